@@ -12,6 +12,7 @@
 #include "game_data.h"
 #include "movement.h"
 #include "visibility.h"
+#include "spatial_index.h"
 #include "math_tables.h"
 #include "audio.h"
 #include <string.h>
@@ -89,18 +90,9 @@ void explode_into_bits(GameObject *obj, GameState *state, bool explosion_kill, i
      * This keeps gib velocity randomness feeling consistent while using d2-driven counts. */
     (void)rand();
 
-    int nasty_slots = NASTY_SHOT_SLOT_COUNT;
     for (int i = 0; i < num_bits; i++) {
         /* Find free slot in NastyShotData */
-        uint8_t *shots = state->level.nasty_shot_data;
-        GameObject *bit = NULL;
-        for (int j = 0; j < nasty_slots; j++) {
-            GameObject *candidate = (GameObject*)(shots + j * OBJECT_SIZE);
-            if (OBJ_ZONE(candidate) < 0) {
-                bit = candidate;
-                break;
-            }
-        }
+        GameObject *bit = objects_alloc_nasty_shot(&state->level);
         if (!bit) {
             break;
         }
@@ -184,6 +176,7 @@ void explode_into_bits(GameObject *obj, GameState *state, bool explosion_kill, i
                 uint8_t *sp = state->level.object_points + src_idx * 8;
                 uint8_t *dp = state->level.object_points + dst_idx * 8;
                 memcpy(dp, sp, 8);
+                spatial_index_note_moved((int16_t)dst_idx);
 
                 if (state->level.prev_object_points) {
                     uint8_t *prev_dp = state->level.prev_object_points + dst_idx * 8;
@@ -441,6 +434,7 @@ void ai_control(GameObject *obj, GameState *state, const AIParams *params)
                 uint8_t *pts = level->object_points + self_idx * 8;
                 obj_sw(pts, (int16_t)ctx.newx);
                 obj_sw(pts + 4, (int16_t)ctx.newz);
+                spatial_index_note_moved((int16_t)self_idx);
             }
             /* Update zone from room */
             if (ctx.objroom) {
@@ -499,6 +493,7 @@ void ai_control(GameObject *obj, GameState *state, const AIParams *params)
                 uint8_t *pts = level->object_points + self_idx * 8;
                 obj_sw(pts, (int16_t)ctx.newx);
                 obj_sw(pts + 4, (int16_t)ctx.newz);
+                spatial_index_note_moved((int16_t)self_idx);
             }
             if (ctx.objroom) {
                 int16_t new_zone = (int16_t)((ctx.objroom[0] << 8) | ctx.objroom[1]);
@@ -536,6 +531,7 @@ void ai_control(GameObject *obj, GameState *state, const AIParams *params)
                 uint8_t *pts = level->object_points + self_idx * 8;
                 obj_sw(pts, (int16_t)ctx.newx);
                 obj_sw(pts + 4, (int16_t)ctx.newz);
+                spatial_index_note_moved((int16_t)self_idx);
             }
             if (ctx.objroom) {
                 int16_t new_zone = (int16_t)((ctx.objroom[0] << 8) | ctx.objroom[1]);
@@ -581,6 +577,7 @@ void ai_control(GameObject *obj, GameState *state, const AIParams *params)
                 uint8_t *pts = level->object_points + self_idx * 8;
                 obj_sw(pts, (int16_t)ctx.newx);
                 obj_sw(pts + 4, (int16_t)ctx.newz);
+                spatial_index_note_moved((int16_t)self_idx);
             }
             if (ctx.objroom) {
                 int16_t new_zone = (int16_t)((ctx.objroom[0] << 8) | ctx.objroom[1]);
@@ -0,0 +1,218 @@
+/*
+ * Alien Breed 3D I - PC Port
+ * asset_loader.c - Background asset loader
+ *
+ * The thread is started on first submit and lives until asset_loader_shutdown.
+ * Jobs are intrusive list nodes; completion is a flag guarded by the queue
+ * mutex plus one condition variable shared by all waiters.
+ *
+ * asset_parallel_for is separate from the queue: it fans one batch of
+ * independent decodes (samples, sprites) out over a few threads that exit
+ * when the batch is done, so it never competes with the renderer's pool.
+ */
+
+#include "asset_loader.h"
+#include "trace.h"
+
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "logging.h"
+#define printf ab3d_log_printf
+
+#if !defined(AB3D_NO_THREADS) && !defined(__EMSCRIPTEN__)
+#define AB3D_ASSET_LOADER_THREAD 1
+#else
+#define AB3D_ASSET_LOADER_THREAD 0
+#endif
+
+struct AssetJob {
+    const char  *name;
+    AssetJobFn   fn;
+    void        *userdata;
+    struct AssetJob *next;
+    int          done;     /* guarded by g_loader_mutex */
+};
+
+#if AB3D_ASSET_LOADER_THREAD
+static SDL_Thread *g_loader_thread = NULL;
+static SDL_mutex  *g_loader_mutex = NULL;
+static SDL_cond   *g_loader_work = NULL; /* queue became non-empty / quit */
+static SDL_cond   *g_loader_done = NULL; /* some job finished */
+static AssetJob   *g_loader_head = NULL;
+static AssetJob   *g_loader_tail = NULL;
+static int         g_loader_quit = 0;
+
+static int asset_loader_main(void *unused)
+{
+    (void)unused;
+    trace_set_thread_name("loader");
+    SDL_LockMutex(g_loader_mutex);
+    for (;;) {
+        while (!g_loader_head && !g_loader_quit)
+            SDL_CondWait(g_loader_work, g_loader_mutex);
+        if (!g_loader_head) break; /* quit with an empty queue */
+
+        AssetJob *job = g_loader_head;
+        g_loader_head = job->next;
+        if (!g_loader_head) g_loader_tail = NULL;
+        SDL_UnlockMutex(g_loader_mutex);
+
+        Uint32 t0 = SDL_GetTicks();
+        uint64_t trace_t = trace_begin();
+        job->fn(job->userdata);
+        trace_end(job->name, trace_t);
+        printf("[LOADER] %s done in %u ms\n", job->name, (unsigned)(SDL_GetTicks() - t0));
+
+        SDL_LockMutex(g_loader_mutex);
+        job->done = 1;
+        SDL_CondBroadcast(g_loader_done);
+    }
+    SDL_UnlockMutex(g_loader_mutex);
+    return 0;
+}
+
+static int asset_loader_start(void)
+{
+    if (g_loader_thread) return 1;
+    g_loader_mutex = SDL_CreateMutex();
+    g_loader_work = SDL_CreateCond();
+    g_loader_done = SDL_CreateCond();
+    if (!g_loader_mutex || !g_loader_work || !g_loader_done) {
+        printf("[LOADER] sync primitives unavailable (%s); loading inline\n", SDL_GetError());
+        return 0;
+    }
+    g_loader_quit = 0;
+    g_loader_thread = SDL_CreateThread(asset_loader_main, "ab3d_loader", NULL);
+    if (!g_loader_thread) {
+        printf("[LOADER] SDL_CreateThread failed (%s); loading inline\n", SDL_GetError());
+        return 0;
+    }
+    return 1;
+}
+#endif
+
+AssetJob *asset_job_submit(const char *name, AssetJobFn fn, void *userdata)
+{
+    if (!fn) return NULL;
+
+#if AB3D_ASSET_LOADER_THREAD
+    AssetJob *job = (AssetJob *)calloc(1, sizeof(*job));
+    if (job && asset_loader_start()) {
+        job->name = name ? name : "job";
+        job->fn = fn;
+        job->userdata = userdata;
+        SDL_LockMutex(g_loader_mutex);
+        if (g_loader_tail) g_loader_tail->next = job;
+        else g_loader_head = job;
+        g_loader_tail = job;
+        SDL_CondSignal(g_loader_work);
+        SDL_UnlockMutex(g_loader_mutex);
+        return job;
+    }
+    free(job);
+#else
+    (void)name;
+#endif
+    fn(userdata);
+    return NULL;
+}
+
+int asset_job_is_done(const AssetJob *job)
+{
+    if (!job) return 1;
+#if AB3D_ASSET_LOADER_THREAD
+    SDL_LockMutex(g_loader_mutex);
+    int done = job->done;
+    SDL_UnlockMutex(g_loader_mutex);
+    return done;
+#else
+    return 1;
+#endif
+}
+
+void asset_job_wait(AssetJob *job)
+{
+    if (!job) return;
+#if AB3D_ASSET_LOADER_THREAD
+    SDL_LockMutex(g_loader_mutex);
+    if (!job->done) {
+        Uint32 t0 = SDL_GetTicks();
+        while (!job->done)
+            SDL_CondWait(g_loader_done, g_loader_mutex);
+        printf("[LOADER] waited %u ms for %s\n", (unsigned)(SDL_GetTicks() - t0), job->name);
+    }
+    SDL_UnlockMutex(g_loader_mutex);
+#endif
+    free(job);
+}
+
+#if AB3D_ASSET_LOADER_THREAD
+typedef struct {
+    AssetIndexFn fn;
+    void        *userdata;
+    int          count;
+    SDL_atomic_t next;
+} AssetParallelCtx;
+
+static int asset_parallel_worker(void *userdata)
+{
+    AssetParallelCtx *ctx = (AssetParallelCtx *)userdata;
+    for (;;) {
+        int i = SDL_AtomicAdd(&ctx->next, 1);
+        if (i >= ctx->count) break;
+        ctx->fn(i, ctx->userdata);
+    }
+    return 0;
+}
+#endif
+
+void asset_parallel_for(int count, AssetIndexFn fn, void *userdata)
+{
+    if (!fn || count <= 0) return;
+
+#if AB3D_ASSET_LOADER_THREAD
+    int threads = SDL_GetCPUCount();
+    if (threads > ASSET_PARALLEL_MAX_THREADS) threads = ASSET_PARALLEL_MAX_THREADS;
+    if (threads > count) threads = count;
+    if (threads > 1) {
+        AssetParallelCtx ctx;
+        SDL_Thread *helpers[ASSET_PARALLEL_MAX_THREADS];
+        int started = 0;
+        ctx.fn = fn;
+        ctx.userdata = userdata;
+        ctx.count = count;
+        SDL_AtomicSet(&ctx.next, 0);
+        for (int t = 1; t < threads; t++) {
+            helpers[started] = SDL_CreateThread(asset_parallel_worker, "ab3d_decode", &ctx);
+            if (!helpers[started]) break;
+            started++;
+        }
+        asset_parallel_worker(&ctx);
+        for (int t = 0; t < started; t++)
+            SDL_WaitThread(helpers[t], NULL);
+        return;
+    }
+#endif
+    for (int i = 0; i < count; i++)
+        fn(i, userdata);
+}
+
+void asset_loader_shutdown(void)
+{
+#if AB3D_ASSET_LOADER_THREAD
+    if (!g_loader_thread) return;
+    SDL_LockMutex(g_loader_mutex);
+    g_loader_quit = 1;
+    SDL_CondSignal(g_loader_work);
+    SDL_UnlockMutex(g_loader_mutex);
+    SDL_WaitThread(g_loader_thread, NULL);
+    g_loader_thread = NULL;
+    SDL_DestroyCond(g_loader_done);
+    SDL_DestroyCond(g_loader_work);
+    SDL_DestroyMutex(g_loader_mutex);
+    g_loader_done = NULL;
+    g_loader_work = NULL;
+    g_loader_mutex = NULL;
+#endif
+}
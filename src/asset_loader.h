@@ -0,0 +1,41 @@
+/*
+ * Alien Breed 3D I - PC Port
+ * asset_loader.h - Background asset loader (single thread, FIFO job queue)
+ *
+ * Jobs run one at a time, in submission order, on the "ab3d_loader" thread.
+ * Each submit returns a completion handle the control loop waits on before
+ * touching whatever the job fills in. Builds without worker threads
+ * (AB3D_NO_THREADS, Emscripten) run the job inline inside asset_job_submit,
+ * so callers are written the same way for both.
+ */
+
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+typedef void (*AssetJobFn)(void *userdata);
+
+typedef struct AssetJob AssetJob;
+
+/* Queue fn(userdata). name is used in log lines only and must outlive the job. */
+AssetJob *asset_job_submit(const char *name, AssetJobFn fn, void *userdata);
+
+/* Non-blocking: 1 once the job has finished (NULL counts as finished). */
+int asset_job_is_done(const AssetJob *job);
+
+/* Block until the job has finished, then release the handle. NULL is a no-op. */
+void asset_job_wait(AssetJob *job);
+
+typedef void (*AssetIndexFn)(int index, void *userdata);
+
+/* Run fn(i, userdata) for i in [0, count) on up to ASSET_PARALLEL_MAX_THREADS
+ * short-lived threads (the caller takes part) and return when all are done.
+ * Indices are handed out from a shared counter, so they finish in any order:
+ * fn writes into a per-index slot and the caller publishes the slots in
+ * index order afterwards. Safe to call from the loader thread. */
+#define ASSET_PARALLEL_MAX_THREADS 8
+void asset_parallel_for(int count, AssetIndexFn fn, void *userdata);
+
+/* Drain the queue and join the loader thread (tear-down). */
+void asset_loader_shutdown(void);
+
+#endif /* ASSET_LOADER_H */
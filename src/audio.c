@@ -5,10 +5,16 @@
  * Sample names and order from Amiga LoadFromDisk.s SFX_NAMES.
  * Prefers Amiga originals: sounds/<name> (no extension) or sounds/<name>.raw,
  * falling back to WAV when needed.
+ *
+ * SFX triggers reach the callback through a lock-free command ring; music
+ * state changes are rare and still take the SDL device lock. Music is
+ * streamed: a background thread decodes the WAV in chunks into a ring the
+ * callback mixes from, so only that ring is resident.
  */
 
 #include "audio.h"
 #include "io.h"
+#include "asset_loader.h"
 #include <SDL.h>
 #include <ctype.h>
 #include <stdio.h>
@@ -19,7 +25,8 @@
 #define printf ab3d_log_printf
 
 #define MAX_SAMPLES      64
-#define MAX_CHANNELS     24
+#define MAX_CHANNELS     24   /* voices actually mixed per callback */
+#define MAX_VOICES       128  /* logical (virtual) voices */
 #define NUM_NAMED_SFX    28
 #define MUSIC_DEFAULT_VOL 176 /* 0..255 */
 /* AB3DI.s sets AUDxPER=443 for SFX playback. Paula PAL audio clock is 3,546,895 Hz. */
@@ -36,7 +43,6 @@
 #endif
 #define DEFAULT_FORMAT  AUDIO_S16SYS
 #define DEFAULT_CHANNELS 1
-#define PLAYBACK_SPEED_DIV 1
 #if defined(__EMSCRIPTEN__)
 /* Web: 1024 @ 48 kHz is about 21 ms, much lower latency than 1024 @ 8 kHz while
  * still giving the browser enough headroom to avoid underruns on heavier frames. */
@@ -44,6 +50,23 @@
 #else
 #define AUDIO_SAMPLES_DESIRED 512
 #endif
+/* Game thread -> audio callback SFX commands (power of two). Several logic
+ * ticks' worth of one-shots even if the callback stalls for a while. */
+#define SFX_CMD_RING_SIZE 256
+/* Mixer accumulates this many output samples at a time. */
+#define MIX_CHUNK_SAMPLES 1024
+/* Streamed music: device-format samples buffered ahead of the callback
+ * (power of two; ~1.4 s at 48 kHz, ~8 s at the native Paula rate), the
+ * source bytes read per refill step, and how much is decoded on the
+ * caller's thread before play starts. */
+#define MUSIC_RING_SAMPLES    65536
+#define MUSIC_READ_BYTES      16384
+#define MUSIC_PREFILL_SAMPLES 8192
+#if !defined(AB3D_NO_THREADS) && !defined(__EMSCRIPTEN__)
+#define AB3D_MUSIC_STREAM_THREAD 1
+#else
+#define AB3D_MUSIC_STREAM_THREAD 0  /* refilled from the callback instead */
+#endif
 
 /* Amiga LoadFromDisk.s SFX_NAMES: size in bytes (one byte per sample, 8-bit signed). */
 static const unsigned int amiga_sfx_sizes[NUM_NAMED_SFX] = {
@@ -82,6 +105,16 @@ static const char *const sfx_names[NUM_NAMED_SFX] = {
     "teleport",    /* 26 */
     "halfwormpain" /* 27 (Amiga: HALFWORMPAIN) */
 };
+/* Voice priority by sample (1 = ambience .. 3 = player feedback). When more
+ * than MAX_CHANNELS voices are live, the highest priority * gain are mixed. */
+static const Uint8 sfx_priority[NUM_NAMED_SFX] = {
+    2, 3, 2, 3, 3, 3, 2, 1, 2, 2,   /* scream fire! munch shoot.dm collect newdoor splash footstep3 lowscream baddiegun */
+    3, 3, 3, 2, 2, 3, 1, 1, 1, 3,   /* switch switch1 noammo splotch splatpop boom newhiss howl1 howl2 pant */
+    2, 3, 2, 1, 1, 1, 3, 2          /* whoosh shotgun flame muffledfoot footclop footclank teleport halfwormpain */
+};
+/* Positional SFX: full volume up to this distance from the listener, then
+ * falling off as AUDIO_NEAR_DIST / distance. */
+#define AUDIO_NEAR_DIST 512
 
 /* One preloaded sample (converted to device format) */
 typedef struct {
@@ -90,19 +123,52 @@ typedef struct {
     int     loaded;
 } LoadedSample;
 
-/* One mixing channel (playing a sample) */
+/* One logical voice (playing a sample). Owned by the audio callback. Voices
+ * that do not make the mixed set still advance, so they resume in sync. */
 typedef struct {
     const Uint8 *sample_data;
     Uint32       sample_len;
     Uint32       position;   /* bytes played */
-    int          volume;     /* 0-255 -> SDL_MixAudio uses 0-128 */
+    int          volume;     /* 0-255 -> mixer gain 0-128 */
     int          sample_id;
+    int          priority;
+    int          mixed;      /* chosen for this callback */
 } Channel;
 
+enum {
+    SFX_CMD_PLAY,
+    SFX_CMD_STOP_ALL
+};
+
 typedef struct {
-    Uint8  *data;
-    Uint32  length;
-    Uint32  position;
+    Uint8  type;
+    Uint8  sample_id;
+    Uint8  priority;
+    Sint16 volume;   /* 0..255, master volume and distance already applied */
+} SfxCommand;
+
+/* Streamed music track. The source is the PCM chunk of a WAV file (or, for
+ * WAVs we cannot stream, an SDL_LoadWAV result already in device format);
+ * fill reads it in MUSIC_READ_BYTES steps through an SDL_AudioStream into
+ * the ring, and the callback mixes from the ring. Looping rewinds the
+ * source without flushing the converter, so the seam is sample-exact. */
+typedef struct {
+    FILE            *file;
+    Uint8           *mem;          /* fallback: whole track in device format */
+    long             data_start;   /* file offset of the PCM data */
+    Uint32           data_bytes;
+    Uint32           read_pos;     /* bytes of PCM data consumed by fill */
+    Uint32           frame_bytes;
+    SDL_AudioStream *cvt;
+    int              flushed;
+    Uint32           total_samples; /* device samples in one pass */
+
+    Sint16          *ring;
+    SDL_atomic_t     ring_write;   /* samples produced (fill) */
+    SDL_atomic_t     ring_read;    /* samples consumed (callback) */
+    SDL_atomic_t     source_done;  /* non-looping track fully decoded */
+    Uint32           played;       /* samples mixed since the last rewind (callback) */
+
     int     loaded;
     int     playing;
     int     loop;
@@ -112,7 +178,7 @@ typedef struct {
 static SDL_AudioDeviceID g_device = 0;
 static SDL_AudioSpec     g_spec;
 static LoadedSample      g_samples[MAX_SAMPLES];
-static Channel           g_channels[MAX_CHANNELS];
+static Channel           g_channels[MAX_VOICES];
 static MusicTrack        g_music;
 static int               g_audio_ready = 0;
 static int               g_master_volume = 100; /* 0..100, scales per-sample volume in audio_play_sample */
@@ -121,22 +187,50 @@ static int               g_master_volume = 100; /* 0..100, scales per-sample vol
  * A sample can be queued at most once for each frame id. */
 static Uint32            g_sfx_frame_id = 0;
 static Uint32            g_sample_last_played_frame[MAX_SAMPLES];
+static int32_t           g_listener_x = 0;
+static int32_t           g_listener_z = 0;
+/* Single-producer (game thread) / single-consumer (audio callback) ring:
+ * head is only written by the producer, tail only by the callback. */
+static SfxCommand        g_sfx_ring[SFX_CMD_RING_SIZE];
+static SDL_atomic_t      g_sfx_ring_head;
+static SDL_atomic_t      g_sfx_ring_tail;
+static Sint32            g_mix_acc[MIX_CHUNK_SAMPLES];
+/* Callback cost in microseconds (perf HUD): last call, and the peak since the last query. */
+static SDL_atomic_t      g_audio_cb_last_us;
+static SDL_atomic_t      g_audio_cb_peak_us;
+#if AB3D_MUSIC_STREAM_THREAD
+/* Guards the music source (file/converter) against the stream thread. */
+static SDL_mutex        *g_music_mutex = NULL;
+static SDL_sem          *g_music_wake = NULL;
+static SDL_Thread       *g_music_thread = NULL;
+static SDL_atomic_t      g_music_thread_quit;
+#endif
 
 static int channel_is_free(const Channel *ch)
 {
     return (ch->sample_data == NULL || ch->position >= ch->sample_len);
 }
 
-/* Pick the best channel for a new one-shot SFX:
- * 1) Prefer truly free channels.
- * 2) If all busy, steal the least intrusive one (lowest volume, nearest end). */
+/* Audibility rank used to pick the mixed voices. */
+static int voice_score(const Channel *ch)
+{
+    int vol = ch->volume;
+    if (vol < 0) vol = 0;
+    if (vol > 255) vol = 255;
+    return vol * ch->priority;
+}
+
+/* Pick the best voice slot for a new one-shot SFX:
+ * 1) Prefer truly free voices.
+ * 2) If all MAX_VOICES are busy, steal the least intrusive one (lowest
+ *    priority * volume, nearest end). */
 static int choose_channel_for_play(void)
 {
     int best_free = -1;
     int best_busy = -1;
     int best_busy_score = 0x7FFFFFFF;
 
-    for (int c = 0; c < MAX_CHANNELS; c++) {
+    for (int c = 0; c < MAX_VOICES; c++) {
         Channel *ch = &g_channels[c];
         if (channel_is_free(ch)) {
             best_free = c;
@@ -144,11 +238,8 @@ static int choose_channel_for_play(void)
         }
 
         Uint32 remain = ch->sample_len - ch->position;
-        int vol = ch->volume;
-        if (vol < 0) vol = 0;
-        if (vol > 255) vol = 255;
         /* Lower score = better steal candidate. Bias toward quieter + near-finished. */
-        int score = (int)remain + (vol << 8);
+        int score = (int)remain + (voice_score(ch) << 8);
         if (score < best_busy_score) {
             best_busy_score = score;
             best_busy = c;
@@ -160,102 +251,385 @@ static int choose_channel_for_play(void)
     return 0;
 }
 
+/* Music state is changed with both the source mutex (stream thread) and the
+ * device lock (callback) held, in that order. */
+static void music_lock(void)
+{
+#if AB3D_MUSIC_STREAM_THREAD
+    if (g_music_mutex) SDL_LockMutex(g_music_mutex);
+#endif
+    if (g_device) SDL_LockAudioDevice(g_device);
+}
+
+static void music_unlock(void)
+{
+    if (g_device) SDL_UnlockAudioDevice(g_device);
+#if AB3D_MUSIC_STREAM_THREAD
+    if (g_music_mutex) SDL_UnlockMutex(g_music_mutex);
+#endif
+}
+
+static Uint32 music_ring_fill_level(void)
+{
+    return (Uint32)SDL_AtomicGet(&g_music.ring_write) - (Uint32)SDL_AtomicGet(&g_music.ring_read);
+}
+
+static Uint32 music_source_read(Uint8 *dst, Uint32 bytes)
+{
+    Uint32 remain = g_music.data_bytes - g_music.read_pos;
+    if (bytes > remain) bytes = remain;
+    bytes -= bytes % g_music.frame_bytes;
+    if (bytes == 0) return 0;
+    if (g_music.mem) {
+        memcpy(dst, g_music.mem + g_music.read_pos, bytes);
+    } else {
+        bytes = (Uint32)fread(dst, 1, bytes, g_music.file);
+        bytes -= bytes % g_music.frame_bytes;
+    }
+    g_music.read_pos += bytes;
+    return bytes;
+}
+
+static void music_source_rewind(void)
+{
+    g_music.read_pos = 0;
+    if (g_music.file) fseek(g_music.file, g_music.data_start, SEEK_SET);
+}
+
+/* Decode until the ring holds at least target samples (or the source ends).
+ * Caller owns the source: the stream thread with g_music_mutex, a
+ * music_lock holder, or the callback when there is no stream thread. */
+static void music_stream_fill(Uint32 target)
+{
+    /* Only one filler runs at a time (see above), so these can be static. */
+    static Uint8 in[MUSIC_READ_BYTES];
+    static Sint16 out[MUSIC_READ_BYTES / 2];
+
+    if (!g_music.loaded || !g_music.cvt || !g_music.ring) return;
+    if (target > MUSIC_RING_SAMPLES) target = MUSIC_RING_SAMPLES;
+
+    while (!SDL_AtomicGet(&g_music.source_done)) {
+        Uint32 level = music_ring_fill_level();
+        if (level >= target) break;
+
+        Uint32 space = MUSIC_RING_SAMPLES - level;
+        if (space > (Uint32)(sizeof(out) / sizeof(out[0]))) space = (Uint32)(sizeof(out) / sizeof(out[0]));
+        int got = SDL_AudioStreamGet(g_music.cvt, out, (int)(space * 2u));
+        if (got > 0) {
+            Uint32 n = (Uint32)got / 2u;
+            Uint32 w = (Uint32)SDL_AtomicGet(&g_music.ring_write);
+            for (Uint32 i = 0; i < n; i++)
+                g_music.ring[(w + i) & (MUSIC_RING_SAMPLES - 1)] = out[i];
+            SDL_MemoryBarrierRelease();
+            SDL_AtomicSet(&g_music.ring_write, (int)(w + n));
+            continue;
+        }
+
+        Uint32 bytes = music_source_read(in, sizeof(in));
+        if (bytes > 0) {
+            if (SDL_AudioStreamPut(g_music.cvt, in, (int)bytes) < 0) {
+                SDL_AtomicSet(&g_music.source_done, 1);
+                break;
+            }
+            continue;
+        }
+        if (g_music.loop && g_music.read_pos > 0) {
+            music_source_rewind();
+        } else if (!g_music.flushed) {
+            SDL_AudioStreamFlush(g_music.cvt);
+            g_music.flushed = 1;
+        } else {
+            SDL_AtomicSet(&g_music.source_done, 1);
+        }
+    }
+}
+
+/* Back to the first sample with an empty ring. Caller holds music_lock. */
+static void music_rewind_locked(void)
+{
+    if (!g_music.loaded) return;
+    music_source_rewind();
+    if (g_music.cvt) SDL_AudioStreamClear(g_music.cvt);
+    g_music.flushed = 0;
+    g_music.played = 0;
+    SDL_AtomicSet(&g_music.source_done, 0);
+    SDL_AtomicSet(&g_music.ring_write, 0);
+    SDL_AtomicSet(&g_music.ring_read, 0);
+    music_stream_fill(MUSIC_PREFILL_SAMPLES);
+}
+
 static void music_stop_locked(void)
 {
     g_music.playing = 0;
-    g_music.position = 0;
+    music_rewind_locked();
 }
 
 static void music_unload_locked(void)
 {
-    if (g_music.data) {
-        SDL_free(g_music.data);
-    }
-    g_music.data = NULL;
-    g_music.length = 0;
-    g_music.position = 0;
+    if (g_music.file) fclose(g_music.file);
+    if (g_music.mem) SDL_free(g_music.mem);
+    if (g_music.cvt) SDL_FreeAudioStream(g_music.cvt);
+    g_music.file = NULL;
+    g_music.mem = NULL;
+    g_music.cvt = NULL;
+    g_music.data_start = 0;
+    g_music.data_bytes = 0;
+    g_music.read_pos = 0;
+    g_music.frame_bytes = 1;
+    g_music.flushed = 0;
+    g_music.total_samples = 0;
+    g_music.played = 0;
+    SDL_AtomicSet(&g_music.source_done, 0);
+    SDL_AtomicSet(&g_music.ring_write, 0);
+    SDL_AtomicSet(&g_music.ring_read, 0);
     g_music.loaded = 0;
     g_music.playing = 0;
     g_music.loop = 1;
     g_music.volume = MUSIC_DEFAULT_VOL;
 }
 
-static void audio_callback(void *userdata, Uint8 *stream, int len)
+#if AB3D_MUSIC_STREAM_THREAD
+/* Keeps the ring at least half full; woken by the callback when it drains
+ * below that, and polls as a fallback. */
+static int music_stream_thread_main(void *unused)
 {
-    (void)userdata;
-    memset(stream, 0, (size_t)len);
-
-    if (g_music.playing && g_music.loaded && g_music.data && g_music.length > 0) {
-        Uint32 out_pos = 0;
-        Uint32 out_remain = (Uint32)len;
-
-        while (out_remain > 0 && g_music.playing) {
-            if (g_music.position >= g_music.length) {
-                if (g_music.loop) {
-                    g_music.position = 0;
-                } else {
-                    g_music.playing = 0;
-                    break;
-                }
-            }
+    (void)unused;
+    while (!SDL_AtomicGet(&g_music_thread_quit)) {
+        SDL_SemWaitTimeout(g_music_wake, 50);
+        SDL_LockMutex(g_music_mutex);
+        music_stream_fill(MUSIC_RING_SAMPLES);
+        SDL_UnlockMutex(g_music_mutex);
+    }
+    return 0;
+}
 
-            Uint32 in_remain = g_music.length - g_music.position;
-            Uint32 to_mix = (out_remain < in_remain) ? out_remain : in_remain;
+static void music_stream_thread_start(void)
+{
+    g_music_mutex = SDL_CreateMutex();
+    g_music_wake = SDL_CreateSemaphore(0);
+    SDL_AtomicSet(&g_music_thread_quit, 0);
+    if (g_music_mutex && g_music_wake)
+        g_music_thread = SDL_CreateThread(music_stream_thread_main, "ab3d_music", NULL);
+    if (!g_music_thread)
+        printf("[MUSIC] stream thread unavailable (%s); refilling from the audio callback\n", SDL_GetError());
+}
 
-            int mix_vol = g_music.volume;
-            if (mix_vol < 0) mix_vol = 0;
-            if (mix_vol > 255) mix_vol = 255;
-            if (g_master_volume <= 0) {
-                mix_vol = 0;
-            } else {
-                mix_vol = (mix_vol * g_master_volume + 50) / 100;
-                if (mix_vol > 255) mix_vol = 255;
-            }
-            mix_vol = (mix_vol * 128) / 255;
+static void music_stream_thread_stop(void)
+{
+    if (g_music_thread) {
+        SDL_AtomicSet(&g_music_thread_quit, 1);
+        SDL_SemPost(g_music_wake);
+        SDL_WaitThread(g_music_thread, NULL);
+        g_music_thread = NULL;
+    }
+    if (g_music_wake) SDL_DestroySemaphore(g_music_wake);
+    if (g_music_mutex) SDL_DestroyMutex(g_music_mutex);
+    g_music_wake = NULL;
+    g_music_mutex = NULL;
+}
+#endif
 
-            if (mix_vol > 0) {
-                SDL_MixAudioFormat(stream + out_pos, g_music.data + g_music.position,
-                                   g_spec.format, to_mix, mix_vol);
+/* Audio thread: apply queued SFX commands to g_channels. Also called by the
+ * producer with the device locked when the ring is full (callback not running). */
+static void sfx_drain_commands(void)
+{
+    int tail = SDL_AtomicGet(&g_sfx_ring_tail);
+    int head = SDL_AtomicGet(&g_sfx_ring_head);
+    SDL_MemoryBarrierAcquire();
+
+    while (tail != head) {
+        const SfxCommand *cmd = &g_sfx_ring[(Uint32)tail & (SFX_CMD_RING_SIZE - 1)];
+        if (cmd->type == SFX_CMD_STOP_ALL) {
+            for (int c = 0; c < MAX_VOICES; c++) {
+                g_channels[c].sample_data = NULL;
+                g_channels[c].position = 0;
+                g_channels[c].sample_id = -1;
             }
+        } else {
+            /* Pick a channel that minimizes audible stomping. */
+            Channel *ch = &g_channels[choose_channel_for_play()];
+            const LoadedSample *smp = &g_samples[cmd->sample_id];
+            ch->sample_data = smp->data;
+            ch->sample_len  = smp->length;
+            ch->position    = 0;
+            ch->volume      = cmd->volume;
+            ch->sample_id   = cmd->sample_id;
+            ch->priority    = cmd->priority;
+        }
+        tail = (int)((Uint32)tail + 1u);
+    }
+    SDL_AtomicSet(&g_sfx_ring_tail, tail);
+}
+
+/* Game thread: queue one command; never blocks on the callback unless the
+ * ring is full, in which case the queue is drained under the device lock. */
+static void sfx_push_command(Uint8 type, int sample_id, int volume, int priority)
+{
+    int head = SDL_AtomicGet(&g_sfx_ring_head);
+    int locked = 0;
+
+    if ((Uint32)head - (Uint32)SDL_AtomicGet(&g_sfx_ring_tail) >= SFX_CMD_RING_SIZE) {
+        SDL_LockAudioDevice(g_device);
+        sfx_drain_commands();
+        locked = 1;
+    }
+
+    SfxCommand *cmd = &g_sfx_ring[(Uint32)head & (SFX_CMD_RING_SIZE - 1)];
+    cmd->type = type;
+    cmd->sample_id = (Uint8)sample_id;
+    cmd->volume = (Sint16)volume;
+    cmd->priority = (Uint8)priority;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&g_sfx_ring_head, (int)((Uint32)head + 1u));
 
-            g_music.position += to_mix;
-            out_pos += to_mix;
-            out_remain -= to_mix;
+    if (locked) SDL_UnlockAudioDevice(g_device);
+}
+
+/* 0..255 volume -> 0..128 gain (same scale SDL_MixAudioFormat used). */
+static int mix_gain(int vol)
+{
+    if (vol < 0) vol = 0;
+    if (vol > 255) vol = 255;
+    return (vol * 128) / 255;
+}
+
+static void mix_music_chunk(Sint32 *acc, Uint32 count)
+{
+    int gain = g_music.volume;
+    if (gain < 0) gain = 0;
+    if (gain > 255) gain = 255;
+    if (g_master_volume <= 0) {
+        gain = 0;
+    } else {
+        gain = (gain * g_master_volume + 50) / 100;
+        if (gain > 255) gain = 255;
+    }
+    gain = mix_gain(gain);
+
+    int done = SDL_AtomicGet(&g_music.source_done); /* before ring_write: no tail is lost */
+    Uint32 r = (Uint32)SDL_AtomicGet(&g_music.ring_read);
+    Uint32 avail = (Uint32)SDL_AtomicGet(&g_music.ring_write) - r;
+    SDL_MemoryBarrierAcquire();
+    Uint32 n = (count < avail) ? count : avail;
+    if (gain > 0) {
+        for (Uint32 i = 0; i < n; i++)
+            acc[i] += (Sint32)g_music.ring[(r + i) & (MUSIC_RING_SAMPLES - 1)] * gain;
+    }
+    SDL_AtomicSet(&g_music.ring_read, (int)(r + n));
+    g_music.played += n;
+
+    /* A short ring only means the source is behind: play silence and catch up. */
+    if (n == avail && done)
+        g_music.playing = 0;
+}
+
+/* Mark the MAX_CHANNELS most audible live voices as mixed for this callback;
+ * the rest are virtual (tracked, not mixed). */
+static void select_mixed_voices(void)
+{
+    int top[MAX_CHANNELS];
+    int top_score[MAX_CHANNELS];
+    int ntop = 0;
+
+    for (int c = 0; c < MAX_VOICES; c++) {
+        Channel *ch = &g_channels[c];
+        ch->mixed = 0;
+        if (channel_is_free(ch)) continue;
+
+        int score = voice_score(ch);
+        if (ntop == MAX_CHANNELS && score <= top_score[ntop - 1]) continue;
+        int i = (ntop < MAX_CHANNELS) ? ntop++ : ntop - 1;
+        while (i > 0 && top_score[i - 1] < score) {
+            top[i] = top[i - 1];
+            top_score[i] = top_score[i - 1];
+            i--;
         }
+        top[i] = c;
+        top_score[i] = score;
     }
+    for (int i = 0; i < ntop; i++) g_channels[top[i]].mixed = 1;
+}
 
-    for (int c = 0; c < MAX_CHANNELS; c++) {
+static void mix_channels_chunk(Sint32 *acc, Uint32 count)
+{
+    for (int c = 0; c < MAX_VOICES; c++) {
         Channel *ch = &g_channels[c];
         if (ch->sample_data == NULL || ch->position >= ch->sample_len)
             continue;
 
-        /* Normal speed (PLAYBACK_SPEED_DIV 1): consume len bytes per callback */
-        Uint32 remain = ch->sample_len - ch->position;
-        Uint32 to_mix = (Uint32)len / PLAYBACK_SPEED_DIV;
-        if (to_mix > remain)
-            to_mix = remain;
-
-        int mix_vol = ch->volume;
-        if (mix_vol < 0) mix_vol = 0;
-        if (mix_vol > 255) mix_vol = 255;
-        mix_vol = (mix_vol * 128) / 255;
-
-        SDL_MixAudioFormat(stream, ch->sample_data + ch->position,
-                           g_spec.format, to_mix, mix_vol);
-#if PLAYBACK_SPEED_DIV > 1
-        if (to_mix * 2 <= (Uint32)len)
-            SDL_MixAudioFormat(stream + to_mix, ch->sample_data + ch->position,
-                               g_spec.format, to_mix, mix_vol);
-#endif
-        ch->position += to_mix;
+        Uint32 avail = (ch->sample_len - ch->position) / 2u;
+        Uint32 n = (count < avail) ? count : avail;
+        if (ch->mixed) {
+            const Sint16 *src = (const Sint16 *)(const void *)(ch->sample_data + ch->position);
+            int gain = mix_gain(ch->volume);
+            for (Uint32 i = 0; i < n; i++) acc[i] += (Sint32)src[i] * gain;
+        }
+        ch->position += n * 2u;
 
-        if (ch->position >= ch->sample_len) {
+        if (ch->position + 1u >= ch->sample_len) {
             ch->sample_data = NULL;
             ch->sample_id = -1;
         }
     }
 }
 
+/* The device is opened with allowed_changes = 0, so the stream is always
+ * DEFAULT_FORMAT (signed 16-bit) and samples/music are converted to it at
+ * load time. All sources are summed at 16.7 fixed point in one pass and
+ * saturated once per output sample. */
+static void audio_callback(void *userdata, Uint8 *stream, int len)
+{
+    Sint16 *out = (Sint16 *)(void *)stream;
+    Uint32 total = (Uint32)len / 2u;
+    Uint64 cb_t0 = SDL_GetPerformanceCounter();
+    (void)userdata;
+
+    sfx_drain_commands();
+    select_mixed_voices();
+    int music_on = g_music.playing && g_music.loaded && g_music.ring;
+#if AB3D_MUSIC_STREAM_THREAD
+    if (music_on && !g_music_thread) {
+        music_stream_fill(total + MUSIC_PREFILL_SAMPLES);
+    } else if (music_on && music_ring_fill_level() < MUSIC_RING_SAMPLES / 2 &&
+               SDL_SemValue(g_music_wake) == 0) {
+        SDL_SemPost(g_music_wake);
+    }
+#else
+    if (music_on) music_stream_fill(total + MUSIC_PREFILL_SAMPLES);
+#endif
+
+    for (Uint32 base = 0; base < total; base += MIX_CHUNK_SAMPLES) {
+        Uint32 count = total - base;
+        if (count > MIX_CHUNK_SAMPLES) count = MIX_CHUNK_SAMPLES;
+        memset(g_mix_acc, 0, (size_t)count * sizeof(g_mix_acc[0]));
+
+        if (music_on) mix_music_chunk(g_mix_acc, count);
+        mix_channels_chunk(g_mix_acc, count);
+
+        for (Uint32 i = 0; i < count; i++) {
+            Sint32 v = g_mix_acc[i] >> 7;
+            if (v > 32767) v = 32767;
+            else if (v < -32768) v = -32768;
+            out[base + i] = (Sint16)v;
+        }
+    }
+    if (len & 1) stream[len - 1] = 0;
+
+    int us = (int)((SDL_GetPerformanceCounter() - cb_t0) * 1000000u / SDL_GetPerformanceFrequency());
+    SDL_AtomicSet(&g_audio_cb_last_us, us);
+    int peak = SDL_AtomicGet(&g_audio_cb_peak_us);
+    while (us > peak && !SDL_AtomicCAS(&g_audio_cb_peak_us, peak, us))
+        peak = SDL_AtomicGet(&g_audio_cb_peak_us);
+}
+
+void audio_get_callback_stats(int *last_us, int *peak_us, int *budget_us)
+{
+    int ready = g_audio_ready && g_spec.freq > 0;
+    if (last_us) *last_us = ready ? SDL_AtomicGet(&g_audio_cb_last_us) : 0;
+    if (peak_us) *peak_us = ready ? SDL_AtomicSet(&g_audio_cb_peak_us, 0) : 0;
+    if (budget_us) *budget_us = ready ? (int)((Uint64)g_spec.samples * 1000000u / (Uint64)g_spec.freq) : 0;
+}
+
 /* Lowercase the filename part of path in place (from last '/' or '\\' to end). */
 static void path_filename_to_lower(char *path)
 {
@@ -314,6 +688,104 @@ static int load_wav_converted(const char *subpath, char *path_out, size_t path_s
     return 1;
 }
 
+/* Where a music track's PCM lives and how to convert it (see MusicTrack). */
+typedef struct {
+    FILE            *file;
+    Uint8           *mem;
+    long             data_start;
+    Uint32           data_bytes;
+    Uint32           frame_bytes;
+    SDL_AudioStream *cvt;
+    Uint32           total_samples;
+} MusicSource;
+
+static Uint32 rd_le16(const Uint8 *p) { return (Uint32)p[0] | ((Uint32)p[1] << 8); }
+static Uint32 rd_le32(const Uint8 *p) { return rd_le16(p) | (rd_le16(p + 2) << 16); }
+
+/* Open a plain PCM WAV (8/16-bit, any rate/channels) for streaming: find
+ * the data chunk and build a converter to the device format. Returns 0 for
+ * anything else (compressed WAVs, bad headers); the file is closed then. */
+static int music_open_wav_stream(FILE *f, MusicSource *out)
+{
+    Uint8 hdr[40];
+    Uint32 fmt_tag = 0, channels = 0, rate = 0, bits = 0;
+    int have_fmt = 0;
+
+    if (fread(hdr, 1, 12, f) != 12 || memcmp(hdr, "RIFF", 4) != 0 || memcmp(hdr + 8, "WAVE", 4) != 0)
+        return 0;
+    for (;;) {
+        if (fread(hdr, 1, 8, f) != 8) return 0;
+        Uint32 size = rd_le32(hdr + 4);
+        if (memcmp(hdr, "fmt ", 4) == 0) {
+            Uint32 want = (size < sizeof(hdr)) ? size : (Uint32)sizeof(hdr);
+            if (want < 16 || fread(hdr, 1, want, f) != want) return 0;
+            fmt_tag = rd_le16(hdr);
+            channels = rd_le16(hdr + 2);
+            rate = rd_le32(hdr + 4);
+            bits = rd_le16(hdr + 14);
+            if (fmt_tag == 0xFFFEu && want >= 26) fmt_tag = rd_le16(hdr + 24); /* EXTENSIBLE subformat */
+            have_fmt = 1;
+            if (fseek(f, (long)(size - want + (size & 1u)), SEEK_CUR) != 0) return 0;
+        } else if (memcmp(hdr, "data", 4) == 0) {
+            if (!have_fmt || fmt_tag != 1 || (bits != 8 && bits != 16) ||
+                channels < 1 || channels > 8 || rate == 0)
+                return 0;
+            out->file = f;
+            out->mem = NULL;
+            out->data_start = ftell(f);
+            out->data_bytes = size;
+            out->frame_bytes = channels * (bits / 8u);
+            out->cvt = SDL_NewAudioStream((bits == 8) ? AUDIO_U8 : AUDIO_S16LSB, (Uint8)channels, (int)rate,
+                                          g_spec.format, g_spec.channels, g_spec.freq);
+            if (!out->cvt || out->data_start < 0) return 0;
+            out->total_samples = (Uint32)(((Uint64)(size / out->frame_bytes) * (Uint64)g_spec.freq /
+                                           rate) * g_spec.channels);
+            return 1;
+        } else if (fseek(f, (long)(size + (size & 1u)), SEEK_CUR) != 0) {
+            return 0;
+        }
+    }
+}
+
+/* Resolve subpath like load_wav_converted and open it as a MusicSource:
+ * streamed from disk when possible, otherwise decoded whole as before. */
+static int music_open_source(const char *subpath, char *path_out, size_t path_size, MusicSource *out)
+{
+    char path[512];
+    FILE *f;
+
+    memset(out, 0, sizeof(*out));
+    io_make_data_path(path, sizeof(path), subpath);
+    f = fopen(path, "rb");
+    if (!f) {
+        path_filename_to_lower(path);
+        f = fopen(path, "rb");
+    }
+    if (f) {
+        if (music_open_wav_stream(f, out)) {
+            snprintf(path_out, path_size, "%s", path);
+            return 1;
+        }
+        if (out->cvt) SDL_FreeAudioStream(out->cvt);
+        fclose(f);
+        memset(out, 0, sizeof(*out));
+    }
+
+    if (!load_wav_converted(subpath, path_out, path_size, &out->mem, &out->data_bytes))
+        return 0;
+    out->frame_bytes = (Uint32)g_spec.channels * (SDL_AUDIO_BITSIZE(g_spec.format) / 8u);
+    if (out->frame_bytes == 0) out->frame_bytes = 1;
+    out->total_samples = out->data_bytes / 2u;
+    out->cvt = SDL_NewAudioStream(g_spec.format, g_spec.channels, g_spec.freq,
+                                  g_spec.format, g_spec.channels, g_spec.freq);
+    if (!out->cvt) {
+        SDL_free(out->mem);
+        out->mem = NULL;
+        return 0;
+    }
+    return 1;
+}
+
 /* Load Amiga raw SFX: no header, 8-bit signed PCM, one byte per sample, ~8007 Hz.
  * Tries sounds/<name> (no extension) then sounds/<name>.raw. Returns 1 with buf/len/spec set, 0 on failure. */
 static int load_amiga_raw(int id, char *path_out, size_t path_size,
@@ -397,16 +869,26 @@ static int load_amiga_raw(int id, char *path_out, size_t path_size,
     return 1;
 }
 
-static int load_one_sample(int id)
+/* One sample decoded off the main table; published by audio_init in id order. */
+typedef struct {
+    Uint8      *data;
+    Uint32      length;
+    int         from_amiga;
+    const char *error;      /* set when the file was found but could not be used */
+    char        path[512];
+} SampleLoadResult;
+
+static void load_one_sample(int id, SampleLoadResult *r)
 {
-    char path[512];
+    char *path = r->path;
+    const size_t path_size = sizeof(r->path);
     SDL_AudioSpec want;
     Uint8 *buf = NULL;
     Uint32 len = 0;
     int from_amiga = 0;
 
     /* Prefer Amiga originals (no .wav): sounds/<name> or sounds/<name>.raw; then fall back to .wav */
-    if (id < NUM_NAMED_SFX && load_amiga_raw(id, path, sizeof(path), &want, &buf, &len)) {
+    if (id < NUM_NAMED_SFX && load_amiga_raw(id, path, path_size, &want, &buf, &len)) {
         from_amiga = 1;
     } else {
         char subpath[80];
@@ -415,19 +897,17 @@ static int load_one_sample(int id)
         } else {
             snprintf(subpath, sizeof(subpath), "sounds/%d.wav", id);
         }
-        io_make_data_path(path, sizeof(path), subpath);
+        io_make_data_path(path, path_size, subpath);
 
         if (!SDL_LoadWAV(path, &want, &buf, &len)) {
             char path_lower[512];
             snprintf(path_lower, sizeof(path_lower), "%s", path);
             path_filename_to_lower(path_lower);
             if (!SDL_LoadWAV(path_lower, &want, &buf, &len)) {
-                strncpy(path, path_lower, sizeof(path) - 1);
-                path[sizeof(path) - 1] = '\0';
-                return 0;  /* not found - skip silently for high IDs */
+                return;  /* not found - skip silently for high IDs */
             }
-            strncpy(path, path_lower, sizeof(path) - 1);
-            path[sizeof(path) - 1] = '\0';
+            strncpy(path, path_lower, path_size - 1);
+            path[path_size - 1] = '\0';
         }
     }
 
@@ -435,33 +915,67 @@ static int load_one_sample(int id)
     SDL_AudioCVT cvt;
     if (SDL_BuildAudioCVT(&cvt, want.format, want.channels, want.freq,
                            g_spec.format, g_spec.channels, g_spec.freq) < 0) {
-        printf("[AUDIO] sample %d: unsupported format (%s)\n", id, path);
+        r->error = "unsupported format";
         if (from_amiga) SDL_free(buf); else SDL_FreeWAV(buf);
-        return 0;
+        return;
     }
 
     cvt.len = (int)len;
     cvt.buf = (Uint8 *)SDL_malloc((size_t)len * cvt.len_mult);
     if (!cvt.buf) {
-        printf("[AUDIO] sample %d: out of memory\n", id);
+        r->error = "out of memory";
         if (from_amiga) SDL_free(buf); else SDL_FreeWAV(buf);
-        return 0;
+        return;
     }
     memcpy(cvt.buf, buf, (size_t)len);
     if (from_amiga) SDL_free(buf); else SDL_FreeWAV(buf);
 
     if (SDL_ConvertAudio(&cvt) < 0) {
-        printf("[AUDIO] sample %d: convert failed\n", id);
+        r->error = "convert failed";
         SDL_free(cvt.buf);
-        return 0;
+        return;
     }
 
-    g_samples[id].data = cvt.buf;
-    g_samples[id].length = (Uint32)(cvt.len_cvt);
-    g_samples[id].loaded = 1;
-    printf("[AUDIO] loaded %d (%s): %s%s (%u bytes)\n",
-           id, id < NUM_NAMED_SFX ? sfx_names[id] : "?", path, from_amiga ? " [Amiga raw]" : "", (unsigned)g_samples[id].length);
-    return 1;
+    r->data = cvt.buf;
+    r->length = (Uint32)(cvt.len_cvt);
+    r->from_amiga = from_amiga;
+}
+
+static void load_sample_job(int id, void *userdata)
+{
+    load_one_sample(id, &((SampleLoadResult *)userdata)[id]);
+}
+
+/* Decode every sample in parallel, then fill g_samples in id order so the
+ * table and the log read the same as a serial load. Returns the count loaded. */
+static int load_all_samples(void)
+{
+    SampleLoadResult *results = (SampleLoadResult *)calloc(MAX_SAMPLES, sizeof(*results));
+    int loaded_count = 0;
+    if (!results) {
+        fprintf(stderr, "[AUDIO] FATAL: out of memory loading samples\n");
+        exit(1);
+    }
+
+    asset_parallel_for(MAX_SAMPLES, load_sample_job, results);
+
+    for (int id = 0; id < MAX_SAMPLES; id++) {
+        SampleLoadResult *r = &results[id];
+        if (r->error) {
+            printf("[AUDIO] sample %d: %s (%s)\n", id, r->error, r->path);
+            continue;
+        }
+        if (!r->data) continue;
+        g_samples[id].data = r->data;
+        g_samples[id].length = r->length;
+        g_samples[id].loaded = 1;
+        loaded_count++;
+        printf("[AUDIO] loaded %d (%s): %s%s (%u bytes)\n",
+               id, id < NUM_NAMED_SFX ? sfx_names[id] : "?", r->path,
+               r->from_amiga ? " [Amiga raw]" : "", (unsigned)r->length);
+    }
+    free(results);
+    return loaded_count;
 }
 
 static void free_samples(void)
@@ -487,13 +1001,16 @@ void audio_init(void)
     memset(&g_music, 0, sizeof(g_music));
     g_music.loop = 1;
     g_music.volume = MUSIC_DEFAULT_VOL;
+    g_music.frame_bytes = 1;
     memset(g_sample_last_played_frame, 0, sizeof(g_sample_last_played_frame));
-    for (int i = 0; i < MAX_CHANNELS; i++) {
+    for (int i = 0; i < MAX_VOICES; i++) {
         g_channels[i].sample_id = -1;
     }
     g_audio_ready = 0;
     g_sfx_frame_id = 0;
     g_device = 0;
+    SDL_AtomicSet(&g_sfx_ring_head, 0);
+    SDL_AtomicSet(&g_sfx_ring_tail, 0);
 
     if (SDL_InitSubSystem(SDL_INIT_AUDIO) < 0) {
         printf("[AUDIO] SDL_Init AUDIO failed: %s\n", SDL_GetError());
@@ -528,10 +1045,14 @@ void audio_init(void)
         io_make_data_path(first_path, sizeof(first_path), "sounds/scream");
         printf("[AUDIO] Loading sound effects from data/sounds (e.g. %s or %s.wav)\n", first_path, first_path);
     }
-    int loaded_count = 0;
-    for (int i = 0; i < MAX_SAMPLES; i++) {
-        loaded_count += load_one_sample(i);
-    }
+    int loaded_count = load_all_samples();
+
+    g_music.ring = (Sint16 *)SDL_malloc(MUSIC_RING_SAMPLES * sizeof(Sint16));
+    if (!g_music.ring)
+        printf("[MUSIC] out of memory for the stream ring; music disabled\n");
+#if AB3D_MUSIC_STREAM_THREAD
+    music_stream_thread_start();
+#endif
 
     SDL_PauseAudioDevice(g_device, 0);
     g_audio_ready = 1;
@@ -563,6 +1084,9 @@ void audio_set_master_volume(int volume_0_to_100)
 
 void audio_shutdown(void)
 {
+#if AB3D_MUSIC_STREAM_THREAD
+    music_stream_thread_stop();
+#endif
     if (g_device) {
         SDL_LockAudioDevice(g_device);
         music_unload_locked();
@@ -572,6 +1096,8 @@ void audio_shutdown(void)
     } else {
         music_unload_locked();
     }
+    SDL_free(g_music.ring);
+    g_music.ring = NULL;
     free_samples();
     SDL_QuitSubSystem(SDL_INIT_AUDIO);
     g_audio_ready = 0;
@@ -620,9 +1146,9 @@ void audio_init_player(void)       { /* no-op: single mixed callback backend */
 void audio_stop_player(void)
 {
     if (!g_audio_ready || g_device == 0) return;
-    SDL_LockAudioDevice(g_device);
+    music_lock();
     music_stop_locked();
-    SDL_UnlockAudioDevice(g_device);
+    music_unlock();
 }
 
 void audio_rem_player(void)        { audio_unload_module(); }
@@ -633,52 +1159,55 @@ void audio_load_module(const char *filename)
 
     char subpath[256];
     char loaded_path[512];
-    Uint8 *data = NULL;
-    Uint32 len = 0;
+    MusicSource src;
 
     normalize_module_subpath(filename, subpath, sizeof(subpath));
     if (!subpath[0]) return;
 
-    if (!load_wav_converted(subpath, loaded_path, sizeof(loaded_path), &data, &len)) {
-        SDL_LockAudioDevice(g_device);
+    if (!g_music.ring || !music_open_source(subpath, loaded_path, sizeof(loaded_path), &src)) {
+        music_lock();
         music_unload_locked();
-        SDL_UnlockAudioDevice(g_device);
+        music_unlock();
         printf("[MUSIC] missing/unreadable module wav: %s\n", subpath);
         return;
     }
 
-    SDL_LockAudioDevice(g_device);
+    music_lock();
     music_unload_locked();
-    g_music.data = data;
-    g_music.length = len;
-    g_music.position = 0;
+    g_music.file = src.file;
+    g_music.mem = src.mem;
+    g_music.data_start = src.data_start;
+    g_music.data_bytes = src.data_bytes;
+    g_music.frame_bytes = src.frame_bytes;
+    g_music.cvt = src.cvt;
+    g_music.total_samples = src.total_samples;
     g_music.loaded = 1;
     g_music.playing = 0;
     g_music.loop = 1;
     g_music.volume = MUSIC_DEFAULT_VOL;
-    SDL_UnlockAudioDevice(g_device);
+    music_rewind_locked();
+    music_unlock();
 
-    printf("[MUSIC] loaded: %s (%u bytes converted)\n", loaded_path, (unsigned)len);
+    printf("[MUSIC] loaded: %s (%s, %u bytes PCM)\n", loaded_path,
+           src.file ? "streamed" : "decoded in memory", (unsigned)src.data_bytes);
 }
 
 void audio_init_module(void)
 {
     if (!g_audio_ready || g_device == 0) return;
-    SDL_LockAudioDevice(g_device);
-    if (g_music.loaded) {
-        g_music.position = 0;
-    }
-    SDL_UnlockAudioDevice(g_device);
+    music_lock();
+    music_rewind_locked();
+    music_unlock();
 }
 
 void audio_play_module(void)
 {
     if (!g_audio_ready || g_device == 0) return;
-    SDL_LockAudioDevice(g_device);
-    if (g_music.loaded && g_music.data && g_music.length > 0) {
+    music_lock();
+    if (g_music.loaded) {
         g_music.playing = 1;
     }
-    SDL_UnlockAudioDevice(g_device);
+    music_unlock();
 }
 
 void audio_play_module_blocking_once_with_tick(const char *filename,
@@ -691,14 +1220,14 @@ void audio_play_module_blocking_once_with_tick(const char *filename,
     audio_load_module(filename);
 
     int started = 0;
-    SDL_LockAudioDevice(g_device);
-    if (g_music.loaded && g_music.data && g_music.length > 0) {
+    music_lock();
+    if (g_music.loaded) {
         g_music.loop = 0;
-        g_music.position = 0;
+        music_rewind_locked(); /* re-prefill so a short track already ends, not wraps */
         g_music.playing = 1;
         started = 1;
     }
-    SDL_UnlockAudioDevice(g_device);
+    music_unlock();
 
     if (!started) return;
 
@@ -712,8 +1241,8 @@ void audio_play_module_blocking_once_with_tick(const char *filename,
         Uint32 len = 0;
         SDL_LockAudioDevice(g_device);
         playing = g_music.playing;
-        pos = g_music.position;
-        len = g_music.length;
+        pos = g_music.played;
+        len = g_music.total_samples;
         SDL_UnlockAudioDevice(g_device);
         if (tick) {
             float progress = 0.0f;
@@ -740,14 +1269,14 @@ int audio_start_one_shot_module(const char *filename)
     audio_load_module(filename);
 
     int started = 0;
-    SDL_LockAudioDevice(g_device);
-    if (g_music.loaded && g_music.data && g_music.length > 0) {
+    music_lock();
+    if (g_music.loaded) {
         g_music.loop = 0;
-        g_music.position = 0;
+        music_rewind_locked(); /* re-prefill so a short track already ends, not wraps */
         g_music.playing = 1;
         started = 1;
     }
-    SDL_UnlockAudioDevice(g_device);
+    music_unlock();
 
     if (started)
         printf("[MUSIC] one-shot start: %s\n", filename);
@@ -757,11 +1286,10 @@ int audio_start_one_shot_module(const char *filename)
 unsigned int audio_music_duration_ms(void)
 {
     if (!g_audio_ready || g_device == 0) return 1u;
-    int bpf = (int)g_spec.channels * (SDL_AUDIO_BITSIZE(g_spec.format) / 8);
-    if (bpf < 1) bpf = 1;
-    if (g_music.length == 0) return 1u;
-    double bytes_per_sec = (double)g_spec.freq * (double)bpf;
-    Uint32 duration_ms = (Uint32)((double)g_music.length / bytes_per_sec * 1000.0 + 0.5);
+    int channels = (g_spec.channels > 0) ? (int)g_spec.channels : 1;
+    if (g_music.total_samples == 0) return 1u;
+    double samples_per_sec = (double)g_spec.freq * (double)channels;
+    Uint32 duration_ms = (Uint32)((double)g_music.total_samples / samples_per_sec * 1000.0 + 0.5);
     if (duration_ms < 1u) duration_ms = 1u;
     if (duration_ms > 600000u) duration_ms = 600000u;
     return (unsigned int)duration_ms;
@@ -770,9 +1298,9 @@ unsigned int audio_music_duration_ms(void)
 void audio_stop_one_shot_module(void)
 {
     if (!g_device) return;
-    SDL_LockAudioDevice(g_device);
+    music_lock();
     music_stop_locked();
-    SDL_UnlockAudioDevice(g_device);
+    music_unlock();
 }
 #endif
 
@@ -783,13 +1311,9 @@ void audio_play_module_blocking_once(const char *filename)
 
 void audio_unload_module(void)
 {
-    if (g_device) {
-        SDL_LockAudioDevice(g_device);
-        music_unload_locked();
-        SDL_UnlockAudioDevice(g_device);
-    } else {
-        music_unload_locked();
-    }
+    music_lock();
+    music_unload_locked();
+    music_unlock();
 }
 
 void audio_begin_frame(void)
@@ -809,7 +1333,7 @@ void audio_play_sfx(int sfx_id, int volume, int channel)
     audio_play_sample(sfx_id, volume);
 }
 
-void audio_play_sample(int sample_id, int volume)
+static void sfx_play(int sample_id, int volume)
 {
     if (!g_audio_ready || g_device == 0)
         return;
@@ -843,31 +1367,40 @@ void audio_play_sample(int sample_id, int volume)
         g_sample_last_played_frame[sample_id] = g_sfx_frame_id;
     }
 
-    SDL_LockAudioDevice(g_device);
+    sfx_push_command(SFX_CMD_PLAY, sample_id, volume,
+                     (sample_id < NUM_NAMED_SFX) ? sfx_priority[sample_id] : 2);
+}
 
-    /* Pick a channel that minimizes audible stomping. */
-    int chan = choose_channel_for_play();
-    Channel *ch = &g_channels[chan];
+void audio_play_sample(int sample_id, int volume)
+{
+    sfx_play(sample_id, volume);
+}
 
-    ch->sample_data = g_samples[sample_id].data;
-    ch->sample_len  = g_samples[sample_id].length;
-    ch->position    = 0;
-    ch->volume      = volume;
-    ch->sample_id   = sample_id;
+void audio_set_listener(int32_t x, int32_t z)
+{
+    g_listener_x = x;
+    g_listener_z = z;
+}
 
-    SDL_UnlockAudioDevice(g_device);
+void audio_play_sample_at(int sample_id, int volume, int32_t x, int32_t z)
+{
+    int32_t dx = x - g_listener_x;
+    int32_t dz = z - g_listener_z;
+    if (dx < 0) dx = -dx;
+    if (dz < 0) dz = -dz;
+    /* |dx|+|dz| octagonal estimate, like CalcDist */
+    int32_t dist = (dx > dz) ? dx + dz / 2 : dz + dx / 2;
+    if (dist > AUDIO_NEAR_DIST) {
+        volume = (int)(((int64_t)volume * AUDIO_NEAR_DIST) / dist);
+        if (volume <= 0) return; /* inaudible: not even a virtual voice */
+    }
+    sfx_play(sample_id, volume);
 }
 
 void audio_stop_all(void)
 {
     if (!g_audio_ready || g_device == 0) return;
-    SDL_LockAudioDevice(g_device);
-    for (int c = 0; c < MAX_CHANNELS; c++) {
-        g_channels[c].sample_data = NULL;
-        g_channels[c].position = 0;
-        g_channels[c].sample_id = -1;
-    }
-    SDL_UnlockAudioDevice(g_device);
+    sfx_push_command(SFX_CMD_STOP_ALL, 0, 0, 0);
 }
 
 void audio_mt_init(void)
@@ -885,12 +1418,12 @@ void audio_mt_init(void)
 void audio_mt_end(void)
 {
     if (!g_audio_ready || g_device == 0) return;
-    SDL_LockAudioDevice(g_device);
+    music_lock();
     if (g_music.playing) {
         music_stop_locked();
-        SDL_UnlockAudioDevice(g_device);
+        music_unlock();
         printf("[MUSIC] in-game music stopped\n");
         return;
     }
-    SDL_UnlockAudioDevice(g_device);
+    music_unlock();
 }
@@ -8,6 +8,8 @@
 #ifndef AUDIO_H
 #define AUDIO_H
 
+#include <stdint.h>
+
 /* Lifecycle */
 void audio_init(void);
 void audio_shutdown(void);
@@ -40,7 +42,15 @@ void audio_stop_one_shot_module(void);
 void audio_begin_frame(void); /* Reset per-frame SFX dedupe state (call once per game logic tick). */
 void audio_play_sfx(int sfx_id, int volume, int channel);
 void audio_play_sample(int sample_id, int volume); /* MakeSomeNoise simplified */
+/* Positional variant: volume falls off with distance from the listener set by
+ * audio_set_listener (world units). Voices beyond MAX_CHANNELS are ranked by
+ * per-sample priority * volume and the quietest are tracked but not mixed. */
+void audio_set_listener(int32_t x, int32_t z);
+void audio_play_sample_at(int sample_id, int volume, int32_t x, int32_t z);
 void audio_stop_all(void);
+/* Mixer callback cost in microseconds: the last call and the longest since the previous
+ * query (which resets it); *budget_us is the playback time of one device buffer. */
+void audio_get_callback_stats(int *last_us, int *peak_us, int *budget_us);
 
 /* In-game music (mt_init / mt_end from SoundPlayer.s) */
 void audio_mt_init(void);
@@ -0,0 +1,375 @@
+/*
+ * benchmark.c - Deterministic render benchmark (--benchmark <level> <path>).
+ *
+ * Path script format (one segment per line, '#' starts a comment):
+ *
+ *     <ticks> <key> [<key> ...]
+ *
+ * where <ticks> is a count of 50Hz logic ticks and each <key> is one of
+ * idle, forward, backward, turn_left, turn_right, sidestep_left,
+ * sidestep_right, run. The keys map onto player_default_keys() and are held
+ * for the whole segment. "builtin" selects the precomputed flythrough below.
+ */
+
+#include "benchmark.h"
+#include "control_loop.h"
+#include "game_loop.h"
+#include "player.h"
+#include "display.h"
+#include "renderer.h"
+#include <SDL.h>
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "logging.h"
+#define printf ab3d_log_printf
+
+enum {
+    BENCH_KEY_FORWARD        = 1 << 0,
+    BENCH_KEY_BACKWARD       = 1 << 1,
+    BENCH_KEY_TURN_LEFT      = 1 << 2,
+    BENCH_KEY_TURN_RIGHT     = 1 << 3,
+    BENCH_KEY_SIDESTEP_LEFT  = 1 << 4,
+    BENCH_KEY_SIDESTEP_RIGHT = 1 << 5,
+    BENCH_KEY_RUN            = 1 << 6
+};
+
+/* Frames excluded from the summary while caches, arenas and AI wake-up settle. */
+#define BENCH_SUMMARY_SKIP_FRAMES 30
+#define BENCH_MAX_SEGMENTS        4096
+
+typedef struct {
+    int ticks;
+    unsigned keys;
+} BenchSegment;
+
+/* Keyboard turning tops out at 2*MAX_TURN_WALK = 70 angle units per tick, so ~118 ticks
+ * is one full turn. Spin in place, walk, run, and sweep back across the start area. */
+static const BenchSegment k_builtin_path[] = {
+    {  60, 0 },
+    { 118, BENCH_KEY_TURN_LEFT },
+    { 150, BENCH_KEY_FORWARD },
+    {  30, BENCH_KEY_TURN_RIGHT },
+    { 150, BENCH_KEY_FORWARD | BENCH_KEY_RUN },
+    {  60, BENCH_KEY_FORWARD | BENCH_KEY_TURN_LEFT },
+    { 100, BENCH_KEY_SIDESTEP_LEFT },
+    { 150, BENCH_KEY_FORWARD | BENCH_KEY_RUN },
+    {  59, BENCH_KEY_TURN_RIGHT },
+    { 150, BENCH_KEY_FORWARD },
+    { 118, BENCH_KEY_TURN_RIGHT }
+};
+
+typedef struct {
+    int x, z;
+    int angle;
+    int zone;
+    double frame_ms;
+    double sim_ms;
+    double present_ms;
+    RendererFrameTimings r;
+} BenchFrame;
+
+static const struct {
+    const char *name;
+    unsigned bit;
+} k_bench_key_names[] = {
+    { "idle",           0 },
+    { "forward",        BENCH_KEY_FORWARD },
+    { "backward",       BENCH_KEY_BACKWARD },
+    { "turn_left",      BENCH_KEY_TURN_LEFT },
+    { "turn_right",     BENCH_KEY_TURN_RIGHT },
+    { "sidestep_left",  BENCH_KEY_SIDESTEP_LEFT },
+    { "sidestep_right", BENCH_KEY_SIDESTEP_RIGHT },
+    { "run",            BENCH_KEY_RUN }
+};
+
+int benchmark_parse_args(int argc, char *argv[], BenchmarkOptions *out)
+{
+    int requested = 0;
+
+    out->level = 0;
+    out->path = NULL;
+    out->out_path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--benchmark") == 0) {
+            if (i + 2 >= argc) {
+                fprintf(stderr, "[BENCH] usage: --benchmark <level 1-16> <path|builtin> [--benchmark-out <file>]\n");
+                return -1;
+            }
+            out->level = atoi(argv[i + 1]);
+            out->path = argv[i + 2];
+            requested = 1;
+            i += 2;
+        } else if (strcmp(argv[i], "--benchmark-out") == 0 && i + 1 < argc) {
+            out->out_path = argv[++i];
+        }
+    }
+    if (!requested) return 0;
+    if (out->level < 1 || out->level > MAX_LEVELS) {
+        fprintf(stderr, "[BENCH] level must be 1..%d\n", MAX_LEVELS);
+        return -1;
+    }
+    return 1;
+}
+
+/* Returns the segment count (0 = nothing usable). */
+static int bench_load_path(const char *path, BenchSegment *segs, int max_segs)
+{
+    char line[256];
+    int n = 0;
+    FILE *f;
+
+    if (!path || strcmp(path, "builtin") == 0) {
+        n = (int)(sizeof(k_builtin_path) / sizeof(k_builtin_path[0]));
+        memcpy(segs, k_builtin_path, sizeof(k_builtin_path));
+        return n;
+    }
+    f = fopen(path, "r");
+    if (!f) {
+        printf("[BENCH] cannot open path script: %s\n", path);
+        return 0;
+    }
+    for (int line_no = 1; fgets(line, sizeof(line), f) && n < max_segs; line_no++) {
+        char *hash = strchr(line, '#');
+        char *tok;
+        int ticks;
+        unsigned keys = 0;
+        if (hash) *hash = '\0';
+        tok = strtok(line, " \t\r\n");
+        if (!tok) continue;
+        ticks = atoi(tok);
+        if (ticks <= 0) {
+            printf("[BENCH] %s:%d: tick count must be positive\n", path, line_no);
+            continue;
+        }
+        while ((tok = strtok(NULL, " \t\r\n")) != NULL) {
+            int found = 0;
+            for (size_t k = 0; k < sizeof(k_bench_key_names) / sizeof(k_bench_key_names[0]); k++) {
+                if (strcmp(tok, k_bench_key_names[k].name) == 0) {
+                    keys |= k_bench_key_names[k].bit;
+                    found = 1;
+                    break;
+                }
+            }
+            if (!found) printf("[BENCH] %s:%d: unknown key '%s' ignored\n", path, line_no, tok);
+        }
+        segs[n].ticks = ticks;
+        segs[n].keys = keys;
+        n++;
+    }
+    fclose(f);
+    return n;
+}
+
+static void bench_fill_key_map(uint8_t key_map[128], unsigned keys)
+{
+    const KeyBindings *kb = player_default_keys();
+    memset(key_map, 0, 128);
+    if (keys & BENCH_KEY_FORWARD)        key_map[kb->forward] = 1;
+    if (keys & BENCH_KEY_BACKWARD)       key_map[kb->backward] = 1;
+    if (keys & BENCH_KEY_TURN_LEFT)      key_map[kb->turn_left] = 1;
+    if (keys & BENCH_KEY_TURN_RIGHT)     key_map[kb->turn_right] = 1;
+    if (keys & BENCH_KEY_SIDESTEP_LEFT)  key_map[kb->sidestep_left] = 1;
+    if (keys & BENCH_KEY_SIDESTEP_RIGHT) key_map[kb->sidestep_right] = 1;
+    if (keys & BENCH_KEY_RUN)            key_map[kb->run] = 1;
+}
+
+static int bench_cmp_double(const void *a, const void *b)
+{
+    double da = *(const double *)a, db = *(const double *)b;
+    return (da > db) - (da < db);
+}
+
+static int bench_out_is_json(const char *out_path)
+{
+    size_t len = strlen(out_path);
+    if (len < 5) return 0;
+    return tolower((unsigned char)out_path[len - 5]) == '.' &&
+           tolower((unsigned char)out_path[len - 4]) == 'j' &&
+           tolower((unsigned char)out_path[len - 3]) == 's' &&
+           tolower((unsigned char)out_path[len - 2]) == 'o' &&
+           tolower((unsigned char)out_path[len - 1]) == 'n';
+}
+
+#define BENCH_FIELDS(X)                                         \
+    X("frame_ms",      fr->frame_ms)                            \
+    X("sim_ms",        fr->sim_ms)                              \
+    X("render_ms",     fr->r.total_ms)                          \
+    X("rotate_ms",     fr->r.rotate_ms)                         \
+    X("prepass_ms",    fr->r.prepass_ms)                        \
+    X("world_ms",      fr->r.world_ms)                          \
+    X("wall_cpu_ms",   fr->r.wall_cpu_ms)                       \
+    X("floor_cpu_ms",  fr->r.floor_cpu_ms)                      \
+    X("sprite_cpu_ms", fr->r.sprite_cpu_ms)                     \
+    X("tint_ms",       fr->r.tint_ms)                           \
+    X("gun_ms",        fr->r.gun_ms)                            \
+    X("swap_ms",       fr->r.swap_ms)                           \
+    X("present_ms",    fr->present_ms)
+
+static int bench_write_output(const char *out_path, const BenchmarkOptions *opts,
+                              const BenchFrame *frames, int count)
+{
+    FILE *f = fopen(out_path, "w");
+    int json = bench_out_is_json(out_path);
+
+    if (!f) {
+        printf("[BENCH] cannot write %s\n", out_path);
+        return 0;
+    }
+    if (json) {
+        fprintf(f, "{\n  \"level\": %d,\n  \"path\": \"", opts->level);
+        for (const char *p = opts->path; *p; p++) {
+            if (*p == '"' || *p == '\\') fputc('\\', f);
+            fputc(*p, f);
+        }
+        fprintf(f, "\",\n  \"width\": %d,\n  \"height\": %d,\n  \"frames\": [\n",
+                renderer_get_width(), renderer_get_height());
+        for (int i = 0; i < count; i++) {
+            const BenchFrame *fr = &frames[i];
+            fprintf(f, "    {\"frame\": %d, \"x\": %d, \"z\": %d, \"angle\": %d, \"zone\": %d, \"world_workers\": %d",
+                    i, fr->x, fr->z, fr->angle, fr->zone, fr->r.world_workers);
+#define BENCH_JSON_FIELD(name, value) fprintf(f, ", \"" name "\": %.4f", (value));
+            BENCH_FIELDS(BENCH_JSON_FIELD)
+#undef BENCH_JSON_FIELD
+            fprintf(f, "}%s\n", (i + 1 < count) ? "," : "");
+        }
+        fprintf(f, "  ]\n}\n");
+    } else {
+        fprintf(f, "frame,x,z,angle,zone,world_workers");
+#define BENCH_CSV_HEADER(name, value) fprintf(f, "," name);
+        BENCH_FIELDS(BENCH_CSV_HEADER)
+#undef BENCH_CSV_HEADER
+        fprintf(f, "\n");
+        for (int i = 0; i < count; i++) {
+            const BenchFrame *fr = &frames[i];
+            fprintf(f, "%d,%d,%d,%d,%d,%d", i, fr->x, fr->z, fr->angle, fr->zone, fr->r.world_workers);
+#define BENCH_CSV_FIELD(name, value) fprintf(f, ",%.4f", (value));
+            BENCH_FIELDS(BENCH_CSV_FIELD)
+#undef BENCH_CSV_FIELD
+            fprintf(f, "\n");
+        }
+    }
+    fclose(f);
+    return 1;
+}
+
+static void bench_log_summary(const BenchmarkOptions *opts, const BenchFrame *frames, int count)
+{
+    int first = (count > BENCH_SUMMARY_SKIP_FRAMES * 2) ? BENCH_SUMMARY_SKIP_FRAMES : 0;
+    int n = count - first;
+    double *sorted;
+    double sum_frame = 0.0, sum_render = 0.0, sum_world = 0.0, sum_present = 0.0;
+
+    if (n <= 0) return;
+    sorted = (double *)malloc((size_t)n * sizeof(double));
+    if (!sorted) return;
+    for (int i = 0; i < n; i++) {
+        const BenchFrame *fr = &frames[first + i];
+        sorted[i] = fr->frame_ms;
+        sum_frame += fr->frame_ms;
+        sum_render += fr->r.total_ms;
+        sum_world += fr->r.world_ms;
+        sum_present += fr->present_ms;
+    }
+    qsort(sorted, (size_t)n, sizeof(double), bench_cmp_double);
+    printf("[BENCH] level %d %dx%d: %d frames (first %d skipped) frame avg %.3f ms p50 %.3f p95 %.3f p99 %.3f max %.3f\n",
+           opts->level, renderer_get_width(), renderer_get_height(), n, first,
+           sum_frame / n,
+           sorted[n / 2],
+           sorted[(int)((double)(n - 1) * 0.95)],
+           sorted[(int)((double)(n - 1) * 0.99)],
+           sorted[n - 1]);
+    printf("[BENCH] level %d: render avg %.3f ms (world %.3f) present avg %.3f ms\n",
+           opts->level, sum_render / n, sum_world / n, sum_present / n);
+    free(sorted);
+}
+
+int benchmark_run(GameState *state, const BenchmarkOptions *opts)
+{
+    BenchSegment *segs;
+    BenchFrame *frames = NULL;
+    int seg_count;
+    int total_ticks = 0;
+    int count = 0;
+    char default_out[64];
+    const char *out_path = opts->out_path;
+    uint8_t key_map[128];
+    bool copper_screen_ready = false;
+    GameLoopCtx ctx;
+    int ok;
+
+    segs = (BenchSegment *)calloc(BENCH_MAX_SEGMENTS, sizeof(BenchSegment));
+    if (!segs) return 1;
+    seg_count = bench_load_path(opts->path, segs, BENCH_MAX_SEGMENTS);
+    for (int i = 0; i < seg_count; i++) total_ticks += segs[i].ticks;
+    if (total_ticks <= 0) {
+        printf("[BENCH] empty camera path\n");
+        free(segs);
+        return 1;
+    }
+    frames = (BenchFrame *)calloc((size_t)total_ticks, sizeof(BenchFrame));
+    if (!frames) {
+        free(segs);
+        return 1;
+    }
+    if (!out_path) {
+        snprintf(default_out, sizeof(default_out), "benchmark_level%02d.csv", opts->level);
+        out_path = default_out;
+    }
+
+    play_game_load_shared_assets(state);
+    state->current_level = (int16_t)(opts->level - 1);
+    state->max_level = state->current_level;
+    /* Same camera every run: no death, keyboard-only control (mouse look ignored),
+     * serial present so present_ms is not hidden behind the next frame's render. */
+    state->infinite_health = true;
+    state->cfg_present_pipeline = false;
+    memset(&state->plr1_control, 0, sizeof(state->plr1_control));
+    state->plr1_control.keys = true;
+
+    play_the_game_prepare_level(state, &copper_screen_ready);
+
+    game_loop_ctx_init(&ctx, state);
+    ctx.fixed_step = 1;
+    ctx.fixed_clock_ms = 0;
+    ctx.last_ticks = 0;
+    ctx.scripted_key_map = key_map;
+    renderer_set_frame_timing_capture(1);
+
+    printf("[BENCH] level %d, path %s: %d segments, %d ticks -> %s\n",
+           opts->level, opts->path, seg_count, total_ticks, out_path);
+
+    for (int s = 0; s < seg_count && state->running; s++) {
+        bench_fill_key_map(key_map, segs[s].keys);
+        for (int t = 0; t < segs[s].ticks && state->running; t++) {
+            BenchFrame *fr = &frames[count];
+            Uint64 t0 = SDL_GetPerformanceCounter();
+            game_loop_tick(state, &ctx);
+            fr->frame_ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 /
+                           (double)SDL_GetPerformanceFrequency();
+            if (!renderer_get_last_frame_timings(&fr->r)) memset(&fr->r, 0, sizeof(fr->r));
+            fr->present_ms = display_last_present_ms();
+            fr->sim_ms = fr->frame_ms - fr->r.total_ms - fr->present_ms;
+            if (fr->sim_ms < 0.0) fr->sim_ms = 0.0;
+            fr->x = (int)(state->plr1.xoff >> 16);
+            fr->z = (int)(state->plr1.zoff >> 16);
+            fr->angle = (int)state->plr1.angpos;
+            fr->zone = (int)state->plr1.zone;
+            count++;
+        }
+    }
+    if (count < total_ticks) {
+        printf("[BENCH] level ended after %d of %d ticks (ESC, end zone or quit)\n", count, total_ticks);
+    }
+
+    renderer_set_frame_timing_capture(0);
+    ok = bench_write_output(out_path, opts, frames, count);
+    bench_log_summary(opts, frames, count);
+    state->running = false;
+    play_the_game_finalize_session(state);
+
+    free(frames);
+    free(segs);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,29 @@
+/*
+ * benchmark.h - Deterministic render benchmark (--benchmark <level> <path>).
+ *
+ * Loads one level the same way PlayTheGame does, then drives player 1 with
+ * scripted keyboard input at a fixed 50Hz tick (one logic step per rendered
+ * frame, synthetic clock) so every run of the same build sees the same camera
+ * path. VSync is off and per-frame phase times are written as CSV or JSON.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "game_state.h"
+
+typedef struct {
+    int level;              /* 1-based, as in ab3d.ini start_level */
+    const char *path;       /* camera path script, or "builtin" */
+    const char *out_path;   /* .json => JSON, anything else => CSV */
+} BenchmarkOptions;
+
+/* Parse --benchmark <level> <path> [--benchmark-out <file>] from argv.
+ * Returns 1 when benchmark mode was requested and the arguments are valid,
+ * 0 when not requested, -1 on malformed arguments (message already printed). */
+int benchmark_parse_args(int argc, char *argv[], BenchmarkOptions *out);
+
+/* Run the benchmark after setup_game. Returns 0 on success (process exit code). */
+int benchmark_run(GameState *state, const BenchmarkOptions *opts);
+
+#endif /* BENCHMARK_H */
@@ -24,7 +24,9 @@
 #include "game_loop.h"
 #include "game_data.h"
 #include "level.h"
+#include "level_bake.h"
 #include "objects.h"
+#include "visibility.h"
 #include "player.h"
 #include "display.h"
 #include "renderer.h"
@@ -32,6 +34,8 @@
 #include "audio.h"
 #include "io.h"
 #include "settings.h"
+#include "asset_loader.h"
+#include "replay.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -102,7 +106,7 @@ static int16_t control_read_be16(const uint8_t *p)
 
 /* Rebuild per-level condition bits from loaded level state.
  * Prevents switch/key conditions from leaking between levels (e.g. level 2 exit switch puzzle). */
-static void game_rebuild_level_conditions(GameState *state)
+void game_rebuild_level_conditions(GameState *state)
 {
     if (!state) {
         game_conditions = 0;
@@ -272,6 +276,124 @@ int read_main_menu(GameState *state)
     return 1; /* play game selected */
 }
 
+/* -----------------------------------------------------------------------
+ * Background loading
+ *
+ * Shared assets (walls, floor, sky, sprites, vec objects, sfx) go to the
+ * loader thread as soon as prefs are read; the gun graphics stay on the main
+ * thread because their GL upload must happen there. The next level's
+ * data/graphics/clips files are prefetched into a staging LevelState while
+ * the level-complete fade still runs; play_the_game_prepare_level adopts
+ * them when the level number matches and parses on the main thread as before.
+ * ----------------------------------------------------------------------- */
+static AssetJob *s_shared_assets_job = NULL;
+static int s_shared_assets_failed = 0; /* written by the job, read after asset_job_wait */
+
+static LevelState s_prefetch_level;
+static int s_prefetch_level_num = -1;
+static AssetJob *s_prefetch_job = NULL;
+
+static void control_load_shared_assets(void)
+{
+    io_load_walls();
+    io_load_floor();
+    io_load_sky();
+    io_load_objects();
+    io_load_vec_objects();
+    io_load_sfx();
+}
+
+static void control_load_shared_assets_job(void *userdata)
+{
+    (void)userdata;
+    /* A missing file must not exit() on the loader thread: hand it back to
+     * control_wait_shared_assets, which exits on the main thread. */
+    s_shared_assets_failed = (io_run_catching_fatal(control_load_shared_assets) != 0);
+}
+
+static void control_wait_shared_assets(void)
+{
+    asset_job_wait(s_shared_assets_job);
+    s_shared_assets_job = NULL;
+    if (s_shared_assets_failed) {
+        fprintf(stderr, "[GAME] FATAL: shared asset load failed (see [IO] error above)\n");
+        exit(1);
+    }
+}
+
+static void control_prefetch_level_job(void *userdata)
+{
+    int level_num = *(const int *)userdata;
+    /* Never io_fatal_missing here: a bad file is left for the foreground load to report. */
+    io_try_load_level_files(&s_prefetch_level, level_num);
+}
+
+static void control_drop_level_prefetch(void)
+{
+    asset_job_wait(s_prefetch_job);
+    s_prefetch_job = NULL;
+    io_release_level_files(&s_prefetch_level);
+    s_prefetch_level_num = -1;
+}
+
+static void control_prefetch_level(int level_num)
+{
+    if (level_num < 0 || level_num >= MAX_LEVELS) return;
+    if (s_prefetch_level_num == level_num) return;
+    control_drop_level_prefetch();
+    s_prefetch_level_num = level_num;
+    s_prefetch_job = asset_job_submit("level prefetch", control_prefetch_level_job,
+                                      &s_prefetch_level_num);
+}
+
+/* Move the prefetched files into level (must be released). 0 if no match. */
+static int control_take_level_prefetch(LevelState *level, int level_num)
+{
+    if (s_prefetch_level_num != level_num) {
+        if (s_prefetch_level_num >= 0) control_drop_level_prefetch();
+        return 0;
+    }
+    asset_job_wait(s_prefetch_job);
+    s_prefetch_job = NULL;
+    if (!s_prefetch_level.data || !s_prefetch_level.graphics || !s_prefetch_level.clips) {
+        control_drop_level_prefetch();
+        return 0;
+    }
+    level->data = s_prefetch_level.data;
+    level->data_byte_count = s_prefetch_level.data_byte_count;
+    level->graphics = s_prefetch_level.graphics;
+    level->graphics_byte_count = s_prefetch_level.graphics_byte_count;
+    level->clips = s_prefetch_level.clips;
+    level->clips_byte_count = s_prefetch_level.clips_byte_count;
+    memset(&s_prefetch_level, 0, sizeof(s_prefetch_level));
+    s_prefetch_level_num = -1;
+    return 1;
+}
+
+void play_the_game_reset_level_session(GameState *state)
+{
+    state->num_explosions = 0;
+    state->num_pending_blasts = 0;
+
+    /* ---- Audio setup ---- */
+    audio_mt_init();
+
+    /* ---- Clear keyboard ---- */
+    input_clear_keyboard(state->key_map);
+
+    /* ---- Set initial state ---- */
+    state->hitcol = 0;
+    state->hitcol2 = 0;
+    state->master_quitting = false;
+    state->slave_quitting = (state->mode == MODE_SINGLE);
+    state->do_anything = true;
+
+    if (state->mode != MODE_SINGLE) {
+        state->plr1.energy = PLAYER_MAX_ENERGY;
+    }
+    state->plr2.energy = PLAYER_MAX_ENERGY;
+}
+
 /*
  * play_the_game - Runs a single level from start to death/completion
  *
@@ -294,6 +416,7 @@ int read_main_menu(GameState *state)
 void play_the_game_prepare_level(GameState *state, bool *copper_screen_ready)
 {
     state->running = true;
+    replay_record_level_prepare(state);
 
     printf("[GAME] === PlayTheGame: level %d ===\n", state->current_level);
 
@@ -306,10 +429,17 @@ void play_the_game_prepare_level(GameState *state, bool *copper_screen_ready)
         *copper_screen_ready = true;
     }
 
-    /* ---- Load level data ---- */
-    io_load_level_data(&state->level, state->current_level);
-    io_load_level_graphics(&state->level, state->current_level);
-    io_load_level_clips(&state->level, state->current_level);
+    /* ---- Load level data (prefetched during the previous fade when possible) ---- */
+    if (control_take_level_prefetch(&state->level, state->current_level)) {
+        printf("[GAME] Level %d files taken from prefetch\n", state->current_level);
+    } else {
+        io_load_level_data(&state->level, state->current_level);
+        io_load_level_graphics(&state->level, state->current_level);
+        io_load_level_clips(&state->level, state->current_level);
+    }
+
+    /* Sky cache / object sizes below need the shared assets in place. */
+    control_wait_shared_assets();
 
     /* ---- Parse level data (blag:) ----
          * Original resolves offsets in level data to absolute pointers:
@@ -320,7 +450,9 @@ void play_the_game_prepare_level(GameState *state, bool *copper_screen_ready)
          */
     /* Parse when level was loaded from file (raw data): zone_adds/points are only set by parse or stub. */
     if (state->level.data && state->level.graphics && !state->level.zone_adds) {
+        io_load_level_bake(&state->level, state->current_level);
         level_parse(&state->level);
+        can_it_be_seen_invalidate_level();
 
         /* Assign clip data to zone graph lists */
         if (state->level.clips && state->level.num_zones > 0) {
@@ -354,16 +486,23 @@ void play_the_game_prepare_level(GameState *state, bool *copper_screen_ready)
 
     /* Apply one-time level-specific data fixes at load time.
      * Keep this outside the parse-only branch so it still runs when
-     * pointers were already resolved by the loader path. */
-    level_apply_level_specific_fixes(&state->level, state->current_level);
+     * pointers were already resolved by the loader path. A baked level
+     * carries their result as a patch list. */
+    if (!level_bake_apply_fixes(&state->level))
+        level_apply_level_specific_fixes(&state->level, state->current_level);
+    if (!state->level.decoded)
+        level_build_decoded(&state->level);
+    level_build_zone_grid(&state->level);
 
     printf("[GAME] Shot pools: player=%d nasty=%d object_points=%d\n",
            PLAYER_SHOT_SLOT_COUNT,
-           NASTY_SHOT_SLOT_COUNT,
+           (int)state->level.nasty_shot_slots,
            (int)state->level.num_object_points);
     /* Ensure each object has world size in its record (Amiga style), for file and test levels */
     if (state->level.object_data && state->level.num_object_points > 0)
         object_init_world_sizes_from_types(&state->level);
+    /* Pristine level for delta saves; before any F9 restore touches it. */
+    player_save_capture_baseline(state);
     if (!state->f9_pending_apply_save) {
         renderer_build_level_sky_cache(&state->level);
     }
@@ -377,26 +516,7 @@ void play_the_game_prepare_level(GameState *state, bool *copper_screen_ready)
         player_init_from_level(state);
     }
 
-    state->num_explosions = 0;
-    state->num_pending_blasts = 0;
-
-    /* ---- Audio setup ---- */
-    audio_mt_init();
-
-    /* ---- Clear keyboard ---- */
-    input_clear_keyboard(state->key_map);
-
-    /* ---- Set initial state ---- */
-    state->hitcol = 0;
-    state->hitcol2 = 0;
-    state->master_quitting = false;
-    state->slave_quitting = (state->mode == MODE_SINGLE);
-    state->do_anything = true;
-
-    if (state->mode != MODE_SINGLE) {
-        state->plr1.energy = PLAYER_MAX_ENERGY;
-    }
-    state->plr2.energy = PLAYER_MAX_ENERGY;
+    play_the_game_reset_level_session(state);
 
     /* F9 cross-level: apply position/orientation only after level + objects are ready */
     if (state->f9_pending_apply_save) {
@@ -570,26 +690,32 @@ void play_game_load_shared_assets(GameState *state)
     settings_load(state);
     settings_log_recap(state);
 
-    /* ---- Load shared assets ---- */
-    io_load_walls();
-    io_load_floor();
-    io_load_sky();
+    /* ---- Load shared assets (loader thread; gun textures need the GL thread) ---- */
+    control_wait_shared_assets();
+    s_shared_assets_job = asset_job_submit("shared assets", control_load_shared_assets_job, NULL);
     io_load_gun_graphics();
     display_upload_gun_gl_textures();
-    io_load_objects();
-    io_load_vec_objects();
-    io_load_sfx();
 
     control_setup_new_game_state(state);
+    control_prefetch_level(state->current_level);
 
     io_load_panel();
 }
 
 #if !defined(__EMSCRIPTEN__)
+/* Level a new game starts on (ab3d.ini start_level, else the first level). */
+static int control_new_game_level(const GameState *state)
+{
+    if (state->cfg_start_level >= 0 && state->cfg_start_level < MAX_LEVELS)
+        return state->cfg_start_level;
+    return 0;
+}
+
 int play_game_outer_should_continue(GameState *state)
 {
     if (!state->finished_level) {
         if (state->energy <= 0) {
+            control_prefetch_level(control_new_game_level(state));
             audio_play_module_blocking_once_with_tick("sounds/mt/GameOver.mt",
                                                       control_game_over_fade_tick,
                                                       state);
@@ -611,6 +737,7 @@ int play_game_outer_should_continue(GameState *state)
         return 0;
     }
 
+    control_prefetch_level(state->current_level + 1);
     audio_play_module_blocking_once_with_tick("sounds/mt/WellDone.mt",
                                               control_level_complete_fade_tick,
                                               state);
@@ -763,6 +890,7 @@ void play_game(GameState *state)
         if (!play_game_outer_should_continue(state)) break;
     }
 
+    control_drop_level_prefetch();
     display_release_panel_memory();
 
     printf("[CONTROL] PlayGame finished\n");
@@ -25,6 +25,13 @@ void play_game_load_shared_assets(GameState *state);
 /* One inner iteration of PlayTheGame (level load + conditions); used by Emscripten main loop. */
 void play_the_game_prepare_level(GameState *state, bool *copper_screen_ready);
 
+/* Per-session resets run before a level starts (explosions, music, keyboard,
+ * quit flags); shared by prepare_level and the in-place F9 restore. */
+void play_the_game_reset_level_session(GameState *state);
+
+/* Rebuild game_conditions (keys, switches) from the loaded level state. */
+void game_rebuild_level_conditions(GameState *state);
+
 /* After game_loop returns: 1 = F9 reload (caller runs another prepare), 0 = level session done. */
 int play_the_game_after_game_loop(GameState *state);
 
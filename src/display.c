@@ -5,6 +5,7 @@
  * Creates a window and presents the 12-bit Amiga color-word framebuffer.
  * Default: SDL OpenGL render driver + GL_R16UI + fragment shader (raw uint16 upload, no SDL BlitNtoN).
  * Fallback: Direct3D + SDL texture (UpdateTexture / RenderCopy may use internal blit). Opt-out: AB3D_DISABLE_GL_UNPACK=1.
+ * GL uploads stream through a fenced PBO ring when the context has GL 3.2 sync (AB3D_DISABLE_GL_PBO=1 to skip).
  *
  * Base window size comes from ab3d.ini (render_width/render_height).
  * Internal render size is base size multiplied by supersampling.
@@ -18,6 +19,8 @@
 #include "display.h"
 #include "renderer.h"
 #include "game_data.h"
+#include "audio.h"
+#include "settings.h"
 #include <SDL.h>
 #include <SDL_opengl.h>
 /* SDL_GL_BindTexture / glGenerateMipmap: framebuffer minification when window < internal size */
@@ -103,6 +106,8 @@ EM_JS(void, display_emscripten_apply_screen_aspect_resolution, (int *out_w, int
 });
 #endif
 
+#include "trace.h"
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
@@ -153,27 +158,62 @@ static SDL_Renderer *g_sdl_ren  = NULL;
 static SDL_Texture  *g_texture  = NULL;
 /* True when g_texture accepts native packed 0x0RGB words directly (XRGB4444/ARGB4444). */
 static int g_texture_is_4444_direct = 0;
-/* Key HUD: one SDL texture per key sprite frame 0..3 (invalidated when level/assets change). */
-static SDL_Texture *g_key_hud_tex[4];
+/* HUD atlas: one SDL texture holds both digit strips (0 = health %, 1 = ammo count;
+ * fonts/health_digits.png, fonts/ammo_digits.png) and a row of the four key sprite
+ * frames, so the stats, key row and FPS draws never switch textures. Regions keep a
+ * 1-texel transparent gutter. Key frames are re-rasterized into their cells when the
+ * level/assets change (renderer_key_sprite_hud_cache_tag). */
+#define HUD_ATLAS_PAD    1
+#define HUD_KEY_FRAME_PX 32
+static SDL_Texture *g_hud_atlas_tex;
+static int          g_hud_atlas_attempted;
+static int          g_hud_digit_ok[2];
+static SDL_Rect     g_hud_digit_rect[2];    /* strip placement inside the atlas */
+static int          g_hud_key_row_y;
+static uint8_t      g_key_hud_frame_mask;   /* bit per frame rasterized for g_key_hud_tex_tag */
+static int          g_key_hud_frames_tried;
 static uintptr_t    g_key_hud_tex_tag;
-static void display_key_hud_free_textures(void);
-
-/* HUD digit strips: 0 = health %, 1 = ammo count (fonts, e.g. health_digits.png). */
-static SDL_Texture *g_hud_digit_tex[2];
-static int          g_hud_digit_tex_w[2];
-static int          g_hud_digit_tex_h[2];
-static int          g_hud_digits_load_attempted;
-static void         display_hud_digits_free(void);
-static void         display_hud_digits_ensure_loaded(void);
+static void         display_hud_atlas_free(void);
+static void         display_hud_atlas_ensure_loaded(void);
+
+/* HUD cache: stats, keys and FPS composited into one letterbox-sized render target. */
+static SDL_Texture *g_hud_cache_tex;
+static int          g_hud_cache_building;   /* element draws go through SDL into the cache */
+static void         display_hud_cache_free(void);
+
+/* Automap GL wall buffer (created lazily on first automap present). */
+static void         display_automap_gl_shutdown(void);
 static int g_gl_unpack_ok; /* OpenGL R16UI + shader path active */
 static int g_present_width = 0;
 static int g_present_height = 0;
 static SDL_Rect g_present_dst_rect;
 static int g_internal_w = RENDER_WIDTH;
 static int g_internal_h = RENDER_HEIGHT;
+/* ab3d.ini dynamic_resolution_ms: the renderer draws at g_dynres_pct percent of
+ * g_internal_w x g_internal_h (per axis) inside buffers and textures allocated at full size. */
+static int g_dynres_pct = 100;
+static int g_dynres_hold_frames = 0;
+static int g_dynres_headroom_frames = 0;
+static double g_dynres_avg_ms = 0.0;
 static int g_release_borderless_desktop = 0;
 static int g_debug_window_title = 0;
 static int g_framebuffer_mipmap_enabled = 0;
+/* AB3D_DISABLE_GL_PBO=1: upload cw frames straight from client memory (no PBO ring). */
+static int g_gl_pbo_state = -1;
+/* Pipelined present (cfg_present_pipeline): cw_back_buffer holds a rendered frame that has not
+ * been presented yet. Cleared whenever that frame goes stale (resize, menus, long gaps). */
+static int g_present_pipe_primed = 0;
+/* --benchmark: create the SDL renderer without PRESENTVSYNC so frame times are uncapped. */
+static int g_present_uncapped = 0;
+/* --headless: no window or SDL renderer; frames stop at the cw buffer. */
+static int g_headless = 0;
+/* --dump-frame: write the Nth rendered frame (1-based) to g_frame_dump_path as PNG. */
+static const char *g_frame_dump_path = NULL;
+static int g_frame_dump_at = 0;
+static int g_frames_rendered = 0;
+static double g_last_present_ms = 0.0;
+static void display_present_pipe_shutdown(void);
+static void display_present_pipe_join(void);
 static int g_screen_tint_enabled = 0;
 static Uint8 g_screen_tint_r = 0;
 static Uint8 g_screen_tint_g = 0;
@@ -327,6 +367,9 @@ typedef void   (APIENTRY *DisplayGlDisableVertexAttribArrayFn)(GLuint index);
 #ifndef GL_ONE_MINUS_SRC_ALPHA
 #define GL_ONE_MINUS_SRC_ALPHA 0x0303
 #endif
+#ifndef GL_ONE
+#define GL_ONE 1
+#endif
 #ifndef GL_DEPTH_TEST
 #define GL_DEPTH_TEST 0x0B71
 #endif
@@ -369,10 +412,17 @@ static GLuint g_gl_prog;
 static GLuint g_gl_vao;
 static GLuint g_gl_vbo;
 
-/* Pre-baked gun frame GL textures: 8 guns × 4 frames = 32 slots, each 96×58 RGBA.
- * Uploaded once at asset-load time; zero means not loaded. */
+/* Pre-baked gun frames: 8 guns × 4 frames = 32 slots, each 96×58 RGBA, packed into one
+ * GL atlas of GUN_GL_ATLAS_COLS slots per row, each cell with a 1-texel transparent gutter
+ * so NEAREST sampling at cell edges never reads a neighbour.
+ * Uploaded once at asset-load time; zero texture means not loaded. */
 #define GUN_GL_FRAME_COUNT 32
-static GLuint g_gun_gl_frames[GUN_GL_FRAME_COUNT];
+#define GUN_GL_ATLAS_COLS  8
+#define GUN_GL_ATLAS_PAD   1
+static GLuint   g_gun_gl_atlas;
+static uint32_t g_gun_gl_frame_mask;   /* bit per slot that decoded into the atlas */
+static int      g_gun_gl_cell_w, g_gun_gl_cell_h;
+static int      g_gun_gl_atlas_w, g_gun_gl_atlas_h;
 
 /* HUD overlays: SDL_Renderer GL backend does not reliably mix with raw glUseProgram; draw HUD with
  * SDL_GL_BindTexture + our own GLSL (same context as the 12-bit present shader). */
@@ -435,6 +485,62 @@ static DisplayGlAttachShaderFn             g_gl_attach_shader;
 static DisplayGlCompileShaderFn            g_gl_compile_shader;
 static DisplayGlGetProgramInfoLogFn       g_gl_get_program_info_log;
 
+/* -----------------------------------------------------------------------
+ * cw upload ring: DISPLAY_GL_PBO_RING pixel-unpack buffers, each guarded by a
+ * fence. The frame is streamed into the next free slot with one memcpy and the
+ * texture update is sourced from the PBO, so glTexSubImage2D returns without
+ * copying client memory. A slot whose fence has not signalled is never waited
+ * on; that frame falls back to the direct client-memory upload instead.
+ * Persistent: glBufferStorage + coherent mapping (GL 4.4 / ARB_buffer_storage).
+ * Mapped: glMapBufferRange per frame, unsynchronized (the fence already did it).
+ * WebGL2 has no buffer mapping, so Emscripten keeps the direct upload.
+ * ----------------------------------------------------------------------- */
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif
+#define DISPLAY_GL_MAP_WRITE_BIT               0x0002u
+#define DISPLAY_GL_MAP_INVALIDATE_BUFFER_BIT   0x0008u
+#define DISPLAY_GL_MAP_UNSYNCHRONIZED_BIT      0x0020u
+#define DISPLAY_GL_MAP_PERSISTENT_BIT          0x0040u
+#define DISPLAY_GL_MAP_COHERENT_BIT            0x0080u
+#define DISPLAY_GL_SYNC_GPU_COMMANDS_COMPLETE  0x9117u
+#define DISPLAY_GL_ALREADY_SIGNALED            0x911Au
+#define DISPLAY_GL_CONDITION_SATISFIED         0x911Cu
+#define DISPLAY_GL_MAJOR_VERSION               0x821Bu
+#define DISPLAY_GL_MINOR_VERSION               0x821Cu
+
+#define DISPLAY_GL_PBO_RING 3
+
+enum {
+    DISPLAY_GL_PBO_OFF = 0,
+    DISPLAY_GL_PBO_MAPPED,
+    DISPLAY_GL_PBO_PERSISTENT
+};
+
+typedef struct DisplayGlSyncObj *DisplayGlSync;
+typedef void         (APIENTRY *DisplayGlBufferStorageFn)(GLenum target, ptrdiff_t size, const void *data, GLbitfield flags);
+typedef void *       (APIENTRY *DisplayGlMapBufferRangeFn)(GLenum target, ptrdiff_t offset, ptrdiff_t length, GLbitfield access);
+typedef GLboolean    (APIENTRY *DisplayGlUnmapBufferFn)(GLenum target);
+typedef DisplayGlSync (APIENTRY *DisplayGlFenceSyncFn)(GLenum condition, GLbitfield flags);
+typedef GLenum       (APIENTRY *DisplayGlClientWaitSyncFn)(DisplayGlSync sync, GLbitfield flags, uint64_t timeout);
+typedef void         (APIENTRY *DisplayGlDeleteSyncFn)(DisplayGlSync sync);
+
+static DisplayGlBufferStorageFn            g_gl_buffer_storage;
+static DisplayGlMapBufferRangeFn           g_gl_map_buffer_range;
+static DisplayGlUnmapBufferFn              g_gl_unmap_buffer;
+static DisplayGlFenceSyncFn                g_gl_fence_sync;
+static DisplayGlClientWaitSyncFn           g_gl_client_wait_sync;
+static DisplayGlDeleteSyncFn               g_gl_delete_sync;
+
+static int           g_gl_pbo_caps;   /* best mode the context supports */
+static int           g_gl_pbo_mode;   /* mode the current ring was built with */
+static GLuint        g_gl_pbo_ring[DISPLAY_GL_PBO_RING];
+static void         *g_gl_pbo_map[DISPLAY_GL_PBO_RING];
+static DisplayGlSync g_gl_pbo_fence[DISPLAY_GL_PBO_RING];
+static size_t        g_gl_pbo_bytes;
+static int           g_gl_pbo_next;
+static unsigned      g_gl_pbo_busy_frames;
+
 static inline size_t display_cw_index_xy(int x, int y, int w, int h)
 {
 #if AB3D_CW_COL_MAJOR
@@ -445,6 +551,9 @@ static inline size_t display_cw_index_xy(int x, int y, int w, int h)
 #endif
 }
 
+/* Unpack shader: 12-bit cw -> RGB, underwater AND #$00FF for rows >= u_water_row
+ * (fillscrnwater, same rows as renderer_apply_underwater_tint), and a box-filter
+ * downscale of up to 4x4 texels when the letterbox is smaller than the framebuffer. */
 #if defined(__EMSCRIPTEN__)
 static const char display_gl_vs_src[] =
     "#version 300 es\n"
@@ -464,28 +573,41 @@ static const char display_gl_fs_src[] =
     "uniform highp usampler2D u_cw;\n"
     "uniform highp int u_fb_w;\n"
     "uniform highp int u_fb_h;\n"
+    "uniform highp int u_dst_w;\n"
+    "uniform highp int u_dst_h;\n"
+    "uniform highp int u_water_row;\n"
     "in highp vec2 v_uv;\n"
     "out highp vec4 o_col;\n"
-    "void main() {\n"
-    "  highp int fb_w = (u_fb_w > 0) ? u_fb_w : 1;\n"
-    "  highp int fb_h = (u_fb_h > 0) ? u_fb_h : 1;\n"
-    "  highp int ox = int(clamp(v_uv.x * float(fb_w), 0.0, float(fb_w - 1)));\n"
-    "  highp int oy = int(clamp(v_uv.y * float(fb_h), 0.0, float(fb_h - 1)));\n"
+    "vec3 cw_rgb(highp int ox, highp int oy, highp int fb_w, highp int fb_h) {\n"
 #if AB3D_CW_COL_MAJOR
     "  highp int lin = ox * fb_h + oy;\n"
     "  highp ivec2 tp = ivec2(lin % fb_w, lin / fb_w);\n"
 #else
     "  highp ivec2 tp = ivec2(ox, oy);\n"
 #endif
-    "  highp uint w = texelFetch(u_cw, tp, 0).r;\n"
-    "  highp uint c = w & 0xFFFu;\n"
-    "  highp uint r4 = (c >> 8) & 0xFu;\n"
-    "  highp uint g4 = (c >> 4) & 0xFu;\n"
-    "  highp uint b4 = c & 0xFu;\n"
-    "  float r = float(r4) * (1.0 / 15.0);\n"
-    "  float g = float(g4) * (1.0 / 15.0);\n"
-    "  float b = float(b4) * (1.0 / 15.0);\n"
-    "  o_col = vec4(r, g, b, 1.0);\n"
+    "  highp uint c = texelFetch(u_cw, tp, 0).r & 0xFFFu;\n"
+    "  if (oy >= u_water_row) c &= 0x0FFu;\n"
+    "  return vec3(float((c >> 8) & 0xFu), float((c >> 4) & 0xFu), float(c & 0xFu)) * (1.0 / 15.0);\n"
+    "}\n"
+    "void main() {\n"
+    "  highp int fb_w = (u_fb_w > 0) ? u_fb_w : 1;\n"
+    "  highp int fb_h = (u_fb_h > 0) ? u_fb_h : 1;\n"
+    "  highp int nx = (u_dst_w > 0 && u_dst_w < fb_w) ? min((fb_w + u_dst_w - 1) / u_dst_w, 4) : 1;\n"
+    "  highp int ny = (u_dst_h > 0 && u_dst_h < fb_h) ? min((fb_h + u_dst_h - 1) / u_dst_h, 4) : 1;\n"
+    "  highp vec2 fb = vec2(float(fb_w), float(fb_h));\n"
+    "  highp vec2 fp = v_uv * fb;\n"
+    "  highp vec2 fstep = vec2(nx > 1 ? fb.x / float(u_dst_w) : 0.0, ny > 1 ? fb.y / float(u_dst_h) : 0.0);\n"
+    "  vec3 acc = vec3(0.0);\n"
+    "  for (highp int j = 0; j < ny; j++) {\n"
+    "    highp float sy = fp.y + fstep.y * ((float(j) + 0.5) / float(ny) - 0.5);\n"
+    "    highp int oy = int(clamp(sy, 0.0, fb.y - 1.0));\n"
+    "    for (highp int i = 0; i < nx; i++) {\n"
+    "      highp float sx = fp.x + fstep.x * ((float(i) + 0.5) / float(nx) - 0.5);\n"
+    "      highp int ox = int(clamp(sx, 0.0, fb.x - 1.0));\n"
+    "      acc += cw_rgb(ox, oy, fb_w, fb_h);\n"
+    "    }\n"
+    "  }\n"
+    "  o_col = vec4(acc / float(nx * ny), 1.0);\n"
     "}\n";
 #else
 static const char display_gl_vs_src[] =
@@ -503,28 +625,41 @@ static const char display_gl_fs_src[] =
     "uniform usampler2D u_cw;\n"
     "uniform int u_fb_w;\n"
     "uniform int u_fb_h;\n"
+    "uniform int u_dst_w;\n"
+    "uniform int u_dst_h;\n"
+    "uniform int u_water_row;\n"
     "in vec2 v_uv;\n"
     "out vec4 o_col;\n"
-    "void main() {\n"
-    "  int fb_w = (u_fb_w > 0) ? u_fb_w : 1;\n"
-    "  int fb_h = (u_fb_h > 0) ? u_fb_h : 1;\n"
-    "  int ox = int(clamp(v_uv.x * float(fb_w), 0.0, float(fb_w - 1)));\n"
-    "  int oy = int(clamp(v_uv.y * float(fb_h), 0.0, float(fb_h - 1)));\n"
+    "vec3 cw_rgb(int ox, int oy, int fb_w, int fb_h) {\n"
 #if AB3D_CW_COL_MAJOR
     "  int lin = ox * fb_h + oy;\n"
     "  ivec2 tp = ivec2(lin % fb_w, lin / fb_w);\n"
 #else
     "  ivec2 tp = ivec2(ox, oy);\n"
 #endif
-    "  uint w = texelFetch(u_cw, tp, 0).r;\n"
-    "  uint c = w & 0xFFFu;\n"
-    "  uint r4 = (c >> 8) & 0xFu;\n"
-    "  uint g4 = (c >> 4) & 0xFu;\n"
-    "  uint b4 = c & 0xFu;\n"
-    "  float r = float(r4) * (1.0 / 15.0);\n"
-    "  float g = float(g4) * (1.0 / 15.0);\n"
-    "  float b = float(b4) * (1.0 / 15.0);\n"
-    "  o_col = vec4(r, g, b, 1.0);\n"
+    "  uint c = texelFetch(u_cw, tp, 0).r & 0xFFFu;\n"
+    "  if (oy >= u_water_row) c &= 0x0FFu;\n"
+    "  return vec3(float((c >> 8) & 0xFu), float((c >> 4) & 0xFu), float(c & 0xFu)) * (1.0 / 15.0);\n"
+    "}\n"
+    "void main() {\n"
+    "  int fb_w = (u_fb_w > 0) ? u_fb_w : 1;\n"
+    "  int fb_h = (u_fb_h > 0) ? u_fb_h : 1;\n"
+    "  int nx = (u_dst_w > 0 && u_dst_w < fb_w) ? min((fb_w + u_dst_w - 1) / u_dst_w, 4) : 1;\n"
+    "  int ny = (u_dst_h > 0 && u_dst_h < fb_h) ? min((fb_h + u_dst_h - 1) / u_dst_h, 4) : 1;\n"
+    "  vec2 fb = vec2(float(fb_w), float(fb_h));\n"
+    "  vec2 fp = v_uv * fb;\n"
+    "  vec2 fstep = vec2(nx > 1 ? fb.x / float(u_dst_w) : 0.0, ny > 1 ? fb.y / float(u_dst_h) : 0.0);\n"
+    "  vec3 acc = vec3(0.0);\n"
+    "  for (int j = 0; j < ny; j++) {\n"
+    "    float sy = fp.y + fstep.y * ((float(j) + 0.5) / float(ny) - 0.5);\n"
+    "    int oy = int(clamp(sy, 0.0, fb.y - 1.0));\n"
+    "    for (int i = 0; i < nx; i++) {\n"
+    "      float sx = fp.x + fstep.x * ((float(i) + 0.5) / float(nx) - 0.5);\n"
+    "      int ox = int(clamp(sx, 0.0, fb.x - 1.0));\n"
+    "      acc += cw_rgb(ox, oy, fb_w, fb_h);\n"
+    "    }\n"
+    "  }\n"
+    "  o_col = vec4(acc / float(nx * ny), 1.0);\n"
     "}\n";
 #endif
 
@@ -820,42 +955,73 @@ static int display_gl_hud_try_init(void)
     return 1;
 }
 
-/* Upload all 32 gun frame slots to pre-baked GL textures.
+static void display_gun_gl_atlas_free(void)
+{
+    if (g_gun_gl_atlas && g_gl_delete_textures)
+        g_gl_delete_textures(1, &g_gun_gl_atlas);
+    g_gun_gl_atlas = 0;
+    g_gun_gl_frame_mask = 0;
+}
+
+/* Decode all 32 gun frame slots into one atlas and upload it with a single glTexImage2D.
  * Must be called after io_load_gun_graphics() and after GL is initialized.
- * Safe to re-call (deletes old textures first). */
+ * Safe to re-call (deletes the old atlas first). */
 void display_upload_gun_gl_textures(void)
 {
     if (!g_gl_unpack_ok) return;  /* GL path not available */
     if (!g_gl_gen_textures || !g_gl_bind_texture || !g_gl_tex_image_2d ||
         !g_gl_tex_parameteri2 || !g_gl_delete_textures) return;
 
+    display_gun_gl_atlas_free();
+
     int w = renderer_gun_src_width();
     int h = renderer_gun_src_height();
     if (w < 1 || h < 1) return;
 
+    int cell_w = w + 2 * GUN_GL_ATLAS_PAD;
+    int cell_h = h + 2 * GUN_GL_ATLAS_PAD;
+    int rows = (GUN_GL_FRAME_COUNT + GUN_GL_ATLAS_COLS - 1) / GUN_GL_ATLAS_COLS;
+    int atlas_w = cell_w * GUN_GL_ATLAS_COLS;
+    int atlas_h = cell_h * rows;
+
+    uint32_t *atlas = (uint32_t *)calloc((size_t)atlas_w * (size_t)atlas_h, sizeof(uint32_t));
     uint32_t *scratch = (uint32_t *)malloc((size_t)w * (size_t)h * sizeof(uint32_t));
-    if (!scratch) return;
+    if (!atlas || !scratch) {
+        free(atlas);
+        free(scratch);
+        return;
+    }
 
+    uint32_t mask = 0;
     for (int slot = 0; slot < GUN_GL_FRAME_COUNT; slot++) {
-        /* Delete any previously uploaded texture for this slot */
-        if (g_gun_gl_frames[slot]) {
-            g_gl_delete_textures(1, &g_gun_gl_frames[slot]);
-            g_gun_gl_frames[slot] = 0;
-        }
         if (!renderer_decode_gun_frame_rgba(slot, scratch)) continue;
+        int ox = (slot % GUN_GL_ATLAS_COLS) * cell_w + GUN_GL_ATLAS_PAD;
+        int oy = (slot / GUN_GL_ATLAS_COLS) * cell_h + GUN_GL_ATLAS_PAD;
+        for (int y = 0; y < h; y++)
+            memcpy(atlas + (size_t)(oy + y) * (size_t)atlas_w + (size_t)ox,
+                   scratch + (size_t)y * (size_t)w, (size_t)w * sizeof(uint32_t));
+        mask |= 1u << slot;
+    }
+    free(scratch);
 
-        g_gl_gen_textures(1, &g_gun_gl_frames[slot]);
-        g_gl_bind_texture(0x0DE1 /* GL_TEXTURE_2D */, g_gun_gl_frames[slot]);
+    if (mask) {
+        g_gl_gen_textures(1, &g_gun_gl_atlas);
+        g_gl_bind_texture(0x0DE1 /* GL_TEXTURE_2D */, g_gun_gl_atlas);
         g_gl_tex_parameteri2(0x0DE1, 0x2800 /* GL_TEXTURE_MAG_FILTER */, 0x2600 /* GL_NEAREST */);
         g_gl_tex_parameteri2(0x0DE1, 0x2801 /* GL_TEXTURE_MIN_FILTER */, 0x2600 /* GL_NEAREST */);
         g_gl_tex_parameteri2(0x0DE1, 0x2802 /* GL_TEXTURE_WRAP_S */,     0x812F /* GL_CLAMP_TO_EDGE */);
         g_gl_tex_parameteri2(0x0DE1, 0x2803 /* GL_TEXTURE_WRAP_T */,     0x812F /* GL_CLAMP_TO_EDGE */);
-        g_gl_tex_image_2d(0x0DE1, 0, (GLint)GL_RGBA8, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, scratch);
+        g_gl_tex_image_2d(0x0DE1, 0, (GLint)GL_RGBA8, atlas_w, atlas_h, 0, GL_RGBA, GL_UNSIGNED_BYTE, atlas);
+        g_gl_bind_texture(0x0DE1, 0);
+        g_gun_gl_frame_mask = mask;
+        g_gun_gl_cell_w = cell_w;
+        g_gun_gl_cell_h = cell_h;
+        g_gun_gl_atlas_w = atlas_w;
+        g_gun_gl_atlas_h = atlas_h;
     }
-    g_gl_bind_texture(0x0DE1, 0);
-    free(scratch);
-    printf("[DISPLAY] Gun GL textures uploaded (%d slots, %dx%d each)\n",
-           GUN_GL_FRAME_COUNT, w, h);
+    free(atlas);
+    printf("[DISPLAY] Gun GL atlas uploaded (%d slots, %dx%d each, %dx%d atlas)\n",
+           GUN_GL_FRAME_COUNT, w, h, atlas_w, atlas_h);
 }
 
 /* Draw a pre-baked gun GL texture as a quad over dst (window pixels). */
@@ -863,7 +1029,7 @@ static void display_gl_gun_quad(int frame_slot, const SDL_Rect *dst)
 {
     if (!g_gl_hud_ok || g_gl_overlay_win_w < 1) return;
     if (frame_slot < 0 || frame_slot >= GUN_GL_FRAME_COUNT) return;
-    if (!g_gun_gl_frames[frame_slot]) return;
+    if (!g_gun_gl_atlas || !(g_gun_gl_frame_mask & (1u << frame_slot))) return;
     if (!dst) return;
 
 #if SDL_VERSION_ATLEAST(2, 0, 14)
@@ -876,13 +1042,20 @@ static void display_gl_gun_quad(int frame_slot, const SDL_Rect *dst)
     display_gl_wnd_ndc((float)(dst->x + dst->w), (float)(dst->y + dst->h), wx, wy, &nx2, &ny2);
     display_gl_wnd_ndc((float)dst->x,           (float)(dst->y + dst->h), wx, wy, &nx3, &ny3);
 
+    int cx = (frame_slot % GUN_GL_ATLAS_COLS) * g_gun_gl_cell_w + GUN_GL_ATLAS_PAD;
+    int cy = (frame_slot / GUN_GL_ATLAS_COLS) * g_gun_gl_cell_h + GUN_GL_ATLAS_PAD;
+    float u0 = (float)cx / (float)g_gun_gl_atlas_w;
+    float v0 = (float)cy / (float)g_gun_gl_atlas_h;
+    float u1 = (float)(cx + g_gun_gl_cell_w - 2 * GUN_GL_ATLAS_PAD) / (float)g_gun_gl_atlas_w;
+    float v1 = (float)(cy + g_gun_gl_cell_h - 2 * GUN_GL_ATLAS_PAD) / (float)g_gun_gl_atlas_h;
+
     float buf[24] = {
-        nx0, ny0, 0.0f, 0.0f,
-        nx1, ny1, 1.0f, 0.0f,
-        nx3, ny3, 0.0f, 1.0f,
-        nx1, ny1, 1.0f, 0.0f,
-        nx2, ny2, 1.0f, 1.0f,
-        nx3, ny3, 0.0f, 1.0f,
+        nx0, ny0, u0, v0,
+        nx1, ny1, u1, v0,
+        nx3, ny3, u0, v1,
+        nx1, ny1, u1, v0,
+        nx2, ny2, u1, v1,
+        nx3, ny3, u0, v1,
     };
 
     g_gl_use_program(g_gl_prog_hud_tex);
@@ -890,7 +1063,7 @@ static void display_gl_gun_quad(int frame_slot, const SDL_Rect *dst)
     if (g_gl_hud_loc_color_tex >= 0)  g_gl_uniform4f(g_gl_hud_loc_color_tex, 1.0f, 1.0f, 1.0f, 1.0f);
     if (g_gl_hud_loc_rb_swap >= 0)    g_gl_uniform1f(g_gl_hud_loc_rb_swap, 0.0f);
     g_gl_active_texture(GL_TEXTURE0);
-    g_gl_bind_texture(0x0DE1, g_gun_gl_frames[frame_slot]);
+    g_gl_bind_texture(0x0DE1, g_gun_gl_atlas);
     g_gl_bind_vertex_array(g_gl_hud_vao_tex);
     g_gl_bind_buffer(0x8892, g_gl_hud_vbo);
     g_gl_buffer_data(0x8892, (ptrdiff_t)sizeof(buf), buf, GL_STREAM_DRAW);
@@ -898,52 +1071,6 @@ static void display_gl_gun_quad(int frame_slot, const SDL_Rect *dst)
     g_gl_bind_texture(0x0DE1, 0);
 }
 
-/* Apply the Amiga underwater tint (AND #$00FF = zero red channel) as a GL
- * multiply quad.  fill_screen_water > 0 → full viewport; < 0 → bottom half. */
-static void display_gl_multiply_tint_rect(int8_t fill_screen_water)
-{
-    if (!g_gl_hud_ok || g_gl_overlay_win_w < 1) return;
-    if (fill_screen_water == 0) return;
-
-    /* Compute rect in window pixels over the present dst letterbox */
-    SDL_Rect r = g_present_dst_rect;
-    if (fill_screen_water < 0) {
-        /* Weak tint: bottom half only */
-        int half = r.h / 2;
-        r.y += half;
-        r.h -= half;
-    }
-    if (r.w < 1 || r.h < 1) return;
-
-#if SDL_VERSION_ATLEAST(2, 0, 14)
-    SDL_RenderFlush(g_sdl_ren);
-#endif
-    /* Color multiply: dst_out = src_color * dst_color.  Amiga AND #$00FF zeroes
-     * the red channel, so multiply by (R=0, G=1, B=1). */
-    int wx = g_gl_overlay_win_w, wy = g_gl_overlay_win_h;
-    float nx0, ny0, nx1, ny1, nx2, ny2, nx3, ny3;
-    display_gl_wnd_ndc((float)r.x,         (float)r.y,         wx, wy, &nx0, &ny0);
-    display_gl_wnd_ndc((float)(r.x + r.w), (float)r.y,         wx, wy, &nx1, &ny1);
-    display_gl_wnd_ndc((float)(r.x + r.w), (float)(r.y + r.h), wx, wy, &nx2, &ny2);
-    display_gl_wnd_ndc((float)r.x,         (float)(r.y + r.h), wx, wy, &nx3, &ny3);
-
-    float solid_buf[12] = {
-        nx0, ny0, nx1, ny1, nx3, ny3,
-        nx1, ny1, nx2, ny2, nx3, ny3,
-    };
-    g_gl_use_program(g_gl_prog_hud_solid);
-    if (g_gl_hud_loc_color_solid >= 0)
-        g_gl_uniform4f(g_gl_hud_loc_color_solid, 0.0f, 1.0f, 1.0f, 1.0f);
-    g_gl_bind_vertex_array(g_gl_hud_vao_solid);
-    g_gl_bind_buffer(0x8892, g_gl_hud_vbo);
-    g_gl_buffer_data(0x8892, (ptrdiff_t)sizeof(solid_buf), solid_buf, GL_STREAM_DRAW);
-    /* Temporarily switch to multiply blend */
-    g_gl_blend_func(GL_DST_COLOR, GL_ZERO);
-    g_gl_draw_arrays(GL_TRIANGLES, 0, 6);
-    /* Restore normal alpha blend */
-    g_gl_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-}
-
 static void display_gl_overlay_begin(void)
 {
     display_gl_output_size(&g_gl_overlay_win_w, &g_gl_overlay_win_h);
@@ -1218,7 +1345,7 @@ static void display_gl_solid_triangles_xy(const float *xy, int nverts, Uint8 r,
 static void display_overlay_copy(SDL_Texture *tex, const SDL_Rect *src_opt, const SDL_Rect *dst)
 {
     if (!g_sdl_ren || !tex || !dst) return;
-    if (g_gl_unpack_ok && g_gl_hud_ok)
+    if (g_gl_unpack_ok && g_gl_hud_ok && !g_hud_cache_building)
         display_gl_texture_blit(tex, src_opt, dst);
     else
         SDL_RenderCopy(g_sdl_ren, tex, src_opt, dst);
@@ -1227,7 +1354,7 @@ static void display_overlay_copy(SDL_Texture *tex, const SDL_Rect *src_opt, cons
 static void display_overlay_fill_rect_abs(const SDL_Rect *rect, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
 {
     if (!g_sdl_ren || !rect) return;
-    if (g_gl_unpack_ok && g_gl_hud_ok)
+    if (g_gl_unpack_ok && g_gl_hud_ok && !g_hud_cache_building)
         display_gl_solid_rect_fill(rect, r, g, b, a);
     else {
         SDL_SetRenderDrawBlendMode(g_sdl_ren, SDL_BLENDMODE_BLEND);
@@ -1264,16 +1391,163 @@ static void display_automap_line_stroked_gl(int ax0, int ay0, int ax1, int ay1,
     }
 }
 
-static void display_gl_shutdown_unpack(void)
+static void display_gl_pbo_probe(void)
 {
-    if (g_gl_delete_textures) {
-        for (int i = 0; i < GUN_GL_FRAME_COUNT; i++) {
-            if (g_gun_gl_frames[i]) g_gl_delete_textures(1, &g_gun_gl_frames[i]);
-            g_gun_gl_frames[i] = 0;
+    GLint major = 0, minor = 0;
+    int ver;
+
+    g_gl_pbo_caps = DISPLAY_GL_PBO_OFF;
+#if !defined(__EMSCRIPTEN__)
+    if (!settings_env_feature_enabled(&g_gl_pbo_state, "AB3D_DISABLE_GL_PBO")) {
+        printf("[DISPLAY] cw upload: PBO ring disabled (AB3D_DISABLE_GL_PBO)\n");
+        return;
+    }
+    g_gl_map_buffer_range = (DisplayGlMapBufferRangeFn)SDL_GL_GetProcAddress("glMapBufferRange");
+    g_gl_unmap_buffer = (DisplayGlUnmapBufferFn)SDL_GL_GetProcAddress("glUnmapBuffer");
+    g_gl_fence_sync = (DisplayGlFenceSyncFn)SDL_GL_GetProcAddress("glFenceSync");
+    g_gl_client_wait_sync = (DisplayGlClientWaitSyncFn)SDL_GL_GetProcAddress("glClientWaitSync");
+    g_gl_delete_sync = (DisplayGlDeleteSyncFn)SDL_GL_GetProcAddress("glDeleteSync");
+    g_gl_buffer_storage = (DisplayGlBufferStorageFn)SDL_GL_GetProcAddress("glBufferStorage");
+
+    /* Some loaders hand back non-NULL stubs for anything; gate on the context version too. */
+    g_gl_get_integerv(DISPLAY_GL_MAJOR_VERSION, &major);
+    g_gl_get_integerv(DISPLAY_GL_MINOR_VERSION, &minor);
+    if (g_gl_get_error) (void)g_gl_get_error();
+    ver = (int)major * 10 + (int)minor;
+
+    if (!g_gl_map_buffer_range || !g_gl_unmap_buffer || !g_gl_fence_sync ||
+        !g_gl_client_wait_sync || !g_gl_delete_sync ||
+        (ver < 32 && !SDL_GL_ExtensionSupported("GL_ARB_sync"))) {
+        printf("[DISPLAY] cw upload: PBO ring unavailable (needs GL 3.2 fences), using direct upload\n");
+        return;
+    }
+    g_gl_pbo_caps = DISPLAY_GL_PBO_MAPPED;
+    if (g_gl_buffer_storage && (ver >= 44 || SDL_GL_ExtensionSupported("GL_ARB_buffer_storage")))
+        g_gl_pbo_caps = DISPLAY_GL_PBO_PERSISTENT;
+#else
+    (void)major;
+    (void)minor;
+    (void)ver;
+#endif
+}
+
+static void display_gl_pbo_ring_destroy(void)
+{
+    for (int i = 0; i < DISPLAY_GL_PBO_RING; i++) {
+        if (g_gl_pbo_fence[i] && g_gl_delete_sync) g_gl_delete_sync(g_gl_pbo_fence[i]);
+        g_gl_pbo_fence[i] = NULL;
+        if (g_gl_pbo_map[i] && g_gl_pbo_ring[i]) {
+            g_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, g_gl_pbo_ring[i]);
+            g_gl_unmap_buffer(GL_PIXEL_UNPACK_BUFFER);
         }
+        g_gl_pbo_map[i] = NULL;
+        if (g_gl_pbo_ring[i] && g_gl_delete_buffers) g_gl_delete_buffers(1, &g_gl_pbo_ring[i]);
+        g_gl_pbo_ring[i] = 0;
+    }
+    if (g_gl_bind_buffer) g_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    g_gl_pbo_mode = DISPLAY_GL_PBO_OFF;
+    g_gl_pbo_bytes = 0;
+    g_gl_pbo_next = 0;
+}
+
+/* (Re)build the ring for a w×h cw frame. Persistent storage falls back to per-frame
+ * mapping if the driver rejects it; any other failure leaves the direct upload path. */
+static void display_gl_pbo_ring_create(int w, int h)
+{
+    size_t bytes = (size_t)w * (size_t)h * sizeof(uint16_t);
+    int mode = g_gl_pbo_caps;
+
+    display_gl_pbo_ring_destroy();
+    if (mode == DISPLAY_GL_PBO_OFF || bytes == 0) return;
+    if (g_gl_get_error) (void)g_gl_get_error();
+
+    while (mode != DISPLAY_GL_PBO_OFF) {
+        int ok = 1;
+        g_gl_gen_buffers(DISPLAY_GL_PBO_RING, g_gl_pbo_ring);
+        for (int i = 0; i < DISPLAY_GL_PBO_RING && ok; i++) {
+            g_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, g_gl_pbo_ring[i]);
+            if (mode == DISPLAY_GL_PBO_PERSISTENT) {
+                const GLbitfield flags = DISPLAY_GL_MAP_WRITE_BIT | DISPLAY_GL_MAP_PERSISTENT_BIT |
+                                         DISPLAY_GL_MAP_COHERENT_BIT;
+                g_gl_buffer_storage(GL_PIXEL_UNPACK_BUFFER, (ptrdiff_t)bytes, NULL, flags);
+                g_gl_pbo_map[i] = g_gl_map_buffer_range(GL_PIXEL_UNPACK_BUFFER, 0, (ptrdiff_t)bytes, flags);
+                if (!g_gl_pbo_map[i]) ok = 0;
+            } else {
+                g_gl_buffer_data(GL_PIXEL_UNPACK_BUFFER, (ptrdiff_t)bytes, NULL, GL_STREAM_DRAW);
+            }
+            if (g_gl_get_error && g_gl_get_error() != 0) ok = 0;
+        }
+        g_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        if (ok) break;
+        g_gl_pbo_mode = mode;
+        display_gl_pbo_ring_destroy();
+        mode = (mode == DISPLAY_GL_PBO_PERSISTENT) ? DISPLAY_GL_PBO_MAPPED : DISPLAY_GL_PBO_OFF;
+    }
+    if (mode == DISPLAY_GL_PBO_OFF) {
+        printf("[DISPLAY] cw upload: PBO ring allocation failed, using direct upload\n");
+        return;
+    }
+    g_gl_pbo_mode = mode;
+    g_gl_pbo_bytes = bytes;
+    printf("[DISPLAY] cw upload: PBO ring x%d (%s, %u KB/slot)\n", DISPLAY_GL_PBO_RING,
+           (mode == DISPLAY_GL_PBO_PERSISTENT) ? "persistent mapped" : "mapped per frame",
+           (unsigned)(bytes / 1024u));
+}
+
+/* Stream src into the next ring slot and source the bound cw texture from it.
+ * Returns 0 (nothing uploaded) when the ring is off or the slot is still in flight. */
+static int display_gl_pbo_upload(const uint16_t *src, int w, int h)
+{
+    size_t bytes = (size_t)w * (size_t)h * sizeof(uint16_t);
+    int slot = g_gl_pbo_next;
+    void *dst;
+
+    if (g_gl_pbo_mode == DISPLAY_GL_PBO_OFF || bytes > g_gl_pbo_bytes) return 0;
+    if (g_gl_pbo_fence[slot]) {
+        GLenum st = g_gl_client_wait_sync(g_gl_pbo_fence[slot], 0, 0);
+        if (st != DISPLAY_GL_ALREADY_SIGNALED && st != DISPLAY_GL_CONDITION_SATISFIED) {
+            g_gl_pbo_busy_frames++;
+            return 0;
+        }
+        g_gl_delete_sync(g_gl_pbo_fence[slot]);
+        g_gl_pbo_fence[slot] = NULL;
+    }
+
+    g_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, g_gl_pbo_ring[slot]);
+    if (g_gl_pbo_mode == DISPLAY_GL_PBO_PERSISTENT) {
+        dst = g_gl_pbo_map[slot];
+    } else {
+        dst = g_gl_map_buffer_range(GL_PIXEL_UNPACK_BUFFER, 0, (ptrdiff_t)bytes,
+                                    DISPLAY_GL_MAP_WRITE_BIT | DISPLAY_GL_MAP_INVALIDATE_BUFFER_BIT |
+                                    DISPLAY_GL_MAP_UNSYNCHRONIZED_BIT);
+    }
+    if (!dst) {
+        g_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return 0;
     }
+    memcpy(dst, src, bytes);
+    if (g_gl_pbo_mode != DISPLAY_GL_PBO_PERSISTENT && !g_gl_unmap_buffer(GL_PIXEL_UNPACK_BUFFER)) {
+        /* Store lost (mode switch etc.); contents undefined, upload directly this frame. */
+        g_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return 0;
+    }
+    g_gl_tex_sub_image_2d(0x0DE1 /* GL_TEXTURE_2D */, 0, 0, 0, w, h, GL_RED_INTEGER,
+                          0x1403 /* GL_UNSIGNED_SHORT */, (const void *)0);
+    g_gl_pbo_fence[slot] = g_gl_fence_sync(DISPLAY_GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    g_gl_bind_buffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    g_gl_pbo_next = (slot + 1) % DISPLAY_GL_PBO_RING;
+    return 1;
+}
+
+static void display_gl_shutdown_unpack(void)
+{
+    display_gun_gl_atlas_free();
+    display_automap_gl_shutdown();
     display_gl_hud_shutdown();
     if (!g_gl_unpack_ok) return;
+    display_gl_pbo_ring_destroy();
+    if (g_gl_pbo_busy_frames)
+        printf("[DISPLAY] cw upload: %u frame(s) bypassed a busy PBO slot\n", g_gl_pbo_busy_frames);
     if (g_gl_delete_vertex_arrays && g_gl_vao) g_gl_delete_vertex_arrays(1, &g_gl_vao);
     if (g_gl_delete_buffers && g_gl_vbo) g_gl_delete_buffers(1, &g_gl_vbo);
     if (g_gl_delete_program && g_gl_prog) g_gl_delete_program(g_gl_prog);
@@ -1354,6 +1628,7 @@ static int display_gl_try_init_unpack(void)
     g_gl_bind_texture(0x0DE1, 0);
 
     g_gl_unpack_ok = 1;
+    display_gl_pbo_probe();
     if (!display_gl_hud_try_init()) {
         printf("[DISPLAY] HUD: GL overlay init failed; status HUD may be invisible until fixed or AB3D_DISABLE_GL_UNPACK=1\n");
     }
@@ -1386,13 +1661,16 @@ static void display_gl_resize_cw_texture(int w, int h)
     g_gl_bind_texture(0x0DE1, 0);
     if (g_gl_get_error && g_gl_get_error() != 0)
         printf("[DISPLAY] GL_R16UI glTexImage2D reported an error (driver may not support integer textures)\n");
+    display_gl_pbo_ring_create(w, h);
 }
 
-static void display_gl_present_cw(const uint16_t *src, int w, int h)
+/* water_row: first framebuffer row the unpack shader masks with AND #$00FF (h = none). */
+static void display_gl_present_cw(const uint16_t *src, int w, int h, int water_row)
 {
     GLint loc_u;
     GLint loc_w;
     GLint loc_h;
+    GLint loc;
     int win_w = 1, win_h = 1;
 
     if (!g_gl_unpack_ok || !src || w < 1 || h < 1) return;
@@ -1401,7 +1679,8 @@ static void display_gl_present_cw(const uint16_t *src, int w, int h)
     display_gl_reset_client_pixel_unpack();
     g_gl_active_texture(GL_TEXTURE0);
     g_gl_bind_texture(0x0DE1 /* GL_TEXTURE_2D */, g_gl_tex_cw);
-    g_gl_tex_sub_image_2d(0x0DE1, 0, 0, 0, w, h, GL_RED_INTEGER, 0x1403 /* GL_UNSIGNED_SHORT */, src);
+    if (!display_gl_pbo_upload(src, w, h))
+        g_gl_tex_sub_image_2d(0x0DE1, 0, 0, 0, w, h, GL_RED_INTEGER, 0x1403 /* GL_UNSIGNED_SHORT */, src);
     g_gl_bind_texture(0x0DE1, 0);
 
     SDL_SetRenderDrawColor(g_sdl_ren, 0, 0, 0, 255);
@@ -1430,6 +1709,12 @@ static void display_gl_present_cw(const uint16_t *src, int w, int h)
     if (loc_w >= 0) g_gl_uniform1i(loc_w, w);
     loc_h = g_gl_get_uniform_location(g_gl_prog, "u_fb_h");
     if (loc_h >= 0) g_gl_uniform1i(loc_h, h);
+    loc = g_gl_get_uniform_location(g_gl_prog, "u_dst_w");
+    if (loc >= 0) g_gl_uniform1i(loc, g_present_dst_rect.w);
+    loc = g_gl_get_uniform_location(g_gl_prog, "u_dst_h");
+    if (loc >= 0) g_gl_uniform1i(loc, g_present_dst_rect.h);
+    loc = g_gl_get_uniform_location(g_gl_prog, "u_water_row");
+    if (loc >= 0) g_gl_uniform1i(loc, water_row);
     g_gl_bind_vertex_array(g_gl_vao);
     g_gl_draw_arrays(GL_TRIANGLE_STRIP, 0, 4);
     g_gl_bind_vertex_array(0);
@@ -1468,10 +1753,12 @@ static void display_sdl_resync_after_raw_gl(void)
 static void display_cpu_unpack_cw_to_texture(const uint16_t *src, int w, int h)
 {
     if (!g_texture || !src || w < 1 || h < 1) return;
+    /* The texture is sized for the full internal size; dynamic resolution fills its top-left. */
+    SDL_Rect rect = { 0, 0, w, h };
 
     /* Fast path: cw_buffer is already packed 0x0RGB words. Push directly; no per-pixel CPU work. */
     if (g_texture_is_4444_direct && !AB3D_CW_COL_MAJOR) {
-        if (SDL_UpdateTexture(g_texture, NULL, src, (int)((size_t)w * sizeof(uint16_t))) != 0) {
+        if (SDL_UpdateTexture(g_texture, &rect, src, (int)((size_t)w * sizeof(uint16_t))) != 0) {
             return;
         }
         return;
@@ -1479,7 +1766,7 @@ static void display_cpu_unpack_cw_to_texture(const uint16_t *src, int w, int h)
 
     void *pixels;
     int pitch;
-    if (SDL_LockTexture(g_texture, NULL, &pixels, &pitch) < 0) return;
+    if (SDL_LockTexture(g_texture, &rect, &pixels, &pitch) < 0) return;
     for (int y = 0; y < h; y++) {
         uint32_t *dst_row = (uint32_t*)((uint8_t*)pixels + (size_t)y * (size_t)pitch);
         for (int x = 0; x < w; x++) {
@@ -1541,8 +1828,12 @@ static void display_set_renderer_target_size(int w, int h)
     printf("[DISPLAY] renderer target: %dx%d\n", w, h);
     renderer_resize(w, h);
     renderer_set_present_size(w, h);
+    g_present_pipe_primed = 0;
     g_internal_w = w;
     g_internal_h = h;
+    g_dynres_pct = 100;
+    g_dynres_hold_frames = 0;
+    g_dynres_avg_ms = 0.0;
     if (g_texture) {
         SDL_DestroyTexture(g_texture);
         g_texture = NULL;
@@ -1550,7 +1841,7 @@ static void display_set_renderer_target_size(int w, int h)
     g_texture_is_4444_direct = 0;
     if (g_gl_unpack_ok) {
         display_gl_resize_cw_texture(w, h);
-    } else {
+    } else if (g_sdl_ren) {
         g_texture = SDL_CreateTexture(g_sdl_ren,
             SDL_PIXELFORMAT_XRGB4444, SDL_TEXTUREACCESS_STREAMING, g_internal_w, g_internal_h);
         if (g_texture) {
@@ -1757,6 +2048,15 @@ void display_init(GameState *state)
 
     renderer_init();
 
+    if (g_headless) {
+        display_set_renderer_target_size(rw, rh);
+        display_update_letterbox(rw, rh);
+        g_present_width = rw;
+        g_present_height = rh;
+        printf("[DISPLAY] headless: rendering %dx%d into the cw buffer, no window\n", rw, rh);
+        return;
+    }
+
     const char *driver_override = SDL_getenv("AB3D_RENDER_DRIVER");
     /* Set AB3D_DISABLE_GL_UNPACK=1 to force D3D + SDL texture (CPU blit path). Otherwise prefer GL_R16UI. */
     const char *disable_gl_unpack = SDL_getenv("AB3D_DISABLE_GL_UNPACK");
@@ -1859,7 +2159,7 @@ void display_init(GameState *state)
             selected_hint = driver_try[i];
             SDL_SetHint(SDL_HINT_RENDER_DRIVER, selected_hint);
             g_sdl_ren = SDL_CreateRenderer(g_window, -1,
-                SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+                SDL_RENDERER_ACCELERATED | (g_present_uncapped ? 0u : (Uint32)SDL_RENDERER_PRESENTVSYNC));
             if (g_sdl_ren) break;
         }
         if (!g_sdl_ren) {
@@ -2012,10 +2312,11 @@ void display_toggle_fullscreen(void)
 
 void display_shutdown(void)
 {
-    display_hud_digits_free();
-    display_key_hud_free_textures();
+    display_hud_atlas_free();
+    display_hud_cache_free();
     display_gl_lines_release_scratch();
     g_key_hud_tex_tag = 0;
+    display_present_pipe_shutdown();
     renderer_shutdown();
     display_gl_shutdown_unpack();
     if (g_texture)  SDL_DestroyTexture(g_texture);
@@ -2183,114 +2484,145 @@ static void display_key_hud_fill_rect(SDL_Renderer *ren, int lx, int ly, int lw,
     display_overlay_fill_rect_abs(&rr, r, g, b, a);
 }
 
-static void display_key_hud_free_textures(void)
+static void display_key_hud_invalidate_frames(void)
 {
-    for (int i = 0; i < 4; i++) {
-        if (g_key_hud_tex[i]) {
-            SDL_DestroyTexture(g_key_hud_tex[i]);
-            g_key_hud_tex[i] = NULL;
-        }
-    }
+    g_key_hud_frame_mask = 0;
+    g_key_hud_frames_tried = 0;
 }
 
-static SDL_Texture *display_key_hud_texture_for_frame(int frame_idx)
+/* Rasterize key frames 0..3 into the atlas key row (once per key cache tag). */
+static void display_key_hud_refresh_frames(void)
 {
-    if (frame_idx < 0 || frame_idx >= 4 || !g_sdl_ren) return NULL;
-    if (g_key_hud_tex[frame_idx]) return g_key_hud_tex[frame_idx];
-
-    uint32_t pixels[32 * 32];
-    if (!renderer_key_sprite_rasterize_frame_argb(frame_idx, pixels, 32)) return NULL;
-
-    SDL_Texture *t = SDL_CreateTexture(g_sdl_ren, SDL_PIXELFORMAT_ARGB8888,
-                                         SDL_TEXTUREACCESS_STATIC, 32, 32);
-    if (!t) return NULL;
-    if (SDL_UpdateTexture(t, NULL, pixels, (int)(32 * sizeof(uint32_t))) != 0) {
-        SDL_DestroyTexture(t);
-        return NULL;
+    if (g_key_hud_frames_tried || !g_hud_atlas_tex) return;
+    g_key_hud_frames_tried = 1;
+
+    uint32_t pixels[HUD_KEY_FRAME_PX * HUD_KEY_FRAME_PX];
+    for (int f = 0; f < 4; f++) {
+        if (!renderer_key_sprite_rasterize_frame_argb(f, pixels, HUD_KEY_FRAME_PX)) continue;
+        SDL_Rect cell;
+        cell.x = HUD_ATLAS_PAD + f * (HUD_KEY_FRAME_PX + 2 * HUD_ATLAS_PAD);
+        cell.y = g_hud_key_row_y;
+        cell.w = HUD_KEY_FRAME_PX;
+        cell.h = HUD_KEY_FRAME_PX;
+        if (SDL_UpdateTexture(g_hud_atlas_tex, &cell, pixels,
+                              (int)(HUD_KEY_FRAME_PX * sizeof(uint32_t))) != 0) continue;
+        g_key_hud_frame_mask |= (uint8_t)(1u << f);
     }
-    SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
-    g_key_hud_tex[frame_idx] = t;
-    return t;
 }
 
-static void display_hud_digits_free(void)
+static int display_key_hud_frame_src(int frame_idx, SDL_Rect *src)
+{
+    if (frame_idx < 0 || frame_idx >= 4 || !g_sdl_ren) return 0;
+    display_hud_atlas_ensure_loaded();
+    display_key_hud_refresh_frames();
+    if (!(g_key_hud_frame_mask & (1u << frame_idx))) return 0;
+    src->x = HUD_ATLAS_PAD + frame_idx * (HUD_KEY_FRAME_PX + 2 * HUD_ATLAS_PAD);
+    src->y = g_hud_key_row_y;
+    src->w = HUD_KEY_FRAME_PX;
+    src->h = HUD_KEY_FRAME_PX;
+    return 1;
+}
+
+static void display_hud_atlas_free(void)
 {
+    if (g_hud_atlas_tex) {
+        SDL_DestroyTexture(g_hud_atlas_tex);
+        g_hud_atlas_tex = NULL;
+    }
     for (int i = 0; i < 2; i++) {
-        if (g_hud_digit_tex[i]) {
-            SDL_DestroyTexture(g_hud_digit_tex[i]);
-            g_hud_digit_tex[i] = NULL;
-        }
-        g_hud_digit_tex_w[i] = 0;
-        g_hud_digit_tex_h[i] = 0;
+        g_hud_digit_ok[i] = 0;
+        memset(&g_hud_digit_rect[i], 0, sizeof(g_hud_digit_rect[i]));
     }
-    g_hud_digits_load_attempted = 0;
+    g_hud_key_row_y = 0;
+    display_key_hud_invalidate_frames();
+    g_key_hud_tex_tag = 0;
+    g_hud_atlas_attempted = 0;
 }
 
-static void display_hud_digits_ensure_loaded(void)
+static void display_hud_atlas_ensure_loaded(void)
 {
-    if (g_hud_digits_load_attempted || !g_sdl_ren) return;
-    g_hud_digits_load_attempted = 1;
+    if (g_hud_atlas_attempted || !g_sdl_ren) return;
+    g_hud_atlas_attempted = 1;
 
     const char *names[2] = { "health_digits.png", "ammo_digits.png" };
+    unsigned char *rgba[2] = { NULL, NULL };
     char *base = SDL_GetBasePath();
     char path[512];
 
+    /* Stack the strips, then the key row; every region sits HUD_ATLAS_PAD in from its cell. */
+    int atlas_w = 4 * (HUD_KEY_FRAME_PX + 2 * HUD_ATLAS_PAD);
+    int y = 0;
     for (int i = 0; i < 2; i++) {
         int w = 0, h = 0, comp = 0;
-        unsigned char *rgba = NULL;
 
         if (base) {
             int plen = snprintf(path, sizeof(path), "%sfonts/%s", base, names[i]);
             if (plen > 0 && plen < (int)sizeof(path))
-                rgba = stbi_load(path, &w, &h, &comp, 4);
+                rgba[i] = stbi_load(path, &w, &h, &comp, 4);
         }
-        if (!rgba) {
+        if (!rgba[i]) {
             int plen = snprintf(path, sizeof(path), "fonts/%s", names[i]);
             if (plen > 0 && plen < (int)sizeof(path))
-                rgba = stbi_load(path, &w, &h, &comp, 4);
+                rgba[i] = stbi_load(path, &w, &h, &comp, 4);
         }
-        if (!rgba) {
+        if (!rgba[i]) {
             printf("[DISPLAY] HUD digits: could not load %s (%s)\n", names[i],
                    stbi_failure_reason() ? stbi_failure_reason() : "?");
             continue;
         }
-
-        size_t npix = (size_t)w * (size_t)h;
-        uint32_t *argb = (uint32_t *)malloc(npix * sizeof(uint32_t));
-        if (!argb) {
-            stbi_image_free(rgba);
-            continue;
-        }
-        for (size_t p = 0; p < npix; p++) {
-            unsigned char r = rgba[p * 4 + 0];
-            unsigned char g = rgba[p * 4 + 1];
-            unsigned char b = rgba[p * 4 + 2];
-            unsigned char a = rgba[p * 4 + 3];
-            argb[p] = ((uint32_t)a << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | (uint32_t)b;
+        g_hud_digit_rect[i].x = HUD_ATLAS_PAD;
+        g_hud_digit_rect[i].y = y + HUD_ATLAS_PAD;
+        g_hud_digit_rect[i].w = w;
+        g_hud_digit_rect[i].h = h;
+        y += h + 2 * HUD_ATLAS_PAD;
+        if (w + 2 * HUD_ATLAS_PAD > atlas_w) atlas_w = w + 2 * HUD_ATLAS_PAD;
+    }
+    if (base)
+        SDL_free(base);
+    g_hud_key_row_y = y + HUD_ATLAS_PAD;
+    int atlas_h = y + HUD_KEY_FRAME_PX + 2 * HUD_ATLAS_PAD;
+
+    uint32_t *argb = (uint32_t *)calloc((size_t)atlas_w * (size_t)atlas_h, sizeof(uint32_t));
+    if (argb) {
+        for (int i = 0; i < 2; i++) {
+            if (!rgba[i]) continue;
+            const SDL_Rect *rc = &g_hud_digit_rect[i];
+            for (int ry = 0; ry < rc->h; ry++) {
+                const unsigned char *src = rgba[i] + (size_t)ry * (size_t)rc->w * 4u;
+                uint32_t *dst = argb + (size_t)(rc->y + ry) * (size_t)atlas_w + (size_t)rc->x;
+                for (int rx = 0; rx < rc->w; rx++) {
+                    unsigned char r = src[rx * 4 + 0];
+                    unsigned char g = src[rx * 4 + 1];
+                    unsigned char b = src[rx * 4 + 2];
+                    unsigned char a = src[rx * 4 + 3];
+                    dst[rx] = ((uint32_t)a << 24) | ((uint32_t)r << 16) | ((uint32_t)g << 8) | (uint32_t)b;
+                }
+            }
         }
-        stbi_image_free(rgba);
 
         SDL_Texture *t = SDL_CreateTexture(g_sdl_ren, SDL_PIXELFORMAT_ARGB8888,
-                                           SDL_TEXTUREACCESS_STATIC, w, h);
-        if (!t || SDL_UpdateTexture(t, NULL, argb, (int)(w * (int)sizeof(uint32_t))) != 0) {
+                                           SDL_TEXTUREACCESS_STATIC, atlas_w, atlas_h);
+        if (!t || SDL_UpdateTexture(t, NULL, argb, (int)(atlas_w * (int)sizeof(uint32_t))) != 0) {
             if (t) SDL_DestroyTexture(t);
-            free(argb);
-            printf("[DISPLAY] HUD digits: SDL texture failed for %s\n", names[i]);
-            continue;
+            t = NULL;
+            printf("[DISPLAY] HUD atlas: SDL texture failed (%dx%d)\n", atlas_w, atlas_h);
         }
         free(argb);
-        SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
+        if (t) {
+            SDL_SetTextureBlendMode(t, SDL_BLENDMODE_BLEND);
 #if SDL_VERSION_ATLEAST(2, 0, 12)
-        /* Nearest: linear upscale bleeds between adjacent digits in the strip atlas. */
-        SDL_SetTextureScaleMode(t, SDL_ScaleModeNearest);
+            /* Nearest: linear upscale bleeds between adjacent digits in the strip atlas. */
+            SDL_SetTextureScaleMode(t, SDL_ScaleModeNearest);
 #endif
-        g_hud_digit_tex[i] = t;
-        g_hud_digit_tex_w[i] = w;
-        g_hud_digit_tex_h[i] = h;
+            g_hud_atlas_tex = t;
+            for (int i = 0; i < 2; i++)
+                g_hud_digit_ok[i] = (rgba[i] != NULL);
+        }
     }
-
-    if (base)
-        SDL_free(base);
+    for (int i = 0; i < 2; i++) {
+        if (rgba[i]) stbi_image_free(rgba[i]);
+    }
+    display_key_hud_invalidate_frames();
 }
 
 /*
@@ -2361,6 +2693,15 @@ static void hud_digit_src_rect(int tex_w, int tex_h, int digit, SDL_Rect *src)
     src->h = tex_h;
 }
 
+/* Digit cell of strip 0/1 in HUD atlas coordinates. */
+static void hud_digit_atlas_src_rect(int strip, int digit, SDL_Rect *src)
+{
+    const SDL_Rect *region = &g_hud_digit_rect[strip];
+    hud_digit_src_rect(region->w, region->h, digit, src);
+    src->x += region->x;
+    src->y += region->y;
+}
+
 /* Widest scaled glyph — fixed column width so 0..9 align in three slots. */
 static int hud_max_digit_scaled_width(int tex_w, int tex_h, int digit_h)
 {
@@ -2386,9 +2727,12 @@ static int hud_three_slot_width(int tex_w, int tex_h, int digit_h, int gap)
  * (health max 100, ammo count max 999).
  * x_left, y_top, digit_h, gap are in letterbox pixels (same space as hud_key_row_layout).
  */
-static void hud_draw_three_slot_value(SDL_Texture *tex, int tex_w, int tex_h, int digit_h,
+static void hud_draw_three_slot_value(int strip, int digit_h,
                                       int value, int max_value, int x_left, int y_top, int gap)
 {
+    const SDL_Rect *region = &g_hud_digit_rect[strip];
+    int tex_w = region->w;
+    int tex_h = region->h;
     if (value < 0) value = 0;
     if (value > max_value) value = max_value;
     char b[8];
@@ -2415,7 +2759,7 @@ static void hud_draw_three_slot_value(SDL_Texture *tex, int tex_w, int tex_h, in
         int d = b[s] - '0';
         if (d < 0 || d > 9) continue;
         SDL_Rect src;
-        hud_digit_src_rect(tex_w, tex_h, d, &src);
+        hud_digit_atlas_src_rect(strip, d, &src);
         int dw = (src.w * digit_h + src.h / 2) / src.h;
         if (dw < 1) dw = 1;
         int slot_ix = x_left + s * (slot_w + gap);
@@ -2429,7 +2773,7 @@ static void hud_draw_three_slot_value(SDL_Texture *tex, int tex_w, int tex_h, in
         dst.w = px1i - px0i;
         if (dst.w < 1) dst.w = 1;
         dst.h = sh;
-        display_overlay_copy(tex, &src, &dst);
+        display_overlay_copy(g_hud_atlas_tex, &src, &dst);
     }
 }
 
@@ -2442,13 +2786,12 @@ static void display_fps_overlay(const GameState *state)
     int ph = g_present_dst_rect.h;
     if (pw < 8 || ph < 8) return;
 
-    display_hud_digits_ensure_loaded();
-    SDL_Texture *tex = g_hud_digit_tex[1];
-    if (!tex) return;
+    display_hud_atlas_ensure_loaded();
+    if (!g_hud_atlas_tex || !g_hud_digit_ok[1]) return;
 
-    int tex_w = g_hud_digit_tex_w[1];
-    int tex_h = g_hud_digit_tex_h[1];
-    SDL_SetTextureAlphaMod(tex, 255);
+    int tex_w = g_hud_digit_rect[1].w;
+    int tex_h = g_hud_digit_rect[1].h;
+    SDL_SetTextureAlphaMod(g_hud_atlas_tex, 255);
 
     int margin = ph / 64;
     if (margin < 2) margin = 2;
@@ -2478,7 +2821,7 @@ static void display_fps_overlay(const GameState *state)
         int d = buf[i] - '0';
         if (d < 0 || d > 9) continue;
         SDL_Rect src;
-        hud_digit_src_rect(tex_w, tex_h, d, &src);
+        hud_digit_atlas_src_rect(1, d, &src);
         int dw = (src.w * digit_h + src.h / 2) / src.h;
         if (dw < 1) dw = 1;
         int slot_ix = x_left + (int)i * (slot_w + d_gap);
@@ -2491,24 +2834,13 @@ static void display_fps_overlay(const GameState *state)
         dst.w = px1i - px0i;
         if (dst.w < 1) dst.w = 1;
         dst.h = sh;
-        display_overlay_copy(tex, &src, &dst);
+        display_overlay_copy(g_hud_atlas_tex, &src, &dst);
     }
 }
 
-static void display_hud_stats_sdl_overlay(const GameState *state)
+/* Health percent and raw ammo count exactly as the stats HUD shows them. */
+static void hud_stats_values(const GameState *state, int *out_hp_pct, int *out_ammo_count)
 {
-    if (!state || !g_sdl_ren) return;
-
-    int pw = g_present_dst_rect.w;
-    int ph = g_present_dst_rect.h;
-    if (pw < 8 || ph < 8) return;
-
-    display_hud_digits_ensure_loaded();
-    if (!g_hud_digit_tex[0] && !g_hud_digit_tex[1]) return;
-
-    int margin, kh, gap_keys, group_w, ix_key0, iy;
-    hud_key_row_layout(pw, ph, &margin, &kh, &gap_keys, &group_w, &ix_key0, &iy);
-
     int16_t e = state->energy;
     if (e < 0) e = 0;
     if (e > PLAYER_MAX_ENERGY) e = PLAYER_MAX_ENERGY;
@@ -2525,6 +2857,26 @@ static void display_hud_stats_sdl_overlay(const GameState *state)
         if (ammo_count < 0) ammo_count = 0;
         if (ammo_count > (int)MAX_AMMO_RAW) ammo_count = (int)MAX_AMMO_RAW;
     }
+    *out_hp_pct = hp_pct;
+    *out_ammo_count = ammo_count;
+}
+
+static void display_hud_stats_sdl_overlay(const GameState *state)
+{
+    if (!state || !g_sdl_ren) return;
+
+    int pw = g_present_dst_rect.w;
+    int ph = g_present_dst_rect.h;
+    if (pw < 8 || ph < 8) return;
+
+    display_hud_atlas_ensure_loaded();
+    if (!g_hud_atlas_tex || (!g_hud_digit_ok[0] && !g_hud_digit_ok[1])) return;
+
+    int margin, kh, gap_keys, group_w, ix_key0, iy;
+    hud_key_row_layout(pw, ph, &margin, &kh, &gap_keys, &group_w, &ix_key0, &iy);
+
+    int hp_pct, ammo_count;
+    hud_stats_values(state, &hp_pct, &ammo_count);
 
     /* Horizontal margin between health | ammo | keys (letterbox pixels). */
     int gap_stat = kh / 4;
@@ -2534,10 +2886,10 @@ static void display_hud_stats_sdl_overlay(const GameState *state)
 
     int digit_h = kh;
     int health_w = 0, ammo_w = 0;
-    if (g_hud_digit_tex[0])
-        health_w = hud_three_slot_width(g_hud_digit_tex_w[0], g_hud_digit_tex_h[0], digit_h, d_gap);
-    if (g_hud_digit_tex[1])
-        ammo_w = hud_three_slot_width(g_hud_digit_tex_w[1], g_hud_digit_tex_h[1], digit_h, d_gap);
+    if (g_hud_digit_ok[0])
+        health_w = hud_three_slot_width(g_hud_digit_rect[0].w, g_hud_digit_rect[0].h, digit_h, d_gap);
+    if (g_hud_digit_ok[1])
+        ammo_w = hud_three_slot_width(g_hud_digit_rect[1].w, g_hud_digit_rect[1].h, digit_h, d_gap);
 
     /* Shrink digits if stats would extend left of the margin (health | ammo | gap | keys). */
     for (int attempt = 0; attempt < 10; attempt++) {
@@ -2547,24 +2899,21 @@ static void display_hud_stats_sdl_overlay(const GameState *state)
         if (leftmost >= margin) break;
         digit_h = digit_h * 9 / 10;
         if (digit_h < 6) break;
-        health_w = g_hud_digit_tex[0] ? hud_three_slot_width(g_hud_digit_tex_w[0], g_hud_digit_tex_h[0], digit_h, d_gap) : 0;
-        ammo_w = g_hud_digit_tex[1] ? hud_three_slot_width(g_hud_digit_tex_w[1], g_hud_digit_tex_h[1], digit_h, d_gap) : 0;
+        health_w = g_hud_digit_ok[0] ? hud_three_slot_width(g_hud_digit_rect[0].w, g_hud_digit_rect[0].h, digit_h, d_gap) : 0;
+        ammo_w = g_hud_digit_ok[1] ? hud_three_slot_width(g_hud_digit_rect[1].w, g_hud_digit_rect[1].h, digit_h, d_gap) : 0;
     }
 
     /* Right edge of stat block sits just left of the key row (same baseline iy). */
     int right = ix_key0 - gap_stat;
-    if (g_hud_digit_tex[1] && ammo_w > 0) {
+    SDL_SetTextureAlphaMod(g_hud_atlas_tex, 255);
+    if (g_hud_digit_ok[1] && ammo_w > 0) {
         int ammo_x = right - ammo_w;
-        SDL_SetTextureAlphaMod(g_hud_digit_tex[1], 255);
-        hud_draw_three_slot_value(g_hud_digit_tex[1], g_hud_digit_tex_w[1], g_hud_digit_tex_h[1],
-                                  digit_h, ammo_count, (int)MAX_AMMO_RAW, ammo_x, iy, d_gap);
+        hud_draw_three_slot_value(1, digit_h, ammo_count, (int)MAX_AMMO_RAW, ammo_x, iy, d_gap);
         right = ammo_x - gap_stat;
     }
-    if (g_hud_digit_tex[0] && health_w > 0) {
+    if (g_hud_digit_ok[0] && health_w > 0) {
         int health_x = right - health_w;
-        SDL_SetTextureAlphaMod(g_hud_digit_tex[0], 255);
-        hud_draw_three_slot_value(g_hud_digit_tex[0], g_hud_digit_tex_w[0], g_hud_digit_tex_h[0],
-                                  digit_h, hp_pct, 100, health_x, iy, d_gap);
+        hud_draw_three_slot_value(0, digit_h, hp_pct, 100, health_x, iy, d_gap);
     }
 }
 
@@ -2578,7 +2927,7 @@ static void display_key_hud_sdl_overlay(const GameState *state)
 
     uintptr_t tag = renderer_key_sprite_hud_cache_tag(state);
     if (tag != g_key_hud_tex_tag) {
-        display_key_hud_free_textures();
+        display_key_hud_invalidate_frames();
         g_key_hud_tex_tag = tag;
     }
 
@@ -2603,15 +2952,15 @@ static void display_key_hud_sdl_overlay(const GameState *state)
 
         int ix = ix0 + i * (kh + gap);
 
-        SDL_Texture *tex = display_key_hud_texture_for_frame(frame);
-        if (tex) {
-            SDL_SetTextureAlphaMod(tex, alpha);
+        SDL_Rect src;
+        if (display_key_hud_frame_src(frame, &src)) {
+            SDL_SetTextureAlphaMod(g_hud_atlas_tex, alpha);
             SDL_Rect dst;
             dst.x = g_present_dst_rect.x + ix;
             dst.y = g_present_dst_rect.y + iy;
             dst.w = kh;
             dst.h = kh;
-            display_overlay_copy(tex, NULL, &dst);
+            display_overlay_copy(g_hud_atlas_tex, &src, &dst);
             continue;
         }
 
@@ -2648,6 +2997,455 @@ static void display_key_hud_sdl_overlay(const GameState *state)
     }
 }
 
+/*
+ * HUD cache: the stats digits, key row and FPS counter only change when a shown
+ * value does, so they are drawn once into a letterbox-sized render target and
+ * presented as a single premultiplied quad. The signature holds every input the
+ * element draws read; any difference (or a new letterbox size) redraws the cache.
+ * AB3D_DISABLE_HUD_CACHE=1 draws the elements directly every present.
+ */
+typedef struct {
+    int       pw, ph;
+    int       hp_pct;
+    int       ammo_count;
+    int       fps;          /* -1: FPS counter hidden */
+    uintptr_t key_tag;
+    uint16_t  key_state;    /* per key: 2-bit sprite frame | collected bit */
+    uint16_t  key_c12[4];
+} DisplayHudCacheSig;
+
+static DisplayHudCacheSig g_hud_cache_sig;
+static int g_hud_cache_w, g_hud_cache_h;
+static int g_hud_cache_valid;
+static int g_hud_cache_state = -1;
+
+static void display_hud_cache_free(void)
+{
+    if (g_hud_cache_tex) SDL_DestroyTexture(g_hud_cache_tex);
+    g_hud_cache_tex = NULL;
+    g_hud_cache_w = 0;
+    g_hud_cache_h = 0;
+    g_hud_cache_valid = 0;
+}
+
+void display_hud_cache_invalidate(void)
+{
+    g_hud_cache_valid = 0;
+}
+
+void display_hud_cache_device_reset(void)
+{
+    /* The texture belongs to the lost device: display_hud_cache_present makes a new one. */
+    display_hud_cache_free();
+}
+
+static int display_hud_cache_enabled(void)
+{
+    if (g_hud_cache_state < 0) {
+        int on = settings_env_feature_enabled(NULL, "AB3D_DISABLE_HUD_CACHE");
+        if (on && !SDL_RenderTargetSupported(g_sdl_ren)) {
+            printf("[DISPLAY] HUD cache: render targets unsupported, drawing HUD per frame\n");
+            on = 0;
+        }
+        g_hud_cache_state = on;
+    }
+    return g_hud_cache_state;
+}
+
+static void display_hud_cache_signature(const GameState *state, DisplayHudCacheSig *sig)
+{
+    memset(sig, 0, sizeof(*sig));
+    sig->pw = g_present_dst_rect.w;
+    sig->ph = g_present_dst_rect.h;
+    hud_stats_values(state, &sig->hp_pct, &sig->ammo_count);
+    sig->fps = state->cfg_show_fps ? (int)state->fps_display : -1;
+    sig->key_tag = renderer_key_sprite_hud_cache_tag(state);
+    for (int i = 0; i < 4; i++) {
+        int frame = renderer_key_sprite_frame_for_condition_bit(state, i);
+        if (frame < 0) frame = 0;
+        if (frame > 3) frame = 3;
+        int collected = (((uint16_t)game_conditions & (uint16_t)(1u << i)) != 0);
+        sig->key_state |= (uint16_t)((frame | (collected << 2)) << (i * 3));
+        sig->key_c12[i] = renderer_key_condition_bit_color_c12(state, i);
+    }
+}
+
+static int display_hud_cache_redraw(const GameState *state)
+{
+    int gl_overlay = g_gl_unpack_ok && g_gl_hud_ok;
+
+    /* SDL draws into the target below; leave no raw GL program/VAO bound under it. */
+    if (gl_overlay)
+        display_gl_overlay_end();
+    if (SDL_SetRenderTarget(g_sdl_ren, g_hud_cache_tex) != 0) {
+        if (gl_overlay)
+            display_gl_overlay_begin();
+        return 0;
+    }
+    SDL_SetRenderDrawBlendMode(g_sdl_ren, SDL_BLENDMODE_NONE);
+    SDL_SetRenderDrawColor(g_sdl_ren, 0, 0, 0, 0);
+    SDL_RenderClear(g_sdl_ren);
+    /* Same no-op as display_sdl_resync_after_raw_gl: force SDL to reselect its shader. */
+    SDL_SetRenderDrawBlendMode(g_sdl_ren, SDL_BLENDMODE_BLEND);
+    SDL_RenderDrawPoint(g_sdl_ren, 0, 0);
+
+    /* Element draws add the letterbox origin; the cache's origin is its top-left. */
+    SDL_Rect saved_dst = g_present_dst_rect;
+    g_present_dst_rect.x = 0;
+    g_present_dst_rect.y = 0;
+    g_hud_cache_building = 1;
+    display_hud_stats_sdl_overlay(state);
+    display_key_hud_sdl_overlay(state);
+    display_fps_overlay(state);
+    g_hud_cache_building = 0;
+    g_present_dst_rect = saved_dst;
+
+    SDL_SetRenderTarget(g_sdl_ren, NULL);
+    if (gl_overlay)
+        display_gl_overlay_begin();
+    else
+        SDL_RenderSetViewport(g_sdl_ren, NULL);
+    return 1;
+}
+
+/* Present the cached HUD; returns 0 when the caller must draw the elements directly. */
+static int display_hud_cache_present(const GameState *state)
+{
+    if (!display_hud_cache_enabled()) return 0;
+
+    int pw = g_present_dst_rect.w;
+    int ph = g_present_dst_rect.h;
+    if (pw < 8 || ph < 8) return 1; /* the element draws skip tiny letterboxes too */
+
+    if (!g_hud_cache_tex || g_hud_cache_w != pw || g_hud_cache_h != ph) {
+        display_hud_cache_free();
+        g_hud_cache_tex = SDL_CreateTexture(g_sdl_ren, SDL_PIXELFORMAT_ARGB8888,
+                                            SDL_TEXTUREACCESS_TARGET, pw, ph);
+        if (!g_hud_cache_tex) {
+            printf("[DISPLAY] HUD cache: %dx%d target failed (%s), drawing HUD per frame\n",
+                   pw, ph, SDL_GetError());
+            g_hud_cache_state = 0;
+            return 0;
+        }
+        /* Blending onto transparent black leaves the target premultiplied. */
+        SDL_SetTextureBlendMode(g_hud_cache_tex,
+                                SDL_ComposeCustomBlendMode(SDL_BLENDFACTOR_ONE,
+                                                           SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                                                           SDL_BLENDOPERATION_ADD,
+                                                           SDL_BLENDFACTOR_ONE,
+                                                           SDL_BLENDFACTOR_ONE_MINUS_SRC_ALPHA,
+                                                           SDL_BLENDOPERATION_ADD));
+        g_hud_cache_w = pw;
+        g_hud_cache_h = ph;
+    }
+
+    DisplayHudCacheSig sig;
+    display_hud_cache_signature(state, &sig);
+    if (!g_hud_cache_valid || memcmp(&sig, &g_hud_cache_sig, sizeof(sig)) != 0) {
+        if (!display_hud_cache_redraw(state)) return 0;
+        g_hud_cache_sig = sig;
+        g_hud_cache_valid = 1;
+    }
+
+    SDL_Rect dst = g_present_dst_rect;
+    if (g_gl_unpack_ok && g_gl_hud_ok) {
+        g_gl_blend_func(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+        display_gl_texture_blit(g_hud_cache_tex, NULL, &dst);
+        g_gl_blend_func(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    } else {
+        SDL_RenderCopy(g_sdl_ren, g_hud_cache_tex, NULL, &dst);
+    }
+    return 1;
+}
+
+/* -----------------------------------------------------------------------
+ * Automap GL: persistent per-level wall buffer
+ *
+ * Seen walls only ever append, so their stroke quads live in one VBO in world
+ * units: black outlines in the first half, colour strokes in the second (same
+ * draw order as the bucketed path). Walls revealed since the last present are
+ * appended with glBufferSubData; pan, zoom, flip and letterbox are one affine
+ * uniform, widening happens in the vertex shader. A renderer_automap_copy_walls
+ * revision change (door colour, level unload, save restore) rebuilds it.
+ * AB3D_DISABLE_AUTOMAP_VBO=1 keeps the per-frame stroked path.
+ * ----------------------------------------------------------------------- */
+#define DISPLAY_AUTOMAP_GL_CHUNK     1024   /* walls copied from the renderer per call */
+#define DISPLAY_AUTOMAP_GL_MIN_CAP   4096   /* initial walls per half of the VBO */
+
+typedef struct {
+    float   seg[4];   /* world x1, z1, x2, z2 */
+    float   ext[2];   /* 0 = (x1,z1) end, 1 = (x2,z2) end; signed half-width in window px */
+    uint8_t rgba[4];
+} DisplayAutomapGlVertex;
+
+#if defined(__EMSCRIPTEN__)
+static const char automap_gl_vs_src[] =
+    "#version 300 es\n"
+    "precision highp float;\n"
+    "layout(location=0) in vec4 a_seg;\n"
+    "layout(location=1) in vec2 a_ext;\n"
+    "layout(location=2) in vec4 a_col;\n"
+    "uniform vec4 u_xform;\n"
+    "uniform vec2 u_win;\n"
+    "out vec4 v_col;\n"
+    "void main() {\n"
+    "  vec2 a = u_xform.xz + u_xform.yw * a_seg.xy;\n"
+    "  vec2 b = u_xform.xz + u_xform.yw * a_seg.zw;\n"
+    "  vec2 d = b - a;\n"
+    "  float len = length(d);\n"
+    "  vec2 n = (len > 1e-6) ? vec2(-d.y, d.x) / len : vec2(0.0);\n"
+    "  vec2 p = mix(a, b, a_ext.x) + n * a_ext.y;\n"
+    "  gl_Position = vec4(2.0 * p.x / u_win.x - 1.0, 1.0 - 2.0 * p.y / u_win.y, 0.0, 1.0);\n"
+    "  v_col = a_col;\n"
+    "}\n";
+
+static const char automap_gl_fs_src[] =
+    "#version 300 es\n"
+    "precision mediump float;\n"
+    "in vec4 v_col;\n"
+    "out vec4 o_col;\n"
+    "void main() { o_col = v_col; }\n";
+#else
+static const char automap_gl_vs_src[] =
+    "#version 330 core\n"
+    "layout(location=0) in vec4 a_seg;\n"
+    "layout(location=1) in vec2 a_ext;\n"
+    "layout(location=2) in vec4 a_col;\n"
+    "uniform vec4 u_xform;\n"
+    "uniform vec2 u_win;\n"
+    "out vec4 v_col;\n"
+    "void main() {\n"
+    "  vec2 a = u_xform.xz + u_xform.yw * a_seg.xy;\n"
+    "  vec2 b = u_xform.xz + u_xform.yw * a_seg.zw;\n"
+    "  vec2 d = b - a;\n"
+    "  float len = length(d);\n"
+    "  vec2 n = (len > 1e-6) ? vec2(-d.y, d.x) / len : vec2(0.0);\n"
+    "  vec2 p = mix(a, b, a_ext.x) + n * a_ext.y;\n"
+    "  gl_Position = vec4(2.0 * p.x / u_win.x - 1.0, 1.0 - 2.0 * p.y / u_win.y, 0.0, 1.0);\n"
+    "  v_col = a_col;\n"
+    "}\n";
+
+static const char automap_gl_fs_src[] =
+    "#version 330 core\n"
+    "in vec4 v_col;\n"
+    "out vec4 o_col;\n"
+    "void main() { o_col = v_col; }\n";
+#endif
+
+typedef void (APIENTRY *DisplayGlBufferSubDataFn)(GLenum target, ptrdiff_t offset, ptrdiff_t size, const void *data);
+typedef void (APIENTRY *DisplayGlUniform2fFn)(GLint location, GLfloat v0, GLfloat v1);
+
+static DisplayGlBufferSubDataFn g_gl_buffer_sub_data;
+static DisplayGlUniform2fFn     g_gl_uniform2f;
+static GLuint   g_automap_gl_prog;
+static GLuint   g_automap_gl_vao;
+static GLuint   g_automap_gl_vbo;
+static GLint    g_automap_gl_loc_xform;
+static GLint    g_automap_gl_loc_win;
+static int      g_automap_gl_state = -1; /* -1 not tried, 0 unavailable, 1 ready */
+static uint32_t g_automap_gl_cap;        /* walls per VBO half */
+static uint32_t g_automap_gl_count;      /* walls uploaded */
+static uint32_t g_automap_gl_rev;
+
+static void display_automap_gl_shutdown(void)
+{
+    if (g_automap_gl_state == 1) {
+        if (g_gl_delete_vertex_arrays && g_automap_gl_vao) g_gl_delete_vertex_arrays(1, &g_automap_gl_vao);
+        if (g_gl_delete_buffers && g_automap_gl_vbo) g_gl_delete_buffers(1, &g_automap_gl_vbo);
+        if (g_gl_delete_program && g_automap_gl_prog) g_gl_delete_program(g_automap_gl_prog);
+    }
+    g_automap_gl_vao = 0;
+    g_automap_gl_vbo = 0;
+    g_automap_gl_prog = 0;
+    g_automap_gl_cap = 0;
+    g_automap_gl_count = 0;
+    g_automap_gl_rev = 0;
+    g_automap_gl_state = -1;
+}
+
+static int display_automap_gl_init(void)
+{
+    if (!settings_env_feature_enabled(NULL, "AB3D_DISABLE_AUTOMAP_VBO")) return 0;
+
+    g_gl_buffer_sub_data = (DisplayGlBufferSubDataFn)SDL_GL_GetProcAddress("glBufferSubData");
+    g_gl_uniform2f = (DisplayGlUniform2fFn)SDL_GL_GetProcAddress("glUniform2f");
+    if (!g_gl_buffer_sub_data || !g_gl_uniform2f) return 0;
+
+    GLuint vs = display_gl_compile_shader(GL_VERTEX_SHADER, automap_gl_vs_src);
+    GLuint fs = display_gl_compile_shader(GL_FRAGMENT_SHADER, automap_gl_fs_src);
+    if (!vs || !fs) {
+        if (vs) g_gl_delete_shader(vs);
+        if (fs) g_gl_delete_shader(fs);
+        return 0;
+    }
+    g_automap_gl_prog = g_gl_create_program();
+    if (!g_automap_gl_prog) {
+        g_gl_delete_shader(vs);
+        g_gl_delete_shader(fs);
+        return 0;
+    }
+    g_gl_attach_shader(g_automap_gl_prog, vs);
+    g_gl_attach_shader(g_automap_gl_prog, fs);
+    g_gl_delete_shader(vs);
+    g_gl_delete_shader(fs);
+    g_gl_link_program(g_automap_gl_prog);
+    GLint linked = 0;
+    g_gl_get_programiv(g_automap_gl_prog, GL_LINK_STATUS, &linked);
+    if (!linked) {
+        char log[1024];
+        log[0] = 0;
+        if (g_gl_get_program_info_log) g_gl_get_program_info_log(g_automap_gl_prog, (GLsizei)sizeof(log), NULL, log);
+        printf("[DISPLAY] automap GL program link failed: %s\n", log);
+        g_gl_delete_program(g_automap_gl_prog);
+        g_automap_gl_prog = 0;
+        return 0;
+    }
+    g_automap_gl_loc_xform = g_gl_get_uniform_location(g_automap_gl_prog, "u_xform");
+    g_automap_gl_loc_win = g_gl_get_uniform_location(g_automap_gl_prog, "u_win");
+
+    const GLsizei stride = (GLsizei)sizeof(DisplayAutomapGlVertex);
+    g_gl_gen_vertex_arrays(1, &g_automap_gl_vao);
+    g_gl_gen_buffers(1, &g_automap_gl_vbo);
+    g_gl_bind_vertex_array(g_automap_gl_vao);
+    g_gl_bind_buffer(0x8892 /* GL_ARRAY_BUFFER */, g_automap_gl_vbo);
+    g_gl_vertex_attrib_pointer(0, 4, 0x1406 /* GL_FLOAT */, 0, stride,
+                               (const void *)(uintptr_t)offsetof(DisplayAutomapGlVertex, seg));
+    g_gl_vertex_attrib_pointer(1, 2, 0x1406, 0, stride,
+                               (const void *)(uintptr_t)offsetof(DisplayAutomapGlVertex, ext));
+    g_gl_vertex_attrib_pointer(2, 4, 0x1401 /* GL_UNSIGNED_BYTE */, 1, stride,
+                               (const void *)(uintptr_t)offsetof(DisplayAutomapGlVertex, rgba));
+    g_gl_enable_vertex_attrib_array(0);
+    g_gl_enable_vertex_attrib_array(1);
+    g_gl_enable_vertex_attrib_array(2);
+    g_gl_bind_vertex_array(0);
+    g_gl_bind_buffer(0x8892, 0);
+
+    g_automap_gl_cap = 0;
+    g_automap_gl_count = 0;
+    g_automap_gl_rev = 0;
+    printf("[DISPLAY] automap: persistent GL wall buffer\n");
+    return 1;
+}
+
+/* One stroke quad (two triangles) in world units, widened by half_w window pixels. */
+static void display_automap_gl_quad(DisplayAutomapGlVertex *v, const RendererAutomapWall *w,
+                                    float half_w, Uint8 r, Uint8 g, Uint8 b, Uint8 a)
+{
+    static const float k_ext[6][2] = {
+        { 0.0f, -1.0f }, { 1.0f, -1.0f }, { 0.0f, 1.0f },
+        { 1.0f, -1.0f }, { 1.0f,  1.0f }, { 0.0f, 1.0f },
+    };
+    for (int i = 0; i < 6; i++) {
+        v[i].seg[0] = (float)w->x1;
+        v[i].seg[1] = (float)w->z1;
+        v[i].seg[2] = (float)w->x2;
+        v[i].seg[3] = (float)w->z2;
+        v[i].ext[0] = k_ext[i][0];
+        v[i].ext[1] = k_ext[i][1] * half_w;
+        v[i].rgba[0] = r;
+        v[i].rgba[1] = g;
+        v[i].rgba[2] = b;
+        v[i].rgba[3] = a;
+    }
+}
+
+/* Append walls revealed since the last sync; returns 0 if the buffer is unusable. */
+static int display_automap_gl_sync(GameState *state)
+{
+    static RendererAutomapWall s_walls[DISPLAY_AUTOMAP_GL_CHUNK];
+    static DisplayAutomapGlVertex s_black[DISPLAY_AUTOMAP_GL_CHUNK * 6];
+    static DisplayAutomapGlVertex s_fg[DISPLAY_AUTOMAP_GL_CHUNK * 6];
+    const size_t wall_bytes = 6u * sizeof(DisplayAutomapGlVertex);
+    int restarts = 0;
+
+    g_gl_bind_buffer(0x8892 /* GL_ARRAY_BUFFER */, g_automap_gl_vbo);
+    for (;;) {
+        uint32_t rev = 0;
+        int got = renderer_automap_copy_walls(state, g_automap_gl_count, s_walls,
+                                              DISPLAY_AUTOMAP_GL_CHUNK, &rev);
+        int full = (uint64_t)g_automap_gl_count + (uint64_t)got > g_automap_gl_cap;
+        if (rev != g_automap_gl_rev || full) {
+            /* Earlier walls changed, or the buffer is full: (re)allocate and re-copy from 0. */
+            if (rev != g_automap_gl_rev && ++restarts > 4) return 0;
+            if (full) {
+                uint32_t cap = g_automap_gl_cap ? g_automap_gl_cap : DISPLAY_AUTOMAP_GL_MIN_CAP;
+                while (cap < g_automap_gl_count + (uint32_t)got + DISPLAY_AUTOMAP_GL_CHUNK) {
+                    if (cap > UINT32_MAX / 2u) return 0;
+                    cap *= 2u;
+                }
+                g_gl_buffer_data(0x8892, (ptrdiff_t)(2u * (size_t)cap * wall_bytes), NULL,
+                                 0x88E8 /* GL_DYNAMIC_DRAW */);
+                g_automap_gl_cap = cap;
+            }
+            g_automap_gl_rev = rev;
+            g_automap_gl_count = 0;
+            continue;
+        }
+        if (got <= 0) break;
+
+        for (int i = 0; i < got; i++) {
+            uint16_t seg = s_walls[i].c12;
+            Uint8 alpha = (seg & RENDERER_AUTOMAP_SEGFLAG_INTERNAL) ? (Uint8)128 : (Uint8)255;
+            Uint8 fr, fg, fb;
+            display_automap_amiga12_to_rgb(seg, &fr, &fg, &fb);
+            display_automap_gl_quad(&s_black[i * 6], &s_walls[i], 3.5f, 0, 0, 0, alpha);
+            display_automap_gl_quad(&s_fg[i * 6], &s_walls[i], 1.5f, fr, fg, fb, alpha);
+        }
+        g_gl_buffer_sub_data(0x8892, (ptrdiff_t)((size_t)g_automap_gl_count * wall_bytes),
+                             (ptrdiff_t)((size_t)got * wall_bytes), s_black);
+        g_gl_buffer_sub_data(0x8892,
+                             (ptrdiff_t)(((size_t)g_automap_gl_cap + g_automap_gl_count) * wall_bytes),
+                             (ptrdiff_t)((size_t)got * wall_bytes), s_fg);
+        g_automap_gl_count += (uint32_t)got;
+        if (got < DISPLAY_AUTOMAP_GL_CHUNK) break;
+    }
+    return 1;
+}
+
+/* Draw every seen wall from the persistent buffer; returns 0 to use the per-frame path. */
+static int display_automap_gl_draw_walls(GameState *state)
+{
+    if (g_automap_gl_state < 0)
+        g_automap_gl_state = display_automap_gl_init();
+    if (g_automap_gl_state != 1 || g_gl_overlay_win_w < 1) return 0;
+
+#if SDL_VERSION_ATLEAST(2, 0, 14)
+    SDL_RenderFlush(g_sdl_ren);
+#endif
+    if (!display_automap_gl_sync(state)) {
+        g_gl_bind_buffer(0x8892 /* GL_ARRAY_BUFFER */, 0);
+        return 0;
+    }
+    if (g_automap_gl_count == 0) return 1;
+
+    /* Internal pixel (mx - (cx + (x - px) / u), cy + (z - pz) / u) mapped into the letterbox
+     * (display_automap_map_pt), folded into window = origin + scale * world. */
+    int32_t px, pz, units;
+    renderer_automap_get_view(state, &px, &pz, &units);
+    int iw = renderer_get_width();
+    int ih = renderer_get_height();
+    if (iw < 1) iw = 1;
+    if (ih < 1) ih = 1;
+    float kx = (float)g_present_dst_rect.w / (float)iw;
+    float ky = (float)g_present_dst_rect.h / (float)ih;
+    float inv_u = 1.0f / (float)units;
+    float mx = (float)(iw - 1), cx = (float)(iw / 2), cy = (float)(ih / 2);
+    float x0 = (float)g_present_dst_rect.x + (mx - cx + (float)px * inv_u) * kx;
+    float y0 = (float)g_present_dst_rect.y + (cy - (float)pz * inv_u) * ky;
+
+    g_gl_use_program(g_automap_gl_prog);
+    if (g_automap_gl_loc_xform >= 0)
+        g_gl_uniform4f(g_automap_gl_loc_xform, x0, -kx * inv_u, y0, ky * inv_u);
+    if (g_automap_gl_loc_win >= 0)
+        g_gl_uniform2f(g_automap_gl_loc_win, (float)g_gl_overlay_win_w, (float)g_gl_overlay_win_h);
+    g_gl_bind_vertex_array(g_automap_gl_vao);
+    g_gl_draw_arrays(GL_TRIANGLES, 0, (GLsizei)(g_automap_gl_count * 6u));
+    g_gl_draw_arrays(GL_TRIANGLES, (GLint)(g_automap_gl_cap * 6u), (GLsizei)(g_automap_gl_count * 6u));
+    g_gl_bind_vertex_array(0);
+    g_gl_bind_buffer(0x8892, 0);
+    return 1;
+}
+
 static void display_automap_sdl_overlay(GameState *state)
 {
     if (!state || !state->automap_visible || !g_sdl_ren) return;
@@ -2660,8 +3458,10 @@ static void display_automap_sdl_overlay(GameState *state)
     static int s_iy1[DISPLAY_AUTOMAP_MAX_SEGS];
     static uint16_t s_c12[DISPLAY_AUTOMAP_MAX_SEGS];
 
+    /* GL: walls come from the persistent buffer; only the player arrow is collected. */
+    int gl_walls = g_gl_unpack_ok && g_gl_hud_ok && display_automap_gl_draw_walls(state);
     int n = renderer_automap_collect_line_segments(state, s_ix0, s_iy0, s_ix1, s_iy1, s_c12,
-                                                   DISPLAY_AUTOMAP_MAX_SEGS);
+                                                   gl_walls ? 3 : DISPLAY_AUTOMAP_MAX_SEGS);
     if (n <= 0) return;
 
 #if SDL_VERSION_ATLEAST(2, 0, 14)
@@ -2888,29 +3688,55 @@ static void display_automap_sdl_overlay(GameState *state)
 /* -----------------------------------------------------------------------
  * Main rendering
  * ----------------------------------------------------------------------- */
-static void display_present_cw_frame(GameState *state)
+/* Renderer outputs the present pass needs for one frame. Captured right after the frame is
+ * rendered so a pipelined present never reads renderer globals the next frame is rewriting. */
+typedef struct {
+    const uint16_t *cw;
+    int8_t fill_screen_water;
+    int gun_ok;
+    int gun_frame_slot, gun_ix, gun_iy, gun_iw, gun_ih;
+} DisplayPresentFrame;
+
+static DisplayPresentFrame g_present_frame;
+
+static void display_capture_present_frame(const GameState *state, DisplayPresentFrame *out)
+{
+    out->cw = renderer_get_cw_buffer();
+    out->fill_screen_water = renderer_get_last_fill_screen_water();
+    out->gun_ok = 0;
+    if (state && state->cfg_weapon_post_gl && state->cfg_weapon_draw) {
+        out->gun_ok = renderer_get_gun_draw_info(state, &out->gun_frame_slot,
+                                                 &out->gun_ix, &out->gun_iy,
+                                                 &out->gun_iw, &out->gun_ih);
+    }
+}
+
+static void display_present_cw_frame(GameState *state, const DisplayPresentFrame *frame)
 {
     if (!g_sdl_ren) return;
+    uint64_t trace_t = trace_begin();
 
-    const uint16_t *src = renderer_get_cw_buffer();
+    const uint16_t *src = frame->cw;
     if (!src) return;
 
     int w = renderer_get_width(), h = renderer_get_height();
 
     int use_gl_weapon = state && state->cfg_weapon_post_gl && g_gl_unpack_ok && g_gl_hud_ok;
-    int use_gl_water_tint = state && state->cfg_post_tint && g_gl_unpack_ok && g_gl_hud_ok;
+    int use_gl_water_tint = state && state->cfg_post_tint && g_gl_unpack_ok;
 
     if (g_gl_unpack_ok) {
-        display_gl_present_cw(src, w, h);
+        /* Underwater tint is folded into the unpack shader; no CPU pass, no extra quad. */
+        int water_row = h;
+        if (use_gl_water_tint && frame->fill_screen_water != 0)
+            water_row = (frame->fill_screen_water > 0) ? 0 : h / 2;
+        display_gl_present_cw(src, w, h, water_row);
         if (g_gl_hud_ok) {
             display_gl_overlay_begin();
-            /* Underwater multiply: cheap GL quad; avoid per-pixel CPU copy of whole buffer. */
-            if (use_gl_water_tint)
-                display_gl_multiply_tint_rect(renderer_get_last_fill_screen_water());
             if (use_gl_weapon) {
                 if (state->cfg_weapon_draw) {
-                    int frame_slot, ix, iy, iw, ih;
-                    if (renderer_get_gun_draw_info(state, &frame_slot, &ix, &iy, &iw, &ih)) {
+                    int frame_slot = frame->gun_frame_slot;
+                    int ix = frame->gun_ix, iy = frame->gun_iy, iw = frame->gun_iw, ih = frame->gun_ih;
+                    if (frame->gun_ok) {
                         int rw = renderer_get_width(), rh = renderer_get_height();
                         SDL_Rect r = g_present_dst_rect;
                         /* Map top-left from (ix,iy) and size from (ix+iw,iy+ih) so bottom/right
@@ -2942,15 +3768,19 @@ static void display_present_cw_frame(GameState *state)
 #endif
         SDL_SetRenderDrawColor(g_sdl_ren, 0, 0, 0, 255);
         SDL_RenderClear(g_sdl_ren);
-        SDL_RenderCopy(g_sdl_ren, g_texture, NULL, &g_present_dst_rect);
+        SDL_Rect src_rect = { 0, 0, w, h };
+        SDL_RenderCopy(g_sdl_ren, g_texture, &src_rect, &g_present_dst_rect);
     }
 
     if (state) {
-        display_hud_stats_sdl_overlay(state);
-        display_key_hud_sdl_overlay(state);
         if (state->automap_visible)
             display_automap_sdl_overlay(state);
-        display_fps_overlay(state);
+        /* HUD goes over the automap so the cached stats/keys/FPS stay one quad. */
+        if (!display_hud_cache_present(state)) {
+            display_hud_stats_sdl_overlay(state);
+            display_key_hud_sdl_overlay(state);
+            display_fps_overlay(state);
+        }
     }
 
     if (g_screen_tint_enabled && g_screen_tint_a > 0) {
@@ -2972,7 +3802,10 @@ static void display_present_cw_frame(GameState *state)
     if (g_gl_unpack_ok && g_gl_hud_ok)
         display_gl_overlay_end();
 
+    trace_end("present compose", trace_t);
+    trace_t = trace_begin();
     SDL_RenderPresent(g_sdl_ren);
+    trace_end("present swap", trace_t);
 
     /* Debug: show player position in window title (throttled) */
     if (g_debug_window_title && state && g_window) {
@@ -2988,20 +3821,599 @@ static void display_present_cw_frame(GameState *state)
     }
 }
 
+/* -----------------------------------------------------------------------
+ * Pipelined present: the main thread uploads/presents frame N (including the vsync wait in
+ * SDL_RenderPresent) while a helper thread runs renderer_draw_display for frame N+1. The
+ * helper is always joined before display_draw_display returns, so simulation never runs
+ * against a frame in flight and the added latency is bounded to exactly one frame.
+ * renderer_swap at the end of the render only swaps pointers; the frame being presented was
+ * captured beforehand and is not written again until the next render starts.
+ * ----------------------------------------------------------------------- */
+/* A primed frame older than this (pause, level load, menus) is re-rendered, never shown. */
+#define DISPLAY_PRESENT_PIPE_STALE_MS 100u
+
+/* Wall time of the last renderer_draw_display; written by whichever thread rendered, read on
+ * the main thread after the pipe's done semaphore (or the sequential call) orders it. */
+static double g_last_render_ms = 0.0;
+
+static void display_render_frame(GameState *state)
+{
+    uint64_t trace_t = trace_begin();
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    renderer_draw_display(state);
+    g_last_render_ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 /
+                       (double)SDL_GetPerformanceFrequency();
+    trace_end("render", trace_t);
+}
+
+#ifndef AB3D_NO_THREADS
+static SDL_Thread *g_present_pipe_thread;
+static SDL_sem *g_present_pipe_go;
+static SDL_sem *g_present_pipe_done;
+static GameState *g_present_pipe_state;
+static int g_present_pipe_quit;
+static int g_present_pipe_failed;
+/* Emscripten: the browser main thread must not block on the render thread, so a frame may
+ * return with its render still running; display_present_pending collects it. */
+static int g_present_pipe_in_flight;
+
+static int display_present_pipe_main(void *userdata)
+{
+    (void)userdata;
+    trace_set_thread_name("render pipe");
+    for (;;) {
+        SDL_SemWait(g_present_pipe_go);
+        if (g_present_pipe_quit) break;
+        display_render_frame(g_present_pipe_state);
+        SDL_SemPost(g_present_pipe_done);
+    }
+    renderer_release_thread_scratch();
+    return 0;
+}
+
+static int display_present_pipe_start(void)
+{
+    if (g_present_pipe_thread) return 1;
+    if (g_present_pipe_failed) return 0;
+    g_present_pipe_go = SDL_CreateSemaphore(0);
+    g_present_pipe_done = SDL_CreateSemaphore(0);
+    g_present_pipe_quit = 0;
+    if (g_present_pipe_go && g_present_pipe_done) {
+        g_present_pipe_thread = SDL_CreateThread(display_present_pipe_main, "ab3d_render_pipe", NULL);
+    }
+    if (!g_present_pipe_thread) {
+        printf("[DISPLAY] present pipeline: failed to start render thread; presenting in sequence\n");
+        if (g_present_pipe_go) SDL_DestroySemaphore(g_present_pipe_go);
+        if (g_present_pipe_done) SDL_DestroySemaphore(g_present_pipe_done);
+        g_present_pipe_go = NULL;
+        g_present_pipe_done = NULL;
+        g_present_pipe_failed = 1;
+        return 0;
+    }
+    printf("[DISPLAY] present pipeline: on (present frame N while frame N+1 renders)\n");
+    return 1;
+}
+#endif
+
+/* Caller sets this around display_draw_display when nothing it does after the call reads
+ * renderer output or changes what the render thread reads (honoured on Emscripten only). */
+static int g_present_defer_allowed = 0;
+
+void display_set_present_defer(int allow)
+{
+    g_present_defer_allowed = allow ? 1 : 0;
+}
+
+static void display_present_pipe_shutdown(void)
+{
+#ifndef AB3D_NO_THREADS
+    display_present_pipe_join();
+    if (g_present_pipe_thread) {
+        g_present_pipe_quit = 1;
+        SDL_SemPost(g_present_pipe_go);
+        SDL_WaitThread(g_present_pipe_thread, NULL);
+        g_present_pipe_thread = NULL;
+    }
+    if (g_present_pipe_go) SDL_DestroySemaphore(g_present_pipe_go);
+    if (g_present_pipe_done) SDL_DestroySemaphore(g_present_pipe_done);
+    g_present_pipe_go = NULL;
+    g_present_pipe_done = NULL;
+#endif
+    g_present_pipe_primed = 0;
+}
+
+/* -----------------------------------------------------------------------
+ * Frame dump (--dump-frame): cw buffer -> 8-bit RGB PNG. The zlib stream uses
+ * stored blocks only, so no compressor is needed; a 1280x720 frame is ~2.7 MB.
+ * SDL/GL overlays (HUD stats, keys, automap, GL weapon) are not in the image.
+ * ----------------------------------------------------------------------- */
+static uint32_t display_png_crc32(uint32_t crc, const uint8_t *p, size_t n)
+{
+    static uint32_t table[256];
+    static int table_ready = 0;
+    if (!table_ready) {
+        for (uint32_t i = 0; i < 256u; i++) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++) c = (c & 1u) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+            table[i] = c;
+        }
+        table_ready = 1;
+    }
+    for (size_t i = 0; i < n; i++) crc = table[(crc ^ p[i]) & 0xFFu] ^ (crc >> 8);
+    return crc;
+}
+
+static void display_png_put_be32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)(v >> 24);
+    p[1] = (uint8_t)(v >> 16);
+    p[2] = (uint8_t)(v >> 8);
+    p[3] = (uint8_t)v;
+}
+
+static int display_png_write_chunk(FILE *f, const char type[4], const uint8_t *data, size_t len)
+{
+    uint8_t be[4];
+    uint32_t crc = 0xFFFFFFFFu;
+    display_png_put_be32(be, (uint32_t)len);
+    if (fwrite(be, 1, 4, f) != 4 || fwrite(type, 1, 4, f) != 4) return 0;
+    if (len > 0 && fwrite(data, 1, len, f) != len) return 0;
+    crc = display_png_crc32(crc, (const uint8_t *)type, 4);
+    crc = display_png_crc32(crc, data, len);
+    display_png_put_be32(be, crc ^ 0xFFFFFFFFu);
+    return fwrite(be, 1, 4, f) == 4;
+}
+
+static int display_write_cw_png(const char *path, const uint16_t *cw, int w, int h)
+{
+    static const uint8_t signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+    size_t row_bytes = 1u + (size_t)w * 3u;
+    size_t raw_bytes = row_bytes * (size_t)h;
+    size_t block_count = (raw_bytes + 65534u) / 65535u;
+    size_t z_bytes = 2u + raw_bytes + block_count * 5u + 4u;
+    uint8_t *raw = (uint8_t *)malloc(raw_bytes);
+    uint8_t *z = (uint8_t *)malloc(z_bytes);
+    uint8_t ihdr[13];
+    int ok = 0;
+
+    if (!raw || !z) goto done;
+    for (int y = 0; y < h; y++) {
+        uint8_t *row = raw + (size_t)y * row_bytes;
+        row[0] = 0; /* filter: none */
+        for (int x = 0; x < w; x++) {
+            uint32_t c = (uint32_t)(cw[display_cw_index_xy(x, y, w, h)] & 0xFFFu);
+            row[1 + x * 3 + 0] = (uint8_t)(((c >> 8) & 0xFu) * 0x11u);
+            row[1 + x * 3 + 1] = (uint8_t)(((c >> 4) & 0xFu) * 0x11u);
+            row[1 + x * 3 + 2] = (uint8_t)((c & 0xFu) * 0x11u);
+        }
+    }
+
+    {
+        uint8_t *zp = z;
+        uint32_t a = 1u, b = 0u;
+        *zp++ = 0x78;
+        *zp++ = 0x01;
+        for (size_t off = 0; off < raw_bytes; off += 65535u) {
+            size_t n = raw_bytes - off;
+            if (n > 65535u) n = 65535u;
+            *zp++ = (off + n == raw_bytes) ? 1u : 0u;
+            *zp++ = (uint8_t)n;
+            *zp++ = (uint8_t)(n >> 8);
+            *zp++ = (uint8_t)~n;
+            *zp++ = (uint8_t)(~n >> 8);
+            memcpy(zp, raw + off, n);
+            zp += n;
+        }
+        for (size_t i = 0; i < raw_bytes; i++) {
+            a = (a + raw[i]) % 65521u;
+            b = (b + a) % 65521u;
+        }
+        display_png_put_be32(zp, (b << 16) | a);
+    }
+
+    display_png_put_be32(ihdr, (uint32_t)w);
+    display_png_put_be32(ihdr + 4, (uint32_t)h);
+    ihdr[8] = 8;   /* bit depth */
+    ihdr[9] = 2;   /* colour type: RGB */
+    ihdr[10] = 0;  /* deflate */
+    ihdr[11] = 0;  /* adaptive filtering */
+    ihdr[12] = 0;  /* no interlace */
+    {
+        FILE *f = fopen(path, "wb");
+        if (!f) goto done;
+        ok = fwrite(signature, 1, sizeof(signature), f) == sizeof(signature) &&
+             display_png_write_chunk(f, "IHDR", ihdr, sizeof(ihdr)) &&
+             display_png_write_chunk(f, "IDAT", z, z_bytes) &&
+             display_png_write_chunk(f, "IEND", NULL, 0);
+        if (fclose(f) != 0) ok = 0;
+    }
+done:
+    free(raw);
+    free(z);
+    return ok;
+}
+
+static void display_frame_dump_poll(const DisplayPresentFrame *frame)
+{
+    g_frames_rendered++;
+    if (!g_frame_dump_path || g_frames_rendered != g_frame_dump_at || !frame->cw) return;
+    int w = renderer_get_width(), h = renderer_get_height();
+    if (display_write_cw_png(g_frame_dump_path, frame->cw, w, h))
+        printf("[DISPLAY] frame %d (%dx%d) written to %s\n", g_frames_rendered, w, h, g_frame_dump_path);
+    else
+        printf("[DISPLAY] frame dump failed: %s\n", g_frame_dump_path);
+}
+
+/* -----------------------------------------------------------------------
+ * Perf HUD (F3): rolling renderer phase times and counters, drawn into the
+ * presented cw frame so it shows in the GL and SDL paths alike.
+ * ----------------------------------------------------------------------- */
+#define PERF_HUD_EMA 0.1
+#define PERF_HUD_LINES 6
+
+/* 3x5 glyphs, row-major, bit 14 = top-left. */
+static const char k_perf_hud_font_chars[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ.%/:-";
+static const uint16_t k_perf_hud_font[] = {
+    0x7B6F, 0x2C97, 0x73E7, 0x72CF, 0x5BC9, 0x79CF, 0x79EF, 0x7252,
+    0x7BEF, 0x7BCF, 0x2BED, 0x6BAE, 0x3923, 0x6B6E, 0x79A7, 0x79A4,
+    0x396B, 0x5BED, 0x7497, 0x126A, 0x5BAD, 0x4927, 0x5FED, 0x6B6D,
+    0x2B6A, 0x6BA4, 0x2B73, 0x6BAD, 0x388E, 0x7492, 0x5B6F, 0x5B6A,
+    0x5BFD, 0x5AAD, 0x5A92, 0x72A7, 0x0002, 0x52A5, 0x12A4, 0x0410,
+    0x01C0,
+};
+
+typedef struct {
+    double frame, sim, present, rotate, prepass, world, tint, gun, swap;
+    double wall_cpu, floor_cpu, sprite_cpu, worker_util, writes;
+    double zones_drawn, zones_total, sprite_candidates, sprite_draws, sprite_occluded_pct;
+} PerfHudAverages;
+
+static int g_perf_hud_visible = 0;
+static int g_perf_hud_primed = 0;
+static double g_perf_hud_sim_pending = 0.0;
+static PerfHudAverages g_perf_hud_avg;
+static int g_perf_hud_audio_peak_us = 0;
+static Uint32 g_perf_hud_audio_peak_ms = 0;
+
+void display_toggle_perf_hud(void)
+{
+    g_perf_hud_visible = !g_perf_hud_visible;
+    g_perf_hud_primed = 0;
+    g_perf_hud_sim_pending = 0.0;
+    renderer_set_frame_timing_capture(g_perf_hud_visible);
+}
+
+int display_perf_hud_visible(void)
+{
+    return g_perf_hud_visible;
+}
+
+void display_perf_hud_add_sim_ms(double ms)
+{
+    g_perf_hud_sim_pending += ms;
+}
+
+static void perf_hud_ema(double *avg, double v)
+{
+    *avg = g_perf_hud_primed ? *avg + (v - *avg) * PERF_HUD_EMA : v;
+}
+
+static void display_perf_hud_update(void)
+{
+    RendererFrameTimings ft;
+    if (!renderer_get_last_frame_timings(&ft)) return;
+    PerfHudAverages *a = &g_perf_hud_avg;
+    double occluded_pct = ft.sprite_pixels_tested
+        ? 100.0 * (double)ft.sprite_pixels_occluded / (double)ft.sprite_pixels_tested : 0.0;
+    perf_hud_ema(&a->frame, ft.total_ms);
+    perf_hud_ema(&a->sim, g_perf_hud_sim_pending);
+    perf_hud_ema(&a->present, g_last_present_ms);
+    perf_hud_ema(&a->rotate, ft.rotate_ms);
+    perf_hud_ema(&a->prepass, ft.prepass_ms);
+    perf_hud_ema(&a->world, ft.world_ms);
+    perf_hud_ema(&a->tint, ft.tint_ms);
+    perf_hud_ema(&a->gun, ft.gun_ms);
+    perf_hud_ema(&a->swap, ft.swap_ms);
+    perf_hud_ema(&a->wall_cpu, ft.wall_cpu_ms);
+    perf_hud_ema(&a->floor_cpu, ft.floor_cpu_ms);
+    perf_hud_ema(&a->sprite_cpu, ft.sprite_cpu_ms);
+    perf_hud_ema(&a->worker_util, ft.worker_util);
+    perf_hud_ema(&a->writes, (double)ft.pixel_writes);
+    perf_hud_ema(&a->zones_drawn, (double)ft.zones_drawn);
+    perf_hud_ema(&a->zones_total, (double)ft.zones_total);
+    perf_hud_ema(&a->sprite_candidates, (double)ft.sprite_candidates);
+    perf_hud_ema(&a->sprite_draws, (double)ft.sprite_draws);
+    perf_hud_ema(&a->sprite_occluded_pct, occluded_pct);
+    g_perf_hud_primed = 1;
+    g_perf_hud_sim_pending = 0.0;
+}
+
+static void display_perf_hud_draw_text(uint16_t *cw, int w, int h, int x0, int y0, int scale,
+                                       const char *text)
+{
+    const uint16_t ink = 0x0FFFu;
+    for (int i = 0; text[i]; i++) {
+        const char *p = strchr(k_perf_hud_font_chars, text[i]);
+        if (text[i] == ' ' || !p) continue;
+        uint16_t bits = k_perf_hud_font[p - k_perf_hud_font_chars];
+        int gx = x0 + i * 4 * scale;
+        for (int row = 0; row < 5; row++) {
+            for (int col = 0; col < 3; col++) {
+                if (!(bits & (1u << (14 - row * 3 - col)))) continue;
+                for (int sy = 0; sy < scale; sy++) {
+                    int y = y0 + row * scale + sy;
+                    if (y < 0 || y >= h) continue;
+                    for (int sx = 0; sx < scale; sx++) {
+                        int x = gx + col * scale + sx;
+                        if (x >= 0 && x < w) cw[display_cw_index_xy(x, y, w, h)] = ink;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void display_perf_hud_draw(const DisplayPresentFrame *frame)
+{
+    if (!g_perf_hud_visible || !frame->cw) return;
+    display_perf_hud_update();
+    if (!g_perf_hud_primed) return;
+
+    /* The mixer runs on its own clock; hold each peak on screen for a second. */
+    int audio_last_us = 0, audio_peak_us = 0, audio_budget_us = 0;
+    Uint32 now_ms = SDL_GetTicks();
+    audio_get_callback_stats(&audio_last_us, &audio_peak_us, &audio_budget_us);
+    if (audio_peak_us >= g_perf_hud_audio_peak_us || now_ms - g_perf_hud_audio_peak_ms > 1000u) {
+        g_perf_hud_audio_peak_us = audio_peak_us;
+        g_perf_hud_audio_peak_ms = now_ms;
+    }
+
+    const PerfHudAverages *a = &g_perf_hud_avg;
+    char lines[PERF_HUD_LINES][64];
+    snprintf(lines[0], sizeof(lines[0]), "FRAME %.2f SIM %.2f PRESENT %.2f MS",
+             a->frame, a->sim, a->present);
+    snprintf(lines[1], sizeof(lines[1]), "ROT %.2f PRE %.2f WORLD %.2f TINT %.2f",
+             a->rotate, a->prepass, a->world, a->tint);
+    snprintf(lines[2], sizeof(lines[2]), "CPU WALL %.2f FLOOR %.2f SPRITE %.2f",
+             a->wall_cpu, a->floor_cpu, a->sprite_cpu);
+    snprintf(lines[3], sizeof(lines[3]), "WRITES %.0fK ZONES %.0f/%.0f",
+             a->writes / 1000.0, a->zones_drawn, a->zones_total);
+    snprintf(lines[4], sizeof(lines[4]), "SPRITES %.0f DRAWS %.0f OCCLUDED %.0f%%",
+             a->sprite_candidates, a->sprite_draws, a->sprite_occluded_pct);
+    snprintf(lines[5], sizeof(lines[5]), "WORKERS %.0f%% AUDIO %.2f/%.2f OF %.1f MS",
+             a->worker_util * 100.0, audio_last_us / 1000.0, g_perf_hud_audio_peak_us / 1000.0,
+             audio_budget_us / 1000.0);
+
+    int w = renderer_get_width(), h = renderer_get_height();
+    int scale = h / 240;
+    if (scale < 1) scale = 1;
+    int max_len = 0;
+    for (int i = 0; i < PERF_HUD_LINES; i++) {
+        int len = (int)strlen(lines[i]);
+        if (len > max_len) max_len = len;
+    }
+    int box_w = (max_len * 4 + 2) * scale;
+    int box_h = (PERF_HUD_LINES * 6 + 2) * scale;
+    int x0 = w - box_w - 2 * scale;
+    int y0 = 2 * scale;
+    if (x0 < 0) x0 = 0;
+
+    /* The present pass only reads this buffer until the next frame is swapped in. */
+    uint16_t *cw = (uint16_t *)frame->cw;
+    for (int x = x0; x < x0 + box_w && x < w; x++) {
+        for (int y = y0; y < y0 + box_h && y < h; y++) {
+            size_t i = display_cw_index_xy(x, y, w, h);
+            cw[i] = (uint16_t)((cw[i] & 0x0EEEu) >> 1);
+        }
+    }
+    for (int i = 0; i < PERF_HUD_LINES; i++)
+        display_perf_hud_draw_text(cw, w, h, x0 + scale, y0 + (1 + i * 6) * scale, scale, lines[i]);
+}
+
+/* -----------------------------------------------------------------------
+ * Dynamic resolution: step the render size so the smoothed render time stays inside the
+ * ini budget. Steps down as soon as the average is over budget; steps up only after
+ * DYNRES_HEADROOM_FRAMES frames in a row whose cost, scaled to the next size up, would
+ * still leave DYNRES_UP_MARGIN of the budget free. Each step restarts the average.
+ * ----------------------------------------------------------------------- */
+#define DYNRES_STEP_PCT 5
+#define DYNRES_EMA 0.1
+#define DYNRES_HOLD_FRAMES 15
+#define DYNRES_HEADROOM_FRAMES 60
+#define DYNRES_UP_MARGIN 0.85
+
+static void display_dynamic_resolution_apply(int pct)
+{
+    int w = ((g_internal_w * pct / 100) + 2) & ~3;
+    int h = ((g_internal_h * pct / 100) + 1) & ~1;
+    if (pct >= 100) {
+        w = g_internal_w;
+        h = g_internal_h;
+    }
+    if (!renderer_set_view_size(w, h)) return;
+    g_dynres_pct = pct;
+    g_dynres_hold_frames = DYNRES_HOLD_FRAMES;
+    g_dynres_headroom_frames = 0;
+    g_dynres_avg_ms = 0.0;
+    /* A primed frame has the old size. */
+    g_present_pipe_primed = 0;
+    printf("[DISPLAY] dynamic resolution: %d%% (%dx%d)\n", pct, renderer_get_width(), renderer_get_height());
+}
+
+static void display_dynamic_resolution_update(const GameState *state)
+{
+    double budget = state ? (double)state->cfg_dynamic_resolution_ms : 0.0;
+    if (budget <= 0.0) {
+        if (g_dynres_pct != 100) display_dynamic_resolution_apply(100);
+        return;
+    }
+    if (g_last_render_ms <= 0.0) return;
+    g_dynres_avg_ms = (g_dynres_avg_ms > 0.0)
+        ? g_dynres_avg_ms + (g_last_render_ms - g_dynres_avg_ms) * DYNRES_EMA
+        : g_last_render_ms;
+    if (g_dynres_hold_frames > 0) {
+        g_dynres_hold_frames--;
+        return;
+    }
+
+    int min_pct = state->cfg_dynamic_resolution_min;
+    if (min_pct < 25) min_pct = 25;
+    if (min_pct > 100) min_pct = 100;
+    int pct = g_dynres_pct;
+    if (g_dynres_avg_ms > budget) {
+        g_dynres_headroom_frames = 0;
+        if (pct > min_pct) {
+            pct -= DYNRES_STEP_PCT;
+            if (pct < min_pct) pct = min_pct;
+            display_dynamic_resolution_apply(pct);
+        }
+        return;
+    }
+    if (pct >= 100) return;
+    int up = pct + DYNRES_STEP_PCT;
+    if (up > 100) up = 100;
+    /* Render cost is roughly proportional to the pixel count. */
+    double predicted = g_dynres_avg_ms * ((double)up * up) / ((double)pct * pct);
+    if (predicted < budget * DYNRES_UP_MARGIN) {
+        if (++g_dynres_headroom_frames >= DYNRES_HEADROOM_FRAMES)
+            display_dynamic_resolution_apply(up);
+    } else {
+        g_dynres_headroom_frames = 0;
+    }
+}
+
+#ifndef AB3D_NO_THREADS
+/* The pipelined render has finished: keep its frame for the next present. */
+static void display_present_pipe_collect(GameState *state)
+{
+    display_capture_present_frame(state, &g_present_frame);
+    display_frame_dump_poll(&g_present_frame);
+    display_perf_hud_draw(&g_present_frame);
+}
+#endif
+
+static void display_present_pipe_join(void)
+{
+#ifndef AB3D_NO_THREADS
+    if (!g_present_pipe_in_flight) return;
+    uint64_t trace_wait = trace_begin();
+    SDL_SemWait(g_present_pipe_done);
+    trace_end("render pipe wait", trace_wait);
+    g_present_pipe_in_flight = 0;
+    display_present_pipe_collect(g_present_pipe_state);
+#endif
+}
+
+int display_present_pending(void)
+{
+#ifndef AB3D_NO_THREADS
+    if (!g_present_pipe_in_flight) return 0;
+    if (SDL_SemTryWait(g_present_pipe_done) != 0) return 1;
+    g_present_pipe_in_flight = 0;
+    display_present_pipe_collect(g_present_pipe_state);
+#endif
+    return 0;
+}
+
 void display_draw_display(GameState *state)
 {
+    static Uint32 s_last_draw_ms = 0;
+    Uint32 now_ms = SDL_GetTicks();
     /* Tell renderer to skip CPU work when the GL overlay path will handle it. */
     int use_gl_weapon = state && state->cfg_weapon_post_gl && g_gl_unpack_ok && g_gl_hud_ok;
-    int use_gl_water_tint = state && state->cfg_post_tint && g_gl_unpack_ok && g_gl_hud_ok;
+    int use_gl_water_tint = state && state->cfg_post_tint && g_gl_unpack_ok;
+    display_present_pipe_join();
     renderer_set_weapon_post_gl_active(use_gl_weapon);
     renderer_set_gl_water_tint_post_active(use_gl_water_tint);
-    renderer_draw_display(state);
-    display_present_cw_frame(state);
+
+    if (now_ms - s_last_draw_ms > DISPLAY_PRESENT_PIPE_STALE_MS)
+        g_present_pipe_primed = 0;
+    s_last_draw_ms = now_ms;
+    display_dynamic_resolution_update(state);
+
+    if (g_headless) {
+        display_render_frame(state);
+        display_capture_present_frame(state, &g_present_frame);
+        display_frame_dump_poll(&g_present_frame);
+        g_last_present_ms = 0.0;
+        return;
+    }
+
+#ifndef AB3D_NO_THREADS
+    if (state && state->cfg_present_pipeline && display_present_pipe_start()) {
+        if (g_present_pipe_primed) {
+            DisplayPresentFrame shown = g_present_frame;
+            g_present_pipe_state = state;
+            SDL_SemPost(g_present_pipe_go);
+            Uint64 t0 = SDL_GetPerformanceCounter();
+            display_present_cw_frame(state, &shown);
+            g_last_present_ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 /
+                                (double)SDL_GetPerformanceFrequency();
+            g_present_pipe_in_flight = 1;
+#if defined(__EMSCRIPTEN__)
+            if (g_present_defer_allowed) return;
+#endif
+            display_present_pipe_join();
+            return;
+        }
+        /* Prime: render and present this frame in sequence; the next call starts overlapping. */
+        display_render_frame(state);
+        display_present_pipe_collect(state);
+        display_present_cw_frame(state, &g_present_frame);
+        g_present_pipe_primed = 1;
+        return;
+    }
+#endif
+    g_present_pipe_primed = 0;
+    display_render_frame(state);
+    display_capture_present_frame(state, &g_present_frame);
+    display_frame_dump_poll(&g_present_frame);
+    display_perf_hud_draw(&g_present_frame);
+    {
+        Uint64 t0 = SDL_GetPerformanceCounter();
+        display_present_cw_frame(state, &g_present_frame);
+        g_last_present_ms = (double)(SDL_GetPerformanceCounter() - t0) * 1000.0 /
+                            (double)SDL_GetPerformanceFrequency();
+    }
+}
+
+void display_request_uncapped_present(void)
+{
+    g_present_uncapped = 1;
+}
+
+void display_request_headless(void)
+{
+    g_headless = 1;
+    g_present_uncapped = 1;
+    /* SDL still provides events and timers; the dummy driver needs no display server. */
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+}
+
+int display_is_headless(void)
+{
+    return g_headless;
+}
+
+void display_request_frame_dump(const char *png_path, int frame)
+{
+    g_frame_dump_path = png_path;
+    g_frame_dump_at = frame;
+}
+
+double display_last_present_ms(void)
+{
+    return g_last_present_ms;
 }
 
 void display_present_last_frame(GameState *state)
 {
-    display_present_cw_frame(state);
+    DisplayPresentFrame frame;
+    display_present_pipe_join();
+    /* Whatever is on screen next is newer than a primed gameplay frame. */
+    g_present_pipe_primed = 0;
+    display_capture_present_frame(state, &frame);
+    display_present_cw_frame(state, &frame);
 }
 
 void display_swap_buffers(void)
@@ -21,6 +21,8 @@ void display_toggle_fullscreen(void); /* borderless ini fullscreen or windowed <
 void display_emscripten_frame_resize_poll(void);
 void display_on_resize(int w, int h);  /* call on window resize to resize framebuffer */
 void display_handle_resize(void);      /* query renderer output size and resize (use on SDL_WINDOWEVENT_RESIZED) */
+void display_hud_cache_invalidate(void); /* redraw the cached HUD (SDL_RENDER_TARGETS_RESET) */
+void display_hud_cache_device_reset(void); /* drop the HUD render target; recreated on the next present (SDL_RENDER_DEVICE_RESET) */
 
 /* Screen management */
 void display_alloc_text_screen(void);
@@ -51,6 +53,29 @@ void display_draw_display(GameState *state);  /* Renders 3D scene; presents 12-b
 void display_present_last_frame(GameState *state); /* Presents the last rendered frame without re-rendering/swap */
 void display_swap_buffers(void);
 void display_wait_vblank(void);
+/* Pipelined present on Emscripten: with defer allowed, display_draw_display may return while
+ * the render thread is still drawing the next frame, so the browser main thread never waits
+ * on it. Allow it only when nothing after the call reads renderer output or writes state the
+ * renderer reads. Until display_present_pending returns 0 the frame is in flight: run no game
+ * logic and touch nothing the renderer reads. Every other display call joins first. */
+void display_set_present_defer(int allow);
+int display_present_pending(void);
+/* Benchmark support: call before display_init to create the renderer without VSync. */
+void display_request_uncapped_present(void);
+/* --headless: call before SDL_Init/display_init. Selects SDL's dummy video driver and skips
+ * the window and SDL renderer; display_draw_display renders into the cw buffer only. */
+void display_request_headless(void);
+int display_is_headless(void);
+/* --dump-frame: write the frame-th rendered frame (1-based, any mode) to png_path. */
+void display_request_frame_dump(const char *png_path, int frame);
+/* Wall time (ms) of the present pass (upload + overlays + swap) of the last display_draw_display. */
+double display_last_present_ms(void);
+/* F3 perf HUD: rolling phase times, pixel writes, zone/sprite counts, worker utilization
+ * and audio callback cost, top-right of the frame. Enables renderer frame timing capture. */
+void display_toggle_perf_hud(void);
+int display_perf_hud_visible(void);
+/* Logic tick time to attribute to the next displayed frame (only while the HUD is visible). */
+void display_perf_hud_add_sim_ms(double ms);
 void display_set_screen_tint(int r, int g, int b, int alpha);
 void display_clear_screen_tint(void);
 
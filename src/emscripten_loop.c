@@ -1,5 +1,7 @@
 /*
  * Emscripten browser main loop: one frame per requestAnimationFrame callback.
+ * In the threaded build the render runs on the present-pipeline thread and is not
+ * waited for here; a callback that finds it still running returns straight away.
  */
 
 #include "emscripten_loop.h"
@@ -36,6 +38,11 @@ static void em_frame(void)
 {
     GameState *st = g_em_st;
 
+    /* Threaded build: the last frame's render may still be running on the render thread.
+     * Yield this animation frame to the browser instead of waiting for it. */
+    if (display_present_pending())
+        return;
+
     switch (g_em_phase) {
     case EM_PREP:
         play_the_game_prepare_level(st, &g_em_copper_ready);
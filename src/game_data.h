@@ -96,6 +96,9 @@ typedef struct {
 
 extern const CollisionBox col_box_table[21];
 
+/* Widest col_box_table entry (huge red thing); bounds any object's reach. */
+#define COL_BOX_MAX_WIDTH 160
+
 /* -----------------------------------------------------------------------
  * Default world size (width, height) per object type for display.
  * Amiga: each type sets move.w #...,6(a0) (word = high byte w, low byte h).
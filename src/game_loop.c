@@ -19,6 +19,7 @@
  */
 
 #include "game_loop.h"
+#include "control_loop.h"
 #include "level.h"
 #include "player.h"
 #include "objects.h"
@@ -29,6 +30,10 @@
 #include "display.h"
 #include "input.h"
 #include "audio.h"
+#include "math_tables.h"
+#include "replay.h"
+#include "trace.h"
+#include "settings.h"
 #include <SDL.h>
 #include <stdio.h>
 #include <string.h>
@@ -47,6 +52,10 @@
  * player feel sluggish and can skip/tunnel through collision edges. */
 #define GAME_TICK_VBLANKS 1
 
+/* Fixed-timestep mode: a camera that moved further than this (world units)
+ * in one tick teleported (F9 load, level start) and is not blended. */
+#define CAMERA_INTERP_SNAP_DIST 256
+
 /* Number of frames to run in stub mode before auto-exiting */
 /* Max frames before auto-exit (0 = disabled, relies on ESC key) */
 #define STUB_MAX_FRAMES 0
@@ -208,6 +217,377 @@ void game_loop_ctx_init(GameLoopCtx *ctx, GameState *state)
     state->obj_interp_alpha = 0.0f;
 }
 
+static PlayerState *game_loop_view_player(GameState *state)
+{
+    return (state->mode == MODE_SLAVE) ? &state->plr2 : &state->plr1;
+}
+
+/* Fixed-timestep mode: remember the view camera before a logic tick moves it. */
+static void game_loop_save_camera(GameState *state, GameLoopCtx *ctx)
+{
+    const PlayerState *plr = game_loop_view_player(state);
+    ctx->camera_prev_xoff = plr->xoff;
+    ctx->camera_prev_zoff = plr->zoff;
+    ctx->camera_prev_yoff = plr->yoff;
+    ctx->camera_prev_angpos = plr->angpos;
+    ctx->camera_prev_valid = 1;
+}
+
+/* Swap the view camera for one blended alpha of the way from the previous
+ * tick to the current one (the same lag obj_interp_alpha gives objects).
+ * Zone, room pointer and zone order stay the live tick's, so the blend is
+ * skipped (live camera drawn) while the blended point lies outside the
+ * live zone, i.e. for the frames of a tick that crossed a zone boundary.
+ * Returns 1 if the live values were parked in ctx and must be restored. */
+static int game_loop_interp_camera_begin(GameState *state, GameLoopCtx *ctx)
+{
+    PlayerState *plr = game_loop_view_player(state);
+    float alpha = state->obj_interp_alpha;
+    int32_t blend_xoff, blend_zoff;
+
+    if (!ctx->camera_prev_valid) return 0;
+    int32_t dx = (plr->xoff >> 16) - (ctx->camera_prev_xoff >> 16);
+    int32_t dz = (plr->zoff >> 16) - (ctx->camera_prev_zoff >> 16);
+    if (dx > CAMERA_INTERP_SNAP_DIST || dx < -CAMERA_INTERP_SNAP_DIST ||
+        dz > CAMERA_INTERP_SNAP_DIST || dz < -CAMERA_INTERP_SNAP_DIST) {
+        ctx->camera_prev_valid = 0;
+        return 0;
+    }
+
+    blend_xoff = ctx->camera_prev_xoff +
+                 (int32_t)((float)(plr->xoff - ctx->camera_prev_xoff) * alpha);
+    blend_zoff = ctx->camera_prev_zoff +
+                 (int32_t)((float)(plr->zoff - ctx->camera_prev_zoff) * alpha);
+    if (state->level.data && plr->zone >= 0 &&
+        level_find_zone_for_point(&state->level, blend_xoff >> 16, blend_zoff >> 16, plr->zone) != plr->zone)
+        return 0;
+
+    ctx->camera_live_xoff = plr->xoff;
+    ctx->camera_live_zoff = plr->zoff;
+    ctx->camera_live_yoff = plr->yoff;
+    ctx->camera_live_angpos = plr->angpos;
+
+    plr->xoff = blend_xoff;
+    plr->zoff = blend_zoff;
+    plr->yoff = ctx->camera_prev_yoff +
+                (int32_t)((float)(plr->yoff - ctx->camera_prev_yoff) * alpha);
+    {
+        /* Shortest way round the 8192-step circle. */
+        int dang = (plr->angpos - ctx->camera_prev_angpos) & ANGLE_MASK;
+        if (dang >= ANGLE_180) dang -= ANGLE_FINE_TABLE_SIZE;
+        plr->angpos = (int16_t)((ctx->camera_prev_angpos + (int)((float)dang * alpha)) & ANGLE_MASK);
+    }
+    return 1;
+}
+
+static void game_loop_interp_camera_end(GameState *state, GameLoopCtx *ctx)
+{
+    PlayerState *plr = game_loop_view_player(state);
+    plr->xoff = ctx->camera_live_xoff;
+    plr->zoff = ctx->camera_live_zoff;
+    plr->yoff = ctx->camera_live_yoff;
+    plr->angpos = ctx->camera_live_angpos;
+}
+
+static int g_late_look_state = -1;
+
+static int game_loop_late_look_enabled(void)
+{
+    return settings_env_feature_enabled(&g_late_look_state, "AB3D_DISABLE_LATE_LATCH");
+}
+
+/* Late-latched mouse look: right before the view transform is built, pull the mouse
+ * motion that arrived after input_update and turn the drawn view by every look count
+ * the simulation has not consumed yet. Camera rotation only; the counts reach the
+ * simulation through the next input_update, so ticks stay deterministic.
+ * Returns 1 if the live angle was parked in ctx and must be restored. */
+static int game_loop_late_look_begin(GameState *state, GameLoopCtx *ctx)
+{
+    PlayerState *plr = game_loop_view_player(state);
+    const ControlMode *ctrl = (state->mode == MODE_SLAVE) ? &state->plr2_control : &state->plr1_control;
+    int scale;
+    int16_t look_dx;
+
+    if (!game_loop_late_look_enabled()) return 0;
+    scale = player_look_angle_scale(ctrl);
+    if (scale == 0 || plr->energy <= 0) return 0;
+    look_dx = input_late_latch_look();
+    if (look_dx == 0) return 0;
+
+    ctx->late_look_live_angpos = plr->angpos;
+    ctx->late_look_live_sinval = plr->sinval;
+    ctx->late_look_live_cosval = plr->cosval;
+    plr->angpos = (int16_t)(((int)plr->angpos + (int)look_dx * scale) & ANGLE_MASK);
+    plr->sinval = sin_lookup(plr->angpos);
+    plr->cosval = cos_lookup(plr->angpos);
+    return 1;
+}
+
+static void game_loop_late_look_end(GameState *state, GameLoopCtx *ctx)
+{
+    PlayerState *plr = game_loop_view_player(state);
+    plr->angpos = ctx->late_look_live_angpos;
+    plr->sinval = ctx->late_look_live_sinval;
+    plr->cosval = ctx->late_look_live_cosval;
+}
+
+/*
+ * game_loop_logic_tick - One ObjMoveAnim-style logic pass advancing ticks VBlanks.
+ */
+static void game_loop_logic_tick(GameState *state, GameLoopCtx *ctx, int ticks)
+{
+    uint64_t trace_tick = trace_begin();
+    Uint64 perf_hud_t0 = display_perf_hud_visible() ? SDL_GetPerformanceCounter() : 0;
+    state->frames_to_draw = (int16_t)ticks;
+    state->temp_frames = (int16_t)ticks;
+    audio_begin_frame();
+
+    /* ---- Phase 1: Pause handling ---- */
+    if (state->mode == MODE_SINGLE) {
+        if (input_key_pressed(state->key_map, KEY_PAUSE)) {
+            state->do_anything = false;
+            state->do_anything = true;
+        }
+    }
+
+    /* ---- Phase 2: Set READCONTROLS flag ---- */
+    state->read_controls = true;
+
+    /* ---- Phase 3: Hit flash fadedown ---- */
+    if (state->hitcol > 0) {
+        state->hitcol -= 0x100;
+        state->hitcol2 = state->hitcol;
+    }
+
+    /* ---- Phase 3b: Gun animation frame countdown ---- */
+    if (state->plr1.gun_frame > 0) {
+        state->plr1.gun_frame -= state->temp_frames;
+        if (state->plr1.gun_frame < 0) state->plr1.gun_frame = 0;
+    }
+    if (state->plr2.gun_frame > 0) {
+        state->plr2.gun_frame -= state->temp_frames;
+        if (state->plr2.gun_frame < 0) state->plr2.gun_frame = 0;
+    }
+
+    /* ---- Phase 6: Gun selection / ammo ---- */
+    {
+        PlayerState *gun_plr;
+        if (state->mode == MODE_SLAVE) {
+            gun_plr = &state->plr2;
+        } else {
+            gun_plr = &state->plr1;
+        }
+
+        int gun_idx = gun_plr->gun_selected;
+        if (gun_idx >= 0 && gun_idx < MAX_GUNS) {
+            state->ammo = gun_plr->gun_data[gun_idx].ammo >> 3;
+        }
+    }
+
+    /* ---- Phase 7: Save old positions ---- */
+    int32_t old_x1 = state->plr1.xoff;
+    int32_t old_z1 = state->plr1.zoff;
+    int32_t old_x2 = state->plr2.xoff;
+    int32_t old_z2 = state->plr2.zoff;
+
+    /* ---- Phase 9: Player control ----
+     * Snapshotting now happens inside player*_control after
+     * simulation/fall and before full collision resolution. */
+    uint64_t trace_t = trace_begin();
+    if (state->mode == MODE_SINGLE) {
+        state->energy = state->plr1.energy;
+        player1_control(state);
+    } else if (state->mode == MODE_MASTER) {
+        state->energy = state->plr1.energy;
+        player1_control(state);
+        player2_control(state);
+    } else if (state->mode == MODE_SLAVE) {
+        state->energy = state->plr2.energy;
+        player1_control(state);
+        player2_control(state);
+    }
+
+    trace_end("player control", trace_t);
+
+    /* Positional SFX are heard from the view player. */
+    {
+        const PlayerState *ear = game_loop_view_player(state);
+        audio_set_listener((int32_t)(int16_t)(ear->xoff >> 16), (int32_t)(int16_t)(ear->zoff >> 16));
+    }
+
+    /* ---- Phase 10: Zone brightness animation (bright_anim_values updated; rendering reads from zone data) ---- */
+    bright_anim_handler(state);
+
+    /* ---- Phase 11: Visibility checks (multiplayer) ---- */
+    if (state->mode != MODE_SINGLE) {
+        if (state->level.zone_adds && state->level.data) {
+            /* CanItBeSeen stub */
+        }
+    }
+
+    /* ---- Phase 12: Fire holddown tracking ---- */
+    {
+        int16_t tf = state->temp_frames;
+
+        state->plr1.p_holddown += tf;
+        if (state->plr1.p_holddown > 30) state->plr1.p_holddown = 30;
+        if (!state->plr1.p_fire) {
+            state->plr1.p_holddown -= tf;
+            if (state->plr1.p_holddown < 0) state->plr1.p_holddown = 0;
+        }
+
+        state->plr2.p_holddown += tf;
+        if (state->plr2.p_holddown > 30) state->plr2.p_holddown = 30;
+        if (!state->plr2.p_fire) {
+            state->plr2.p_holddown -= tf;
+            if (state->plr2.p_holddown < 0) state->plr2.p_holddown = 0;
+        }
+    }
+
+    /* ---- Phase 13: Position diff ---- */
+    {
+        int16_t tf = state->temp_frames;
+        if (tf < 1) tf = 1;
+
+        int16_t dx1 = (int16_t)((state->plr1.xoff >> 16) - (old_x1 >> 16));
+        int16_t dz1 = (int16_t)((state->plr1.zoff >> 16) - (old_z1 >> 16));
+        int16_t dx2 = (int16_t)((state->plr2.xoff >> 16) - (old_x2 >> 16));
+        int16_t dz2 = (int16_t)((state->plr2.zoff >> 16) - (old_z2 >> 16));
+        state->xdiff1 = (int16_t)(((int32_t)dx1 << 4) / tf);
+        state->zdiff1 = (int16_t)(((int32_t)dz1 << 4) / tf);
+        state->xdiff2 = (int16_t)(((int32_t)dx2 << 4) / tf);
+        state->zdiff2 = (int16_t)(((int32_t)dz2 << 4) / tf);
+    }
+
+    /* ---- Phase 14: Shooting, objects ---- */
+    can_it_be_seen_flush_results();
+    player1_shoot(state);
+    if (state->mode != MODE_SINGLE) {
+        player2_shoot(state);
+    }
+
+    use_player1(state);
+    if (state->mode != MODE_SINGLE) {
+        use_player2(state);
+    }
+
+    /* Zone ordering for rendering */
+    {
+        PlayerState *view_plr = (state->mode == MODE_SLAVE) ?
+                                &state->plr2 : &state->plr1;
+
+        /* Amiga: ListOfGraphRooms = current room's list (roompt + 48). */
+        const uint8_t *lgr_ptr = NULL;
+        if (state->level.data) {
+            int32_t lgr_off = -1;
+            if (view_plr->roompt >= 0) {
+                lgr_off = view_plr->roompt + 48;  /* ToListOfGraph */
+            } else if (view_plr->list_of_graph_rooms > 0) {
+                lgr_off = view_plr->list_of_graph_rooms;
+            }
+            if (lgr_off > 0) {
+                lgr_ptr = state->level.data + lgr_off;
+            }
+        }
+
+        /* Amiga uses high 16 bits of xoff/zoff for OrderZones side test (move.w xoff,d2 = first word of long). */
+        int32_t view_x = (int32_t)(int16_t)(view_plr->xoff >> 16);
+        int32_t view_z = (int32_t)(int16_t)(view_plr->zoff >> 16);
+        int32_t move_dx = (state->mode == MODE_SLAVE) ? (int32_t)state->xdiff2 : (int32_t)state->xdiff1;
+        int32_t move_dz = (state->mode == MODE_SLAVE) ? (int32_t)state->zdiff2 : (int32_t)state->zdiff1;
+        ZoneOrder zo;
+        trace_t = trace_begin();
+        order_zones(&zo, &state->level,
+                    view_x, view_z, move_dx, move_dz,
+                    (int)(view_plr->angpos & 0x3FFF),
+                    lgr_ptr);
+        trace_end("order_zones", trace_t);
+        memcpy(state->zone_order_zones, zo.zones,
+               (size_t)(zo.count < 256 ? zo.count : 256) * sizeof(int16_t));
+        state->zone_order_count = zo.count;
+        apply_zone_order_workaround_level8_zone49(state, view_plr);
+        state->view_list_of_graph_rooms = lgr_ptr;
+    }
+
+    game_log_zone_changes(state);
+
+    /* Snapshot object positions before they are mutated by objects_update.
+     * The renderer uses prev_object_points + obj_interp_alpha to draw smooth
+     * movement at display frame rate even though logic runs at 50 Hz. */
+    if (state->level.prev_object_points && state->level.object_points &&
+        state->level.num_object_points > 0) {
+        memcpy(state->level.prev_object_points,
+               state->level.object_points,
+               (size_t)state->level.num_object_points * 8u);
+    }
+
+    trace_t = trace_begin();
+    objects_update(state);
+    explosion_advance(state);
+    trace_end("objects_update", trace_t);
+
+    /* Match Amiga frame timing: in-line target vectors are refreshed
+     * after object movement/AI for use by the next shot solve. */
+    calc_plr1_in_line(state);
+    if (state->mode != MODE_SINGLE) {
+        calc_plr2_in_line(state);
+    }
+
+    /* ---- Phase 15: Object worry flags ---- */
+    if (state->level.object_data) {
+        uint8_t vis_zones[256];
+        memset(vis_zones, 0, sizeof(vis_zones));
+        bool has_visible = false;
+
+        /* Amiga builds WorkSpace from each player's ToListOfGraph list,
+         * then wakes objects whose objZone bit is set in WorkSpace. */
+        if (state->mode != MODE_SINGLE) {
+            int32_t lgr2 = state->plr2.roompt;
+            if (lgr2 >= 0) lgr2 += 48;  /* ToListOfGraph */
+            else lgr2 = state->plr2.list_of_graph_rooms;
+            has_visible |= mark_visible_zones_from_graph_list(
+                vis_zones, &state->level, lgr2);
+        }
+        int32_t lgr1 = state->plr1.roompt;
+        if (lgr1 >= 0) lgr1 += 48;  /* ToListOfGraph */
+        else lgr1 = state->plr1.list_of_graph_rooms;
+        has_visible |= mark_visible_zones_from_graph_list(
+            vis_zones, &state->level, lgr1);
+
+        if (!has_visible) {
+            /* Match Amiga behavior: no visible-zone bits -> no wake this tick. */
+        }
+
+        int obj_idx = 0;
+        while (1) {
+            GameObject *wobj = (GameObject*)(state->level.object_data +
+                                obj_idx * OBJECT_SIZE);
+            if (OBJ_CID(wobj) < 0) break;
+
+            if (OBJ_ZONE(wobj) >= 0 && OBJ_ZONE(wobj) < 256) {
+                if (vis_zones[OBJ_ZONE(wobj)]) {
+                    /* Amiga: or.b #127,objWorry(a0) */
+                    wobj->obj.worry |= 127;
+                }
+            }
+            obj_idx++;
+        }
+    }
+
+    if (state->infinite_health) {
+        state->plr1.energy = PLAYER_MAX_ENERGY;
+        state->plr2.energy = PLAYER_MAX_ENERGY;
+    }
+
+    input_mark_mouse_consumed();
+    ctx->logic_count++;
+    replay_after_logic_tick(state, ctx->logic_count);
+    if (perf_hud_t0)
+        display_perf_hud_add_sim_ms((double)(SDL_GetPerformanceCounter() - perf_hud_t0) * 1000.0 /
+                                    (double)SDL_GetPerformanceFrequency());
+    trace_end("logic tick", trace_tick);
+}
+
 /*
  * game_loop_tick - One display frame of the main game loop (Emscripten calls this
  * from the browser main loop; native game_loop wraps it in a while).
@@ -221,47 +601,78 @@ void game_loop_tick(GameState *state, GameLoopCtx *ctx)
     /* ================================================================
      * Always: Poll input every display frame for responsiveness
      * ================================================================ */
-        input_update(state->key_map, &state->last_pressed);
+        bool f2_pick_log_requested = false;
+        uint32_t replay_elapsed_ms = 0;
+        uint64_t trace_frame = trace_begin();
+        if (ctx->headless) {
+            if (!replay_next_frame(state, &replay_elapsed_ms)) {
+                state->running = false;
+                return;
+            }
+        } else {
+            input_update(state->key_map, &state->last_pressed);
+            if (ctx->scripted_key_map) {
+                uint8_t esc = state->key_map[KEY_ESC];
+                memcpy(state->key_map, ctx->scripted_key_map, sizeof(state->key_map));
+                state->key_map[KEY_ESC] = esc;
+            }
 #if defined(__EMSCRIPTEN__)
-        display_emscripten_frame_resize_poll();
+            display_emscripten_frame_resize_poll();
 #endif
-        bool f2_pick_log_requested = input_f2_pick_log_requested();
-        if (input_f5_save_requested())
-            player_save_position(state);
-        if (input_f9_load_requested()) {
-            switch (player_load_save_from_file(state)) {
-            case PLAYER_SAVE_LOAD_APPLIED:
-                break;
-            case PLAYER_SAVE_LOAD_NEED_LEVEL_RELOAD:
-                state->debug_f9_need_level_reload = true;
-                state->running = false;
-                break;
-            case PLAYER_SAVE_LOAD_FAILED:
-                printf("[PLAYER] F9: no savegame.bin or load failed\n");
-                break;
+            f2_pick_log_requested = input_f2_pick_log_requested();
+            if (input_f5_save_requested())
+                player_save_position(state);
+            if (input_f9_load_requested()) {
+                if (replay_recording()) {
+                    printf("[REPLAY] F9 load: tape ends here\n");
+                    replay_record_end();
+                }
+                switch (player_load_save_from_file(state)) {
+                case PLAYER_SAVE_LOAD_APPLIED:
+                    game_rebuild_level_conditions(state);
+                    break;
+                case PLAYER_SAVE_LOAD_NEED_LEVEL_RELOAD:
+                    state->debug_f9_need_level_reload = true;
+                    state->running = false;
+                    break;
+                case PLAYER_SAVE_LOAD_FAILED:
+                    printf("[PLAYER] F9: no savegame.bin or load failed\n");
+                    break;
+                }
             }
+            if (input_f6_gouraud_visualize_requested())
+                renderer_toggle_floor_gouraud_debug_view();
+            if (input_f7_spill_visualize_requested())
+                renderer_toggle_spill_visualize_debug_view();
+            if (input_automap_toggle_requested())
+                state->automap_visible = !state->automap_visible;
+            if (input_automap_pgup_requested())
+                renderer_automap_adjust_scale(-1); /* zoom in: fewer world units per pixel */
+            if (input_automap_pgdn_requested())
+                renderer_automap_adjust_scale(1);  /* zoom out */
+            if (input_fullscreen_toggle_requested())
+                display_toggle_fullscreen();
+            if (input_f8_trace_toggle_requested())
+                trace_toggle();
+            if (input_f3_perf_hud_toggle_requested())
+                display_toggle_perf_hud();
         }
-        if (input_f6_gouraud_visualize_requested())
-            renderer_toggle_floor_gouraud_debug_view();
-        if (input_f7_spill_visualize_requested())
-            renderer_toggle_spill_visualize_debug_view();
-        if (input_automap_toggle_requested())
-            state->automap_visible = !state->automap_visible;
-        if (input_automap_pgup_requested())
-            renderer_automap_adjust_scale(-1); /* zoom in: fewer world units per pixel */
-        if (input_automap_pgdn_requested())
-            renderer_automap_adjust_scale(1);  /* zoom out */
-        if (input_fullscreen_toggle_requested())
-            display_toggle_fullscreen();
+        trace_end("input", trace_frame);
 
         /* ================================================================
          * Frame timing: accumulate 50Hz VBlanks from real elapsed time
          * ================================================================ */
         {
             Uint32 now = SDL_GetTicks();
+            if (ctx->fixed_step) {
+                ctx->fixed_clock_ms += 20u;
+                now = ctx->fixed_clock_ms;
+            }
+            if (ctx->headless) now = ctx->last_ticks + (Uint32)replay_elapsed_ms;
             state->current_ticks_ms = (uint32_t)now;
             Uint32 elapsed = now - ctx->last_ticks;
             ctx->last_ticks = now;
+            replay_record_frame(state, (uint32_t)elapsed);
 
             /* Clamp to prevent spiral-of-death after alt-tab etc. */
             if (elapsed > 200) elapsed = 200;
@@ -286,242 +697,26 @@ void game_loop_tick(GameState *state, GameLoopCtx *ctx)
          * FramesToDraw is accumulated by VBlank interrupt, then TempFrames
          * is latched once per main-loop iteration (clamped) and a single
          * ObjMoveAnim-style logic pass runs with that TempFrames value.
+         * With ab3d.ini fixed_timestep the VBlanks are instead run one by
+         * one, so simulation stays at 50Hz whatever the display rate.
          * ================================================================ */
-        if (ctx->pending_vblanks >= GAME_TICK_VBLANKS) {
+        if (state->cfg_fixed_timestep && !ctx->fixed_step) {
+            /* Fixed-timestep mode: one TempFrames=1 tick per elapsed VBlank, the
+             * renderer blends the camera from the previous tick below. (elapsed is
+             * clamped to 200 ms above, so this never runs more than 10 ticks.) */
             int ticks = ctx->pending_vblanks;
-            if (ticks > MAX_TEMP_FRAMES) ticks = MAX_TEMP_FRAMES;
             ctx->pending_vblanks = 0;
-
-            state->frames_to_draw = (int16_t)ticks;
-            state->temp_frames = (int16_t)ticks;
-            audio_begin_frame();
-
-            /* ---- Phase 1: Pause handling ---- */
-            if (state->mode == MODE_SINGLE) {
-                if (input_key_pressed(state->key_map, KEY_PAUSE)) {
-                    state->do_anything = false;
-                    state->do_anything = true;
-                }
-            }
-
-            /* ---- Phase 2: Set READCONTROLS flag ---- */
-            state->read_controls = true;
-
-            /* ---- Phase 3: Hit flash fadedown ---- */
-            if (state->hitcol > 0) {
-                state->hitcol -= 0x100;
-                state->hitcol2 = state->hitcol;
-            }
-
-            /* ---- Phase 3b: Gun animation frame countdown ---- */
-            if (state->plr1.gun_frame > 0) {
-                state->plr1.gun_frame -= state->temp_frames;
-                if (state->plr1.gun_frame < 0) state->plr1.gun_frame = 0;
-            }
-            if (state->plr2.gun_frame > 0) {
-                state->plr2.gun_frame -= state->temp_frames;
-                if (state->plr2.gun_frame < 0) state->plr2.gun_frame = 0;
-            }
-
-            /* ---- Phase 6: Gun selection / ammo ---- */
-            {
-                PlayerState *gun_plr;
-                if (state->mode == MODE_SLAVE) {
-                    gun_plr = &state->plr2;
-                } else {
-                    gun_plr = &state->plr1;
-                }
-
-                int gun_idx = gun_plr->gun_selected;
-                if (gun_idx >= 0 && gun_idx < MAX_GUNS) {
-                    state->ammo = gun_plr->gun_data[gun_idx].ammo >> 3;
-                }
-            }
-
-            /* ---- Phase 7: Save old positions ---- */
-            int32_t old_x1 = state->plr1.xoff;
-            int32_t old_z1 = state->plr1.zoff;
-            int32_t old_x2 = state->plr2.xoff;
-            int32_t old_z2 = state->plr2.zoff;
-
-            /* ---- Phase 9: Player control ----
-             * Snapshotting now happens inside player*_control after
-             * simulation/fall and before full collision resolution. */
-            if (state->mode == MODE_SINGLE) {
-                state->energy = state->plr1.energy;
-                player1_control(state);
-            } else if (state->mode == MODE_MASTER) {
-                state->energy = state->plr1.energy;
-                player1_control(state);
-                player2_control(state);
-            } else if (state->mode == MODE_SLAVE) {
-                state->energy = state->plr2.energy;
-                player1_control(state);
-                player2_control(state);
-            }
-
-            /* ---- Phase 10: Zone brightness animation (bright_anim_values updated; rendering reads from zone data) ---- */
-            bright_anim_handler(state);
-
-            /* ---- Phase 11: Visibility checks (multiplayer) ---- */
-            if (state->mode != MODE_SINGLE) {
-                if (state->level.zone_adds && state->level.data) {
-                    /* CanItBeSeen stub */
-                }
-            }
-
-            /* ---- Phase 12: Fire holddown tracking ---- */
-            {
-                int16_t tf = state->temp_frames;
-
-                state->plr1.p_holddown += tf;
-                if (state->plr1.p_holddown > 30) state->plr1.p_holddown = 30;
-                if (!state->plr1.p_fire) {
-                    state->plr1.p_holddown -= tf;
-                    if (state->plr1.p_holddown < 0) state->plr1.p_holddown = 0;
-                }
-
-                state->plr2.p_holddown += tf;
-                if (state->plr2.p_holddown > 30) state->plr2.p_holddown = 30;
-                if (!state->plr2.p_fire) {
-                    state->plr2.p_holddown -= tf;
-                    if (state->plr2.p_holddown < 0) state->plr2.p_holddown = 0;
-                }
-            }
-
-            /* ---- Phase 13: Position diff ---- */
-            {
-                int16_t tf = state->temp_frames;
-                if (tf < 1) tf = 1;
-
-                int16_t dx1 = (int16_t)((state->plr1.xoff >> 16) - (old_x1 >> 16));
-                int16_t dz1 = (int16_t)((state->plr1.zoff >> 16) - (old_z1 >> 16));
-                int16_t dx2 = (int16_t)((state->plr2.xoff >> 16) - (old_x2 >> 16));
-                int16_t dz2 = (int16_t)((state->plr2.zoff >> 16) - (old_z2 >> 16));
-                state->xdiff1 = (int16_t)(((int32_t)dx1 << 4) / tf);
-                state->zdiff1 = (int16_t)(((int32_t)dz1 << 4) / tf);
-                state->xdiff2 = (int16_t)(((int32_t)dx2 << 4) / tf);
-                state->zdiff2 = (int16_t)(((int32_t)dz2 << 4) / tf);
-            }
-
-            /* ---- Phase 14: Shooting, objects ---- */
-            player1_shoot(state);
-            if (state->mode != MODE_SINGLE) {
-                player2_shoot(state);
-            }
-
-            use_player1(state);
-            if (state->mode != MODE_SINGLE) {
-                use_player2(state);
-            }
-
-            /* Zone ordering for rendering */
-            {
-                PlayerState *view_plr = (state->mode == MODE_SLAVE) ?
-                                        &state->plr2 : &state->plr1;
-
-                /* Amiga: ListOfGraphRooms = current room's list (roompt + 48). */
-                const uint8_t *lgr_ptr = NULL;
-                if (state->level.data) {
-                    int32_t lgr_off = -1;
-                    if (view_plr->roompt >= 0) {
-                        lgr_off = view_plr->roompt + 48;  /* ToListOfGraph */
-                    } else if (view_plr->list_of_graph_rooms > 0) {
-                        lgr_off = view_plr->list_of_graph_rooms;
-                    }
-                    if (lgr_off > 0) {
-                        lgr_ptr = state->level.data + lgr_off;
-                    }
-                }
-
-                /* Amiga uses high 16 bits of xoff/zoff for OrderZones side test (move.w xoff,d2 = first word of long). */
-                int32_t view_x = (int32_t)(int16_t)(view_plr->xoff >> 16);
-                int32_t view_z = (int32_t)(int16_t)(view_plr->zoff >> 16);
-                int32_t move_dx = (state->mode == MODE_SLAVE) ? (int32_t)state->xdiff2 : (int32_t)state->xdiff1;
-                int32_t move_dz = (state->mode == MODE_SLAVE) ? (int32_t)state->zdiff2 : (int32_t)state->zdiff1;
-                ZoneOrder zo;
-                order_zones(&zo, &state->level,
-                            view_x, view_z, move_dx, move_dz,
-                            (int)(view_plr->angpos & 0x3FFF),
-                            lgr_ptr);
-                memcpy(state->zone_order_zones, zo.zones,
-                       (size_t)(zo.count < 256 ? zo.count : 256) * sizeof(int16_t));
-                state->zone_order_count = zo.count;
-                apply_zone_order_workaround_level8_zone49(state, view_plr);
-                state->view_list_of_graph_rooms = lgr_ptr;
-            }
-
-            game_log_zone_changes(state);
-
-            /* Snapshot object positions before they are mutated by objects_update.
-             * The renderer uses prev_object_points + obj_interp_alpha to draw smooth
-             * movement at display frame rate even though logic runs at 50 Hz. */
-            if (state->level.prev_object_points && state->level.object_points &&
-                state->level.num_object_points > 0) {
-                memcpy(state->level.prev_object_points,
-                       state->level.object_points,
-                       (size_t)state->level.num_object_points * 8u);
-            }
-
-            objects_update(state);
-            explosion_advance(state);
-
-            /* Match Amiga frame timing: in-line target vectors are refreshed
-             * after object movement/AI for use by the next shot solve. */
-            calc_plr1_in_line(state);
-            if (state->mode != MODE_SINGLE) {
-                calc_plr2_in_line(state);
-            }
-
-            /* ---- Phase 15: Object worry flags ---- */
-            if (state->level.object_data) {
-                uint8_t vis_zones[256];
-                memset(vis_zones, 0, sizeof(vis_zones));
-                bool has_visible = false;
-
-                /* Amiga builds WorkSpace from each player's ToListOfGraph list,
-                 * then wakes objects whose objZone bit is set in WorkSpace. */
-                if (state->mode != MODE_SINGLE) {
-                    int32_t lgr2 = state->plr2.roompt;
-                    if (lgr2 >= 0) lgr2 += 48;  /* ToListOfGraph */
-                    else lgr2 = state->plr2.list_of_graph_rooms;
-                    has_visible |= mark_visible_zones_from_graph_list(
-                        vis_zones, &state->level, lgr2);
-                }
-                int32_t lgr1 = state->plr1.roompt;
-                if (lgr1 >= 0) lgr1 += 48;  /* ToListOfGraph */
-                else lgr1 = state->plr1.list_of_graph_rooms;
-                has_visible |= mark_visible_zones_from_graph_list(
-                    vis_zones, &state->level, lgr1);
-
-                if (!has_visible) {
-                    /* Match Amiga behavior: no visible-zone bits -> no wake this tick. */
-                }
-
-                int obj_idx = 0;
-                while (1) {
-                    GameObject *wobj = (GameObject*)(state->level.object_data +
-                                        obj_idx * OBJECT_SIZE);
-                    if (OBJ_CID(wobj) < 0) break;
-
-                    if (OBJ_ZONE(wobj) >= 0 && OBJ_ZONE(wobj) < 256) {
-                        if (vis_zones[OBJ_ZONE(wobj)]) {
-                            /* Amiga: or.b #127,objWorry(a0) */
-                            wobj->obj.worry |= 127;
-                        }
-                    }
-                    obj_idx++;
-                }
-            }
-
-            if (state->infinite_health) {
-                state->plr1.energy = PLAYER_MAX_ENERGY;
-                state->plr2.energy = PLAYER_MAX_ENERGY;
+            for (int i = 0; i < ticks && state->running; i++) {
+                game_loop_save_camera(state, ctx);
+                game_loop_logic_tick(state, ctx, 1);
             }
-
-            ctx->logic_count++;
-
-        } /* end if (run_logic) */
+        } else if (ctx->pending_vblanks >= GAME_TICK_VBLANKS) {
+            int ticks = ctx->pending_vblanks;
+            if (ticks > MAX_TEMP_FRAMES) ticks = MAX_TEMP_FRAMES;
+            ctx->pending_vblanks = 0;
+            ctx->camera_prev_valid = 0;
+            game_loop_logic_tick(state, ctx, ticks);
+        }
 
         /* ================================================================
          * Always: Update sprite rotation frames every display frame so
@@ -529,25 +724,10 @@ void game_loop_tick(GameState *state, GameLoopCtx *ctx)
          * ================================================================ */
         objects_update_sprite_frames(state);
 
-        /* ================================================================
-         * Always: Render every display frame (60Hz VSync) for smooth output
-         * ================================================================ */
-        if (f2_pick_log_requested) {
-            renderer_request_center_pick_capture();
-        }
-        display_energy_bar(state->energy);
-        display_ammo_bar(state->ammo);
-        display_draw_display(state);
-        if (f2_pick_log_requested) {
-            PlayerState *view_plr = (state->mode == MODE_SLAVE) ? &state->plr2 : &state->plr1;
-            int16_t looking_zone = -1;
-            renderer_get_center_pick(&looking_zone, NULL);
-            renderer_log_f2_pick_debug(state, view_plr->zone, looking_zone);
-            level_log_zones(&state->level);
-            level_log_player_zone_full(state);
-            level_log_zone_full(&state->level, looking_zone, "looking");
-        }
-
+        /* The FPS sample and the quit / level-end checks below write state the renderer
+         * reads (fps_display, running, finished_level), so they run before the render:
+         * a deferred Emscripten present is still reading state after display_draw_display
+         * returns, until display_present_pending collects it next frame. */
         ctx->fps_frames_in_sample++;
         {
             Uint64 fps_now = SDL_GetPerformanceCounter();
@@ -608,10 +788,40 @@ void game_loop_tick(GameState *state, GameLoopCtx *ctx)
             state->running = false;
         }
 
+        /* ================================================================
+         * Always: Render every display frame (60Hz VSync) for smooth output
+         * ================================================================ */
+        if (f2_pick_log_requested) {
+            renderer_request_center_pick_capture();
+        }
+        if (!ctx->headless) {
+            display_energy_bar(state->energy);
+            display_ammo_bar(state->ammo);
+            int camera_blended = game_loop_interp_camera_begin(state, ctx);
+            int late_look = game_loop_late_look_begin(state, ctx);
+            /* The camera restores and the F2 pick readback need the render finished. */
+            display_set_present_defer(!camera_blended && !late_look && !f2_pick_log_requested);
+            display_draw_display(state);
+            display_set_present_defer(0);
+            if (late_look) game_loop_late_look_end(state, ctx);
+            if (camera_blended) game_loop_interp_camera_end(state, ctx);
+        }
+        if (f2_pick_log_requested) {
+            PlayerState *view_plr = (state->mode == MODE_SLAVE) ? &state->plr2 : &state->plr1;
+            int16_t looking_zone = -1;
+            renderer_get_center_pick(&looking_zone, NULL);
+            renderer_log_f2_pick_debug(state, view_plr->zone, looking_zone);
+            level_log_zones(&state->level);
+            level_log_player_zone_full(state);
+            level_log_zone_full(&state->level, looking_zone, "looking");
+        }
+
         /* ================================================================
          * Frame counter
          * ================================================================ */
         ctx->frame_count++;
+        replay_end_frame();
+        trace_end("frame", trace_frame);
 
         /* Auto-exit (only if STUB_MAX_FRAMES > 0) */
 #if STUB_MAX_FRAMES > 0
@@ -635,9 +845,11 @@ void game_loop(GameState *state)
 {
     GameLoopCtx ctx;
     game_loop_ctx_init(&ctx, state);
+    replay_record_begin(state, &ctx);
     while (state->running) {
         game_loop_tick(state, &ctx);
     }
+    replay_record_end();
 
     printf("[LOOP] Exited: %d display frames, %d logic ticks (avg temp_frames=%d)\n",
            ctx.frame_count, ctx.logic_count,
@@ -40,6 +40,24 @@ typedef struct GameLoopCtx {
     Uint32 vblank_remainder_ms;
     Uint64 fps_sample_start_counter;
     int fps_frames_in_sample;
+    /* Deterministic stepping (--benchmark): when set, every tick advances exactly one
+     * 50Hz logic step on a synthetic clock instead of real elapsed time. */
+    int fixed_step;
+    Uint32 fixed_clock_ms;
+    /* Non-NULL: replaces the polled keyboard state each tick (ESC still passes through). */
+    const uint8_t *scripted_key_map;
+    /* --replay: input and the clock delta come from the tape, nothing is drawn. */
+    int headless;
+    /* ab3d.ini fixed_timestep: view camera before the last logic tick (blended
+     * toward the current one when rendering) and the live values parked while
+     * the blended camera is drawn. */
+    int camera_prev_valid;
+    int32_t camera_prev_xoff, camera_prev_zoff, camera_prev_yoff;
+    int16_t camera_prev_angpos;
+    int32_t camera_live_xoff, camera_live_zoff, camera_live_yoff;
+    int16_t camera_live_angpos;
+    /* Late-latched mouse look: view angle parked while the previewed one is drawn. */
+    int16_t late_look_live_angpos, late_look_live_sinval, late_look_live_cosval;
 } GameLoopCtx;
 
 void game_loop_ctx_init(GameLoopCtx *ctx, GameState *state);
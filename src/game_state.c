@@ -82,6 +82,12 @@ void game_state_init(GameState *state)
     state->cfg_weapon_draw = true;
     state->cfg_post_tint = true;
     state->cfg_weapon_post_gl = false;
+    state->cfg_render_thread_schedule = RENDER_THREAD_SCHEDULE_STRIPS;
+    state->cfg_render_thread_wait = RENDER_THREAD_WAIT_BLOCK;
+    state->cfg_present_pipeline = false;
+    state->cfg_fixed_timestep = false;
+    state->cfg_dynamic_resolution_ms = 0;
+    state->cfg_dynamic_resolution_min = 50;
 }
 
 /*
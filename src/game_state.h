@@ -15,7 +15,8 @@
 #include "game_types.h"
 
 #define PLAYER_SHOT_SLOT_COUNT 20
-#define NASTY_SHOT_SLOT_COUNT  100
+#define NASTY_SHOT_SLOT_COUNT  100   /* nasty shot/gib pool size at level load */
+#define NASTY_SHOT_SLOT_MAX    400   /* growth ceiling; keeps object points under MAX_OBJ_POINTS */
 
 /* -----------------------------------------------------------------------
  * Player state
@@ -157,6 +158,8 @@ typedef struct {
     uint8_t *player_shot_data;
     uint8_t *nasty_shot_data;
     uint8_t *other_nasty_data;
+    int16_t  nasty_shot_slots;    /* live slots in nasty_shot_data (NASTY_SHOT_SLOT_COUNT..MAX) */
+    bool     nasty_shot_pool_full; /* a spawn found no free slot; grow before the next update */
     uint8_t *object_points;
     uint8_t *prev_object_points;  /* copy of object_points snapshotted before each 50Hz logic tick (for render interpolation) */
     uint8_t *plr1_obj;           /* pointer to player 1 object in object data */
@@ -193,6 +196,7 @@ typedef struct {
     bool zone_brightness_le;
 
     int16_t  num_object_points;
+    int16_t  num_points;          /* Number of level (wall/floor) points */
     int16_t  num_zones;           /* Number of zones in the level */
     int16_t  num_zone_slots;      /* Number of entries in zone_adds table (can be num_zones+1 on Amiga data) */
     int16_t  num_zone_graph_entries; /* 8-byte rows at zone_graph_adds until next graphics section; 0 = unknown */
@@ -202,6 +206,13 @@ typedef struct {
     int16_t *zone_index_by_data_offset;
     size_t   zone_index_by_data_offset_len;
 
+    /* Native-endian copy of the static level structure (level_build_decoded). */
+    struct LevelDecoded *decoded;
+    /* Baked image for level_parse to attach instead of building decoded (level_bake.h). */
+    struct LevelBakeImage *bake_pending;
+    /* XZ grid of candidate zones for level_find_zone_for_point (level_build_zone_grid). */
+    struct LevelZoneGrid *zone_grid;
+
     /* Automap: seen wall list + lookup set.
      * Updated from renderer wall draw; guarded by renderer automap mutex when threading is on. */
     AutomapSeenWall *automap_seen_walls;
@@ -212,6 +223,14 @@ typedef struct {
 
 } LevelState;
 
+/* ab3d.ini render_thread_schedule: how the threaded world pass splits columns. */
+#define RENDER_THREAD_SCHEDULE_STRIPS 0  /* one equal-width column strip per worker */
+#define RENDER_THREAD_SCHEDULE_TILES  1  /* narrow column tiles pulled from a shared counter */
+#define RENDER_THREAD_SCHEDULE_ADAPTIVE 2 /* one strip per worker, bounds rebalanced from last frame's cost */
+/* ab3d.ini render_thread_wait: how idle render workers wait for the next dispatch. */
+#define RENDER_THREAD_WAIT_BLOCK 0  /* park on semaphores straight away (lowest idle CPU) */
+#define RENDER_THREAD_WAIT_SPIN  1  /* spin briefly on the job ticket, then park (lower wake latency) */
+
 /* -----------------------------------------------------------------------
  * Full game state
  * ----------------------------------------------------------------------- */
@@ -349,6 +368,12 @@ typedef struct {
     bool            cfg_weapon_draw;      /* 1 = first-person weapon overlay after world */
     bool            cfg_post_tint;        /* 1 = underwater fillscrnwater software post-pass */
     bool            cfg_weapon_post_gl;   /* 1 = draw weapon + underwater tint via pre-baked GL textures */
+    int8_t          cfg_render_thread_schedule; /* ab3d.ini: RENDER_THREAD_SCHEDULE_* (strips / tiles / adaptive) */
+    int8_t          cfg_render_thread_wait;     /* ab3d.ini: RENDER_THREAD_WAIT_* (block / spin) */
+    bool            cfg_present_pipeline;       /* 1 = present frame N while frame N+1 renders (+1 frame latency) */
+    bool            cfg_fixed_timestep;         /* 1 = one 50Hz logic tick per VBlank, camera blended between ticks */
+    int16_t         cfg_dynamic_resolution_ms;  /* ab3d.ini: per-frame render budget (ms); 0 = fixed render size */
+    int16_t         cfg_dynamic_resolution_min; /* ab3d.ini: smallest dynamic render scale, percent of render size */
 
 } GameState;
 
@@ -102,6 +102,13 @@ static int input_abs_i32(int v)
     return (v < 0) ? -v : v;
 }
 
+static int16_t input_clamp_i16(int v)
+{
+    if (v > 32767) return 32767;
+    if (v < -32768) return -32768;
+    return (int16_t)v;
+}
+
 static void input_set_key_state(uint8_t *map, uint8_t keycode, bool down)
 {
     if (!map || keycode >= 128) return;
@@ -151,6 +158,17 @@ static int input_axis_to_mouse_delta(int16_t axis)
  * Mouse state
  * ----------------------------------------------------------------------- */
 static MouseState g_mouse = {0};
+/* Raw mouse motion not yet seen by a logic tick. Carried across display frames that run
+ * no tick; g_mouse.dx/dy are this plus the current frame's right-stick look rate. */
+static int16_t g_raw_mouse_dx = 0;
+static int16_t g_raw_mouse_dy = 0;
+/* Look motion pulled by input_late_latch_look after input_update; folded into the next
+ * frame's raw motion. */
+static int16_t g_late_mouse_dx = 0;
+static int16_t g_late_mouse_dy = 0;
+static bool g_mouse_consumed = true;
+/* Right-stick look delta for this frame only (a rate, so never carried). */
+static int16_t g_gamepad_look_dx = 0;
 static JoyState g_joy1 = {0};
 static JoyState g_joy2 = {0};
 static bool g_quit_requested = false;
@@ -158,6 +176,8 @@ static bool g_f5_save_requested = false;
 static bool g_f9_load_requested = false;
 static bool g_f6_gouraud_visualize_requested = false;
 static bool g_f7_spill_visualize_requested = false;
+static bool g_f8_trace_toggle_requested = false;
+static bool g_f3_perf_hud_toggle_requested = false;
 static bool g_f2_pick_log_requested = false;
 static bool g_automap_toggle_requested = false;
 static bool g_automap_pgup_requested = false;
@@ -297,6 +317,7 @@ static void input_update_gamepad(uint8_t *last_pressed)
     memset(g_gamepad_keys, 0, sizeof(g_gamepad_keys));
     memset(&g_joy1, 0, sizeof(g_joy1));
     memset(&g_joy2, 0, sizeof(g_joy2));
+    g_gamepad_look_dx = 0;
 
     if (!g_gamepad) return;
 
@@ -346,7 +367,7 @@ static void input_update_gamepad(uint8_t *last_pressed)
         input_set_key_state(g_gamepad_keys, AMIGA_KEY_P, true);
     }
 
-    g_mouse.dx = (int16_t)(g_mouse.dx + input_axis_to_mouse_delta(rx));
+    g_gamepad_look_dx = (int16_t)input_axis_to_mouse_delta(rx);
 
     for (int b = 0; b < SDL_CONTROLLER_BUTTON_MAX; b++) {
         buttons[b] = (uint8_t)SDL_GameControllerGetButton(g_gamepad, (SDL_GameControllerButton)b);
@@ -399,6 +420,10 @@ static void input_apply_relative_mouse(SDL_bool want_capture, uint8_t *key_map)
         g_mouse.wheel_y = 0;
         g_mouse.dx = 0;
         g_mouse.dy = 0;
+        g_raw_mouse_dx = 0;
+        g_raw_mouse_dy = 0;
+        g_late_mouse_dx = 0;
+        g_late_mouse_dy = 0;
         input_clear_key_sources();
         if (key_map) {
             input_merge_key_sources(key_map);
@@ -428,6 +453,8 @@ void input_init(void)
     g_gamepad_weapon_cycle_steps = 0;
     g_quit_requested = false;
     g_f7_spill_visualize_requested = false;
+    g_f8_trace_toggle_requested = false;
+    g_f3_perf_hud_toggle_requested = false;
     g_f2_pick_log_requested = false;
     if (SDL_InitSubSystem(SDL_INIT_GAMECONTROLLER) == 0) {
         g_gamecontroller_subsystem_inited = true;
@@ -457,9 +484,21 @@ void input_shutdown(void)
  * ----------------------------------------------------------------------- */
 void input_update(uint8_t *key_map, uint8_t *last_pressed)
 {
-    /* Reset mouse deltas each frame */
-    g_mouse.dx = 0;
-    g_mouse.dy = 0;
+    /* Start this frame's raw motion from what the simulation has not seen yet:
+     * late-latched motion, and last frame's raw motion if no logic tick consumed it. */
+    {
+        int carry_dx = g_late_mouse_dx;
+        int carry_dy = g_late_mouse_dy;
+        if (!g_mouse_consumed) {
+            carry_dx += g_raw_mouse_dx;
+            carry_dy += g_raw_mouse_dy;
+        }
+        g_raw_mouse_dx = input_clamp_i16(carry_dx);
+        g_raw_mouse_dy = input_clamp_i16(carry_dy);
+        g_late_mouse_dx = 0;
+        g_late_mouse_dy = 0;
+        g_mouse_consumed = false;
+    }
     g_mouse.wheel_y = 0;
 
 #if defined(__EMSCRIPTEN__)
@@ -513,6 +552,10 @@ void input_update(uint8_t *key_map, uint8_t *last_pressed)
                 g_f6_gouraud_visualize_requested = true;
             } else if (ev.key.keysym.scancode == SDL_SCANCODE_F7) {
                 g_f7_spill_visualize_requested = true;
+            } else if (ev.key.keysym.scancode == SDL_SCANCODE_F8) {
+                g_f8_trace_toggle_requested = true;
+            } else if (ev.key.keysym.scancode == SDL_SCANCODE_F3) {
+                g_f3_perf_hud_toggle_requested = true;
 #if !defined(__EMSCRIPTEN__)
             } else if (ev.key.keysym.scancode == SDL_SCANCODE_F11 ||
                        ev.key.keysym.scancode == SDL_SCANCODE_F12) {
@@ -552,8 +595,8 @@ void input_update(uint8_t *key_map, uint8_t *last_pressed)
         case SDL_MOUSEMOTION:
             /* Only use mouse motion for look when captured */
             if (SDL_GetRelativeMouseMode()) {
-                g_mouse.dx += (int16_t)ev.motion.xrel;
-                g_mouse.dy += (int16_t)ev.motion.yrel;
+                g_raw_mouse_dx = input_clamp_i16(g_raw_mouse_dx + ev.motion.xrel);
+                g_raw_mouse_dy = input_clamp_i16(g_raw_mouse_dy + ev.motion.yrel);
             }
             break;
 
@@ -612,6 +655,13 @@ void input_update(uint8_t *key_map, uint8_t *last_pressed)
             }
             break;
 
+        case SDL_RENDER_TARGETS_RESET:
+            display_hud_cache_invalidate();  /* render target contents were lost */
+            break;
+        case SDL_RENDER_DEVICE_RESET:
+            display_hud_cache_device_reset(); /* the render target itself was lost */
+            break;
+
         case SDL_CONTROLLERDEVICEADDED:
             input_try_open_gamepad((int)ev.cdevice.which);
             break;
@@ -626,6 +676,8 @@ void input_update(uint8_t *key_map, uint8_t *last_pressed)
     }
 
     input_update_gamepad(last_pressed);
+    g_mouse.dx = input_clamp_i16(g_raw_mouse_dx + g_gamepad_look_dx);
+    g_mouse.dy = g_raw_mouse_dy;
 
     /* Pointer lock can drop before SDL_KEYDOWN(Escape); sync state next frame. */
     if (g_input_capture_active && !SDL_GetRelativeMouseMode()) {
@@ -646,6 +698,38 @@ void input_read_mouse(MouseState *out)
     if (out) *out = g_mouse;
 }
 
+int16_t input_late_latch_look(void)
+{
+    SDL_Event evs[32];
+    int n;
+    int pending;
+
+    if (SDL_GetRelativeMouseMode()) {
+        /* Only motion is taken; keys, buttons and window events stay queued for input_update. */
+        SDL_PumpEvents();
+        while ((n = SDL_PeepEvents(evs, (int)(sizeof(evs) / sizeof(evs[0])), SDL_GETEVENT,
+                                   SDL_MOUSEMOTION, SDL_MOUSEMOTION)) > 0) {
+            int dx = g_late_mouse_dx;
+            int dy = g_late_mouse_dy;
+            for (int i = 0; i < n; i++) {
+                dx += evs[i].motion.xrel;
+                dy += evs[i].motion.yrel;
+            }
+            g_late_mouse_dx = input_clamp_i16(dx);
+            g_late_mouse_dy = input_clamp_i16(dy);
+        }
+    }
+    /* Mouse only: the right stick is a per-frame rate and is not previewed. */
+    pending = g_late_mouse_dx;
+    if (!g_mouse_consumed) pending += g_raw_mouse_dx;
+    return input_clamp_i16(pending);
+}
+
+void input_mark_mouse_consumed(void)
+{
+    g_mouse_consumed = true;
+}
+
 void input_read_joy1(JoyState *out)
 {
     if (out) *out = g_joy1;
@@ -670,6 +754,38 @@ int16_t input_consume_gamepad_weapon_cycle_steps(void)
     return steps;
 }
 
+void input_capture_frame(const uint8_t *key_map, uint8_t last_pressed, InputFrame *out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (key_map) {
+        for (int i = 0; i < 128; i++) {
+            if (key_map[i]) out->keys[i >> 3] |= (uint8_t)(1u << (i & 7));
+        }
+    }
+    out->last_pressed = last_pressed;
+    out->mouse = g_mouse;
+    out->joy1 = g_joy1;
+    out->joy2 = g_joy2;
+    out->gamepad_duck_toggles = g_gamepad_duck_toggle_queue;
+    out->gamepad_weapon_cycle_steps = g_gamepad_weapon_cycle_steps;
+}
+
+void input_apply_frame(const InputFrame *in, uint8_t *key_map, uint8_t *last_pressed)
+{
+    if (!in) return;
+    if (key_map) {
+        for (int i = 0; i < 128; i++)
+            key_map[i] = (uint8_t)((in->keys[i >> 3] >> (i & 7)) & 1u);
+    }
+    if (last_pressed) *last_pressed = in->last_pressed;
+    g_mouse = in->mouse;
+    g_joy1 = in->joy1;
+    g_joy2 = in->joy2;
+    g_gamepad_duck_toggle_queue = in->gamepad_duck_toggles;
+    g_gamepad_weapon_cycle_steps = in->gamepad_weapon_cycle_steps;
+}
+
 bool input_key_pressed(const uint8_t *key_map, uint8_t keycode)
 {
     if (!key_map || keycode >= 128) return false;
@@ -710,6 +826,20 @@ bool input_f7_spill_visualize_requested(void)
     return true;
 }
 
+bool input_f8_trace_toggle_requested(void)
+{
+    if (!g_f8_trace_toggle_requested) return false;
+    g_f8_trace_toggle_requested = false;
+    return true;
+}
+
+bool input_f3_perf_hud_toggle_requested(void)
+{
+    if (!g_f3_perf_hud_toggle_requested) return false;
+    g_f3_perf_hud_toggle_requested = false;
+    return true;
+}
+
 bool input_f2_pick_log_requested(void)
 {
     if (!g_f2_pick_log_requested) return false;
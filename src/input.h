@@ -30,6 +30,15 @@ typedef struct {
 
 void input_read_mouse(MouseState *out);
 
+/* Late-latched look: pull mouse motion that arrived since input_update, just before the
+ * view transform is set up. Returns the look X counts the simulation has not consumed
+ * yet (late motion, plus this frame's deltas when no logic tick ran); the renderer may
+ * preview them as camera rotation. The next input_update hands them to the simulation,
+ * so every count reaches the ticks (and --record-input) exactly once. */
+int16_t input_late_latch_look(void);
+/* A logic tick read this frame's mouse deltas; do not carry them into the next frame. */
+void input_mark_mouse_consumed(void);
+
 /* Joystick */
 typedef struct {
     int16_t dx;
@@ -44,6 +53,24 @@ void input_read_joy2(JoyState *out);
 bool input_gamepad_duck_toggle_requested(void);
 int16_t input_consume_gamepad_weapon_cycle_steps(void);
 
+/* Everything the simulation reads from input in one display frame: what
+ * --record-input stores per frame and --replay feeds back (replay.c). */
+typedef struct {
+    uint8_t    keys[16];                 /* key_map bits, by Amiga keycode */
+    uint8_t    last_pressed;
+    MouseState mouse;
+    JoyState   joy1;
+    JoyState   joy2;
+    uint8_t    gamepad_duck_toggles;     /* queued, not yet consumed */
+    int16_t    gamepad_weapon_cycle_steps;
+} InputFrame;
+
+/* Snapshot the input the coming logic ticks will read (after input_update). */
+void input_capture_frame(const uint8_t *key_map, uint8_t last_pressed, InputFrame *out);
+
+/* Replace this frame's input with a recorded one (instead of input_update). */
+void input_apply_frame(const InputFrame *in, uint8_t *key_map, uint8_t *last_pressed);
+
 /* Convenience: check if a specific key is pressed */
 bool input_key_pressed(const uint8_t *key_map, uint8_t keycode);
 
@@ -56,6 +83,10 @@ bool input_f5_save_requested(void);
 bool input_f9_load_requested(void);
 bool input_f6_gouraud_visualize_requested(void);
 bool input_f7_spill_visualize_requested(void);
+/* F8: start / stop-and-write a Chrome trace capture (trace.h). */
+bool input_f8_trace_toggle_requested(void);
+/* F3: show / hide the perf HUD (display_toggle_perf_hud). */
+bool input_f3_perf_hud_toggle_requested(void);
 /* F2: log center-pick debug info (once per key press). */
 bool input_f2_pick_log_requested(void);
 /* Tab: toggle automap overlay (once per key press). */
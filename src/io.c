@@ -6,13 +6,22 @@
  */
 
 #include "io.h"
+#include "asset_loader.h"
 #include "sb_decompress.h"
 #include "renderer.h"
 #include "renderer_3dobj.h"
+#include "visibility.h"
+#include "spatial_index.h"
+#include "objects.h"
+#include "level.h"
+#include "level_bake.h"
 #include "game_types.h"
 #include "sprite_palettes.h"
+#include "settings.h"
+#include "thread_local.h"
 #include <SDL.h>
 #include <ctype.h>
+#include <setjmp.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -27,6 +36,23 @@
 #define MKDIR(path) mkdir(path, 0755)
 #endif
 
+/* Unpacked level cache: mapped copy-on-write where the platform has it. */
+#if defined(__EMSCRIPTEN__)
+#define AB3D_LEVEL_CACHE 0
+#else
+#define AB3D_LEVEL_CACHE 1
+#if defined(_WIN32) || defined(_WIN64)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#endif
+
 #if defined(__GNUC__) || defined(__clang__)
 #define AB3D_IO_UNUSED_STATIC __attribute__((unused))
 #else
@@ -41,6 +67,31 @@
 static char g_exe_base[512] = "";
 static char g_data_base[512] = "";
 
+/* Set while io_run_catching_fatal runs a load on this thread: fatal errors
+ * unwind to it instead of calling exit() off the main thread. */
+static AB3D_THREAD_LOCAL jmp_buf *t_io_fatal_catch = NULL;
+
+_Noreturn static void io_fatal_exit(void)
+{
+    if (t_io_fatal_catch) longjmp(*t_io_fatal_catch, 1);
+    exit(1);
+}
+
+int io_run_catching_fatal(void (*fn)(void))
+{
+    jmp_buf catch_buf;
+    jmp_buf *prev = t_io_fatal_catch;
+
+    t_io_fatal_catch = &catch_buf;
+    if (setjmp(catch_buf)) {
+        t_io_fatal_catch = prev;
+        return -1;
+    }
+    fn();
+    t_io_fatal_catch = prev;
+    return 0;
+}
+
 static const char *exe_base_path(void)
 {
     if (g_exe_base[0]) return g_exe_base;
@@ -48,13 +99,13 @@ static const char *exe_base_path(void)
     char *base = SDL_GetBasePath();
     if (!base) {
         fprintf(stderr, "[IO] FATAL: SDL_GetBasePath failed; cannot resolve executable base path\n");
-        exit(1);
+        io_fatal_exit();
     }
 
     if (snprintf(g_exe_base, sizeof(g_exe_base), "%s", base) >= (int)sizeof(g_exe_base)) {
         SDL_free(base);
         fprintf(stderr, "[IO] FATAL: executable base path too long\n");
-        exit(1);
+        io_fatal_exit();
     }
     SDL_free(base);
     return g_exe_base;
@@ -65,7 +116,7 @@ static const char *data_base_path(void)
     if (g_data_base[0]) return g_data_base;
     if (snprintf(g_data_base, sizeof(g_data_base), "%sdata/", exe_base_path()) >= (int)sizeof(g_data_base)) {
         fprintf(stderr, "[IO] FATAL: executable-local data path too long\n");
-        exit(1);
+        io_fatal_exit();
     }
     return g_data_base;
 }
@@ -92,7 +143,7 @@ _Noreturn static void io_fatal_missing(const char *what, const char *path)
     } else {
         fprintf(stderr, "[IO] FATAL: missing required %s\n", what);
     }
-    exit(1);
+    io_fatal_exit();
 }
 
 /* -----------------------------------------------------------------------
@@ -410,6 +461,7 @@ static void build_test_level_data(LevelState *level)
     level->num_zones = NUM_ZONES;
     level->num_zone_slots = (int16_t)NUM_ZONES;
     level->num_floor_lines = NUM_FLINES;
+    level->num_points = NUM_POINTS;
     level->point_brights = NULL; /* No per-point brightness for test level */
 
     /* Allocate player shot data (20 bullet slots for projectile weapons).
@@ -439,6 +491,7 @@ static void build_test_level_data(LevelState *level)
             }
             level->nasty_shot_data = nasty_buf;
             level->other_nasty_data = nasty_buf + nasty_shots * OBJECT_SIZE;
+            level->nasty_shot_slots = (int16_t)nasty_shots;
         }
     }
 
@@ -585,6 +638,7 @@ static void build_test_level_graphics(LevelState *level)
 
     printf("[IO] Graphics: zone_graph_adds@0, lgr@%d, gfx_data@%d, bright@%d\n",
            off_lgr, off_gfx_data, off_bright);
+    level_build_decoded(level);
 }
 
 AB3D_IO_UNUSED_STATIC
@@ -657,6 +711,7 @@ void io_init(void)
 
 void io_shutdown(void)
 {
+    renderer_release_texture_mips();
     /* Free wall texture data */
     for (int i = 0; i < MAX_WALL_TILES; i++) {
         free(g_wall_data[i]);
@@ -665,6 +720,7 @@ void io_shutdown(void)
     }
     /* Free vec object data */
     for (int i = 0; i < POLY_OBJECTS_COUNT; i++) {
+        poly_obj_unload(i);
         free(g_vec_data[i]);
         g_vec_data[i] = NULL;
     }
@@ -706,66 +762,457 @@ void io_shutdown(void)
     printf("[IO] shutdown\n");
 }
 
-int io_load_level_data(LevelState *level, int level_num)
+/* -----------------------------------------------------------------------
+ * Unpacked level cache
+ *
+ * twolev.bin / twolev.graph.bin / twolev.clips are =SB= packed. The first
+ * load of a level writes the unpacked bytes to cache/levels/ beside the
+ * executable, keyed by an FNV-1a hash of the packed file; later loads map the
+ * cache file copy-on-write instead of decompressing into a fresh buffer.
+ * The mapping is private, so level_parse fixups and runtime writes (doors,
+ * lifts, roof heights) stay in memory and never reach the file.
+ *
+ * What is cached is the unpacked file image, not the post-parse state:
+ * level_parse rewrites parts of level->data in place (water list zone ids,
+ * door/lift tables) and is not idempotent, so it keeps running on every load.
+ * AB3D_DISABLE_LEVEL_CACHE=1 skips the cache entirely.
+ *
+ * Live mappings sit in a small slot table so the loader thread can map the
+ * next level while the current one is still held; the table is guarded by a
+ * spinlock since mapping and release can happen on different threads.
+ * ----------------------------------------------------------------------- */
+#define LEVEL_BLOB_SLOTS 8  /* 3 files x (current + prefetched level), plus slack */
+
+#define LEVEL_CACHE_MAGIC "AB3DLVC1"
+
+/* 64 bytes so the payload keeps cache-line alignment inside the mapping. */
+typedef struct {
+    char     magic[8];
+    uint64_t source_hash;   /* FNV-1a 64 of the packed source file */
+    uint64_t source_size;
+    uint64_t payload_size;  /* unpacked bytes following the header */
+    uint8_t  reserved[32];
+} LevelCacheHeader;
+
+#if AB3D_LEVEL_CACHE
+typedef struct {
+    void    *base;          /* start of the mapping (header) */
+    size_t   map_len;
+    uint8_t *payload;       /* what the loader handed out */
+} LevelBlobMap;
+
+static LevelBlobMap g_level_blob_map[LEVEL_BLOB_SLOTS];
+static SDL_SpinLock g_level_blob_lock = 0;
+static int g_level_cache_state = -1;
+
+static int level_cache_enabled(void)
 {
-    char subpath[256], path[512];
-    snprintf(subpath, sizeof(subpath),
-             "levels/level_%c/twolev.bin", 'a' + level_num);
-    make_data_path(path, sizeof(path), subpath);
+    if (g_level_cache_state < 0 &&
+        !settings_env_feature_enabled(&g_level_cache_state, "AB3D_DISABLE_LEVEL_CACHE"))
+        printf("[IO] Level cache disabled (AB3D_DISABLE_LEVEL_CACHE)\n");
+    return g_level_cache_state;
+}
 
-    uint8_t *data = NULL;
-    size_t size = 0;
-    if (sb_load_file(path, &data, &size) == 0 && data) {
-        level->data = data;
-        level->data_byte_count = size;
-        printf("[IO] Loaded level data: %s (%zu bytes)\n", path, size);
-        return 0;
+static uint64_t level_cache_hash(const uint8_t *p, size_t n)
+{
+    uint64_t h = 14695981039346656037ull;
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
     }
+    return h;
+}
 
-    io_fatal_missing("level data", path);
+static void level_cache_path(char *buf, size_t bufsize, int level_num, const char *name)
+{
+    char subpath[256];
+    snprintf(subpath, sizeof(subpath), "cache/levels/level_%c_%s.cache", 'a' + level_num, name);
+    io_make_exe_path(buf, bufsize, subpath);
 }
 
-int io_load_level_graphics(LevelState *level, int level_num)
+static void io_unmap_file(void *base, size_t len)
 {
-    char subpath[256], path[512];
-    snprintf(subpath, sizeof(subpath),
-             "levels/level_%c/twolev.graph.bin", 'a' + level_num);
-    make_data_path(path, sizeof(path), subpath);
+#if defined(_WIN32) || defined(_WIN64)
+    (void)len;
+    UnmapViewOfFile(base);
+#else
+    munmap(base, len);
+#endif
+}
+
+/* Map a whole file copy-on-write; NULL when missing or shorter than min_len. */
+static void *io_map_file_private(const char *path, size_t min_len, size_t *out_len)
+{
+    void *base = NULL;
+
+#if defined(_WIN32) || defined(_WIN64)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) return NULL;
+    LARGE_INTEGER fsize;
+    if (!GetFileSizeEx(file, &fsize) || fsize.QuadPart < (LONGLONG)min_len || fsize.QuadPart == 0) {
+        CloseHandle(file);
+        return NULL;
+    }
+    *out_len = (size_t)fsize.QuadPart;
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping) return NULL;
+    base = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    return base;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)min_len || st.st_size == 0) {
+        close(fd);
+        return NULL;
+    }
+    *out_len = (size_t)st.st_size;
+    base = mmap(NULL, *out_len, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    return (base == MAP_FAILED) ? NULL : base;
+#endif
+}
+
+static void level_cache_unmap(LevelBlobMap *m)
+{
+    if (!m->base) return;
+    io_unmap_file(m->base, m->map_len);
+    m->base = NULL;
+    m->map_len = 0;
+    m->payload = NULL;
+}
+
+/* Map a cache file if its header matches the packed source. Returns the
+ * payload (writable, private) or NULL on a miss. */
+static uint8_t *level_cache_map(const char *path, uint64_t hash,
+                                size_t source_size, size_t *out_size)
+{
+    size_t len = 0;
+    void *base = io_map_file_private(path, sizeof(LevelCacheHeader), &len);
+    if (!base) return NULL;
+
+    const LevelCacheHeader *hdr = (const LevelCacheHeader *)base;
+    if (memcmp(hdr->magic, LEVEL_CACHE_MAGIC, sizeof(hdr->magic)) != 0 ||
+        hdr->source_hash != hash || hdr->source_size != (uint64_t)source_size ||
+        hdr->payload_size == 0 ||
+        hdr->payload_size != (uint64_t)(len - sizeof(LevelCacheHeader))) {
+        LevelBlobMap stale = { base, len, NULL };
+        level_cache_unmap(&stale);
+        return NULL;
+    }
+
+    uint8_t *payload = (uint8_t *)base + sizeof(LevelCacheHeader);
+    size_t payload_size = (size_t)hdr->payload_size;
+    int slotted = 0;
+    SDL_AtomicLock(&g_level_blob_lock);
+    for (int i = 0; i < LEVEL_BLOB_SLOTS; i++) {
+        LevelBlobMap *m = &g_level_blob_map[i];
+        if (!m->base) {
+            m->base = base;
+            m->map_len = len;
+            m->payload = payload;
+            slotted = 1;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&g_level_blob_lock);
+    if (!slotted) {
+        /* Out of slots: hand out a heap copy so release stays a plain free. */
+        uint8_t *copy = (uint8_t *)malloc(payload_size);
+        if (copy) memcpy(copy, payload, payload_size);
+        LevelBlobMap tmp = { base, len, NULL };
+        level_cache_unmap(&tmp);
+        if (!copy) return NULL;
+        payload = copy;
+    }
+    *out_size = payload_size;
+    return payload;
+}
+
+/* Write the unpacked image next to the executable. Goes through a temp file
+ * and rename so a concurrent reader never maps a half-written cache. */
+static void level_cache_store(const char *path, uint64_t hash, size_t source_size,
+                              const uint8_t *data, size_t size)
+{
+    char dir[512], tmp[520];
+    io_make_exe_path(dir, sizeof(dir), "cache");
+    MKDIR(dir);
+    io_make_exe_path(dir, sizeof(dir), "cache/levels");
+    MKDIR(dir);
+
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    FILE *f = fopen(tmp, "wb");
+    if (!f) {
+        printf("[IO] Level cache: cannot write %s\n", tmp);
+        return;
+    }
+
+    LevelCacheHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, LEVEL_CACHE_MAGIC, sizeof(hdr.magic));
+    hdr.source_hash = hash;
+    hdr.source_size = (uint64_t)source_size;
+    hdr.payload_size = (uint64_t)size;
+
+    int ok = fwrite(&hdr, sizeof(hdr), 1, f) == 1 &&
+             fwrite(data, 1, size, f) == size;
+    ok = (fclose(f) == 0) && ok;
+    if (ok) {
+#if defined(_WIN32) || defined(_WIN64)
+        remove(path); /* rename does not replace on Windows */
+#endif
+        ok = rename(tmp, path) == 0;
+    }
+    if (!ok) {
+        remove(tmp);
+        printf("[IO] Level cache: failed to store %s\n", path);
+    }
+}
+#endif /* AB3D_LEVEL_CACHE */
+
+static uint8_t *level_blob_read_file(const char *path, size_t *out_len)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (len < 12) {
+        fclose(f);
+        return NULL;
+    }
+    uint8_t *buf = (uint8_t *)malloc((size_t)len);
+    if (buf && fread(buf, 1, (size_t)len, f) != (size_t)len) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    *out_len = (size_t)len;
+    return buf;
+}
+
+/* Load one level file, preferring the unpacked cache. *out_cached is set
+ * when the buffer came from a mapping (release with level_blob_release). */
+static int io_load_level_blob(int level_num, const char *name,
+                              char *path, size_t path_size,
+                              uint8_t **out_data, size_t *out_size, int *out_cached)
+{
+    char subpath[256];
+    snprintf(subpath, sizeof(subpath), "levels/level_%c/%s", 'a' + level_num, name);
+    make_data_path(path, path_size, subpath);
+    *out_data = NULL;
+    *out_size = 0;
+    *out_cached = 0;
+
+#if AB3D_LEVEL_CACHE
+    if (level_cache_enabled()) {
+        size_t src_len = 0;
+        uint8_t *src = level_blob_read_file(path, &src_len);
+        if (!src) return -1;
+
+        char cache_path[512];
+        uint64_t hash = level_cache_hash(src, src_len);
+        level_cache_path(cache_path, sizeof(cache_path), level_num, name);
+
+        uint8_t *mapped = level_cache_map(cache_path, hash, src_len, out_size);
+        if (mapped) {
+            free(src);
+            *out_data = mapped;
+            *out_cached = 1;
+            return 0;
+        }
+
+        int packed = sb_is_compressed(src, src_len);
+        if (sb_unpack_buffer(src, src_len, path, out_data, out_size) != 0 || !*out_data)
+            return -1;
+        if (packed) /* raw files gain nothing from a second copy */
+            level_cache_store(cache_path, hash, src_len, *out_data, *out_size);
+        return 0;
+    }
+#endif
+    return (sb_load_file(path, out_data, out_size) == 0 && *out_data) ? 0 : -1;
+}
 
+static void level_blob_release(uint8_t *data)
+{
+    if (!data) return;
+#if AB3D_LEVEL_CACHE
+    LevelBlobMap mapped = { NULL, 0, NULL };
+    SDL_AtomicLock(&g_level_blob_lock);
+    for (int i = 0; i < LEVEL_BLOB_SLOTS; i++) {
+        if (g_level_blob_map[i].payload == data) {
+            mapped = g_level_blob_map[i];
+            g_level_blob_map[i].base = NULL;
+            g_level_blob_map[i].map_len = 0;
+            g_level_blob_map[i].payload = NULL;
+            break;
+        }
+    }
+    SDL_AtomicUnlock(&g_level_blob_lock);
+    if (mapped.base) {
+        level_cache_unmap(&mapped);
+        return;
+    }
+#endif
+    free(data);
+}
+
+/* One of the three level files. A miss is fatal for the foreground load; with
+ * fatal == 0 (loader-thread prefetch) it returns -1 and leaves *out_data alone. */
+static int io_load_level_file(int level_num, const char *name, const char *what,
+                              uint8_t **out_data, size_t *out_size, int fatal)
+{
+    char path[512];
     uint8_t *data = NULL;
     size_t size = 0;
-    if (sb_load_file(path, &data, &size) == 0 && data) {
-        level->graphics = data;
-        level->graphics_byte_count = size;
-        printf("[IO] Loaded level graphics: %s (%zu bytes)\n", path, size);
+    int cached = 0;
+    if (io_load_level_blob(level_num, name, path, sizeof(path), &data, &size, &cached) == 0) {
+        *out_data = data;
+        *out_size = size;
+        printf("[IO] Loaded %s: %s (%zu bytes%s)\n", what, path, size, cached ? ", cached" : "");
         return 0;
     }
+    if (fatal) io_fatal_missing(what, path);
+    return -1;
+}
+
+int io_load_level_data(LevelState *level, int level_num)
+{
+    return io_load_level_file(level_num, "twolev.bin", "level data",
+                              &level->data, &level->data_byte_count, 1);
+}
 
-    io_fatal_missing("level graphics", path);
+int io_load_level_graphics(LevelState *level, int level_num)
+{
+    return io_load_level_file(level_num, "twolev.graph.bin", "level graphics",
+                              &level->graphics, &level->graphics_byte_count, 1);
 }
 
 int io_load_level_clips(LevelState *level, int level_num)
 {
-    char subpath[256], path[512];
-    snprintf(subpath, sizeof(subpath),
-             "levels/level_%c/twolev.clips", 'a' + level_num);
-    make_data_path(path, sizeof(path), subpath);
+    return io_load_level_file(level_num, "twolev.clips", "level clips",
+                              &level->clips, &level->clips_byte_count, 1);
+}
 
-    uint8_t *data = NULL;
+int io_try_load_level_files(LevelState *level, int level_num)
+{
+    if (io_load_level_file(level_num, "twolev.bin", "level data",
+                           &level->data, &level->data_byte_count, 0) != 0 ||
+        io_load_level_file(level_num, "twolev.graph.bin", "level graphics",
+                           &level->graphics, &level->graphics_byte_count, 0) != 0 ||
+        io_load_level_file(level_num, "twolev.clips", "level clips",
+                           &level->clips, &level->clips_byte_count, 0) != 0) {
+        io_release_level_files(level);
+        return -1;
+    }
+    return 0;
+}
+
+/* -----------------------------------------------------------------------
+ * Baked level (level_bake.h): levels/level_x/twolev.bake, written by
+ * tools/parse_level --bake. Optional; level_parse attaches it when its
+ * source hash matches the files just loaded. AB3D_DISABLE_LEVEL_BAKE=1
+ * ignores it.
+ * ----------------------------------------------------------------------- */
+typedef struct {
+    LevelBakeImage img;
+    int mapped;
+} IoLevelBake;
+
+static void io_level_bake_release(LevelBakeImage *img)
+{
+    IoLevelBake *b = (IoLevelBake *)img;
+#if AB3D_LEVEL_CACHE
+    if (b->mapped) io_unmap_file(img->base, img->size);
+    else
+#endif
+        free(img->base);
+    free(b);
+}
+
+void io_load_level_bake(LevelState *level, int level_num)
+{
+    static int s_bake_state = -1;
+    char subpath[256], path[512];
+    uint8_t *base = NULL;
     size_t size = 0;
-    if (sb_load_file(path, &data, &size) == 0 && data) {
-        level->clips = data;
-        level->clips_byte_count = size;
-        printf("[IO] Loaded level clips: %s (%zu bytes)\n", path, size);
-        return 0;
+    int mapped = 0;
+
+    if (s_bake_state < 0 && !settings_env_feature_enabled(&s_bake_state, "AB3D_DISABLE_LEVEL_BAKE"))
+        printf("[IO] Level bake disabled (AB3D_DISABLE_LEVEL_BAKE)\n");
+    if (!s_bake_state || !level->data || !level->graphics) return;
+
+    snprintf(subpath, sizeof(subpath), "levels/level_%c/%s", 'a' + level_num, LEVEL_BAKE_FILE_NAME);
+    make_data_path(path, sizeof(path), subpath);
+#if AB3D_LEVEL_CACHE
+    base = (uint8_t *)io_map_file_private(path, 1, &size);
+    mapped = base != NULL;
+#endif
+    if (!base) {
+        FILE *f = fopen(path, "rb");
+        long len;
+        if (!f) return;
+        fseek(f, 0, SEEK_END);
+        len = ftell(f);
+        fseek(f, 0, SEEK_SET);
+        base = (len > 0) ? (uint8_t *)malloc((size_t)len) : NULL;
+        if (base && fread(base, 1, (size_t)len, f) != (size_t)len) {
+            free(base);
+            base = NULL;
+        }
+        fclose(f);
+        if (!base) return;
+        size = (size_t)len;
     }
 
-    io_fatal_missing("level clips", path);
+    IoLevelBake *b = (IoLevelBake *)calloc(1, sizeof(*b));
+    if (!b) {
+#if AB3D_LEVEL_CACHE
+        if (mapped) io_unmap_file(base, size);
+        else
+#endif
+            free(base);
+        return;
+    }
+    b->img.base = base;
+    b->img.size = size;
+    b->img.release = io_level_bake_release;
+    b->mapped = mapped;
+    if (!level_bake_header_ok(base, size, level_bake_source_hash(level))) {
+        printf("[IO] Level bake %s does not match the level files, ignoring it\n", path);
+        io_level_bake_release(&b->img);
+        return;
+    }
+    if (level->bake_pending) level_bake_image_release(level->bake_pending);
+    level->bake_pending = &b->img;
+    printf("[IO] Loaded level bake: %s (%zu bytes%s)\n", path, size, mapped ? ", mapped" : "");
 }
 
-void io_release_level_memory(LevelState *level)
+void io_release_level_files(LevelState *level)
+{
+    level_blob_release(level->data);        level->data = NULL;
+    level->data_byte_count = 0;
+    level_blob_release(level->graphics);    level->graphics = NULL;
+    level->graphics_byte_count = 0;
+    level_blob_release(level->clips);       level->clips = NULL;
+    level->clips_byte_count = 0;
+}
+
+void io_invalidate_level_caches(void)
 {
     renderer_reset_level_sky_cache();
+    order_zones_invalidate_cache();
+    spatial_index_reset();
+    objects_shot_pools_invalidate();
+    can_it_be_seen_invalidate_level();
+}
+
+void io_release_level_memory(LevelState *level)
+{
+    io_invalidate_level_caches();
 
     /* Automap runtime state */
     renderer_automap_lock();
@@ -778,9 +1225,16 @@ void io_release_level_memory(LevelState *level)
     level->automap_seen_hash_cap = 0;
     renderer_automap_unlock();
 
+    /* Before the offset map: a baked one lives inside the decoded image. */
+    level_free_decoded(level);
+    level_free_zone_grid(level);
     free(level->zone_index_by_data_offset);
     level->zone_index_by_data_offset = NULL;
     level->zone_index_by_data_offset_len = 0;
+    if (level->bake_pending) {
+        level_bake_image_release(level->bake_pending);
+        level->bake_pending = NULL;
+    }
 
     /* player_shot_data and nasty_shot_data point into the data buffer
      * when loaded from real files (level_parse resolves them as offsets
@@ -801,6 +1255,8 @@ void io_release_level_memory(LevelState *level)
     }
     level->nasty_shot_data = NULL;
     level->other_nasty_data = NULL;
+    level->nasty_shot_slots = 0;
+    level->nasty_shot_pool_full = false;
 
     if (level->object_points && level->data) {
         uint8_t *d = level->data;
@@ -858,13 +1314,8 @@ void io_release_level_memory(LevelState *level)
     level->zone_adds = NULL;
     level->zone_adds_owned = false;
     level->num_zone_slots = 0;
-    free(level->data);              level->data = NULL;
-    level->data_byte_count = 0;
-    free(level->graphics);          level->graphics = NULL;
-    level->graphics_byte_count = 0;
+    io_release_level_files(level);
     level->num_zone_graph_entries = 0;
-    free(level->clips);             level->clips = NULL;
-    level->clips_byte_count = 0;
 
     /* Clear remaining pointers (they pointed into the freed buffers) */
     level->lift_data = NULL;
@@ -947,6 +1398,7 @@ void io_load_walls(void)
                 wall_texture_dims_from_size(i, pixel_size, &rows, &valshift);
                 g_renderer.wall_valand[i] = (uint8_t)(rows - 1);
                 g_renderer.wall_valshift[i] = (uint8_t)valshift;
+                renderer_build_wall_mips(i, data + 2048, size - 2048, valshift, data);
             }
             printf("[IO] Wall %2d: %s (%zu bytes)\n", i,
                    wall_texture_table[i].name, size);
@@ -964,6 +1416,7 @@ void io_load_floor(void)
 
     char path[512];
     FILE *f = NULL;
+    size_t floor_tile_len = 0;
 
     /* Reload-safe: free prior allocations and clear renderer pointers. */
     free(g_floor_tile_data);       g_floor_tile_data = NULL;
@@ -991,7 +1444,7 @@ void io_load_floor(void)
 
         g_floor_tile_data = (uint8_t *)malloc((size_t)len);
         if (g_floor_tile_data) {
-            fread(g_floor_tile_data, 1, (size_t)len, f);
+            floor_tile_len = fread(g_floor_tile_data, 1, (size_t)len, f);
             printf("[IO] Floor tile: %ld bytes from %s\n", len, path);
             g_renderer.floor_tile = g_floor_tile_data;
         }
@@ -1057,6 +1510,8 @@ void io_load_floor(void)
     } else {
         io_fatal_missing("floor palette (FloorPalScaled)", path);
     }
+    renderer_build_floor_mips(g_floor_tile_data, floor_tile_len,
+                              g_floor_pal_data);
 
     /* BumpTile (types 8/9) */
     {
@@ -1893,6 +2348,31 @@ static int load_sprite_file(const char *name, const char *prefix,
     return 0;
 }
 
+/* One sprite slot's WAD/PTR pair, decoded in parallel by io_load_objects. */
+typedef struct {
+    uint8_t *wad;
+    size_t   wad_size;
+    uint8_t *ptr;
+    size_t   ptr_size;
+} SpriteLoadResult;
+
+static void io_load_sprite_slot_job(int slot, void *userdata)
+{
+    SpriteLoadResult *r = &((SpriteLoadResult *)userdata)[slot];
+    if (sprite_wad_names[slot] &&
+        !load_sprite_file(sprite_wad_names[slot], NULL, &r->wad, &r->wad_size)) {
+        r->wad = NULL;
+        r->wad_size = 0;
+    }
+    if (sprite_ptr_names[slot] &&
+        !load_sprite_file(sprite_ptr_names[slot], NULL, &r->ptr, &r->ptr_size)) {
+        r->ptr = NULL;
+        r->ptr_size = 0;
+    }
+    if (r->wad && r->ptr)
+        io_apply_sprite_asset_fixes(slot, r->wad, r->wad_size, r->ptr, r->ptr_size);
+}
+
 void io_load_objects(void)
 {
     printf("[IO] Loading object sprites...\n");
@@ -1907,15 +2387,19 @@ void io_load_objects(void)
         g_renderer.sprite_pal_data[i] = NULL; g_renderer.sprite_pal_size[i] = 0;
     }
 
+    /* File reads + =SB= decode are independent per slot; publish in slot order. */
+    SpriteLoadResult loaded[MAX_SPRITE_TYPES];
+    memset(loaded, 0, sizeof(loaded));
+    asset_parallel_for(MAX_SPRITE_TYPES, io_load_sprite_slot_job, loaded);
+
     for (int i = 0; i < MAX_SPRITE_TYPES; i++) {
         /* Load .wad (packed pixel data) */
         if (sprite_wad_names[i]) {
-            uint8_t *data = NULL; size_t sz = 0;
-            if (load_sprite_file(sprite_wad_names[i], NULL, &data, &sz)) {
-                g_sprite_data[i] = data;
-                g_renderer.sprite_wad[i] = data;
-                g_renderer.sprite_wad_size[i] = sz;
-                printf("[IO] Sprite %2d WAD: %s (%zu bytes)\n", i, sprite_wad_names[i], sz);
+            if (loaded[i].wad) {
+                g_sprite_data[i] = loaded[i].wad;
+                g_renderer.sprite_wad[i] = loaded[i].wad;
+                g_renderer.sprite_wad_size[i] = loaded[i].wad_size;
+                printf("[IO] Sprite %2d WAD: %s (%zu bytes)\n", i, sprite_wad_names[i], loaded[i].wad_size);
             } else {
                 if (sprite_slot_required(i)) {
                     char path[512];
@@ -1927,12 +2411,11 @@ void io_load_objects(void)
 
         /* Load .ptr (column pointer table) */
         if (sprite_ptr_names[i]) {
-            uint8_t *data = NULL; size_t sz = 0;
-            if (load_sprite_file(sprite_ptr_names[i], NULL, &data, &sz)) {
-                g_sprite_ptr_data[i] = data;
-                g_renderer.sprite_ptr[i] = data;
-                g_renderer.sprite_ptr_size[i] = sz;
-                printf("[IO] Sprite %2d PTR: %s (%zu bytes)\n", i, sprite_ptr_names[i], sz);
+            if (loaded[i].ptr) {
+                g_sprite_ptr_data[i] = loaded[i].ptr;
+                g_renderer.sprite_ptr[i] = loaded[i].ptr;
+                g_renderer.sprite_ptr_size[i] = loaded[i].ptr_size;
+                printf("[IO] Sprite %2d PTR: %s (%zu bytes)\n", i, sprite_ptr_names[i], loaded[i].ptr_size);
             } else {
                 if (sprite_slot_required(i)) {
                     char path[512];
@@ -1942,12 +2425,6 @@ void io_load_objects(void)
             }
         }
 
-        if (g_sprite_data[i] && g_sprite_ptr_data[i]) {
-            io_apply_sprite_asset_fixes(i,
-                                        g_sprite_data[i], g_renderer.sprite_wad_size[i],
-                                        g_sprite_ptr_data[i], g_renderer.sprite_ptr_size[i]);
-        }
-
         /* .pal: embedded tables only (from data/pal via sprite_palettes_data.h). No runtime load. */
         if (sprite_pal_names[i]) {
             if (sprite_pal_embedded_size[i] > 0 && sprite_pal_embedded[i] != NULL) {
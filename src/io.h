@@ -19,7 +19,23 @@ void io_shutdown(void);
 int  io_load_level_data(LevelState *level, int level_num);
 int  io_load_level_graphics(LevelState *level, int level_num);
 int  io_load_level_clips(LevelState *level, int level_num);
+/* All three files without the fatal exit: on any failure, releases what was loaded and
+ * returns -1. For loads off the main thread (level prefetch). */
+int  io_try_load_level_files(LevelState *level, int level_num);
+/* Queue levels/level_x/twolev.bake for level_parse when it matches the
+ * loaded files (level_bake.h). Call after the three loads above. */
+void io_load_level_bake(LevelState *level, int level_num);
 void io_release_level_memory(LevelState *level);
+/* Drop the per-level derived caches (sky, zone order, spatial index,
+ * shot pools, LOS). Part of io_release_level_memory; also after an in-place F9 restore. */
+void io_invalidate_level_caches(void);
+/* Free only data/graphics/clips - for an unparsed (prefetched) LevelState. */
+void io_release_level_files(LevelState *level);
+
+/* Run fn; a fatal load error inside it (missing file, bad data path) returns -1
+ * here instead of exiting. For loads off the main thread: the caller reports the
+ * failure and exits on the main thread. Partially loaded assets are not released. */
+int  io_run_catching_fatal(void (*fn)(void));
 
 /* Asset loading */
 void io_load_walls(void);
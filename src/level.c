@@ -6,7 +6,9 @@
  */
 
 #include "level.h"
+#include "level_bake.h"
 #include "game_types.h"
+#include "thread_local.h"
 #include <stdint.h>
 #include <limits.h>
 #include <stdio.h>
@@ -21,16 +23,6 @@
 #define AB3D_ATTR_UNUSED
 #endif
 
-#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
-#define AB3D_THREAD_LOCAL _Thread_local
-#elif defined(_MSC_VER)
-#define AB3D_THREAD_LOCAL __declspec(thread)
-#elif defined(__GNUC__) || defined(__clang__)
-#define AB3D_THREAD_LOCAL __thread
-#else
-#define AB3D_THREAD_LOCAL
-#endif
-
 /* Helper to read big-endian 16-bit word from buffer */
 static int16_t read_word(const uint8_t *p)
 {
@@ -91,10 +83,16 @@ static int32_t pick_next_section_offset(int32_t floor_offset, int32_t data_size,
     return next;
 }
 
-static int level_expand_nasty_shot_pool(LevelState *level)
+/* Same ownership rule io_release_level_memory applies to the shot pools. */
+static bool level_ptr_in_data(const LevelState *level, const uint8_t *p)
+{
+    size_t len = level->data_byte_count ? level->data_byte_count : 1024u * 1024u;
+    return level->data && p >= level->data && p < level->data + len;
+}
+
+int level_grow_nasty_shot_pool(LevelState *level, int new_slots)
 {
-    const int old_slots = PLAYER_SHOT_SLOT_COUNT;
-    const int new_slots = NASTY_SHOT_SLOT_COUNT;
+    int old_slots;
     int old_point_count;
     int added_slots;
     int new_point_count;
@@ -103,9 +101,12 @@ static int level_expand_nasty_shot_pool(LevelState *level)
     uint8_t *new_points;
 
     if (!level || !level->nasty_shot_data) return -1;
+    old_slots = (level->nasty_shot_slots > 0) ? level->nasty_shot_slots : PLAYER_SHOT_SLOT_COUNT;
+    if (new_slots > NASTY_SHOT_SLOT_MAX) new_slots = NASTY_SHOT_SLOT_MAX;
     if (new_slots <= old_slots) {
+        level->nasty_shot_slots = (int16_t)old_slots;
         level->other_nasty_data = level->nasty_shot_data + (size_t)old_slots * OBJECT_SIZE;
-        return 0;
+        return (new_slots == old_slots) ? 0 : -1;
     }
 
     old_point_count = (level->num_object_points > 0) ? (int)level->num_object_points : 0;
@@ -126,6 +127,19 @@ static int level_expand_nasty_shot_pool(LevelState *level)
         memcpy(new_points, level->object_points, (size_t)old_point_count * 8u);
     }
 
+    /* Render interpolation snapshot must cover the new points too. */
+    if (level->prev_object_points) {
+        uint8_t *new_prev = (uint8_t *)realloc(level->prev_object_points,
+                                               (size_t)new_point_count * 8u);
+        if (!new_prev) {
+            free(new_points);
+            free(new_nasty);
+            return -1;
+        }
+        memset(new_prev + (size_t)old_point_count * 8u, 0, (size_t)added_slots * 8u);
+        level->prev_object_points = new_prev;
+    }
+
     next_cid = old_point_count;
     for (int i = old_slots; i < new_slots; i++) {
         uint8_t *slot = new_nasty + (size_t)i * OBJECT_SIZE;
@@ -134,8 +148,18 @@ static int level_expand_nasty_shot_pool(LevelState *level)
         next_cid++;
     }
 
+    /* The file's own pool lives inside level data; later pools are ours. */
+    if (!level_ptr_in_data(level, level->nasty_shot_data)) {
+        memcpy(new_nasty + (size_t)new_slots * OBJECT_SIZE, level->other_nasty_data,
+               (size_t)old_slots * 64u);
+        free(level->nasty_shot_data);
+    }
+    if (level->object_points && !level_ptr_in_data(level, level->object_points))
+        free(level->object_points);
+
     level->nasty_shot_data = new_nasty;
     level->other_nasty_data = new_nasty + (size_t)new_slots * OBJECT_SIZE;
+    level->nasty_shot_slots = (int16_t)new_slots;
     level->object_points = new_points;
     level->num_object_points = (int16_t)new_point_count;
     return 0;
@@ -488,6 +512,7 @@ int level_parse(LevelState *level)
     /* ---- Level data header ---- */
     /* Byte 14: Number of points (word) */
     int16_t num_points = read_word(ld + 14);
+    level->num_points = num_points;
 
     /* Byte 16: Number of zones (word) */
     level->num_zones = read_word(ld + 16);
@@ -688,11 +713,13 @@ int level_parse(LevelState *level)
     level->nasty_shot_data = ld + nshot_offset;
     /* Other nasty data follows after shot records. */
     level->other_nasty_data = level->nasty_shot_data + (size_t)PLAYER_SHOT_SLOT_COUNT * OBJECT_SIZE;
+    level->nasty_shot_slots = PLAYER_SHOT_SLOT_COUNT;
+    level->nasty_shot_pool_full = false;
 
     /* Long 42: Offset to object points */
     level->object_points = ld + objpts_offset;
 
-    if (level_expand_nasty_shot_pool(level) == 0) {
+    if (level_grow_nasty_shot_pool(level, NASTY_SHOT_SLOT_COUNT) == 0) {
         printf("[LEVEL] Expanded nasty shot pool: %d slots, object_points=%d\n",
                NASTY_SHOT_SLOT_COUNT, (int)level->num_object_points);
     } else {
@@ -831,7 +858,15 @@ int level_parse(LevelState *level)
 
     log_broken_floor_line_connects(level);
 
+    if (level->bake_pending) {
+        LevelBakeImage *bake = level->bake_pending;
+        level->bake_pending = NULL;
+        if (level_bake_attach(level, bake))
+            return 0;
+        level_bake_image_release(bake);
+    }
     level_build_zone_index_by_data_offset(level);
+    level_build_decoded(level);
 
     return 0;
 }
@@ -977,6 +1012,8 @@ int level_connect_to_zone_index(const LevelState *level, int16_t connect)
 
     if (!level->zone_adds || !level->data || connect < 0)
         return -1;
+    if (level->decoded && level->decoded->connect_zone && connect < level->decoded->num_connect)
+        return (int)level->decoded->connect_zone[connect];
     int zone_slots = level_zone_slot_count(level);
     if (zone_slots <= 0)
         return -1;
@@ -1095,6 +1132,554 @@ int level_zone_index_from_room_ptr(const LevelState *level, const uint8_t *room_
     return level_zone_index_from_room_offset(level, (int32_t)(room_ptr - level->data));
 }
 
+/* -----------------------------------------------------------------------
+ * Decoded level view (see level.h)
+ * ----------------------------------------------------------------------- */
+size_t level_gfx_entry_payload_size(int16_t entry_type, const uint8_t *payload)
+{
+    switch (entry_type) {
+    case 0:
+    case 13: return 28;
+    case 3:
+    case 12: return 0;
+    case 4: return 2;
+    case 5: return 28;
+    case 6: return 4;
+    case 1:
+    case 2:
+    case 7:
+    case 8:
+    case 9:
+    case 10:
+    case 11:
+    {
+        int16_t num_sides_m1 = read_word(payload + 2);
+        int sides = (int)num_sides_m1 + 1;
+        if (sides < 0) sides = 0;
+        if (sides > 100) sides = 100;
+        /* Payload layout after type:
+         *   ypos(2) + sides_m1(2) + point_indices(2*sides) + extra(8) */
+        return (size_t)(4 + 2 * sides + 8);
+    }
+    default:
+        return 0;
+    }
+}
+
+void level_floor_line_decode(const LevelState *level, int32_t idx, LevelFloorLine *out)
+{
+    const uint8_t *fl = level->floor_lines + (size_t)idx * 16u;
+    int zone_slots = level_zone_slot_count(level);
+    int32_t ex, ez;
+
+    out->x = read_word(fl + 0);
+    out->z = read_word(fl + 2);
+    out->xlen = read_word(fl + 4);
+    out->zlen = read_word(fl + 6);
+    out->connect = read_word(fl + 8);
+    out->length = read_word(fl + 10);
+    out->normal_x = (int8_t)fl[12];
+    out->normal_z = (int8_t)fl[13];
+    out->connect_zone = (int16_t)level_connect_to_zone_index(level, out->connect);
+    out->target_off = 0;
+    if (level->zone_adds && out->connect_zone >= 0 && out->connect_zone < zone_slots)
+        out->target_off = read_long(level->zone_adds + (size_t)out->connect_zone * 4u);
+
+    ex = (int32_t)out->x + (int32_t)out->xlen;
+    ez = (int32_t)out->z + (int32_t)out->zlen;
+    out->min_x = (out->x < ex) ? out->x : ex;
+    out->max_x = (out->x < ex) ? ex : out->x;
+    out->min_z = (out->z < ez) ? out->z : ez;
+    out->max_z = (out->z < ez) ? ez : out->z;
+}
+
+/* Copy an exit list up to and including the -2 terminator. */
+static int level_copy_exit_list(const uint8_t *list, int16_t *out)
+{
+    int n = 0;
+    while (n < LEVEL_EXIT_LIST_MAX) {
+        int16_t entry = read_word(list + (size_t)n * 2u);
+        out[n++] = entry;
+        if (entry == -2) break;
+    }
+    return n;
+}
+
+/* Exit list of zone slot z, or NULL when its data/list lies outside level->data. */
+static const uint8_t *level_zone_exit_list_raw(const LevelState *level, int z)
+{
+    int32_t zoff = read_long(level->zone_adds + (size_t)z * 4u);
+    int16_t list_off;
+    int64_t list_abs;
+
+    if (zoff < 0) return NULL;
+    if (level->data_byte_count > 0 && (size_t)zoff + 34u > level->data_byte_count) return NULL;
+    list_off = read_word(level->data + zoff + 32);
+    list_abs = (int64_t)zoff + (int64_t)list_off;
+    if (list_abs < 0) return NULL;
+    if (level->data_byte_count > 0 && (size_t)list_abs + 2u > level->data_byte_count) return NULL;
+    return level->data + (size_t)list_abs;
+}
+
+void level_free_decoded(LevelState *level)
+{
+    LevelDecoded *d;
+    if (!level || !level->decoded) return;
+    d = level->decoded;
+    if (d->bake) {
+        /* The offset map may point into the same image. */
+        if (level_bake_image_owns(d->bake, level->zone_index_by_data_offset)) {
+            level->zone_index_by_data_offset = NULL;
+            level->zone_index_by_data_offset_len = 0;
+        }
+        level_bake_image_release(d->bake);
+        free(d);
+        level->decoded = NULL;
+        return;
+    }
+    free(d->point_x); free(d->point_z);
+    free(d->line_x); free(d->line_z); free(d->line_xlen); free(d->line_zlen);
+    free(d->line_length); free(d->line_connect); free(d->line_connect_zone);
+    free(d->line_target_off); free(d->line_normal_x); free(d->line_normal_z);
+    free(d->line_min_x); free(d->line_min_z); free(d->line_max_x); free(d->line_max_z);
+    free(d->zone_off); free(d->zone_exit_first); free(d->zone_exits);
+    free(d->zone_neighbor_first); free(d->zone_neighbors);
+    free(d->graph_zone_id); free(d->gfx_streams); free(d->gfx_tokens);
+    free(d->connect_zone);
+    free(d->zone_pvs_first); free(d->zone_pvs); free(d->zone_pvs_gate);
+    free(d);
+    level->decoded = NULL;
+}
+
+static int level_decode_lines_and_points(const LevelState *level, LevelDecoded *d)
+{
+    size_t n = (size_t)level->num_floor_lines;
+    size_t np = (level->points && level->num_points > 0) ? (size_t)level->num_points : 0u;
+
+    d->point_x = (int16_t *)malloc((np ? np : 1u) * sizeof(int16_t));
+    d->point_z = (int16_t *)malloc((np ? np : 1u) * sizeof(int16_t));
+    d->line_x = (int16_t *)malloc(n * sizeof(int16_t));
+    d->line_z = (int16_t *)malloc(n * sizeof(int16_t));
+    d->line_xlen = (int16_t *)malloc(n * sizeof(int16_t));
+    d->line_zlen = (int16_t *)malloc(n * sizeof(int16_t));
+    d->line_length = (int16_t *)malloc(n * sizeof(int16_t));
+    d->line_connect = (int16_t *)malloc(n * sizeof(int16_t));
+    d->line_connect_zone = (int16_t *)malloc(n * sizeof(int16_t));
+    d->line_target_off = (int32_t *)malloc(n * sizeof(int32_t));
+    d->line_normal_x = (int8_t *)malloc(n);
+    d->line_normal_z = (int8_t *)malloc(n);
+    d->line_min_x = (int32_t *)malloc(n * sizeof(int32_t));
+    d->line_min_z = (int32_t *)malloc(n * sizeof(int32_t));
+    d->line_max_x = (int32_t *)malloc(n * sizeof(int32_t));
+    d->line_max_z = (int32_t *)malloc(n * sizeof(int32_t));
+    if (!d->point_x || !d->point_z || !d->line_x || !d->line_z || !d->line_xlen ||
+        !d->line_zlen || !d->line_length || !d->line_connect || !d->line_connect_zone ||
+        !d->line_target_off || !d->line_normal_x || !d->line_normal_z ||
+        !d->line_min_x || !d->line_min_z || !d->line_max_x || !d->line_max_z)
+        return 0;
+
+    d->num_points = (int32_t)np;
+    for (size_t i = 0; i < np; i++) {
+        d->point_x[i] = read_word(level->points + i * 4u);
+        d->point_z[i] = read_word(level->points + i * 4u + 2u);
+    }
+
+    d->num_floor_lines = (int32_t)n;
+    for (size_t i = 0; i < n; i++) {
+        LevelFloorLine fl;
+        level_floor_line_decode(level, (int32_t)i, &fl);
+        d->line_x[i] = fl.x;
+        d->line_z[i] = fl.z;
+        d->line_xlen[i] = fl.xlen;
+        d->line_zlen[i] = fl.zlen;
+        d->line_length[i] = fl.length;
+        d->line_connect[i] = fl.connect;
+        d->line_connect_zone[i] = fl.connect_zone;
+        d->line_target_off[i] = fl.target_off;
+        d->line_normal_x[i] = fl.normal_x;
+        d->line_normal_z[i] = fl.normal_z;
+        d->line_min_x[i] = fl.min_x;
+        d->line_min_z[i] = fl.min_z;
+        d->line_max_x[i] = fl.max_x;
+        d->line_max_z[i] = fl.max_z;
+    }
+    return 1;
+}
+
+static int level_decode_zones(const LevelState *level, LevelDecoded *d)
+{
+    int slots = level_zone_slot_count(level);
+    size_t zn = (slots > 0) ? (size_t)slots : 0u;
+    int32_t used = 0;
+    uint8_t *links;
+
+    d->zone_off = (int32_t *)malloc((zn + 1u) * sizeof(int32_t));
+    d->zone_exit_first = (int32_t *)malloc((zn + 1u) * sizeof(int32_t));
+    d->zone_exits = (int16_t *)malloc((zn + 1u) * LEVEL_EXIT_LIST_MAX * sizeof(int16_t));
+    d->zone_neighbor_first = (int32_t *)malloc((zn + 1u) * sizeof(int32_t));
+    /* Neighbours are unique zones other than self: at most slots-1 each. */
+    d->zone_neighbors = (int16_t *)malloc((zn * zn + 1u) * sizeof(int16_t));
+    links = (uint8_t *)calloc(zn * zn + 1u, 1);
+    if (!d->zone_off || !d->zone_exit_first || !d->zone_exits ||
+        !d->zone_neighbor_first || !d->zone_neighbors || !links) {
+        free(links);
+        return 0;
+    }
+
+    d->num_zone_slots = (int32_t)zn;
+    for (size_t z = 0; z < zn; z++) {
+        const uint8_t *list = level->zone_adds ? level_zone_exit_list_raw(level, (int)z) : NULL;
+        d->zone_exit_first[z] = used;
+        d->zone_off[z] = -1;
+        if (!list) continue;
+        d->zone_off[z] = read_long(level->zone_adds + z * 4u);
+        used += level_copy_exit_list(list, d->zone_exits + used);
+    }
+    d->zone_exit_first[zn] = used;
+
+    /* links[src * zn + dst]: an exit of src (before the -1) connects to dst. */
+    for (size_t z = 0; z < zn; z++) {
+        for (int32_t i = d->zone_exit_first[z]; i < d->zone_exit_first[z + 1]; i++) {
+            int16_t entry = d->zone_exits[i];
+            if (entry < 0) break;
+            if ((int32_t)entry >= d->num_floor_lines) continue;
+            {
+                int cz = d->line_connect_zone[entry];
+                if (cz >= 0 && (size_t)cz < zn) links[z * zn + (size_t)cz] = 1;
+            }
+        }
+    }
+
+    used = 0;
+    for (size_t z = 0; z < zn; z++) {
+        int32_t first = used;
+        d->zone_neighbor_first[z] = first;
+        for (int32_t i = d->zone_exit_first[z]; i < d->zone_exit_first[z + 1]; i++) {
+            int16_t entry = d->zone_exits[i];
+            int cz;
+            int dup = 0;
+            if (entry < 0) break;
+            if ((int32_t)entry >= d->num_floor_lines) continue;
+            cz = d->line_connect_zone[entry];
+            if (cz < 0 || (size_t)cz >= zn || (size_t)cz == z) continue;
+            for (int32_t j = first; j < used; j++) {
+                if (d->zone_neighbors[j] == cz) { dup = 1; break; }
+            }
+            if (!dup) d->zone_neighbors[used++] = (int16_t)cz;
+        }
+        /* Reverse links, so one-way connect data still joins both zones. */
+        for (size_t src = 0; src < zn; src++) {
+            int dup = 0;
+            if (src == z || !links[src * zn + z]) continue;
+            for (int32_t j = first; j < used; j++) {
+                if (d->zone_neighbors[j] == (int16_t)src) { dup = 1; break; }
+            }
+            if (!dup) d->zone_neighbors[used++] = (int16_t)src;
+        }
+    }
+    d->zone_neighbor_first[zn] = used;
+    free(links);
+    return 1;
+}
+
+static int level_gfx_stream_cmp(const void *a, const void *b)
+{
+    uint32_t x = ((const LevelGfxStream *)a)->gfx_off;
+    uint32_t y = ((const LevelGfxStream *)b)->gfx_off;
+    return (x > y) - (x < y);
+}
+
+/* Tokenize one stream with the renderer's scan rules: stop at a negative
+ * type, after LEVEL_GFX_STREAM_MAX entries, or after an unknown type (kept
+ * as the last token). */
+static int32_t level_tokenize_gfx_stream(const LevelState *level, uint32_t gfx_off,
+                                         LevelGfxToken *out, uint32_t *out_mask)
+{
+    size_t cap = level->graphics_byte_count;
+    size_t pos = (size_t)gfx_off + 2u;
+    int32_t n = 0;
+    uint32_t mask = 0;
+
+    for (int iter = 0; iter < LEVEL_GFX_STREAM_MAX; iter++) {
+        int16_t t;
+        size_t skip;
+        if (cap > 0 && pos + 2u > cap) break;
+        t = read_word(level->graphics + pos);
+        pos += 2u;
+        if (t < 0) break;
+        if (cap > 0 && pos + 4u > cap && t != 3 && t != 12) break;
+
+        out[n].type = t;
+        out[n].sides = 0;
+        out[n].off = (uint32_t)pos;
+        if (t < 32) mask |= 1u << t;
+        skip = level_gfx_entry_payload_size(t, level->graphics + pos);
+        if (skip == 0) {
+            n++;
+            if (t != 3 && t != 12) break;
+            continue;
+        }
+        if (t == 1 || t == 2 || (t >= 7 && t <= 11))
+            out[n].sides = (int16_t)((skip - 12u) / 2u);
+        n++;
+        pos += skip;
+    }
+    *out_mask = mask;
+    return n;
+}
+
+static int level_decode_gfx(const LevelState *level, LevelDecoded *d)
+{
+    int32_t entries = 0;
+    int32_t ns = 0;
+    int32_t nt = 0;
+
+    if (!level->zone_graph_adds || !level->graphics) return 1;
+
+    entries = (level->num_zone_graph_entries > 0) ? level->num_zone_graph_entries
+                                                  : (int32_t)level_zone_slot_count(level);
+    if (entries <= 0) return 1;
+
+    d->graph_zone_id = (int32_t *)malloc((size_t)entries * sizeof(int32_t));
+    d->gfx_streams = (LevelGfxStream *)malloc((size_t)entries * 2u * sizeof(LevelGfxStream));
+    d->gfx_tokens = (LevelGfxToken *)malloc((size_t)entries * 2u * LEVEL_GFX_STREAM_MAX *
+                                            sizeof(LevelGfxToken));
+    if (!d->graph_zone_id || !d->gfx_streams || !d->gfx_tokens) return 0;
+
+    d->num_graph_entries = entries;
+    for (int32_t e = 0; e < entries; e++) {
+        const uint8_t *zg = level->zone_graph_adds + (size_t)e * 8u;
+        for (int k = 0; k < 2; k++) {
+            int32_t off = read_long(zg + (size_t)k * 4u);
+            int dup = 0;
+
+            if (k == 0) {
+                /* Same bound as the LGR entry resolvers (offset read unsigned). */
+                uint32_t uoff = (uint32_t)off;
+                if (level->graphics_byte_count > 0 && (size_t)uoff + 2u > level->graphics_byte_count)
+                    d->graph_zone_id[e] = LEVEL_GRAPH_ZONE_NONE;
+                else
+                    d->graph_zone_id[e] = read_word(level->graphics + uoff);
+            }
+            if (off <= 0) continue;
+            if (level->graphics_byte_count > 0 && (size_t)off + 2u > level->graphics_byte_count)
+                continue;
+            for (int32_t s = 0; s < ns; s++) {
+                if (d->gfx_streams[s].gfx_off == (uint32_t)off) { dup = 1; break; }
+            }
+            if (dup) continue;
+
+            d->gfx_streams[ns].gfx_off = (uint32_t)off;
+            d->gfx_streams[ns].first = nt;
+            d->gfx_streams[ns].count =
+                level_tokenize_gfx_stream(level, (uint32_t)off, d->gfx_tokens + nt,
+                                          &d->gfx_streams[ns].type_mask);
+            nt += d->gfx_streams[ns].count;
+            ns++;
+        }
+    }
+    qsort(d->gfx_streams, (size_t)ns, sizeof(LevelGfxStream), level_gfx_stream_cmp);
+    d->num_gfx_streams = ns;
+
+    /* Give back the worst-case reservation. */
+    if (nt > 0) {
+        LevelGfxToken *shrunk = (LevelGfxToken *)realloc(d->gfx_tokens, (size_t)nt * sizeof(LevelGfxToken));
+        if (shrunk) d->gfx_tokens = shrunk;
+    }
+    return 1;
+}
+
+static int level_decode_connects(const LevelState *level, LevelDecoded *d)
+{
+    int32_t n = d->num_zone_slots;
+    int16_t *table;
+
+    /* Connect words are zone id words, or slot indices for the ObjectMove fallback. */
+    for (int32_t z = 0; z < d->num_zone_slots; z++) {
+        int32_t zoff = d->zone_off[z];
+        int16_t id;
+        if (zoff < 0) continue;
+        id = read_word(level->data + zoff);
+        if (id >= n) n = (int32_t)id + 1;
+    }
+    if (n <= 0) return 1;
+    table = (int16_t *)malloc((size_t)n * sizeof(int16_t));
+    if (!table) return 0;
+    for (int32_t c = 0; c < n; c++)
+        table[c] = (int16_t)level_connect_to_zone_index(level, (int16_t)c);
+    d->connect_zone = table;
+    d->num_connect = n;
+    return 1;
+}
+
+/* Same walk as order_zones_gather (visibility.c) with the list bounded by
+ * level->data. A list that runs off the data drops the whole PVS, so every
+ * zone falls back to the runtime walk. */
+static int level_decode_pvs(const LevelState *level, LevelDecoded *d)
+{
+    int32_t slots = d->num_zone_slots;
+    int32_t cap = slots * 16 + 256;
+    int32_t n = 0;
+    uint8_t seen[256];
+    int16_t *pvs;
+    uint32_t *gate;
+
+    d->zone_pvs_first = (int32_t *)malloc(((size_t)slots + 1u) * sizeof(int32_t));
+    pvs = (int16_t *)malloc((size_t)cap * sizeof(int16_t));
+    gate = (uint32_t *)malloc((size_t)cap * sizeof(uint32_t));
+    if (!d->zone_pvs_first || !pvs || !gate) {
+        free(pvs);
+        free(gate);
+        return 0;
+    }
+
+    for (int32_t z = 0; z < slots; z++) {
+        int32_t zoff = d->zone_off[z];
+        int32_t first = n;
+        int unique = 0;
+
+        d->zone_pvs_first[z] = n;
+        if (zoff < 0) continue;
+        memset(seen, 0, sizeof(seen));
+        for (size_t pos = (size_t)zoff + 48u; unique < 256; pos += 8u) {
+            int16_t entry_word;
+            int32_t zid;
+
+            if (level->data_byte_count > 0 && pos + 8u > level->data_byte_count) goto truncated;
+            entry_word = read_word(level->data + pos);
+            if (entry_word < 0) break;
+            if (level->zone_graph_adds && level->graphics) {
+                if (level->num_zone_graph_entries > 0 && entry_word >= level->num_zone_graph_entries)
+                    continue;
+                if (entry_word < d->num_graph_entries) {
+                    zid = d->graph_zone_id[entry_word];
+                    if (zid == LEVEL_GRAPH_ZONE_NONE) continue;
+                } else {
+                    uint32_t gfx_off = (uint32_t)read_long(level->zone_graph_adds + (size_t)entry_word * 8u);
+                    if (level->graphics_byte_count > 0 && (size_t)gfx_off + 2u > level->graphics_byte_count)
+                        continue;
+                    zid = read_word(level->graphics + gfx_off);
+                }
+            } else {
+                zid = entry_word;
+            }
+            if (zid < 0 || zid >= 256 || zid >= slots) continue;
+            if (seen[zid]) {
+                for (int32_t i = first; i < n; i++) {
+                    if (pvs[i] == zid) { gate[i] |= (uint32_t)read_long(level->data + pos + 4); break; }
+                }
+                continue;
+            }
+            if (n == cap) {
+                int16_t *gp;
+                uint32_t *gg;
+                cap *= 2;
+                gp = (int16_t *)realloc(pvs, (size_t)cap * sizeof(int16_t));
+                if (gp) pvs = gp;
+                gg = (uint32_t *)realloc(gate, (size_t)cap * sizeof(uint32_t));
+                if (gg) gate = gg;
+                if (!gp || !gg) goto failed;
+            }
+            seen[zid] = 1;
+            pvs[n] = (int16_t)zid;
+            gate[n] = (uint32_t)read_long(level->data + pos + 4);
+            n++;
+            unique++;
+        }
+    }
+    d->zone_pvs_first[slots] = n;
+    d->zone_pvs = pvs;
+    d->zone_pvs_gate = gate;
+    return 1;
+
+truncated:
+    printf("[LEVEL] Decoded view: a ListOfGraphRooms runs past the level data, no PVS\n");
+failed:
+    free(d->zone_pvs_first);
+    d->zone_pvs_first = NULL;
+    free(pvs);
+    free(gate);
+    return 1;
+}
+
+const int16_t *level_graph_room_pvs(const LevelState *level, const uint8_t *list_of_graph_rooms,
+                                    const uint32_t **out_gate, int *out_count)
+{
+    const LevelDecoded *d = level ? level->decoded : NULL;
+    int32_t zoff;
+    int z;
+
+    if (!d || !d->zone_pvs || !list_of_graph_rooms || list_of_graph_rooms < level->data + 48)
+        return NULL;
+    zoff = (int32_t)(list_of_graph_rooms - level->data - 48);
+    z = level_zone_index_from_room_offset(level, zoff);
+    if (z < 0 || z >= d->num_zone_slots || d->zone_off[z] != zoff) return NULL;
+    *out_gate = d->zone_pvs_gate + d->zone_pvs_first[z];
+    *out_count = (int)(d->zone_pvs_first[z + 1] - d->zone_pvs_first[z]);
+    return d->zone_pvs + d->zone_pvs_first[z];
+}
+
+void level_build_decoded(LevelState *level)
+{
+    LevelDecoded *d;
+
+    if (!level) return;
+    level_free_decoded(level);
+    if (!level->data || !level->floor_lines || level->num_floor_lines <= 0) return;
+
+    d = (LevelDecoded *)calloc(1, sizeof(LevelDecoded));
+    if (!d) return;
+    level->decoded = d;
+    if (!level_decode_lines_and_points(level, d) || !level_decode_zones(level, d) ||
+        !level_decode_gfx(level, d) || !level_decode_connects(level, d) ||
+        !level_decode_pvs(level, d)) {
+        printf("[LEVEL] Decoded view: allocation failed, using raw level data\n");
+        level_free_decoded(level);
+        return;
+    }
+    printf("[LEVEL] Decoded view: %d points, %d floor lines, %d zones (%d exit entries), %d gfx streams (%d tokens)\n",
+           (int)d->num_points, (int)d->num_floor_lines, (int)d->num_zone_slots,
+           (int)d->zone_exit_first[d->num_zone_slots], (int)d->num_gfx_streams,
+           d->num_gfx_streams > 0
+               ? (int)(d->gfx_streams[d->num_gfx_streams - 1].first + d->gfx_streams[d->num_gfx_streams - 1].count)
+               : 0);
+}
+
+const int16_t *level_room_exit_list(const LevelState *level, const uint8_t *zone_data,
+                                    int16_t *scratch, int *out_count)
+{
+    const LevelDecoded *d = level->decoded;
+
+    if (d) {
+        int z = level_zone_index_from_room_ptr(level, zone_data);
+        if (z >= 0 && z < d->num_zone_slots && d->zone_off[z] == (int32_t)(zone_data - level->data)) {
+            *out_count = (int)(d->zone_exit_first[z + 1] - d->zone_exit_first[z]);
+            return d->zone_exits + d->zone_exit_first[z];
+        }
+    }
+    *out_count = level_copy_exit_list(zone_data + read_word(zone_data + 32), scratch);
+    return scratch;
+}
+
+const LevelGfxStream *level_gfx_stream(const LevelState *level, const uint8_t *gfx_data)
+{
+    const LevelDecoded *d = level ? level->decoded : NULL;
+    uint32_t off;
+    int32_t lo = 0, hi;
+
+    if (!d || !gfx_data || !level->graphics || gfx_data < level->graphics) return NULL;
+    off = (uint32_t)(gfx_data - level->graphics);
+    hi = d->num_gfx_streams - 1;
+    while (lo <= hi) {
+        int32_t mid = (lo + hi) >> 1;
+        uint32_t m = d->gfx_streams[mid].gfx_off;
+        if (m == off) return &d->gfx_streams[mid];
+        if (m < off) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return NULL;
+}
+
 static int point_on_segment_i32(int32_t px, int32_t pz,
                                 int32_t x1, int32_t z1,
                                 int32_t x2, int32_t z2)
@@ -1107,69 +1692,223 @@ static int point_on_segment_i32(int32_t px, int32_t pz,
     return 1;
 }
 
-static int zone_contains_point(const LevelState *level, int zone_index, int32_t x, int32_t z)
+/* Edge list (ZoneData+32) of zone_index for the point-in-zone test: entries
+ * usable before the end of level->data, capped at 256. NULL if none. */
+static const uint8_t *zone_edge_list(const LevelState *level, int zone_index, int *out_max)
 {
     if (!level || !level->data || !level->zone_adds || !level->floor_lines)
-        return 0;
+        return NULL;
     if (zone_index < 0 || zone_index >= level_zone_slot_count(level))
+        return NULL;
+
+    int32_t zoff = read_long(level->zone_adds + (size_t)zone_index * 4u);
+    if (zoff < 0)
+        return NULL;
+
+    size_t data_len = level->data_byte_count;
+    if (data_len != 0 && (size_t)zoff + 34u > data_len)
+        return NULL;
+
+    const uint8_t *zd = level->data + zoff;
+    int16_t list_off = read_word(zd + 32);
+    int64_t list_abs = (int64_t)zoff + (int64_t)list_off;
+    if (list_abs < 0)
+        return NULL;
+    if (data_len != 0 && (size_t)list_abs + 2u > data_len)
+        return NULL;
+
+    *out_max = 256;
+    if (data_len != 0 && (data_len - (size_t)list_abs) / 2u < 256u)
+        *out_max = (int)((data_len - (size_t)list_abs) / 2u);
+    return level->data + (size_t)list_abs;
+}
+
+static int zone_contains_point(const LevelState *level, int zone_index, int32_t x, int32_t z)
+{
+    int max_entries = 0;
+    const uint8_t *list = zone_edge_list(level, zone_index, &max_entries);
+    int inside = 0;
+    int edges = 0;
+
+    if (!list)
         return 0;
 
-    {
-        int32_t zoff = read_long(level->zone_adds + (size_t)zone_index * 4u);
-        if (zoff < 0)
-            return 0;
+    for (int i = 0; i < max_entries; i++) {
+        int16_t entry = read_word(list + i * 2);
+        if (entry == -2)
+            break;
+        if (entry < 0)
+            continue; /* -1 separator between exits and wall list */
+        if (entry >= level->num_floor_lines)
+            continue;
 
-        size_t data_len = level->data_byte_count;
-        if (data_len != 0 && (size_t)zoff + 34u > data_len)
-            return 0;
+        const uint8_t *fl = level->floor_lines + (size_t)entry * 16u;
+        int32_t x1 = read_word(fl + 0);
+        int32_t z1 = read_word(fl + 2);
+        int32_t x2 = x1 + read_word(fl + 4);
+        int32_t z2 = z1 + read_word(fl + 6);
+        edges++;
 
-        const uint8_t *zd = level->data + zoff;
-        int16_t list_off = read_word(zd + 32);
-        int64_t list_abs = (int64_t)zoff + (int64_t)list_off;
-        if (list_abs < 0)
-            return 0;
-        if (data_len != 0 && (size_t)list_abs + 2u > data_len)
-            return 0;
+        if (point_on_segment_i32(x, z, x1, z1, x2, z2))
+            return 1;
 
-        const uint8_t *list = level->data + (size_t)list_abs;
-        int inside = 0;
-        int edges = 0;
+        if ((z1 > z) != (z2 > z)) {
+            int64_t dz = (int64_t)z2 - (int64_t)z1;
+            int64_t lhs = (int64_t)(x - x1) * dz;
+            int64_t rhs = (int64_t)(x2 - x1) * (int64_t)(z - z1);
+            if ((dz > 0 && lhs < rhs) || (dz < 0 && lhs > rhs))
+                inside ^= 1;
+        }
+    }
 
-        for (int i = 0; i < 256; i++) {
-            if (data_len != 0 && (size_t)(list - level->data) + (size_t)i * 2u + 2u > data_len)
-                break;
+    if (edges == 0)
+        return 0;
+    return inside;
+}
 
-            int16_t entry = read_word(list + i * 2);
-            if (entry == -2)
-                break;
-            if (entry < 0)
-                continue; /* -1 separator between exits and wall list */
-            if (entry >= level->num_floor_lines)
-                continue;
+/* Bounding box of the edges zone_contains_point tests; 0 when it has none
+ * (such a zone never contains a point). */
+static int zone_edge_bounds(const LevelState *level, int zone_index,
+                            int32_t *min_x, int32_t *min_z, int32_t *max_x, int32_t *max_z)
+{
+    int max_entries = 0;
+    const uint8_t *list = zone_edge_list(level, zone_index, &max_entries);
+    int edges = 0;
 
-            const uint8_t *fl = level->floor_lines + (size_t)entry * 16u;
-            int32_t x1 = read_word(fl + 0);
-            int32_t z1 = read_word(fl + 2);
-            int32_t x2 = x1 + read_word(fl + 4);
-            int32_t z2 = z1 + read_word(fl + 6);
-            edges++;
-
-            if (point_on_segment_i32(x, z, x1, z1, x2, z2))
-                return 1;
-
-            if ((z1 > z) != (z2 > z)) {
-                int64_t dz = (int64_t)z2 - (int64_t)z1;
-                int64_t lhs = (int64_t)(x - x1) * dz;
-                int64_t rhs = (int64_t)(x2 - x1) * (int64_t)(z - z1);
-                if ((dz > 0 && lhs < rhs) || (dz < 0 && lhs > rhs))
-                    inside ^= 1;
-            }
+    if (!list)
+        return 0;
+
+    for (int i = 0; i < max_entries; i++) {
+        int16_t entry = read_word(list + i * 2);
+        if (entry == -2)
+            break;
+        if (entry < 0 || entry >= level->num_floor_lines)
+            continue;
+
+        const uint8_t *fl = level->floor_lines + (size_t)entry * 16u;
+        int32_t x1 = read_word(fl + 0);
+        int32_t z1 = read_word(fl + 2);
+        int32_t x2 = x1 + read_word(fl + 4);
+        int32_t z2 = z1 + read_word(fl + 6);
+        if (edges++ == 0) {
+            *min_x = *max_x = x1;
+            *min_z = *max_z = z1;
         }
+        if (x1 < *min_x) *min_x = x1;
+        if (x1 > *max_x) *max_x = x1;
+        if (x2 < *min_x) *min_x = x2;
+        if (x2 > *max_x) *max_x = x2;
+        if (z1 < *min_z) *min_z = z1;
+        if (z1 > *max_z) *max_z = z1;
+        if (z2 < *min_z) *min_z = z2;
+        if (z2 > *max_z) *max_z = z2;
+    }
+    return edges > 0;
+}
 
-        if (edges == 0)
-            return 0;
-        return inside;
+void level_free_zone_grid(LevelState *level)
+{
+    if (!level || !level->zone_grid) return;
+    free(level->zone_grid->cell_first);
+    free(level->zone_grid->cell_zones);
+    free(level->zone_grid);
+    level->zone_grid = NULL;
+}
+
+void level_build_zone_grid(LevelState *level)
+{
+    LevelZoneGrid *g;
+    int32_t *bmin_x = NULL, *bmin_z = NULL, *bmax_x = NULL, *bmax_z = NULL;
+    int32_t lo_x = INT32_MAX, lo_z = INT32_MAX, hi_x = INT32_MIN, hi_z = INT32_MIN;
+    int32_t used = 0;
+    int slots, shift, zones_with_edges = 0;
+    size_t cells;
+
+    if (!level) return;
+    level_free_zone_grid(level);
+    slots = level_zone_slot_count(level);
+    if (!level->data || !level->zone_adds || !level->floor_lines || slots <= 0) return;
+
+    g = (LevelZoneGrid *)calloc(1, sizeof(LevelZoneGrid));
+    bmin_x = (int32_t *)malloc((size_t)slots * sizeof(int32_t));
+    bmin_z = (int32_t *)malloc((size_t)slots * sizeof(int32_t));
+    bmax_x = (int32_t *)malloc((size_t)slots * sizeof(int32_t));
+    bmax_z = (int32_t *)malloc((size_t)slots * sizeof(int32_t));
+    if (!g || !bmin_x || !bmin_z || !bmax_x || !bmax_z) goto failed;
+
+    for (int zi = 0; zi < slots; zi++) {
+        if (!zone_edge_bounds(level, zi, &bmin_x[zi], &bmin_z[zi], &bmax_x[zi], &bmax_z[zi])) {
+            bmin_x[zi] = 1;
+            bmax_x[zi] = 0; /* empty: never a candidate */
+            continue;
+        }
+        zones_with_edges++;
+        if (bmin_x[zi] < lo_x) lo_x = bmin_x[zi];
+        if (bmin_z[zi] < lo_z) lo_z = bmin_z[zi];
+        if (bmax_x[zi] > hi_x) hi_x = bmax_x[zi];
+        if (bmax_z[zi] > hi_z) hi_z = bmax_z[zi];
+    }
+    if (zones_with_edges == 0) goto failed;
+
+    /* Coarsen 256-unit cells until the table stays small. */
+    shift = LEVEL_ZONE_GRID_MIN_SHIFT;
+    for (;;) {
+        g->cols = ((hi_x - lo_x) >> shift) + 1;
+        g->rows = ((hi_z - lo_z) >> shift) + 1;
+        if ((int64_t)g->cols * g->rows <= LEVEL_ZONE_GRID_MAX_CELLS) break;
+        shift++;
+    }
+    g->shift = shift;
+    g->min_x = lo_x;
+    g->min_z = lo_z;
+    cells = (size_t)g->cols * (size_t)g->rows;
+
+    /* A zone is a candidate for every cell in its z rows from the left edge
+     * of the grid to its max x: the even-odd test counts edge crossings to
+     * the right of the point, and exit lists are not always closed loops, so
+     * points left of a zone's box can still test inside and the grid has to
+     * give the same answer as the linear scan. Count, prefix-sum, then fill;
+     * zones go in ascending slot order so a cell's candidates are tested in
+     * the order the linear scan used. */
+    g->cell_first = (int32_t *)calloc(cells + 1u, sizeof(int32_t));
+    if (!g->cell_first) goto failed;
+    for (int zi = 0; zi < slots; zi++) {
+        if (bmin_x[zi] > bmax_x[zi]) continue;
+        for (int32_t cz = (bmin_z[zi] - lo_z) >> shift; cz <= (bmax_z[zi] - lo_z) >> shift; cz++)
+            for (int32_t cx = 0; cx <= (bmax_x[zi] - lo_x) >> shift; cx++)
+                g->cell_first[(size_t)cz * (size_t)g->cols + (size_t)cx + 1u]++;
+    }
+    for (size_t c = 0; c < cells; c++)
+        g->cell_first[c + 1u] += g->cell_first[c];
+    g->cell_zones = (int16_t *)malloc((size_t)g->cell_first[cells] * sizeof(int16_t) + 1u);
+    if (!g->cell_zones) goto failed;
+    {
+        int32_t *fill = (int32_t *)malloc(cells * sizeof(int32_t));
+        if (!fill) goto failed;
+        memcpy(fill, g->cell_first, cells * sizeof(int32_t));
+        for (int zi = 0; zi < slots; zi++) {
+            if (bmin_x[zi] > bmax_x[zi]) continue;
+            for (int32_t cz = (bmin_z[zi] - lo_z) >> shift; cz <= (bmax_z[zi] - lo_z) >> shift; cz++)
+                for (int32_t cx = 0; cx <= (bmax_x[zi] - lo_x) >> shift; cx++)
+                    g->cell_zones[fill[(size_t)cz * (size_t)g->cols + (size_t)cx]++] = (int16_t)zi;
+        }
+        free(fill);
+    }
+    used = g->cell_first[cells];
+
+    free(bmin_x); free(bmin_z); free(bmax_x); free(bmax_z);
+    level->zone_grid = g;
+    printf("[LEVEL] Zone grid: %dx%d cells of %d units, %d zones, %d entries\n",
+           (int)g->cols, (int)g->rows, 1 << shift, zones_with_edges, (int)used);
+    return;
+
+failed:
+    if (g) {
+        free(g->cell_first);
+        free(g->cell_zones);
+        free(g);
     }
+    free(bmin_x); free(bmin_z); free(bmax_x); free(bmax_z);
 }
 
 int level_find_zone_for_point(const LevelState *level, int32_t x, int32_t z, int16_t hint_zone)
@@ -1179,6 +1918,7 @@ int level_find_zone_for_point(const LevelState *level, int32_t x, int32_t z, int
 
     {
         int zone_slots = level_zone_slot_count(level);
+        const LevelZoneGrid *g = level->zone_grid;
         if (zone_slots <= 0)
             return -1;
 
@@ -1191,6 +1931,24 @@ int level_find_zone_for_point(const LevelState *level, int32_t x, int32_t z, int
                 return hint;
         }
 
+        if (g) {
+            int32_t cx = x - g->min_x, cz = z - g->min_z;
+            if (cz < 0) return -1;
+            cx = (cx < 0) ? 0 : (cx >> g->shift);
+            cz >>= g->shift;
+            if (cx >= g->cols || cz >= g->rows) return -1;
+            {
+                size_t c = (size_t)cz * (size_t)g->cols + (size_t)cx;
+                for (int32_t i = g->cell_first[c]; i < g->cell_first[c + 1u]; i++) {
+                    int zi = g->cell_zones[i];
+                    if (zi == hint || zi >= zone_slots) continue;
+                    if (zone_contains_point(level, zi, x, z))
+                        return zi;
+                }
+            }
+            return -1;
+        }
+
         for (int zi = 0; zi < zone_slots; zi++) {
             if (zi == hint) continue;
             if (zone_contains_point(level, zi, x, z))
@@ -1453,35 +2211,6 @@ ZoneInfo zone_info_swap_endianness(const ZoneInfo *z)
     return out;
 }
 
-/* Payload bytes after type word in zone graphics stream (matches renderer zone_gfx_entry_data_skip). */
-static size_t zone_gfx_payload_skip(int16_t entry_type, const uint8_t *data)
-{
-    switch (entry_type) {
-    case 0:
-    case 13: return 28;
-    case 3:
-    case 12: return 0;
-    case 4: return 2;
-    case 5: return 28;
-    case 6: return 4;
-    case 1:
-    case 2:
-    case 7:
-    case 8:
-    case 9:
-    case 10:
-    case 11:
-    {
-        int16_t nsm1 = read_word(data + 2);
-        int sides = (int)nsm1 + 1;
-        if (sides < 0) sides = 0;
-        if (sides > 100) sides = 100;
-        return (size_t)(4 + 2 * sides + 10);
-    }
-    default: return 0;
-    }
-}
-
 static int level_find_zone_slot_by_id_word(const LevelState *level, int16_t zone_id_word)
 {
     if (!level || !level->zone_adds || !level->data) return -1;
@@ -1567,7 +2296,7 @@ static AB3D_ATTR_UNUSED int level_patch_zone_wall_yoff(LevelState *level,
         if (t < 0)
             break;
 
-        size_t skip = zone_gfx_payload_skip(t, ptr);
+        size_t skip = level_gfx_entry_payload_size(t, ptr);
         if (ptr + skip > gend)
             break;
 
@@ -1639,7 +2368,7 @@ static AB3D_ATTR_UNUSED int level_patch_all_lower_zone_walls_yoff(LevelState *le
             if (t < 0)
                 break;
 
-            size_t skip = zone_gfx_payload_skip(t, ptr);
+            size_t skip = level_gfx_entry_payload_size(t, ptr);
             if (ptr + skip > gend)
                 break;
 
@@ -1813,7 +2542,7 @@ static void log_gfx_poly_stream(const char *which,
             printf("[ZONELOG]     [%d] END (type=%d)\n", iter - 1, (int)t);
             break;
         }
-        size_t skip = zone_gfx_payload_skip(t, ptr);
+        size_t skip = level_gfx_entry_payload_size(t, ptr);
         if (ptr + skip > gend) {
             printf("[ZONELOG]     [%d] type=%d TRUNCATED (need %zu bytes)\n",
                    iter - 1, (int)t, skip);
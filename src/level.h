@@ -113,9 +113,172 @@ int level_connect_to_zone_index(const LevelState *level, int16_t connect);
 int level_zone_index_from_room_ptr(const LevelState *level, const uint8_t *room_ptr);
 int level_zone_index_from_room_offset(const LevelState *level, int32_t room_offset);
 
+/* -----------------------------------------------------------------------
+ * Decoded level view
+ *
+ * level_parse decodes everything in the level that nothing writes at run
+ * time into native-endian arrays: points, floor lines (with the connect word
+ * already resolved to a zone slot), each zone's exit list and connected
+ * zones, and a token list per zone graphics stream. It is read-only after
+ * the build, so the renderer workers, movement and visibility code share it
+ * without per-thread lookup caches.
+ *
+ * Zone heights and brightness, floor line touch flags (+14) and door/lift
+ * wall records are rewritten every frame and stay in the raw data.
+ * ----------------------------------------------------------------------- */
+#define LEVEL_EXIT_LIST_MAX     128   /* entries scanned per zone exit list */
+#define LEVEL_GFX_STREAM_MAX    500   /* entries scanned per graphics stream */
+#define LEVEL_GRAPH_ZONE_NONE   INT32_MIN
+
+typedef struct {
+    int16_t x, z, xlen, zlen, length;
+    int16_t connect;           /* raw connect word */
+    int16_t connect_zone;      /* level_connect_to_zone_index(connect) */
+    int8_t  normal_x, normal_z;
+    int32_t target_off;        /* zone_adds[connect_zone] when in range, else 0 */
+    int32_t min_x, min_z, max_x, max_z;
+} LevelFloorLine;
+
+/* One graphics stream entry: type word and offset of its payload (the
+ * bytes after the type word) in level->graphics. */
+typedef struct {
+    int16_t  type;
+    int16_t  sides;            /* polygon entries: clamped side count, else 0 */
+    uint32_t off;
+} LevelGfxToken;
+
+typedef struct {
+    uint32_t gfx_off;          /* stream start (zone id word) in level->graphics */
+    uint32_t type_mask;        /* bit t set when type t (< 32) occurs */
+    int32_t  first;            /* into LevelDecoded.gfx_tokens */
+    int32_t  count;
+} LevelGfxStream;
+
+typedef struct LevelDecoded {
+    int32_t   num_points;
+    int16_t  *point_x;
+    int16_t  *point_z;
+
+    /* Floor lines, one array per field. */
+    int32_t   num_floor_lines;
+    int16_t  *line_x, *line_z, *line_xlen, *line_zlen, *line_length, *line_connect;
+    int16_t  *line_connect_zone;
+    int32_t  *line_target_off;
+    int8_t   *line_normal_x, *line_normal_z;
+    int32_t  *line_min_x, *line_min_z, *line_max_x, *line_max_z;
+
+    /* Zones, by zone_adds slot. zone_off is -1 for slots whose data or exit
+     * list lies outside level->data; those have no exits or neighbours. */
+    int32_t   num_zone_slots;
+    int32_t  *zone_off;
+    int32_t  *zone_exit_first;     /* [slots + 1] ranges into zone_exits */
+    int16_t  *zone_exits;          /* exit list incl. -1 separator and -2 terminator */
+    int32_t  *zone_neighbor_first; /* [slots + 1] ranges into zone_neighbors */
+    int16_t  *zone_neighbors;      /* exit targets in list order, then zones linking here */
+
+    /* Zone graphics: zone id word per zone_graph_adds entry, and the
+     * tokenized streams sorted by gfx_off. */
+    int32_t   num_graph_entries;
+    int32_t  *graph_zone_id;       /* LEVEL_GRAPH_ZONE_NONE: stream out of range */
+    int32_t   num_gfx_streams;
+    LevelGfxStream *gfx_streams;
+    LevelGfxToken  *gfx_tokens;
+
+    /* level_connect_to_zone_index for connect words 0..num_connect-1. */
+    int32_t   num_connect;
+    int16_t  *connect_zone;
+
+    /* Potentially visible set per zone slot: its ListOfGraphRooms resolved
+     * to unique zone ids in list order, with the gate long of every entry
+     * naming that zone OR'd together (what order_zones gathers). */
+    int32_t  *zone_pvs_first;      /* [slots + 1] ranges into zone_pvs */
+    int16_t  *zone_pvs;
+    uint32_t *zone_pvs_gate;
+
+    /* Set when the arrays above live in a baked level image (level_bake.h)
+     * rather than in separate allocations. */
+    struct LevelBakeImage *bake;
+} LevelDecoded;
+
+/* (Re)build level->decoded from the current pointers; level_parse calls it
+ * unless it attaches a matching baked image (level_bake.h) instead.
+ * Leaves level->decoded NULL when the level has no floor lines or allocation
+ * fails - every accessor below falls back to the raw data. */
+void level_build_decoded(LevelState *level);
+void level_free_decoded(LevelState *level);
+
+/* Floor line idx (0 <= idx < num_floor_lines). */
+void level_floor_line_decode(const LevelState *level, int32_t idx, LevelFloorLine *out);
+static inline void level_floor_line(const LevelState *level, int32_t idx, LevelFloorLine *out)
+{
+    const LevelDecoded *d = level->decoded;
+    if (!d || idx >= d->num_floor_lines) {
+        level_floor_line_decode(level, idx, out);
+        return;
+    }
+    out->x = d->line_x[idx];
+    out->z = d->line_z[idx];
+    out->xlen = d->line_xlen[idx];
+    out->zlen = d->line_zlen[idx];
+    out->length = d->line_length[idx];
+    out->connect = d->line_connect[idx];
+    out->connect_zone = d->line_connect_zone[idx];
+    out->normal_x = d->line_normal_x[idx];
+    out->normal_z = d->line_normal_z[idx];
+    out->target_off = d->line_target_off[idx];
+    out->min_x = d->line_min_x[idx];
+    out->min_z = d->line_min_z[idx];
+    out->max_x = d->line_max_x[idx];
+    out->max_z = d->line_max_z[idx];
+}
+
+/* Exit list of the zone whose data starts at zone_data: the decoded copy, or
+ * decoded into scratch[LEVEL_EXIT_LIST_MAX] when zone_data is not a known
+ * zone. Ends after the -2 terminator or LEVEL_EXIT_LIST_MAX entries. */
+const int16_t *level_room_exit_list(const LevelState *level, const uint8_t *zone_data,
+                                    int16_t *scratch, int *out_count);
+
+/* PVS of the zone whose ListOfGraphRooms starts at list_of_graph_rooms
+ * (zone data + 48); NULL when that is not a decoded zone's list. */
+const int16_t *level_graph_room_pvs(const LevelState *level, const uint8_t *list_of_graph_rooms,
+                                    const uint32_t **out_gate, int *out_count);
+
+/* Tokenized graphics stream starting at gfx_data, or NULL if not decoded. */
+const LevelGfxStream *level_gfx_stream(const LevelState *level, const uint8_t *gfx_data);
+
+/* Payload bytes after the type word of a zone graphics stream entry; 0 for
+ * payload-less (3, 12) and unknown types. */
+size_t level_gfx_entry_payload_size(int16_t entry_type, const uint8_t *payload);
+
+/* -----------------------------------------------------------------------
+ * Point-in-zone grid
+ *
+ * Uniform XZ grid over the level: each cell lists, in ascending slot order,
+ * the zone slots whose point-in-zone test can pass somewhere in it (the zone's
+ * edge box rows, from the grid's left edge to the box's right edge).
+ * level_find_zone_for_point tests only those candidates instead of every zone. Built once per level
+ * load (after level_parse and the level fixes); read-only afterwards.
+ * ----------------------------------------------------------------------- */
+#define LEVEL_ZONE_GRID_MIN_SHIFT  8      /* 256-unit cells at the finest */
+#define LEVEL_ZONE_GRID_MAX_CELLS  16384  /* coarser cells beyond this */
+
+typedef struct LevelZoneGrid {
+    int32_t  min_x, min_z;     /* world position of cell (0,0) */
+    int32_t  cols, rows;
+    int      shift;            /* cell size = 1 << shift */
+    int32_t *cell_first;       /* [cols * rows + 1] ranges into cell_zones */
+    int16_t *cell_zones;
+} LevelZoneGrid;
+
+/* (Re)build level->zone_grid; leaves it NULL when the level has no zone
+ * edges or allocation fails, and lookups fall back to the linear scan. */
+void level_build_zone_grid(LevelState *level);
+void level_free_zone_grid(LevelState *level);
+
 /*
  * Find which zone contains world point (x,z). hint_zone is optional and tested first.
  * Returns index in range 0..level_zone_slot_count()-1, or -1 if no containing zone is found.
+ * Same result as testing every zone in slot order; uses level->zone_grid when built.
  */
 int level_find_zone_for_point(const LevelState *level, int32_t x, int32_t z, int16_t hint_zone);
 
@@ -185,4 +348,12 @@ void level_assign_clips(LevelState *level, int16_t num_zones);
  */
 void level_apply_level_specific_fixes(LevelState *level, int16_t level_num);
 
+/*
+ * Grow nasty_shot_data to new_slots (capped at NASTY_SHOT_SLOT_MAX), adding
+ * one ObjectPoints entry per new slot. Reallocates nasty_shot_data,
+ * object_points and prev_object_points, so call only between object
+ * updates. Returns 0 on success (or when already that size), -1 otherwise.
+ */
+int level_grow_nasty_shot_pool(LevelState *level, int new_slots);
+
 #endif /* LEVEL_H */
@@ -0,0 +1,516 @@
+/*
+ * Alien Breed 3D I - PC Port
+ * level_bake.c - Baked (precompiled) level images
+ */
+
+#include "level_bake.h"
+#include "level.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "logging.h"
+#define printf ab3d_log_printf
+
+#define LEVEL_BAKE_MAGIC    "AB3DLVB1"
+#define LEVEL_BAKE_VERSION  1u
+#define LEVEL_BAKE_ENDIAN   0x01020304u
+#define LEVEL_BAKE_ALIGN    64u
+
+/* Patches closer than this are merged into one. */
+#define LEVEL_BAKE_PATCH_GAP 8u
+
+enum {
+    BAKE_POINT_X = 1, BAKE_POINT_Z,
+    BAKE_LINE_X, BAKE_LINE_Z, BAKE_LINE_XLEN, BAKE_LINE_ZLEN, BAKE_LINE_LENGTH,
+    BAKE_LINE_CONNECT, BAKE_LINE_CONNECT_ZONE, BAKE_LINE_TARGET_OFF,
+    BAKE_LINE_NORMAL_X, BAKE_LINE_NORMAL_Z,
+    BAKE_LINE_MIN_X, BAKE_LINE_MIN_Z, BAKE_LINE_MAX_X, BAKE_LINE_MAX_Z,
+    BAKE_ZONE_OFF, BAKE_ZONE_EXIT_FIRST, BAKE_ZONE_EXITS,
+    BAKE_ZONE_NEIGHBOR_FIRST, BAKE_ZONE_NEIGHBORS,
+    BAKE_GRAPH_ZONE_ID, BAKE_GFX_STREAMS, BAKE_GFX_TOKENS,
+    BAKE_CONNECT_ZONE, BAKE_PVS_FIRST, BAKE_PVS, BAKE_PVS_GATE,
+    BAKE_ZONE_MAP, BAKE_PATCHES, BAKE_PATCH_BYTES
+};
+
+/* What a section's element count must equal. */
+enum {
+    BAKE_N_POINTS, BAKE_N_LINES, BAKE_N_SLOTS, BAKE_N_SLOTS1,
+    BAKE_N_EXITS, BAKE_N_NEIGHBORS, BAKE_N_GRAPH, BAKE_N_STREAMS, BAKE_N_TOKENS,
+    BAKE_N_CONNECT, BAKE_N_PVS_FIRST, BAKE_N_PVS
+};
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t endian;        /* LEVEL_BAKE_ENDIAN in the writer's byte order */
+    uint32_t header_size;
+    uint32_t section_count;
+    uint64_t source_hash;   /* level_bake_source_hash */
+    uint64_t file_size;
+    int32_t  num_points;
+    int32_t  num_floor_lines;
+    int32_t  num_zone_slots;
+    int32_t  num_graph_entries;
+    int32_t  num_gfx_streams;
+    int32_t  num_connect;
+    int32_t  has_pvs;
+    int32_t  reserved;
+} LevelBakeHeader;
+
+typedef struct {
+    uint32_t id;
+    uint32_t elem_size;
+    uint64_t count;
+    uint64_t offset;        /* from the start of the file, LEVEL_BAKE_ALIGN aligned */
+} LevelBakeSection;
+
+/* Bytes [offset, offset + len) of level->data (target 0) or
+ * level->graphics (1) become patch_bytes[data_off...]. */
+typedef struct {
+    uint32_t target;
+    uint32_t offset;
+    uint32_t len;
+    uint32_t data_off;
+} LevelBakePatch;
+
+/* LevelDecoded arrays, in file order (each *_first before the arrays it ranges). */
+typedef struct {
+    uint32_t id;
+    uint32_t elem_size;
+    size_t   field;         /* offsetof the pointer in LevelDecoded */
+    int      count_kind;
+    int      nullable;      /* empty arrays stay NULL (callers test the pointer) */
+} BakeArrayDesc;
+
+#define BAKE_ARRAY(id, field, kind, nullable) \
+    { id, (uint32_t)sizeof(*((LevelDecoded *)0)->field), offsetof(LevelDecoded, field), kind, nullable }
+
+static const BakeArrayDesc k_bake_arrays[] = {
+    BAKE_ARRAY(BAKE_POINT_X,             point_x,             BAKE_N_POINTS,    0),
+    BAKE_ARRAY(BAKE_POINT_Z,             point_z,             BAKE_N_POINTS,    0),
+    BAKE_ARRAY(BAKE_LINE_X,              line_x,              BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_Z,              line_z,              BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_XLEN,           line_xlen,           BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_ZLEN,           line_zlen,           BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_LENGTH,         line_length,         BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_CONNECT,        line_connect,        BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_CONNECT_ZONE,   line_connect_zone,   BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_TARGET_OFF,     line_target_off,     BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_NORMAL_X,       line_normal_x,       BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_NORMAL_Z,       line_normal_z,       BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_MIN_X,          line_min_x,          BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_MIN_Z,          line_min_z,          BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_MAX_X,          line_max_x,          BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_LINE_MAX_Z,          line_max_z,          BAKE_N_LINES,     0),
+    BAKE_ARRAY(BAKE_ZONE_OFF,            zone_off,            BAKE_N_SLOTS,     0),
+    BAKE_ARRAY(BAKE_ZONE_EXIT_FIRST,     zone_exit_first,     BAKE_N_SLOTS1,    0),
+    BAKE_ARRAY(BAKE_ZONE_EXITS,          zone_exits,          BAKE_N_EXITS,     0),
+    BAKE_ARRAY(BAKE_ZONE_NEIGHBOR_FIRST, zone_neighbor_first, BAKE_N_SLOTS1,    0),
+    BAKE_ARRAY(BAKE_ZONE_NEIGHBORS,      zone_neighbors,      BAKE_N_NEIGHBORS, 0),
+    BAKE_ARRAY(BAKE_GRAPH_ZONE_ID,       graph_zone_id,       BAKE_N_GRAPH,     1),
+    BAKE_ARRAY(BAKE_GFX_STREAMS,         gfx_streams,         BAKE_N_STREAMS,   1),
+    BAKE_ARRAY(BAKE_GFX_TOKENS,          gfx_tokens,          BAKE_N_TOKENS,    1),
+    BAKE_ARRAY(BAKE_CONNECT_ZONE,        connect_zone,        BAKE_N_CONNECT,   1),
+    BAKE_ARRAY(BAKE_PVS_FIRST,           zone_pvs_first,      BAKE_N_PVS_FIRST, 1),
+    BAKE_ARRAY(BAKE_PVS,                 zone_pvs,            BAKE_N_PVS,       1),
+    BAKE_ARRAY(BAKE_PVS_GATE,            zone_pvs_gate,       BAKE_N_PVS,       1),
+};
+#define BAKE_NUM_ARRAYS ((int)(sizeof(k_bake_arrays) / sizeof(k_bake_arrays[0])))
+
+/* Stands in for empty non-nullable arrays. */
+static const int32_t k_bake_empty[2] = { 0, 0 };
+
+static void *bake_get_field(const LevelDecoded *d, const BakeArrayDesc *a)
+{
+    void *p;
+    memcpy(&p, (const char *)d + a->field, sizeof(p));
+    return p;
+}
+
+static void bake_set_field(LevelDecoded *d, const BakeArrayDesc *a, const void *p)
+{
+    memcpy((char *)d + a->field, &p, sizeof(p));
+}
+
+/* Total of a [slots + 1] range array, or -1 when it does not start at 0 and
+ * never decrease. */
+static int64_t bake_range_total(const int32_t *first, int32_t slots)
+{
+    if (!first) return 0;
+    if (first[0] != 0) return -1;
+    for (int32_t z = 0; z < slots; z++) {
+        if (first[z + 1] < first[z]) return -1;
+    }
+    return first[slots];
+}
+
+static int64_t bake_tokens_total(const LevelDecoded *d)
+{
+    int64_t total = 0;
+    if (!d->gfx_streams) return 0;
+    for (int32_t s = 0; s < d->num_gfx_streams; s++) {
+        const LevelGfxStream *st = &d->gfx_streams[s];
+        if (st->first < 0 || st->count < 0) return -1;
+        if ((int64_t)st->first + st->count > total) total = (int64_t)st->first + st->count;
+    }
+    return total;
+}
+
+/* Element count of array a for d; the range arrays it depends on must already be set. */
+static int64_t bake_expected_count(const LevelDecoded *d, const BakeArrayDesc *a, int has_pvs)
+{
+    switch (a->count_kind) {
+    case BAKE_N_POINTS:    return d->num_points;
+    case BAKE_N_LINES:     return d->num_floor_lines;
+    case BAKE_N_SLOTS:     return d->num_zone_slots;
+    case BAKE_N_SLOTS1:    return (int64_t)d->num_zone_slots + 1;
+    case BAKE_N_EXITS:     return bake_range_total(d->zone_exit_first, d->num_zone_slots);
+    case BAKE_N_NEIGHBORS: return bake_range_total(d->zone_neighbor_first, d->num_zone_slots);
+    case BAKE_N_GRAPH:     return d->num_graph_entries;
+    case BAKE_N_STREAMS:   return d->num_gfx_streams;
+    case BAKE_N_TOKENS:    return bake_tokens_total(d);
+    case BAKE_N_CONNECT:   return d->num_connect;
+    case BAKE_N_PVS_FIRST: return has_pvs ? (int64_t)d->num_zone_slots + 1 : 0;
+    case BAKE_N_PVS:       return bake_range_total(d->zone_pvs_first, d->num_zone_slots);
+    default:               return -1;
+    }
+}
+
+/* Structural checks shared by every reader; NULL when base is not a usable bake. */
+static const LevelBakeHeader *bake_header(const uint8_t *base, size_t size)
+{
+    const LevelBakeHeader *h = (const LevelBakeHeader *)base;
+
+    if (!base || size < sizeof(*h)) return NULL;
+    if (memcmp(h->magic, LEVEL_BAKE_MAGIC, sizeof(h->magic)) != 0 ||
+        h->version != LEVEL_BAKE_VERSION || h->endian != LEVEL_BAKE_ENDIAN ||
+        h->header_size != (uint32_t)sizeof(*h) || h->file_size != (uint64_t)size)
+        return NULL;
+    if ((uint64_t)h->section_count * sizeof(LevelBakeSection) > size - sizeof(*h))
+        return NULL;
+    return h;
+}
+
+static const LevelBakeSection *bake_section(const uint8_t *base, uint32_t id)
+{
+    const LevelBakeHeader *h = (const LevelBakeHeader *)base;
+    const LevelBakeSection *sec = (const LevelBakeSection *)(base + sizeof(*h));
+    for (uint32_t i = 0; i < h->section_count; i++) {
+        if (sec[i].id != id) continue;
+        if (sec[i].offset % LEVEL_BAKE_ALIGN != 0 || sec[i].offset > h->file_size ||
+            sec[i].count > (h->file_size - sec[i].offset) / (sec[i].elem_size ? sec[i].elem_size : 1u))
+            return NULL;
+        return &sec[i];
+    }
+    return NULL;
+}
+
+static uint64_t bake_fnv1a(uint64_t h, const uint8_t *p, size_t n)
+{
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+uint64_t level_bake_source_hash(const LevelState *level)
+{
+    uint64_t h = 14695981039346656037ull;
+    uint64_t sizes[3] = { level->data_byte_count, level->graphics_byte_count, level->clips_byte_count };
+
+    h = bake_fnv1a(h, (const uint8_t *)sizes, sizeof(sizes));
+    if (level->data) h = bake_fnv1a(h, level->data, level->data_byte_count);
+    if (level->graphics) h = bake_fnv1a(h, level->graphics, level->graphics_byte_count);
+    if (level->clips) h = bake_fnv1a(h, level->clips, level->clips_byte_count);
+    return h;
+}
+
+int level_bake_header_ok(const uint8_t *base, size_t size, uint64_t source_hash)
+{
+    const LevelBakeHeader *h = bake_header(base, size);
+    return h && h->source_hash == source_hash;
+}
+
+int level_bake_image_owns(const LevelBakeImage *img, const void *p)
+{
+    const uint8_t *b = (const uint8_t *)p;
+    return img && b && b >= img->base && b < img->base + img->size;
+}
+
+void level_bake_image_release(LevelBakeImage *img)
+{
+    if (img && img->release) img->release(img);
+}
+
+int level_bake_attach(LevelState *level, LevelBakeImage *img)
+{
+    const LevelBakeHeader *h;
+    const LevelBakeSection *sec;
+    LevelDecoded *d;
+    int expected_lines = level->floor_lines ? level->num_floor_lines : 0;
+    int expected_points = (level->points && level->num_points > 0) ? level->num_points : 0;
+
+    h = img ? bake_header(img->base, img->size) : NULL;
+    if (!h) return 0;
+    if (h->num_floor_lines != expected_lines || h->num_points != expected_points ||
+        h->num_zone_slots != level_zone_slot_count(level) || h->num_gfx_streams < 0 ||
+        h->num_graph_entries < 0 || h->num_connect < 0) {
+        printf("[LEVEL] Baked image does not match the parsed level, decoding instead\n");
+        return 0;
+    }
+
+    d = (LevelDecoded *)calloc(1, sizeof(LevelDecoded));
+    if (!d) return 0;
+    d->num_points = h->num_points;
+    d->num_floor_lines = h->num_floor_lines;
+    d->num_zone_slots = h->num_zone_slots;
+    d->num_graph_entries = h->num_graph_entries;
+    d->num_gfx_streams = h->num_gfx_streams;
+    d->num_connect = h->num_connect;
+
+    for (int i = 0; i < BAKE_NUM_ARRAYS; i++) {
+        const BakeArrayDesc *a = &k_bake_arrays[i];
+        int64_t want = bake_expected_count(d, a, h->has_pvs);
+        sec = bake_section(img->base, a->id);
+        if (want < 0 || !sec || sec->elem_size != a->elem_size || sec->count != (uint64_t)want) {
+            printf("[LEVEL] Baked image: section %u is malformed, decoding instead\n", (unsigned)a->id);
+            free(d);
+            return 0;
+        }
+        if (want > 0) bake_set_field(d, a, img->base + sec->offset);
+        else if (!a->nullable) bake_set_field(d, a, k_bake_empty);
+    }
+
+    /* The offset map is the one bulky table; level_parse builds it only when
+     * it is small enough, so an empty section is fine. */
+    sec = bake_section(img->base, BAKE_ZONE_MAP);
+    if (!sec || sec->elem_size != sizeof(int16_t) ||
+        (sec->count != 0 && sec->count != (uint64_t)level->data_byte_count)) {
+        printf("[LEVEL] Baked image: zone offset map is malformed, decoding instead\n");
+        free(d);
+        return 0;
+    }
+
+    level_free_decoded(level);
+    free(level->zone_index_by_data_offset);
+    level->zone_index_by_data_offset = sec->count ? (int16_t *)(img->base + sec->offset) : NULL;
+    level->zone_index_by_data_offset_len = (size_t)sec->count;
+    d->bake = img;
+    level->decoded = d;
+
+    printf("[LEVEL] Decoded view from bake: %d points, %d floor lines, %d zones, %d gfx streams, PVS %s\n",
+           (int)d->num_points, (int)d->num_floor_lines, (int)d->num_zone_slots,
+           (int)d->num_gfx_streams, d->zone_pvs ? "yes" : "no");
+    return 1;
+}
+
+int level_bake_apply_fixes(LevelState *level)
+{
+    const LevelBakeImage *img = (level && level->decoded) ? level->decoded->bake : NULL;
+    const LevelBakeSection *ps, *pb;
+    const LevelBakePatch *patches;
+    int applied = 0;
+
+    if (!img) return 0;
+    ps = bake_section(img->base, BAKE_PATCHES);
+    pb = bake_section(img->base, BAKE_PATCH_BYTES);
+    if (!ps || !pb || ps->elem_size != sizeof(LevelBakePatch) || pb->elem_size != 1) {
+        printf("[LEVELFIX] baked patch list missing, running the fixes\n");
+        return 0;
+    }
+    patches = (const LevelBakePatch *)(img->base + ps->offset);
+    for (uint64_t i = 0; i < ps->count; i++) {
+        const LevelBakePatch *p = &patches[i];
+        uint8_t *dst = (p->target == 0) ? level->data : level->graphics;
+        size_t cap = (p->target == 0) ? level->data_byte_count : level->graphics_byte_count;
+        if (p->target > 1 || !dst || (uint64_t)p->offset + p->len > cap ||
+            (uint64_t)p->data_off + p->len > pb->count)
+            continue;
+        memcpy(dst + p->offset, img->base + pb->offset + p->data_off, p->len);
+        applied++;
+    }
+    printf("[LEVELFIX] applied %d baked patches\n", applied);
+    return 1;
+}
+
+/* ---- Writer ---- */
+
+typedef struct {
+    uint32_t    id;
+    uint32_t    elem_size;
+    uint64_t    count;
+    const void *src;
+} BakeOut;
+
+/* Append the runs where now differs from before as patches (gaps shorter
+ * than LEVEL_BAKE_PATCH_GAP are folded in). */
+static int bake_diff(uint32_t target, const uint8_t *before, const uint8_t *now, size_t n,
+                     LevelBakePatch **patches, uint32_t *num_patches,
+                     uint8_t **bytes, uint32_t *num_bytes)
+{
+    size_t i = 0;
+
+    if (!before || !now) return 1;
+    while (i < n) {
+        size_t start, end, gap;
+        LevelBakePatch *np;
+        uint8_t *nb;
+
+        if (before[i] == now[i]) { i++; continue; }
+        start = i;
+        end = i + 1;
+        for (gap = 0, i = end; i < n && gap < LEVEL_BAKE_PATCH_GAP; i++) {
+            if (before[i] != now[i]) { end = i + 1; gap = 0; }
+            else gap++;
+        }
+        i = end;
+
+        np = (LevelBakePatch *)realloc(*patches, ((size_t)*num_patches + 1u) * sizeof(LevelBakePatch));
+        if (!np) return 0;
+        *patches = np;
+        nb = (uint8_t *)realloc(*bytes, (size_t)*num_bytes + (end - start));
+        if (!nb) return 0;
+        *bytes = nb;
+        np[*num_patches].target = target;
+        np[*num_patches].offset = (uint32_t)start;
+        np[*num_patches].len = (uint32_t)(end - start);
+        np[*num_patches].data_off = *num_bytes;
+        memcpy(nb + *num_bytes, now + start, end - start);
+        (*num_patches)++;
+        *num_bytes += (uint32_t)(end - start);
+    }
+    return 1;
+}
+
+static uint64_t bake_align(uint64_t v)
+{
+    return (v + LEVEL_BAKE_ALIGN - 1u) & ~(uint64_t)(LEVEL_BAKE_ALIGN - 1u);
+}
+
+int level_bake_write(const LevelState *level, uint64_t source_hash,
+                     const uint8_t *pre_fix_data, const uint8_t *pre_fix_graphics,
+                     const char *path)
+{
+    const LevelDecoded *d = level ? level->decoded : NULL;
+    BakeOut out[BAKE_NUM_ARRAYS + 3];
+    int num_out = 0;
+    LevelBakePatch *patches = NULL;
+    uint8_t *patch_bytes = NULL;
+    uint32_t num_patches = 0, num_patch_bytes = 0;
+    LevelBakeHeader hdr;
+    LevelBakeSection *sections = NULL;
+    uint8_t *file = NULL;
+    uint64_t pos;
+    char tmp[1040];
+    FILE *f;
+    int ok = 0;
+
+    if (!d || d->bake) {
+        printf("[BAKE] level has no decoded view to bake\n");
+        return -1;
+    }
+    if (!bake_diff(0, pre_fix_data, level->data, level->data_byte_count,
+                   &patches, &num_patches, &patch_bytes, &num_patch_bytes) ||
+        !bake_diff(1, pre_fix_graphics, level->graphics, level->graphics_byte_count,
+                   &patches, &num_patches, &patch_bytes, &num_patch_bytes))
+        goto done;
+
+    for (int i = 0; i < BAKE_NUM_ARRAYS; i++) {
+        const BakeArrayDesc *a = &k_bake_arrays[i];
+        int64_t n = bake_expected_count(d, a, d->zone_pvs_first != NULL);
+        const void *src = bake_get_field(d, a);
+        if (n < 0 || (n > 0 && !src)) {
+            printf("[BAKE] decoded array %u is inconsistent\n", (unsigned)a->id);
+            goto done;
+        }
+        out[num_out].id = a->id;
+        out[num_out].elem_size = a->elem_size;
+        out[num_out].count = (uint64_t)n;
+        out[num_out].src = src;
+        num_out++;
+    }
+    out[num_out].id = BAKE_ZONE_MAP;
+    out[num_out].elem_size = sizeof(int16_t);
+    out[num_out].count = level->zone_index_by_data_offset ? level->zone_index_by_data_offset_len : 0;
+    out[num_out].src = level->zone_index_by_data_offset;
+    num_out++;
+    out[num_out].id = BAKE_PATCHES;
+    out[num_out].elem_size = sizeof(LevelBakePatch);
+    out[num_out].count = num_patches;
+    out[num_out].src = patches;
+    num_out++;
+    out[num_out].id = BAKE_PATCH_BYTES;
+    out[num_out].elem_size = 1;
+    out[num_out].count = num_patch_bytes;
+    out[num_out].src = patch_bytes;
+    num_out++;
+
+    sections = (LevelBakeSection *)calloc((size_t)num_out, sizeof(LevelBakeSection));
+    if (!sections) goto done;
+    pos = bake_align(sizeof(hdr) + (uint64_t)num_out * sizeof(LevelBakeSection));
+    for (int i = 0; i < num_out; i++) {
+        sections[i].id = out[i].id;
+        sections[i].elem_size = out[i].elem_size;
+        sections[i].count = out[i].count;
+        sections[i].offset = pos;
+        pos = bake_align(pos + out[i].count * out[i].elem_size);
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, LEVEL_BAKE_MAGIC, sizeof(hdr.magic));
+    hdr.version = LEVEL_BAKE_VERSION;
+    hdr.endian = LEVEL_BAKE_ENDIAN;
+    hdr.header_size = (uint32_t)sizeof(hdr);
+    hdr.section_count = (uint32_t)num_out;
+    hdr.source_hash = source_hash;
+    hdr.file_size = pos;
+    hdr.num_points = d->num_points;
+    hdr.num_floor_lines = d->num_floor_lines;
+    hdr.num_zone_slots = d->num_zone_slots;
+    hdr.num_graph_entries = d->num_graph_entries;
+    hdr.num_gfx_streams = d->num_gfx_streams;
+    hdr.num_connect = d->num_connect;
+    hdr.has_pvs = d->zone_pvs_first != NULL;
+
+    file = (uint8_t *)calloc(1, (size_t)pos);
+    if (!file) goto done;
+    memcpy(file, &hdr, sizeof(hdr));
+    memcpy(file + sizeof(hdr), sections, (size_t)num_out * sizeof(LevelBakeSection));
+    for (int i = 0; i < num_out; i++) {
+        if (out[i].count)
+            memcpy(file + sections[i].offset, out[i].src, (size_t)(out[i].count * out[i].elem_size));
+    }
+
+    /* Temp file and rename, so a running game never maps a half-written bake. */
+    snprintf(tmp, sizeof(tmp), "%s.tmp", path);
+    f = fopen(tmp, "wb");
+    if (!f) {
+        printf("[BAKE] cannot write %s\n", tmp);
+        goto done;
+    }
+    ok = fwrite(file, 1, (size_t)pos, f) == (size_t)pos;
+    ok = (fclose(f) == 0) && ok;
+    if (ok) {
+#if defined(_WIN32) || defined(_WIN64)
+        remove(path); /* rename does not replace on Windows */
+#endif
+        ok = rename(tmp, path) == 0;
+    }
+    if (!ok) {
+        remove(tmp);
+        printf("[BAKE] failed to write %s\n", path);
+    } else {
+        printf("[BAKE] wrote %s: %llu bytes, %d sections, %d PVS entries, %u patches (%u bytes)\n",
+               path, (unsigned long long)pos, num_out,
+               d->zone_pvs_first ? (int)d->zone_pvs_first[d->num_zone_slots] : 0,
+               (unsigned)num_patches, (unsigned)num_patch_bytes);
+    }
+
+done:
+    free(file);
+    free(sections);
+    free(patches);
+    free(patch_bytes);
+    return ok ? 0 : -1;
+}
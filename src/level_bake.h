@@ -0,0 +1,63 @@
+/*
+ * Alien Breed 3D I - PC Port
+ * level_bake.h - Baked (precompiled) level images
+ *
+ * tools/parse_level --bake runs level_parse offline and writes everything
+ * level_parse and level_build_decoded derive from the three level files to
+ * levels/level_x/twolev.bake: the decoded view (points, floor lines, zone
+ * exits and neighbours, graphics stream tokens), the connect -> zone slot
+ * table, each zone's PVS, the data-offset -> zone map, and the bytes
+ * level_apply_level_specific_fixes changes, as a patch list.
+ *
+ * The file is native-endian and made of 64-byte aligned arrays, so the
+ * loader maps it and points LevelDecoded straight into the mapping. It is
+ * keyed by an FNV-1a hash of the unpacked twolev.bin, twolev.graph.bin and
+ * twolev.clips; a stale, foreign-endian or otherwise mismatched bake is
+ * ignored and the level is decoded as before. level_parse itself still
+ * runs, since it resolves the level's offsets to pointers and rewrites parts
+ * of level->data in place.
+ */
+
+#ifndef LEVEL_BAKE_H
+#define LEVEL_BAKE_H
+
+#include "game_state.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define LEVEL_BAKE_FILE_NAME  "twolev.bake"
+
+/* A loaded bake file. release() frees the bytes and the struct itself. */
+typedef struct LevelBakeImage {
+    uint8_t *base;
+    size_t   size;
+    void   (*release)(struct LevelBakeImage *img);
+} LevelBakeImage;
+
+/* FNV-1a 64 over the unpacked data, graphics and clips (before level_parse). */
+uint64_t level_bake_source_hash(const LevelState *level);
+
+/* 1 when base/size is a bake of this build's format for source_hash. */
+int level_bake_header_ok(const uint8_t *base, size_t size, uint64_t source_hash);
+
+/* level_parse: point level->decoded and the zone offset map into img when it
+ * matches the parsed level. On success the level owns img (released by
+ * level_free_decoded) and 1 is returned; on 0 the caller still owns it. */
+int level_bake_attach(LevelState *level, LevelBakeImage *img);
+
+/* Replay the baked level_apply_level_specific_fixes patches. Returns 0 when
+ * the level was not attached to a bake (run the fixes instead). */
+int level_bake_apply_fixes(LevelState *level);
+
+int  level_bake_image_owns(const LevelBakeImage *img, const void *p);
+void level_bake_image_release(LevelBakeImage *img);
+
+/* Offline: write the bake for a level that has been through level_parse,
+ * level_assign_clips and level_apply_level_specific_fixes. pre_fix_data /
+ * pre_fix_graphics are copies taken just before the fixes ran; the
+ * difference becomes the patch list. Returns 0 on success. */
+int level_bake_write(const LevelState *level, uint64_t source_hash,
+                     const uint8_t *pre_fix_data, const uint8_t *pre_fix_graphics,
+                     const char *path);
+
+#endif /* LEVEL_BAKE_H */
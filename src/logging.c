@@ -3,12 +3,22 @@
  *
  * The game runs without a DOS console on Windows and writes logs to
  * ab3d.log beside the executable.
+ *
+ * Once the log file is open, ab3d_log_printf formats into a per-thread
+ * single-producer ring and returns; a writer thread drains all rings and
+ * writes them out in batches. A full ring drops the line and counts it
+ * (reported by the writer). AB3D_DISABLE_ASYNC_LOG=1 keeps the old
+ * synchronous write+flush per call. Fatal paths that exit() without
+ * ab3d_log_shutdown are covered by an atexit drain.
  */
 
 #include "logging.h"
+#include "settings.h"
+#include "thread_local.h"
 
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include <SDL.h>
@@ -17,6 +27,21 @@
 #include <windows.h>
 #endif
 
+#define LOG_MAX_RINGS      32
+#define LOG_RING_BYTES     (64 * 1024)          /* power of two */
+#define LOG_RING_MASK      (LOG_RING_BYTES - 1)
+#define LOG_LINE_BYTES     1024                 /* stack format buffer; longer lines go through the heap */
+#define LOG_MAX_LINE_BYTES (LOG_RING_BYTES / 4)
+#define LOG_FLUSH_MS       10
+
+typedef struct {
+    SDL_atomic_t owned;     /* 1 while a live thread produces into this ring */
+    SDL_atomic_t head;      /* bytes written; producer only */
+    SDL_atomic_t tail;      /* bytes consumed; writer only */
+    SDL_atomic_t dropped;   /* lines dropped because the ring was full */
+    void *buf;              /* LOG_RING_BYTES; published with SDL_AtomicSetPtr */
+} LogRing;
+
 #if !defined(__EMSCRIPTEN__)
 static FILE *g_log_stdout = NULL;
 static FILE *g_log_stderr = NULL;
@@ -24,6 +49,18 @@ static FILE *g_log_stderr = NULL;
 static int g_log_ready = 0;
 static char g_log_path[1024] = "ab3d.log";
 
+static LogRing g_log_rings[LOG_MAX_RINGS];
+static SDL_atomic_t g_log_async;        /* writer thread running; producers may enqueue */
+static SDL_atomic_t g_log_writer_quit;
+static SDL_Thread *g_log_writer;
+static SDL_sem *g_log_wake;
+static SDL_mutex *g_log_drain_mutex;    /* writer vs. shutdown's final drain */
+static SDL_TLSID g_log_tls;
+static char g_log_batch[LOG_RING_BYTES];
+
+static AB3D_THREAD_LOCAL LogRing *t_log_ring = NULL;
+static AB3D_THREAD_LOCAL int t_log_ring_failed = 0;
+
 static int ab3d_log_is_suppressed(const char *fmt)
 {
     if (!fmt) return 0;
@@ -51,6 +88,158 @@ static void ab3d_log_build_path(void)
 }
 #endif
 
+/* SDL TLS destructor: runs when an SDL-created thread exits (loader decode
+ * helpers come and go per load), so its ring can be claimed again. Lines it
+ * left behind are still drained; the next owner appends after them. */
+static void log_ring_release(void *p)
+{
+    LogRing *ring = (LogRing *)p;
+    if (ring) SDL_AtomicSet(&ring->owned, 0);
+}
+
+static LogRing *log_ring_for_thread(void)
+{
+    if (t_log_ring) return t_log_ring;
+    if (t_log_ring_failed) return NULL;
+
+    for (int i = 0; i < LOG_MAX_RINGS; i++) {
+        LogRing *ring = &g_log_rings[i];
+        if (!SDL_AtomicCAS(&ring->owned, 0, 1)) continue;
+        if (!SDL_AtomicGetPtr(&ring->buf)) {
+            void *buf = malloc(LOG_RING_BYTES);
+            if (!buf) {
+                SDL_AtomicSet(&ring->owned, 0);
+                break;
+            }
+            SDL_AtomicSetPtr(&ring->buf, buf);
+        }
+        if (g_log_tls) SDL_TLSSet(g_log_tls, ring, log_ring_release);
+        t_log_ring = ring;
+        return ring;
+    }
+    /* Out of rings: this thread logs synchronously from now on. */
+    t_log_ring_failed = 1;
+    return NULL;
+}
+
+/* Copy len bytes into the ring as one unit, or drop the line if it does not fit. */
+static int log_ring_push(LogRing *ring, const char *text, int len)
+{
+    unsigned char *buf = (unsigned char *)SDL_AtomicGetPtr(&ring->buf);
+    Uint32 head = (Uint32)SDL_AtomicGet(&ring->head);
+    Uint32 tail = (Uint32)SDL_AtomicGet(&ring->tail);
+    Uint32 used = head - tail;
+
+    if (len <= 0) return 0;
+    if ((Uint32)len > LOG_RING_BYTES - used) {
+        SDL_AtomicAdd(&ring->dropped, 1);
+        return 0;
+    }
+    Uint32 at = head & LOG_RING_MASK;
+    Uint32 first = LOG_RING_BYTES - at;
+    if (first > (Uint32)len) first = (Uint32)len;
+    memcpy(buf + at, text, first);
+    if (first < (Uint32)len) memcpy(buf, text + first, (size_t)len - first);
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&ring->head, (int)(head + (Uint32)len));
+
+    /* Wake the writer early rather than waiting out LOG_FLUSH_MS with a ring
+     * that is filling quickly. */
+    if (used + (Uint32)len >= LOG_RING_BYTES / 2 && used < LOG_RING_BYTES / 2 && g_log_wake)
+        SDL_SemPost(g_log_wake);
+    return len;
+}
+
+/* Drain every ring into one batch and write it with a single flush.
+ * Caller holds g_log_drain_mutex. */
+static void log_drain_rings(void)
+{
+    size_t batch = 0;
+
+    for (int i = 0; i < LOG_MAX_RINGS; i++) {
+        LogRing *ring = &g_log_rings[i];
+        const unsigned char *buf = (const unsigned char *)SDL_AtomicGetPtr(&ring->buf);
+        if (!buf) continue;
+
+        Uint32 tail = (Uint32)SDL_AtomicGet(&ring->tail);
+        Uint32 head = (Uint32)SDL_AtomicGet(&ring->head);
+        SDL_MemoryBarrierAcquire();
+        while (tail != head) {
+            Uint32 at = tail & LOG_RING_MASK;
+            Uint32 n = head - tail;
+            if (n > LOG_RING_BYTES - at) n = LOG_RING_BYTES - at;
+            if (n > sizeof(g_log_batch) - batch) n = (Uint32)(sizeof(g_log_batch) - batch);
+            memcpy(g_log_batch + batch, buf + at, n);
+            batch += n;
+            tail += n;
+            if (batch == sizeof(g_log_batch)) {
+                fwrite(g_log_batch, 1, batch, stdout);
+                batch = 0;
+            }
+        }
+        SDL_MemoryBarrierRelease();
+        SDL_AtomicSet(&ring->tail, (int)tail);
+
+        int dropped = SDL_AtomicGet(&ring->dropped);
+        if (dropped > 0) {
+            SDL_AtomicAdd(&ring->dropped, -dropped);
+            if (batch) fwrite(g_log_batch, 1, batch, stdout);
+            batch = 0;
+            fprintf(stdout, "[LOG] dropped %d lines (log ring %d full)\n", dropped, i);
+        }
+    }
+    if (batch) fwrite(g_log_batch, 1, batch, stdout);
+    fflush(stdout);
+}
+
+static int log_writer_main(void *unused)
+{
+    (void)unused;
+    while (!SDL_AtomicGet(&g_log_writer_quit)) {
+        SDL_SemWaitTimeout(g_log_wake, LOG_FLUSH_MS);
+        SDL_LockMutex(g_log_drain_mutex);
+        log_drain_rings();
+        SDL_UnlockMutex(g_log_drain_mutex);
+    }
+    return 0;
+}
+
+/* atexit: write out what is queued without joining the writer, which may be
+ * parked in SDL_SemWaitTimeout; later lines go straight to stdout. */
+static void log_exit_drain(void)
+{
+    if (g_log_writer) {
+        SDL_AtomicSet(&g_log_async, 0);
+        SDL_LockMutex(g_log_drain_mutex);
+        log_drain_rings();
+        SDL_UnlockMutex(g_log_drain_mutex);
+    }
+    if (stdout) fflush(stdout);
+    if (stderr) fflush(stderr);
+}
+
+static void log_async_start(void)
+{
+    if (!settings_env_feature_enabled(NULL, "AB3D_DISABLE_ASYNC_LOG")) return;
+
+    g_log_tls = SDL_TLSCreate();
+    g_log_wake = SDL_CreateSemaphore(0);
+    g_log_drain_mutex = SDL_CreateMutex();
+    SDL_AtomicSet(&g_log_writer_quit, 0);
+    if (g_log_wake && g_log_drain_mutex)
+        g_log_writer = SDL_CreateThread(log_writer_main, "ab3d_log", NULL);
+    if (!g_log_writer) {
+        fprintf(stdout, "[LOG] writer thread unavailable (%s); logging synchronously\n", SDL_GetError());
+        if (g_log_wake) SDL_DestroySemaphore(g_log_wake);
+        if (g_log_drain_mutex) SDL_DestroyMutex(g_log_drain_mutex);
+        g_log_wake = NULL;
+        g_log_drain_mutex = NULL;
+        return;
+    }
+    SDL_AtomicSet(&g_log_async, 1);
+    atexit(log_exit_drain);
+}
+
 int ab3d_log_init_file(void)
 {
     if (g_log_ready) return 1;
@@ -86,12 +275,25 @@ int ab3d_log_init_file(void)
 
     g_log_ready = 1;
     fprintf(stdout, "[LOG] Writing output to: %s\n", g_log_path);
+    log_async_start();
     return 1;
 #endif
 }
 
 void ab3d_log_shutdown(void)
 {
+    if (g_log_writer) {
+        /* New lines go straight to stdout from here on; then stop the writer
+         * and pick up whatever was queued after its last pass. */
+        SDL_AtomicSet(&g_log_async, 0);
+        SDL_AtomicSet(&g_log_writer_quit, 1);
+        SDL_SemPost(g_log_wake);
+        SDL_WaitThread(g_log_writer, NULL);
+        g_log_writer = NULL;
+        SDL_LockMutex(g_log_drain_mutex);
+        log_drain_rings();
+        SDL_UnlockMutex(g_log_drain_mutex);
+    }
     if (stdout) fflush(stdout);
     if (stderr) fflush(stderr);
 }
@@ -108,6 +310,33 @@ int ab3d_log_printf(const char *fmt, ...)
 
     if (ab3d_log_is_suppressed(fmt)) return 0;
 
+    LogRing *ring = SDL_AtomicGet(&g_log_async) ? log_ring_for_thread() : NULL;
+    if (ring) {
+        char line[LOG_LINE_BYTES];
+        /* Plain strings skip the formatter entirely. */
+        if (!strchr(fmt, '%')) return log_ring_push(ring, fmt, (int)strlen(fmt));
+
+        va_start(ap, fmt);
+        out = vsnprintf(line, sizeof(line), fmt, ap);
+        va_end(ap);
+        if (out < (int)sizeof(line)) return log_ring_push(ring, line, out);
+
+        /* Long report lines: format on the heap, capped so one line cannot
+         * take over the ring. */
+        int len = out < LOG_MAX_LINE_BYTES ? out : LOG_MAX_LINE_BYTES - 1;
+        char *big = (char *)malloc((size_t)len + 1u);
+        if (!big) {
+            SDL_AtomicAdd(&ring->dropped, 1);
+            return 0;
+        }
+        va_start(ap, fmt);
+        vsnprintf(big, (size_t)len + 1u, fmt, ap);
+        va_end(ap);
+        log_ring_push(ring, big, len);
+        free(big);
+        return out;
+    }
+
     va_start(ap, fmt);
     out = vfprintf(stdout, fmt, ap);
     va_end(ap);
@@ -39,8 +39,13 @@
 #include "input.h"
 #include "audio.h"
 #include "io.h"
+#include "player.h"
+#include "asset_loader.h"
 #include "renderer_3dobj.h"
 #include "settings.h"
+#include "benchmark.h"
+#include "replay.h"
+#include "trace.h"
 
 #if defined(__EMSCRIPTEN__)
 #include "emscripten_loop.h"
@@ -104,6 +109,8 @@ void tear_down_game(GameState *state)
     printf("\nTearDownGame\n");
 
     audio_mt_end();
+    player_save_shutdown();
+    asset_loader_shutdown();
 
     io_save_passwords();
 
@@ -116,6 +123,8 @@ void tear_down_game(GameState *state)
     audio_shutdown();
     input_shutdown();
     display_shutdown();
+    /* After display_shutdown: the render workers record until they are joined there. */
+    trace_shutdown();
     io_shutdown();
 
     printf("TearDownGame complete\n");
@@ -128,6 +137,10 @@ int main(int argc, char *argv[])
 {
     int log_init_ok;
     int enable_3dobj_anim = 1;
+    BenchmarkOptions bench_opts;
+    int bench_mode;
+    ReplayOptions replay_opts;
+    int replay_mode;
 
     /* OSFriendlyStartup is a no-op on PC
      * (no Amiga system state to save/restore) */
@@ -137,14 +150,30 @@ int main(int argc, char *argv[])
     if (!log_init_ok) {
         fprintf(stderr, "[LOG] Failed to open log file (expected: %s)\n", ab3d_log_path());
     }
+    trace_init();
 
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--3dobj-anim") == 0) {
             enable_3dobj_anim = 1;
         } else if (strcmp(argv[i], "--amiga-3dobj-static") == 0) {
             enable_3dobj_anim = 0;
+        } else if (strcmp(argv[i], "--headless") == 0) {
+            display_request_headless();
+        } else if (strcmp(argv[i], "--dump-frame") == 0 && i + 2 < argc) {
+            display_request_frame_dump(argv[i + 2], atoi(argv[i + 1]));
+            i += 2;
         }
     }
+    bench_mode = benchmark_parse_args(argc, argv, &bench_opts);
+    if (bench_mode < 0) {
+        ab3d_log_shutdown();
+        return 2;
+    }
+    replay_mode = replay_parse_args(argc, argv, &replay_opts);
+    if (replay_mode < 0) {
+        ab3d_log_shutdown();
+        return 2;
+    }
     poly_obj_set_use_object_frame(enable_3dobj_anim);
     if (enable_3dobj_anim) {
         printf("[3DOBJ] Animation mode: object frame enabled (default; --3dobj-anim)\n");
@@ -152,12 +181,29 @@ int main(int argc, char *argv[])
         printf("[3DOBJ] Animation mode: Amiga static frame 0 (--amiga-3dobj-static)\n");
     }
 
+#if !defined(__EMSCRIPTEN__)
+    if (bench_mode || replay_mode) display_request_uncapped_present();
+#endif
     setup_game(&g_state);
 #if defined(__EMSCRIPTEN__)
     emscripten_run_game(&g_state);
     /* Game runs in emscripten_set_main_loop; tear_down + log shutdown happen when the loop ends. */
     return 0;
 #else
+    if (bench_mode) {
+        int bench_rc = benchmark_run(&g_state, &bench_opts);
+        tear_down_game(&g_state);
+        printf("\n=== Exit (code %d) ===\n", bench_rc);
+        ab3d_log_shutdown();
+        return bench_rc;
+    }
+    if (replay_mode) {
+        int replay_rc = replay_run(&g_state, &replay_opts);
+        tear_down_game(&g_state);
+        printf("\n=== Exit (code %d) ===\n", replay_rc);
+        ab3d_log_shutdown();
+        return replay_rc;
+    }
     play_game(&g_state);
     tear_down_game(&g_state);
 
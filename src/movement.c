@@ -9,6 +9,7 @@
 #include "game_data.h"
 #include "math_tables.h"
 #include "level.h"
+#include "spatial_index.h"
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
@@ -234,17 +235,17 @@ static bool transition_height_ok_zone_for_mover(const MoveContext *ctx, int32_t
 
 static void mark_floorline_touch_flag(const MoveContext *ctx, const uint8_t *fline);
 
-static void get_floorline_shift_offsets(const MoveContext *ctx, const uint8_t *fline,
+static void get_floorline_shift_offsets(const MoveContext *ctx, int8_t normal_x, int8_t normal_z,
     int32_t *out_a4, int32_t *out_a6)
 {
     int32_t a4 = 0;
     int32_t a6 = 0;
 
-    if (ctx && fline) {
+    if (ctx) {
         int8_t shift = (int8_t)ctx->awayfromwall;
         if (shift >= 0) {
-            a4 = (int32_t)(int8_t)fline[FLINE_NORMAL + 0];
-            a6 = (int32_t)(int8_t)fline[FLINE_NORMAL + 1];
+            a4 = (int32_t)normal_x;
+            a6 = (int32_t)normal_z;
             if (shift > 0) {
                 if (shift > 15) shift = 15;
                 a4 <<= shift;
@@ -533,7 +534,7 @@ static void mark_floorline_touch_flag(const MoveContext *ctx, const uint8_t *fli
  *
  * Our coordinates may be shifted by pos_shift, so scale the 32 threshold too. */
 static void mark_floorline_touch_if_near(const MoveContext *ctx, const uint8_t *fline,
-    int32_t lx, int32_t lz, int16_t lxlen, int16_t lzlen, int ps)
+    int32_t lx, int32_t lz, int16_t lxlen, int16_t lzlen, int16_t length, int ps)
 {
     if (!ctx || !fline) return;
     if (ctx->wall_flags == 0) return;
@@ -543,7 +544,7 @@ static void mark_floorline_touch_if_near(const MoveContext *ctx, const uint8_t *
                        (int64_t)(ctx->newz - lz) * (int64_t)lxlen;
         if (side <= 0) return;
 
-        int32_t line_len = (int32_t)(int16_t)read_be16(fline + FLINE_LENGTH);
+        int32_t line_len = (int32_t)length;
         if (line_len < 0) line_len = -line_len;
         int32_t denom = line_len + ctx->extlen;
         if (denom <= 0) denom = 1;
@@ -905,6 +906,22 @@ void player_fall(int32_t* yoff, int32_t* yvel, int32_t tyoff,
     *yoff = d1;
 }
 
+/* True when the old->new path's box, grown by margin, is more than margin
+ * away from the line's box on either axis: no crossing, and the segment
+ * distance is at least margin. */
+static int move_path_misses_bbox(const MoveContext *ctx, const LevelFloorLine *ml, int ps, int64_t margin)
+{
+    int64_t pmin_x = (ctx->oldx < ctx->newx) ? ctx->oldx : ctx->newx;
+    int64_t pmax_x = (ctx->oldx < ctx->newx) ? ctx->newx : ctx->oldx;
+    int64_t pmin_z = (ctx->oldz < ctx->newz) ? ctx->oldz : ctx->newz;
+    int64_t pmax_z = (ctx->oldz < ctx->newz) ? ctx->newz : ctx->oldz;
+    int64_t lmin_x = (int64_t)ml->min_x << ps, lmax_x = (int64_t)ml->max_x << ps;
+    int64_t lmin_z = (int64_t)ml->min_z << ps, lmax_z = (int64_t)ml->max_z << ps;
+
+    return pmax_x + margin < lmin_x || pmin_x - margin > lmax_x ||
+           pmax_z + margin < lmin_z || pmin_z - margin > lmax_z;
+}
+
 /* -----------------------------------------------------------------------
  * check_wall_line - Phase 1: Check one floor line for wall collision.
  *
@@ -914,21 +931,21 @@ void player_fall(int32_t* yoff, int32_t* yvel, int32_t tyoff,
  *   3 = wall hit, reverted (stop)
  * ----------------------------------------------------------------------- */
 static int check_wall_line(MoveContext* ctx, LevelState* level,
-    const uint8_t* fline, const uint8_t* zone_data,
+    const uint8_t* fline, const LevelFloorLine* ml, const uint8_t* zone_data,
     int32_t* xdiff, int32_t* zdiff, int pass_kind)
 {
     int ps = ctx->pos_shift;
     int pass_is_walls = (pass_kind == MOVE_PASS_WALLS || pass_kind == MOVE_PASS_BRUTE) ? 1 : 0;
     int pass_is_other = (pass_kind == MOVE_PASS_OTHER) ? 1 : 0;
 
-    int16_t connect = (int16_t)read_be16(fline + FLINE_CONNECT);
-    int connect_index = level_connect_to_zone_index(level, connect);
+    int16_t connect = ml->connect;
+    int connect_index = ml->connect_zone;
     int zone_slots = level_zone_slot_count(level);
-    int32_t lx = (int32_t)(int16_t)read_be16(fline + FLINE_X) << ps;
-    int32_t lz = (int32_t)(int16_t)read_be16(fline + FLINE_Z) << ps;
-    int16_t lxlen = (int16_t)read_be16(fline + FLINE_XLEN);
-    int16_t lzlen = (int16_t)read_be16(fline + FLINE_ZLEN);
-    int32_t line_len = (int32_t)(int16_t)read_be16(fline + FLINE_LENGTH);
+    int32_t lx = (int32_t)ml->x << ps;
+    int32_t lz = (int32_t)ml->z << ps;
+    int16_t lxlen = ml->xlen;
+    int16_t lzlen = ml->zlen;
+    int32_t line_len = (int32_t)ml->length;
     int32_t a4 = 0;
     int32_t a6 = 0;
     int32_t orig_newx = ctx->newx;
@@ -940,14 +957,14 @@ static int check_wall_line(MoveContext* ctx, LevelState* level,
     uint8_t *target_room = NULL;
     int has_target_zone = 0;
 
-    get_floorline_shift_offsets(ctx, fline, &a4, &a6);
+    get_floorline_shift_offsets(ctx, ml->normal_x, ml->normal_z, &a4, &a6);
 
     /* Amiga tags touch flags before deciding whether an exit is passable. */
-    mark_floorline_touch_if_near(ctx, fline, lx, lz, lxlen, lzlen, ps);
+    mark_floorline_touch_if_near(ctx, fline, lx, lz, lxlen, lzlen, ml->length, ps);
 
     /* ---- Exit line handling. ---- */
     if (zone_data && level->zone_adds && connect_index >= 0 && connect_index < zone_slots) {
-        int32_t target_zone_off = read_be32(level->zone_adds + (size_t)connect_index * 4);
+        int32_t target_zone_off = ml->target_off;
         target_zone = level->data + target_zone_off;
         target_room = (uint8_t*)(level->data + target_zone_off);
         has_target_zone = 1;
@@ -1022,7 +1039,10 @@ static int check_wall_line(MoveContext* ctx, LevelState* level,
         ext = ext / 2;  /* use half extlen for wall radius */
 
         if (ext == 0) {
-            /* Point-crossing fallback (your previous behavior). */
+            /* Point-crossing fallback (your previous behavior). A path that
+             * cannot reach the line's bounding box cannot cross it. */
+            if (move_path_misses_bbox(ctx, ml, ps, 0)) return 0;
+
             int64_t new_cross = (int64_t)(ctx->newx - lx) * lzlen -
                 (int64_t)(ctx->newz - lz) * lxlen;
             int64_t old_cross = (int64_t)(ctx->oldx - lx) * lzlen -
@@ -1069,6 +1089,8 @@ static int check_wall_line(MoveContext* ctx, LevelState* level,
         }
 
         {
+            if (move_path_misses_bbox(ctx, ml, ps, (int64_t)ext << ps)) return 0;
+
             double radius = (double)((int64_t)ext << ps);
             int64_t old_cross = (int64_t)(ctx->oldx - lx) * lzlen -
                                 (int64_t)(ctx->oldz - lz) * lxlen;
@@ -1158,39 +1180,40 @@ static void find_room(MoveContext* ctx, LevelState* level,
 
     {
         int ps = ctx->pos_shift;
-        int16_t list_off = read_be16(zone_data + ZONE_EXIT_LIST);
-        const uint8_t* list_ptr = zone_data + list_off;
+        int16_t scratch[LEVEL_EXIT_LIST_MAX];
+        int exit_count = 0;
+        const int16_t *exits = level_room_exit_list(level, zone_data, scratch, &exit_count);
 
-        for (int i = 0; i < 128; i++) {
-            int16_t entry = read_be16(list_ptr + i * 2);
+        for (int i = 0; i < exit_count; i++) {
+            int16_t entry = exits[i];
             if (entry < 0) break; /* -1 ends exit portion */
             if (entry >= level->num_floor_lines) continue;
 
             {
-                const uint8_t* fline = level->floor_lines + entry * FLINE_SIZE;
-                int16_t connect = (int16_t)read_be16(fline + FLINE_CONNECT);
-                int connect_index = level_connect_to_zone_index(level, connect);
+                LevelFloorLine ml;
+                level_floor_line(level, entry, &ml);
+                int connect_index = ml.connect_zone;
                 if (connect_index < 0) continue;
                 if (connect_index >= zone_slots) continue;
 
-                int32_t lx = (int32_t)(int16_t)read_be16(fline + FLINE_X) << ps;
-                int32_t lz = (int32_t)(int16_t)read_be16(fline + FLINE_Z) << ps;
-                int16_t lxlen = (int16_t)read_be16(fline + FLINE_XLEN);
-                int16_t lzlen = (int16_t)read_be16(fline + FLINE_ZLEN);
+                int32_t lx = (int32_t)ml.x << ps;
+                int32_t lz = (int32_t)ml.z << ps;
+                int16_t lxlen = ml.xlen;
+                int16_t lzlen = ml.zlen;
                 int32_t cross_new = 0;
                 int32_t cross_old = 0;
                 if (!find_room_crosses_exit_asm(ctx, lx, lz, lxlen, lzlen, &cross_new, &cross_old))
                     continue;
 
                 {
-                    int32_t target_zone_off = read_be32(level->zone_adds + (size_t)connect_index * 4);
+                    int32_t target_zone_off = ml.target_off;
                     const uint8_t* target_zone = level->data + target_zone_off;
                     int8_t target_in_top = 0;
                     {
                         /* Amiga find_room computes crossing height and sets StoodInTop
                          * from target lower-roof compare:
                          *   cmp.l ToZoneRoof(a4),d4 ; slt StoodInTop */
-                        int32_t line_len = (int32_t)(int16_t)read_be16(fline + FLINE_LENGTH);
+                        int32_t line_len = (int32_t)ml.length;
                         int32_t cross_y = ctx->newy;
                         if (line_len != 0) {
                             cross_y = compute_crossing_height_asm(ctx, (int64_t)cross_new, (int64_t)cross_old, line_len);
@@ -1341,6 +1364,9 @@ void move_object(MoveContext* ctx, LevelState* level)
         if (xdiff == 0 && zdiff == 0) return;
 
         const uint8_t* zone_data = ctx->objroom;
+        int16_t scratch[LEVEL_EXIT_LIST_MAX];
+        const int16_t *exits = NULL;
+        int exit_count = 0;
 
         int total_iterations = 0;
         const int max_total = 200;
@@ -1351,20 +1377,21 @@ void move_object(MoveContext* ctx, LevelState* level)
 
             if (total_iterations >= max_total) goto phase3;
 
-            {
-                int16_t list_off = read_be16(zone_data + ZONE_EXIT_LIST);
-                const uint8_t* list_ptr = zone_data + list_off;
+            exits = level_room_exit_list(level, zone_data, scratch, &exit_count);
 
-                for (int i = 0; i < 128; i++, total_iterations++) {
+            {
+                for (int i = 0; i < exit_count; i++, total_iterations++) {
                     if (total_iterations >= max_total) goto phase3;
 
-                    int16_t entry = read_be16(list_ptr + i * 2);
+                    int16_t entry = exits[i];
                     if (entry < 0) break; /* Amiga checkwalls: stop at first negative */
                     if (entry >= level->num_floor_lines) continue;
 
                     {
                         const uint8_t* fline = level->floor_lines + entry * FLINE_SIZE;
-                        int result = check_wall_line(ctx, level, fline, zone_data, &xdiff, &zdiff, MOVE_PASS_WALLS);
+                        LevelFloorLine ml;
+                        level_floor_line(level, entry, &ml);
+                        int result = check_wall_line(ctx, level, fline, &ml, zone_data, &xdiff, &zdiff, MOVE_PASS_WALLS);
 
                         /* Amiga MoveObject continues scanning after a slide-adjusted hit
                          * (hitthewall -> checkwalls/checkotherwalls), it does not restart
@@ -1379,13 +1406,10 @@ void move_object(MoveContext* ctx, LevelState* level)
                 if (total_iterations >= max_total) goto phase3;
 
                 {
-                    int16_t list_off = read_be16(zone_data + ZONE_EXIT_LIST);
-                    const uint8_t* list_ptr = zone_data + list_off;
-
-                    for (int i = 0; i < 128; i++, total_iterations++) {
+                    for (int i = 0; i < exit_count; i++, total_iterations++) {
                         if (total_iterations >= max_total) goto phase3;
 
-                        int16_t entry = read_be16(list_ptr + i * 2);
+                        int16_t entry = exits[i];
                         if (entry < 0) {
                             if (entry == -2) break; /* Amiga checkotherwalls terminator */
                             continue;               /* -1 separator */
@@ -1394,7 +1418,9 @@ void move_object(MoveContext* ctx, LevelState* level)
 
                         {
                             const uint8_t* fline = level->floor_lines + entry * FLINE_SIZE;
-                            int result = check_wall_line(ctx, level, fline, zone_data, &xdiff, &zdiff, MOVE_PASS_OTHER);
+                            LevelFloorLine ml;
+                            level_floor_line(level, entry, &ml);
+                            int result = check_wall_line(ctx, level, fline, &ml, zone_data, &xdiff, &zdiff, MOVE_PASS_OTHER);
 
                             if (result == 2) continue;
                             if (result == 3) goto phase3;
@@ -1424,7 +1450,9 @@ void move_object(MoveContext* ctx, LevelState* level)
 
                 {
                     const uint8_t* fline = level->floor_lines + i * FLINE_SIZE;
-                    int result = check_wall_line(ctx, level, fline, zone_data, &xdiff, &zdiff, MOVE_PASS_BRUTE);
+                    LevelFloorLine ml;
+                    level_floor_line(level, i, &ml);
+                    int result = check_wall_line(ctx, level, fline, &ml, zone_data, &xdiff, &zdiff, MOVE_PASS_BRUTE);
 
                     if (result == 2) continue;
                     if (result == 3) return;
@@ -1450,23 +1478,29 @@ void collision_check(MoveContext* ctx, LevelState* level)
         if (mover_width < 0) mover_width = 0;
 
         if (ctx->coll_id >= 0) {
-            int find_i = 0;
-            while (1) {
+            int find_i = spatial_index_object_for_cid(level, ctx->coll_id);
+            if (find_i >= 0) {
                 GameObject* o = (GameObject*)(level->object_data + find_i * OBJECT_SIZE);
-                if (OBJ_CID(o) < 0) break;
-                if (OBJ_CID(o) == ctx->coll_id) {
-                    int mt = o->obj.number;
-                    if (mt >= 0 && mt <= 20) mover_width = col_box_table[mt].width;
-                    break;
-                }
-                find_i++;
+                int mt = o->obj.number;
+                if (mt >= 0 && mt <= 20) mover_width = col_box_table[mt].width;
             }
         }
 
-        /* Iterate all objects and test collision. */
+        /* Iterate objects that can overlap the mover and test collision.
+         * A hit needs max(|dx|,|dz|) <= mover_width + box width, so the grid
+         * rect uses the widest box; -1 from the grid means walk every object. */
         {
+            int cand[SPATIAL_INDEX_MAX_RESULTS];
+            int num_cand = spatial_index_query_radius(level, ctx->newx, ctx->newz,
+                                                      mover_width + COL_BOX_MAX_WIDTH,
+                                                      cand, SPATIAL_INDEX_MAX_RESULTS);
+            int cand_pos = 0;
             int obj_index = 0;
             while (1) {
+                if (num_cand >= 0) {
+                    if (cand_pos >= num_cand) break;
+                    obj_index = cand[cand_pos++];
+                }
                 GameObject* obj = (GameObject*)(level->object_data + obj_index * OBJECT_SIZE);
 
                 if (OBJ_CID(obj) < 0) break;
@@ -19,6 +19,9 @@
 #include "math_tables.h"
 #include "audio.h"
 #include "visibility.h"
+#include "spatial_index.h"
+#include "renderer.h"
+#include "settings.h"
 #include <math.h>
 #include <stdio.h>
 #include <string.h>
@@ -661,9 +664,151 @@ static void get_object_pos(const LevelState *level, int index,
     }
 }
 
-static GameObject *find_free_shot_slot(uint8_t *shots, int16_t *saved_cid)
+/* Enemy vocals/attack sounds come from the object's position, so they fall
+ * off with distance and rank below nearby sounds when voices run short. */
+static void enemy_play_sample(const GameState *state, const GameObject *obj,
+                              int sample_id, int volume)
 {
-    if (!shots) return NULL;
+    int cid = (int)OBJ_CID(obj);
+    if (state->level.object_points && cid >= 0 && cid < state->level.num_object_points) {
+        int16_t x, z;
+        get_object_pos(&state->level, cid, &x, &z);
+        audio_play_sample_at(sample_id, volume, x, z);
+        return;
+    }
+    audio_play_sample(sample_id, volume);
+}
+
+/* -----------------------------------------------------------------------
+ * Shot pool index
+ *
+ * PlayerShotData / NastyShotData slots are free while their zone word is
+ * negative. Each pool keeps a side bitmap of the slots last seen live, so
+ * allocation is a find-first-zero over a few words and the update loops
+ * visit set bits only. Bits are set when a slot is seen live (a handed-out
+ * slot is confirmed by the next allocation or loop step, so bullets spawned
+ * mid-loop are still visited in slot order) and cleared when the
+ * update loop finds it freed - slots are only freed by their own bullet
+ * handler. Allocation stays lowest-free-slot first, as the Amiga scan did.
+ * The index rebuilds when a pool is replaced or resized, and on
+ * objects_shot_pools_invalidate (savegame restore, level unload).
+ * AB3D_DISABLE_SHOT_POOL_INDEX=1 goes back to the linear scans.
+ * ----------------------------------------------------------------------- */
+#define SHOT_POOL_WORDS ((NASTY_SHOT_SLOT_MAX + 63) / 64)
+
+typedef struct {
+    const uint8_t *data;
+    int            slots;
+    int            handed_out;              /* last slot returned, not yet confirmed, or -1 */
+    uint64_t       live[SHOT_POOL_WORDS];   /* bit set: slot seen with zone >= 0 */
+} ShotPoolIndex;
+
+static ShotPoolIndex g_player_shot_index;
+static ShotPoolIndex g_nasty_shot_index;
+static int g_shot_pool_index_state = -1;
+
+static int shot_pool_index_enabled(void)
+{
+    return settings_env_feature_enabled(&g_shot_pool_index_state, "AB3D_DISABLE_SHOT_POOL_INDEX");
+}
+
+static inline int shot_pool_ctz64(uint64_t v)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(v);
+#else
+    int n = 0;
+    while (!(v & 1u)) {
+        v >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+void objects_shot_pools_invalidate(void)
+{
+    g_player_shot_index.data = NULL;
+    g_nasty_shot_index.data = NULL;
+}
+
+/* Index for the pool, rebuilt if it no longer describes (data, slots). */
+static ShotPoolIndex *shot_pool_index(ShotPoolIndex *ix, const uint8_t *data, int slots)
+{
+    if (!data || slots <= 0) return NULL;
+    if (slots > SHOT_POOL_WORDS * 64) slots = SHOT_POOL_WORDS * 64;
+    if (ix->data != data || ix->slots != slots) {
+        ix->data = data;
+        ix->slots = slots;
+        ix->handed_out = -1;
+        memset(ix->live, 0, sizeof(ix->live));
+        for (int i = 0; i < slots; i++) {
+            if (OBJ_ZONE((const GameObject *)(data + (size_t)i * OBJECT_SIZE)) >= 0)
+                ix->live[i >> 6] |= (uint64_t)1 << (i & 63);
+        }
+    }
+    return ix;
+}
+
+/* Lowest free slot, or -1. Bits of slots taken since the last call are
+ * confirmed here, so each live slot is stepped over once. */
+static int shot_pool_find_free(ShotPoolIndex *ix)
+{
+    for (int w = 0; w * 64 < ix->slots; w++) {
+        for (;;) {
+            uint64_t free_bits = ~ix->live[w];
+            if (!free_bits) break;
+            int i = w * 64 + shot_pool_ctz64(free_bits);
+            if (i >= ix->slots) return -1;
+            if (OBJ_ZONE((const GameObject *)(ix->data + (size_t)i * OBJECT_SIZE)) < 0) return i;
+            ix->live[w] |= (uint64_t)1 << (i & 63);
+        }
+    }
+    return -1;
+}
+
+static void shot_pool_note_slot(ShotPoolIndex *ix, int i)
+{
+    uint64_t bit = (uint64_t)1 << (i & 63);
+    if (OBJ_ZONE((const GameObject *)(ix->data + (size_t)i * OBJECT_SIZE)) >= 0)
+        ix->live[i >> 6] |= bit;
+    else
+        ix->live[i >> 6] &= ~bit;
+}
+
+/* First slot >= from with its live bit set, or -1. Confirms the slot last
+ * handed out first, so a shot spawned by the previous handler is seen. */
+static int shot_pool_next_live(ShotPoolIndex *ix, int from)
+{
+    if (ix->handed_out >= 0) {
+        shot_pool_note_slot(ix, ix->handed_out);
+        ix->handed_out = -1;
+    }
+    if (from < 0) from = 0;
+    for (int w = from >> 6; w * 64 < ix->slots; w++) {
+        uint64_t bits = ix->live[w];
+        if (w == (from >> 6)) bits &= ~(uint64_t)0 << (from & 63);
+        if (bits) {
+            int i = w * 64 + shot_pool_ctz64(bits);
+            return (i < ix->slots) ? i : -1;
+        }
+    }
+    return -1;
+}
+
+GameObject *objects_alloc_player_shot(LevelState *level, int16_t *saved_cid)
+{
+    if (!level || !level->player_shot_data) return NULL;
+    uint8_t *shots = level->player_shot_data;
+    if (shot_pool_index_enabled()) {
+        ShotPoolIndex *ix = shot_pool_index(&g_player_shot_index, shots, PLAYER_SHOT_SLOT_COUNT);
+        int i = shot_pool_find_free(ix);
+        if (i < 0) return NULL;
+        ix->handed_out = i;
+        GameObject *candidate = (GameObject *)(shots + (size_t)i * OBJECT_SIZE);
+        if (saved_cid) *saved_cid = OBJ_CID(candidate);
+        return candidate;
+    }
     for (int i = 0; i < PLAYER_SHOT_SLOT_COUNT; i++) {
         GameObject *candidate = (GameObject *)(shots + i * OBJECT_SIZE);
         if (OBJ_ZONE(candidate) < 0) {
@@ -674,6 +819,65 @@ static GameObject *find_free_shot_slot(uint8_t *shots, int16_t *saved_cid)
     return NULL;
 }
 
+GameObject *objects_alloc_nasty_shot(LevelState *level)
+{
+    if (!level || !level->nasty_shot_data) return NULL;
+    uint8_t *shots = level->nasty_shot_data;
+    if (shot_pool_index_enabled()) {
+        ShotPoolIndex *ix = shot_pool_index(&g_nasty_shot_index, shots, level->nasty_shot_slots);
+        int i = ix ? shot_pool_find_free(ix) : -1;
+        if (i >= 0) {
+            ix->handed_out = i;
+            return (GameObject *)(shots + (size_t)i * OBJECT_SIZE);
+        }
+        level->nasty_shot_pool_full = true;
+        return NULL;
+    }
+    for (int i = 0; i < level->nasty_shot_slots; i++) {
+        GameObject *candidate = (GameObject *)(shots + i * OBJECT_SIZE);
+        if (OBJ_ZONE(candidate) < 0) return candidate;
+    }
+    level->nasty_shot_pool_full = true;
+    return NULL;
+}
+
+/* Run object_handle_bullet over one shot pool in slot order. */
+static void objects_update_shot_pool(GameState *state, ShotPoolIndex *ix_store,
+                                     uint8_t *shots, int slots)
+{
+    ShotPoolIndex *ix = shot_pool_index_enabled() ? shot_pool_index(ix_store, shots, slots) : NULL;
+    if (!ix) {
+        for (int j = 0; j < slots; j++) {
+            GameObject *bullet = (GameObject *)(shots + j * OBJECT_SIZE);
+            if (OBJ_ZONE(bullet) < 0) continue;
+            if (bullet->obj.number != OBJ_NBR_BULLET) continue;
+            object_handle_bullet(bullet, state);
+        }
+        return;
+    }
+    for (int j = shot_pool_next_live(ix, 0); j >= 0; j = shot_pool_next_live(ix, j + 1)) {
+        GameObject *bullet = (GameObject *)(shots + (size_t)j * OBJECT_SIZE);
+        if (OBJ_ZONE(bullet) >= 0 && bullet->obj.number == OBJ_NBR_BULLET)
+            object_handle_bullet(bullet, state);
+        shot_pool_note_slot(ix, j);
+    }
+}
+
+/* Grow a pool that ran dry last tick. Runs before any shot iteration so no
+ * caller holds a pointer into the old buffers. */
+static void objects_grow_nasty_shot_pool(LevelState *level)
+{
+    if (!level->nasty_shot_pool_full) return;
+    level->nasty_shot_pool_full = false;
+    if (level->nasty_shot_slots >= NASTY_SHOT_SLOT_MAX) return;
+
+    int old_slots = level->nasty_shot_slots;
+    if (level_grow_nasty_shot_pool(level, old_slots * 2) == 0) {
+        printf("[OBJECTS] Nasty shot pool full: grew %d -> %d slots, object_points=%d\n",
+               old_slots, (int)level->nasty_shot_slots, (int)level->num_object_points);
+    }
+}
+
 /* Amiga Noisevol (sfx importance / channel mix) → PC mixer 0–255 (see SoundPlayer.s). */
 static inline int amiga_noisevol_to_pc(int noisevol)
 {
@@ -1360,6 +1564,7 @@ static void enemy_wander_with_timer(GameObject *obj, const EnemyParams *params,
         uint8_t *pts = state->level.object_points + cid * 8;
         obj_sw(pts, (int16_t)ctx.newx);
         obj_sw(pts + 4, (int16_t)ctx.newz);
+        spatial_index_note_moved((int16_t)cid);
     }
     if (ctx.objroom && state->level.data) {
         int new_zone = level_zone_index_from_room_ptr(&state->level, ctx.objroom);
@@ -1430,61 +1635,71 @@ static bool dead_object_is_runtime_corpse(const GameObject *obj)
  * Called by every enemy handler each tick (Amiga: each NormalAlien / MutantMarine
  * calls CanItBeSeen itself in its prowl/attack routine).
  * ----------------------------------------------------------------------- */
-static void enemy_update_can_see(GameObject *obj, GameState *state)
+/* The LOS queries enemy_update_can_see issues for obj, with viewer_top as it
+ * will be after the in_top clamp. Returns the query count (0..2); bits[] gets
+ * each query's can_see bit. Shared with the parallel prepass so both build
+ * byte-identical queries. */
+static int enemy_can_see_queries(const GameObject *obj, GameState *state,
+                                 LosQuery queries[2], uint8_t bits[2])
 {
     int enemy_zone = object_resolve_zone_index(&state->level, OBJ_ZONE(obj));
-    if (enemy_zone < 0) return;
-    if (obj->obj.in_top && !object_zone_use_upper(&state->level, enemy_zone, 1))
-        obj->obj.in_top = 0;
+    if (enemy_zone < 0) return -1;
+    int8_t viewer_top = obj->obj.in_top;
+    if (viewer_top && !object_zone_use_upper(&state->level, enemy_zone, 1))
+        viewer_top = 0;
     const uint8_t *from_room = level_get_zone_data_ptr(&state->level, (int16_t)enemy_zone);
-    if (!from_room) return;
+    if (!from_room) return -1;
 
     int enemy_cid = (int)OBJ_CID(obj);
     int16_t enemy_x = 0, enemy_z = 0;
     get_object_pos(&state->level, enemy_cid, &enemy_x, &enemy_z);
     int16_t viewer_y = (int16_t)obj_w(obj->raw + 4);
 
-    obj->obj.can_see = 0;
-
-    /* Player 1 -> bit 0 */
-    {
-        int plr_zone = object_resolve_zone_index(&state->level, state->plr1.zone);
+    /* Player 1 -> bit 0, player 2 -> bit 1; both traced from the same room. */
+    int num_queries = 0;
+    for (int p = 0; p < 2; p++) {
+        const PlayerState *plr = (p == 0) ? &state->plr1 : &state->plr2;
+        int plr_zone = object_resolve_zone_index(&state->level, plr->zone);
         const uint8_t *to_room = (plr_zone >= 0)
             ? level_get_zone_data_ptr(&state->level, (int16_t)plr_zone)
             : NULL;
-        if (to_room) {
-            int16_t plr_zone_word = be16(to_room + 0);
-            int16_t plr_x    = (int16_t)state->plr1.p_xoff;
-            int16_t plr_z    = (int16_t)state->plr1.p_zoff;
-            int16_t target_y = (int16_t)(state->plr1.p_yoff >> 7);
-            uint8_t vis = can_it_be_seen(&state->level,
-                                         from_room, to_room, plr_zone_word,
-                                         enemy_x, enemy_z, viewer_y,
-                                         plr_x, plr_z, target_y,
-                                         obj->obj.in_top,
-                                         state->plr1.stood_in_top, 0);
-            if (vis) obj->obj.can_see |= 0x01;
-        }
-    }
-    /* Player 2 -> bit 1 */
-    {
-        int plr_zone = object_resolve_zone_index(&state->level, state->plr2.zone);
-        const uint8_t *to_room = (plr_zone >= 0)
-            ? level_get_zone_data_ptr(&state->level, (int16_t)plr_zone)
-            : NULL;
-        if (to_room) {
-            int16_t plr_zone_word = be16(to_room + 0);
-            int16_t plr_x    = (int16_t)state->plr2.p_xoff;
-            int16_t plr_z    = (int16_t)state->plr2.p_zoff;
-            int16_t target_y = (int16_t)(state->plr2.p_yoff >> 7);
-            uint8_t vis = can_it_be_seen(&state->level,
-                                         from_room, to_room, plr_zone_word,
-                                         enemy_x, enemy_z, viewer_y,
-                                         plr_x, plr_z, target_y,
-                                         obj->obj.in_top,
-                                         state->plr2.stood_in_top, 0);
-            if (vis) obj->obj.can_see |= 0x02;
-        }
+        if (!to_room) continue;
+
+        LosQuery *q = &queries[num_queries];
+        q->from_room   = from_room;
+        q->to_room     = to_room;
+        q->to_zone_id  = be16(to_room + 0);
+        q->viewer_x    = enemy_x;
+        q->viewer_z    = enemy_z;
+        q->viewer_y    = viewer_y;
+        q->target_x    = (int16_t)plr->p_xoff;
+        q->target_z    = (int16_t)plr->p_zoff;
+        q->target_y    = (int16_t)(plr->p_yoff >> 7);
+        q->viewer_top  = viewer_top;
+        q->target_top  = plr->stood_in_top;
+        q->full_height = 0;
+        bits[num_queries] = (uint8_t)(1u << p);
+        num_queries++;
+    }
+    return num_queries;
+}
+
+static void enemy_update_can_see(GameObject *obj, GameState *state)
+{
+    LosQuery queries[2];
+    uint8_t query_bit[2];
+    uint8_t vis[2];
+    int enemy_zone = object_resolve_zone_index(&state->level, OBJ_ZONE(obj));
+    if (enemy_zone < 0) return;
+    if (obj->obj.in_top && !object_zone_use_upper(&state->level, enemy_zone, 1))
+        obj->obj.in_top = 0;
+    int num_queries = enemy_can_see_queries(obj, state, queries, query_bit);
+    if (num_queries < 0) return;
+
+    obj->obj.can_see = 0;
+    can_it_be_seen_batch(&state->level, queries, num_queries, vis);
+    for (int i = 0; i < num_queries; i++) {
+        if (vis[i]) obj->obj.can_see |= query_bit[i];
     }
 }
 
@@ -1532,7 +1747,7 @@ static void enemy_tick_sec_timer_vocal(GameObject *obj, GameState *state,
         int vol = (noisevol * 255 + 400) / 800;
         if (vol < 12) vol = 12;
         if (vol > 255) vol = 255;
-        audio_play_sample(samp, vol);
+        enemy_play_sample(state, obj, samp, vol);
 
         int tspan = (int)params->hiss_timer_range + 1;
         if (tspan < 1) tspan = 1;
@@ -1700,6 +1915,7 @@ static bool enemy_spawn_tree_eyeball(GameObject *tree, GameState *state)
                 uint8_t *pt = state->level.object_points + cid * 8;
                 obj_sw(pt, tree_x);
                 obj_sw(pt + 4, tree_z);
+                spatial_index_note_moved((int16_t)cid);
             }
         }
         return true;
@@ -1839,11 +2055,123 @@ static void game_apply_all_keys_from_level(const GameState *state)
  *
  * Translated from Anims.s ObjMoveAnim.
  * ----------------------------------------------------------------------- */
+/* -----------------------------------------------------------------------
+ * Parallel LOS prepass
+ *
+ * enemy_update_can_see is most of the enemy think time on crowded levels.
+ * Before the handler loop, the queries every awake enemy is about to issue
+ * are traced on the render worker pool and seeded into the main thread's
+ * LOS memo; the handlers then run serially exactly as before. A query whose
+ * inputs are unchanged by the time its enemy runs hits the memo, one that
+ * changed (the enemy fell, an earlier handler moved it) misses and is traced
+ * inline, so results are identical to the serial path.
+ * AB3D_DISABLE_PARALLEL_AI=1 skips the prepass.
+ * ----------------------------------------------------------------------- */
+#define ENEMY_LOS_PREPASS_MIN_OBJECTS 8   /* fewer: not worth waking the pool */
+#define ENEMY_LOS_PREPASS_PER_WORKER  4
+#define ENEMY_LOS_PREPASS_MAX_OBJECTS 256
+
+typedef struct {
+    const LevelState *level;
+    int               count;
+    LosQuery          queries[ENEMY_LOS_PREPASS_MAX_OBJECTS][2];
+    uint8_t           query_count[ENEMY_LOS_PREPASS_MAX_OBJECTS];
+    uint8_t           vis[ENEMY_LOS_PREPASS_MAX_OBJECTS][2];
+} EnemyLosPrepass;
+
+static EnemyLosPrepass g_enemy_los_prepass;
+static int g_enemy_los_prepass_state = -1;
+
+static int enemy_los_prepass_enabled(void)
+{
+    return settings_env_feature_enabled(&g_enemy_los_prepass_state, "AB3D_DISABLE_PARALLEL_AI");
+}
+
+static void enemy_los_prepass_job(int index, void *userdata)
+{
+    EnemyLosPrepass *pp = (EnemyLosPrepass *)userdata;
+    can_it_be_seen_batch(pp->level, pp->queries[index], pp->query_count[index], pp->vis[index]);
+}
+
+static void enemy_los_prepass(GameState *state)
+{
+    EnemyLosPrepass *pp = &g_enemy_los_prepass;
+    const LevelState *level = &state->level;
+    uint8_t bits[2];
+
+    if (!enemy_los_prepass_enabled() || !can_it_be_seen_cache_enabled()) return;
+    if (!level->object_data || !level->data || !level->floor_lines || !level->zone_adds) return;
+
+    pp->level = level;
+    pp->count = 0;
+    for (int i = 0; i < ENEMY_LOS_PREPASS_MAX_OBJECTS; i++) {
+        const GameObject *obj = (const GameObject *)(level->object_data + (size_t)i * OBJECT_SIZE);
+        if (OBJ_CID(obj) < 0) break;
+        if (OBJ_ZONE(obj) < 0 || NASTY_LIVES(*obj) <= 0) continue;
+        if (!object_type_uses_worry_gate(obj->obj.number) || obj->obj.worry == 0) continue;
+        int n = enemy_can_see_queries(obj, state, pp->queries[pp->count], bits);
+        if (n <= 0) continue;
+        pp->query_count[pp->count++] = (uint8_t)n;
+    }
+    if (pp->count < ENEMY_LOS_PREPASS_MIN_OBJECTS) return;
+
+    /* Seed in object order so memo slot collisions resolve the same way every run. */
+    renderer_parallel_for(pp->count, ENEMY_LOS_PREPASS_PER_WORKER, enemy_los_prepass_job, pp);
+    for (int k = 0; k < pp->count; k++) {
+        can_it_be_seen_seed_results(level, pp->queries[k], pp->vis[k], pp->query_count[k]);
+    }
+}
+
+/* Object types whose display frame is angle*4+step from the camera. */
+static const int8_t k_display_facing_types[] = {
+    OBJ_NBR_ALIEN, OBJ_NBR_ROBOT, OBJ_NBR_BIG_NASTY, OBJ_NBR_FLYING_NASTY, OBJ_NBR_EYEBALL,
+    OBJ_NBR_MARINE, OBJ_NBR_TOUGH_MARINE, OBJ_NBR_FLAME_MARINE,
+    OBJ_NBR_WORM, OBJ_NBR_HUGE_RED_THING, OBJ_NBR_SMALL_RED_THING, OBJ_NBR_TREE,
+};
+
+static int object_display_facing_type(int8_t obj_type)
+{
+    for (size_t k = 0; k < sizeof(k_display_facing_types); k++) {
+        if (k_display_facing_types[k] == obj_type) return 1;
+    }
+    return 0;
+}
+
+/* Refresh display-facing for the current camera while preserving the
+ * walk/attack sub-frame in the low 2 bits (Amiga: frame=angle*4+step).
+ * vis_zones (256 flags) limits it to visible zones; NULL refreshes all. */
+static void objects_refresh_display_facing(GameState *state, const uint8_t *vis_zones)
+{
+    const PlayerState *view_plr = (state->mode == MODE_SLAVE)
+        ? &state->plr2 : &state->plr1;
+    int16_t view_x = (int16_t)(view_plr->xoff >> 16);
+    int16_t view_z = (int16_t)(view_plr->zoff >> 16);
+    int obj_index = 0;
+    while (1) {
+        GameObject *obj = get_object(&state->level, obj_index);
+        if (!obj) break;
+        if (OBJ_CID(obj) < 0) break;
+        obj_index++;
+        int16_t obj_zone = OBJ_ZONE(obj);
+        if (obj_zone < 0 || NASTY_LIVES(*obj) <= 0) continue;
+        if (vis_zones && (obj_zone >= 256 || !vis_zones[obj_zone])) continue;
+        int8_t obj_type = obj->obj.number;
+        if (!object_display_facing_type(obj_type)) continue;
+        if (obj_type == OBJ_NBR_ROBOT &&
+            (uint8_t)obj->raw[6] == (uint8_t)OBJ_3D_SPRITE) {
+            continue; /* keep Robot.s ROBFRAME frame in raw+10 */
+        }
+        enemy_update_display_facing_frame(obj, state, view_x, view_z);
+    }
+}
+
 void objects_update(GameState *state)
 {
     const int zone_slots = level_zone_slot_count(&state->level);
 
     gib_impact_splat_sound_this_update = false;
+    objects_grow_nasty_shot_pool(&state->level);
+    spatial_index_begin_tick(&state->level);
 
     /* 1. Update player zones (from room pointer if available) */
     /* Zone is already maintained by player_full_control -> MoveObject */
@@ -1884,6 +2212,8 @@ void objects_update(GameState *state)
     }
 
     lift_routine(state);
+    /* Doors and lifts have moved: drop LOS results traced against old heights. */
+    can_it_be_seen_flush_results();
 
     /* Water animations */
     do_water_anims(state);
@@ -1903,6 +2233,7 @@ void objects_update(GameState *state)
     /* Advance walk-cycle counter (Amiga: alanptr steps through alan[] table each game tick).
      * walk_cycle 0-31 wraps; walk_step = walk_cycle >> 3 gives 0-3 (8 ticks per step). */
     walk_cycle = (uint8_t)((walk_cycle + (uint8_t)state->temp_frames) & 31u);
+    enemy_los_prepass(state);
 
     int obj_index = 0;
     while (1) {
@@ -2080,54 +2411,21 @@ void objects_update(GameState *state)
             break;
         }
 
-        /* Refresh display-facing for the current camera while preserving the
-         * walk/attack sub-frame in the low 2 bits (Amiga: frame=angle*4+step). */
-        if (NASTY_LIVES(*obj) > 0) {
-            switch (obj_type) {
-            case OBJ_NBR_ALIEN: case OBJ_NBR_ROBOT: case OBJ_NBR_BIG_NASTY:
-            case OBJ_NBR_FLYING_NASTY: case OBJ_NBR_EYEBALL:
-            case OBJ_NBR_MARINE: case OBJ_NBR_TOUGH_MARINE: case OBJ_NBR_FLAME_MARINE:
-            case OBJ_NBR_WORM: case OBJ_NBR_HUGE_RED_THING: case OBJ_NBR_SMALL_RED_THING:
-            case OBJ_NBR_TREE:
-                {
-                    if (obj_type == OBJ_NBR_ROBOT &&
-                        (uint8_t)obj->raw[6] == (uint8_t)OBJ_3D_SPRITE) {
-                        break; /* keep Robot.s ROBFRAME frame in raw+10 */
-                    }
-                    const PlayerState *view_plr = (state->mode == MODE_SLAVE)
-                        ? &state->plr2 : &state->plr1;
-                    int16_t view_x = (int16_t)(view_plr->xoff >> 16);
-                    int16_t view_z = (int16_t)(view_plr->zoff >> 16);
-                    enemy_update_display_facing_frame(obj, state, view_x, view_z);
-                }
-                break;
-            default:
-                break;
-            }
-        }
-
         obj_index++;
     }
 
     /* Process nasty_shot_data bullets and gibs (not in object_data list) */
     if (state->level.nasty_shot_data) {
-        uint8_t *shots = state->level.nasty_shot_data;
-        for (int j = 0; j < NASTY_SHOT_SLOT_COUNT; j++) {
-            GameObject *bullet = (GameObject *)(shots + j * OBJECT_SIZE);
-            if (OBJ_ZONE(bullet) < 0) continue;
-            if (bullet->obj.number != OBJ_NBR_BULLET) continue;
-            object_handle_bullet(bullet, state);
-        }
+        objects_update_shot_pool(state, &g_nasty_shot_index,
+                                 state->level.nasty_shot_data, state->level.nasty_shot_slots);
     }
     if (state->level.player_shot_data) {
-        uint8_t *shots = state->level.player_shot_data;
-        for (int j = 0; j < PLAYER_SHOT_SLOT_COUNT; j++) {
-            GameObject *bullet = (GameObject *)(shots + j * OBJECT_SIZE);
-            if (OBJ_ZONE(bullet) < 0) continue;
-            if (bullet->obj.number != OBJ_NBR_BULLET) continue;
-            object_handle_bullet(bullet, state);
-        }
+        objects_update_shot_pool(state, &g_player_shot_index,
+                                 state->level.player_shot_data, PLAYER_SHOT_SLOT_COUNT);
     }
+
+    /* Handlers are done for this tick: refresh display-facing for every live enemy. */
+    objects_refresh_display_facing(state, NULL);
 }
 
 /* -----------------------------------------------------------------------
@@ -2148,46 +2446,7 @@ void objects_update_sprite_frames(GameState *state)
         for (int z = 0; z < 256; z++) vis_zones[z] = 1;
     }
 
-    const PlayerState *view_plr = (state->mode == MODE_SLAVE)
-        ? &state->plr2 : &state->plr1;
-    int16_t view_x = (int16_t)(view_plr->xoff >> 16);
-    int16_t view_z = (int16_t)(view_plr->zoff >> 16);
-
-    int obj_index = 0;
-    while (1) {
-        GameObject *obj = get_object(&state->level, obj_index);
-        if (!obj) break;
-        if (OBJ_CID(obj) < 0) break;
-        int16_t obj_zone = OBJ_ZONE(obj);
-        if (obj_zone < 0 || obj_zone >= 256 || !vis_zones[obj_zone]) {
-            obj_index++;
-            continue;
-        }
-        if (NASTY_LIVES(*obj) <= 0) {
-            obj_index++;
-            continue;
-        }
-
-        int8_t obj_type = obj->obj.number;
-        switch (obj_type) {
-        case OBJ_NBR_ALIEN: case OBJ_NBR_ROBOT: case OBJ_NBR_BIG_NASTY:
-        case OBJ_NBR_FLYING_NASTY: case OBJ_NBR_EYEBALL:
-        case OBJ_NBR_MARINE: case OBJ_NBR_TOUGH_MARINE: case OBJ_NBR_FLAME_MARINE:
-        case OBJ_NBR_WORM: case OBJ_NBR_HUGE_RED_THING: case OBJ_NBR_SMALL_RED_THING:
-        case OBJ_NBR_TREE:
-            {
-                if (obj_type == OBJ_NBR_ROBOT &&
-                    (uint8_t)obj->raw[6] == (uint8_t)OBJ_3D_SPRITE) {
-                    break; /* keep Robot.s ROBFRAME frame in raw+10 */
-                }
-                enemy_update_display_facing_frame(obj, state, view_x, view_z);
-            }
-            break;
-        default:
-            break;
-        }
-        obj_index++;
-    }
+    objects_refresh_display_facing(state, vis_zones);
 }
 
 /* -----------------------------------------------------------------------
@@ -2237,7 +2496,7 @@ static void enemy_handle_big_red_variant(GameObject *obj, GameState *state, bool
         if (fourth_timer < 20) {
             fourth_timer = 30;
             OBJ_SET_TD_W(obj, ENEMY_THIRD_TIMER_OFF, (int16_t)(100 + (rand() & 0x7F)));
-            audio_play_sample(9, 100);
+            enemy_play_sample(state, obj, 9, 100);
             if (big_claws) {
                 enemy_fire_at_player(obj, state, target_player, 2, 10, 64, 6);
             } else {
@@ -2377,7 +2636,7 @@ void object_handle_robot(GameObject *obj, GameState *state)
                     }
                     OBJ_SET_TD_W(obj, ENEMY_THIRD_TIMER_OFF, third_after);
                 }
-                audio_play_sample(9, 100);
+                enemy_play_sample(state, obj, 9, 100);
                 enemy_fire_at_player(obj, state, target_player, 4, 10, 16, 3);
                 fired_this_tick = true;
             }
@@ -2475,7 +2734,7 @@ void object_handle_worm(GameObject *obj, GameState *state)
                 }
                 OBJ_SET_TD_W(obj, ENEMY_THIRD_TIMER_OFF, third_after);
             }
-            audio_play_sample(9, 100);
+            enemy_play_sample(state, obj, 9, 100);
             enemy_fire_at_player(obj, state, target_player, 5, 10, 16, 3);
         }
         OBJ_SET_TD_W(obj, ENEMY_FOURTH_TIMER_OFF, fourth_timer);
@@ -2601,6 +2860,7 @@ static int32_t robot_track_target(GameObject *obj, const EnemyParams *params,
             uint8_t *pts = state->level.object_points + cid * 8;
             obj_sw(pts, (int16_t)ctx.newx);
             obj_sw(pts + 4, (int16_t)ctx.newz);
+            spatial_index_note_moved((int16_t)cid);
         }
 
         if (ctx.objroom && state->level.data) {
@@ -2809,6 +3069,7 @@ static int32_t enemy_track_target_with_turn(GameObject *obj, const EnemyParams *
         uint8_t *pts = state->level.object_points + cid * 8;
         obj_sw(pts, (int16_t)ctx.newx);
         obj_sw(pts + 4, (int16_t)ctx.newz);
+        spatial_index_note_moved((int16_t)cid);
     }
 
     if (ctx.objroom && state->level.data) {
@@ -2899,19 +3160,19 @@ void object_handle_marine(GameObject *obj, GameState *state)
             (type != OBJ_NBR_MARINE && fourth_timer < 20)) {
             if (type == OBJ_NBR_MARINE) {
                 OBJ_SET_TD_W(obj, ENEMY_THIRD_TIMER_OFF, 50 + (int16_t)(rand() & 0xFF));
-                if (params->attack_sound >= 0) audio_play_sample(params->attack_sound, 100);
+                if (params->attack_sound >= 0) enemy_play_sample(state, obj, params->attack_sound, 100);
                 marine_hitscan_burst(obj, state, target_player, 1, 4);
             } else if (type == OBJ_NBR_TOUGH_MARINE) {
                 OBJ_SET_TD_W(obj, ENEMY_THIRD_TIMER_OFF, 50 + (int16_t)(rand() & 0x1F));
-                if (params->attack_sound >= 0) audio_play_sample(params->attack_sound, 100);
+                if (params->attack_sound >= 0) enemy_play_sample(state, obj, params->attack_sound, 100);
                 enemy_fire_at_player(obj, state, target_player, 6, 7, 32, 4);
             } else if (type == OBJ_NBR_FLAME_MARINE) {
                 fourth_timer = 25;
-                if (params->attack_sound >= 0) audio_play_sample(params->attack_sound, 100);
+                if (params->attack_sound >= 0) enemy_play_sample(state, obj, params->attack_sound, 100);
                 enemy_fire_at_player(obj, state, target_player, 3, 7, 8, 2);
             } else {
                 OBJ_SET_TD_W(obj, ENEMY_THIRD_TIMER_OFF, 200 + (int16_t)(rand() & 0xFF));
-                if (params->attack_sound >= 0) audio_play_sample(params->attack_sound, 100);
+                if (params->attack_sound >= 0) enemy_play_sample(state, obj, params->attack_sound, 100);
                 marine_hitscan_burst(obj, state, target_player, 5, 2);
             }
             OBJ_SET_TD_W(obj, ENEMY_FOURTH_TIMER_OFF, fourth_timer);
@@ -2965,7 +3226,7 @@ void object_handle_big_nasty(GameObject *obj, GameState *state)
             sec_timer = (int16_t)(50 + (rand() & 7));
             int vol = (200 * 255 + 400) / 800;
             if (vol > 255) vol = 255;
-            audio_play_sample(9, vol);
+            enemy_play_sample(state, obj, 9, vol);
             enemy_fire_at_player(obj, state, target_player, 1, 10, 16, 4);
         }
         OBJ_SET_TD_W(obj, ENEMY_SEC_TIMER_OFF, sec_timer);
@@ -3222,13 +3483,7 @@ void object_handle_gas_pipe(GameObject *obj, GameState *state)
     if (sec == 4) audio_play_sample(22, 200);
 
     /* Spawn one flame projectile (Amiga: at most one per handler call). */
-    if (!state->level.nasty_shot_data) return;
-    uint8_t *shots = state->level.nasty_shot_data;
-    GameObject *bullet = NULL;
-    for (int i = 0; i < NASTY_SHOT_SLOT_COUNT; i++) {
-        GameObject *c = (GameObject*)(shots + i * OBJECT_SIZE);
-        if (OBJ_ZONE(c) < 0) { bullet = c; break; }
-    }
+    GameObject *bullet = objects_alloc_nasty_shot(&state->level);
     if (!bullet) return;
 
     SHOT_ANIM(*bullet) = 0;
@@ -3257,6 +3512,7 @@ void object_handle_gas_pipe(GameObject *obj, GameState *state)
             uint8_t *sp = state->level.object_points + self_idx * 8;
             uint8_t *dp = state->level.object_points + bul_idx * 8;
             memcpy(dp, sp, 8);
+            spatial_index_note_moved((int16_t)bul_idx);
         }
     }
 
@@ -3874,6 +4130,7 @@ void object_handle_bullet(GameObject *obj, GameState *state)
     /* Update position in ObjectPoints */
     obj_sl(bullet_pts, final_bx_fp);
     obj_sl(bullet_pts + 4, final_bz_fp);
+    spatial_index_note_moved((int16_t)idx);
 
     /* Amiga ItsABullet: move.w (accypos>>7),4(a0). */
     obj_sw(obj->raw + 4, (int16_t)(accypos >> 7));
@@ -3905,8 +4162,20 @@ void object_handle_bullet(GameObject *obj, GameState *state)
     GameObject *best_target = NULL;
 
     if (enemy_flags != 0 && state->level.object_data) {
+    /* Only objects within the widest hit radius of the swept segment can be
+     * hit; -1 from the grid means walk every object. */
+    int cand[SPATIAL_INDEX_MAX_RESULTS];
+    int num_cand = spatial_index_query_segment(&state->level,
+                                               seg_start_x, seg_start_z, seg_end_x, seg_end_z,
+                                               COL_BOX_MAX_WIDTH + 40, cand,
+                                               SPATIAL_INDEX_MAX_RESULTS);
+    int cand_pos = 0;
     int check_idx = 0;
     while (1) {
+        if (num_cand >= 0) {
+            if (cand_pos >= num_cand) break;
+            check_idx = cand[cand_pos++];
+        }
         GameObject *target = (GameObject*)(state->level.object_data +
                              check_idx * OBJECT_SIZE);
         if (OBJ_CID(target) < 0) break;
@@ -4068,6 +4337,7 @@ void object_handle_bullet(GameObject *obj, GameState *state)
     /* Pop at resolved hit point so impact doesn't appear to pass through. */
     obj_sl(bullet_pts, (int32_t)best_hit_x << 16);
     obj_sl(bullet_pts + 4, (int32_t)best_hit_z << 16);
+    spatial_index_note_moved((int16_t)idx);
     obj_sw(obj->raw + 4, (int16_t)(accypos >> 7));
 }
 
@@ -4835,15 +5105,7 @@ void enemy_fire_at_player(GameObject *obj, GameState *state,
     PlayerState *plr = (player_num == 1) ? &state->plr1 : &state->plr2;
 
     /* Find free slot in NastyShotData */
-    uint8_t *shots = state->level.nasty_shot_data;
-    GameObject *bullet = NULL;
-    for (int i = 0; i < NASTY_SHOT_SLOT_COUNT; i++) {
-        GameObject *candidate = (GameObject*)(shots + i * OBJECT_SIZE);
-        if (OBJ_ZONE(candidate) < 0) {
-            bullet = candidate;
-            break;
-        }
-    }
+    GameObject *bullet = objects_alloc_nasty_shot(&state->level);
     if (!bullet) return;
 
     /* Calculate direction to player (AlienControl.s FireAtPlayer1 lines 360-411) */
@@ -4899,6 +5161,7 @@ void enemy_fire_at_player(GameObject *obj, GameState *state,
         uint8_t *pts = state->level.object_points + bul_idx * 8;
         obj_sl(pts, (int32_t)hctx.newx << 16);
         obj_sl(pts + 4, (int32_t)hctx.newz << 16);
+        spatial_index_note_moved((int16_t)bul_idx);
 
         if (state->level.prev_object_points) {
             uint8_t *prev_pts = state->level.prev_object_points + bul_idx * 8;
@@ -4996,7 +5259,7 @@ static void spawn_blast_particles(GameState *state, int32_t x, int32_t z, int32_
 
         for (int n = 0; n < 3; n++) {
             int16_t saved_cid = -1;
-            GameObject *part = find_free_shot_slot(shot_pool, &saved_cid);
+            GameObject *part = objects_alloc_player_shot(&state->level, &saved_cid);
             if (!part) return;
 
             part->obj.number = OBJ_NBR_BULLET;
@@ -5070,6 +5333,7 @@ static void spawn_blast_particles(GameState *state, int32_t x, int32_t z, int32_
                 uint8_t *pt = state->level.object_points + (uint32_t)saved_cid * 8u;
                 obj_sl(pt,     (int32_t)ctx.newx << 16);
                 obj_sl(pt + 4, (int32_t)ctx.newz << 16);
+                spatial_index_note_moved(saved_cid);
 
                 if (state->level.prev_object_points) {
                     uint8_t *prev_pt = state->level.prev_object_points + (uint32_t)saved_cid * 8u;
@@ -5151,6 +5415,25 @@ static inline uint8_t damage_accumulate_u8(uint8_t current, int32_t add)
     return (uint8_t)(current + (uint8_t)add); /* Amiga add.b wrap */
 }
 
+/* Blast falloff reaches zero at (36 << 3) past the target's radius; +4
+ * covers compute_blast_dist_sqrt rounding. */
+#define BLAST_MAX_REACH (36 * 8 + COL_BOX_MAX_WIDTH + 4)
+
+/* Would the full compute_blast list walk have reached obj as a target?
+ * (Player objects normally sit at the head of the list.) */
+static bool compute_blast_obj_in_list(GameState *state, const GameObject *obj)
+{
+    const uint8_t *base = state->level.object_data;
+    if (!obj || !base || (const uint8_t *)obj < base) return false;
+    size_t off = (size_t)((const uint8_t *)obj - base);
+    if (off % OBJECT_SIZE != 0) return false;
+    int index = (int)(off / OBJECT_SIZE);
+    for (int obj_index = 0; obj_index <= index; obj_index++) {
+        if (OBJ_CID(get_object(&state->level, obj_index)) < 0) return false;
+    }
+    return OBJ_ZONE(obj) >= 0 && compute_blast_can_hit_obj_type(obj->obj.number);
+}
+
 static void compute_blast_apply_target(GameState *state,
                                        const uint8_t *from_room,
                                        int zone_slots,
@@ -5285,7 +5568,23 @@ void compute_blast(GameState *state, int32_t x, int32_t z, int32_t y,
     bool plr1_in_list = false;
     bool plr2_in_list = false;
 
-    for (int obj_index = 0;; obj_index++) {
+    /* Targets further than BLAST_MAX_REACH fall outside the damage buckets,
+     * so only grid candidates near the blast are traced. The player-in-list
+     * flags still describe the whole list. -1 from the grid: walk it all. */
+    int cand[SPATIAL_INDEX_MAX_RESULTS];
+    int num_cand = spatial_index_query_radius(&state->level, viewer_x, viewer_z,
+                                              BLAST_MAX_REACH, cand,
+                                              SPATIAL_INDEX_MAX_RESULTS);
+    if (num_cand >= 0) {
+        plr1_in_list = compute_blast_obj_in_list(state, plr1_obj);
+        plr2_in_list = compute_blast_obj_in_list(state, plr2_obj);
+    }
+    for (int k = 0;; k++) {
+        int obj_index = k;
+        if (num_cand >= 0) {
+            if (k >= num_cand) break;
+            obj_index = cand[k];
+        }
         GameObject *obj = get_object(&state->level, obj_index);
         if (!obj || OBJ_CID(obj) < 0) break;
         if (OBJ_ZONE(obj) < 0) continue;
@@ -5502,6 +5801,7 @@ void use_player1(GameState *state)
             uint8_t *pts = state->level.object_points + idx * 8;
             obj_sl(pts, state->plr1.xoff);
             obj_sl(pts + 4, state->plr1.zoff);
+            spatial_index_note_moved((int16_t)idx);
         }
     }
 
@@ -5571,6 +5871,7 @@ void use_player2(GameState *state)
             uint8_t *pts = state->level.object_points + idx * 8;
             obj_sl(pts, state->plr2.xoff);
             obj_sl(pts + 4, state->plr2.zoff);
+            spatial_index_note_moved((int16_t)idx);
         }
     }
 
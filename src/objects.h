@@ -89,6 +89,18 @@ void explosion_spawn(GameState *state, int16_t x, int16_t z, int16_t zone, int8_
                     int8_t size_scale, int8_t anim_rate);
 void explosion_advance(GameState *state);
 
+/* First free NastyShotData slot (bullets/gibs), or NULL. A full pool is
+ * flagged and grown at the start of the next objects_update. */
+GameObject *objects_alloc_nasty_shot(LevelState *level);
+
+/* First free PlayerShotData slot (player projectiles, impacts, blast
+ * particles), or NULL. *saved_cid gets the slot's level-baked CID. */
+GameObject *objects_alloc_player_shot(LevelState *level, int16_t *saved_cid);
+
+/* Drop the shot pool free-slot indices; call after shot pools are rewritten
+ * wholesale (savegame restore, level unload). */
+void objects_shot_pools_invalidate(void);
+
 /* Utility: player-object pickup distance check */
 int pickup_distance_check(GameObject *obj, GameState *state, int player_num);
 
@@ -17,6 +17,11 @@
 #include "audio.h"
 #include "io.h"
 #include "renderer.h"
+#include "spatial_index.h"
+#include "asset_loader.h"
+#include "settings.h"
+#include "control_loop.h"
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
@@ -129,19 +134,6 @@ static void player_cycle_weapon(PlayerState *plr, int direction)
     }
 }
 
-static GameObject *find_free_player_shot_slot(uint8_t *shots, int16_t *saved_cid)
-{
-    if (!shots) return NULL;
-    for (int i = 0; i < PLAYER_SHOT_SLOT_COUNT; i++) {
-        GameObject *candidate = (GameObject *)(shots + i * OBJECT_SIZE);
-        if (OBJ_ZONE(candidate) < 0) {
-            if (saved_cid) *saved_cid = OBJ_CID(candidate);
-            return candidate;
-        }
-    }
-    return NULL;
-}
-
 static uint8_t *resolve_player_room_ptr(GameState *state, const PlayerState *plr)
 {
     if (!state || !state->level.data || !plr) return NULL;
@@ -313,7 +305,7 @@ static void spawn_instant_hit_effect(GameState *state, const PlayerState *plr, i
     if (!shot_pool) return;
 
     int16_t saved_cid = -1;
-    GameObject *impact = find_free_player_shot_slot(shot_pool, &saved_cid);
+    GameObject *impact = objects_alloc_player_shot(&state->level, &saved_cid);
     if (!impact) return;
 
     obj_sw(impact->raw, saved_cid);
@@ -328,6 +320,7 @@ static void spawn_instant_hit_effect(GameState *state, const PlayerState *plr, i
             uint8_t *dst = state->level.object_points + (uint32_t)(uint16_t)saved_cid * 8u;
             dst[0] = src[0]; dst[1] = src[1];
             dst[4] = src[4]; dst[5] = src[5];
+            spatial_index_note_moved(saved_cid);
         }
     }
 
@@ -379,7 +372,7 @@ static void spawn_instant_miss_effect_target(GameState *state, const PlayerState
         return;
 
     int16_t saved_cid = -1;
-    GameObject *impact = find_free_player_shot_slot(state->level.player_shot_data, &saved_cid);
+    GameObject *impact = objects_alloc_player_shot(&state->level, &saved_cid);
     if (!impact) return;
     obj_sw(impact->raw, saved_cid);
 
@@ -387,6 +380,7 @@ static void spawn_instant_miss_effect_target(GameState *state, const PlayerState
         uint8_t *pt = state->level.object_points + (uint32_t)(uint16_t)saved_cid * 8u;
         obj_sw(pt, hit_x);
         obj_sw(pt + 4, hit_z);
+        spatial_index_note_moved(saved_cid);
     }
 
     init_instant_pop_slot(impact, gun_idx,
@@ -419,7 +413,7 @@ static void spawn_instant_miss_effect_no_target(GameState *state, const PlayerSt
         return;
 
     int16_t saved_cid = -1;
-    GameObject *impact = find_free_player_shot_slot(state->level.player_shot_data, &saved_cid);
+    GameObject *impact = objects_alloc_player_shot(&state->level, &saved_cid);
     if (!impact) return;
     obj_sw(impact->raw, saved_cid);
 
@@ -428,6 +422,7 @@ static void spawn_instant_miss_effect_no_target(GameState *state, const PlayerSt
         uint8_t *pt = state->level.object_points + (uint32_t)(uint16_t)saved_cid * 8u;
         obj_sw(pt, hit_x);
         obj_sw(pt + 4, hit_z);
+        spatial_index_note_moved(saved_cid);
     }
 
     init_instant_pop_slot(impact, gun_idx,
@@ -926,6 +921,16 @@ static void player_sim_control(PlayerState *plr, const ControlMode *ctrl,
     }
 }
 
+int player_look_angle_scale(const ControlMode *ctrl)
+{
+    /* Same dispatch as player_sim_control: angle units one mouse X count turns the view. */
+    if (!ctrl) return 0;
+    if (ctrl->mouse_kbd) return MOUSE_SENSITIVITY;
+    if (ctrl->mouse) return 1;
+    if (ctrl->keys || ctrl->joy) return 0;
+    return MOUSE_SENSITIVITY;
+}
+
 /* -----------------------------------------------------------------------
  * PLR1_Control / PLR2_Control - Full control + collision + room update
  *
@@ -1314,6 +1319,11 @@ static const KeyBindings default_keys = {
     .look_behind    = 0x28,  /* L */
 };
 
+const KeyBindings *player_default_keys(void)
+{
+    return &default_keys;
+}
+
 void player1_snapshot(GameState *state)
 {
     PlayerState *p = &state->plr1;
@@ -1418,14 +1428,50 @@ void player2_control(GameState *state)
 
 /* Save file: savegame.bin beside the executable.
  * New format (magic "AB3S") stores full game + level runtime state.
- * Legacy format (magic "AB3D") remains readable for old position-only saves. */
+ * Legacy format (magic "AB3D") remains readable for old position-only saves.
+ *
+ * Version 4 stores each level chunk either raw or as runs of the 64-byte
+ * blocks that differ from the save baseline: a copy of the level as it
+ * stood right after setup, taken once per level load. Most of a level never
+ * changes, so a save is mostly the GameState plus a few KB of runs. The
+ * delta info names the baseline's level and hash; delta chunks only decode
+ * against that baseline, which a reload of the same level files reproduces.
+ *
+ * F5 copies the live chunks into reusable capture buffers on the game
+ * thread; encoding and the file write run as a loader job (inline in builds
+ * without threads). F9 of a save from the running level restores in place. */
 #define SAVE_MAGIC_LEGACY "AB3D"
 #define SAVE_MAGIC_FULL   "AB3S"
-#define SAVE_VERSION_FULL 3u
+#define SAVE_VERSION_FULL 4u
 #define SAVE_FILE_SUBPATH "savegame.bin"
 #define SAVE_MAX_TABLE_ENTRIES 4096
 #define SAVE_MAX_CHUNK_BYTES (256u * 1024u * 1024u)
 #define SAVE_NASTY_SLOT_SCRATCH_BYTES 64u
+#define SAVE_DELTA_BLOCK_BYTES 64u
+
+/* Chunks in file order. */
+enum {
+    SAVE_CHUNK_LEVEL_DATA = 0,
+    SAVE_CHUNK_LEVEL_GRAPHICS,
+    SAVE_CHUNK_LEVEL_CLIPS,
+    SAVE_CHUNK_PLAYER_SHOTS,
+    SAVE_CHUNK_NASTY_SHOTS,
+    SAVE_CHUNK_OBJECT_POINTS,
+    SAVE_CHUNK_DOOR_DATA,
+    SAVE_CHUNK_SWITCH_DATA,
+    SAVE_CHUNK_LIFT_DATA,
+    SAVE_CHUNK_ZONE_ADDS,
+    SAVE_CHUNK_DOOR_WALL_LIST,
+    SAVE_CHUNK_DOOR_WALL_OFFSETS,
+    SAVE_CHUNK_LIFT_WALL_LIST,
+    SAVE_CHUNK_LIFT_WALL_OFFSETS,
+    SAVE_CHUNK_WORKSPACE,
+    SAVE_CHUNK_AUTOMAP_SEEN,   /* converted, never delta-coded */
+    SAVE_CHUNK_COUNT
+};
+
+#define SAVE_CHUNK_RAW   0u
+#define SAVE_CHUNK_DELTA 1u  /* {u32 offset, u32 len, len bytes} runs over the baseline */
 
 typedef struct {
     char     magic[4];
@@ -1466,6 +1512,19 @@ typedef struct {
     uint32_t bright_anim_indices[3];
 } FullSaveHeader;
 
+/* v4+: follows the header. baseline_level is -1 when the save has no baseline. */
+typedef struct {
+    uint32_t baseline_hash;
+    int16_t  baseline_level;
+    int16_t  reserved0;
+} FullSaveDeltaInfo;
+
+/* v4+: precedes each chunk. Raw chunks store exactly the header byte count. */
+typedef struct {
+    uint32_t encoding;
+    uint32_t payload_bytes;
+} SaveChunkDisk;
+
 typedef struct {
     uint32_t gfx_off;
     int16_t  x1, z1;
@@ -1473,29 +1532,84 @@ typedef struct {
     uint16_t flags; /* bit0: is_door, bits8..15: door_key_id */
 } SaveAutomapSeenWallDisk;
 
+static const char *const k_save_chunk_labels[SAVE_CHUNK_COUNT] = {
+    "level data", "level graphics", "level clips", "player shots", "nasty shots",
+    "object points", "door table", "switch table", "lift table", "zone adds",
+    "door wall list", "door wall offsets", "lift wall list", "lift wall offsets",
+    "workspace", "automap"
+};
+
+/* FullSaveHeader byte counts, by chunk. */
+static const size_t k_save_chunk_header_offset[SAVE_CHUNK_COUNT] = {
+    offsetof(FullSaveHeader, level_data_bytes),
+    offsetof(FullSaveHeader, level_graphics_bytes),
+    offsetof(FullSaveHeader, level_clips_bytes),
+    offsetof(FullSaveHeader, player_shot_bytes),
+    offsetof(FullSaveHeader, nasty_shot_bytes),
+    offsetof(FullSaveHeader, object_points_bytes),
+    offsetof(FullSaveHeader, door_data_bytes),
+    offsetof(FullSaveHeader, switch_data_bytes),
+    offsetof(FullSaveHeader, lift_data_bytes),
+    offsetof(FullSaveHeader, zone_adds_bytes),
+    offsetof(FullSaveHeader, door_wall_list_bytes),
+    offsetof(FullSaveHeader, door_wall_offsets_bytes),
+    offsetof(FullSaveHeader, lift_wall_list_bytes),
+    offsetof(FullSaveHeader, lift_wall_offsets_bytes),
+    offsetof(FullSaveHeader, workspace_bytes),
+    offsetof(FullSaveHeader, automap_seen_bytes),
+};
+
 typedef struct {
     bool     valid;
     FullSaveHeader header;
+    FullSaveDeltaInfo delta_info;
     GameState game_state;
-    uint8_t *level_data;
-    uint8_t *level_graphics;
-    uint8_t *level_clips;
-    uint8_t *player_shot_data;
-    uint8_t *nasty_shot_data;
-    uint8_t *object_points;
-    uint8_t *door_data;
-    uint8_t *switch_data;
-    uint8_t *lift_data;
-    uint8_t *zone_adds;
-    uint8_t *door_wall_list;
-    uint8_t *door_wall_offsets;
-    uint8_t *lift_wall_list;
-    uint8_t *lift_wall_offsets;
-    uint8_t *workspace;
-    uint8_t *automap_seen;
+    uint8_t *chunk[SAVE_CHUNK_COUNT];
+    uint32_t encoding[SAVE_CHUNK_COUNT];
+    uint32_t payload_bytes[SAVE_CHUNK_COUNT];  /* bytes held in chunk[] */
 } FullSavePending;
 
+/* Level chunks as set up at load time; what delta chunks are coded against. */
+typedef struct {
+    bool     valid;
+    int16_t  level;
+    uint32_t hash;
+    uint8_t *chunk[SAVE_CHUNK_COUNT];
+    uint32_t bytes[SAVE_CHUNK_COUNT];
+} SaveBaseline;
+
+/* One F5 in flight: the capture handed to the loader job. */
+typedef struct {
+    AssetJob *job;
+    char      path[512];
+    FullSaveHeader header;
+    GameState game_state;
+    uint8_t  *chunk[SAVE_CHUNK_COUNT];  /* capture buffers, reused across saves */
+    size_t    cap[SAVE_CHUNK_COUNT];
+    bool      delta;                    /* encode against g_save_baseline */
+} SaveWrite;
+
 static FullSavePending g_full_save_pending;
+static SaveBaseline g_save_baseline;
+static SaveWrite g_save_write;
+static int g_save_delta_state = -1;
+
+static int player_save_delta_enabled(void)
+{
+    return settings_env_feature_enabled(&g_save_delta_state, "AB3D_DISABLE_SAVE_DELTA");
+}
+
+static uint32_t player_save_header_chunk_bytes(const FullSaveHeader *hdr, int chunk)
+{
+    uint32_t v;
+    memcpy(&v, (const uint8_t *)hdr + k_save_chunk_header_offset[chunk], sizeof(v));
+    return v;
+}
+
+static void player_save_set_header_chunk_bytes(FullSaveHeader *hdr, int chunk, uint32_t v)
+{
+    memcpy((uint8_t *)hdr + k_save_chunk_header_offset[chunk], &v, sizeof(v));
+}
 
 static int16_t player_save_read_word_be(const uint8_t *p)
 {
@@ -1582,22 +1696,8 @@ static size_t player_save_lift_wall_offsets_size(const LevelState *level)
 
 static void player_save_clear_pending_full_save(void)
 {
-    free(g_full_save_pending.level_data);
-    free(g_full_save_pending.level_graphics);
-    free(g_full_save_pending.level_clips);
-    free(g_full_save_pending.player_shot_data);
-    free(g_full_save_pending.nasty_shot_data);
-    free(g_full_save_pending.object_points);
-    free(g_full_save_pending.door_data);
-    free(g_full_save_pending.switch_data);
-    free(g_full_save_pending.lift_data);
-    free(g_full_save_pending.zone_adds);
-    free(g_full_save_pending.door_wall_list);
-    free(g_full_save_pending.door_wall_offsets);
-    free(g_full_save_pending.lift_wall_list);
-    free(g_full_save_pending.lift_wall_offsets);
-    free(g_full_save_pending.workspace);
-    free(g_full_save_pending.automap_seen);
+    for (int c = 0; c < SAVE_CHUNK_COUNT; c++)
+        free(g_full_save_pending.chunk[c]);
     memset(&g_full_save_pending, 0, sizeof(g_full_save_pending));
 }
 
@@ -1636,6 +1736,207 @@ static bool player_save_apply_chunk(const char *label, void *dst, size_t dst_siz
     return true;
 }
 
+/* Live level memory behind a chunk (the automap chunk is converted, not copied). */
+static uint8_t *player_save_live_chunk(const LevelState *level, int chunk)
+{
+    switch (chunk) {
+    case SAVE_CHUNK_LEVEL_DATA:        return level->data;
+    case SAVE_CHUNK_LEVEL_GRAPHICS:    return level->graphics;
+    case SAVE_CHUNK_LEVEL_CLIPS:       return level->clips;
+    case SAVE_CHUNK_PLAYER_SHOTS:      return level->player_shot_data;
+    case SAVE_CHUNK_NASTY_SHOTS:       return level->nasty_shot_data;
+    case SAVE_CHUNK_OBJECT_POINTS:     return level->object_points;
+    case SAVE_CHUNK_DOOR_DATA:         return level->door_data;
+    case SAVE_CHUNK_SWITCH_DATA:       return level->switch_data;
+    case SAVE_CHUNK_LIFT_DATA:         return level->lift_data;
+    case SAVE_CHUNK_ZONE_ADDS:         return level->zone_adds;
+    case SAVE_CHUNK_DOOR_WALL_LIST:    return level->door_wall_list;
+    case SAVE_CHUNK_DOOR_WALL_OFFSETS: return (uint8_t *)level->door_wall_list_offsets;
+    case SAVE_CHUNK_LIFT_WALL_LIST:    return level->lift_wall_list;
+    case SAVE_CHUNK_LIFT_WALL_OFFSETS: return (uint8_t *)level->lift_wall_list_offsets;
+    case SAVE_CHUNK_WORKSPACE:         return level->workspace;
+    default:                           return NULL;
+    }
+}
+
+/* Bytes a save writes for the chunk, and what a restore may write back. */
+static size_t player_save_live_chunk_size(const LevelState *level, int chunk)
+{
+    switch (chunk) {
+    case SAVE_CHUNK_LEVEL_DATA:
+        return level->data ? level->data_byte_count : 0;
+    case SAVE_CHUNK_LEVEL_GRAPHICS:
+        return level->graphics ? level->graphics_byte_count : 0;
+    case SAVE_CHUNK_LEVEL_CLIPS:
+        return level->clips ? level->clips_byte_count : 0;
+    case SAVE_CHUNK_PLAYER_SHOTS:
+        return level->player_shot_data ? (size_t)PLAYER_SHOT_SLOT_COUNT * OBJECT_SIZE : 0;
+    case SAVE_CHUNK_NASTY_SHOTS:
+        return level->nasty_shot_data
+            ? (size_t)level->nasty_shot_slots * (OBJECT_SIZE + SAVE_NASTY_SLOT_SCRATCH_BYTES) : 0;
+    case SAVE_CHUNK_OBJECT_POINTS:
+        return (level->object_points && level->num_object_points > 0)
+            ? (size_t)level->num_object_points * 8u : 0u;
+    case SAVE_CHUNK_DOOR_DATA:         return player_save_table_size_with_sentinel(level->door_data, 22u);
+    case SAVE_CHUNK_SWITCH_DATA:       return player_save_table_size_with_sentinel(level->switch_data, 14u);
+    case SAVE_CHUNK_LIFT_DATA:         return player_save_table_size_with_sentinel(level->lift_data, 20u);
+    case SAVE_CHUNK_ZONE_ADDS:         return player_save_zone_adds_size(level);
+    case SAVE_CHUNK_DOOR_WALL_LIST:    return player_save_door_wall_list_size(level);
+    case SAVE_CHUNK_DOOR_WALL_OFFSETS: return player_save_door_wall_offsets_size(level);
+    case SAVE_CHUNK_LIFT_WALL_LIST:    return player_save_lift_wall_list_size(level);
+    case SAVE_CHUNK_LIFT_WALL_OFFSETS: return player_save_lift_wall_offsets_size(level);
+    case SAVE_CHUNK_WORKSPACE:         return player_save_workspace_size(level);
+    case SAVE_CHUNK_AUTOMAP_SEEN:
+        return (size_t)level->automap_seen_count * sizeof(SaveAutomapSeenWallDisk);
+    default:
+        return 0;
+    }
+}
+
+static uint32_t player_save_fnv1a(uint32_t h, const void *data, size_t bytes)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    for (size_t i = 0; i < bytes; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* Next run of differing SAVE_DELTA_BLOCK_BYTES blocks at or after *pos.
+ * Returns false once cur matches base up to n. */
+static bool player_save_next_delta_run(const uint8_t *cur, const uint8_t *base, size_t n,
+                                       size_t *pos, size_t *run_off, size_t *run_len)
+{
+    size_t p = *pos;
+    while (p < n) {
+        size_t blk = (n - p < SAVE_DELTA_BLOCK_BYTES) ? n - p : SAVE_DELTA_BLOCK_BYTES;
+        if (memcmp(cur + p, base + p, blk) != 0) break;
+        p += blk;
+    }
+    if (p >= n) {
+        *pos = n;
+        return false;
+    }
+    *run_off = p;
+    while (p < n) {
+        size_t blk = (n - p < SAVE_DELTA_BLOCK_BYTES) ? n - p : SAVE_DELTA_BLOCK_BYTES;
+        if (memcmp(cur + p, base + p, blk) == 0) break;
+        p += blk;
+    }
+    *run_len = p - *run_off;
+    *pos = p;
+    return true;
+}
+
+static size_t player_save_delta_payload_size(const uint8_t *cur, const uint8_t *base, size_t n)
+{
+    size_t pos = 0, off, len, total = 0;
+    while (player_save_next_delta_run(cur, base, n, &pos, &off, &len))
+        total += 2u * sizeof(uint32_t) + len;
+    return total;
+}
+
+static void player_save_wait_for_write(void)
+{
+    asset_job_wait(g_save_write.job);
+    g_save_write.job = NULL;
+}
+
+static void player_save_release_baseline(void)
+{
+    for (int c = 0; c < SAVE_CHUNK_COUNT; c++)
+        free(g_save_baseline.chunk[c]);
+    memset(&g_save_baseline, 0, sizeof(g_save_baseline));
+}
+
+/* Expand the pending save's delta chunks over the baseline. All or nothing:
+ * on failure the pending save is left as read. */
+static bool player_save_pending_has_deltas(void)
+{
+    if (!g_full_save_pending.valid) return false;
+    for (int c = 0; c < SAVE_CHUNK_COUNT; c++)
+        if (g_full_save_pending.encoding[c] == SAVE_CHUNK_DELTA) return true;
+    return false;
+}
+
+static bool player_save_resolve_pending_deltas(void)
+{
+    FullSavePending *p = &g_full_save_pending;
+    uint8_t *expanded[SAVE_CHUNK_COUNT] = { 0 };
+    int c;
+
+    if (!player_save_pending_has_deltas()) return true;
+
+    if (!g_save_baseline.valid ||
+        g_save_baseline.level != p->delta_info.baseline_level ||
+        g_save_baseline.hash != p->delta_info.baseline_hash) {
+        printf("[PLAYER] load: save needs the level %d baseline %08x (have level %d %08x)\n",
+               (int)p->delta_info.baseline_level, (unsigned)p->delta_info.baseline_hash,
+               g_save_baseline.valid ? (int)g_save_baseline.level : -1,
+               (unsigned)g_save_baseline.hash);
+        return false;
+    }
+
+    for (c = 0; c < SAVE_CHUNK_COUNT; c++) {
+        if (p->encoding[c] != SAVE_CHUNK_DELTA) continue;
+        uint32_t bytes = player_save_header_chunk_bytes(&p->header, c);
+        const uint8_t *run = p->chunk[c];
+        size_t left = p->payload_bytes[c];
+
+        if (g_save_baseline.bytes[c] != bytes || !g_save_baseline.chunk[c]) goto fail;
+        expanded[c] = (uint8_t *)malloc((size_t)bytes);
+        if (!expanded[c]) goto fail;
+        memcpy(expanded[c], g_save_baseline.chunk[c], (size_t)bytes);
+        while (left > 0) {
+            uint32_t off_len[2];
+            if (!run || left < sizeof(off_len)) goto fail;
+            memcpy(off_len, run, sizeof(off_len));
+            run += sizeof(off_len);
+            left -= sizeof(off_len);
+            if (off_len[1] > left || off_len[0] > bytes || off_len[1] > bytes - off_len[0])
+                goto fail;
+            memcpy(expanded[c] + off_len[0], run, off_len[1]);
+            run += off_len[1];
+            left -= off_len[1];
+        }
+    }
+
+    for (c = 0; c < SAVE_CHUNK_COUNT; c++) {
+        if (!expanded[c]) continue;
+        free(p->chunk[c]);
+        p->chunk[c] = expanded[c];
+        p->encoding[c] = SAVE_CHUNK_RAW;
+        p->payload_bytes[c] = player_save_header_chunk_bytes(&p->header, c);
+    }
+    return true;
+
+fail:
+    printf("[PLAYER] load: %s delta does not match the save baseline\n",
+           (c < SAVE_CHUNK_COUNT) ? k_save_chunk_labels[c] : "chunk");
+    for (int i = 0; i < SAVE_CHUNK_COUNT; i++)
+        free(expanded[i]);
+    return false;
+}
+
+static bool player_save_read_chunk(FILE *f, const FullSaveHeader *hdr, int chunk)
+{
+    uint32_t bytes = player_save_header_chunk_bytes(hdr, chunk);
+    SaveChunkDisk disk = { SAVE_CHUNK_RAW, bytes };
+
+    if (hdr->version >= 4u) {
+        if (!player_save_read_exact(f, &disk, sizeof(disk))) return false;
+        if (disk.encoding == SAVE_CHUNK_RAW) {
+            if (disk.payload_bytes != bytes) return false;
+        } else if (disk.encoding != SAVE_CHUNK_DELTA || chunk == SAVE_CHUNK_AUTOMAP_SEEN) {
+            return false;
+        }
+    }
+    g_full_save_pending.encoding[chunk] = disk.encoding;
+    g_full_save_pending.payload_bytes[chunk] = disk.payload_bytes;
+    return player_save_alloc_read_chunk(f, disk.payload_bytes, &g_full_save_pending.chunk[chunk]);
+}
+
 static bool player_save_read_full_save(FILE *f, GameState *state, const char *path)
 {
     FullSaveHeader hdr;
@@ -1657,47 +1958,24 @@ static bool player_save_read_full_save(FILE *f, GameState *state, const char *pa
     player_save_clear_pending_full_save();
     g_full_save_pending.header = hdr;
 
+    if (hdr.version >= 4u) {
+        if (!player_save_read_exact(f, &g_full_save_pending.delta_info, sizeof(FullSaveDeltaInfo)))
+            goto fail;
+    } else {
+        g_full_save_pending.delta_info.baseline_level = -1;
+    }
     if (!player_save_read_exact(f, &g_full_save_pending.game_state, sizeof(GameState)))
         goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.level_data_bytes, &g_full_save_pending.level_data))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.level_graphics_bytes, &g_full_save_pending.level_graphics))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.level_clips_bytes, &g_full_save_pending.level_clips))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.player_shot_bytes, &g_full_save_pending.player_shot_data))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.nasty_shot_bytes, &g_full_save_pending.nasty_shot_data))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.object_points_bytes, &g_full_save_pending.object_points))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.door_data_bytes, &g_full_save_pending.door_data))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.switch_data_bytes, &g_full_save_pending.switch_data))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.lift_data_bytes, &g_full_save_pending.lift_data))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.zone_adds_bytes, &g_full_save_pending.zone_adds))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.door_wall_list_bytes, &g_full_save_pending.door_wall_list))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.door_wall_offsets_bytes, &g_full_save_pending.door_wall_offsets))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.lift_wall_list_bytes, &g_full_save_pending.lift_wall_list))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.lift_wall_offsets_bytes, &g_full_save_pending.lift_wall_offsets))
-        goto fail;
-    if (!player_save_alloc_read_chunk(f, hdr.workspace_bytes, &g_full_save_pending.workspace))
-        goto fail;
-    if (hdr.version >= 3u) {
-        if (!player_save_alloc_read_chunk(f, hdr.automap_seen_bytes, &g_full_save_pending.automap_seen))
+    /* v2 saves end before the automap chunk. */
+    for (int c = 0; c < SAVE_CHUNK_COUNT; c++) {
+        if (c == SAVE_CHUNK_AUTOMAP_SEEN && hdr.version < 3u) break;
+        if (!player_save_read_chunk(f, &hdr, c))
             goto fail;
     }
 
     g_full_save_pending.valid = true;
     state->current_level = hdr.current_level;
-    printf("[PLAYER] load: full save read (level %d), reloading level to restore state\n",
-           (int)hdr.current_level);
+    printf("[PLAYER] load: full save read (level %d)\n", (int)hdr.current_level);
     return true;
 
 fail:
@@ -1706,21 +1984,34 @@ fail:
     return false;
 }
 
-static bool player_apply_pending_full_save_after_level_load(GameState *state)
+/* Seen-wall count of the pending automap chunk (0 before v3); false if malformed. */
+static bool player_save_automap_count(const FullSaveHeader *hdr, uint32_t *out_count)
+{
+    uint32_t bytes = hdr->version >= 3u ? hdr->automap_seen_bytes : 0u;
+
+    *out_count = 0;
+    if (bytes % (uint32_t)sizeof(SaveAutomapSeenWallDisk) != 0u) {
+        printf("[PLAYER] load: automap chunk size invalid (%u)\n", (unsigned)bytes);
+        return false;
+    }
+    *out_count = bytes / (uint32_t)sizeof(SaveAutomapSeenWallDisk);
+    if (*out_count > 200000u) {
+        printf("[PLAYER] load: automap chunk too large (%u)\n", (unsigned)*out_count);
+        return false;
+    }
+    return true;
+}
+
+/* Overwrite *state and the live level with the pending save. On failure the
+ * pending save is kept so the caller can still restore it over a fresh load. */
+static bool player_save_apply_pending(GameState *state)
 {
     const FullSaveHeader *hdr;
     LevelState live_level;
-    size_t door_data_dst;
-    size_t switch_data_dst;
-    size_t lift_data_dst;
-    size_t zone_adds_dst;
-    size_t door_wall_list_dst;
-    size_t door_wall_offsets_dst;
-    size_t lift_wall_list_dst;
-    size_t lift_wall_offsets_dst;
-    size_t workspace_dst;
+    size_t chunk_dst[SAVE_CHUNK_COUNT];
 
     if (!g_full_save_pending.valid) return false;
+    if (!player_save_resolve_pending_deltas()) return false;
 
     hdr = &g_full_save_pending.header;
     live_level = state->level;
@@ -1743,6 +2034,12 @@ static bool player_apply_pending_full_save_after_level_load(GameState *state)
     bool    ini_cfg_post_tint = state->cfg_post_tint;
     bool    ini_cfg_weapon_post_gl = state->cfg_weapon_post_gl;
     bool    ini_cfg_show_fps = state->cfg_show_fps;
+    int8_t  ini_cfg_render_thread_schedule = state->cfg_render_thread_schedule;
+    int8_t  ini_cfg_render_thread_wait = state->cfg_render_thread_wait;
+    bool    ini_cfg_present_pipeline = state->cfg_present_pipeline;
+    bool    ini_cfg_fixed_timestep = state->cfg_fixed_timestep;
+    int16_t ini_cfg_dynamic_resolution_ms = state->cfg_dynamic_resolution_ms;
+    int16_t ini_cfg_dynamic_resolution_min = state->cfg_dynamic_resolution_min;
 
     *state = g_full_save_pending.game_state;
     state->level = live_level;
@@ -1766,92 +2063,42 @@ static bool player_apply_pending_full_save_after_level_load(GameState *state)
     state->cfg_post_tint = ini_cfg_post_tint;
     state->cfg_weapon_post_gl = ini_cfg_weapon_post_gl;
     state->cfg_show_fps = ini_cfg_show_fps;
-
-    door_data_dst = player_save_table_size_with_sentinel(state->level.door_data, 22u);
-    switch_data_dst = player_save_table_size_with_sentinel(state->level.switch_data, 14u);
-    lift_data_dst = player_save_table_size_with_sentinel(state->level.lift_data, 20u);
-    zone_adds_dst = player_save_zone_adds_size(&state->level);
-    door_wall_list_dst = player_save_door_wall_list_size(&state->level);
-    door_wall_offsets_dst = player_save_door_wall_offsets_size(&state->level);
-    lift_wall_list_dst = player_save_lift_wall_list_size(&state->level);
-    lift_wall_offsets_dst = player_save_lift_wall_offsets_size(&state->level);
-    workspace_dst = player_save_workspace_size(&state->level);
-
-    if (!player_save_apply_chunk("level data",
-            state->level.data, state->level.data_byte_count,
-            g_full_save_pending.level_data, hdr->level_data_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("level graphics",
-            state->level.graphics, state->level.graphics_byte_count,
-            g_full_save_pending.level_graphics, hdr->level_graphics_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("level clips",
-            state->level.clips, state->level.clips_byte_count,
-            g_full_save_pending.level_clips, hdr->level_clips_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("player shots",
-            state->level.player_shot_data, (size_t)PLAYER_SHOT_SLOT_COUNT * OBJECT_SIZE,
-            g_full_save_pending.player_shot_data, hdr->player_shot_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("nasty shots",
-            state->level.nasty_shot_data,
-            (size_t)NASTY_SHOT_SLOT_COUNT * (OBJECT_SIZE + SAVE_NASTY_SLOT_SCRATCH_BYTES),
-            g_full_save_pending.nasty_shot_data, hdr->nasty_shot_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("object points",
-            state->level.object_points,
-            (state->level.num_object_points > 0) ? (size_t)state->level.num_object_points * 8u : 0u,
-            g_full_save_pending.object_points, hdr->object_points_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("door table",
-            state->level.door_data, door_data_dst,
-            g_full_save_pending.door_data, hdr->door_data_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("switch table",
-            state->level.switch_data, switch_data_dst,
-            g_full_save_pending.switch_data, hdr->switch_data_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("lift table",
-            state->level.lift_data, lift_data_dst,
-            g_full_save_pending.lift_data, hdr->lift_data_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("zone adds",
-            state->level.zone_adds, zone_adds_dst,
-            g_full_save_pending.zone_adds, hdr->zone_adds_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("door wall list",
-            state->level.door_wall_list, door_wall_list_dst,
-            g_full_save_pending.door_wall_list, hdr->door_wall_list_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("door wall offsets",
-            state->level.door_wall_list_offsets, door_wall_offsets_dst,
-            g_full_save_pending.door_wall_offsets, hdr->door_wall_offsets_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("lift wall list",
-            state->level.lift_wall_list, lift_wall_list_dst,
-            g_full_save_pending.lift_wall_list, hdr->lift_wall_list_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("lift wall offsets",
-            state->level.lift_wall_list_offsets, lift_wall_offsets_dst,
-            g_full_save_pending.lift_wall_offsets, hdr->lift_wall_offsets_bytes))
-        goto fail;
-    if (!player_save_apply_chunk("workspace",
-            state->level.workspace, workspace_dst,
-            g_full_save_pending.workspace, hdr->workspace_bytes))
-        goto fail;
-
-    /* Automap (v3+): restore seen wall list. */
-    if (hdr->version >= 3u && hdr->automap_seen_bytes > 0) {
-        uint32_t bytes = hdr->automap_seen_bytes;
-        if (bytes % (uint32_t)sizeof(SaveAutomapSeenWallDisk) != 0u) {
-            printf("[PLAYER] load: automap chunk size invalid (%u)\n", (unsigned)bytes);
-            goto fail;
+    state->cfg_render_thread_schedule = ini_cfg_render_thread_schedule;
+    state->cfg_render_thread_wait = ini_cfg_render_thread_wait;
+    state->cfg_present_pipeline = ini_cfg_present_pipeline;
+    state->cfg_fixed_timestep = ini_cfg_fixed_timestep;
+    state->cfg_dynamic_resolution_ms = ini_cfg_dynamic_resolution_ms;
+    state->cfg_dynamic_resolution_min = ini_cfg_dynamic_resolution_min;
+
+    for (int c = 0; c < SAVE_CHUNK_COUNT; c++)
+        chunk_dst[c] = player_save_live_chunk_size(&state->level, c);
+
+    objects_shot_pools_invalidate();
+    for (int c = 0; c < SAVE_CHUNK_AUTOMAP_SEEN; c++) {
+        uint32_t bytes = player_save_header_chunk_bytes(hdr, c);
+        if (c == SAVE_CHUNK_NASTY_SHOTS) {
+            /* The save may come from a pool that grew past the load-time size. */
+            size_t saved_slots = (size_t)bytes / (OBJECT_SIZE + SAVE_NASTY_SLOT_SCRATCH_BYTES);
+            if (saved_slots > (size_t)state->level.nasty_shot_slots &&
+                level_grow_nasty_shot_pool(&state->level, (int)saved_slots) != 0) {
+                printf("[PLAYER] load: cannot grow nasty shot pool to %zu slots\n", saved_slots);
+                goto fail;
+            }
+            /* Growing also reallocates ObjectPoints for the new slots. */
+            chunk_dst[c] = player_save_live_chunk_size(&state->level, c);
+            chunk_dst[SAVE_CHUNK_OBJECT_POINTS] =
+                player_save_live_chunk_size(&state->level, SAVE_CHUNK_OBJECT_POINTS);
         }
-        uint32_t count = bytes / (uint32_t)sizeof(SaveAutomapSeenWallDisk);
-        if (count > 200000u) {
-            printf("[PLAYER] load: automap chunk too large (%u)\n", (unsigned)count);
+        if (!player_save_apply_chunk(k_save_chunk_labels[c],
+                player_save_live_chunk(&state->level, c), chunk_dst[c],
+                g_full_save_pending.chunk[c], bytes))
             goto fail;
-        }
+    }
+
+    /* Automap (v3+): restore seen wall list; older or empty saves clear it. */
+    {
+        uint32_t count = 0;
+        if (!player_save_automap_count(hdr, &count)) goto fail;
 
         renderer_automap_lock();
         free(state->level.automap_seen_walls);
@@ -1870,7 +2117,7 @@ static bool player_apply_pending_full_save_after_level_load(GameState *state)
             }
             state->level.automap_seen_cap = count;
 
-            const SaveAutomapSeenWallDisk *disk = (const SaveAutomapSeenWallDisk *)g_full_save_pending.automap_seen;
+            const SaveAutomapSeenWallDisk *disk = (const SaveAutomapSeenWallDisk *)g_full_save_pending.chunk[SAVE_CHUNK_AUTOMAP_SEEN];
             for (uint32_t i = 0; i < count; i++) {
                 AutomapSeenWall *w = &state->level.automap_seen_walls[i];
                 w->gfx_off = disk[i].gfx_off;
@@ -1941,7 +2188,7 @@ static bool player_apply_pending_full_save_after_level_load(GameState *state)
 
     if (state->level.nasty_shot_data) {
         state->level.other_nasty_data =
-            state->level.nasty_shot_data + (size_t)NASTY_SHOT_SLOT_COUNT * OBJECT_SIZE;
+            state->level.nasty_shot_data + (size_t)state->level.nasty_shot_slots * OBJECT_SIZE;
     } else {
         state->level.other_nasty_data = NULL;
     }
@@ -1954,167 +2201,190 @@ static bool player_apply_pending_full_save_after_level_load(GameState *state)
     return true;
 
 fail:
+    return false;
+}
+
+static bool player_apply_pending_full_save_after_level_load(GameState *state)
+{
+    if (!g_full_save_pending.valid) return false;
+    if (player_save_apply_pending(state)) return true;
     player_save_clear_pending_full_save();
     printf("[PLAYER] load: full save apply failed\n");
     return false;
 }
 
-void player_save_position(GameState *state)
+/* Validate the live level and fill a v4 header for it; what = log prefix. */
+static bool player_save_build_header(const GameState *state, FullSaveHeader *hdr, const char *what)
 {
-    char path[512];
-    FILE *f = NULL;
-    FullSaveHeader hdr;
-    GameState game_snapshot;
-    uint32_t level_data_bytes = 0, level_graphics_bytes = 0, level_clips_bytes = 0;
-    uint32_t player_shot_bytes = 0, nasty_shot_bytes = 0, object_points_bytes = 0;
-    uint32_t door_data_bytes = 0, switch_data_bytes = 0, lift_data_bytes = 0;
-    uint32_t zone_adds_bytes = 0;
-    uint32_t door_wall_list_bytes = 0, door_wall_offsets_bytes = 0;
-    uint32_t lift_wall_list_bytes = 0, lift_wall_offsets_bytes = 0;
-    uint32_t workspace_bytes = 0;
-    uint32_t automap_seen_bytes = 0;
-    size_t door_data_sz, switch_data_sz, lift_data_sz;
-
-    if (!state) return;
+    const LevelState *level = &state->level;
 
-    if (state->level.data && state->level.data_byte_count == 0) {
-        printf("[PLAYER] save: level data size unknown; aborting save\n");
-        return;
+    if (level->data && level->data_byte_count == 0) {
+        printf("[PLAYER] %s: level data size unknown; aborting save\n", what);
+        return false;
     }
-    if (state->level.graphics && state->level.graphics_byte_count == 0) {
-        printf("[PLAYER] save: level graphics size unknown; aborting save\n");
-        return;
+    if (level->graphics && level->graphics_byte_count == 0) {
+        printf("[PLAYER] %s: level graphics size unknown; aborting save\n", what);
+        return false;
     }
-    if (state->level.clips && state->level.clips_byte_count == 0) {
-        printf("[PLAYER] save: level clips size unknown; aborting save\n");
-        return;
+    if (level->clips && level->clips_byte_count == 0) {
+        printf("[PLAYER] %s: level clips size unknown; aborting save\n", what);
+        return false;
     }
-
-    door_data_sz = player_save_table_size_with_sentinel(state->level.door_data, 22u);
-    switch_data_sz = player_save_table_size_with_sentinel(state->level.switch_data, 14u);
-    lift_data_sz = player_save_table_size_with_sentinel(state->level.lift_data, 20u);
-    if (state->level.door_data && door_data_sz == 0) {
-        printf("[PLAYER] save: door table missing terminator; aborting save\n");
-        return;
+    if (level->door_data && player_save_live_chunk_size(level, SAVE_CHUNK_DOOR_DATA) == 0) {
+        printf("[PLAYER] %s: door table missing terminator; aborting save\n", what);
+        return false;
     }
-    if (state->level.switch_data && switch_data_sz == 0) {
-        printf("[PLAYER] save: switch table missing terminator; aborting save\n");
-        return;
+    if (level->switch_data && player_save_live_chunk_size(level, SAVE_CHUNK_SWITCH_DATA) == 0) {
+        printf("[PLAYER] %s: switch table missing terminator; aborting save\n", what);
+        return false;
     }
-    if (state->level.lift_data && lift_data_sz == 0) {
-        printf("[PLAYER] save: lift table missing terminator; aborting save\n");
-        return;
+    if (level->lift_data && player_save_live_chunk_size(level, SAVE_CHUNK_LIFT_DATA) == 0) {
+        printf("[PLAYER] %s: lift table missing terminator; aborting save\n", what);
+        return false;
     }
 
-    if (!player_save_size_to_u32(state->level.data ? state->level.data_byte_count : 0, &level_data_bytes) ||
-        !player_save_size_to_u32(state->level.graphics ? state->level.graphics_byte_count : 0, &level_graphics_bytes) ||
-        !player_save_size_to_u32(state->level.clips ? state->level.clips_byte_count : 0, &level_clips_bytes) ||
-        !player_save_size_to_u32(state->level.player_shot_data ? (size_t)PLAYER_SHOT_SLOT_COUNT * OBJECT_SIZE : 0, &player_shot_bytes) ||
-        !player_save_size_to_u32(state->level.nasty_shot_data ? (size_t)NASTY_SHOT_SLOT_COUNT * (OBJECT_SIZE + SAVE_NASTY_SLOT_SCRATCH_BYTES) : 0, &nasty_shot_bytes) ||
-        !player_save_size_to_u32((state->level.object_points && state->level.num_object_points > 0) ? (size_t)state->level.num_object_points * 8u : 0u, &object_points_bytes) ||
-        !player_save_size_to_u32(door_data_sz, &door_data_bytes) ||
-        !player_save_size_to_u32(switch_data_sz, &switch_data_bytes) ||
-        !player_save_size_to_u32(lift_data_sz, &lift_data_bytes) ||
-        !player_save_size_to_u32(player_save_zone_adds_size(&state->level), &zone_adds_bytes) ||
-        !player_save_size_to_u32(player_save_door_wall_list_size(&state->level), &door_wall_list_bytes) ||
-        !player_save_size_to_u32(player_save_door_wall_offsets_size(&state->level), &door_wall_offsets_bytes) ||
-        !player_save_size_to_u32(player_save_lift_wall_list_size(&state->level), &lift_wall_list_bytes) ||
-        !player_save_size_to_u32(player_save_lift_wall_offsets_size(&state->level), &lift_wall_offsets_bytes) ||
-        !player_save_size_to_u32(player_save_workspace_size(&state->level), &workspace_bytes)) {
-        printf("[PLAYER] save: payload too large; aborting save\n");
+    memset(hdr, 0, sizeof(*hdr));
+    for (int c = 0; c < SAVE_CHUNK_COUNT; c++) {
+        uint32_t bytes;
+        if (!player_save_size_to_u32(player_save_live_chunk_size(level, c), &bytes)) {
+            printf("[PLAYER] %s: %s payload too large; aborting save\n", what, k_save_chunk_labels[c]);
+            return false;
+        }
+        player_save_set_header_chunk_bytes(hdr, c, bytes);
+    }
+
+    memcpy(hdr->magic, SAVE_MAGIC_FULL, 4);
+    hdr->version = SAVE_VERSION_FULL;
+    hdr->game_state_size = (uint32_t)sizeof(GameState);
+    hdr->current_level = state->current_level;
+    hdr->num_object_points = level->num_object_points;
+    hdr->num_zones = level->num_zones;
+    hdr->num_zone_slots = level->num_zone_slots;
+    hdr->num_floor_lines = level->num_floor_lines;
+    hdr->num_doors = level->num_doors;
+    hdr->num_lifts = level->num_lifts;
+    hdr->zone_brightness_le = level->zone_brightness_le ? 1u : 0u;
+    hdr->door_data_owned = level->door_data_owned ? 1u : 0u;
+    hdr->switch_data_owned = level->switch_data_owned ? 1u : 0u;
+    hdr->lift_data_owned = level->lift_data_owned ? 1u : 0u;
+    hdr->zone_adds_owned = level->zone_adds_owned ? 1u : 0u;
+    hdr->door_wall_list_owned = level->door_wall_list_owned ? 1u : 0u;
+    hdr->lift_wall_list_owned = level->lift_wall_list_owned ? 1u : 0u;
+    memcpy(hdr->bright_anim_values, level->bright_anim_values, sizeof(hdr->bright_anim_values));
+    memcpy(hdr->bright_anim_indices, level->bright_anim_indices, sizeof(hdr->bright_anim_indices));
+    return true;
+}
+
+void player_save_capture_baseline(GameState *state)
+{
+    SaveBaseline *b = &g_save_baseline;
+    FullSaveHeader hdr;
+    size_t total = 0;
+
+    player_save_wait_for_write();
+    player_save_release_baseline();
+    /* AB3D_DISABLE_SAVE_DELTA only stops writing deltas; a pending delta save
+     * still needs the baseline to load. */
+    if (!state || (!player_save_delta_enabled() && !player_save_pending_has_deltas()) ||
+        !player_save_build_header(state, &hdr, "save baseline"))
         return;
-    }
 
-    {
-        size_t count = (size_t)state->level.automap_seen_count;
-        size_t bytes = count * sizeof(SaveAutomapSeenWallDisk);
-        if (!player_save_size_to_u32(bytes, &automap_seen_bytes)) {
-            printf("[PLAYER] save: automap payload too large; aborting save\n");
+    b->hash = 2166136261u;
+    for (int c = 0; c < SAVE_CHUNK_AUTOMAP_SEEN; c++) {
+        uint32_t bytes = player_save_header_chunk_bytes(&hdr, c);
+        b->bytes[c] = bytes;
+        b->hash = player_save_fnv1a(b->hash, &bytes, sizeof(bytes));
+        if (bytes == 0) continue;
+        b->chunk[c] = (uint8_t *)malloc((size_t)bytes);
+        if (!b->chunk[c]) {
+            printf("[PLAYER] save baseline: out of memory; saves stay raw\n");
+            player_save_release_baseline();
             return;
         }
+        memcpy(b->chunk[c], player_save_live_chunk(&state->level, c), (size_t)bytes);
+        b->hash = player_save_fnv1a(b->hash, b->chunk[c], (size_t)bytes);
+        total += bytes;
+    }
+    b->level = state->current_level;
+    b->valid = true;
+    printf("[PLAYER] save baseline: level %d, %zu KB, hash %08x\n",
+           (int)b->level, total / 1024u, (unsigned)b->hash);
+}
+
+void player_save_shutdown(void)
+{
+    player_save_wait_for_write();
+    player_save_release_baseline();
+    for (int c = 0; c < SAVE_CHUNK_COUNT; c++)
+        free(g_save_write.chunk[c]);
+    memset(&g_save_write, 0, sizeof(g_save_write));
+    player_save_clear_pending_full_save();
+}
+
+static bool player_save_write_chunk(FILE *f, const SaveWrite *w, int chunk, int *delta_chunks)
+{
+    uint32_t bytes = player_save_header_chunk_bytes(&w->header, chunk);
+    const uint8_t *data = w->chunk[chunk];
+    const uint8_t *base = NULL;
+    SaveChunkDisk disk = { SAVE_CHUNK_RAW, bytes };
+
+    if (w->delta && bytes > 0 && chunk != SAVE_CHUNK_AUTOMAP_SEEN && g_save_baseline.valid &&
+        g_save_baseline.level == w->header.current_level &&
+        g_save_baseline.bytes[chunk] == bytes) {
+        size_t delta = player_save_delta_payload_size(data, g_save_baseline.chunk[chunk], bytes);
+        if (delta < (size_t)bytes) {
+            base = g_save_baseline.chunk[chunk];
+            disk.encoding = SAVE_CHUNK_DELTA;
+            disk.payload_bytes = (uint32_t)delta;
+        }
     }
+    if (!player_save_write_exact(f, &disk, sizeof(disk))) return false;
+    if (!base) return player_save_write_exact(f, data, bytes);
 
-    memset(&hdr, 0, sizeof(hdr));
-    memcpy(hdr.magic, SAVE_MAGIC_FULL, 4);
-    hdr.version = SAVE_VERSION_FULL;
-    hdr.game_state_size = (uint32_t)sizeof(GameState);
-    hdr.level_data_bytes = level_data_bytes;
-    hdr.level_graphics_bytes = level_graphics_bytes;
-    hdr.level_clips_bytes = level_clips_bytes;
-    hdr.player_shot_bytes = player_shot_bytes;
-    hdr.nasty_shot_bytes = nasty_shot_bytes;
-    hdr.object_points_bytes = object_points_bytes;
-    hdr.door_data_bytes = door_data_bytes;
-    hdr.switch_data_bytes = switch_data_bytes;
-    hdr.lift_data_bytes = lift_data_bytes;
-    hdr.zone_adds_bytes = zone_adds_bytes;
-    hdr.door_wall_list_bytes = door_wall_list_bytes;
-    hdr.door_wall_offsets_bytes = door_wall_offsets_bytes;
-    hdr.lift_wall_list_bytes = lift_wall_list_bytes;
-    hdr.lift_wall_offsets_bytes = lift_wall_offsets_bytes;
-    hdr.workspace_bytes = workspace_bytes;
-    hdr.automap_seen_bytes = automap_seen_bytes;
-    hdr.current_level = state->current_level;
-    hdr.num_object_points = state->level.num_object_points;
-    hdr.num_zones = state->level.num_zones;
-    hdr.num_zone_slots = state->level.num_zone_slots;
-    hdr.num_floor_lines = state->level.num_floor_lines;
-    hdr.num_doors = state->level.num_doors;
-    hdr.num_lifts = state->level.num_lifts;
-    hdr.zone_brightness_le = state->level.zone_brightness_le ? 1u : 0u;
-    hdr.door_data_owned = state->level.door_data_owned ? 1u : 0u;
-    hdr.switch_data_owned = state->level.switch_data_owned ? 1u : 0u;
-    hdr.lift_data_owned = state->level.lift_data_owned ? 1u : 0u;
-    hdr.zone_adds_owned = state->level.zone_adds_owned ? 1u : 0u;
-    hdr.door_wall_list_owned = state->level.door_wall_list_owned ? 1u : 0u;
-    hdr.lift_wall_list_owned = state->level.lift_wall_list_owned ? 1u : 0u;
-    memcpy(hdr.bright_anim_values, state->level.bright_anim_values, sizeof(hdr.bright_anim_values));
-    memcpy(hdr.bright_anim_indices, state->level.bright_anim_indices, sizeof(hdr.bright_anim_indices));
+    size_t pos = 0, off, len;
+    while (player_save_next_delta_run(data, base, bytes, &pos, &off, &len)) {
+        uint32_t off_len[2] = { (uint32_t)off, (uint32_t)len };
+        if (!player_save_write_exact(f, off_len, sizeof(off_len)) ||
+            !player_save_write_exact(f, data + off, len))
+            return false;
+    }
+    (*delta_chunks)++;
+    return true;
+}
+
+/* Loader job: encode the capture and write savegame.bin. The baseline is only
+ * replaced after player_save_wait_for_write, so it is stable here. */
+static void player_save_write_job(void *userdata)
+{
+    SaveWrite *w = (SaveWrite *)userdata;
+    FullSaveDeltaInfo info;
+    int delta_chunks = 0;
+    FILE *f = fopen(w->path, "wb");
 
-    io_make_exe_path(path, sizeof(path), SAVE_FILE_SUBPATH);
-    f = fopen(path, "wb");
     if (!f) {
-        printf("[PLAYER] save: could not open %s for write\n", path);
+        printf("[PLAYER] save: could not open %s for write\n", w->path);
         return;
     }
-
-    game_snapshot = *state;
-    if (!player_save_write_exact(f, &hdr, sizeof(hdr))) goto fail;
-    if (!player_save_write_exact(f, &game_snapshot, sizeof(game_snapshot))) goto fail;
-    if (!player_save_write_exact(f, state->level.data, hdr.level_data_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.graphics, hdr.level_graphics_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.clips, hdr.level_clips_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.player_shot_data, hdr.player_shot_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.nasty_shot_data, hdr.nasty_shot_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.object_points, hdr.object_points_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.door_data, hdr.door_data_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.switch_data, hdr.switch_data_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.lift_data, hdr.lift_data_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.zone_adds, hdr.zone_adds_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.door_wall_list, hdr.door_wall_list_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.door_wall_list_offsets, hdr.door_wall_offsets_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.lift_wall_list, hdr.lift_wall_list_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.lift_wall_list_offsets, hdr.lift_wall_offsets_bytes)) goto fail;
-    if (!player_save_write_exact(f, state->level.workspace, hdr.workspace_bytes)) goto fail;
-    if (hdr.automap_seen_bytes > 0) {
-        size_t count = (size_t)state->level.automap_seen_count;
-        SaveAutomapSeenWallDisk *tmp = (SaveAutomapSeenWallDisk *)malloc(count * sizeof(SaveAutomapSeenWallDisk));
-        if (!tmp) goto fail;
-        for (size_t i = 0; i < count; i++) {
-            const AutomapSeenWall *w = &state->level.automap_seen_walls[i];
-            tmp[i].gfx_off = w->gfx_off;
-            tmp[i].x1 = w->x1; tmp[i].z1 = w->z1;
-            tmp[i].x2 = w->x2; tmp[i].z2 = w->z2;
-            tmp[i].flags = (uint16_t)((w->is_door ? 1u : 0u) | ((uint16_t)w->door_key_id << 8));
-        }
-        bool ok = player_save_write_exact(f, tmp, count * sizeof(SaveAutomapSeenWallDisk));
-        free(tmp);
-        if (!ok) goto fail;
+    memset(&info, 0, sizeof(info));
+    info.baseline_level = -1;
+    if (w->delta && g_save_baseline.valid) {
+        info.baseline_hash = g_save_baseline.hash;
+        info.baseline_level = g_save_baseline.level;
+    }
+    if (!player_save_write_exact(f, &w->header, sizeof(w->header))) goto fail;
+    if (!player_save_write_exact(f, &info, sizeof(info))) goto fail;
+    if (!player_save_write_exact(f, &w->game_state, sizeof(w->game_state))) goto fail;
+    for (int c = 0; c < SAVE_CHUNK_COUNT; c++) {
+        if (!player_save_write_chunk(f, w, c, &delta_chunks)) goto fail;
     }
 
-    fclose(f);
-    printf("[PLAYER] save: full game + level state (level %d) written to %s\n",
-           (int)state->current_level, path);
+    long file_bytes = ftell(f);
+    if (fclose(f) != 0) {
+        printf("[PLAYER] save: write failed\n");
+        return;
+    }
+    printf("[PLAYER] save: full game + level state (level %d) written to %s (%ld bytes, %d delta chunks)\n",
+           (int)w->header.current_level, w->path, file_bytes, delta_chunks);
     return;
 
 fail:
@@ -2122,6 +2392,59 @@ fail:
     printf("[PLAYER] save: write failed\n");
 }
 
+static bool player_save_reserve_capture(int chunk, size_t bytes)
+{
+    if (bytes <= g_save_write.cap[chunk]) return true;
+    uint8_t *buf = (uint8_t *)realloc(g_save_write.chunk[chunk], bytes);
+    if (!buf) return false;
+    g_save_write.chunk[chunk] = buf;
+    g_save_write.cap[chunk] = bytes;
+    return true;
+}
+
+void player_save_position(GameState *state)
+{
+    SaveWrite *w = &g_save_write;
+    FullSaveHeader hdr;
+
+    if (!state) return;
+    player_save_wait_for_write();
+    if (!player_save_build_header(state, &hdr, "save")) return;
+
+    /* Capture on the game thread; everything after the copies runs on the loader. */
+    for (int c = 0; c < SAVE_CHUNK_COUNT; c++) {
+        size_t bytes = (size_t)player_save_header_chunk_bytes(&hdr, c);
+        if (!player_save_reserve_capture(c, bytes)) {
+            printf("[PLAYER] save: out of memory for %s; aborting save\n", k_save_chunk_labels[c]);
+            return;
+        }
+        if (bytes == 0) continue;
+        if (c != SAVE_CHUNK_AUTOMAP_SEEN) {
+            memcpy(w->chunk[c], player_save_live_chunk(&state->level, c), bytes);
+            continue;
+        }
+        SaveAutomapSeenWallDisk *disk = (SaveAutomapSeenWallDisk *)w->chunk[c];
+        size_t count = bytes / sizeof(SaveAutomapSeenWallDisk);
+        renderer_automap_lock();
+        if (count > state->level.automap_seen_count) count = state->level.automap_seen_count;
+        for (size_t i = 0; i < count; i++) {
+            const AutomapSeenWall *aw = &state->level.automap_seen_walls[i];
+            disk[i].gfx_off = aw->gfx_off;
+            disk[i].x1 = aw->x1; disk[i].z1 = aw->z1;
+            disk[i].x2 = aw->x2; disk[i].z2 = aw->z2;
+            disk[i].flags = (uint16_t)((aw->is_door ? 1u : 0u) | ((uint16_t)aw->door_key_id << 8));
+        }
+        renderer_automap_unlock();
+        bytes = count * sizeof(SaveAutomapSeenWallDisk);
+        player_save_set_header_chunk_bytes(&hdr, c, (uint32_t)bytes);
+    }
+    w->header = hdr;
+    w->game_state = *state;
+    w->delta = player_save_delta_enabled() != 0;
+    io_make_exe_path(w->path, sizeof(w->path), SAVE_FILE_SUBPATH);
+    w->job = asset_job_submit("savegame", player_save_write_job, w);
+}
+
 static void player_sync_loaded_player(GameState *state, PlayerState *plr, int plr_num)
 {
     int zone_slots = level_zone_slot_count(&state->level);
@@ -2207,6 +2530,60 @@ static void player_seed_facing_and_snapshots(GameState *state)
     player2_snapshot(state);
 }
 
+/* Same-level F9: restore over the running level instead of reloading it.
+ * Only for v4 saves made against this level's baseline whose chunks fit
+ * the live buffers; anything else takes the reload path. Runs the same
+ * resets as a reload (play_the_game_prepare_level); if the apply itself
+ * fails the pending save is kept and the reload restores it. */
+static bool player_save_try_apply_in_place(GameState *state, int16_t live_level)
+{
+    const FullSavePending *p = &g_full_save_pending;
+    const FullSaveHeader *hdr = &p->header;
+    const char *why = NULL;
+    uint32_t automap_count;
+
+    if (!p->valid) return false;
+    if (!state->level.data)
+        why = "no level loaded";
+    else if (hdr->current_level != live_level)
+        why = "different level";
+    else if (hdr->version < 4u)
+        why = "pre-v4 save";
+    else if (!g_save_baseline.valid || g_save_baseline.level != live_level ||
+             p->delta_info.baseline_level != live_level ||
+             p->delta_info.baseline_hash != g_save_baseline.hash)
+        why = "save was not written against this level's baseline";
+    else if (!player_save_automap_count(hdr, &automap_count))
+        why = "automap chunk invalid";
+    else if (!player_save_resolve_pending_deltas())
+        why = "delta chunks do not resolve";
+    for (int c = 0; !why && c < SAVE_CHUNK_AUTOMAP_SEEN; c++) {
+        if (c == SAVE_CHUNK_NASTY_SHOTS || c == SAVE_CHUNK_OBJECT_POINTS) continue; /* may grow */
+        if ((size_t)player_save_header_chunk_bytes(hdr, c) > player_save_live_chunk_size(&state->level, c))
+            why = "chunk larger than the live level";
+    }
+    if (why) {
+        printf("[PLAYER] load: in-place restore skipped (%s)\n", why);
+        return false;
+    }
+
+    /* What play_the_game_after_game_loop + prepare_level do around a reload. */
+    audio_mt_end();
+    play_the_game_reset_level_session(state);
+    io_invalidate_level_caches();
+    if (!player_save_apply_pending(state)) {
+        printf("[PLAYER] load: in-place restore failed\n");
+        return false;
+    }
+    renderer_build_level_sky_cache(&state->level);
+    renderer_automap_preallocate_for_level(&state->level);
+    /* No interpolation from the pre-load positions on the first frame. */
+    if (state->level.prev_object_points && state->level.object_points)
+        memcpy(state->level.prev_object_points, state->level.object_points,
+               (size_t)state->level.num_object_points * 8u);
+    return true;
+}
+
 void player_apply_save_payload_after_level_load(GameState *state)
 {
     if (player_apply_pending_full_save_after_level_load(state))
@@ -2233,6 +2610,7 @@ PlayerSaveLoadResult player_load_save_from_file(GameState *state)
     bool has_level = false;
     char magic[4];
 
+    player_save_wait_for_write();
     player_save_clear_pending_full_save();
     io_make_exe_path(path, sizeof(path), SAVE_FILE_SUBPATH);
     FILE *f = fopen(path, "rb");
@@ -2245,12 +2623,16 @@ PlayerSaveLoadResult player_load_save_from_file(GameState *state)
     }
 
     if (memcmp(magic, SAVE_MAGIC_FULL, 4) == 0) {
+        int16_t live_level = state->current_level;
         rewind(f);
         if (!player_save_read_full_save(f, state, path)) {
             fclose(f);
             return PLAYER_SAVE_LOAD_FAILED;
         }
         fclose(f);
+        if (player_save_try_apply_in_place(state, live_level))
+            return PLAYER_SAVE_LOAD_APPLIED;
+        printf("[PLAYER] load: reloading level %d to restore state\n", (int)state->current_level);
         return PLAYER_SAVE_LOAD_NEED_LEVEL_RELOAD;
     }
 
@@ -2689,22 +3071,12 @@ static void player_shoot_internal(GameState *state, PlayerState *plr,
             bulyspd = 0;
         }
 
-        /* Find free slot in player_shot_data */
-        uint8_t *shots = state->level.player_shot_data;
-        GameObject *bullet = NULL;
-        for (int i = 0; i < PLAYER_SHOT_SLOT_COUNT; i++) {
-            GameObject *candidate = (GameObject*)(shots + i * OBJECT_SIZE);
-            if (OBJ_ZONE(candidate) < 0) {
-                bullet = candidate;
-                break;
-            }
-        }
-
+        /* Find free slot in player_shot_data. The CID is baked into the slot by
+         * level data; keep it across the memset. */
+        int16_t saved_cid = -1;
+        GameObject *bullet = objects_alloc_player_shot(&state->level, &saved_cid);
         if (!bullet) return; /* No free slot */
 
-        /* Save CID before memset (it's baked into the slot by level data) */
-        int16_t saved_cid = OBJ_CID(bullet);
-
         /* Set up bullet */
         memset(bullet, 0, OBJECT_SIZE);
 
@@ -2718,6 +3090,7 @@ static void player_shoot_internal(GameState *state, PlayerState *plr,
             uint8_t *pt = state->level.object_points + (int)saved_cid * 8;
             obj_sl(pt,     (int32_t)spawn_x << 16);
             obj_sl(pt + 4, (int32_t)spawn_z << 16);
+            spatial_index_note_moved(saved_cid);
         }
 
         OBJ_SET_ZONE(bullet, plr->zone);
@@ -23,6 +23,12 @@
 void player1_control(GameState *state);
 void player2_control(GameState *state);
 
+/* Amiga raw key codes player_sim_control reads (cursor keys, shift, . and /). */
+const KeyBindings *player_default_keys(void);
+
+/* Angle units one mouse X count turns the view under this control mode (0: no mouse look). */
+int player_look_angle_scale(const ControlMode *ctrl);
+
 /* Init player positions from level data (from LevelData2.s InitPlayer) */
 void player_init_from_level(GameState *state);
 
@@ -43,10 +49,18 @@ typedef enum {
     PLAYER_SAVE_LOAD_NEED_LEVEL_RELOAD
 } PlayerSaveLoadResult;
 
-/* Read savegame.bin. Full saves stage a pending restore and request level reload. */
+/* Read savegame.bin. A full save of the running level is restored in place
+ * (APPLIED); other full saves stage a pending restore and request a reload. */
 PlayerSaveLoadResult player_load_save_from_file(GameState *state);
 
 /* After level reload, apply the pending full restore (or legacy position payload). */
 void player_apply_save_payload_after_level_load(GameState *state);
 
+/* Snapshot the freshly set-up level as the delta baseline for saves. Once per
+ * level load, before any pending restore is applied. */
+void player_save_capture_baseline(GameState *state);
+
+/* Finish an in-flight save write and free the save buffers (tear-down). */
+void player_save_shutdown(void);
+
 #endif /* PLAYER_H */
@@ -37,6 +37,9 @@
 #include "game_types.h"
 #include "visibility.h"
 #include "audio.h"
+#include "trace.h"
+#include "thread_local.h"
+#include "settings.h"
 #include <SDL.h>
 #include <stdlib.h>
 #include <string.h>
@@ -51,6 +54,42 @@
 #define AB3D_HAVE_SSE2 0
 #endif
 
+/* AVX2 gathers are compiled per function (target attribute) and only used
+ * after a runtime CPU check, so the baseline x86 build stays SSE2. */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && AB3D_HAVE_SSE2
+#include <immintrin.h>
+#define AB3D_HAVE_AVX2_TARGET 1
+#define AB3D_TARGET_AVX2 __attribute__((target("avx2")))
+#elif defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_X64))
+#include <immintrin.h>
+#define AB3D_HAVE_AVX2_TARGET 1
+#define AB3D_TARGET_AVX2
+#else
+#define AB3D_HAVE_AVX2_TARGET 0
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || (defined(_MSC_VER) && defined(_M_ARM64))
+#include <arm_neon.h>
+#define AB3D_HAVE_NEON 1
+#else
+#define AB3D_HAVE_NEON 0
+#endif
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define AB3D_HAVE_WASM_SIMD 1
+#else
+#define AB3D_HAVE_WASM_SIMD 0
+#endif
+
+/* Floor/ceiling and wall texel kernels. SCALAR is the reference path; the
+ * vector levels are chosen once at renderer_init from what was compiled in
+ * and what the CPU reports (AB3D_RASTER_SIMD=0 forces the reference). */
+#define RENDERER_RASTER_SIMD_SCALAR 0
+#define RENDERER_RASTER_SIMD_VEC128 1  /* SSE2 / NEON / wasm SIMD128 */
+#define RENDERER_RASTER_SIMD_AVX2   2  /* VEC128 addressing + AVX2 colour gathers */
+static int g_renderer_raster_simd = RENDERER_RASTER_SIMD_SCALAR;
+
 #if defined(__GNUC__) || defined(__clang__)
 #define AB3D_PREFETCH_READ(p)  __builtin_prefetch((p), 0, 0)
 #define AB3D_PREFETCH_WRITE(p) __builtin_prefetch((p), 1, 0)
@@ -155,23 +194,37 @@ static inline void renderer_cw_store_xy(uint16_t *cw, int x, int y, int width, i
 #endif
 
 #if defined(_MSC_VER)
-#define AB3D_CACHELINE_ALIGN __declspec(align(64))
-#elif defined(__GNUC__) || defined(__clang__)
-#define AB3D_CACHELINE_ALIGN __attribute__((aligned(64)))
+#define AB3D_FORCE_INLINE __forceinline
+#elif defined(__clang__) || defined(__GNUC__)
+#define AB3D_FORCE_INLINE inline __attribute__((always_inline))
 #else
-#define AB3D_CACHELINE_ALIGN
+#define AB3D_FORCE_INLINE inline
 #endif
 
 #if defined(_MSC_VER)
-#define AB3D_THREAD_LOCAL __declspec(thread)
-#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
-#define AB3D_THREAD_LOCAL _Thread_local
+#define AB3D_CACHELINE_ALIGN __declspec(align(64))
 #elif defined(__GNUC__) || defined(__clang__)
-#define AB3D_THREAD_LOCAL __thread
+#define AB3D_CACHELINE_ALIGN __attribute__((aligned(64)))
 #else
-#define AB3D_THREAD_LOCAL
+#define AB3D_CACHELINE_ALIGN
 #endif
 
+/* Per-thread frame arena backing the renderer's scratch tables (edge/column
+ * bounds, floor rows, occluder, zone-trace snapshots, zone sprite lists).
+ * Reset once per frame by the owning thread; see renderer_frame_arena_begin. */
+static AB3D_THREAD_LOCAL Ab3dArena g_renderer_frame_arena;
+/* Set by renderer_frame_arena_begin. Only renderer threads begin frames (the
+ * drawing thread in renderer_draw_display, pool workers on their world job);
+ * scratch requests from any other thread fail instead of leaving an arena
+ * on a thread that never resets or releases it. */
+static AB3D_THREAD_LOCAL int g_renderer_frame_arena_owner;
+
+static void *renderer_frame_arena_alloc(size_t size)
+{
+    if (!g_renderer_frame_arena_owner) return NULL;
+    return ab3d_arena_alloc(&g_renderer_frame_arena, size);
+}
+
 /* Sprite row caches for renderer_draw_sprite_ctx hot path (per-thread). */
 static AB3D_THREAD_LOCAL int g_sprite_src_row_lut[RENDER_INTERNAL_MAX_DIM];
 static AB3D_THREAD_LOCAL uint8_t g_sprite_col_texel_lut[256];
@@ -323,6 +376,57 @@ typedef struct {
     uint8_t valid;
 } RendererZoneSectionClip;
 
+/* Level object table is CID-terminated but physically 256 slots in level data.
+ * Sprite candidate capacity covers every potential contributor per frame. */
+#define RENDERER_OBJECT_SLOT_SCAN_CAP 256
+#define RENDERER_SPRITE_CANDIDATE_CAP (RENDERER_OBJECT_SLOT_SCAN_CAP + \
+                                       NASTY_SHOT_SLOT_MAX + \
+                                       PLAYER_SHOT_SLOT_COUNT + \
+                                       MAX_EXPLOSIONS)
+
+/* One billboard / poly object / explosion that survived the frame-invariant
+ * tests (valid point, near clip). The estimated screen x-extent lets each
+ * column strip bin it once instead of re-projecting it for every zone. */
+typedef struct {
+    int32_t sort_z;          /* painter key (poly objects: nearest vertex) */
+    int32_t screen_left;     /* estimated projected extent [left, right) */
+    int32_t screen_right;
+    int32_t spill_min_h;     /* spill sliver reject height (world Y, fixed) */
+    int16_t idx;
+    int16_t source_zone;
+    uint8_t src;             /* RENDERER_F2_SPRITE_SOURCE_* */
+    uint8_t on_upper;
+} RendererSpriteCandidate;
+
+/* Built once per frame on the main thread, in the same order the per-zone
+ * scan used to visit sources (objects, nasty shots, player shots,
+ * explosions) so the stable depth sort keeps identical painter order. */
+typedef struct {
+    int count;
+    RendererSpriteCandidate entries[RENDERER_SPRITE_CANDIDATE_CAP];
+} RendererWorldSpriteList;
+
+/* Per-strip draw list: indices into the frame list whose extent overlaps
+ * the strip's columns. Lives on the worker's stack for one world slice. */
+typedef struct {
+    const RendererWorldSpriteList *sprites;
+    int count;
+    uint16_t index[RENDERER_SPRITE_CANDIDATE_CAP];
+} RendererSpriteStripList;
+
+/* One candidate accepted for the zone being drawn, with its resolved clip. */
+typedef struct {
+    int src;
+    int idx;
+    int16_t source_zone;
+    int32_t z;
+    int16_t clip_left;
+    int16_t clip_right;
+    int32_t zone_top_world;
+    int32_t zone_bot_world;
+    uint8_t ignore_top_clip;
+} RendererZoneObjEntry;
+
 typedef struct {
     int count;
     int16_t index_by_zone_id[RENDERER_MAX_ZONE_ORDER];
@@ -333,6 +437,7 @@ typedef struct {
     uint8_t draw_upper_first[RENDERER_MAX_ZONE_ORDER];
     RendererZoneSectionClip lower_clip[RENDERER_MAX_ZONE_ORDER];
     RendererZoneSectionClip upper_clip[RENDERER_MAX_ZONE_ORDER];
+    RendererWorldSpriteList sprites;
 } RendererWorldZonePrepass;
 
 typedef struct {
@@ -433,6 +538,7 @@ typedef struct {
 static AB3D_THREAD_LOCAL uint8_t *g_zone_trace_floor_before_tags_scratch = NULL;
 static AB3D_THREAD_LOCAL uint16_t *g_zone_trace_floor_before_cw_scratch = NULL;
 static AB3D_THREAD_LOCAL size_t g_zone_trace_floor_before_scratch_cap = 0;
+static AB3D_THREAD_LOCAL unsigned g_zone_trace_floor_before_scratch_gen = 0;
 
 static int renderer_zone_trace_floor_stats_ensure_scratch(size_t need_count)
 {
@@ -443,6 +549,7 @@ static int renderer_zone_trace_floor_stats_ensure_scratch(size_t need_count)
     if (need_count == 0) return 1;
     if (g_zone_trace_floor_before_tags_scratch &&
         g_zone_trace_floor_before_cw_scratch &&
+        g_zone_trace_floor_before_scratch_gen == g_renderer_frame_arena.generation &&
         need_count <= g_zone_trace_floor_before_scratch_cap) {
         return 1;
     }
@@ -450,32 +557,26 @@ static int renderer_zone_trace_floor_stats_ensure_scratch(size_t need_count)
     new_cap = (g_zone_trace_floor_before_scratch_cap > 0)
         ? g_zone_trace_floor_before_scratch_cap : 1024u;
     while (new_cap < need_count) {
-        if (new_cap > SIZE_MAX / 2u) {
+        if (new_cap > SIZE_MAX / 4u) {
             new_cap = need_count;
             break;
         }
         new_cap *= 2u;
     }
 
-    new_tags = (uint8_t *)realloc(g_zone_trace_floor_before_tags_scratch,
-                                  new_cap * sizeof(*new_tags));
-    if (!new_tags) return 0;
+    new_tags = (uint8_t *)renderer_frame_arena_alloc(new_cap * sizeof(*new_tags));
+    new_cw = (uint16_t *)renderer_frame_arena_alloc(new_cap * sizeof(*new_cw));
+    if (!new_tags || !new_cw) return 0;
     g_zone_trace_floor_before_tags_scratch = new_tags;
-
-    new_cw = (uint16_t *)realloc(g_zone_trace_floor_before_cw_scratch,
-                                 new_cap * sizeof(*new_cw));
-    if (!new_cw) return 0;
     g_zone_trace_floor_before_cw_scratch = new_cw;
-
     g_zone_trace_floor_before_scratch_cap = new_cap;
+    g_zone_trace_floor_before_scratch_gen = g_renderer_frame_arena.generation;
     return 1;
 }
 
 static void renderer_zone_trace_floor_stats_release_scratch(void)
 {
-    free(g_zone_trace_floor_before_tags_scratch);
     g_zone_trace_floor_before_tags_scratch = NULL;
-    free(g_zone_trace_floor_before_cw_scratch);
     g_zone_trace_floor_before_cw_scratch = NULL;
     g_zone_trace_floor_before_scratch_cap = 0;
 }
@@ -517,22 +618,40 @@ static void renderer_build_world_zone_prepass(GameState *state, uint32_t frame_i
 #define RENDERER_MAX_THREADS 64
 /* Keep column strips wide enough to reduce overlap/synchronization overhead. */
 #define RENDERER_MIN_COLS_PER_WORKER 32
+/* render_thread_wait=spin: how long workers (and the dispatcher) busy-wait for the next
+ * job / completion before parking on their semaphores. Covers back-to-back dispatches
+ * (world -> tint) inside one frame without a futex round-trip. */
+#define RENDERER_THREAD_SPIN_US 200
+/* Tile schedule: each tile re-walks the zone list, so keep tiles from getting
+ * too narrow; tiles-per-worker adapts between MIN/MAX from last frame's imbalance. */
+#define RENDERER_MIN_COLS_PER_TILE 16
+#define RENDERER_MAX_WORLD_TILES 512
+#define RENDERER_TILES_PER_WORKER_MIN 2
+#define RENDERER_TILES_PER_WORKER_MAX 8
+#define RENDERER_TILES_PER_WORKER_DEFAULT 4
+/* Adaptive strips: narrowest strip a hot worker can be squeezed to, and the dead band
+ * (columns) below which a boundary is left where it is. Moves are halved per frame. */
+#define RENDERER_ADAPTIVE_MIN_STRIP_COLS 16
+#define RENDERER_ADAPTIVE_DEAD_BAND_COLS 2
 
 typedef enum {
     RENDERER_THREAD_JOB_WORLD = 0,
-    RENDERER_THREAD_JOB_WATER_TINT = 1
+    RENDERER_THREAD_JOB_WATER_TINT = 1,
+    RENDERER_THREAD_JOB_INDEXED = 2     /* renderer_parallel_for */
 } RendererThreadJobType;
 
 struct RendererThreadWorker {
     SDL_Thread *thread;
     int index;
+    SDL_atomic_t parked;     /* 1 = worker is (about to be) blocked on its semaphore */
+    SDL_atomic_t job_ticket; /* job_generation of the last dispatch this worker was assigned */
     int16_t col_start;
     int16_t col_end;
     int8_t fill_screen_water;
 #if UINTPTR_MAX > 0xFFFFFFFFu
-    char _pad[104];
+    char _pad[100];
 #else
-    char _pad[112];
+    char _pad[104];
 #endif
 };
 typedef struct RendererThreadWorker RendererThreadWorker;
@@ -557,18 +676,48 @@ typedef struct {
     const uint16_t *post_src_cw;
     uint32_t *post_dst_rgb;
     uint16_t *post_dst_cw;
+    /* Indexed job: fn(i, userdata) for i handed out from index_next. */
+    RendererIndexFn index_fn;
+    void *index_userdata;
+    int index_count;
+    SDL_atomic_t index_next;
     SDL_sem *done_sem;
+    SDL_atomic_t main_parked;  /* 1 = dispatcher is (about to be) blocked on done_sem */
+    SDL_atomic_t spin_ticks;   /* spin-then-park budget in perf counter ticks (0 = block at once) */
     SDL_sem *worker_sems[RENDERER_MAX_THREADS];
     RendererThreadWorker workers[RENDERER_MAX_THREADS];
     RendererWorkloadStats worker_world_stats[RENDERER_MAX_THREADS];
+    /* Per-worker busy time of the last world job (perf counter ticks). */
+    uint64_t worker_busy_ticks[RENDERER_MAX_THREADS];
+    /* Work-stealing tile schedule (world job only): 0 tiles = fixed strips. */
+    int world_tile_count;
+    int world_tiles_per_worker;
+    SDL_atomic_t world_next_tile;
+    int16_t world_tile_bounds[RENDERER_MAX_WORLD_TILES + 1];
+    /* Adaptive strip schedule: bounds carried between frames (reset on width/worker change). */
+    int adaptive_width;
+    int adaptive_workers;
+    int32_t adaptive_bounds[RENDERER_MAX_THREADS + 1];
     int last_logged_strip_width;
     int last_logged_workers;
+    int last_logged_tile_width;
+    int last_logged_tile_workers;
 } RendererThreadPool;
 
 static RendererThreadPool g_renderer_thread_pool;
 static int g_prof_last_world_workers = 0;
 static int g_prof_last_tint_workers = 0;
 static int g_renderer_thread_max_workers = 0; /* 0 = use max available workers */
+static int g_renderer_thread_schedule = RENDER_THREAD_SCHEDULE_STRIPS;
+static int g_renderer_thread_wait = RENDER_THREAD_WAIT_BLOCK;
+
+#if AB3D_HAVE_SSE2
+#define AB3D_CPU_RELAX() _mm_pause()
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__aarch64__) || defined(__arm__))
+#define AB3D_CPU_RELAX() __asm__ __volatile__("yield" ::: "memory")
+#else
+#define AB3D_CPU_RELAX() ((void)0)
+#endif
 #endif
 
 #if defined(__EMSCRIPTEN__) && !defined(AB3D_NO_THREADS)
@@ -602,6 +751,12 @@ static int renderer_resolve_lgr_entry_zone_id(const LevelState *level, int16_t e
     if (level && level->zone_graph_adds && level->graphics) {
         if (level->num_zone_graph_entries > 0 && entry_word >= level->num_zone_graph_entries)
             return 0;
+        if (level->decoded && entry_word < level->decoded->num_graph_entries) {
+            int32_t zid = level->decoded->graph_zone_id[entry_word];
+            if (zid == LEVEL_GRAPH_ZONE_NONE) return 0;
+            *out_zone_id = (int16_t)zid;
+            return 1;
+        }
         {
             uint32_t gfx_off = (uint32_t)rd32(level->zone_graph_adds + (unsigned)entry_word * 8u);
             if (level->graphics_byte_count > 0 &&
@@ -662,6 +817,9 @@ static uint32_t g_automap_last_door_refresh_ms = 0;
 
 /* Workers run renderer_draw_world_slice in parallel; automap updates must be serialized. */
 static SDL_mutex *g_automap_mutex;
+/* Bumped (under the automap lock) whenever an already-seen wall's colour changes or the
+ * list is rewritten outside the append path; renderer_automap_copy_walls reports it. */
+static uint32_t g_automap_wall_rev = 1;
 
 /* Door metadata lookup caches:
  *  - (zone_id + wall gfx_off) -> raw door flags
@@ -699,7 +857,16 @@ static AutomapStagedWall *g_automap_stage_walls[RENDERER_AUTOMAP_STAGE_SLOT_COUN
 static uint32_t g_automap_stage_counts[RENDERER_AUTOMAP_STAGE_SLOT_COUNT];
 static uint32_t g_automap_stage_caps[RENDERER_AUTOMAP_STAGE_SLOT_COUNT];
 
-/* Synthesized backdrop sky-hole polygons, built once per level load. */
+/* Committed walls by gfx_off (one bit per LEVELGRAPHICS byte). Only automap_mark_seen_locked
+ * writes it, on the main thread between world dispatches; render workers read it without
+ * the lock so walls the automap already has are not re-staged (and re-committed) every frame. */
+static uint32_t *g_automap_seen_bits;
+static uint32_t g_automap_seen_bits_words;
+static const uint8_t *g_automap_seen_bits_graphics;
+
+/* Synthesized backdrop sky-hole polygons. Level load only snapshots the per-zone inputs
+ * (backdrop flag, open-roof signs); each zone's polygons are synthesized the first time
+ * it reaches the draw order (renderer_level_sky_cache_prepare_zone, main thread only). */
 typedef struct {
     int16_t sides;
     int16_t pt_indices[100];
@@ -723,14 +890,49 @@ static uint32_t g_level_sky_cache_poly_count;
 static uint32_t g_level_sky_cache_poly_cap;
 static RendererSkyCacheBucket *g_level_sky_cache_buckets;
 static int g_level_sky_cache_zone_slots;
+static uint8_t *g_level_sky_cache_zone_state;   /* RENDERER_SKY_ZONE_* per zone slot */
+
+#define RENDERER_SKY_ZONE_BUILT       0x01u
+#define RENDERER_SKY_ZONE_BACKDROP    0x02u
+#define RENDERER_SKY_ZONE_LOWER_OPEN  0x04u
+#define RENDERER_SKY_ZONE_UPPER_OPEN  0x08u
 
 static void renderer_reset_level_sky_cache_internal(void);
+static void sky_pan_cache_release(void);
 static void renderer_floor_fast_release_scratch(void);
 static int renderer_poly_edge_ensure_h(int h);
 static int renderer_poly_col_ensure_w(int w);
 static int16_t *renderer_viewer_floor_occlude_get_scratch(int width);
 static int renderer_floor_fast_ensure_rows_capacity(int row_count);
 static int renderer_floor_fast_ensure_cols_capacity(int col_count);
+static void renderer_raster_simd_detect(void);
+static void renderer_zone_objects_release_scratch(void);
+
+/* Start a frame on the calling thread's arena (worker_index < 0: main
+ * thread). Reports the high-water mark whenever the arena had to grow,
+ * which should only happen on the first frames or after a resize. */
+static void renderer_frame_arena_begin(int worker_index)
+{
+    g_renderer_frame_arena_owner = 1;
+    if (ab3d_arena_reset(&g_renderer_frame_arena)) {
+        char owner[24];
+        if (worker_index < 0) snprintf(owner, sizeof(owner), "main");
+        else snprintf(owner, sizeof(owner), "worker %d", worker_index);
+        printf("[RENDERER] Frame arena (%s) grown to %u KB (high-water %u KB)\n",
+               owner,
+               (unsigned)(g_renderer_frame_arena.capacity / 1024u),
+               (unsigned)(g_renderer_frame_arena.high_water / 1024u));
+    }
+}
+
+static void renderer_frame_arena_release(void)
+{
+    renderer_floor_fast_release_scratch();
+    renderer_zone_trace_floor_stats_release_scratch();
+    renderer_zone_objects_release_scratch();
+    ab3d_arena_release(&g_renderer_frame_arena);
+    g_renderer_frame_arena_owner = 0;
+}
 static uint8_t automap_level_key_mask(const LevelState *level);
 static void automap_stage_release(void);
 static void automap_stage_reset_frame(void);
@@ -740,6 +942,7 @@ static void automap_stage_seen_wall(int stage_slot,
                                     int16_t x1, int16_t z1,
                                     int16_t x2, int16_t z2);
 static void automap_commit_staged_walls(LevelState *level);
+static uint16_t automap_wall_c12(const AutomapSeenWall *sw);
 
 static void automap_lock(void)
 {
@@ -787,6 +990,40 @@ static void automap_stage_release(void)
         g_automap_stage_counts[i] = 0;
         g_automap_stage_caps[i] = 0;
     }
+    free(g_automap_seen_bits);
+    g_automap_seen_bits = NULL;
+    g_automap_seen_bits_words = 0;
+    g_automap_seen_bits_graphics = NULL;
+}
+
+static inline int automap_seen_bit_test(const LevelState *level, uint32_t gfx_off)
+{
+    return g_automap_seen_bits_graphics == level->graphics &&
+           (gfx_off >> 5) < g_automap_seen_bits_words &&
+           ((g_automap_seen_bits[gfx_off >> 5] >> (gfx_off & 31u)) & 1u) != 0u;
+}
+
+/* Call with the automap lock held, never while a world dispatch is running. */
+static void automap_seen_bit_set(const LevelState *level, uint32_t gfx_off)
+{
+    uint32_t words = (level->graphics_byte_count + 31u) >> 5;
+    if (g_automap_seen_bits_graphics != level->graphics || g_automap_seen_bits_words != words) {
+        uint32_t *bits = (uint32_t *)realloc(g_automap_seen_bits, (size_t)words * sizeof(uint32_t));
+        if (!bits) return;
+        memset(bits, 0, (size_t)words * sizeof(uint32_t));
+        g_automap_seen_bits = bits;
+        g_automap_seen_bits_words = words;
+        g_automap_seen_bits_graphics = level->graphics;
+    }
+    if ((gfx_off >> 5) < words)
+        g_automap_seen_bits[gfx_off >> 5] |= 1u << (gfx_off & 31u);
+}
+
+/* The seen list was rewritten (level unload, save restore): re-stage everything once. */
+static void automap_seen_bits_clear(void)
+{
+    if (g_automap_seen_bits)
+        memset(g_automap_seen_bits, 0, (size_t)g_automap_seen_bits_words * sizeof(uint32_t));
 }
 
 static void automap_stage_reset_frame(void)
@@ -902,6 +1139,9 @@ static int automap_door_lookup_rebuild_locked(const LevelState *level)
     uint32_t mask_gfx;
 
     automap_door_lookup_release();
+    /* New door data: committed walls are staged once more so their recommit
+     * re-checks is_door against it (automap_mark_seen_locked). */
+    automap_seen_bits_clear();
 
     if (!level || !level->door_wall_list || !level->door_wall_list_offsets || !level->door_data || level->num_doors <= 0) {
         g_automap_door_lookup_level = level;
@@ -1564,6 +1804,10 @@ static void automap_mark_seen_locked(LevelState *level,
     if (!level->graphics || level->graphics_byte_count == 0) return;
     if (gfx_off == 0 || gfx_off >= level->graphics_byte_count) return;
 
+    /* Only stop re-staging a wall once its door verdict is final (door lookup built for
+     * this level's door data); until then every recommit must reach the is_door fix-up. */
+    const int door_verdict_final = automap_door_lookup_matches_level(level);
+
     /* Lazy init structures. */
     if (!automap_ensure_hash(level, 2048u)) {
         return;
@@ -1589,6 +1833,7 @@ static void automap_mark_seen_locked(LevelState *level,
                 AutomapSeenWall *ew = &level->automap_seen_walls[idx];
                 uint32_t ek = renderer_automap_seen_key_plus1(ew->gfx_off, ew->x1, ew->z1, ew->x2, ew->z2);
                 if (ek == key_plus1) {
+                    uint16_t old_c12 = automap_wall_c12(ew);
                     /* Existing entry: refresh metadata so stale color assignments self-heal. */
                     if (is_door) {
                         ew->is_door = 1;
@@ -1605,6 +1850,10 @@ static void automap_mark_seen_locked(LevelState *level,
                         }
                         ew->reserved = meta;
                     }
+                    if (automap_wall_c12(ew) != old_c12)
+                        g_automap_wall_rev++;
+                    if (door_verdict_final)
+                        automap_seen_bit_set(level, gfx_off);
                     return; /* already seen */
                 }
             }
@@ -1629,6 +1878,8 @@ static void automap_mark_seen_locked(LevelState *level,
     }
 
     level->automap_seen_hash[h] = level->automap_seen_count;
+    if (door_verdict_final)
+        automap_seen_bit_set(level, gfx_off);
 }
 
 static AB3D_ATTR_UNUSED void automap_mark_seen(LevelState *level,
@@ -1684,6 +1935,43 @@ static inline uint16_t automap_color_for(uint8_t is_door, uint8_t key_id)
     return 0x0F0Fu; /* hot pink: any key-locked door */
 }
 
+/* Overlay colour + segment flags for one seen wall. Internal edge dimming uses metadata
+ * from automap_mark_seen only; a per-frame automap_segment_is_internal_connected was
+ * O(seen * floor_lines) and froze. */
+static uint16_t automap_wall_c12(const AutomapSeenWall *sw)
+{
+    uint16_t c12 = automap_color_for(sw->is_door, sw->door_key_id);
+    if (automap_meta_internal_known(sw->reserved) && automap_meta_internal(sw->reserved))
+        c12 = (uint16_t)(c12 | RENDERER_AUTOMAP_SEGFLAG_INTERNAL);
+    return c12;
+}
+
+/* Door state / key pickup: expensive scan - at most every 250 ms, not every frame
+ * (was freezing the game). Call with the automap lock held. */
+static void automap_refresh_door_keys_locked(LevelState *level)
+{
+    uint32_t now_ms = SDL_GetTicks();
+    if (g_automap_last_door_refresh_ms != 0u && now_ms - g_automap_last_door_refresh_ms < 250u)
+        return;
+    g_automap_last_door_refresh_ms = now_ms;
+    if (!level->automap_seen_walls) return;
+
+    for (uint32_t i = 0; i < level->automap_seen_count; i++) {
+        AutomapSeenWall *sw = &level->automap_seen_walls[i];
+        if (!sw->is_door) continue;
+        int now_is_door = 0;
+        int16_t zone_hint = automap_unpack_zone_hint(sw->reserved);
+        uint8_t now_key_id = automap_door_key_for_wall_gfx_off(level, sw->gfx_off,
+                                                                sw->x1, sw->z1, sw->x2, sw->z2,
+                                                                zone_hint,
+                                                                &now_is_door);
+        if (now_is_door && now_key_id != sw->door_key_id) {
+            sw->door_key_id = now_key_id;
+            g_automap_wall_rev++;
+        }
+    }
+}
+
 uint16_t renderer_key_condition_bit_color_c12(const GameState *state, int bit_index)
 {
     if (!state || bit_index < 0 || bit_index > 3) return 0;
@@ -1780,6 +2068,9 @@ void renderer_automap_lock(void)
 
 void renderer_automap_unlock(void)
 {
+    /* External holders (level unload, save restore) rewrite the seen list wholesale. */
+    g_automap_wall_rev++;
+    automap_seen_bits_clear();
     automap_unlock();
 }
 
@@ -1848,33 +2139,13 @@ int renderer_automap_collect_line_segments(GameState *state,
     /* Reserve last 3 slots for the player arrow so overlay draws walls first, player on top. */
     int wall_cap = (max_lines >= 3) ? (max_lines - 3) : max_lines;
 
-    uint32_t now_ms = SDL_GetTicks();
-    int refresh_doors = (g_automap_last_door_refresh_ms == 0u) ||
-        (now_ms - g_automap_last_door_refresh_ms >= 250u);
-    if (refresh_doors)
-        g_automap_last_door_refresh_ms = now_ms;
-
     automap_lock();
     if (level->automap_seen_walls && level->automap_seen_count != 0) {
         automap_refresh_key_bit_colors(level);
+        automap_refresh_door_keys_locked(level);
 
         for (uint32_t i = 0; i < level->automap_seen_count && n < wall_cap; i++) {
-        AutomapSeenWall *sw = &level->automap_seen_walls[i];
-        uint8_t is_door = sw->is_door;
-        uint8_t key_id = sw->door_key_id;
-        /* Door state / key pickup: expensive scan — not every frame (was freezing the game). */
-        if (is_door && refresh_doors) {
-            int now_is_door = 0;
-            int16_t zone_hint = automap_unpack_zone_hint(sw->reserved);
-            uint8_t now_key_id = automap_door_key_for_wall_gfx_off(level, sw->gfx_off,
-                                                                    sw->x1, sw->z1, sw->x2, sw->z2,
-                                                                    zone_hint,
-                                                                    &now_is_door);
-            if (now_is_door && now_key_id != key_id) {
-                key_id = now_key_id;
-                sw->door_key_id = now_key_id;
-            }
-        }
+        const AutomapSeenWall *sw = &level->automap_seen_walls[i];
         int32_t ax0 = (int32_t)sw->x1 - (int32_t)px;
         int32_t az0 = (int32_t)sw->z1 - (int32_t)pz;
         int32_t ax1 = (int32_t)sw->x2 - (int32_t)px;
@@ -1887,14 +2158,7 @@ int renderer_automap_collect_line_segments(GameState *state,
         y0[n] = wy0;
         x1[n] = mx - wx1;
         y1[n] = wy1;
-        {
-            /* Internal edge dimming uses metadata from automap_mark_seen only. Per-frame
-             * automap_segment_is_internal_connected here was O(seen * floor_lines) and froze. */
-            uint16_t meta = sw->reserved;
-            c12[n] = automap_color_for(is_door, key_id);
-            if (automap_meta_internal_known(meta) && automap_meta_internal(meta))
-                c12[n] = (uint16_t)(c12[n] | RENDERER_AUTOMAP_SEGFLAG_INTERNAL);
-        }
+        c12[n] = automap_wall_c12(sw);
         n++;
         }
     }
@@ -1928,6 +2192,43 @@ int renderer_automap_collect_line_segments(GameState *state,
     return n;
 }
 
+int renderer_automap_copy_walls(GameState *state, uint32_t first,
+                                RendererAutomapWall *out, int max_walls, uint32_t *out_rev)
+{
+    int n = 0;
+
+    if (out_rev) *out_rev = 0;
+    if (!state || !out || max_walls < 1) return 0;
+    LevelState *level = &state->level;
+
+    automap_lock();
+    if (level->automap_seen_walls && level->automap_seen_count != 0) {
+        automap_refresh_key_bit_colors(level);
+        automap_refresh_door_keys_locked(level);
+        for (uint32_t i = first; i < level->automap_seen_count && n < max_walls; i++) {
+            const AutomapSeenWall *sw = &level->automap_seen_walls[i];
+            out[n].x1 = sw->x1;
+            out[n].z1 = sw->z1;
+            out[n].x2 = sw->x2;
+            out[n].z2 = sw->z2;
+            out[n].c12 = automap_wall_c12(sw);
+            n++;
+        }
+    }
+    if (out_rev) *out_rev = g_automap_wall_rev;
+    automap_unlock();
+    return n;
+}
+
+void renderer_automap_get_view(const GameState *state, int32_t *out_px, int32_t *out_pz,
+                               int32_t *out_units_per_px)
+{
+    const PlayerState *plr = (state->mode == MODE_SLAVE) ? &state->plr2 : &state->plr1;
+    *out_px = (int16_t)(plr->xoff >> 16);
+    *out_pz = (int16_t)(plr->zoff >> 16);
+    *out_units_per_px = (g_automap_units_per_px < 1) ? 1 : g_automap_units_per_px;
+}
+
 /* -----------------------------------------------------------------------
  * SCALE table (from Macros.i)
  *
@@ -1999,6 +2300,7 @@ typedef AB3D_CACHELINE_ALIGN struct {
     uint8_t profile_collect_stats;
     uint8_t _profile_pad[3];
     const RendererWorldZonePrepass *zone_prepass;
+    const RendererSpriteStripList *sprite_strip;
     RendererWorkloadStats workload_stats;
 
     /* ---- Cold: floor palette span cache (lazily populated) ---- */
@@ -2050,6 +2352,7 @@ static void render_slice_context_init(RenderSliceContext *ctx,
     renderer_workload_stats_reset(&ctx->workload_stats);
     ctx->profile_collect_stats = g_renderer_profile_collect_stats ? 1u : 0u;
     ctx->zone_prepass = NULL;
+    ctx->sprite_strip = NULL;
     ctx->floor_pal_cache_src = NULL;
     ctx->floor_pal_cache_all_levels_ready = 0u;
     memset(ctx->floor_pal_cache_valid, 0, sizeof(ctx->floor_pal_cache_valid));
@@ -2073,6 +2376,12 @@ static inline uint32_t *renderer_active_rgb(void)
     return g_renderer.rgb_buffer;
 }
 
+/* The ARGB plane only exists while raster expand is on; a NULL plane is fine otherwise. */
+static inline int renderer_rgb_target_ok(const uint32_t *rgb)
+{
+    return rgb != NULL || !g_renderer_rgb_raster_expand;
+}
+
 static inline uint16_t *renderer_active_cw(void)
 {
     return g_renderer.cw_buffer;
@@ -2181,11 +2490,6 @@ uint16_t *renderer_get_active_cw_target(void)
     return renderer_active_cw();
 }
 
-void renderer_set_rgb_raster_expand(int enabled)
-{
-    g_renderer_rgb_raster_expand = enabled ? 1 : 0;
-}
-
 int renderer_get_rgb_raster_expand(void)
 {
     return g_renderer_rgb_raster_expand;
@@ -2199,11 +2503,106 @@ static int8_t merge_fill_screen_water(int8_t a, int8_t b)
     return 0;
 }
 
+/* Spin-then-park wait for this worker's next job ticket.
+ * Parking handshake: the worker sets parked=1 and then re-checks its ticket; the dispatcher
+ * bumps the ticket and only posts the semaphore if it wins the parked 1->0 CAS. Whoever loses
+ * the CAS knows the other side already acted, so no wakeup is lost and no post leaks (stale
+ * posts from mode switches are absorbed by the ticket re-check after SemWait).
+ * Returns 0 when the pool is stopping. */
+static int renderer_thread_worker_wait_job(RendererThreadPool *pool, RendererThreadWorker *worker,
+                                           int last_ticket, int *out_ticket)
+{
+    SDL_sem *sem = pool->worker_sems[worker->index];
+    for (;;) {
+        uint64_t spin_ticks = (uint64_t)(uint32_t)SDL_AtomicGet(&pool->spin_ticks);
+        if (spin_ticks > 0) {
+            uint64_t spin_start = SDL_GetPerformanceCounter();
+            for (unsigned n = 0;; n++) {
+                int ticket = SDL_AtomicGet(&worker->job_ticket);
+                if (SDL_AtomicGet(&pool->stop)) return 0;
+                if (ticket != last_ticket) {
+                    *out_ticket = ticket;
+                    return 1;
+                }
+                AB3D_CPU_RELAX();
+                if ((n & 63u) == 63u && SDL_GetPerformanceCounter() - spin_start >= spin_ticks) break;
+            }
+        }
+
+        SDL_AtomicSet(&worker->parked, 1);
+        {
+            int ticket = SDL_AtomicGet(&worker->job_ticket);
+            int stopping = SDL_AtomicGet(&pool->stop);
+            if ((ticket != last_ticket || stopping) && SDL_AtomicCAS(&worker->parked, 1, 0)) {
+                if (stopping) return 0;
+                *out_ticket = ticket;
+                return 1;
+            }
+        }
+        SDL_SemWait(sem);
+        SDL_AtomicSet(&worker->parked, 0);
+        if (SDL_AtomicGet(&pool->stop)) return 0;
+        {
+            int ticket = SDL_AtomicGet(&worker->job_ticket);
+            if (ticket != last_ticket) {
+                *out_ticket = ticket;
+                return 1;
+            }
+        }
+        /* Stale wakeup (post raced with a ticket we already consumed): wait again. */
+    }
+}
+
+/* Hand the current job_generation to workers [0,active_workers) and wake the parked ones. */
+static void renderer_thread_pool_wake_workers(RendererThreadPool *pool, int active_workers)
+{
+    int ticket = SDL_AtomicGet(&pool->job_generation);
+    for (int i = 0; i < active_workers; i++) {
+        RendererThreadWorker *worker = &pool->workers[i];
+        SDL_AtomicSet(&worker->job_ticket, ticket);
+        if (SDL_AtomicCAS(&worker->parked, 1, 0)) {
+            SDL_SemPost(pool->worker_sems[i]);
+        }
+    }
+}
+
+/* Dispatcher side: wait until pending_workers hits zero (same spin-then-park handshake,
+ * against main_parked / done_sem). */
+static void renderer_thread_pool_wait_done(RendererThreadPool *pool)
+{
+    uint64_t spin_ticks = (uint64_t)(uint32_t)SDL_AtomicGet(&pool->spin_ticks);
+    if (spin_ticks > 0) {
+        uint64_t spin_start = SDL_GetPerformanceCounter();
+        for (unsigned n = 0;; n++) {
+            if (SDL_AtomicGet(&pool->pending_workers) == 0) return;
+            AB3D_CPU_RELAX();
+            if ((n & 63u) == 63u && SDL_GetPerformanceCounter() - spin_start >= spin_ticks) break;
+        }
+    }
+    SDL_AtomicSet(&pool->main_parked, 1);
+    if (SDL_AtomicGet(&pool->pending_workers) == 0 && SDL_AtomicCAS(&pool->main_parked, 1, 0)) {
+        return;
+    }
+    SDL_SemWait(pool->done_sem);
+}
+
+/* Called once per dispatch from the main thread: pick up ab3d.ini render_thread_wait. */
+static void renderer_thread_pool_apply_wait_policy(RendererThreadPool *pool)
+{
+    uint64_t ticks = 0;
+    if (g_renderer_thread_wait == RENDER_THREAD_WAIT_SPIN) {
+        ticks = (SDL_GetPerformanceFrequency() * (uint64_t)RENDERER_THREAD_SPIN_US) / 1000000u;
+        if (ticks == 0) ticks = 1;
+        if (ticks > 0x7FFFFFFFu) ticks = 0x7FFFFFFFu;
+    }
+    SDL_AtomicSet(&pool->spin_ticks, (int)ticks);
+}
+
 static int renderer_thread_worker_main(void *userdata)
 {
     RendererThreadWorker *worker = (RendererThreadWorker*)userdata;
     RendererThreadPool *pool = &g_renderer_thread_pool;
-    int last_job_generation = 0;
+    int last_job_ticket = 0;
     if (!worker) return 0;
 
     if (worker->index < 0 || worker->index >= pool->worker_count ||
@@ -2211,26 +2610,21 @@ static int renderer_thread_worker_main(void *userdata)
         return 0;
     }
 
-    last_job_generation = SDL_AtomicGet(&pool->job_generation);
+    last_job_ticket = SDL_AtomicGet(&worker->job_ticket);
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "render worker %d", worker->index);
+        trace_set_thread_name(name);
+    }
 
     for (;;) {
-        SDL_SemWait(pool->worker_sems[worker->index]);
-
-        if (SDL_AtomicGet(&pool->stop)) {
-            renderer_floor_fast_release_scratch();
-            renderer_zone_trace_floor_stats_release_scratch();
+        int job_ticket = last_job_ticket;
+        if (!renderer_thread_worker_wait_job(pool, worker, last_job_ticket, &job_ticket)) {
+            renderer_frame_arena_release();
             return 0;
         }
-
-        {
-            int job_generation = SDL_AtomicGet(&pool->job_generation);
-            if (job_generation == last_job_generation) {
-                /* Ignore duplicate/stale wakeups; each worker runs at most once per dispatch. */
-                continue;
-            }
-            SDL_MemoryBarrierAcquire();
-            last_job_generation = job_generation;
-        }
+        SDL_MemoryBarrierAcquire();
+        last_job_ticket = job_ticket;
 
         const int active = (worker->index < pool->active_workers);
         const int16_t col_start = worker->col_start;
@@ -2246,13 +2640,18 @@ static int renderer_thread_worker_main(void *userdata)
         uint32_t *post_dst_rgb = pool->post_dst_rgb;
         uint16_t *post_dst_cw = pool->post_dst_cw;
 
+        const int world_tile_count = (job_type == RENDERER_THREAD_JOB_WORLD) ? pool->world_tile_count : 0;
         int8_t fill_screen_water = 0;
         RendererWorkloadStats world_stats;
+        uint64_t busy_t0 = SDL_GetPerformanceCounter();
+        uint64_t trace_job = trace_begin();
         renderer_workload_stats_reset(&world_stats);
-        if (active && col_start < col_end) {
+        if (active && (world_tile_count > 0 || col_start < col_end)) {
             if (job_type == RENDERER_THREAD_JOB_WORLD && state) {
-                /* Pre-size thread-local scratch once at the start of this worker
-                 * job so we avoid first-use reallocs inside hot zone loops. */
+                /* One world job per frame: reset this worker's arena, then carve
+                 * its scratch tables up front instead of on first use inside hot
+                 * zone loops. */
+                renderer_frame_arena_begin(worker->index);
                 {
                     int w = g_renderer.width;
                     int h = g_renderer.height;
@@ -2266,31 +2665,66 @@ static int renderer_thread_worker_main(void *userdata)
                         (void)renderer_floor_fast_ensure_cols_capacity(w);
                     }
                 }
-                renderer_draw_world_slice(state, world_zone_prepass,
-                                          col_start, col_end,
-                                          frame_idx, trace_clip,
-                                          worker->index,
-                                          &fill_screen_water, &world_stats);
-                if (state->cfg_weapon_draw)
-                    renderer_draw_gun_columns(state, col_start, col_end);
+                if (world_tile_count > 0) {
+                    /* Pull tiles until the shared counter runs past the end; workers that
+                     * finish cheap tiles early simply take more of them. */
+                    for (;;) {
+                        int tile = SDL_AtomicAdd(&pool->world_next_tile, 1);
+                        int8_t tile_water = 0;
+                        RendererWorkloadStats tile_stats;
+                        if (tile >= world_tile_count) break;
+                        uint64_t trace_tile = trace_begin();
+                        renderer_draw_world_slice(state, world_zone_prepass,
+                                                  pool->world_tile_bounds[tile],
+                                                  pool->world_tile_bounds[tile + 1],
+                                                  frame_idx, trace_clip,
+                                                  worker->index,
+                                                  &tile_water, &tile_stats);
+                        if (state->cfg_weapon_draw)
+                            renderer_draw_gun_columns(state, pool->world_tile_bounds[tile],
+                                                      pool->world_tile_bounds[tile + 1]);
+                        fill_screen_water = merge_fill_screen_water(fill_screen_water, tile_water);
+                        renderer_workload_stats_add(&world_stats, &tile_stats);
+                        trace_end("world tile", trace_tile);
+                    }
+                } else {
+                    renderer_draw_world_slice(state, world_zone_prepass,
+                                              col_start, col_end,
+                                              frame_idx, trace_clip,
+                                              worker->index,
+                                              &fill_screen_water, &world_stats);
+                    if (state->cfg_weapon_draw)
+                        renderer_draw_gun_columns(state, col_start, col_end);
+                }
             } else if (job_type == RENDERER_THREAD_JOB_WATER_TINT) {
                 renderer_apply_underwater_tint_slice(tint_fill_screen_water,
                                                      0, (int16_t)g_renderer.height,
                                                      col_start, col_end,
                                                      post_src_rgb, post_src_cw,
                                                      post_dst_rgb, post_dst_cw);
+            } else if (job_type == RENDERER_THREAD_JOB_INDEXED) {
+                for (;;) {
+                    int i = SDL_AtomicAdd(&pool->index_next, 1);
+                    if (i >= pool->index_count) break;
+                    pool->index_fn(i, pool->index_userdata);
+                }
             }
             AB3D_NT_STORE_FENCE();
+            trace_end((job_type == RENDERER_THREAD_JOB_WORLD) ? "world strip" :
+                      (job_type == RENDERER_THREAD_JOB_WATER_TINT) ? "tint strip" : "parallel_for",
+                      trace_job);
         }
 
         worker->fill_screen_water = fill_screen_water;
         if (worker->index >= 0 && worker->index < RENDERER_MAX_THREADS) {
             pool->worker_world_stats[worker->index] = world_stats;
+            if (job_type == RENDERER_THREAD_JOB_WORLD)
+                pool->worker_busy_ticks[worker->index] = SDL_GetPerformanceCounter() - busy_t0;
         }
         if (active) {
             /* SDL_AtomicAdd returns the value before the add; last worker sees previous==1. */
             int prev = SDL_AtomicAdd(&pool->pending_workers, -1);
-            if (prev == 1) {
+            if (prev == 1 && SDL_AtomicCAS(&pool->main_parked, 1, 0)) {
                 SDL_SemPost(pool->done_sem);
             }
         }
@@ -2340,6 +2774,9 @@ static void renderer_threads_init(void)
     memset(pool, 0, sizeof(*pool));
     pool->last_logged_strip_width = -1;
     pool->last_logged_workers = -1;
+    pool->last_logged_tile_width = -1;
+    pool->last_logged_tile_workers = -1;
+    pool->world_tiles_per_worker = RENDERER_TILES_PER_WORKER_DEFAULT;
 
     int cpu_count = SDL_GetCPUCount();
     if (cpu_count < 1) cpu_count = 1;
@@ -2454,6 +2891,143 @@ static int renderer_prepare_worker_columns(RendererThreadPool *pool, int width,
     return active_workers;
 }
 
+/* Cut [0,width) into equal narrow tiles for the work-stealing world schedule.
+ * Tile count is active_workers * world_tiles_per_worker, capped so a tile never
+ * drops below RENDERER_MIN_COLS_PER_TILE columns. */
+static int renderer_prepare_world_tiles(RendererThreadPool *pool, int width, int active_workers)
+{
+    int tiles_per_worker = pool->world_tiles_per_worker;
+    int tile_count;
+    int max_tiles_by_cols;
+    if (tiles_per_worker < RENDERER_TILES_PER_WORKER_MIN) tiles_per_worker = RENDERER_TILES_PER_WORKER_MIN;
+    if (tiles_per_worker > RENDERER_TILES_PER_WORKER_MAX) tiles_per_worker = RENDERER_TILES_PER_WORKER_MAX;
+    pool->world_tiles_per_worker = tiles_per_worker;
+
+    tile_count = active_workers * tiles_per_worker;
+    max_tiles_by_cols = width / RENDERER_MIN_COLS_PER_TILE;
+    if (max_tiles_by_cols < 1) max_tiles_by_cols = 1;
+    if (tile_count > max_tiles_by_cols) tile_count = max_tiles_by_cols;
+    if (tile_count > RENDERER_MAX_WORLD_TILES) tile_count = RENDERER_MAX_WORLD_TILES;
+    if (tile_count < 1) tile_count = 1;
+
+    for (int i = 0; i <= tile_count; i++) {
+        pool->world_tile_bounds[i] = (int16_t)(((int64_t)i * (int64_t)width) / (int64_t)tile_count);
+    }
+    pool->world_tile_count = tile_count;
+    SDL_AtomicSet(&pool->world_next_tile, 0);
+
+    if (pool->last_logged_tile_width != width || pool->last_logged_tile_workers != active_workers) {
+        printf("[RENDERER] threading: dispatch %d column tile(s) to %d worker(s) over width=%d\n",
+               tile_count, active_workers, width);
+        pool->last_logged_tile_width = width;
+        pool->last_logged_tile_workers = active_workers;
+    }
+    return tile_count;
+}
+
+/* Tile granularity feedback: finer tiles when last frame's busiest worker ran well past
+ * the mean (tail latency), coarser when balanced (less per-tile zone-walk overhead). */
+static void renderer_update_world_tile_granularity(RendererThreadPool *pool, int active_workers)
+{
+    uint64_t max_ticks = 0;
+    uint64_t sum_ticks = 0;
+    if (active_workers <= 1) return;
+    for (int i = 0; i < active_workers; i++) {
+        uint64_t t = pool->worker_busy_ticks[i];
+        sum_ticks += t;
+        if (t > max_ticks) max_ticks = t;
+    }
+    if (sum_ticks == 0) return;
+    /* Compare max * n against sum (= mean * n) in integer space: above 115% adds tiles, below 105% removes them. */
+    if (max_ticks * (uint64_t)active_workers * 100u > sum_ticks * 115u) {
+        if (pool->world_tiles_per_worker < RENDERER_TILES_PER_WORKER_MAX)
+            pool->world_tiles_per_worker++;
+    } else if (max_ticks * (uint64_t)active_workers * 100u < sum_ticks * 105u) {
+        if (pool->world_tiles_per_worker > RENDERER_TILES_PER_WORKER_MIN)
+            pool->world_tiles_per_worker--;
+    }
+}
+
+/* Adaptive strip schedule: overwrite the uniform strips from renderer_prepare_worker_columns
+ * with the bounds carried over from the previous frame's feedback. */
+static void renderer_apply_adaptive_worker_columns(RendererThreadPool *pool, int width, int active_workers)
+{
+    if (pool->adaptive_width != width || pool->adaptive_workers != active_workers) {
+        for (int i = 0; i <= active_workers; i++) {
+            pool->adaptive_bounds[i] = (int32_t)(((int64_t)i * (int64_t)width) / (int64_t)active_workers);
+        }
+        pool->adaptive_width = width;
+        pool->adaptive_workers = active_workers;
+    }
+    for (int i = 0; i < active_workers; i++) {
+        pool->workers[i].col_start = (int16_t)pool->adaptive_bounds[i];
+        pool->workers[i].col_end = (int16_t)pool->adaptive_bounds[i + 1];
+    }
+}
+
+/* Move adaptive strip bounds toward equal cost. Last frame's cost is taken as uniform within
+ * each strip (busy ticks / strip width), so the cumulative cost curve is piecewise linear;
+ * cut it at i/n of the total, then move each bound halfway there (dead band suppresses jitter). */
+static void renderer_update_adaptive_strip_bounds(RendererThreadPool *pool, int active_workers)
+{
+    int32_t target[RENDERER_MAX_THREADS + 1];
+    double total = 0.0;
+    int width = pool->adaptive_width;
+    if (active_workers <= 1 || pool->adaptive_workers != active_workers || width <= 0) return;
+
+    for (int i = 0; i < active_workers; i++) {
+        /* +1 keeps empty strips from reading as free and collapsing to zero width. */
+        total += (double)pool->worker_busy_ticks[i] + 1.0;
+    }
+    if (total <= 0.0) return;
+
+    target[0] = 0;
+    target[active_workers] = width;
+    {
+        int strip = 0;
+        double cum = 0.0;
+        for (int k = 1; k < active_workers; k++) {
+            double want = (total * (double)k) / (double)active_workers;
+            double strip_cost = (double)pool->worker_busy_ticks[strip] + 1.0;
+            while (strip < active_workers - 1 && cum + strip_cost < want) {
+                cum += strip_cost;
+                strip++;
+                strip_cost = (double)pool->worker_busy_ticks[strip] + 1.0;
+            }
+            {
+                int32_t s0 = pool->adaptive_bounds[strip];
+                int32_t s1 = pool->adaptive_bounds[strip + 1];
+                double frac = (want - cum) / strip_cost;
+                if (frac < 0.0) frac = 0.0;
+                if (frac > 1.0) frac = 1.0;
+                target[k] = s0 + (int32_t)(frac * (double)(s1 - s0) + 0.5);
+            }
+        }
+    }
+
+    for (int k = 1; k < active_workers; k++) {
+        int32_t cur = pool->adaptive_bounds[k];
+        int32_t delta = target[k] - cur;
+        if (delta > RENDERER_ADAPTIVE_DEAD_BAND_COLS || delta < -RENDERER_ADAPTIVE_DEAD_BAND_COLS) {
+            pool->adaptive_bounds[k] = cur + delta / 2;
+        }
+    }
+
+    /* Keep every strip at least RENDERER_ADAPTIVE_MIN_STRIP_COLS wide (when width allows). */
+    {
+        int32_t min_cols = RENDERER_ADAPTIVE_MIN_STRIP_COLS;
+        if ((int64_t)min_cols * active_workers > width) min_cols = width / active_workers;
+        for (int k = 1; k < active_workers; k++) {
+            if (pool->adaptive_bounds[k] < pool->adaptive_bounds[k - 1] + min_cols)
+                pool->adaptive_bounds[k] = pool->adaptive_bounds[k - 1] + min_cols;
+        }
+        for (int k = active_workers - 1; k >= 1; k--) {
+            if (pool->adaptive_bounds[k] > pool->adaptive_bounds[k + 1] - min_cols)
+                pool->adaptive_bounds[k] = pool->adaptive_bounds[k + 1] - min_cols;
+        }
+    }
+}
+
 static int renderer_dispatch_threaded_world(GameState *state,
                                             const RendererWorldZonePrepass *zone_prepass,
                                             uint32_t frame_idx,
@@ -2470,10 +3044,18 @@ static int renderer_dispatch_threaded_world(GameState *state,
     int width = g_renderer.width;
     if (width <= 0) return 0;
 
-    int active_workers = renderer_prepare_worker_columns(pool, width, 1);
+    const int use_tiles = (g_renderer_thread_schedule == RENDER_THREAD_SCHEDULE_TILES);
+    const int use_adaptive = (g_renderer_thread_schedule == RENDER_THREAD_SCHEDULE_ADAPTIVE);
+    int active_workers = renderer_prepare_worker_columns(pool, width, use_tiles ? 0 : 1);
     if (active_workers <= 0) {
         return 0;
     }
+    pool->world_tile_count = 0;
+    if (use_tiles) {
+        (void)renderer_prepare_world_tiles(pool, width, active_workers);
+    } else if (use_adaptive) {
+        renderer_apply_adaptive_worker_columns(pool, width, active_workers);
+    }
 
     pool->job_state = state;
     pool->world_zone_prepass = zone_prepass;
@@ -2487,13 +3069,14 @@ static int renderer_dispatch_threaded_world(GameState *state,
     pool->post_dst_cw = NULL;
     pool->active_workers = active_workers;
     SDL_AtomicSet(&pool->pending_workers, active_workers);
+    renderer_thread_pool_apply_wait_policy(pool);
     SDL_AtomicAdd(&pool->job_generation, 1);
     SDL_MemoryBarrierRelease();
-    for (int i = 0; i < active_workers; i++) {
-        SDL_SemPost(pool->worker_sems[i]);
-    }
+    renderer_thread_pool_wake_workers(pool, active_workers);
 
-    SDL_SemWait(pool->done_sem);
+    uint64_t trace_wait = trace_begin();
+    renderer_thread_pool_wait_done(pool);
+    trace_end("world wait", trace_wait);
 
     int8_t fill_screen_water = 0;
     RendererWorkloadStats merged_stats;
@@ -2502,6 +3085,11 @@ static int renderer_dispatch_threaded_world(GameState *state,
         fill_screen_water = merge_fill_screen_water(fill_screen_water, pool->workers[i].fill_screen_water);
         renderer_workload_stats_add(&merged_stats, &pool->worker_world_stats[i]);
     }
+    if (use_tiles) {
+        renderer_update_world_tile_granularity(pool, active_workers);
+    } else if (use_adaptive) {
+        renderer_update_adaptive_strip_bounds(pool, active_workers);
+    }
     g_prof_last_world_workers = active_workers;
 
     if (out_fill_screen_water) *out_fill_screen_water = fill_screen_water;
@@ -2517,7 +3105,7 @@ static int renderer_dispatch_threaded_underwater_tint(int8_t fill_screen_water)
     if (fill_screen_water == 0) return 0;
 
     RendererState *r = &g_renderer;
-    if (!r->rgb_buffer || !r->cw_buffer) return 0;
+    if (!renderer_rgb_target_ok(r->rgb_buffer) || !r->cw_buffer) return 0;
 
     int width = r->width;
     int height = r->height;
@@ -2540,21 +3128,75 @@ static int renderer_dispatch_threaded_underwater_tint(int8_t fill_screen_water)
     pool->post_dst_cw = r->cw_buffer;
     pool->active_workers = active_workers;
     SDL_AtomicSet(&pool->pending_workers, active_workers);
+    renderer_thread_pool_apply_wait_policy(pool);
     SDL_AtomicAdd(&pool->job_generation, 1);
     SDL_MemoryBarrierRelease();
-    for (int i = 0; i < active_workers; i++) {
-        SDL_SemPost(pool->worker_sems[i]);
-    }
+    renderer_thread_pool_wake_workers(pool, active_workers);
 
-    SDL_SemWait(pool->done_sem);
+    renderer_thread_pool_wait_done(pool);
     g_prof_last_tint_workers = active_workers;
 
     return 1;
 }
 
+int renderer_parallel_for(int count, int min_per_worker, RendererIndexFn fn, void *userdata)
+{
+    RendererThreadPool *pool = &g_renderer_thread_pool;
+    int active_workers = 0;
+
+    if (!fn || count <= 0) return 0;
+    if (min_per_worker < 1) min_per_worker = 1;
+    if (pool->initialized && pool->worker_count > 0 && pool->cpu_count > 1) {
+        /* The caller takes a share too, so hand out count/min - 1 workers. */
+        active_workers = count / min_per_worker - 1;
+        if (active_workers > pool->worker_count) active_workers = pool->worker_count;
+    }
+    if (active_workers <= 0) {
+        for (int i = 0; i < count; i++) fn(i, userdata);
+        return 0;
+    }
+
+    for (int i = 0; i < active_workers; i++) {
+        pool->workers[i].col_start = 0;
+        pool->workers[i].col_end = 1;   /* non-empty: the worker runs the job */
+        pool->workers[i].fill_screen_water = 0;
+    }
+    pool->job_state = NULL;
+    pool->world_zone_prepass = NULL;
+    pool->world_tile_count = 0;
+    pool->job_type = RENDERER_THREAD_JOB_INDEXED;
+    pool->index_fn = fn;
+    pool->index_userdata = userdata;
+    pool->index_count = count;
+    SDL_AtomicSet(&pool->index_next, 0);
+    pool->active_workers = active_workers;
+    SDL_AtomicSet(&pool->pending_workers, active_workers);
+    renderer_thread_pool_apply_wait_policy(pool);
+    SDL_AtomicAdd(&pool->job_generation, 1);
+    SDL_MemoryBarrierRelease();
+    renderer_thread_pool_wake_workers(pool, active_workers);
+
+    for (;;) {
+        int i = SDL_AtomicAdd(&pool->index_next, 1);
+        if (i >= count) break;
+        fn(i, userdata);
+    }
+    renderer_thread_pool_wait_done(pool);
+    SDL_MemoryBarrierAcquire();
+    return active_workers;
+}
+
 #else
 static void renderer_threads_shutdown(void) { }
 static void renderer_threads_init(void) { }
+
+int renderer_parallel_for(int count, int min_per_worker, RendererIndexFn fn, void *userdata)
+{
+    (void)min_per_worker;
+    if (!fn) return 0;
+    for (int i = 0; i < count; i++) fn(i, userdata);
+    return 0;
+}
 #endif
 
 /* Water animation / assets (Amiga: watertouse, wtan, wateroff, fillscrnwater). */
@@ -3055,6 +3697,24 @@ typedef struct {
 
 static RendererProfileState g_renderer_profile;
 
+/* Per-frame phase times for callers that record every frame (--benchmark).
+ * Independent of AB3D_PROFILE_RENDER, which only aggregates [RPROF] windows. */
+static int g_renderer_frame_timing_capture = 0;
+static RendererFrameTimings g_renderer_last_frame_timings;
+
+void renderer_set_frame_timing_capture(int enabled)
+{
+    g_renderer_frame_timing_capture = enabled ? 1 : 0;
+    g_renderer_last_frame_timings.valid = 0;
+}
+
+int renderer_get_last_frame_timings(RendererFrameTimings *out)
+{
+    if (!out || !g_renderer_last_frame_timings.valid) return 0;
+    *out = g_renderer_last_frame_timings;
+    return 1;
+}
+
 static int renderer_profile_enabled(void)
 {
     if (!g_renderer_profile.initialized) {
@@ -4332,28 +4992,81 @@ static const uint32_t gun_ptr_frame_offsets[32] = {
 /* -----------------------------------------------------------------------
  * Initialization / Shutdown
  * ----------------------------------------------------------------------- */
-static void free_buffers(void)
+/* Single-plane render target: the 8-bit tag plane and the cw plane are always
+ * present, while the 32-bit ARGB pair (only written when raster expand is on)
+ * and the F2 pick planes are allocated on demand.  At 1080p that keeps ~16 MB
+ * of framebuffers out of every frame's clear/swap and out of the cache. */
+static int g_renderer_alloc_w = 0;
+static int g_renderer_alloc_h = 0;
+
+static void renderer_free_rgb_planes(void)
 {
-    ab3d_aligned_free(g_renderer.buffer);
-    g_renderer.buffer = NULL;
-    ab3d_aligned_free(g_renderer.back_buffer);
-    g_renderer.back_buffer = NULL;
     ab3d_aligned_free(g_renderer.rgb_buffer);
     g_renderer.rgb_buffer = NULL;
     ab3d_aligned_free(g_renderer.rgb_back_buffer);
     g_renderer.rgb_back_buffer = NULL;
-    ab3d_aligned_free(g_renderer.cw_buffer);
-    g_renderer.cw_buffer = NULL;
-    ab3d_aligned_free(g_renderer.cw_back_buffer);
-    g_renderer.cw_back_buffer = NULL;
-    ab3d_aligned_free(g_pick_zone_buffer);
-    g_pick_zone_buffer = NULL;
-    ab3d_aligned_free(g_pick_zone_back_buffer);
-    g_pick_zone_back_buffer = NULL;
-    ab3d_aligned_free(g_pick_player_buffer);
-    g_pick_player_buffer = NULL;
-    ab3d_aligned_free(g_pick_player_back_buffer);
-    g_pick_player_back_buffer = NULL;
+}
+
+static int renderer_alloc_rgb_planes(void)
+{
+    size_t rgb_size = (size_t)g_renderer_alloc_w * (size_t)g_renderer_alloc_h * sizeof(uint32_t);
+    if (g_renderer.rgb_buffer && g_renderer.rgb_back_buffer) return 1;
+    if (rgb_size == 0) return 0;
+    renderer_free_rgb_planes();
+    g_renderer.rgb_buffer = (uint32_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, rgb_size);
+    g_renderer.rgb_back_buffer = (uint32_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, rgb_size);
+    if (!g_renderer.rgb_buffer || !g_renderer.rgb_back_buffer) {
+        renderer_free_rgb_planes();
+        return 0;
+    }
+    return 1;
+}
+
+static void renderer_free_pick_planes(void)
+{
+    ab3d_aligned_free(g_pick_zone_buffer);
+    g_pick_zone_buffer = NULL;
+    ab3d_aligned_free(g_pick_zone_back_buffer);
+    g_pick_zone_back_buffer = NULL;
+    ab3d_aligned_free(g_pick_player_buffer);
+    g_pick_player_buffer = NULL;
+    ab3d_aligned_free(g_pick_player_back_buffer);
+    g_pick_player_back_buffer = NULL;
+}
+
+static int renderer_alloc_pick_planes(void)
+{
+    size_t count = (size_t)g_renderer_alloc_w * (size_t)g_renderer_alloc_h;
+    if (g_pick_zone_buffer && g_pick_zone_back_buffer &&
+        g_pick_player_buffer && g_pick_player_back_buffer) return 1;
+    if (count == 0) return 0;
+    renderer_free_pick_planes();
+    g_pick_zone_buffer = (uint16_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, count, sizeof(uint16_t));
+    g_pick_zone_back_buffer = (uint16_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, count, sizeof(uint16_t));
+    g_pick_player_buffer = (uint8_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, count, 1);
+    g_pick_player_back_buffer = (uint8_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, count, 1);
+    if (!g_pick_zone_buffer || !g_pick_zone_back_buffer ||
+        !g_pick_player_buffer || !g_pick_player_back_buffer) {
+        renderer_free_pick_planes();
+        return 0;
+    }
+    memset(g_pick_zone_buffer, 0xFF, count * sizeof(uint16_t));
+    memset(g_pick_zone_back_buffer, 0xFF, count * sizeof(uint16_t));
+    return 1;
+}
+
+static void free_buffers(void)
+{
+    ab3d_aligned_free(g_renderer.buffer);
+    g_renderer.buffer = NULL;
+    ab3d_aligned_free(g_renderer.back_buffer);
+    g_renderer.back_buffer = NULL;
+    renderer_free_rgb_planes();
+    ab3d_aligned_free(g_renderer.cw_buffer);
+    g_renderer.cw_buffer = NULL;
+    ab3d_aligned_free(g_renderer.cw_back_buffer);
+    g_renderer.cw_back_buffer = NULL;
+    renderer_free_pick_planes();
     ab3d_aligned_free(g_renderer.clip.top);
     g_renderer.clip.top = NULL;
     ab3d_aligned_free(g_renderer.clip.bot);
@@ -4366,10 +5079,22 @@ static void free_buffers(void)
     g_renderer.clip.bot2 = NULL;
     ab3d_aligned_free(g_renderer.clip.z2);
     g_renderer.clip.z2 = NULL;
+    free(g_renderer.clip.tile_top);
+    g_renderer.clip.tile_top = NULL;
+    free(g_renderer.clip.tile_bot);
+    g_renderer.clip.tile_bot = NULL;
+    free(g_renderer.clip.tile_zmax);
+    g_renderer.clip.tile_zmax = NULL;
+    free(g_renderer.clip.tile_zmin);
+    g_renderer.clip.tile_zmin = NULL;
+    free(g_renderer.clip.tile_dirty);
+    g_renderer.clip.tile_dirty = NULL;
 }
 
 static void allocate_buffers(int w, int h)
 {
+    g_renderer_alloc_w = w;
+    g_renderer_alloc_h = h;
     g_renderer.width = w;
     g_renderer.height = h;
     g_renderer.present_width = w;
@@ -4379,20 +5104,14 @@ static void allocate_buffers(int w, int h)
     g_renderer.buffer = (uint8_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, buf_size, 1);
     g_renderer.back_buffer = (uint8_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, buf_size, 1);
 
-    size_t rgb_size = buf_size * sizeof(uint32_t);
-    g_renderer.rgb_buffer = (uint32_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, rgb_size);
-    g_renderer.rgb_back_buffer = (uint32_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, rgb_size);
-
     size_t cw_size = buf_size * sizeof(uint16_t);
     g_renderer.cw_buffer = (uint16_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, cw_size);
     g_renderer.cw_back_buffer = (uint16_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, cw_size);
 
-    g_pick_zone_buffer = (uint16_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, cw_size);
-    g_pick_zone_back_buffer = (uint16_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, cw_size);
-    g_pick_player_buffer = (uint8_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, buf_size);
-    g_pick_player_back_buffer = (uint8_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, buf_size);
-    if (g_pick_zone_buffer) memset(g_pick_zone_buffer, 0xFF, cw_size);
-    if (g_pick_zone_back_buffer) memset(g_pick_zone_back_buffer, 0xFF, cw_size);
+    if (g_renderer_rgb_raster_expand && !renderer_alloc_rgb_planes()) {
+        printf("[RENDERER] Warning: ARGB planes unavailable, falling back to single-plane mode\n");
+        g_renderer_rgb_raster_expand = 0;
+    }
 
     size_t clip_size = (size_t)w * sizeof(int16_t);
     g_renderer.clip.top = (int16_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, clip_size);
@@ -4401,6 +5120,15 @@ static void allocate_buffers(int w, int h)
     g_renderer.clip.top2 = (int16_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, clip_size);
     g_renderer.clip.bot2 = (int16_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, 1, clip_size);
     g_renderer.clip.z2 = (int32_t *)ab3d_aligned_calloc(AB3D_CACHE_LINE_SIZE, (size_t)w, sizeof(int32_t));
+    {
+        size_t tiles = ((size_t)w + RENDERER_CLIP_TILE_W - 1) >> RENDERER_CLIP_TILE_SHIFT;
+        g_renderer.clip.tile_top = (int16_t *)calloc(tiles, sizeof(int16_t));
+        g_renderer.clip.tile_bot = (int16_t *)calloc(tiles, sizeof(int16_t));
+        g_renderer.clip.tile_zmax = (int32_t *)calloc(tiles, sizeof(int32_t));
+        g_renderer.clip.tile_zmin = (int32_t *)calloc(tiles, sizeof(int32_t));
+        g_renderer.clip.tile_dirty = (uint8_t *)malloc(tiles);
+        if (g_renderer.clip.tile_dirty) memset(g_renderer.clip.tile_dirty, 1, tiles);
+    }
 
     g_renderer.top_clip = 0;
     g_renderer.bot_clip = (int16_t)(h - 1);
@@ -4409,18 +5137,25 @@ static void allocate_buffers(int w, int h)
     g_renderer.left_clip = 0;
     g_renderer.right_clip = (int16_t)w;
 
+    /* Fill the row reciprocals for the whole allocation now, so dynamic-resolution
+     * view sizes up to it never extend the table mid-frame. */
+    renderer_floor_prepare_row_recip_table(h);
+
     /* Safe defaults before first renderer_draw_display sets y_proj_scale-based caps. */
     g_renderer.floor_uv_dist_max = 30000;
     g_renderer.floor_uv_dist_near = 32000;
 
-    /* Pre-size main-thread scratch to current render dimensions so normal frame
-     * rendering does not need first-use allocations. Worker-thread scratch is
-     * still grown lazily on each worker thread. */
+    /* Pre-size the main-thread frame arena to current render dimensions so
+     * normal frame rendering does not need first-use allocations: carve every
+     * table once, then reset so the arena regrows to that high-water mark.
+     * Worker arenas size themselves the same way on their first world job. */
+    g_renderer_frame_arena_owner = 1;
     (void)renderer_poly_edge_ensure_h(h);
     (void)renderer_poly_col_ensure_w(w);
     (void)renderer_viewer_floor_occlude_get_scratch(w);
     (void)renderer_floor_fast_ensure_rows_capacity(h);
     (void)renderer_floor_fast_ensure_cols_capacity(w);
+    renderer_frame_arena_begin(-1);
 }
 
 void renderer_init(void)
@@ -4436,6 +5171,7 @@ void renderer_init(void)
         printf("[RENDERER] Warning: automap mutex unavailable (possible data races with threaded draw)\n");
     }
     renderer_threads_init();
+    renderer_raster_simd_detect();
     printf("[RENDERER] Initialized: %dx%d\n", g_renderer.width, g_renderer.height);
 }
 
@@ -4449,12 +5185,35 @@ void renderer_resize(int w, int h)
     allocate_buffers(w, h);
 }
 
+int renderer_set_view_size(int w, int h)
+{
+    if (w < 96) w = 96;
+    if (h < 80) h = 80;
+    if (w > g_renderer_alloc_w || h > g_renderer_alloc_h) return 0;
+    if (w == g_renderer.width && h == g_renderer.height) return 1;
+    g_renderer.width = w;
+    g_renderer.height = h;
+    g_renderer.top_clip = 0;
+    g_renderer.bot_clip = (int16_t)(h - 1);
+    g_renderer.left_clip = 0;
+    g_renderer.right_clip = (int16_t)w;
+    if (g_renderer.clip.tile_dirty)
+        memset(g_renderer.clip.tile_dirty, 1, ((size_t)w + RENDERER_CLIP_TILE_W - 1) >> RENDERER_CLIP_TILE_SHIFT);
+    return 1;
+}
+
+void renderer_release_thread_scratch(void)
+{
+    renderer_frame_arena_release();
+}
+
 void renderer_shutdown(void)
 {
     renderer_threads_shutdown();
     renderer_reset_level_sky_cache_internal();
-    renderer_floor_fast_release_scratch();
-    renderer_zone_trace_floor_stats_release_scratch();
+    sky_pan_cache_release();
+    renderer_release_texture_mips();
+    renderer_frame_arena_release();
     automap_stage_release();
     automap_door_lookup_release();
     automap_key_mask_cache_reset();
@@ -4638,9 +5397,322 @@ static inline uint32_t sky_bilinear_argb(uint32_t c00, uint32_t c10, uint32_t c0
     return RENDER_RGB_RASTER_PIXEL((r << 16) | (g << 8) | b);
 }
 
+/* Width-dependent sky column count (how many of the 432 pan columns span the
+ * screen for the current projection); cached per width. */
+static int sky_view_cols_for_width(int w)
+{
+    if (w == s_cached_sky_view_cols_w) return s_cached_sky_view_cols;
+    int center_x = (w * 47) / 96;
+    int left_px = center_x;
+    int right_px = (w - 1) - center_x;
+    const double focal_px = (double)(64 * renderer_proj_x_scale_px());
+    const double hfov =
+        atan((double)left_px / focal_px) +
+        atan((double)right_px / focal_px);
+    double sky_cols_f = ((double)SKY_PAN_WIDTH * hfov) / (2.0 * 3.14159265358979323846);
+    int sky_view_cols = (int)(sky_cols_f + 0.5);
+    if (sky_view_cols < 1) sky_view_cols = 1;
+    if (sky_view_cols > SKY_PAN_WIDTH) sky_view_cols = SKY_PAN_WIDTH;
+    s_cached_sky_view_cols = sky_view_cols;
+    s_cached_sky_view_cols_w = w;
+    return sky_view_cols;
+}
+
+/* -----------------------------------------------------------------------
+ * Panoramic sky cache
+ *
+ * The backfile resampled once to screen resolution: one strip per texel row,
+ * one entry per screen column of pan (step = sky_view_cols / width), covering
+ * the full 432-column wrap. Sky spans then become contiguous copies starting
+ * at the panorama column for the frame's angle; bilinear filtering reduces to
+ * a vertical blend of two prefiltered strips. Rebuilt on the main thread
+ * (renderer_draw_frame) when the assets or the allocated render width change;
+ * workers only read it. The panorama is built for the allocated width, so a
+ * narrower view (dynamic resolution) reuses it and steps through it at
+ * view_stride_fp panorama columns per screen column instead of rebuilding.
+ * Texture pan is quantized to whole panorama columns, which is finer than the
+ * 432-column backfile at any supported width.
+ * ----------------------------------------------------------------------- */
+#define SKY_PAN_CACHE_MAX_TEXELS (1u << 24)
+
+typedef struct {
+    uint32_t *argb;      /* rows x cols, nearest texel */
+    uint16_t *cw;        /* rows x cols, nearest texel */
+#if SKY_BILINEAR_FILTER
+    uint32_t *argb_filt; /* rows x cols, horizontally interpolated */
+#endif
+    int       cols;
+    int       rows;
+    int32_t   step_fp;   /* pan (16.16 backfile columns) per panorama column */
+    int       width;     /* width the panorama was built for */
+    int       view_w;    /* width of the frame being drawn (sky_pan_cache_sync) */
+    int32_t   view_stride_fp; /* 16.16 panorama columns per view column; 1.0 at full width */
+    uint32_t  gen;
+    int       valid;
+} SkyPanCache;
+
+static SkyPanCache s_sky_pan;
+static uint32_t s_sky_assets_gen = 1;
+static int s_sky_pan_state = -1;
+
+static int sky_pan_cache_enabled(void)
+{
+    return settings_env_feature_enabled(&s_sky_pan_state, "AB3D_DISABLE_SKY_CACHE");
+}
+
+static void sky_pan_cache_release(void)
+{
+    free(s_sky_pan.argb);
+    free(s_sky_pan.cw);
+#if SKY_BILINEAR_FILTER
+    free(s_sky_pan.argb_filt);
+#endif
+    memset(&s_sky_pan, 0, sizeof(s_sky_pan));
+}
+
+static void sky_pan_cache_build(int w, int32_t step_fp)
+{
+    const int32_t period_fp = SKY_PAN_WIDTH << 16;
+    const int th = s_sky_tex_h;
+    const int tw = s_sky_tex_w;
+    const int32_t tw_scale_fp = ((int32_t)tw << 16) / SKY_PAN_WIDTH;
+    int cols = (int)(((int64_t)period_fp + step_fp - 1) / step_fp);
+    size_t n = (size_t)cols * (size_t)th;
+
+    sky_pan_cache_release();
+    s_sky_pan.width = w;
+    s_sky_pan.step_fp = step_fp;
+    s_sky_pan.gen = s_sky_assets_gen;
+    if (n == 0 || n > SKY_PAN_CACHE_MAX_TEXELS) return;
+
+    s_sky_pan.argb = (uint32_t *)malloc(n * sizeof(uint32_t));
+    s_sky_pan.cw = (uint16_t *)malloc(n * sizeof(uint16_t));
+#if SKY_BILINEAR_FILTER
+    s_sky_pan.argb_filt = (uint32_t *)malloc(n * sizeof(uint32_t));
+    if (!s_sky_pan.argb_filt) {
+        sky_pan_cache_release();
+        return;
+    }
+#endif
+    if (!s_sky_pan.argb || !s_sky_pan.cw) {
+        sky_pan_cache_release();
+        return;
+    }
+
+    for (int k = 0; k < cols; k++) {
+        int32_t pan_fp = (int32_t)(((int64_t)k * step_fp) % period_fp);
+        int c = (int)(((int64_t)(pan_fp >> 16) * (int64_t)tw_scale_fp) >> 16);
+        if (c >= tw) c = tw - 1;
+#if SKY_BILINEAR_FILTER
+        int32_t tx_fp = (int32_t)(((int64_t)pan_fp * (int64_t)tw_scale_fp) >> 16);
+        int tx0 = (int)(tx_fp >> 16);
+        uint32_t fx = (uint32_t)(tx_fp & 0xFFFF);
+        if (tx0 >= tw) tx0 = tw - 1;
+        int tx1 = (tx0 + 1 < tw) ? tx0 + 1 : 0;
+#endif
+        for (int v = 0; v < th; v++) {
+            size_t i = (size_t)v * (size_t)cols + (size_t)k;
+            if (s_sky_mode == 0) {
+                uint16_t cw12 = sky_fetch_cw_mode0(c, v);
+                s_sky_pan.cw[i] = cw12;
+                s_sky_pan.argb[i] = amiga12_to_argb(cw12);
+#if SKY_BILINEAR_FILTER
+                uint32_t c0 = amiga12_to_argb(sky_fetch_cw_mode0(tx0, v));
+                uint32_t c1 = amiga12_to_argb(sky_fetch_cw_mode0(tx1, v));
+                s_sky_pan.argb_filt[i] = sky_bilinear_argb(c0, c1, c0, c1, fx, 0);
+#endif
+            } else {
+                uint8_t idx = s_sky_pixels[(size_t)v * (size_t)tw + (size_t)c];
+                s_sky_pan.cw[i] = s_sky_cw[idx];
+                s_sky_pan.argb[i] = s_sky_argb[idx];
+#if SKY_BILINEAR_FILTER
+                uint32_t c0 = sky_fetch_argb_mode1(tx0, v);
+                uint32_t c1 = sky_fetch_argb_mode1(tx1, v);
+                s_sky_pan.argb_filt[i] = sky_bilinear_argb(c0, c1, c0, c1, fx, 0);
+#endif
+            }
+        }
+    }
+    s_sky_pan.cols = cols;
+    s_sky_pan.rows = th;
+    s_sky_pan.valid = 1;
+    printf("[RENDERER] Sky panorama cache: %d x %d (width %d)\n", cols, th, w);
+}
+
+static int32_t sky_pan_step_for_width(int w)
+{
+    int32_t step_fp = (int32_t)(((int64_t)sky_view_cols_for_width(w) << 16) / (int64_t)w);
+    return step_fp < 1 ? 1 : step_fp;
+}
+
+/* Main thread, before the world pass: make the cache match the allocated width and assets,
+ * and set the stride for view width w. */
+static void sky_pan_cache_sync(int w)
+{
+    if (!sky_pan_cache_enabled() || w < 1 || !s_sky_pixels ||
+        (s_sky_mode != 0 && s_sky_mode != 1)) {
+        s_sky_pan.valid = 0;
+        return;
+    }
+    int build_w = (g_renderer_alloc_w > w) ? g_renderer_alloc_w : w;
+    int32_t step_fp = sky_pan_step_for_width(build_w);
+    if (s_sky_pan.gen != s_sky_assets_gen || s_sky_pan.width != build_w || s_sky_pan.step_fp != step_fp)
+        sky_pan_cache_build(build_w, step_fp);
+    s_sky_pan.view_w = w;
+    s_sky_pan.view_stride_fp = (w == build_w) ? 0x10000
+        : (int32_t)(((int64_t)sky_pan_step_for_width(w) << 16) / (int64_t)step_fp);
+}
+
+/* Cache usable for this frame's width: returns the panorama column of screen x = 0. */
+static inline int sky_pan_cache_origin(int w, int16_t angpos)
+{
+    if (!s_sky_pan.valid || s_sky_pan.view_w != w || s_sky_pan.gen != s_sky_assets_gen) return -1;
+    int32_t u0_fp = (int32_t)(((int64_t)(angpos & 8191) * ((int64_t)SKY_PAN_WIDTH << 16)) / 8192);
+    int k0 = (int)((u0_fp + s_sky_pan.step_fp / 2) / s_sky_pan.step_fp);
+    return k0 % s_sky_pan.cols;
+}
+
+/* Store one contiguous run of cached sky into the frame buffers. */
+static inline void sky_pan_store_run(uint8_t *buf, uint32_t *rgb, uint16_t *cw,
+                                     int w, int h, int x, int y, int n,
+                                     const uint32_t *src_argb, const uint16_t *src_cw)
+{
+    size_t p = (size_t)y * (size_t)w + (size_t)x;
+    memset(buf + p, 0, (size_t)n);
+    if (g_renderer_rgb_raster_expand)
+        memcpy(rgb + p, src_argb, (size_t)n * sizeof(uint32_t));
+#if AB3D_CW_COL_MAJOR
+    for (int i = 0; i < n; i++)
+        renderer_cw_store_xy(cw, x + i, y, w, h, src_cw[i]);
+#else
+    (void)h;
+    memcpy(cw + p, src_cw, (size_t)n * sizeof(uint16_t));
+#endif
+}
+
+/* Panorama column of view column x when the view is narrower than the panorama. */
+static inline int sky_pan_strided_col(int k0, int x)
+{
+    int k = k0 + (int)(((int64_t)x * s_sky_pan.view_stride_fp) >> 16);
+    while (k >= s_sky_pan.cols) k -= s_sky_pan.cols;
+    return k;
+}
+
+/* Nearest-neighbour sky for screen row y, columns [xl, xr], texel row v. */
+static void sky_pan_draw_row_nearest(uint8_t *buf, uint32_t *rgb, uint16_t *cw,
+                                     int w, int h, int y, int xl, int xr, int v, int k0)
+{
+    const int cols = s_sky_pan.cols;
+    const uint32_t *row_argb = s_sky_pan.argb + (size_t)v * (size_t)cols;
+    const uint16_t *row_cw = s_sky_pan.cw + (size_t)v * (size_t)cols;
+    if (s_sky_pan.view_stride_fp != 0x10000) {
+        uint32_t tmp_argb[256];
+        uint16_t tmp_cw[256];
+        for (int x = xl; x <= xr;) {
+            int n = xr - x + 1;
+            if (n > 256) n = 256;
+            for (int i = 0; i < n; i++) {
+                int k = sky_pan_strided_col(k0, x + i);
+                tmp_argb[i] = row_argb[k];
+                tmp_cw[i] = row_cw[k];
+            }
+            sky_pan_store_run(buf, rgb, cw, w, h, x, y, n, tmp_argb, tmp_cw);
+            x += n;
+        }
+        return;
+    }
+    int k = (k0 + xl) % cols;
+    for (int x = xl; x <= xr;) {
+        int n = xr - x + 1;
+        if (n > cols - k) n = cols - k;
+        sky_pan_store_run(buf, rgb, cw, w, h, x, y, n, row_argb + k, row_cw + k);
+        x += n;
+        k = 0;
+    }
+}
+
+#if SKY_BILINEAR_FILTER
+/* dst = a + (b - a) * f8 / 256 per 8-bit channel (f8 in 0..256). */
+static void sky_pan_blend_span(uint32_t *dst, const uint32_t *a, const uint32_t *b, int n, uint32_t f8)
+{
+    int i = 0;
+#if AB3D_HAVE_SSE2
+    const __m128i z = _mm_setzero_si128();
+    const __m128i wa = _mm_set1_epi16((short)(256u - f8));
+    const __m128i wb = _mm_set1_epi16((short)f8);
+    const __m128i rnd = _mm_set1_epi16(128);
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + i));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(va, z), wa),
+                                   _mm_mullo_epi16(_mm_unpacklo_epi8(vb, z), wb));
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(va, z), wa),
+                                   _mm_mullo_epi16(_mm_unpackhi_epi8(vb, z), wb));
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, rnd), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, rnd), 8);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    /* Two channels per multiply; each 16-bit lane holds at most 255 * 256 + 128. */
+    const uint32_t fa = 256u - f8;
+    for (; i < n; i++) {
+        uint32_t ca = a[i], cb = b[i];
+        uint32_t rb = ((ca & 0x00FF00FFu) * fa + (cb & 0x00FF00FFu) * f8 + 0x00800080u) >> 8;
+        uint32_t ag = ((ca >> 8) & 0x00FF00FFu) * fa + ((cb >> 8) & 0x00FF00FFu) * f8 + 0x00800080u;
+        dst[i] = (rb & 0x00FF00FFu) | (ag & 0xFF00FF00u);
+    }
+}
+
+/* Bilinear sky for screen row y: blend texel rows v0/v1 of the prefiltered strips. */
+static void sky_pan_draw_row_bilinear(uint8_t *buf, uint32_t *rgb, uint16_t *cw,
+                                      int w, int h, int y, int xl, int xr,
+                                      int v0, int v1, uint32_t fy, int k0)
+{
+    const int cols = s_sky_pan.cols;
+    const uint32_t *ra = s_sky_pan.argb_filt + (size_t)v0 * (size_t)cols;
+    const uint32_t *rb = s_sky_pan.argb_filt + (size_t)v1 * (size_t)cols;
+    uint32_t f8 = (fy + 128u) >> 8;
+    uint32_t tmp_argb[256];
+    uint16_t tmp_cw[256];
+    if (s_sky_pan.view_stride_fp != 0x10000) {
+        uint32_t tmp_a[256];
+        uint32_t tmp_b[256];
+        for (int x = xl; x <= xr;) {
+            int n = xr - x + 1;
+            if (n > 256) n = 256;
+            for (int i = 0; i < n; i++) {
+                int k = sky_pan_strided_col(k0, x + i);
+                tmp_a[i] = ra[k];
+                tmp_b[i] = rb[k];
+            }
+            sky_pan_blend_span(tmp_argb, tmp_a, tmp_b, n, f8);
+            for (int i = 0; i < n; i++)
+                tmp_cw[i] = argb_to_amiga12(tmp_argb[i]);
+            sky_pan_store_run(buf, rgb, cw, w, h, x, y, n, tmp_argb, tmp_cw);
+            x += n;
+        }
+        return;
+    }
+    int k = (k0 + xl) % cols;
+    for (int x = xl; x <= xr;) {
+        int n = xr - x + 1;
+        if (n > cols - k) n = cols - k;
+        if (n > 256) n = 256;
+        sky_pan_blend_span(tmp_argb, ra + k, rb + k, n, f8);
+        for (int i = 0; i < n; i++)
+            tmp_cw[i] = argb_to_amiga12(tmp_argb[i]);
+        sky_pan_store_run(buf, rgb, cw, w, h, x, y, n, tmp_argb, tmp_cw);
+        x += n;
+        k += n;
+        if (k >= cols) k = 0;
+    }
+}
+#endif
+
 void renderer_set_sky_assets(const uint8_t *chunky_pixels, int tex_w, int tex_h, size_t data_bytes,
                               const uint8_t *rgb_palette_768)
 {
+    s_sky_assets_gen++;
     s_sky_pixels = chunky_pixels;
     s_sky_tex_w = tex_w > 0 ? tex_w : 1;
     s_sky_tex_h = tex_h > 0 ? tex_h : 1;
@@ -4709,7 +5781,7 @@ static void renderer_draw_sky_pass_rows(int16_t angpos, int16_t row_start, int16
     uint8_t *buf = renderer_active_buf();
     uint32_t *rgb = renderer_active_rgb();
     uint16_t *cw = renderer_active_cw();
-    if (!buf || !rgb || !cw) return;
+    if (!buf || !renderer_rgb_target_ok(rgb) || !cw) return;
     int w = g_renderer.width;
     int h = g_renderer.height;
     if (w < 1 || h < 1) return;
@@ -4763,26 +5835,29 @@ static void renderer_draw_sky_pass_rows(int16_t angpos, int16_t row_start, int16
     /* Sky + below-band clear: each threaded worker fills only its column strip. */
     int sky_h = h;
     /* Match sky horizontal span to the renderer's actual projection FOV (cached: same for all strips). */
-    int sky_view_cols;
-    if (w != s_cached_sky_view_cols_w) {
-        int center_x = (w * 47) / 96;
-        int left_px = center_x;
-        int right_px = (w - 1) - center_x;
-        const double focal_px = (double)(64 * renderer_proj_x_scale_px());
-        const double hfov =
-            atan((double)left_px / focal_px) +
-            atan((double)right_px / focal_px);
-        double sky_cols_f = ((double)SKY_PAN_WIDTH * hfov) / (2.0 * 3.14159265358979323846);
-        sky_view_cols = (int)(sky_cols_f + 0.5);
-        if (sky_view_cols < 1) sky_view_cols = 1;
-        if (sky_view_cols > SKY_PAN_WIDTH) sky_view_cols = SKY_PAN_WIDTH;
-        s_cached_sky_view_cols = sky_view_cols;
-        s_cached_sky_view_cols_w = w;
-    } else {
-        sky_view_cols = s_cached_sky_view_cols;
-    }
+    int sky_view_cols = sky_view_cols_for_width(w);
+    int pan_k0 = sky_pan_cache_origin(w, angpos);
 
-    if (s_sky_pixels && s_sky_mode == 0) {
+    if (pan_k0 >= 0) {
+        int th = s_sky_pan.rows;
+        const int64_t v_den = (int64_t)(sky_h > 1 ? sky_h - 1 : 1);
+        for (int y = y0; y < y1 && y < sky_h; y++) {
+#if SKY_BILINEAR_FILTER
+            if (th > 1 && s_sky_tex_w > 1 && w > 1 && sky_h > 1) {
+                int64_t v_fp = (((int64_t)y * (th - 1)) << 16) / v_den;
+                int v0 = (int)(v_fp >> 16);
+                int v1 = (v0 < th - 1) ? (v0 + 1) : v0;
+                sky_pan_draw_row_bilinear(buf, rgb, cw, w, h, y, x0, x1 - 1,
+                                          v0, v1, (uint32_t)(v_fp & 0xFFFF), pan_k0);
+                continue;
+            }
+#endif
+            int v = (int)((int64_t)y * (th - 1) / v_den);
+            if (v < 0) v = 0;
+            if (v >= th) v = th - 1;
+            sky_pan_draw_row_nearest(buf, rgb, cw, w, h, y, x0, x1 - 1, v, pan_k0);
+        }
+    } else if (s_sky_pixels && s_sky_mode == 0) {
         int th = s_sky_tex_h;
         int tw = s_sky_tex_w;
         const int32_t tw_scale_fp = ((int32_t)tw << 16) / SKY_PAN_WIDTH;
@@ -4983,6 +6058,7 @@ static void renderer_draw_sky_pass_rows(int16_t angpos, int16_t row_start, int16
 
 void renderer_draw_sky_pass(int16_t angpos)
 {
+    sky_pan_cache_sync(g_renderer.width);
     renderer_draw_sky_pass_rows(angpos, 0, (int16_t)g_renderer.height,
                                 0, (int16_t)g_renderer.width);
 }
@@ -5283,15 +6359,21 @@ static AB3D_ATTR_UNUSED inline void draw_vline(uint8_t *buf, int x, int y_top, i
  *   rotated.z = dx * sin + dz * cos  (depth)
  *   on_screen.x = rotated.x / rotated.z  (perspective divide)
  * ----------------------------------------------------------------------- */
-static void rotate_one_point(RendererState *r, const uint8_t *pts, int idx)
+static void rotate_one_point(RendererState *r, const LevelState *level, int idx)
 {
     int16_t sin_v = r->sinval;
     int16_t cos_v = r->cosval;
     int16_t cam_x = r->xoff;
     int16_t cam_z = r->zoff;
 
-    int16_t px = rd16(pts + idx * 4);
-    int16_t pz = rd16(pts + idx * 4 + 2);
+    int16_t px, pz;
+    if (level->decoded && idx < level->decoded->num_points) {
+        px = level->decoded->point_x[idx];
+        pz = level->decoded->point_z[idx];
+    } else {
+        px = rd16(level->points + idx * 4);
+        pz = rd16(level->points + idx * 4 + 2);
+    }
 
     int16_t dx = (int16_t)(px - cam_x);
     int16_t dz = (int16_t)(pz - cam_z);
@@ -5343,7 +6425,7 @@ static int renderer_ensure_level_point_rotated(GameState *state, int16_t idx)
     if (!state || !state->level.points) return 0;
     if (idx < 0 || idx >= MAX_POINTS) return 0;
     if (r->rotate_stamp != 0 && r->rotated_stamp[idx] == r->rotate_stamp) return 1;
-    rotate_one_point(r, state->level.points, idx);
+    rotate_one_point(r, &state->level, idx);
     return 1;
 }
 
@@ -5363,7 +6445,6 @@ void renderer_rotate_level_pts(GameState *state)
     RendererState *r = &g_renderer;
 
     if (!state->level.points) return;
-    const uint8_t *pts = state->level.points;
     renderer_begin_rotate_frame(r);
 
     /* Get the PointsToRotatePtr from the current player's zone data.
@@ -5385,7 +6466,7 @@ void renderer_rotate_level_pts(GameState *state)
             pt_list += 2;
 
             if (idx < MAX_POINTS) {
-                rotate_one_point(r, pts, idx);
+                rotate_one_point(r, &state->level, idx);
             }
         }
     } else {
@@ -5395,7 +6476,7 @@ void renderer_rotate_level_pts(GameState *state)
         if (num_pts > MAX_POINTS) num_pts = MAX_POINTS;
 
         for (int i = 0; i < num_pts; i++) {
-            rotate_one_point(r, pts, i);
+            rotate_one_point(r, &state->level, i);
         }
     }
 }
@@ -5541,6 +6622,7 @@ write_back:
     clip->top2[col] = tops[1];
     clip->bot2[col] = bots[1];
     clip->z2[col] = zs[1];
+    if (clip->tile_dirty) clip->tile_dirty[col >> RENDERER_CLIP_TILE_SHIFT] = 1;
 }
 
 int32_t renderer_column_clip_nearest_z_at(int col, int row)
@@ -5568,6 +6650,30 @@ int32_t renderer_column_clip_nearest_z_at(int col, int row)
     return nearest_z;
 }
 
+int renderer_column_clip_row_nearest_z(int row, int x0, int x1, int32_t *out_z)
+{
+    const ColumnClip *clip = &g_renderer.clip;
+    int any = 0;
+    if (row < 0 || row >= g_renderer.height) return 0;
+    if (x0 < 0 || x1 >= g_renderer.width || x0 > x1) return 0;
+    if (!clip->top || !clip->bot || !clip->z ||
+        !clip->top2 || !clip->bot2 || !clip->z2) {
+        return 0;
+    }
+
+    for (int c = x0; c <= x1; c++) {
+        int32_t z = 0;
+        if (clip->z[c] > 0 && row >= clip->top[c] && row <= clip->bot[c]) z = clip->z[c];
+        if (clip->z2[c] > 0 && row >= clip->top2[c] && row <= clip->bot2[c] &&
+            (z <= 0 || clip->z2[c] < z)) {
+            z = clip->z2[c];
+        }
+        out_z[c - x0] = z;
+        any |= (z > 0);
+    }
+    return any;
+}
+
 /* Nearest wall Z in a column that overlaps [top, bot]. Used to decide whether
  * boundary extension pixels (x+/-1) have matching real wall geometry nearby. */
 static int32_t renderer_column_clip_nearest_z_overlap(const ColumnClip *clip, int col, int top, int bot)
@@ -5601,6 +6707,124 @@ static int32_t renderer_column_clip_nearest_z_overlap(const ColumnClip *clip, in
     return nearest_z;
 }
 
+/* Rows one column is certainly covered over, as a single interval: the two
+ * spans merged when they touch, else the taller one. zmax is the farthest
+ * depth inside that interval; zmin the nearest span depth in the column. */
+static void renderer_column_clip_column_cover(const ColumnClip *clip, int col,
+                                              int *top, int *bot,
+                                              int32_t *zmax, int32_t *zmin)
+{
+    int v0 = (clip->z[col] > 0 && clip->top[col] <= clip->bot[col]);
+    int v1 = (clip->z2[col] > 0 && clip->top2[col] <= clip->bot2[col]);
+    int t0 = clip->top[col], b0 = clip->bot[col];
+    int t1 = clip->top2[col], b1 = clip->bot2[col];
+
+    *zmin = INT32_MAX;
+    if (v0) *zmin = clip->z[col];
+    if (v1 && clip->z2[col] < *zmin) *zmin = clip->z2[col];
+
+    if (v0 && v1 && !(b1 < t0 - 1 || t1 > b0 + 1)) {
+        *top = (t0 < t1) ? t0 : t1;
+        *bot = (b0 > b1) ? b0 : b1;
+        *zmax = (clip->z[col] > clip->z2[col]) ? clip->z[col] : clip->z2[col];
+    } else if (v0 && (!v1 || b0 - t0 >= b1 - t1)) {
+        *top = t0;
+        *bot = b0;
+        *zmax = clip->z[col];
+    } else if (v1) {
+        *top = t1;
+        *bot = b1;
+        *zmax = clip->z2[col];
+    } else {
+        *top = 1;
+        *bot = 0;
+        *zmax = 0;
+    }
+}
+
+static void renderer_column_clip_tile_refresh(ColumnClip *clip, int tile)
+{
+    int c0 = tile << RENDERER_CLIP_TILE_SHIFT;
+    int c1 = c0 + RENDERER_CLIP_TILE_W;
+    int top = INT16_MIN, bot = INT16_MAX;
+    int32_t zmax = 0, zmin = INT32_MAX;
+
+    if (c1 > g_renderer.width) c1 = g_renderer.width;
+    /* Clear first: a span added while summarizing re-marks the tile. */
+    clip->tile_dirty[tile] = 0;
+    for (int c = c0; c < c1; c++) {
+        int ct, cb;
+        int32_t czmax, czmin;
+        renderer_column_clip_column_cover(clip, c, &ct, &cb, &czmax, &czmin);
+        if (ct > top) top = ct;
+        if (cb < bot) bot = cb;
+        if (czmax > zmax) zmax = czmax;
+        if (czmin < zmin) zmin = czmin;
+    }
+    if (top > bot) {
+        top = 1;
+        bot = 0;
+    }
+    clip->tile_top[tile] = (int16_t)top;
+    clip->tile_bot[tile] = (int16_t)bot;
+    clip->tile_zmax[tile] = zmax;
+    clip->tile_zmin[tile] = zmin;
+}
+
+#define RENDERER_CLIP_RECT_MIXED  0
+#define RENDERER_CLIP_RECT_HIDDEN 1  /* every pixel behind a span nearer than z */
+#define RENDERER_CLIP_RECT_CLEAR  2  /* no span in these columns is nearer than z */
+
+static int g_renderer_clip_tiles_state = -1;
+
+/* Classify screen rect [x0,x1] x [y0,y1] at depth z against the column clip.
+ * Whole tiles inside the range use the summary, the ragged ends are tested per
+ * column. Callers keep the range inside their own thread slice, so a tile is
+ * only ever refreshed by the worker that owns its columns. */
+static int renderer_column_clip_classify_rect(int x0, int x1, int y0, int y1, int32_t z)
+{
+    ColumnClip *clip = &g_renderer.clip;
+
+    if (!settings_env_feature_enabled(&g_renderer_clip_tiles_state, "AB3D_DISABLE_CLIP_TILES")) return RENDERER_CLIP_RECT_MIXED;
+    if (!clip->top || !clip->bot || !clip->z || !clip->top2 || !clip->bot2 || !clip->z2 ||
+        !clip->tile_top || !clip->tile_bot || !clip->tile_zmax || !clip->tile_zmin ||
+        !clip->tile_dirty) {
+        return RENDERER_CLIP_RECT_MIXED;
+    }
+    if (x0 < 0) x0 = 0;
+    if (x1 >= g_renderer.width) x1 = g_renderer.width - 1;
+    if (x0 > x1 || y0 > y1) return RENDERER_CLIP_RECT_MIXED;
+
+    int hidden = 1, clear = 1;
+    for (int c = x0; c <= x1;) {
+        int tile = c >> RENDERER_CLIP_TILE_SHIFT;
+        int tile_end = ((tile + 1) << RENDERER_CLIP_TILE_SHIFT) - 1;
+        if (tile_end >= g_renderer.width) tile_end = g_renderer.width - 1;
+        int ct, cb;
+        int32_t czmax, czmin;
+        if (c == (tile << RENDERER_CLIP_TILE_SHIFT) && tile_end <= x1) {
+            if (clip->tile_dirty[tile]) renderer_column_clip_tile_refresh(clip, tile);
+            ct = clip->tile_top[tile];
+            cb = clip->tile_bot[tile];
+            czmax = clip->tile_zmax[tile];
+            czmin = clip->tile_zmin[tile];
+            c = tile_end + 1;
+        } else {
+            renderer_column_clip_column_cover(clip, c, &ct, &cb, &czmax, &czmin);
+            c++;
+        }
+        if (!(ct <= y0 && cb >= y1 && czmax < z)) hidden = 0;
+        if (czmin < z) clear = 0;
+        if (!hidden && !clear) return RENDERER_CLIP_RECT_MIXED;
+    }
+    return hidden ? RENDERER_CLIP_RECT_HIDDEN : RENDERER_CLIP_RECT_CLEAR;
+}
+
+int renderer_column_clip_rect_hidden(int x0, int x1, int y0, int y1, int32_t z)
+{
+    return renderer_column_clip_classify_rect(x0, x1, y0, y1, z) == RENDERER_CLIP_RECT_HIDDEN;
+}
+
 static void renderer_zone_trace_floor_stats_init(RendererZoneTraceFloorStats *stats,
                                                  int active,
                                                  int zone_id,
@@ -5923,6 +7147,325 @@ static AB3D_ATTR_UNUSED int wall_proj_y_screen_invz(int16_t world_y, int64_t inv
     return (int)q + height / 2;
 }
 
+/* -----------------------------------------------------------------------
+ * Wall column kernels
+ *
+ * Same texel decode as the scalar WALL_TEX_* rows: 5-bit index packed three
+ * per big-endian word, looked up in the per-column 32-entry shade cache.
+ * Output is identical to the scalar loops; only the walk differs.
+ * ----------------------------------------------------------------------- */
+static inline uint8_t wall_column_texel(const uint8_t *tex_strip, int32_t tex_y,
+                                        int valand, unsigned pack_shift)
+{
+    int ra = ((int)(tex_y >> 16) & valand) << 1;
+    uint16_t w = ((uint16_t)tex_strip[ra] << 8) | tex_strip[ra + 1];
+    return (uint8_t)((w >> pack_shift) & 31u);
+}
+
+static inline void raster_fill_u16(uint16_t *dst, uint16_t v, int n)
+{
+    int i = 0;
+#if AB3D_HAVE_SSE2
+    const __m128i v8 = _mm_set1_epi16((short)v);
+    for (; i + 8 <= n; i += 8) _mm_storeu_si128((__m128i *)(void *)(dst + i), v8);
+#elif AB3D_HAVE_NEON
+    const uint16x8_t v8 = vdupq_n_u16(v);
+    for (; i + 8 <= n; i += 8) vst1q_u16(dst + i, v8);
+#elif AB3D_HAVE_WASM_SIMD
+    const v128_t v8 = wasm_i16x8_splat((int16_t)v);
+    for (; i + 8 <= n; i += 8) wasm_v128_store(dst + i, v8);
+#endif
+    for (; i < n; i++) dst[i] = v;
+}
+
+/* Texel row offsets for 8 consecutive pixels: ((tex_y >> 16) & valand) << 1. */
+static inline void wall_column_row_offsets8(int32_t tex_y, int32_t tex_step, int valand, int out[8])
+{
+#if AB3D_HAVE_SSE2
+    const __m128i mask = _mm_set1_epi32(valand);
+    __m128i y_lo = _mm_add_epi32(_mm_set1_epi32(tex_y),
+                                 _mm_setr_epi32(0, tex_step, tex_step * 2, tex_step * 3));
+    __m128i y_hi = _mm_add_epi32(y_lo, _mm_set1_epi32(tex_step * 4));
+    _mm_storeu_si128((__m128i *)(void *)out,
+                     _mm_slli_epi32(_mm_and_si128(_mm_srai_epi32(y_lo, 16), mask), 1));
+    _mm_storeu_si128((__m128i *)(void *)(out + 4),
+                     _mm_slli_epi32(_mm_and_si128(_mm_srai_epi32(y_hi, 16), mask), 1));
+#elif AB3D_HAVE_NEON
+    const int32_t ramp[4] = { 0, tex_step, tex_step * 2, tex_step * 3 };
+    const int32x4_t mask = vdupq_n_s32(valand);
+    int32x4_t y_lo = vaddq_s32(vdupq_n_s32(tex_y), vld1q_s32(ramp));
+    int32x4_t y_hi = vaddq_s32(y_lo, vdupq_n_s32(tex_step * 4));
+    vst1q_s32(out, vshlq_n_s32(vandq_s32(vshrq_n_s32(y_lo, 16), mask), 1));
+    vst1q_s32(out + 4, vshlq_n_s32(vandq_s32(vshrq_n_s32(y_hi, 16), mask), 1));
+#elif AB3D_HAVE_WASM_SIMD
+    const v128_t mask = wasm_i32x4_splat(valand);
+    v128_t y_lo = wasm_i32x4_add(wasm_i32x4_splat(tex_y),
+                                 wasm_i32x4_make(0, tex_step, tex_step * 2, tex_step * 3));
+    v128_t y_hi = wasm_i32x4_add(y_lo, wasm_i32x4_splat(tex_step * 4));
+    wasm_v128_store(out, wasm_i32x4_shl(wasm_v128_and(wasm_i32x4_shr(y_lo, 16), mask), 1));
+    wasm_v128_store(out + 4, wasm_i32x4_shl(wasm_v128_and(wasm_i32x4_shr(y_hi, 16), mask), 1));
+#else
+    for (int k = 0; k < 8; k++) out[k] = ((int)((tex_y + tex_step * k) >> 16) & valand) << 1;
+#endif
+}
+
+/* Unextended textured wall column (rgb NULL when not expanded).
+ * Magnified columns (less than one texel per pixel, the common case for
+ * near walls at high RENDER_SCALE) decode each texel once and fill its run
+ * of rows. Minified columns in the column-major cw layout step 8 rows at a
+ * time and write their contiguous cw values with one store. Returns rows
+ * drawn; the caller's scalar loop finishes the rest. */
+static int wall_column_fast(uint8_t *AB3D_RESTRICT buf,
+                            uint32_t *AB3D_RESTRICT rgb,
+                            uint16_t *AB3D_RESTRICT cw,
+                            size_t pix, size_t pix_cw,
+                            size_t wstride, size_t cw_step_y,
+                            const uint8_t *tex_strip, int valand, unsigned pack_shift,
+                            const uint16_t *cache_cw, const uint32_t *cache_rgb,
+                            int32_t tex_y, int32_t tex_step, int count)
+{
+    int i = 0;
+    if (tex_step > 0 && tex_step < (1 << 16)) {
+        while (i < count) {
+            int64_t next_row_fp = ((int64_t)(tex_y >> 16) + 1) << 16;
+            int64_t rows_left = (next_row_fp - (int64_t)tex_y + tex_step - 1) / tex_step;
+            int run = count - i;
+            if (rows_left < run) run = (int)rows_left;
+            uint8_t t = wall_column_texel(tex_strip, tex_y, valand, pack_shift);
+            uint16_t cv = cache_cw[t];
+            if (cw_step_y == 1u) {
+                raster_fill_u16(&cw[pix_cw], cv, run);
+                pix_cw += (size_t)run;
+            } else {
+                for (int k = 0; k < run; k++, pix_cw += cw_step_y) cw[pix_cw] = cv;
+            }
+            if (rgb) {
+                uint32_t rv = cache_rgb[t];
+                for (int k = 0; k < run; k++, pix += wstride) {
+                    buf[pix] = 2;
+                    rgb[pix] = rv;
+                }
+            } else {
+                for (int k = 0; k < run; k++, pix += wstride) buf[pix] = 2;
+            }
+            tex_y += tex_step * run;
+            i += run;
+        }
+        return i;
+    }
+
+    if (cw_step_y != 1u) return 0;
+    for (; i <= count - 8; i += 8) {
+        int ra[8];
+        uint16_t cw8[8];
+        wall_column_row_offsets8(tex_y, tex_step, valand, ra);
+        for (int k = 0; k < 8; k++) {
+            uint16_t w = ((uint16_t)tex_strip[ra[k]] << 8) | tex_strip[ra[k] + 1];
+            uint8_t t = (uint8_t)((w >> pack_shift) & 31u);
+            cw8[k] = cache_cw[t];
+            buf[pix] = 2;
+            if (rgb) rgb[pix] = cache_rgb[t];
+            pix += wstride;
+        }
+        memcpy(&cw[pix_cw], cw8, sizeof(cw8));
+        pix_cw += 8u;
+        tex_y += tex_step * 8;
+    }
+    return i;
+}
+
+/* -----------------------------------------------------------------------
+ * Texture mips
+ *
+ * Reduced levels of the wall and floor textures, built at load time. Each
+ * level keeps the base layout (packed 5-bit words for walls, the
+ * interleaved 256x256 sheet for floors) with every 2^L x 2^L block holding
+ * one representative texel index: the block texel nearest the block's mean
+ * colour under the brightest palette row. Indices instead of colours keep
+ * the per-brightness LUT caches in use for every level, and the unchanged
+ * layout means any address still reads the right block. The rasterizers
+ * pick a level from the texel step of the column/row and also snap their
+ * addresses to the block corner, so at distance neighbouring pixels share
+ * cache lines instead of scattering across the texture.
+ * ----------------------------------------------------------------------- */
+#define TEX_MIP_LEVELS       2       /* levels beyond the base texture */
+#define FLOOR_SHEET_BYTES    65536u
+
+static uint8_t *g_wall_mips[MAX_WALL_TILES][TEX_MIP_LEVELS];
+static const uint8_t *g_wall_mip_src[MAX_WALL_TILES];
+static uint8_t *g_floor_mips[TEX_MIP_LEVELS];
+static const uint8_t *g_floor_mip_src;
+static int g_tex_mips_state = -1;
+
+static int tex_mips_enabled(void)
+{
+    return settings_env_feature_enabled(&g_tex_mips_state, "AB3D_DISABLE_TEX_MIPS");
+}
+
+/* Level for a 16.16 texel step per pixel: one level per doubling past 2. */
+static inline int tex_mip_level_for_step(uint32_t step_abs)
+{
+    if (step_abs >= (4u << 16)) return 2;
+    if (step_abs >= (2u << 16)) return 1;
+    return 0;
+}
+
+/* Index of the texel in idx[0..n) nearest the mean colour (pal: 12-bit BE words). */
+static uint8_t tex_mip_pick(const uint8_t *idx, int n, const uint8_t *pal, size_t pal_entries)
+{
+    int sr = 0, sg = 0, sb = 0;
+    for (int i = 0; i < n; i++) {
+        size_t t = idx[i] < pal_entries ? idx[i] : 0;
+        uint16_t c = (uint16_t)((pal[t * 2u] << 8) | pal[t * 2u + 1u]);
+        sr += (c >> 8) & 15;
+        sg += (c >> 4) & 15;
+        sb += c & 15;
+    }
+    uint8_t best = idx[0];
+    int best_d = INT_MAX;
+    for (int i = 0; i < n; i++) {
+        size_t t = idx[i] < pal_entries ? idx[i] : 0;
+        uint16_t c = (uint16_t)((pal[t * 2u] << 8) | pal[t * 2u + 1u]);
+        int dr = ((c >> 8) & 15) * n - sr;
+        int dg = ((c >> 4) & 15) * n - sg;
+        int db = (c & 15) * n - sb;
+        int d = dr * dr + dg * dg + db * db;
+        if (d < best_d) {
+            best_d = d;
+            best = idx[i];
+        }
+    }
+    return best;
+}
+
+static void tex_mips_release_wall(int tex_id)
+{
+    for (int l = 0; l < TEX_MIP_LEVELS; l++) {
+        free(g_wall_mips[tex_id][l]);
+        g_wall_mips[tex_id][l] = NULL;
+    }
+    g_wall_mip_src[tex_id] = NULL;
+}
+
+void renderer_build_wall_mips(int tex_id, const uint8_t *pixels, size_t pixel_bytes,
+                              int valshift, const uint8_t *pal)
+{
+    if (tex_id < 0 || tex_id >= MAX_WALL_TILES) return;
+    tex_mips_release_wall(tex_id);
+    if (!tex_mips_enabled() || !pixels || !pal || valshift < 0 || valshift > 12) return;
+
+    const int rows = 1 << valshift;
+    const size_t strip_bytes = (size_t)rows * 2u;
+    const int strips = (int)(pixel_bytes / strip_bytes);
+    const int cols = strips * 3;
+    if (strips < 1) return;
+
+    uint8_t *idx = (uint8_t *)malloc((size_t)cols * (size_t)rows);
+    if (!idx) return;
+    for (int c = 0; c < cols; c++) {
+        const uint8_t *strip = pixels + (size_t)(c / 3) * strip_bytes;
+        unsigned shift = (unsigned)(c % 3) * 5u;
+        for (int r = 0; r < rows; r++) {
+            uint16_t w = (uint16_t)((strip[r * 2] << 8) | strip[r * 2 + 1]);
+            idx[(size_t)c * (size_t)rows + (size_t)r] = (uint8_t)((w >> shift) & 31u);
+        }
+    }
+
+    for (int l = 0; l < TEX_MIP_LEVELS; l++) {
+        const int block = 2 << l;
+        uint8_t *out = (uint8_t *)malloc(pixel_bytes);
+        if (!out) break;
+        memcpy(out, pixels, pixel_bytes);
+        for (int bc = 0; bc < cols; bc += block) {
+            int bw = (cols - bc < block) ? cols - bc : block;
+            for (int br = 0; br < rows; br += block) {
+                int bh = (rows - br < block) ? rows - br : block;
+                uint8_t cand[16];
+                int n = 0;
+                for (int c = bc; c < bc + bw; c++)
+                    for (int r = br; r < br + bh; r++)
+                        cand[n++] = idx[(size_t)c * (size_t)rows + (size_t)r];
+                uint8_t t = tex_mip_pick(cand, n, pal, 32u);
+                for (int c = bc; c < bc + bw; c++) {
+                    uint8_t *strip = out + (size_t)(c / 3) * strip_bytes;
+                    unsigned shift = (unsigned)(c % 3) * 5u;
+                    for (int r = br; r < br + bh; r++) {
+                        uint16_t w = (uint16_t)((strip[r * 2] << 8) | strip[r * 2 + 1]);
+                        w = (uint16_t)((w & ~(31u << shift)) | ((unsigned)t << shift));
+                        strip[r * 2] = (uint8_t)(w >> 8);
+                        strip[r * 2 + 1] = (uint8_t)w;
+                    }
+                }
+            }
+        }
+        g_wall_mips[tex_id][l] = out;
+    }
+    free(idx);
+    g_wall_mip_src[tex_id] = pixels;
+}
+
+void renderer_build_floor_mips(const uint8_t *sheet, size_t sheet_bytes, const uint8_t *floor_pal)
+{
+    for (int l = 0; l < TEX_MIP_LEVELS; l++) {
+        free(g_floor_mips[l]);
+        g_floor_mips[l] = NULL;
+    }
+    g_floor_mip_src = NULL;
+    if (!tex_mips_enabled() || !sheet || !floor_pal || sheet_bytes < FLOOR_SHEET_BYTES) return;
+
+    /* Sheet address = row * 1024 + tile_y * 256 + col * 4 + tile_x: sixteen
+     * interleaved 64x64 tiles, sampled at col/row (see renderer_draw_floor_span_ctx). */
+    for (int l = 0; l < TEX_MIP_LEVELS; l++) {
+        const int block = 2 << l;
+        uint8_t *out = (uint8_t *)malloc(FLOOR_SHEET_BYTES);
+        if (!out) break;
+        for (int tile = 0; tile < 16; tile++) {
+            const size_t tile_base = (size_t)(tile >> 2) * 256u + (size_t)(tile & 3);
+            for (int bc = 0; bc < 64; bc += block) {
+                for (int br = 0; br < 64; br += block) {
+                    uint8_t cand[16];
+                    int n = 0;
+                    for (int r = br; r < br + block; r++)
+                        for (int c = bc; c < bc + block; c++)
+                            cand[n++] = sheet[tile_base + (size_t)r * 1024u + (size_t)c * 4u];
+                    uint8_t t = tex_mip_pick(cand, n, floor_pal, 256u);
+                    for (int r = br; r < br + block; r++)
+                        for (int c = bc; c < bc + block; c++)
+                            out[tile_base + (size_t)r * 1024u + (size_t)c * 4u] = t;
+                }
+            }
+        }
+        g_floor_mips[l] = out;
+    }
+    g_floor_mip_src = sheet;
+}
+
+void renderer_release_texture_mips(void)
+{
+    for (int i = 0; i < MAX_WALL_TILES; i++) tex_mips_release_wall(i);
+    renderer_build_floor_mips(NULL, 0, NULL);
+}
+
+/* Floor texture and texel-offset masks for a span/row with the given step.
+ * Non-sheet textures (bump maps) and near rows keep the base level. */
+static inline const uint8_t *floor_mip_select(const uint8_t *texture, int32_t u_step, int32_t v_step,
+                                              uint32_t *mask_u, uint32_t *mask_v)
+{
+    *mask_u = 0xFCu;
+    *mask_v = 0xFC00u;
+    if (!g_floor_mip_src || !texture ||
+        texture < g_floor_mip_src || texture >= g_floor_mip_src + FLOOR_SHEET_BYTES) {
+        return texture;
+    }
+    uint32_t au = (u_step < 0) ? (uint32_t)0 - (uint32_t)u_step : (uint32_t)u_step;
+    uint32_t av = (v_step < 0) ? (uint32_t)0 - (uint32_t)v_step : (uint32_t)v_step;
+    int level = tex_mip_level_for_step(au > av ? au : av);
+    if (level == 0 || !g_floor_mips[level - 1]) return texture;
+    *mask_u = (0xFCu << level) & 0xFCu;
+    *mask_v = (0xFC00u << level) & 0xFC00u;
+    return g_floor_mips[level - 1] + (texture - g_floor_mip_src);
+}
+
 /* -----------------------------------------------------------------------
  * Wall rendering — one entry per wall segment (not per screen column).
  *
@@ -5950,7 +7493,7 @@ static void draw_wall_rasterize_segment(
     uint32_t * AB3D_RESTRICT rgb = renderer_active_rgb();
     uint16_t * AB3D_RESTRICT cw = renderer_active_cw();
     if (!ctx) return;
-    if (!buf || !rgb || !cw) return;
+    if (!buf || !renderer_rgb_target_ok(rgb) || !cw) return;
 
     const int expand = g_renderer_rgb_raster_expand;
     const int width = g_renderer.width;
@@ -5988,6 +7531,9 @@ static void draw_wall_rasterize_segment(
 
     const uint8_t *pal = ctx->cur_wall_pal;
     const int has_tex_pal = (texture != NULL && pal != NULL);
+    const uint8_t *const *wall_mips =
+        (texture && tex_id >= 0 && tex_id < MAX_WALL_TILES && texture == g_wall_mip_src[tex_id])
+        ? (const uint8_t *const *)g_wall_mips[tex_id] : NULL;
 
     /* --- Endpoint-anchored interpolation ---
      * Compute start/end from the full line equation, then walk with extra fractional precision.
@@ -6088,17 +7634,30 @@ static void draw_wall_rasterize_segment(
             fallback_cw = argb_to_amiga12(fallback_rgb);
         }
 
+        int wall_pixels = yb - y_top_scr;
+        if (wall_pixels < 1) wall_pixels = 1;
+        int32_t tex_step = (int32_t)(h_shifted / wall_pixels);
+        int32_t tex_y = (ct - y_top_scr) * tex_step + ((int32_t)yoff_base << 16);
+
+        /* Minified column: sample the mip level for its row step, snapped to
+         * the block corner so neighbouring columns reuse the same strip. */
+        const uint8_t *col_texture = texture;
+        int col_valand = valand;
+        if (wall_mips) {
+            int level = tex_mip_level_for_step((uint32_t)tex_step);
+            if (level > 0 && wall_mips[level - 1]) {
+                col_texture = wall_mips[level - 1];
+                col_valand = valand & ~((1 << level) - 1);
+                tex_col &= ~((1 << level) - 1);
+            }
+        }
+
         /* Texture addressing */
         int strip_index = tex_col / 3;
         int pack_mode   = tex_col % 3;
         int strip_offset = strip_index << (valshift + 1);
         const uint8_t pack_shift = (uint8_t)(pack_mode * 5);
 
-        int wall_pixels = yb - y_top_scr;
-        if (wall_pixels < 1) wall_pixels = 1;
-        int32_t tex_step = (int32_t)(h_shifted / wall_pixels);
-        int32_t tex_y = (ct - y_top_scr) * tex_step + ((int32_t)yoff_base << 16);
-
         /* Edge extension only on segment boundary columns.  Interior columns
          * of the same segment are consecutive, so the ±1 extension from one
          * column is immediately overwritten by the adjacent column's center
@@ -6126,7 +7685,7 @@ static void draw_wall_rasterize_segment(
          * vertical-stride cache misses inherent to column-major rasterization. */
 #define WALL_PF_DIST 8
         if (has_tex_pal && strip_offset >= 0) {
-            const uint8_t *tex_strip = texture + strip_offset;
+            const uint8_t *tex_strip = col_texture + strip_offset;
             const uint16_t *cache_cw  = ctx->wall_cache_cw;
             const uint32_t *cache_rgb = ctx->wall_cache_rgb;
 
@@ -6136,12 +7695,22 @@ static void draw_wall_rasterize_segment(
                 size_t pix_hot_cw = pix_cw;
                 size_t pf_hot = pix_hot + (size_t)wstride * WALL_PF_DIST;
                 int32_t tex_y_hot = tex_y;
-                const int hot_count = cb - ct + 1;
+                int hot_count = cb - ct + 1;
+                if (g_renderer_raster_simd != RENDERER_RASTER_SIMD_SCALAR) {
+                    int done = wall_column_fast(buf, NULL, cw, pix_hot, pix_hot_cw, wstride, cw_step_y,
+                                                tex_strip, col_valand, pack_shift, cache_cw, cache_rgb,
+                                                tex_y_hot, tex_step, hot_count);
+                    pix_hot += wstride * (size_t)done;
+                    pix_hot_cw += cw_step_y * (size_t)done;
+                    pf_hot += wstride * (size_t)done;
+                    tex_y_hot += tex_step * done;
+                    hot_count -= done;
+                }
                 const int do_pf_hot = (hot_count > WALL_PF_DIST);
 
 #define WALL_TEX_HOT_ROW(SHIFT_) \
     do { \
-        int ra_ = ((int)(tex_y_hot >> 16) & valand) << 1; \
+        int ra_ = ((int)(tex_y_hot >> 16) & col_valand) << 1; \
         uint16_t w_ = ((uint16_t)tex_strip[ra_] << 8) | tex_strip[ra_ + 1]; \
         uint8_t t_ = (uint8_t)((w_ >> (SHIFT_)) & 31u); \
         buf[pix_hot] = 2; \
@@ -6217,11 +7786,21 @@ static void draw_wall_rasterize_segment(
                 pix_cw = pix_hot_cw;
                 tex_y = tex_y_hot;
             } else if (expand) {
+                int ct_run = ct;
+                if (!do_ext_l && !do_ext_r && g_renderer_raster_simd != RENDERER_RASTER_SIMD_SCALAR) {
+                    int done = wall_column_fast(buf, rgb, cw, pix, pix_cw, wstride, cw_step_y,
+                                                tex_strip, col_valand, pack_shift, cache_cw, cache_rgb,
+                                                tex_y, tex_step, cb - ct + 1);
+                    pix += wstride * (size_t)done;
+                    pix_cw += cw_step_y * (size_t)done;
+                    tex_y += tex_step * done;
+                    ct_run += done;
+                }
 #define WALL_TEX_E(EL, ER) \
-    do { for (int y_ = ct; y_ <= cb; y_++) { \
+    do { for (int y_ = ct_run; y_ <= cb; y_++) { \
         AB3D_PREFETCH_WRITE(&buf[pix + (size_t)wstride * WALL_PF_DIST]); \
         AB3D_PREFETCH_WRITE(&rgb[pix + (size_t)wstride * WALL_PF_DIST]); \
-        int ra_ = ((int)(tex_y >> 16) & valand) << 1; \
+        int ra_ = ((int)(tex_y >> 16) & col_valand) << 1; \
         uint16_t w_ = ((uint16_t)tex_strip[ra_] << 8) | tex_strip[ra_ + 1]; \
         uint8_t t_ = (uint8_t)((w_ >> pack_shift) & 31u); \
         uint16_t cv_ = cache_cw[t_]; uint32_t rv_ = cache_rgb[t_]; \
@@ -6239,7 +7818,7 @@ static void draw_wall_rasterize_segment(
 #define WALL_TEX_C(EL, ER) \
     do { for (int y_ = ct; y_ <= cb; y_++) { \
         AB3D_PREFETCH_WRITE(&buf[pix + (size_t)wstride * WALL_PF_DIST]); \
-        int ra_ = ((int)(tex_y >> 16) & valand) << 1; \
+        int ra_ = ((int)(tex_y >> 16) & col_valand) << 1; \
         uint16_t w_ = ((uint16_t)tex_strip[ra_] << 8) | tex_strip[ra_ + 1]; \
         uint8_t t_ = (uint8_t)((w_ >> pack_shift) & 31u); \
         uint16_t cv_ = cache_cw[t_]; \
@@ -6508,7 +8087,7 @@ static void renderer_draw_sky_ceiling_span_ctx(RenderSliceContext *ctx,
     uint8_t *buf = renderer_active_buf();
     uint32_t *rgb = renderer_active_rgb();
     uint16_t *cwbuf = renderer_active_cw();
-    if (!buf || !rgb || !cwbuf) return;
+    if (!buf || !renderer_rgb_target_ok(rgb) || !cwbuf) return;
     if (y < 0 || y >= rs->height) return;
     if (y < (int)ctx->top_clip || y > (int)ctx->bot_clip) return;
 
@@ -6539,31 +8118,22 @@ static void renderer_draw_sky_ceiling_span_ctx(RenderSliceContext *ctx,
         const int32_t sky_pan_period_fp = SKY_PAN_WIDTH << 16;
         int32_t u0_fp = (int32_t)(((int64_t)(angpos & 8191) * ((int64_t)SKY_PAN_WIDTH << 16)) / 8192);
         int sky_h = h;
-        int sky_view_cols;
-        if (w != s_cached_sky_view_cols_w) {
-            int center_x = (w * 47) / 96;
-            int left_px = center_x;
-            int right_px = (w - 1) - center_x;
-            const double focal_px = (double)(64 * renderer_proj_x_scale_px());
-            const double hfov =
-                atan((double)left_px / focal_px) +
-                atan((double)right_px / focal_px);
-            double sky_cols_f = ((double)SKY_PAN_WIDTH * hfov) / (2.0 * 3.14159265358979323846);
-            sky_view_cols = (int)(sky_cols_f + 0.5);
-            if (sky_view_cols < 1) sky_view_cols = 1;
-            if (sky_view_cols > SKY_PAN_WIDTH) sky_view_cols = SKY_PAN_WIDTH;
-            s_cached_sky_view_cols = sky_view_cols;
-            s_cached_sky_view_cols_w = w;
-        } else {
-            sky_view_cols = s_cached_sky_view_cols;
-        }
+        int sky_view_cols = sky_view_cols_for_width(w);
 
         const int32_t sx_step_fp = (int32_t)(((int64_t)sky_view_cols << 16) / (int64_t)w);
         int32_t sx_fp = (int32_t)((int64_t)xl * (int64_t)sx_step_fp);
 
         size_t row = (size_t)y * (size_t)w;
+        int pan_k0 = sky_pan_cache_origin(w, angpos);
 
-        if (s_sky_pixels && s_sky_mode == 0) {
+        if (pan_k0 >= 0) {
+            int th = s_sky_pan.rows;
+            const int64_t r_den = (int64_t)(sky_h > 1 ? sky_h - 1 : 1);
+            int rpix = (int)((int64_t)y * (th - 1) / r_den);
+            if (rpix < 0) rpix = 0;
+            if (rpix >= th) rpix = th - 1;
+            sky_pan_draw_row_nearest(buf, rgb, cwbuf, w, h, y, xl, xr, rpix, pan_k0);
+        } else if (s_sky_pixels && s_sky_mode == 0) {
             int th = s_sky_tex_h;
             int tw = s_sky_tex_w;
             const int32_t tw_scale_fp = ((int32_t)tw << 16) / SKY_PAN_WIDTH;
@@ -6664,6 +8234,225 @@ static void renderer_draw_sky_ceiling_span_ctx(RenderSliceContext *ctx,
 #endif
 }
 
+/* -----------------------------------------------------------------------
+ * Floor texel kernels
+ *
+ * The scalar span/column loops are the reference. The vector kernels walk
+ * eight pixels per step with identical 32-bit wrapping UV arithmetic, so
+ * their output matches the scalar path bit for bit.
+ * ----------------------------------------------------------------------- */
+static const char *renderer_raster_simd_name(int level)
+{
+    switch (level) {
+    case RENDERER_RASTER_SIMD_AVX2: return "avx2";
+    case RENDERER_RASTER_SIMD_VEC128:
+#if AB3D_HAVE_SSE2
+        return "sse2";
+#elif AB3D_HAVE_NEON
+        return "neon";
+#elif AB3D_HAVE_WASM_SIMD
+        return "simd128";
+#else
+        return "vec128";
+#endif
+    default: return "scalar";
+    }
+}
+
+static void renderer_raster_simd_detect(void)
+{
+    int level = RENDERER_RASTER_SIMD_SCALAR;
+#if AB3D_HAVE_SSE2
+    if (SDL_HasSSE2()) level = RENDERER_RASTER_SIMD_VEC128;
+#elif AB3D_HAVE_NEON || AB3D_HAVE_WASM_SIMD
+    /* Compiled-in NEON / SIMD128 is part of the target baseline. */
+    level = RENDERER_RASTER_SIMD_VEC128;
+#endif
+#if AB3D_HAVE_AVX2_TARGET
+    if (level == RENDERER_RASTER_SIMD_VEC128 && SDL_HasAVX2()) level = RENDERER_RASTER_SIMD_AVX2;
+#endif
+    {
+        const char *env = SDL_getenv("AB3D_RASTER_SIMD");
+        if (env && (env[0] == '0' || strcmp(env, "scalar") == 0 || strcmp(env, "off") == 0)) {
+            level = RENDERER_RASTER_SIMD_SCALAR;
+        } else if (env && strcmp(env, "vec128") == 0 && level > RENDERER_RASTER_SIMD_VEC128) {
+            level = RENDERER_RASTER_SIMD_VEC128;
+        }
+    }
+    g_renderer_raster_simd = level;
+    printf("[RENDERER] Raster texel kernel: %s\n", renderer_raster_simd_name(level));
+}
+
+/* Texel offsets for 8 consecutive span pixels:
+ * ((u >> 14) & mask_u) | ((v >> 6) & mask_v), same as the scalar walk
+ * (0xFC / 0xFC00 at the base level, block-aligned masks for mips). */
+static inline void floor_span_texel_offsets8(uint32_t u_fp, uint32_t v_fp,
+                                             uint32_t u_step, uint32_t v_step,
+                                             uint32_t mask_u, uint32_t mask_v,
+                                             uint32_t out[8])
+{
+#if AB3D_HAVE_NEON
+    const uint32_t u_ramp[4] = { 0u, u_step, u_step * 2u, u_step * 3u };
+    const uint32_t v_ramp[4] = { 0u, v_step, v_step * 2u, v_step * 3u };
+    const uint32x4_t u_mask = vdupq_n_u32(mask_u);
+    const uint32x4_t v_mask = vdupq_n_u32(mask_v);
+    uint32x4_t u_lo = vaddq_u32(vdupq_n_u32(u_fp), vld1q_u32(u_ramp));
+    uint32x4_t v_lo = vaddq_u32(vdupq_n_u32(v_fp), vld1q_u32(v_ramp));
+    uint32x4_t u_hi = vaddq_u32(u_lo, vdupq_n_u32(u_step * 4u));
+    uint32x4_t v_hi = vaddq_u32(v_lo, vdupq_n_u32(v_step * 4u));
+    vst1q_u32(out, vorrq_u32(vandq_u32(vshrq_n_u32(u_lo, 14), u_mask),
+                             vandq_u32(vshrq_n_u32(v_lo, 6), v_mask)));
+    vst1q_u32(out + 4, vorrq_u32(vandq_u32(vshrq_n_u32(u_hi, 14), u_mask),
+                                 vandq_u32(vshrq_n_u32(v_hi, 6), v_mask)));
+#elif AB3D_HAVE_WASM_SIMD
+    const v128_t u_mask = wasm_i32x4_splat((int32_t)mask_u);
+    const v128_t v_mask = wasm_i32x4_splat((int32_t)mask_v);
+    v128_t u_lo = wasm_i32x4_add(wasm_i32x4_splat((int32_t)u_fp),
+                                 wasm_i32x4_make(0, (int32_t)u_step, (int32_t)(u_step * 2u), (int32_t)(u_step * 3u)));
+    v128_t v_lo = wasm_i32x4_add(wasm_i32x4_splat((int32_t)v_fp),
+                                 wasm_i32x4_make(0, (int32_t)v_step, (int32_t)(v_step * 2u), (int32_t)(v_step * 3u)));
+    v128_t u_hi = wasm_i32x4_add(u_lo, wasm_i32x4_splat((int32_t)(u_step * 4u)));
+    v128_t v_hi = wasm_i32x4_add(v_lo, wasm_i32x4_splat((int32_t)(v_step * 4u)));
+    wasm_v128_store(out, wasm_v128_or(wasm_v128_and(wasm_u32x4_shr(u_lo, 14), u_mask),
+                                      wasm_v128_and(wasm_u32x4_shr(v_lo, 6), v_mask)));
+    wasm_v128_store(out + 4, wasm_v128_or(wasm_v128_and(wasm_u32x4_shr(u_hi, 14), u_mask),
+                                          wasm_v128_and(wasm_u32x4_shr(v_hi, 6), v_mask)));
+#else
+    for (int k = 0; k < 8; k++) {
+        uint32_t u = u_fp + u_step * (uint32_t)k;
+        uint32_t v = v_fp + v_step * (uint32_t)k;
+        out[k] = ((u >> 14) & mask_u) | ((v >> 6) & mask_v);
+    }
+#endif
+}
+
+/* Row-major LUT span, 8 pixels per step. span_rgb/p32 are NULL when the
+ * RGB raster is not expanded. Returns pixels written (multiple of 8);
+ * the caller finishes the tail and advances its pointers. */
+static int floor_span_lut_kernel8(const uint8_t *AB3D_RESTRICT texture,
+                                  const uint16_t *AB3D_RESTRICT span_cw,
+                                  const uint32_t *AB3D_RESTRICT span_rgb,
+                                  uint32_t *io_u, uint32_t *io_v,
+                                  int32_t u_step, int32_t v_step,
+                                  uint32_t mask_u, uint32_t mask_v,
+                                  uint8_t *AB3D_RESTRICT p8,
+                                  uint32_t *AB3D_RESTRICT p32,
+                                  uint16_t *AB3D_RESTRICT p16,
+                                  int count)
+{
+    const uint32_t us = (uint32_t)u_step;
+    const uint32_t vs = (uint32_t)v_step;
+    uint32_t u_fp = *io_u;
+    uint32_t v_fp = *io_v;
+    int i = 0;
+    for (; i <= count - 8; i += 8) {
+        uint32_t off[8];
+        uint16_t cw8[8];
+        uint8_t tex[8];
+        floor_span_texel_offsets8(u_fp, v_fp, us, vs, mask_u, mask_v, off);
+        for (int k = 0; k < 8; k++) {
+            tex[k] = texture[off[k]];
+            cw8[k] = span_cw[tex[k]];
+        }
+        memcpy(p16 + i, cw8, sizeof(cw8));
+        if (p32) {
+            uint32_t rgb8[8];
+            for (int k = 0; k < 8; k++) rgb8[k] = span_rgb[tex[k]];
+            memcpy(p32 + i, rgb8, sizeof(rgb8));
+        }
+        memset(p8 + i, 1, 8);
+        u_fp += us * 8u;
+        v_fp += vs * 8u;
+    }
+    *io_u = u_fp;
+    *io_v = v_fp;
+    return i;
+}
+
+#if AB3D_HAVE_AVX2_TARGET
+/* AVX2 variant of the expanded span: 8-lane address math and a hardware
+ * gather for the RGB LUT. cw stays a scalar lookup; a 32-bit gather on the
+ * 16-bit table would read past its last entry. */
+AB3D_TARGET_AVX2
+static int floor_span_lut_kernel8_avx2(const uint8_t *AB3D_RESTRICT texture,
+                                       const uint16_t *AB3D_RESTRICT span_cw,
+                                       const uint32_t *AB3D_RESTRICT span_rgb,
+                                       uint32_t *io_u, uint32_t *io_v,
+                                       int32_t u_step, int32_t v_step,
+                                       uint32_t mask_u, uint32_t mask_v,
+                                       uint8_t *AB3D_RESTRICT p8,
+                                       uint32_t *AB3D_RESTRICT p32,
+                                       uint16_t *AB3D_RESTRICT p16,
+                                       int count)
+{
+    const __m256i ramp = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256i u_step8 = _mm256_set1_epi32((int)((uint32_t)u_step * 8u));
+    const __m256i v_step8 = _mm256_set1_epi32((int)((uint32_t)v_step * 8u));
+    const __m256i u_mask = _mm256_set1_epi32((int)mask_u);
+    const __m256i v_mask = _mm256_set1_epi32((int)mask_v);
+    __m256i u = _mm256_add_epi32(_mm256_set1_epi32((int)*io_u),
+                                 _mm256_mullo_epi32(ramp, _mm256_set1_epi32(u_step)));
+    __m256i v = _mm256_add_epi32(_mm256_set1_epi32((int)*io_v),
+                                 _mm256_mullo_epi32(ramp, _mm256_set1_epi32(v_step)));
+    int i = 0;
+    for (; i <= count - 8; i += 8) {
+        uint32_t off[8];
+        uint16_t cw8[8];
+        int32_t tex[8];
+        __m256i o = _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(u, 14), u_mask),
+                                    _mm256_and_si256(_mm256_srli_epi32(v, 6), v_mask));
+        _mm256_storeu_si256((__m256i *)(void *)off, o);
+        for (int k = 0; k < 8; k++) {
+            tex[k] = texture[off[k]];
+            cw8[k] = span_cw[tex[k]];
+        }
+        memcpy(p16 + i, cw8, sizeof(cw8));
+        _mm256_storeu_si256((__m256i *)(void *)(p32 + i),
+                            _mm256_i32gather_epi32((const int *)(const void *)span_rgb,
+                                                   _mm256_loadu_si256((const __m256i *)(const void *)tex), 4));
+        memset(p8 + i, 1, 8);
+        u = _mm256_add_epi32(u, u_step8);
+        v = _mm256_add_epi32(v, v_step8);
+    }
+    *io_u += (uint32_t)u_step * (uint32_t)i;
+    *io_v += (uint32_t)v_step * (uint32_t)i;
+    return i;
+}
+#endif
+
+/* SSE2 builds keep their 4-wide SSE2 span loop at the vec128 level: the
+ * 8-wide kernel only does the address math in vectors, the texel and LUT
+ * fetches stay scalar, so it replaces that loop only where it adds the RGB
+ * gather (AVX2) or where there is no SSE2 loop (NEON, wasm SIMD). */
+static inline int floor_span_lut_kernel_enabled(int expand_rgb)
+{
+#if AB3D_HAVE_SSE2
+    return expand_rgb && g_renderer_raster_simd == RENDERER_RASTER_SIMD_AVX2;
+#else
+    (void)expand_rgb;
+    return g_renderer_raster_simd != RENDERER_RASTER_SIMD_SCALAR;
+#endif
+}
+
+static inline int floor_span_lut_run(const uint8_t *texture,
+                                     const uint16_t *span_cw,
+                                     const uint32_t *span_rgb,
+                                     uint32_t *io_u, uint32_t *io_v,
+                                     int32_t u_step, int32_t v_step,
+                                     uint32_t mask_u, uint32_t mask_v,
+                                     uint8_t *p8, uint32_t *p32, uint16_t *p16,
+                                     int count)
+{
+#if AB3D_HAVE_AVX2_TARGET
+    if (p32 && g_renderer_raster_simd == RENDERER_RASTER_SIMD_AVX2) {
+        return floor_span_lut_kernel8_avx2(texture, span_cw, span_rgb, io_u, io_v,
+                                           u_step, v_step, mask_u, mask_v, p8, p32, p16, count);
+    }
+#endif
+    return floor_span_lut_kernel8(texture, span_cw, p32 ? span_rgb : NULL, io_u, io_v,
+                                  u_step, v_step, mask_u, mask_v, p8, p32, p16, count);
+}
+
 /* -----------------------------------------------------------------------
  * Floor/ceiling span rendering
  *
@@ -6699,7 +8488,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
     uint8_t *buf = renderer_active_buf();
     uint32_t *rgb = renderer_active_rgb();
     uint16_t *cwbuf = renderer_active_cw();
-    if (!buf || !rgb || !cwbuf) return;
+    if (!buf || !renderer_rgb_target_ok(rgb) || !cwbuf) return;
     if (y < 0 || y >= rs->height) return;
     /* Clip to active slice vertical band (full height for column-threaded workers). */
     if (y < (int)ctx->top_clip || y > (int)ctx->bot_clip) return;
@@ -6772,6 +8561,10 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
     int w = floor_common.width;
     int32_t u_step = row_math.u_step;
     int32_t v_step = row_math.v_step;
+    uint32_t fu_mask = 0xFCu, fv_mask = 0xFC00u;
+    if (texture && !is_water) {
+        texture = floor_mip_select(texture, u_step, v_step, &fu_mask, &fv_mask);
+    }
 
     const uint8_t *pal_lut_src = floor_pal ? floor_pal : rs->floor_pal;
     int floor_pal_level = 0;
@@ -6843,7 +8636,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
         }
     }
     uint8_t *row8 = buf + (size_t)y * w + (size_t)xl;
-    uint32_t *row32 = rgb + (size_t)y * w + (size_t)xl;
+    uint32_t *row32 = rgb ? rgb + (size_t)y * w + (size_t)xl : NULL;
     uint16_t *row16 = cwbuf + (size_t)y * w + (size_t)xl;
     const int cw_col_major = AB3D_CW_COL_MAJOR;
     const int floor_cw_nt = (cw_col_major && !is_water);
@@ -6877,7 +8670,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
     size_t water_refr_cw_base1 = 0;
     int water_refr_frac = 0;
     int water_has_next_refr = 0;
-    const int water_has_back_buffers = (rs->rgb_back_buffer && rs->cw_back_buffer);
+    const int water_has_back_buffers = (rs->cw_back_buffer && renderer_rgb_target_ok(rs->rgb_back_buffer));
     if (is_water) {
         int32_t refr_y_fp = ((int32_t)y << 8) + water_refr_y_off_fp;
         int refr_y = (int)(refr_y_fp >> 8);
@@ -6905,21 +8698,30 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
             uint32_t u_pf = u_fp + (uint32_t)u_step * 8u;
             uint32_t v_pf = v_fp + (uint32_t)v_step * 8u;
             int i = 0;
+            if (!cw_col_major && span_len >= 8 && floor_span_lut_kernel_enabled(1)) {
+                i = floor_span_lut_run(texture, span_cw, span_rgb, &u_fp, &v_fp, u_step, v_step,
+                                       fu_mask, fv_mask, p8, p32, p16, span_len);
+                p8 += i;
+                p32 += i;
+                p16 += i;
+                u_pf += (uint32_t)u_step * (uint32_t)i;
+                v_pf += (uint32_t)v_step * (uint32_t)i;
+            }
 #if AB3D_HAVE_SSE2
             if (!cw_col_major) for (; i <= span_len - 4; i += 4) {
                 if (i + 8 < span_len) {
-                    AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                    AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                 }
-                uint8_t t0 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t t0 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
-                uint8_t t1 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t t1 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
-                uint8_t t2 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t t2 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
-                uint8_t t3 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t t3 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
                 u_pf += (uint32_t)u_step * 4u;
@@ -6946,18 +8748,18 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
             if (cw_col_major) {
                 for (; i <= span_len - 4; i += 4) {
                     if (i + 8 < span_len) {
-                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                     }
-                    uint8_t t0 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t0 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
-                    uint8_t t1 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t1 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
-                    uint8_t t2 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t2 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
-                    uint8_t t3 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t3 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
                     u_pf += (uint32_t)u_step * 4u;
@@ -6980,9 +8782,9 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
             }
             for (; i < span_len; i++) {
                 if (i + 8 < span_len) {
-                    AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                    AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                 }
-                uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t texel = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
                 u_pf += (uint32_t)u_step;
@@ -6999,21 +8801,29 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
             uint32_t u_pf = u_fp + (uint32_t)u_step * 8u;
             uint32_t v_pf = v_fp + (uint32_t)v_step * 8u;
             int i = 0;
+            if (!cw_col_major && span_len >= 8 && floor_span_lut_kernel_enabled(0)) {
+                i = floor_span_lut_run(texture, span_cw, NULL, &u_fp, &v_fp, u_step, v_step,
+                                       fu_mask, fv_mask, p8, NULL, p16, span_len);
+                p8 += i;
+                p16 += i;
+                u_pf += (uint32_t)u_step * (uint32_t)i;
+                v_pf += (uint32_t)v_step * (uint32_t)i;
+            }
 #if AB3D_HAVE_SSE2
             if (!cw_col_major) for (; i <= span_len - 4; i += 4) {
                 if (i + 8 < span_len) {
-                    AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                    AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                 }
-                uint8_t t0 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t t0 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
-                uint8_t t1 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t t1 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
-                uint8_t t2 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t t2 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
-                uint8_t t3 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t t3 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
                 u_pf += (uint32_t)u_step * 4u;
@@ -7034,18 +8844,18 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
             if (cw_col_major) {
                 for (; i <= span_len - 4; i += 4) {
                     if (i + 8 < span_len) {
-                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                     }
-                    uint8_t t0 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t0 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
-                    uint8_t t1 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t1 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
-                    uint8_t t2 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t2 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
-                    uint8_t t3 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t3 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
                     u_pf += (uint32_t)u_step * 4u;
@@ -7062,9 +8872,9 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
             }
             for (; i < span_len; i++) {
                 if (i + 8 < span_len) {
-                    AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                    AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                 }
-                uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t texel = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
                 u_pf += (uint32_t)u_step;
@@ -7573,16 +9383,16 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                     int i = 0;
                     for (; i <= span_len - 4; i += 4) {
                         if (i + 8 < span_len) {
-                            AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                            AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                         }
 
-                        uint8_t t0 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                        uint8_t t0 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                         u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                        uint8_t t1 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                        uint8_t t1 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                         u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                        uint8_t t2 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                        uint8_t t2 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                         u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                        uint8_t t3 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                        uint8_t t3 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                         u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
                         u_pf += (uint32_t)u_step * 4u;
                         v_pf += (uint32_t)v_step * 4u;
@@ -7595,10 +9405,10 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
 
                     for (; i < span_len; i++) {
                         if (i + 8 < span_len) {
-                            AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                            AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                         }
 
-                        uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                        uint8_t texel = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                         u_fp += (uint32_t)u_step;
                         v_fp += (uint32_t)v_step;
                         u_pf += (uint32_t)u_step;
@@ -7612,16 +9422,16 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                     int i = 0;
                     for (; i <= span_len - 4; i += 4) {
                         if (i + 8 < span_len) {
-                            AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                            AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                         }
 
-                        uint8_t t0 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                        uint8_t t0 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                         u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                        uint8_t t1 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                        uint8_t t1 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                         u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                        uint8_t t2 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                        uint8_t t2 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                         u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                        uint8_t t3 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                        uint8_t t3 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                         u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
                         u_pf += (uint32_t)u_step * 4u;
                         v_pf += (uint32_t)v_step * 4u;
@@ -7634,10 +9444,10 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
 
                     for (; i < span_len; i++) {
                         if (i + 8 < span_len) {
-                            AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                            AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                         }
 
-                        uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                        uint8_t texel = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                         u_fp += (uint32_t)u_step;
                         v_fp += (uint32_t)v_step;
                         u_pf += (uint32_t)u_step;
@@ -7654,7 +9464,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                 int i = 0;
                 for (; i <= span_len - 4; i += 4) {
                     if (i + 8 < span_len) {
-                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                     }
 
                     int g0 = (int)(gour_level_fp >> 16); gour_level_fp += gour_level_step;
@@ -7666,13 +9476,13 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                     if (g2 < 0) g2 = 0; if (g2 >= FLOOR_PAL_LEVEL_COUNT) g2 = FLOOR_PAL_LEVEL_COUNT - 1;
                     if (g3 < 0) g3 = 0; if (g3 >= FLOOR_PAL_LEVEL_COUNT) g3 = FLOOR_PAL_LEVEL_COUNT - 1;
 
-                    uint8_t t0 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t0 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                    uint8_t t1 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t1 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                    uint8_t t2 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t2 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                    uint8_t t3 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t3 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
                     u_pf += (uint32_t)u_step * 4u;
                     v_pf += (uint32_t)v_step * 4u;
@@ -7685,7 +9495,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
 
                 for (; i < span_len; i++) {
                     if (i + 8 < span_len) {
-                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                     }
 
                     int gour_level = (int)(gour_level_fp >> 16);
@@ -7693,7 +9503,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                     if (gour_level < 0) gour_level = 0;
                     if (gour_level >= FLOOR_PAL_LEVEL_COUNT) gour_level = FLOOR_PAL_LEVEL_COUNT - 1;
 
-                    uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t texel = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
                     u_pf += (uint32_t)u_step;
@@ -7707,7 +9517,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                 int i = 0;
                 for (; i <= span_len - 4; i += 4) {
                     if (i + 8 < span_len) {
-                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                     }
 
                     int g0 = (int)(gour_level_fp >> 16); gour_level_fp += gour_level_step;
@@ -7719,13 +9529,13 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                     if (g2 < 0) g2 = 0; if (g2 >= FLOOR_PAL_LEVEL_COUNT) g2 = FLOOR_PAL_LEVEL_COUNT - 1;
                     if (g3 < 0) g3 = 0; if (g3 >= FLOOR_PAL_LEVEL_COUNT) g3 = FLOOR_PAL_LEVEL_COUNT - 1;
 
-                    uint8_t t0 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t0 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                    uint8_t t1 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t1 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                    uint8_t t2 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t2 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
-                    uint8_t t3 = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t t3 = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step; v_fp += (uint32_t)v_step;
                     u_pf += (uint32_t)u_step * 4u;
                     v_pf += (uint32_t)v_step * 4u;
@@ -7738,7 +9548,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
 
                 for (; i < span_len; i++) {
                     if (i + 8 < span_len) {
-                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                     }
 
                     int gour_level = (int)(gour_level_fp >> 16);
@@ -7746,7 +9556,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                     if (gour_level < 0) gour_level = 0;
                     if (gour_level >= FLOOR_PAL_LEVEL_COUNT) gour_level = FLOOR_PAL_LEVEL_COUNT - 1;
 
-                    uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t texel = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
                     u_pf += (uint32_t)u_step;
@@ -7766,9 +9576,9 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                 uint32_t v_pf = v_fp + (uint32_t)v_step * 8u;
                 for (int i = 0; i < span_len; i++) {
                     if (i + 8 < span_len) {
-                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                     }
-                    uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t texel = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
                     u_pf += (uint32_t)u_step;
@@ -7784,9 +9594,9 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                 uint32_t v_pf = v_fp + (uint32_t)v_step * 8u;
                 for (int i = 0; i < span_len; i++) {
                     if (i + 8 < span_len) {
-                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & 0xFCu) | ((v_pf >> 6) & 0xFC00u)]);
+                        AB3D_PREFETCH_READ(&texture[((u_pf >> 14) & fu_mask) | ((v_pf >> 6) & fv_mask)]);
                     }
-                    uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                    uint8_t texel = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                     u_fp += (uint32_t)u_step;
                     v_fp += (uint32_t)v_step;
                     u_pf += (uint32_t)u_step;
@@ -7816,7 +9626,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
                 if (d6 > 64) d6 = 64;
                 int gour_gray = (64 - d6) * 255 / 64;
 
-                uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                uint8_t texel = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
                 u_fp += (uint32_t)u_step;
                 v_fp += (uint32_t)v_step;
 
@@ -7830,7 +9640,7 @@ static void renderer_draw_floor_span_ctx(RenderSliceContext *ctx,
         }
 
         for (int i = 0; i < span_len; i++) {
-            uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+            uint8_t texel = texture[((u_fp >> 14) & fu_mask) | ((v_fp >> 6) & fv_mask)];
             u_fp += (uint32_t)u_step;
             v_fp += (uint32_t)v_step;
             int lit = ((int)texel * gray) >> 8;
@@ -7897,6 +9707,9 @@ typedef struct {
     int16_t bright_term;
     const uint16_t *span_cw;
     const uint32_t *span_rgb;
+    const uint8_t *tex;         /* texture or its mip for this row's step */
+    uint32_t tex_mask_u;
+    uint32_t tex_mask_v;
     uint32_t u_col;
     uint32_t v_col;
     int16_t next_x;
@@ -7904,14 +9717,17 @@ typedef struct {
 
 static AB3D_THREAD_LOCAL FloorRowFast *g_floor_fast_rows_scratch = NULL;
 static AB3D_THREAD_LOCAL int g_floor_fast_rows_capacity = 0;
+static AB3D_THREAD_LOCAL unsigned g_floor_fast_rows_gen = 0;
 static AB3D_THREAD_LOCAL int16_t *g_floor_fast_col_top_scratch = NULL;
 static AB3D_THREAD_LOCAL int16_t *g_floor_fast_col_bot_scratch = NULL;
 static AB3D_THREAD_LOCAL int *g_floor_fast_next_top_scratch = NULL;
 static AB3D_THREAD_LOCAL int *g_floor_fast_next_bot_scratch = NULL;
 static AB3D_THREAD_LOCAL int *g_floor_fast_cov_diff_scratch = NULL;
 static AB3D_THREAD_LOCAL int g_floor_fast_col_capacity = 0;
+static AB3D_THREAD_LOCAL unsigned g_floor_fast_col_gen = 0;
 static AB3D_THREAD_LOCAL int16_t *g_viewer_floor_occlude_scratch = NULL;
 static AB3D_THREAD_LOCAL int g_viewer_floor_occlude_capacity = 0;
+static AB3D_THREAD_LOCAL unsigned g_viewer_floor_occlude_gen = 0;
 
 /* Thread-local scanline edge tables for floor/ceiling/sky polygon rasterization.
  * Shared by renderer_draw_zone_ctx, renderer_tessellate_sky_ceiling_ctx, and
@@ -7922,9 +9738,25 @@ static AB3D_THREAD_LOCAL int16_t *g_poly_edge_right_scratch   = NULL;
 static AB3D_THREAD_LOCAL int16_t *g_poly_bright_left_scratch  = NULL;
 static AB3D_THREAD_LOCAL int16_t *g_poly_bright_right_scratch = NULL;
 static AB3D_THREAD_LOCAL int      g_poly_edge_h_capacity      = 0;
+static AB3D_THREAD_LOCAL unsigned g_poly_edge_gen             = 0;
 static AB3D_THREAD_LOCAL int16_t *g_poly_col_top_scratch      = NULL;
 static AB3D_THREAD_LOCAL int16_t *g_poly_col_bot_scratch      = NULL;
 static AB3D_THREAD_LOCAL int      g_poly_col_w_capacity       = 0;
+static AB3D_THREAD_LOCAL unsigned g_poly_col_gen              = 0;
+
+/* All scratch tables below are carved from g_renderer_frame_arena. A table
+ * is live while its recorded generation matches the arena's; after a reset
+ * the next ensure re-carves it at the remembered capacity, so growth only
+ * happens once and steady-state frames do no heap work. */
+static int renderer_scratch_grow_cap(int cap, int need, int initial)
+{
+    if (cap <= 0) cap = initial;
+    while (cap < need) {
+        if (cap > INT_MAX / 2) return need;
+        cap *= 2;
+    }
+    return cap;
+}
 
 /* Ensure all four h-row edge/bright scratch buffers are at least h entries wide.
  * Returns 1 on success, 0 on allocation failure. */
@@ -7933,25 +9765,17 @@ static int renderer_poly_edge_ensure_h(int h)
     int16_t *p;
     int new_cap;
     if (h <= 0) return 0;
-    if (g_poly_edge_left_scratch && h <= g_poly_edge_h_capacity) return 1;
-    new_cap = (g_poly_edge_h_capacity > 0) ? g_poly_edge_h_capacity : 64;
-    while (new_cap < h) {
-        if (new_cap > INT_MAX / 2) { new_cap = h; break; }
-        new_cap *= 2;
-    }
-    p = (int16_t *)realloc(g_poly_edge_left_scratch,    (size_t)new_cap * sizeof(*p));
+    if (g_poly_edge_left_scratch && h <= g_poly_edge_h_capacity &&
+        g_poly_edge_gen == g_renderer_frame_arena.generation) return 1;
+    new_cap = renderer_scratch_grow_cap(g_poly_edge_h_capacity, h, 64);
+    p = (int16_t *)renderer_frame_arena_alloc((size_t)new_cap * 4u * sizeof(*p));
     if (!p) return 0;
     g_poly_edge_left_scratch    = p;
-    p = (int16_t *)realloc(g_poly_edge_right_scratch,   (size_t)new_cap * sizeof(*p));
-    if (!p) return 0;
-    g_poly_edge_right_scratch   = p;
-    p = (int16_t *)realloc(g_poly_bright_left_scratch,  (size_t)new_cap * sizeof(*p));
-    if (!p) return 0;
-    g_poly_bright_left_scratch  = p;
-    p = (int16_t *)realloc(g_poly_bright_right_scratch, (size_t)new_cap * sizeof(*p));
-    if (!p) return 0;
-    g_poly_bright_right_scratch = p;
+    g_poly_edge_right_scratch   = p + new_cap;
+    g_poly_bright_left_scratch  = p + (size_t)new_cap * 2u;
+    g_poly_bright_right_scratch = p + (size_t)new_cap * 3u;
     g_poly_edge_h_capacity = new_cap;
+    g_poly_edge_gen = g_renderer_frame_arena.generation;
     return 1;
 }
 
@@ -7962,19 +9786,15 @@ static int renderer_poly_col_ensure_w(int w)
     int16_t *p;
     int new_cap;
     if (w <= 0) return 0;
-    if (g_poly_col_top_scratch && w <= g_poly_col_w_capacity) return 1;
-    new_cap = (g_poly_col_w_capacity > 0) ? g_poly_col_w_capacity : 64;
-    while (new_cap < w) {
-        if (new_cap > INT_MAX / 2) { new_cap = w; break; }
-        new_cap *= 2;
-    }
-    p = (int16_t *)realloc(g_poly_col_top_scratch, (size_t)new_cap * sizeof(*p));
+    if (g_poly_col_top_scratch && w <= g_poly_col_w_capacity &&
+        g_poly_col_gen == g_renderer_frame_arena.generation) return 1;
+    new_cap = renderer_scratch_grow_cap(g_poly_col_w_capacity, w, 64);
+    p = (int16_t *)renderer_frame_arena_alloc((size_t)new_cap * 2u * sizeof(*p));
     if (!p) return 0;
     g_poly_col_top_scratch = p;
-    p = (int16_t *)realloc(g_poly_col_bot_scratch, (size_t)new_cap * sizeof(*p));
-    if (!p) return 0;
-    g_poly_col_bot_scratch = p;
+    g_poly_col_bot_scratch = p + new_cap;
     g_poly_col_w_capacity = new_cap;
+    g_poly_col_gen = g_renderer_frame_arena.generation;
     return 1;
 }
 
@@ -7984,24 +9804,17 @@ static int16_t *renderer_viewer_floor_occlude_get_scratch(int width)
     int16_t *new_buf;
 
     if (width <= 0) return NULL;
-    if (g_viewer_floor_occlude_scratch && width <= g_viewer_floor_occlude_capacity)
+    if (g_viewer_floor_occlude_scratch && width <= g_viewer_floor_occlude_capacity &&
+        g_viewer_floor_occlude_gen == g_renderer_frame_arena.generation)
         return g_viewer_floor_occlude_scratch;
 
-    new_cap = (g_viewer_floor_occlude_capacity > 0) ? g_viewer_floor_occlude_capacity : 128;
-    while (new_cap < width) {
-        if (new_cap > INT_MAX / 2) {
-            new_cap = width;
-            break;
-        }
-        new_cap *= 2;
-    }
-
-    new_buf = (int16_t *)realloc(g_viewer_floor_occlude_scratch,
-                                 (size_t)new_cap * sizeof(*new_buf));
+    new_cap = renderer_scratch_grow_cap(g_viewer_floor_occlude_capacity, width, 128);
+    new_buf = (int16_t *)renderer_frame_arena_alloc((size_t)new_cap * sizeof(*new_buf));
     if (!new_buf) return NULL;
 
     g_viewer_floor_occlude_scratch = new_buf;
     g_viewer_floor_occlude_capacity = new_cap;
+    g_viewer_floor_occlude_gen = g_renderer_frame_arena.generation;
     return new_buf;
 }
 
@@ -8011,95 +9824,68 @@ static int renderer_floor_fast_ensure_rows_capacity(int row_count)
     FloorRowFast *new_rows;
 
     if (row_count <= 0) return 0;
-    if (g_floor_fast_rows_scratch && row_count <= g_floor_fast_rows_capacity) return 1;
-
-    new_cap = (g_floor_fast_rows_capacity > 0) ? g_floor_fast_rows_capacity : 64;
-    while (new_cap < row_count) {
-        if (new_cap > INT_MAX / 2) {
-            new_cap = row_count;
-            break;
-        }
-        new_cap *= 2;
-    }
+    if (g_floor_fast_rows_scratch && row_count <= g_floor_fast_rows_capacity &&
+        g_floor_fast_rows_gen == g_renderer_frame_arena.generation) return 1;
 
-    new_rows = (FloorRowFast *)realloc(g_floor_fast_rows_scratch, (size_t)new_cap * sizeof(*new_rows));
+    new_cap = renderer_scratch_grow_cap(g_floor_fast_rows_capacity, row_count, 64);
+    new_rows = (FloorRowFast *)renderer_frame_arena_alloc((size_t)new_cap * sizeof(*new_rows));
     if (!new_rows) return 0;
 
     g_floor_fast_rows_scratch = new_rows;
     g_floor_fast_rows_capacity = new_cap;
+    g_floor_fast_rows_gen = g_renderer_frame_arena.generation;
     return 1;
 }
 
 static int renderer_floor_fast_ensure_cols_capacity(int col_count)
 {
     int new_cap;
+    int16_t *bounds;
+    int *edges;
 
     if (col_count <= 0) return 0;
-    if (g_floor_fast_col_top_scratch &&
-        g_floor_fast_col_bot_scratch &&
-        g_floor_fast_next_top_scratch &&
-        g_floor_fast_next_bot_scratch &&
-        g_floor_fast_cov_diff_scratch &&
-        col_count <= g_floor_fast_col_capacity) {
+    if (g_floor_fast_col_top_scratch && col_count <= g_floor_fast_col_capacity &&
+        g_floor_fast_col_gen == g_renderer_frame_arena.generation) {
         return 1;
     }
 
-    new_cap = (g_floor_fast_col_capacity > 0) ? g_floor_fast_col_capacity : 64;
-    while (new_cap < col_count) {
-        if (new_cap > INT_MAX / 2) {
-            new_cap = col_count;
-            break;
-        }
-        new_cap *= 2;
-    }
-
-    {
-        int16_t *new_top = (int16_t *)realloc(g_floor_fast_col_top_scratch, (size_t)new_cap * sizeof(*new_top));
-        if (!new_top) return 0;
-        g_floor_fast_col_top_scratch = new_top;
-    }
-    {
-        int16_t *new_bot = (int16_t *)realloc(g_floor_fast_col_bot_scratch, (size_t)new_cap * sizeof(*new_bot));
-        if (!new_bot) return 0;
-        g_floor_fast_col_bot_scratch = new_bot;
-    }
-    {
-        int *new_next_top = (int *)realloc(g_floor_fast_next_top_scratch, (size_t)(new_cap + 1) * sizeof(*new_next_top));
-        if (!new_next_top) return 0;
-        g_floor_fast_next_top_scratch = new_next_top;
-    }
-    {
-        int *new_next_bot = (int *)realloc(g_floor_fast_next_bot_scratch, (size_t)(new_cap + 1) * sizeof(*new_next_bot));
-        if (!new_next_bot) return 0;
-        g_floor_fast_next_bot_scratch = new_next_bot;
-    }
-    {
-        int *new_cov_diff = (int *)realloc(g_floor_fast_cov_diff_scratch, (size_t)(new_cap + 1) * sizeof(*new_cov_diff));
-        if (!new_cov_diff) return 0;
-        g_floor_fast_cov_diff_scratch = new_cov_diff;
-    }
+    new_cap = renderer_scratch_grow_cap(g_floor_fast_col_capacity, col_count, 64);
+    bounds = (int16_t *)renderer_frame_arena_alloc((size_t)new_cap * 2u * sizeof(*bounds));
+    edges = (int *)renderer_frame_arena_alloc((size_t)(new_cap + 1) * 3u * sizeof(*edges));
+    if (!bounds || !edges) return 0;
 
+    g_floor_fast_col_top_scratch = bounds;
+    g_floor_fast_col_bot_scratch = bounds + new_cap;
+    g_floor_fast_next_top_scratch = edges;
+    g_floor_fast_next_bot_scratch = edges + (size_t)(new_cap + 1);
+    g_floor_fast_cov_diff_scratch = edges + (size_t)(new_cap + 1) * 2u;
     g_floor_fast_col_capacity = new_cap;
+    g_floor_fast_col_gen = g_renderer_frame_arena.generation;
     return 1;
 }
 
+/* Drop every arena-backed table pointer; called right before the owning
+ * thread releases its arena. */
 static void renderer_floor_fast_release_scratch(void)
 {
-    free(g_floor_fast_rows_scratch);
     g_floor_fast_rows_scratch = NULL;
-    g_floor_fast_rows_capacity = 0;
-
-    free(g_floor_fast_col_top_scratch);
     g_floor_fast_col_top_scratch = NULL;
-    free(g_floor_fast_col_bot_scratch);
     g_floor_fast_col_bot_scratch = NULL;
-    free(g_floor_fast_next_top_scratch);
     g_floor_fast_next_top_scratch = NULL;
-    free(g_floor_fast_next_bot_scratch);
     g_floor_fast_next_bot_scratch = NULL;
-    free(g_floor_fast_cov_diff_scratch);
     g_floor_fast_cov_diff_scratch = NULL;
+    g_viewer_floor_occlude_scratch = NULL;
+    g_poly_edge_left_scratch = NULL;
+    g_poly_edge_right_scratch = NULL;
+    g_poly_bright_left_scratch = NULL;
+    g_poly_bright_right_scratch = NULL;
+    g_poly_col_top_scratch = NULL;
+    g_poly_col_bot_scratch = NULL;
+    g_floor_fast_rows_capacity = 0;
     g_floor_fast_col_capacity = 0;
+    g_viewer_floor_occlude_capacity = 0;
+    g_poly_edge_h_capacity = 0;
+    g_poly_col_w_capacity = 0;
 }
 
 static void renderer_floor_fast_seed_rows(FloorRowFast *rows,
@@ -8126,6 +9912,11 @@ static void renderer_floor_fast_seed_rows(FloorRowFast *rows,
     }
 }
 
+/* Column-order floor fill. Stays scalar under every raster SIMD level: each
+ * row down the column has its own UV walk, mip texture, masks and palette
+ * LUT (FloorRowFast), so a 4-wide step would have to gather every operand
+ * from four structs and scatter the UVs back, costing more than the shift
+ * and mask it saves. The vector kernels run on the row spans instead. */
 static uint64_t renderer_draw_floor_fast_column(const RenderSliceContext *ctx,
                                                 FloorRowFast *rows,
                                                 const uint16_t *const *gour_cw_levels,
@@ -8183,7 +9974,7 @@ static uint64_t renderer_draw_floor_fast_column(const RenderSliceContext *ctx,
                         {
                             uint32_t u_fp = row->u_col;
                             uint32_t v_fp = row->v_col;
-                            uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                            uint8_t texel = row->tex[((u_fp >> 14) & row->tex_mask_u) | ((v_fp >> 6) & row->tex_mask_v)];
                             uint16_t out_cw = row->span_cw[texel];
 
                             buf[pix] = 1;
@@ -8215,7 +10006,7 @@ static uint64_t renderer_draw_floor_fast_column(const RenderSliceContext *ctx,
                             }
                             uint32_t u_fp = row->u_col;
                             uint32_t v_fp = row->v_col;
-                            uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                            uint8_t texel = row->tex[((u_fp >> 14) & row->tex_mask_u) | ((v_fp >> 6) & row->tex_mask_v)];
                             uint16_t out_cw = row->span_cw[texel];
 
                             if (run_start == -1) run_start = y;
@@ -8247,7 +10038,7 @@ static uint64_t renderer_draw_floor_fast_column(const RenderSliceContext *ctx,
                         {
                             uint32_t u_fp = row->u_col;
                             uint32_t v_fp = row->v_col;
-                            uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                            uint8_t texel = row->tex[((u_fp >> 14) & row->tex_mask_u) | ((v_fp >> 6) & row->tex_mask_v)];
                             uint16_t out_cw = row->span_cw[texel];
 
                             buf[pix] = 1;
@@ -8277,7 +10068,7 @@ static uint64_t renderer_draw_floor_fast_column(const RenderSliceContext *ctx,
                             }
                             uint32_t u_fp = row->u_col;
                             uint32_t v_fp = row->v_col;
-                            uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                            uint8_t texel = row->tex[((u_fp >> 14) & row->tex_mask_u) | ((v_fp >> 6) & row->tex_mask_v)];
                             uint16_t out_cw = row->span_cw[texel];
 
                             if (run_start == -1) run_start = y;
@@ -8311,7 +10102,7 @@ static uint64_t renderer_draw_floor_fast_column(const RenderSliceContext *ctx,
                         {
                             uint32_t u_fp = row->u_col;
                             uint32_t v_fp = row->v_col;
-                            uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                            uint8_t texel = row->tex[((u_fp >> 14) & row->tex_mask_u) | ((v_fp >> 6) & row->tex_mask_v)];
                             int level = (int)(row->bright_col_fp >> 16);
                             uint16_t out_cw;
                             uint32_t out_rgb;
@@ -8356,7 +10147,7 @@ static uint64_t renderer_draw_floor_fast_column(const RenderSliceContext *ctx,
                             }
                             uint32_t u_fp = row->u_col;
                             uint32_t v_fp = row->v_col;
-                            uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                            uint8_t texel = row->tex[((u_fp >> 14) & row->tex_mask_u) | ((v_fp >> 6) & row->tex_mask_v)];
                             int level = (int)(row->bright_col_fp >> 16);
                             uint16_t out_cw;
                             uint32_t out_rgb;
@@ -8401,7 +10192,7 @@ static uint64_t renderer_draw_floor_fast_column(const RenderSliceContext *ctx,
                         {
                             uint32_t u_fp = row->u_col;
                             uint32_t v_fp = row->v_col;
-                            uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                            uint8_t texel = row->tex[((u_fp >> 14) & row->tex_mask_u) | ((v_fp >> 6) & row->tex_mask_v)];
                             int level = (int)(row->bright_col_fp >> 16);
                             uint16_t out_cw;
 
@@ -8441,7 +10232,7 @@ static uint64_t renderer_draw_floor_fast_column(const RenderSliceContext *ctx,
                             }
                             uint32_t u_fp = row->u_col;
                             uint32_t v_fp = row->v_col;
-                            uint8_t texel = texture[((u_fp >> 14) & 0xFCu) | ((v_fp >> 6) & 0xFC00u)];
+                            uint8_t texel = row->tex[((u_fp >> 14) & row->tex_mask_u) | ((v_fp >> 6) & row->tex_mask_v)];
                             int level = (int)(row->bright_col_fp >> 16);
                             uint16_t out_cw;
 
@@ -8513,7 +10304,7 @@ static int renderer_draw_floor_columns_ctx_fast(RenderSliceContext *ctx,
     uint32_t *rgb = renderer_active_rgb();
     uint16_t *cwbuf = renderer_active_cw();
     if (!ctx || !left_edge || !right_edge_tab || !texture || !floor_pal) return 0;
-    if (!buf || !rgb || !cwbuf) return 0;
+    if (!buf || !renderer_rgb_target_ok(rgb) || !cwbuf) return 0;
 
     const int w = rs->width;
     const int h = rs->height;
@@ -8611,6 +10402,8 @@ static int renderer_draw_floor_columns_ctx_fast(RenderSliceContext *ctx,
                 row->span_rgb = NULL;
                 row->bright_base_fp = gour_level_fp;
                 row->bright_step_fp = gour_level_step;
+                row->tex = floor_mip_select(texture, row_math.u_step, row_math.v_step,
+                                            &row->tex_mask_u, &row->tex_mask_v);
             }
         } else {
             for (int y = y0; y <= y1; y++) {
@@ -8644,6 +10437,8 @@ static int renderer_draw_floor_columns_ctx_fast(RenderSliceContext *ctx,
                 row->v_base = row_math.v_base;
                 row->span_cw = gour_cw_levels[floor_pal_level];
                 row->span_rgb = expand ? gour_rgb_levels[floor_pal_level] : NULL;
+                row->tex = floor_mip_select(texture, row_math.u_step, row_math.v_step,
+                                            &row->tex_mask_u, &row->tex_mask_v);
             }
         }
 
@@ -8873,6 +10668,129 @@ static int renderer_draw_floor_columns_ctx_fast(RenderSliceContext *ctx,
  *
  * Uses painter's algorithm (drawn back-to-front by zone order).
  * ----------------------------------------------------------------------- */
+/* One visible row interval of a sprite column, for the span kernels below. */
+typedef struct {
+    uint32_t *rgb;
+    uint16_t *cw;
+    uint16_t *pick_zone;
+    const int *row_src;            /* source row per screen row, from col_top */
+    const uint8_t *col_texel_lut;  /* decoded column texels (texel-LUT variants) */
+    const uint8_t *src_base;       /* packed column words (decode variants) */
+    const uint16_t *spr_cw;
+    const uint32_t *spr_rgb;
+    size_t pix;
+    size_t pix_cw;
+    size_t rw_stride;
+    size_t cw_step_y;
+    int rows;
+    int max_src_row;
+    int texel_shift;
+} RendererSpriteSpan;
+
+/* Returns the number of opaque texels written. */
+typedef uint32_t (*RendererSpriteSpanFn)(const RendererSpriteSpan *s);
+
+/* Template for the sprite span kernels. Every flag is a literal at each
+ * instantiation, so the generated loops carry no per-pixel branches for the
+ * RGB plane, the source-row bound, the texel source or the F2/spill pick
+ * marking. */
+static AB3D_FORCE_INLINE uint32_t renderer_sprite_span_impl(const RendererSpriteSpan *s,
+                                                            const int expand,
+                                                            const int texel_lut,
+                                                            const int row_bounds,
+                                                            const int mark_pick)
+{
+    uint32_t * AB3D_RESTRICT rgb = s->rgb;
+    uint16_t * AB3D_RESTRICT cw = s->cw;
+    uint16_t *pick_zone = s->pick_zone;
+    const int *row_src = s->row_src;
+    const uint8_t *col_texel_lut = s->col_texel_lut;
+    const uint8_t *src_base = s->src_base;
+    const uint16_t *spr_cw = s->spr_cw;
+    const uint32_t *spr_rgb = s->spr_rgb;
+    const size_t rw_stride = s->rw_stride;
+    const size_t cw_step_y = s->cw_step_y;
+    const int max_src_row = s->max_src_row;
+    const int texel_shift = s->texel_shift;
+    size_t pix = s->pix;
+    size_t pix_cw = s->pix_cw;
+    uint32_t written = 0;
+
+    for (int r = 0; r < s->rows; r++) {
+        const int src_row = row_src[r];
+        if (!row_bounds || src_row <= max_src_row) {
+            uint8_t texel;
+            if (texel_lut) {
+                texel = col_texel_lut[src_row];
+            } else {
+                const int src_byte = src_row << 1;
+                const uint16_t w = (uint16_t)((src_base[src_byte] << 8) | src_base[src_byte + 1]);
+                texel = (uint8_t)((w >> texel_shift) & 0x1F);
+            }
+            if (texel != 0) {
+                written++;
+                if (expand) rgb[pix] = spr_rgb[texel];
+                cw[pix_cw] = spr_cw[texel];
+                if (mark_pick) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
+            }
+        }
+        pix += rw_stride;
+        pix_cw += cw_step_y;
+    }
+    return written;
+}
+
+#define RENDERER_SPRITE_SPAN_VARIANT(E_, L_, B_, P_) \
+    static uint32_t renderer_sprite_span_##E_##L_##B_##P_(const RendererSpriteSpan *s) \
+    { \
+        return renderer_sprite_span_impl(s, E_, L_, B_, P_); \
+    }
+RENDERER_SPRITE_SPAN_VARIANT(0, 0, 0, 0)
+RENDERER_SPRITE_SPAN_VARIANT(0, 0, 1, 0)
+RENDERER_SPRITE_SPAN_VARIANT(0, 1, 0, 0)
+RENDERER_SPRITE_SPAN_VARIANT(0, 1, 1, 0)
+RENDERER_SPRITE_SPAN_VARIANT(0, 0, 0, 1)
+RENDERER_SPRITE_SPAN_VARIANT(0, 0, 1, 1)
+RENDERER_SPRITE_SPAN_VARIANT(0, 1, 0, 1)
+RENDERER_SPRITE_SPAN_VARIANT(0, 1, 1, 1)
+RENDERER_SPRITE_SPAN_VARIANT(1, 0, 0, 0)
+RENDERER_SPRITE_SPAN_VARIANT(1, 0, 1, 0)
+RENDERER_SPRITE_SPAN_VARIANT(1, 1, 0, 0)
+RENDERER_SPRITE_SPAN_VARIANT(1, 1, 1, 0)
+RENDERER_SPRITE_SPAN_VARIANT(1, 0, 0, 1)
+RENDERER_SPRITE_SPAN_VARIANT(1, 0, 1, 1)
+RENDERER_SPRITE_SPAN_VARIANT(1, 1, 0, 1)
+RENDERER_SPRITE_SPAN_VARIANT(1, 1, 1, 1)
+#undef RENDERER_SPRITE_SPAN_VARIANT
+
+/* [expand][mark_pick][texel_lut << 1 | row_bounds] */
+static const RendererSpriteSpanFn g_sprite_span_kernels[2][2][4] = {
+    {
+        { renderer_sprite_span_0000, renderer_sprite_span_0010,
+          renderer_sprite_span_0100, renderer_sprite_span_0110 },
+        { renderer_sprite_span_0001, renderer_sprite_span_0011,
+          renderer_sprite_span_0101, renderer_sprite_span_0111 },
+    },
+    {
+        { renderer_sprite_span_1000, renderer_sprite_span_1010,
+          renderer_sprite_span_1100, renderer_sprite_span_1110 },
+        { renderer_sprite_span_1001, renderer_sprite_span_1011,
+          renderer_sprite_span_1101, renderer_sprite_span_1111 },
+    },
+};
+
+/* Kernel set for the current frame (renderer_select_raster_kernels). */
+static const RendererSpriteSpanFn *g_sprite_span_kernel_set = g_sprite_span_kernels[0][0];
+
+/* Pick this frame's specialized kernels from the output and debug state;
+ * renderer_draw_display calls it once the pick capture flags are settled. */
+static void renderer_select_raster_kernels(void)
+{
+    const int expand = g_renderer_rgb_raster_expand ? 1 : 0;
+    const int mark_pick = (g_debug_spill_visualize && renderer_active_pick_zone()) ? 1 : 0;
+    g_sprite_span_kernel_set = g_sprite_span_kernels[expand][mark_pick];
+}
+
 static void renderer_draw_sprite_ctx(RenderSliceContext *ctx,
                                      int16_t screen_x, int16_t screen_y,
                                      int16_t width, int16_t height, int16_t z,
@@ -8900,7 +10818,7 @@ static void renderer_draw_sprite_ctx(RenderSliceContext *ctx,
     uint32_t *rgb = renderer_active_rgb();
     uint16_t *cw = renderer_active_cw();
     if (!ctx) return;
-    if (!rgb || !cw) return;
+    if (!renderer_rgb_target_ok(rgb) || !cw) return;
     if (z <= SPRITE_NEAR_CLIP_Z) return;
     if (!wad || !ptr_data) return;
     const int rw = g_renderer.width, rh = g_renderer.height;
@@ -8973,6 +10891,22 @@ static void renderer_draw_sprite_ctx(RenderSliceContext *ctx,
         ctx->workload_stats.sprite_columns += (uint64_t)(dx_end - dx_start);
     }
 
+    /* Spill sprites are depth-tested against the wall spans per column; settle
+     * the whole rect from the tile summary first (fully behind a wall: done;
+     * in front of every span: skip the per-column occluder search). */
+    int clip_rect_class = RENDERER_CLIP_RECT_MIXED;
+    if (is_spill) {
+        clip_rect_class = renderer_column_clip_classify_rect(col_start, col_end - 1,
+                                                             draw_top, draw_bot, (int32_t)z);
+        if (clip_rect_class == RENDERER_CLIP_RECT_HIDDEN) {
+            if (profile_collect_stats) {
+                ctx->workload_stats.sprite_pixels_wall_occluded +=
+                    (uint64_t)(dx_end - dx_start) * (uint64_t)draw_row_count;
+            }
+            return;
+        }
+    }
+
     /* --- Pre-build 32-entry palette LUT for this brightness level ---
      * Replaces per-pixel palette byte reads, c12 construction, and
      * amiga12_to_argb conversion with a single indexed load. */
@@ -9023,6 +10957,16 @@ static void renderer_draw_sprite_ctx(RenderSliceContext *ctx,
     const int mark_sprite_pick_zone_none = (g_debug_spill_visualize && pick_zone) ? 1 : 0;
     const int fast_common_no_spill =
         (!have_pick) ? 1 : 0;
+    const RendererSpriteSpanFn *span_kernels =
+        pick_zone ? g_sprite_span_kernel_set : g_sprite_span_kernels[expand][0];
+    RendererSpriteSpan span;
+    span.rgb = rgb;
+    span.cw = cw;
+    span.pick_zone = pick_zone;
+    span.spr_cw = spr_cw;
+    span.spr_rgb = spr_rgb;
+    span.rw_stride = rw_stride;
+    span.cw_step_y = cw_step_y;
     const int have_geometric_zone_clip = 0;
     int geom_dx_starts[RENDERER_GEOM_CLIP_MAX_SPANS];
     int geom_dx_ends[RENDERER_GEOM_CLIP_MAX_SPANS];
@@ -9234,7 +11178,7 @@ static void renderer_draw_sprite_ctx(RenderSliceContext *ctx,
          * in other zones get merged (min-z), which incorrectly occludes local
          * sprites that are in front of the real wall. */
         int seg_top[3], seg_bot[3], seg_count;
-        if (!is_spill) {
+        if (!is_spill || clip_rect_class == RENDERER_CLIP_RECT_CLEAR) {
             seg_top[0] = draw_top;
             seg_bot[0] = draw_bot;
             seg_count = 1;
@@ -9322,197 +11266,50 @@ static void renderer_draw_sprite_ctx(RenderSliceContext *ctx,
         }
         if (seg_count <= 0) continue;
 
-        /* Rasterize all visible intervals for this column. */
-        if (expand) {
-            for (int si = 0; si < seg_count; si++) {
-                int col_top = seg_top[si];
-                int col_bot = seg_bot[si];
-                if (col_top > col_bot) continue;
-                int row_lut_idx = col_top - draw_top;
-                size_t pix = (size_t)col_top * rw_stride + (size_t)screen_col;
-                size_t pix_cw = renderer_cw_index_xy(screen_col, col_top, rw, rh);
-                if (fast_common_no_spill) {
-                    const int *row_src_ptr = row_src_lut + row_lut_idx;
-                    if (!need_src_row_bounds) {
-                        if (use_col_texel_lut) {
-                            for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
-                                const int src_row = *row_src_ptr++;
-                                const uint8_t texel = col_texel_lut[src_row];
-                                if (texel != 0) {
-                                    if (profile_collect_stats) sprite_opaque_writes_total++;
-                                    rgb[pix] = spr_rgb[texel];
-                                    cw[pix_cw] = spr_cw[texel];
-                                    if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
-                                }
-                                pix += rw_stride;
-                                pix_cw += cw_step_y;
-                            }
-                        } else {
-                            for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
-                                const int src_row = *row_src_ptr++;
-                                const int src_byte = src_row << 1;
-                                const uint16_t w = (uint16_t)((src_base[src_byte] << 8) | src_base[src_byte + 1]);
-                                const uint8_t texel = (uint8_t)((w >> texel_shift) & 0x1F);
-                                if (texel != 0) {
-                                    if (profile_collect_stats) sprite_opaque_writes_total++;
-                                    rgb[pix] = spr_rgb[texel];
-                                    cw[pix_cw] = spr_cw[texel];
-                                    if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
-                                }
-                                pix += rw_stride;
-                                pix_cw += cw_step_y;
-                            }
-                        }
-                    } else {
-                        if (use_col_texel_lut) {
-                            for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
-                                const int src_row = *row_src_ptr++;
-                                if (src_row <= max_src_row_col) {
-                                    const uint8_t texel = col_texel_lut[src_row];
-                                    if (texel != 0) {
-                                        if (profile_collect_stats) sprite_opaque_writes_total++;
-                                        rgb[pix] = spr_rgb[texel];
-                                        cw[pix_cw] = spr_cw[texel];
-                                        if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
-                                    }
-                                }
-                                pix += rw_stride;
-                                pix_cw += cw_step_y;
-                            }
-                        } else {
-                            for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
-                                const int src_row = *row_src_ptr++;
-                                if (src_row <= max_src_row_col) {
-                                    const int src_byte = src_row << 1;
-                                    const uint16_t w = (uint16_t)((src_base[src_byte] << 8) | src_base[src_byte + 1]);
-                                    const uint8_t texel = (uint8_t)((w >> texel_shift) & 0x1F);
-                                    if (texel != 0) {
-                                        if (profile_collect_stats) sprite_opaque_writes_total++;
-                                        rgb[pix] = spr_rgb[texel];
-                                        cw[pix_cw] = spr_cw[texel];
-                                        if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
-                                    }
-                                }
-                                pix += rw_stride;
-                                pix_cw += cw_step_y;
-                            }
-                        }
-                    }
-                } else {
-                    for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
-                        const int src_row = row_src_lut[row_lut_idx];
-                        if (have_pick) pick_player[pix] = pick_player_id;
-                        if (!need_src_row_bounds || src_row <= max_src_row_col) {
-                            const int src_byte = src_row << 1;
-                            const uint16_t w = (uint16_t)((src_base[src_byte] << 8) | src_base[src_byte + 1]);
-                            const uint8_t texel = (uint8_t)((w >> texel_shift) & 0x1F);
-                            if (texel != 0) {
-                                if (profile_collect_stats) sprite_opaque_writes_total++;
-                                if (spill_visualize) {
-                                    rgb[pix] = spill_vis_rgb;
-                                    cw[pix_cw] = spill_vis_cw;
-                                } else {
-                                    rgb[pix] = spr_rgb[texel];
-                                    cw[pix_cw] = spr_cw[texel];
-                                }
-                                if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
-                            }
-                        }
-                        pix += rw_stride;
-                        pix_cw += cw_step_y;
-                        row_lut_idx++;
-                    }
-                }
-            }
-        } else {
-            for (int si = 0; si < seg_count; si++) {
-                int col_top = seg_top[si];
-                int col_bot = seg_bot[si];
-                if (col_top > col_bot) continue;
-                int row_lut_idx = col_top - draw_top;
-                size_t pix = (size_t)col_top * rw_stride + (size_t)screen_col;
-                size_t pix_cw = renderer_cw_index_xy(screen_col, col_top, rw, rh);
-                if (fast_common_no_spill) {
-                    const int *row_src_ptr = row_src_lut + row_lut_idx;
-                    if (!need_src_row_bounds) {
-                        if (use_col_texel_lut) {
-                            for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
-                                const int src_row = *row_src_ptr++;
-                                const uint8_t texel = col_texel_lut[src_row];
-                                if (texel != 0) {
-                                    if (profile_collect_stats) sprite_opaque_writes_total++;
-                                    cw[pix_cw] = spr_cw[texel];
-                                    if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
-                                }
-                                pix += rw_stride;
-                                pix_cw += cw_step_y;
-                            }
-                        } else {
-                            for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
-                                const int src_row = *row_src_ptr++;
-                                const int src_byte = src_row << 1;
-                                const uint16_t w = (uint16_t)((src_base[src_byte] << 8) | src_base[src_byte + 1]);
-                                const uint8_t texel = (uint8_t)((w >> texel_shift) & 0x1F);
-                                if (texel != 0) {
-                                    if (profile_collect_stats) sprite_opaque_writes_total++;
-                                    cw[pix_cw] = spr_cw[texel];
-                                    if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
-                                }
-                                pix += rw_stride;
-                                pix_cw += cw_step_y;
-                            }
-                        }
-                    } else {
-                        if (use_col_texel_lut) {
-                            for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
-                                const int src_row = *row_src_ptr++;
-                                if (src_row <= max_src_row_col) {
-                                    const uint8_t texel = col_texel_lut[src_row];
-                                    if (texel != 0) {
-                                        if (profile_collect_stats) sprite_opaque_writes_total++;
-                                        cw[pix_cw] = spr_cw[texel];
-                                        if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
-                                    }
-                                }
-                                pix += rw_stride;
-                                pix_cw += cw_step_y;
-                            }
-                        } else {
-                            for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
-                                const int src_row = *row_src_ptr++;
-                                if (src_row <= max_src_row_col) {
-                                    const int src_byte = src_row << 1;
-                                    const uint16_t w = (uint16_t)((src_base[src_byte] << 8) | src_base[src_byte + 1]);
-                                    const uint8_t texel = (uint8_t)((w >> texel_shift) & 0x1F);
-                                    if (texel != 0) {
-                                        if (profile_collect_stats) sprite_opaque_writes_total++;
-                                        cw[pix_cw] = spr_cw[texel];
-                                        if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
-                                    }
-                                }
-                                pix += rw_stride;
-                                pix_cw += cw_step_y;
-                            }
-                        }
-                    }
-                } else {
-                    for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
-                        const int src_row = row_src_lut[row_lut_idx];
-                        if (have_pick) pick_player[pix] = pick_player_id;
-                        if (!need_src_row_bounds || src_row <= max_src_row_col) {
-                            const int src_byte = src_row << 1;
-                            const uint16_t w = (uint16_t)((src_base[src_byte] << 8) | src_base[src_byte + 1]);
-                            const uint8_t texel = (uint8_t)((w >> texel_shift) & 0x1F);
-                            if (texel != 0) {
-                                if (profile_collect_stats) sprite_opaque_writes_total++;
-                                cw[pix_cw] = spill_visualize ? spill_vis_cw : spr_cw[texel];
-                                if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
+        /* Rasterize all visible intervals for this column. Common case: the
+         * frame's specialized span kernel; pick-player capture and spill
+         * visualization take the generic loop. */
+        span.col_texel_lut = col_texel_lut;
+        span.src_base = src_base;
+        span.max_src_row = max_src_row_col;
+        span.texel_shift = texel_shift;
+        for (int si = 0; si < seg_count; si++) {
+            int col_top = seg_top[si];
+            int col_bot = seg_bot[si];
+            if (col_top > col_bot) continue;
+            int row_lut_idx = col_top - draw_top;
+            size_t pix = (size_t)col_top * rw_stride + (size_t)screen_col;
+            size_t pix_cw = renderer_cw_index_xy(screen_col, col_top, rw, rh);
+            if (fast_common_no_spill) {
+                span.row_src = row_src_lut + row_lut_idx;
+                span.pix = pix;
+                span.pix_cw = pix_cw;
+                span.rows = col_bot - col_top + 1;
+                uint32_t written = span_kernels[(use_col_texel_lut << 1) | need_src_row_bounds](&span);
+                if (profile_collect_stats) sprite_opaque_writes_total += written;
+            } else {
+                for (int screen_row = col_top; screen_row <= col_bot; screen_row++) {
+                    const int src_row = row_src_lut[row_lut_idx];
+                    if (have_pick) pick_player[pix] = pick_player_id;
+                    if (!need_src_row_bounds || src_row <= max_src_row_col) {
+                        const int src_byte = src_row << 1;
+                        const uint16_t w = (uint16_t)((src_base[src_byte] << 8) | src_base[src_byte + 1]);
+                        const uint8_t texel = (uint8_t)((w >> texel_shift) & 0x1F);
+                        if (texel != 0) {
+                            if (profile_collect_stats) sprite_opaque_writes_total++;
+                            if (spill_visualize) {
+                                if (expand) rgb[pix] = spill_vis_rgb;
+                                cw[pix_cw] = spill_vis_cw;
+                            } else {
+                                if (expand) rgb[pix] = spr_rgb[texel];
+                                cw[pix_cw] = spr_cw[texel];
                             }
+                            if (mark_sprite_pick_zone_none) pick_zone[pix] = RENDERER_PICK_ZONE_NONE;
                         }
-                        pix += rw_stride;
-                        pix_cw += cw_step_y;
-                        row_lut_idx++;
                     }
+                    pix += rw_stride;
+                    pix_cw += cw_step_y;
+                    row_lut_idx++;
                 }
             }
         }
@@ -9635,7 +11432,7 @@ static void renderer_draw_gun_columns(GameState *state, int col_start, int col_e
     uint8_t *buf = renderer_active_buf();
     uint32_t *rgb = renderer_active_rgb();
     uint16_t *cw = renderer_active_cw();
-    if (!buf || !rgb || !cw) return;
+    if (!buf || !renderer_rgb_target_ok(rgb) || !cw) return;
     if (!state) return;
 
     int rw = g_renderer.width, rh = g_renderer.height;
@@ -10669,36 +12466,7 @@ static int renderer_billboard_lateral_hits_adj_lines(const LevelState *level,
 }
 
 #define RENDERER_PORTAL_CROSS_LINE_CAP 64
-#define RENDERER_PORTAL_LINE_CACHE_SIZE 128u
-
-typedef struct {
-    const LevelState *level;
-    const uint8_t *data;
-    const uint8_t *zone_adds;
-    const uint8_t *floor_lines;
-    int32_t num_floor_lines;
-    int16_t zone_a;
-    int16_t zone_b;
-    uint8_t valid;
-    uint8_t line_count;
-    int16_t lines[RENDERER_PORTAL_CROSS_LINE_CAP];
-} RendererPortalLineCacheEntry;
-
-static AB3D_THREAD_LOCAL RendererPortalLineCacheEntry
-    g_renderer_portal_line_cache[RENDERER_PORTAL_LINE_CACHE_SIZE];
-
-static inline unsigned renderer_portal_line_cache_slot(const LevelState *level,
-                                                       int16_t zone_a,
-                                                       int16_t zone_b)
-{
-    uintptr_t k = (uintptr_t)level;
-    k ^= (uintptr_t)((uint32_t)(uint16_t)zone_a * 0x9E3779B1u);
-    k ^= (uintptr_t)((uint32_t)(uint16_t)zone_b * 0x85EBCA6Bu);
-    k ^= (k >> 11);
-    return (unsigned)(k & (RENDERER_PORTAL_LINE_CACHE_SIZE - 1u));
-}
-
-static int renderer_collect_shared_portal_lines_uncached(const LevelState *level,
+static int renderer_collect_shared_portal_lines(const LevelState *level,
                                                          int16_t zone_a,
                                                          int16_t zone_b,
                                                          int16_t *out_lines,
@@ -10714,6 +12482,27 @@ static int renderer_collect_shared_portal_lines_uncached(const LevelState *level
     for (int pass = 0; pass < 2 && line_count < max_lines; pass++) {
         int16_t src_zone = (pass == 0) ? zone_a : zone_b;
         int16_t dst_zone = (pass == 0) ? zone_b : zone_a;
+        const LevelDecoded *d = level->decoded;
+
+        if (d && src_zone >= 0 && src_zone < d->num_zone_slots && d->zone_off[src_zone] >= 0) {
+            for (int32_t i = d->zone_exit_first[src_zone];
+                 i < d->zone_exit_first[src_zone + 1] && line_count < max_lines; i++) {
+                int16_t entry = d->zone_exits[i];
+                int dup = 0;
+                if (entry < 0) break;
+                if ((int32_t)entry >= d->num_floor_lines) continue;
+                if (d->line_connect_zone[entry] != dst_zone) continue;
+                for (int j = 0; j < line_count; j++) {
+                    if (out_lines[j] == entry) {
+                        dup = 1;
+                        break;
+                    }
+                }
+                if (!dup) out_lines[line_count++] = entry;
+            }
+            continue;
+        }
+
         int32_t zone_off = rd32(level->zone_adds + (size_t)(uint16_t)src_zone * 4u);
 
         if (zone_off < 0) continue;
@@ -10766,9 +12555,6 @@ static int renderer_get_shared_portal_lines(const LevelState *level,
 {
     int16_t zone_a = from_zone;
     int16_t zone_b = to_zone;
-    int line_count = 0;
-    unsigned slot;
-    RendererPortalLineCacheEntry *entry;
 
     if (!out_lines || max_lines <= 0) return 0;
     if (!level || !level->data || !level->zone_adds || !level->floor_lines) return 0;
@@ -10778,44 +12564,8 @@ static int renderer_get_shared_portal_lines(const LevelState *level,
         zone_a = zone_b;
         zone_b = t;
     }
-
-    slot = renderer_portal_line_cache_slot(level, zone_a, zone_b);
-    entry = &g_renderer_portal_line_cache[slot];
-
-    if (entry->valid &&
-        entry->level == level &&
-        entry->data == level->data &&
-        entry->zone_adds == level->zone_adds &&
-        entry->floor_lines == level->floor_lines &&
-        entry->num_floor_lines == level->num_floor_lines &&
-        entry->zone_a == zone_a &&
-        entry->zone_b == zone_b) {
-        line_count = (int)entry->line_count;
-    } else {
-        line_count = renderer_collect_shared_portal_lines_uncached(level,
-                                                                   zone_a,
-                                                                   zone_b,
-                                                                   entry->lines,
-                                                                   RENDERER_PORTAL_CROSS_LINE_CAP);
-        if (line_count < 0) line_count = 0;
-        if (line_count > RENDERER_PORTAL_CROSS_LINE_CAP)
-            line_count = RENDERER_PORTAL_CROSS_LINE_CAP;
-
-        entry->level = level;
-        entry->data = level->data;
-        entry->zone_adds = level->zone_adds;
-        entry->floor_lines = level->floor_lines;
-        entry->num_floor_lines = level->num_floor_lines;
-        entry->zone_a = zone_a;
-        entry->zone_b = zone_b;
-        entry->line_count = (uint8_t)line_count;
-        entry->valid = 1;
-    }
-
-    if (line_count > max_lines) line_count = max_lines;
-    if (line_count > 0)
-        memcpy(out_lines, entry->lines, (size_t)line_count * sizeof(*out_lines));
-    return line_count;
+    if (max_lines > RENDERER_PORTAL_CROSS_LINE_CAP) max_lines = RENDERER_PORTAL_CROSS_LINE_CAP;
+    return renderer_collect_shared_portal_lines(level, zone_a, zone_b, out_lines, max_lines);
 }
 
 /* Returns 1 if the billboard lateral segment crosses any boundary line shared
@@ -11175,32 +12925,6 @@ static int renderer_zone_list_contains(const int16_t *zones, int count, int16_t
     return 0;
 }
 
-#define RENDERER_CONNECTED_ZONE_CACHE_SIZE 128u
-
-typedef struct {
-    const LevelState *level;
-    const uint8_t *data;
-    const uint8_t *zone_adds;
-    const uint8_t *floor_lines;
-    int32_t num_floor_lines;
-    int16_t zone_id;
-    uint8_t valid;
-    uint8_t count;
-    int16_t zones[RENDERER_SPILL_SEARCH_MAX_NEIGHBORS];
-} RendererConnectedZoneCacheEntry;
-
-static AB3D_THREAD_LOCAL RendererConnectedZoneCacheEntry
-    g_renderer_connected_zone_cache[RENDERER_CONNECTED_ZONE_CACHE_SIZE];
-
-static inline unsigned renderer_connected_zone_cache_slot(const LevelState *level,
-                                                          int16_t zone_id)
-{
-    uintptr_t k = (uintptr_t)level;
-    k ^= (uintptr_t)((uint32_t)(uint16_t)zone_id * 0x9E3779B1u);
-    k ^= (k >> 9);
-    return (unsigned)(k & (RENDERER_CONNECTED_ZONE_CACHE_SIZE - 1u));
-}
-
 static int renderer_collect_connected_zones_fast(const LevelState *level,
                                                  int16_t zone_id,
                                                  int16_t *out_zones,
@@ -11209,35 +12933,22 @@ static int renderer_collect_connected_zones_fast(const LevelState *level,
     const uint8_t *exit_list;
     int zone_slots;
     int out_count = 0;
-    int cacheable;
-    unsigned cache_slot = 0;
-    RendererConnectedZoneCacheEntry *cache_entry = NULL;
 
     if (!level || !out_zones || max_zones <= 0 || !level->floor_lines) return 0;
 
-    cacheable = (max_zones >= RENDERER_SPILL_SEARCH_MAX_NEIGHBORS) ? 1 : 0;
-    if (cacheable) {
-        cache_slot = renderer_connected_zone_cache_slot(level, zone_id);
-        cache_entry = &g_renderer_connected_zone_cache[cache_slot];
-
-        if (cache_entry->valid &&
-            cache_entry->level == level &&
-            cache_entry->data == level->data &&
-            cache_entry->zone_adds == level->zone_adds &&
-            cache_entry->floor_lines == level->floor_lines &&
-            cache_entry->num_floor_lines == level->num_floor_lines &&
-            cache_entry->zone_id == zone_id) {
-            out_count = (int)cache_entry->count;
-            if (out_count > max_zones) out_count = max_zones;
-            if (out_count > 0)
-                memcpy(out_zones, cache_entry->zones, (size_t)out_count * sizeof(*out_zones));
-            return out_count;
-        }
-    }
-
     zone_slots = level_zone_slot_count(level);
     if (zone_slots <= 0 || zone_id < 0 || zone_id >= zone_slots) return 0;
 
+    if (level->decoded && zone_id < level->decoded->num_zone_slots) {
+        const LevelDecoded *d = level->decoded;
+        out_count = (int)(d->zone_neighbor_first[zone_id + 1] - d->zone_neighbor_first[zone_id]);
+        if (out_count > max_zones) out_count = max_zones;
+        if (out_count > 0)
+            memcpy(out_zones, d->zone_neighbors + d->zone_neighbor_first[zone_id],
+                   (size_t)out_count * sizeof(*out_zones));
+        return out_count;
+    }
+
     exit_list = renderer_zone_exit_list_ptr(level, zone_id);
     if (!exit_list) return 0;
 
@@ -11288,24 +12999,6 @@ static int renderer_collect_connected_zones_fast(const LevelState *level,
         out_zones[out_count++] = (int16_t)src_zone;
     }
 
-    if (cacheable && cache_entry) {
-        int cached_count = out_count;
-        if (cached_count < 0) cached_count = 0;
-        if (cached_count > RENDERER_SPILL_SEARCH_MAX_NEIGHBORS)
-            cached_count = RENDERER_SPILL_SEARCH_MAX_NEIGHBORS;
-
-        if (cached_count > 0)
-            memcpy(cache_entry->zones, out_zones, (size_t)cached_count * sizeof(*cache_entry->zones));
-        cache_entry->level = level;
-        cache_entry->data = level->data;
-        cache_entry->zone_adds = level->zone_adds;
-        cache_entry->floor_lines = level->floor_lines;
-        cache_entry->num_floor_lines = level->num_floor_lines;
-        cache_entry->zone_id = zone_id;
-        cache_entry->count = (uint8_t)cached_count;
-        cache_entry->valid = 1;
-    }
-
     return out_count;
 }
 
@@ -11918,90 +13611,303 @@ static int renderer_resolve_sprite_zone_draw_clip(const RenderSliceContext *ctx,
     if (!ctx || !state || !out_left || !out_right || !out_top_world || !out_bot_world || !out_ignore_top)
         return 0;
 
-    LevelState *level = &state->level;
-    int zone_slots = level_zone_slot_count(level);
-    if (!level->data || !level->zone_adds || zone_slots <= 0 || zone_id < 0 || zone_id >= zone_slots)
-        return 0;
+    LevelState *level = &state->level;
+    int zone_slots = level_zone_slot_count(level);
+    if (!level->data || !level->zone_adds || zone_slots <= 0 || zone_id < 0 || zone_id >= zone_slots)
+        return 0;
+
+    int16_t draw_left = ctx->left_clip;
+    int16_t draw_right = ctx->right_clip;
+    if (draw_left >= draw_right) return 0;
+
+    int32_t zone_roof = section_top_world;
+    int32_t zone_floor = section_bot_world;
+    if (zone_roof > zone_floor) {
+        int32_t t = zone_roof;
+        zone_roof = zone_floor;
+        zone_floor = t;
+    }
+
+    *out_left = draw_left;
+    *out_right = draw_right;
+    *out_top_world = zone_roof;
+    *out_bot_world = zone_floor;
+    *out_ignore_top = ignore_sky_top_clip ? 1 : 0;
+    return 1;
+}
+
+static void renderer_get_explosion_frame_and_world_size(const GameState *state,
+                                                        int explosion_index,
+                                                        int *out_frame_num,
+                                                        int *out_world_w,
+                                                        int *out_world_h)
+{
+    int frame_num = 0;
+    int expl_w = 100;
+    int expl_h = 100;
+    int scale = 100;
+    int ft_count = sprite_frames_table[8].count;
+    if (ft_count < 1) ft_count = 1;
+
+    if (state && explosion_index >= 0 && explosion_index < state->num_explosions) {
+        scale = (int)state->explosions[explosion_index].size_scale;
+        if (scale <= 0) scale = 100;
+
+        frame_num = (int)state->explosions[explosion_index].frame;
+        if (frame_num < 0) frame_num = 0;
+        if (frame_num >= ft_count) frame_num = ft_count - 1;
+
+        if (bullet_pop_tables[2]) {
+            const BulletAnimFrame *pf = &bullet_pop_tables[2][frame_num];
+            if (pf->width > 0 && pf->height > 0) {
+                expl_w = pf->width;
+                expl_h = pf->height;
+            }
+        }
+    }
+
+    expl_w = (expl_w * scale) / 100;
+    expl_h = (expl_h * scale) / 100;
+    if (expl_w < 1) expl_w = 1;
+    if (expl_h < 1) expl_h = 1;
+
+    if (out_frame_num) *out_frame_num = frame_num;
+    if (out_world_w) *out_world_w = expl_w;
+    if (out_world_h) *out_world_h = expl_h;
+}
+
+static void renderer_project_zone_world_clip_y(const RendererState *r,
+                                               int32_t zone_top_world,
+                                               int32_t zone_bot_world,
+                                               int32_t y_off,
+                                               int32_t z_fp,
+                                               int ignore_top_clip,
+                                               int32_t *out_top_y,
+                                               int32_t *out_bot_y)
+{
+    int32_t z = (z_fp > 0) ? z_fp : 1;
+    int center_y = r->height / 2;
+    if (ignore_top_clip) {
+        *out_top_y = INT32_MIN;
+    } else {
+        *out_top_y = (int)(((int64_t)((zone_top_world - y_off) >> WORLD_Y_FRAC_BITS) *
+                            (int64_t)r->proj_y_scale * (int64_t)RENDER_SCALE << ROT_Z_FRAC_BITS) / z) + center_y;
+    }
+    *out_bot_y = (int)(((int64_t)((zone_bot_world - y_off) >> WORLD_Y_FRAC_BITS) *
+                        (int64_t)r->proj_y_scale * (int64_t)RENDER_SCALE << ROT_Z_FRAC_BITS) / z) + center_y;
+}
+
+/* -----------------------------------------------------------------------
+ * Frame sprite candidate list
+ *
+ * Everything in the per-zone object scan that does not depend on the zone
+ * or column strip: point lookup, near clip, painter sort key and the
+ * estimated screen extent used for the early x reject.
+ * ----------------------------------------------------------------------- */
+static void renderer_sprite_candidate_set_extent(RendererSpriteCandidate *cand,
+                                                 int world_w, int sprite_scale_x,
+                                                 int32_t x_fine, int32_t z)
+{
+    int z_for_size = ROT_Z_INT(z);
+    if (z_for_size < 1) z_for_size = 1;
+    int sprite_w_est = (int)((int32_t)world_w * sprite_scale_x / z_for_size) * SPRITE_SIZE_MULTIPLIER;
+    if (sprite_w_est < 1) sprite_w_est = 1;
+    int scr_x_est = project_x_to_pixels(x_fine, z);
+    int spr_l = scr_x_est - sprite_w_est / 2;
+    cand->screen_left = spr_l;
+    cand->screen_right = spr_l + sprite_w_est;
+}
+
+static void renderer_build_world_sprite_list(GameState *state, RendererWorldSpriteList *out)
+{
+    RendererState *r = &g_renderer;
+    out->count = 0;
+    if (!state) return;
+    LevelState *level = &state->level;
+    if (!level->object_data || !level->object_points) return;
+
+    const int max_entries = RENDERER_SPRITE_CANDIDATE_CAP;
+    const int sprite_scale_x = renderer_sprite_scale_x_for_state(r, state);
+    int count = 0;
+
+    int num_pts = level->num_object_points;
+    if (num_pts > MAX_OBJ_POINTS) num_pts = MAX_OBJ_POINTS;
+
+    /* Object/shot layout keeps the logical upper/lower section flag at byte 63.
+     * For sprites in their own zone, prefer that stable gameplay-side section state
+     * over a renderer-estimated vertical overlap test; overlap remains useful for
+     * adjacent spill across stair/split boundaries. */
+    const int obj_off_in_top = 63;
+
+    /* Iterate by object index; each object has point number at offset 0 (ObjDraw: move.w (a0)+,d0).
+     * Use that to look up ObjRotated[pt_num] so keys and other pickups use correct position/z. */
+    for (int obj_idx = 0; obj_idx < RENDERER_OBJECT_SLOT_SCAN_CAP && count < max_entries; obj_idx++) {
+        const uint8_t *obj = level->object_data + obj_idx * OBJECT_SIZE;
+        int16_t pt_num = rd16(obj);
+        if (pt_num < 0) break; /* End of object list */
+
+        if ((unsigned)pt_num >= (unsigned)num_pts) continue; /* invalid point number */
+        int16_t obj_zone = rd16(obj + 12);
+        if (obj_zone < 0) continue;
+
+        ObjRotatedPoint *orp = &r->obj_rotated[pt_num];
+        int is_poly_object = ((uint8_t)obj[6] == (uint8_t)OBJ_3D_SPRITE);
+        {
+            /* Amiga parity:
+             * - BitMapObj: near reject at z <= 50
+             * - PolygonObj: near reject at z <= 0 (see PolygonObj ble polybehind) */
+            int32_t near_clip_z = is_poly_object ? 0 : ROT_Z_FROM_INT(SPRITE_NEAR_CLIP_Z);
+            if (orp->z <= near_clip_z) continue;
+        }
+
+        int spill_world_w = 32, spill_world_h = 32;
+        renderer_resolve_billboard_world_size_for_spill(obj, 0, &spill_world_w, &spill_world_h);
+
+        RendererSpriteCandidate *cand = &out->entries[count++];
+        cand->src = RENDERER_F2_SPRITE_SOURCE_OBJECT;
+        cand->idx = (int16_t)obj_idx;
+        cand->source_zone = obj_zone;
+        cand->on_upper = (uint8_t)(obj[obj_off_in_top] != 0);
+        cand->sort_z = is_poly_object
+            ? poly_object_front_z_for_sort(obj, orp, state)
+            : orp->z;
+        cand->spill_min_h = (int32_t)(spill_world_h >> 1) << WORLD_Y_FRAC_BITS;
+        renderer_sprite_candidate_set_extent(cand, spill_world_w, sprite_scale_x, orp->x_fine, orp->z);
+    }
+
+    /* Bullets/gibs from both shot pools (depth-sorted with level objects). */
+    int shot_pool_slots[2] = { level->nasty_shot_slots, PLAYER_SHOT_SLOT_COUNT };
+    for (int pool = 0; pool < 2 && count < max_entries; pool++) {
+        const uint8_t *shots = (pool == 0) ? level->nasty_shot_data : level->player_shot_data;
+        int slots = shot_pool_slots[pool];
+        if (!shots) continue;
+        for (int slot = 0; slot < slots && count < max_entries; slot++) {
+            const uint8_t *obj = shots + slot * OBJECT_SIZE;
+            int16_t shot_zone = rd16(obj + 12);
+            if (shot_zone < 0) continue; /* OBJ_ZONE */
+            if ((int8_t)obj[16] != OBJ_NBR_BULLET) continue;
+            int16_t pt_num = rd16(obj);
+            if (pt_num < 0 || (unsigned)pt_num >= (unsigned)num_pts) continue;
+            ObjRotatedPoint *orp = &r->obj_rotated[pt_num];
+            if (orp->z <= ROT_Z_FROM_INT(SPRITE_NEAR_CLIP_Z)) continue;
+
+            int spill_world_w = 32, spill_world_h = 32;
+            renderer_resolve_billboard_world_size_for_spill(obj, 1, &spill_world_w, &spill_world_h);
+
+            RendererSpriteCandidate *cand = &out->entries[count++];
+            cand->src = RENDERER_F2_SPRITE_SOURCE_SHOT;
+            cand->idx = (int16_t)(slot + ((pool == 0) ? 0 : NASTY_SHOT_SLOT_MAX));
+            cand->source_zone = shot_zone;
+            cand->on_upper = (uint8_t)(obj[obj_off_in_top] != 0);
+            cand->sort_z = orp->z;
+            cand->spill_min_h = (int32_t)(spill_world_h >> 1) << WORLD_Y_FRAC_BITS;
+            renderer_sprite_candidate_set_extent(cand, spill_world_w, sprite_scale_x, orp->x_fine, orp->z);
+        }
+    }
+
+    /* Explosion sprites join the same list so particles and billboards interleave by depth. */
+    if (state->num_explosions > 0 && count < max_entries &&
+        r->sprite_wad[8] && r->sprite_ptr[8]) {
+        int16_t sin_v = r->sinval;
+        int16_t cos_v = r->cosval;
+        int16_t cam_x = r->xoff;
+        int16_t cam_z = r->zoff;
 
-    int16_t draw_left = ctx->left_clip;
-    int16_t draw_right = ctx->right_clip;
-    if (draw_left >= draw_right) return 0;
+        for (int ei = 0; ei < state->num_explosions && count < max_entries; ei++) {
+            if (state->explosions[ei].start_delay > 0) continue;
+            if ((int)state->explosions[ei].frame >= 9) continue;
+            int16_t dx = (int16_t)(state->explosions[ei].x - cam_x);
+            int16_t dz = (int16_t)(state->explosions[ei].z - cam_z);
+            int32_t vz = (int32_t)dx * sin_v + (int32_t)dz * cos_v;
+            vz <<= 2;
+            int32_t orp_z = vz >> (16 - ROT_Z_FRAC_BITS);
+            if (orp_z <= ROT_Z_FROM_INT(SPRITE_NEAR_CLIP_Z)) continue;
 
-    int32_t zone_roof = section_top_world;
-    int32_t zone_floor = section_bot_world;
-    if (zone_roof > zone_floor) {
-        int32_t t = zone_roof;
-        zone_roof = zone_floor;
-        zone_floor = t;
+            int expl_w_est = 100;
+            int expl_h_est = 100;
+            renderer_get_explosion_frame_and_world_size(state, ei, NULL, &expl_w_est, &expl_h_est);
+            int world_w = expl_w_est * EXPLOSION_SIZE_CORRECTION;
+            if (world_w < 1) world_w = 1;
+            int32_t vx = (int32_t)dx * cos_v - (int32_t)dz * sin_v;
+            vx <<= 1;
+            int32_t vx_fine = (vx >> 9) + r->xwobble;
+
+            RendererSpriteCandidate *cand = &out->entries[count++];
+            cand->src = RENDERER_F2_SPRITE_SOURCE_EXPLOSION;
+            cand->idx = (int16_t)ei;
+            cand->source_zone = state->explosions[ei].zone;
+            cand->on_upper = (uint8_t)(state->explosions[ei].in_top != 0);
+            cand->sort_z = orp_z;
+            cand->spill_min_h = (int32_t)(expl_h_est >> 1) << WORLD_Y_FRAC_BITS;
+            renderer_sprite_candidate_set_extent(cand, world_w, sprite_scale_x, vx_fine, orp_z);
+        }
     }
 
-    *out_left = draw_left;
-    *out_right = draw_right;
-    *out_top_world = zone_roof;
-    *out_bot_world = zone_floor;
-    *out_ignore_top = ignore_sky_top_clip ? 1 : 0;
-    return 1;
+    out->count = count;
 }
 
-static void renderer_get_explosion_frame_and_world_size(const GameState *state,
-                                                        int explosion_index,
-                                                        int *out_frame_num,
-                                                        int *out_world_w,
-                                                        int *out_world_h)
+/* Bin the frame candidates whose estimated extent overlaps [col_start, col_end). */
+static void renderer_build_sprite_strip_list(const RendererWorldSpriteList *sprites,
+                                             int col_start, int col_end,
+                                             RendererSpriteStripList *out)
 {
-    int frame_num = 0;
-    int expl_w = 100;
-    int expl_h = 100;
-    int scale = 100;
-    int ft_count = sprite_frames_table[8].count;
-    if (ft_count < 1) ft_count = 1;
+    int count = 0;
+    out->sprites = sprites;
+    if (sprites) {
+        for (int i = 0; i < sprites->count; i++) {
+            const RendererSpriteCandidate *cand = &sprites->entries[i];
+            if (cand->screen_right <= col_start || cand->screen_left >= col_end) continue;
+            out->index[count++] = (uint16_t)i;
+        }
+    }
+    out->count = count;
+}
 
-    if (state && explosion_index >= 0 && explosion_index < state->num_explosions) {
-        scale = (int)state->explosions[explosion_index].size_scale;
-        if (scale <= 0) scale = 100;
+/* draw_zone_objects_ctx scratch (per-thread, frame arena). The entry table is
+ * sized from the live candidate count and the unbinned sprite list is only
+ * taken outside the world pass, so neither sits on a worker stack: both are
+ * RENDERER_SPRITE_CANDIDATE_CAP wide, which grows with NASTY_SHOT_SLOT_MAX. */
+static AB3D_THREAD_LOCAL RendererZoneObjEntry *g_zone_obj_entries_scratch = NULL;
+static AB3D_THREAD_LOCAL int g_zone_obj_entries_capacity = 0;
+static AB3D_THREAD_LOCAL unsigned g_zone_obj_entries_gen = 0;
+static AB3D_THREAD_LOCAL RendererWorldSpriteList *g_zone_sprite_list_scratch = NULL;
+static AB3D_THREAD_LOCAL unsigned g_zone_sprite_list_gen = 0;
 
-        frame_num = (int)state->explosions[explosion_index].frame;
-        if (frame_num < 0) frame_num = 0;
-        if (frame_num >= ft_count) frame_num = ft_count - 1;
+static RendererZoneObjEntry *renderer_zone_obj_entries_get_scratch(int count)
+{
+    int new_cap;
+    RendererZoneObjEntry *new_entries;
 
-        if (bullet_pop_tables[2]) {
-            const BulletAnimFrame *pf = &bullet_pop_tables[2][frame_num];
-            if (pf->width > 0 && pf->height > 0) {
-                expl_w = pf->width;
-                expl_h = pf->height;
-            }
-        }
-    }
+    if (count <= 0) return NULL;
+    if (g_zone_obj_entries_scratch && count <= g_zone_obj_entries_capacity &&
+        g_zone_obj_entries_gen == g_renderer_frame_arena.generation)
+        return g_zone_obj_entries_scratch;
 
-    expl_w = (expl_w * scale) / 100;
-    expl_h = (expl_h * scale) / 100;
-    if (expl_w < 1) expl_w = 1;
-    if (expl_h < 1) expl_h = 1;
+    new_cap = renderer_scratch_grow_cap(g_zone_obj_entries_capacity, count, 64);
+    new_entries = (RendererZoneObjEntry *)renderer_frame_arena_alloc((size_t)new_cap * sizeof(*new_entries));
+    if (!new_entries) return NULL;
 
-    if (out_frame_num) *out_frame_num = frame_num;
-    if (out_world_w) *out_world_w = expl_w;
-    if (out_world_h) *out_world_h = expl_h;
+    g_zone_obj_entries_scratch = new_entries;
+    g_zone_obj_entries_capacity = new_cap;
+    g_zone_obj_entries_gen = g_renderer_frame_arena.generation;
+    return new_entries;
 }
 
-static void renderer_project_zone_world_clip_y(const RendererState *r,
-                                               int32_t zone_top_world,
-                                               int32_t zone_bot_world,
-                                               int32_t y_off,
-                                               int32_t z_fp,
-                                               int ignore_top_clip,
-                                               int32_t *out_top_y,
-                                               int32_t *out_bot_y)
+static RendererWorldSpriteList *renderer_zone_sprite_list_get_scratch(void)
 {
-    int32_t z = (z_fp > 0) ? z_fp : 1;
-    int center_y = r->height / 2;
-    if (ignore_top_clip) {
-        *out_top_y = INT32_MIN;
-    } else {
-        *out_top_y = (int)(((int64_t)((zone_top_world - y_off) >> WORLD_Y_FRAC_BITS) *
-                            (int64_t)r->proj_y_scale * (int64_t)RENDER_SCALE << ROT_Z_FRAC_BITS) / z) + center_y;
-    }
-    *out_bot_y = (int)(((int64_t)((zone_bot_world - y_off) >> WORLD_Y_FRAC_BITS) *
-                        (int64_t)r->proj_y_scale * (int64_t)RENDER_SCALE << ROT_Z_FRAC_BITS) / z) + center_y;
+    if (g_zone_sprite_list_scratch && g_zone_sprite_list_gen == g_renderer_frame_arena.generation)
+        return g_zone_sprite_list_scratch;
+    g_zone_sprite_list_scratch =
+        (RendererWorldSpriteList *)renderer_frame_arena_alloc(sizeof(*g_zone_sprite_list_scratch));
+    g_zone_sprite_list_gen = g_renderer_frame_arena.generation;
+    return g_zone_sprite_list_scratch;
+}
+
+static void renderer_zone_objects_release_scratch(void)
+{
+    g_zone_obj_entries_scratch = NULL;
+    g_zone_obj_entries_capacity = 0;
+    g_zone_sprite_list_scratch = NULL;
 }
 
 /* -----------------------------------------------------------------------
@@ -12023,8 +13929,6 @@ static void draw_zone_objects_ctx(RenderSliceContext *ctx, GameState *state, int
     if (!level->object_data || !level->object_points) return;
 
     int32_t y_off = r->yoff;
-    const int sprite_scale_x_for_estimate = renderer_sprite_scale_x_for_state(r, state);
-    const int explosion_sprite_scale_x_for_estimate = renderer_sprite_scale_x_for_state(r, state);
     const int16_t billboard_view_right_x = (int16_t)(r->cosval / 2);
     const int16_t billboard_view_right_z = (int16_t)(-r->sinval / 2);
 
@@ -12034,64 +13938,52 @@ static void draw_zone_objects_ctx(RenderSliceContext *ctx, GameState *state, int
         DRAW_SRC_SHOT = RENDERER_F2_SPRITE_SOURCE_SHOT,
         DRAW_SRC_EXPLOSION = RENDERER_F2_SPRITE_SOURCE_EXPLOSION
     };
-    typedef struct {
-        int src;
-        int idx;
-        int16_t source_zone;
-        int32_t z;
-        int16_t clip_left;
-        int16_t clip_right;
-        int32_t zone_top_world;
-        int32_t zone_bot_world;
-        uint8_t ignore_top_clip;
-    } ObjEntry;
-    enum {
-        /* Level object table is CID-terminated but physically 256 slots in level data.
-         * Keep draw-list capacity aligned with all potential contributors. */
-        RENDERER_OBJECT_SLOT_SCAN_CAP = 256
-    };
-    ObjEntry objs[RENDERER_OBJECT_SLOT_SCAN_CAP +
-                  NASTY_SHOT_SLOT_COUNT +
-                  PLAYER_SHOT_SLOT_COUNT +
-                  MAX_EXPLOSIONS];
-    const int max_draw_entries = (int)(sizeof(objs) / sizeof(objs[0]));
+    RendererZoneObjEntry *objs;
     int obj_count = 0;
 
     int num_pts = level->num_object_points;
     if (num_pts > MAX_OBJ_POINTS) num_pts = MAX_OBJ_POINTS;
 
+    /* Frame-invariant work (projection, near clip, sort key, x-extent) was
+     * done once in the world prepass and binned per strip; callers outside
+     * the world pass build an unbinned list here. */
+    const RendererSpriteStripList *strip_list = ctx->sprite_strip;
+    const RendererWorldSpriteList *sprites;
+    int candidate_count;
+    if (strip_list && strip_list->sprites) {
+        sprites = strip_list->sprites;
+        candidate_count = strip_list->count;
+    } else {
+        RendererWorldSpriteList *local_sprites = renderer_zone_sprite_list_get_scratch();
+        if (!local_sprites) return;
+        strip_list = NULL;
+        renderer_build_world_sprite_list(state, local_sprites);
+        sprites = local_sprites;
+        candidate_count = local_sprites->count;
+    }
+    if (candidate_count <= 0) return;
+    objs = renderer_zone_obj_entries_get_scratch(candidate_count);
+    if (!objs) return;
+
     int16_t adjacent_source_zones[RENDERER_SPILL_SEARCH_MAX_NEIGHBORS];
     int adjacent_source_count = renderer_collect_connected_zones_fast(level,
                                                                       zone_id,
                                                                       adjacent_source_zones,
                                                                       RENDERER_SPILL_SEARCH_MAX_NEIGHBORS);
-    /* Object/shot layout keeps the logical upper/lower section flag at byte 63.
-     * For sprites in their own zone, prefer that stable gameplay-side section state
-     * over a renderer-estimated vertical overlap test; overlap remains useful for
-     * adjacent spill across stair/split boundaries. */
-    const int obj_off_in_top = 63;
-
-    /* Iterate by object index; each object has point number at offset 0 (ObjDraw: move.w (a0)+,d0).
-     * Use that to look up ObjRotated[pt_num] so keys and other pickups use correct position/z. */
-    for (int obj_idx = 0; obj_idx < RENDERER_OBJECT_SLOT_SCAN_CAP && obj_count < max_draw_entries; obj_idx++) {
-        const uint8_t *obj = level->object_data + obj_idx * OBJECT_SIZE;
-        int16_t pt_num = rd16(obj);
-        if (pt_num < 0) break; /* End of object list */
 
-        if ((unsigned)pt_num >= (unsigned)num_pts) continue; /* invalid point number */
-        int spill_world_w = 32, spill_world_h = 32;
-        renderer_resolve_billboard_world_size_for_spill(obj, 0, &spill_world_w, &spill_world_h);
+    for (int ci = 0; ci < candidate_count; ci++) {
+        const RendererSpriteCandidate *cand =
+            &sprites->entries[strip_list ? strip_list->index[ci] : ci];
+        int16_t src_zone = cand->source_zone;
+        int in_this_zone = (src_zone == (int16_t)zone_id);
+        int src_on_upper = cand->on_upper ? 1 : 0;
 
         /* Basic spill mode: allow the current zone to draw directly adjacent
          * source zones as spill candidates. */
-        int16_t obj_zone = rd16(obj + 12);
-        int in_this_zone = (obj_zone == (int16_t)zone_id);
-        int obj_on_upper = (obj[obj_off_in_top] != 0);
-        if (obj_zone < 0) continue;
         if (!in_this_zone) {
-            if (!renderer_zone_list_contains(adjacent_source_zones, adjacent_source_count, obj_zone))
+            if (!renderer_zone_list_contains(adjacent_source_zones, adjacent_source_count, src_zone))
                 continue;
-            if (!renderer_spill_zone_order_allows(state, obj_zone, zone_id))
+            if (!renderer_spill_zone_order_allows(state, src_zone, zone_id))
                 continue;
             /* Portal crossing check removed: draw-time geometric clip
              * narrowing (renderer_spill_narrow_clip_to_zone_geometry)
@@ -12102,8 +13994,8 @@ static void draw_zone_objects_ctx(RenderSliceContext *ctx, GameState *state, int
         }
 
         if (level_filter >= 0 && in_this_zone) {
-            if ((level_filter == 1 && !obj_on_upper) ||
-                (level_filter == 0 && obj_on_upper))
+            if ((level_filter == 1 && !src_on_upper) ||
+                (level_filter == 0 && src_on_upper))
                 continue;
         }
 
@@ -12118,7 +14010,7 @@ static void draw_zone_objects_ctx(RenderSliceContext *ctx, GameState *state, int
                                                     &draw_ignore_top)) {
             continue;
         }
-        if (!in_this_zone && level_filter == 0 && obj_on_upper) {
+        if (!in_this_zone && level_filter == 0 && src_on_upper) {
             draw_ignore_top = 1;
         }
         if (!in_this_zone) {
@@ -12126,46 +14018,26 @@ static void draw_zone_objects_ctx(RenderSliceContext *ctx, GameState *state, int
              * extends below its home floor or above its home ceiling when
              * drawn in an adjacent zone at a different height. */
             int32_t src_top = 0, src_bot = 0;
-            int src_filter = obj_on_upper ? 1 : 0;
-            if (renderer_resolve_zone_section_world_bounds(level, obj_zone, src_filter, &src_top, &src_bot)) {
+            if (renderer_resolve_zone_section_world_bounds(level, src_zone, src_on_upper, &src_top, &src_bot)) {
                 if (src_top > draw_zone_top) draw_zone_top = src_top;
                 if (src_bot < draw_zone_bot) draw_zone_bot = src_bot;
                 if (draw_zone_top >= draw_zone_bot) continue;
             }
             /* Reject trivial slivers (e.g. pillar step zones): discard if the
              * overlap after clamping is less than half the sprite height. */
-            if ((draw_zone_bot - draw_zone_top) < ((int32_t)(spill_world_h >> 1) << WORLD_Y_FRAC_BITS))
+            if ((draw_zone_bot - draw_zone_top) < cand->spill_min_h)
                 continue;
         }
-        ObjRotatedPoint *orp = &r->obj_rotated[pt_num];
-        int is_poly_object = ((uint8_t)obj[6] == (uint8_t)OBJ_3D_SPRITE);
-        {
-            /* Amiga parity:
-             * - BitMapObj: near reject at z <= 50
-             * - PolygonObj: near reject at z <= 0 (see PolygonObj ble polybehind) */
-            int32_t near_clip_z = is_poly_object ? 0 : ROT_Z_FROM_INT(SPRITE_NEAR_CLIP_Z);
-            if (orp->z <= near_clip_z) continue;
-        }
 
-        /* Skip early when this object cannot affect this column strip. */
-        {
-            int world_w = spill_world_w;
-            int z_for_size = ROT_Z_INT(orp->z);
-            if (z_for_size < 1) z_for_size = 1;
-            int sprite_w_est = (int)((int32_t)world_w * sprite_scale_x_for_estimate / z_for_size) * SPRITE_SIZE_MULTIPLIER;
-            if (sprite_w_est < 1) sprite_w_est = 1;
-            int scr_x_est = project_x_to_pixels(orp->x_fine, orp->z);
-            int spr_l = scr_x_est - sprite_w_est / 2;
-            int spr_r = spr_l + sprite_w_est;
-            if (spr_r <= (int)draw_clip_left || spr_l >= (int)draw_clip_right) continue;
-        }
-
-        objs[obj_count].src = DRAW_SRC_OBJECT;
-        objs[obj_count].idx = obj_idx;
-        objs[obj_count].source_zone = obj_zone;
-        objs[obj_count].z = is_poly_object
-            ? poly_object_front_z_for_sort(obj, orp, state)
-            : orp->z;
+        /* Skip early when this object cannot affect this zone's clip span. */
+        if (cand->screen_right <= (int32_t)draw_clip_left ||
+            cand->screen_left >= (int32_t)draw_clip_right)
+            continue;
+
+        objs[obj_count].src = cand->src;
+        objs[obj_count].idx = cand->idx;
+        objs[obj_count].source_zone = src_zone;
+        objs[obj_count].z = cand->sort_z;
         objs[obj_count].clip_left = draw_clip_left;
         objs[obj_count].clip_right = draw_clip_right;
         objs[obj_count].zone_top_world = draw_zone_top;
@@ -12174,183 +14046,9 @@ static void draw_zone_objects_ctx(RenderSliceContext *ctx, GameState *state, int
         obj_count++;
     }
 
-    /* Add bullets/gibs from both shot pools (same zone, depth-sorted with level objects). */
-    int shot_pool_slots[2] = { NASTY_SHOT_SLOT_COUNT, PLAYER_SHOT_SLOT_COUNT };
-    for (int pool = 0; pool < 2 && obj_count < max_draw_entries; pool++) {
-        const uint8_t *shots = (pool == 0) ? level->nasty_shot_data : level->player_shot_data;
-        int slots = shot_pool_slots[pool];
-        if (!shots) continue;
-        for (int slot = 0; slot < slots && obj_count < max_draw_entries; slot++) {
-            const uint8_t *obj = shots + slot * OBJECT_SIZE;
-            int16_t shot_zone = rd16(obj + 12);
-            if (shot_zone < 0) continue; /* OBJ_ZONE */
-            if ((int8_t)obj[16] != OBJ_NBR_BULLET) continue;
-            int16_t pt_num = rd16(obj);
-            if (pt_num < 0 || (unsigned)pt_num >= (unsigned)num_pts) continue;
-            int spill_world_w = 32, spill_world_h = 32;
-            renderer_resolve_billboard_world_size_for_spill(obj, 1, &spill_world_w, &spill_world_h);
-            int in_this_zone = (shot_zone == (int16_t)zone_id);
-            int shot_on_upper = (obj[obj_off_in_top] != 0);
-            if (!in_this_zone) {
-                if (!renderer_zone_list_contains(adjacent_source_zones, adjacent_source_count, shot_zone))
-                    continue;
-                if (!renderer_spill_zone_order_allows(state, shot_zone, zone_id))
-                    continue;
-            }
-            if (level_filter >= 0 && in_this_zone) {
-                if ((level_filter == 1 && !shot_on_upper) ||
-                    (level_filter == 0 && shot_on_upper))
-                    continue;
-            }
-
-            int16_t draw_clip_left = 0, draw_clip_right = 0;
-            int32_t draw_zone_top = 0, draw_zone_bot = 0;
-            int draw_ignore_top = 0;
-            if (!renderer_resolve_sprite_zone_draw_clip(ctx, state, zone_id,
-                                                        top_of_room, bot_of_room,
-                                                        ignore_sky_top_clip,
-                                                        &draw_clip_left, &draw_clip_right,
-                                                        &draw_zone_top, &draw_zone_bot,
-                                                        &draw_ignore_top)) {
-                continue;
-            }
-            if (!in_this_zone && level_filter == 0 && shot_on_upper) {
-                draw_ignore_top = 1;
-            }
-            if (!in_this_zone) {
-                int32_t src_top = 0, src_bot = 0;
-                int src_filter = shot_on_upper ? 1 : 0;
-                if (renderer_resolve_zone_section_world_bounds(level, shot_zone, src_filter, &src_top, &src_bot)) {
-                    if (src_top > draw_zone_top) draw_zone_top = src_top;
-                    if (src_bot < draw_zone_bot) draw_zone_bot = src_bot;
-                    if (draw_zone_top >= draw_zone_bot) continue;
-                }
-                /* Reject trivial slivers after clamping. */
-                if ((draw_zone_bot - draw_zone_top) < ((int32_t)(spill_world_h >> 1) << WORLD_Y_FRAC_BITS))
-                    continue;
-            }
-            ObjRotatedPoint *orp = &r->obj_rotated[pt_num];
-            if (orp->z <= ROT_Z_FROM_INT(SPRITE_NEAR_CLIP_Z)) continue;
-
-            {
-                int world_w = spill_world_w;
-                int z_for_size = ROT_Z_INT(orp->z);
-                if (z_for_size < 1) z_for_size = 1;
-                int sprite_w_est = (int)((int32_t)world_w * sprite_scale_x_for_estimate / z_for_size) * SPRITE_SIZE_MULTIPLIER;
-                if (sprite_w_est < 1) sprite_w_est = 1;
-                int scr_x_est = project_x_to_pixels(orp->x_fine, orp->z);
-                int spr_l = scr_x_est - sprite_w_est / 2;
-                int spr_r = spr_l + sprite_w_est;
-                if (spr_r <= (int)draw_clip_left || spr_l >= (int)draw_clip_right) continue;
-            }
-            objs[obj_count].src = DRAW_SRC_SHOT;
-            objs[obj_count].idx = slot + ((pool == 0) ? 0 : NASTY_SHOT_SLOT_COUNT);
-            objs[obj_count].source_zone = shot_zone;
-            objs[obj_count].z = orp->z;
-            objs[obj_count].clip_left = draw_clip_left;
-            objs[obj_count].clip_right = draw_clip_right;
-            objs[obj_count].zone_top_world = draw_zone_top;
-            objs[obj_count].zone_bot_world = draw_zone_bot;
-            objs[obj_count].ignore_top_clip = (uint8_t)(draw_ignore_top ? 1 : 0);
-            obj_count++;
-        }
-    }
-
-    /* Add explosion sprites into the same sorted list so particles and billboards interleave by depth. */
-    if (state->num_explosions > 0 && obj_count < max_draw_entries &&
-        r->sprite_wad[8] && r->sprite_ptr[8]) {
-        int16_t sin_v = r->sinval;
-        int16_t cos_v = r->cosval;
-        int16_t cam_x = r->xoff;
-        int16_t cam_z = r->zoff;
-
-        for (int ei = 0; ei < state->num_explosions && obj_count < max_draw_entries; ei++) {
-            int16_t expl_zone = state->explosions[ei].zone;
-            int in_this_zone = (expl_zone == (int16_t)zone_id);
-            int expl_on_upper = (state->explosions[ei].in_top != 0);
-            int expl_h_est = 100;
-            if (state->explosions[ei].start_delay > 0) continue;
-            if ((int)state->explosions[ei].frame >= 9) continue;
-            renderer_get_explosion_frame_and_world_size(state, ei, NULL, NULL, &expl_h_est);
-            if (!in_this_zone) {
-                if (!renderer_zone_list_contains(adjacent_source_zones, adjacent_source_count, expl_zone))
-                    continue;
-                if (!renderer_spill_zone_order_allows(state, expl_zone, zone_id))
-                    continue;
-            }
-            if (level_filter >= 0 && in_this_zone) {
-                if ((level_filter == 1 && !expl_on_upper) ||
-                    (level_filter == 0 && expl_on_upper))
-                    continue;
-            }
-
-            int16_t draw_clip_left = 0, draw_clip_right = 0;
-            int32_t draw_zone_top = 0, draw_zone_bot = 0;
-            int draw_ignore_top = 0;
-            if (!renderer_resolve_sprite_zone_draw_clip(ctx, state, zone_id,
-                                                        top_of_room, bot_of_room,
-                                                        ignore_sky_top_clip,
-                                                        &draw_clip_left, &draw_clip_right,
-                                                        &draw_zone_top, &draw_zone_bot,
-                                                        &draw_ignore_top)) {
-                continue;
-            }
-            if (!in_this_zone && level_filter == 0 && expl_on_upper) {
-                draw_ignore_top = 1;
-            }
-            if (!in_this_zone) {
-                int32_t src_top = 0, src_bot = 0;
-                int src_filter = expl_on_upper ? 1 : 0;
-                if (renderer_resolve_zone_section_world_bounds(level, expl_zone, src_filter, &src_top, &src_bot)) {
-                    if (src_top > draw_zone_top) draw_zone_top = src_top;
-                    if (src_bot < draw_zone_bot) draw_zone_bot = src_bot;
-                    if (draw_zone_top >= draw_zone_bot) continue;
-                }
-                /* Reject trivial slivers after clamping. */
-                if ((draw_zone_bot - draw_zone_top) < ((int32_t)(expl_h_est >> 1) << WORLD_Y_FRAC_BITS))
-                    continue;
-            }
-            int16_t dx = (int16_t)(state->explosions[ei].x - cam_x);
-            int16_t dz = (int16_t)(state->explosions[ei].z - cam_z);
-            int32_t vz = (int32_t)dx * sin_v + (int32_t)dz * cos_v;
-            vz <<= 2;
-            int32_t orp_z = vz >> (16 - ROT_Z_FRAC_BITS);
-            if (orp_z <= ROT_Z_FROM_INT(SPRITE_NEAR_CLIP_Z)) continue;
-
-            {
-                int z_for_size = ROT_Z_INT(orp_z);
-                if (z_for_size < 1) z_for_size = 1;
-                int expl_w_est = 100;
-                renderer_get_explosion_frame_and_world_size(state, ei, NULL, &expl_w_est, NULL);
-                int world_w = expl_w_est * EXPLOSION_SIZE_CORRECTION;
-                if (world_w < 1) world_w = 1;
-                int sprite_w_est = (int)((int32_t)world_w * explosion_sprite_scale_x_for_estimate / z_for_size) * SPRITE_SIZE_MULTIPLIER;
-                if (sprite_w_est < 1) sprite_w_est = 1;
-                int32_t vx = (int32_t)dx * cos_v - (int32_t)dz * sin_v;
-                vx <<= 1;
-                int32_t vx_fine = (vx >> 9) + r->xwobble;
-                int scr_x_est = project_x_to_pixels(vx_fine, orp_z);
-                int spr_l = scr_x_est - sprite_w_est / 2;
-                int spr_r = spr_l + sprite_w_est;
-                if (spr_r <= (int)draw_clip_left || spr_l >= (int)draw_clip_right) continue;
-            }
-
-            objs[obj_count].src = DRAW_SRC_EXPLOSION;
-            objs[obj_count].idx = ei;
-            objs[obj_count].source_zone = expl_zone;
-            objs[obj_count].z = orp_z;
-            objs[obj_count].clip_left = draw_clip_left;
-            objs[obj_count].clip_right = draw_clip_right;
-            objs[obj_count].zone_top_world = draw_zone_top;
-            objs[obj_count].zone_bot_world = draw_zone_bot;
-            objs[obj_count].ignore_top_clip = (uint8_t)(draw_ignore_top ? 1 : 0);
-            obj_count++;
-        }
-    }
-
     /* Insertion sort by Z descending (farthest first - painter's algorithm). */
     for (int i = 1; i < obj_count; i++) {
-        ObjEntry key = objs[i];
+        RendererZoneObjEntry key = objs[i];
         int j = i - 1;
         while (j >= 0 && objs[j].z < key.z) {
             objs[j + 1] = objs[j];
@@ -12377,7 +14075,7 @@ static void draw_zone_objects_ctx(RenderSliceContext *ctx, GameState *state, int
     const int expl_ft_count = sprite_frames_table[expl_vect].count;
     const int explosion_sprite_scale_x = renderer_sprite_scale_x_for_state(r, state);
     for (int oi = 0; oi < obj_count; oi++) {
-        const ObjEntry *entry = &objs[oi];
+        const RendererZoneObjEntry *entry = &objs[oi];
         int entry_src = entry->src;
         int16_t draw_clip_left = entry->clip_left;
         int16_t draw_clip_right = entry->clip_right;
@@ -12511,12 +14209,12 @@ static void draw_zone_objects_ctx(RenderSliceContext *ctx, GameState *state, int
         if (entry_src == DRAW_SRC_OBJECT) {
             obj = level->object_data + obj_idx * OBJECT_SIZE;
         } else {
-            if (obj_idx < NASTY_SHOT_SLOT_COUNT) {
+            if (obj_idx < NASTY_SHOT_SLOT_MAX) {
                 if (!level->nasty_shot_data) continue;
                 obj = level->nasty_shot_data + obj_idx * OBJECT_SIZE;
             } else {
                 if (!level->player_shot_data) continue;
-                obj = level->player_shot_data + (obj_idx - NASTY_SHOT_SLOT_COUNT) * OBJECT_SIZE;
+                obj = level->player_shot_data + (obj_idx - NASTY_SHOT_SLOT_MAX) * OBJECT_SIZE;
             }
         }
         /* ObjDraw3: cmp.b #$ff,6(a0); bne BitMapObj; bsr PolygonObj.
@@ -12923,6 +14621,8 @@ static void renderer_reset_level_sky_cache_internal(void)
 
     free(g_level_sky_cache_buckets);
     g_level_sky_cache_buckets = NULL;
+    free(g_level_sky_cache_zone_state);
+    g_level_sky_cache_zone_state = NULL;
     g_level_sky_cache_zone_slots = 0;
 }
 
@@ -12964,38 +14664,6 @@ static int renderer_level_sky_cache_push_poly(const int16_t *pt_indices, int sid
     return 1;
 }
 
-/* Bytes of payload after the type word (for forward-scanning the zone graphics stream). */
-static size_t zone_gfx_entry_data_skip(int16_t entry_type, const uint8_t *data)
-{
-    switch (entry_type) {
-    case 0:
-    case 13: return 28;
-    case 3:
-    case 12: return 0;
-    case 4: return 2;
-    case 5: return 28;
-    case 6: return 4;
-    case 1:
-    case 2:
-    case 7:
-    case 8:
-    case 9:
-    case 10:
-    case 11:
-    {
-        int16_t num_sides_m1 = rd16(data + 2);
-        int sides = (int)num_sides_m1 + 1;
-        if (sides < 0) sides = 0;
-        if (sides > 100) sides = 100;
-        /* Payload layout after type:
-         *   ypos(2) + sides_m1(2) + point_indices(2*sides) + extra(8) */
-        return (size_t)(4 + 2 * sides + 8);
-    }
-    default:
-        return 0;
-    }
-}
-
 static int renderer_build_viewer_split_floor_occluder(const GameState *state,
                                                       int16_t viewer_zone,
                                                       int16_t col_start,
@@ -13060,16 +14728,29 @@ static int renderer_build_viewer_split_floor_occluder(const GameState *state,
     right_edge = g_poly_edge_right_scratch;
 
     {
+        const LevelGfxStream *gs = level_gfx_stream(level, gfx_data);
         const uint8_t *ptr = gfx_data + 2;
-        int max_iter = 500;
+        int max_iter = LEVEL_GFX_STREAM_MAX;
+        int32_t tok = 0;
 
         while (max_iter-- > 0) {
-            int16_t entry_type = rd16(ptr);
-            ptr += 2;
-            if (entry_type < 0) break;
+            int16_t entry_type;
+            if (gs) {
+                /* Pre-tokenized stream: jump straight to each payload. */
+                const LevelGfxToken *t;
+                if (tok >= gs->count) break;
+                t = &level->decoded->gfx_tokens[gs->first + tok++];
+                if (t->type != 1) continue;
+                entry_type = t->type;
+                ptr = level->graphics + t->off;
+            } else {
+                entry_type = rd16(ptr);
+                ptr += 2;
+                if (entry_type < 0) break;
+            }
 
             if (entry_type != 1) {
-                size_t skip = zone_gfx_entry_data_skip(entry_type, ptr);
+                size_t skip = level_gfx_entry_payload_size(entry_type, ptr);
                 if (skip == 0) {
                     if (entry_type != 3 && entry_type != 12) break;
                 } else {
@@ -13347,7 +15028,7 @@ static int zone_stream_has_matching_roof_polygon(const uint8_t *gfx_data,
         }
 
         {
-            size_t skip = zone_gfx_entry_data_skip(t, scan);
+            size_t skip = level_gfx_entry_payload_size(t, scan);
             if (skip == 0) {
                 if (t != 3 && t != 12) break;
                 continue;
@@ -13372,7 +15053,7 @@ static AB3D_ATTR_UNUSED int zone_stream_has_explicit_roof_polygon(const uint8_t
         if (t == 2) return 1;
 
         {
-            size_t skip = zone_gfx_entry_data_skip(t, scan);
+            size_t skip = level_gfx_entry_payload_size(t, scan);
             if (skip == 0) {
                 if (t != 3 && t != 12) break;
                 continue;
@@ -13383,63 +15064,32 @@ static AB3D_ATTR_UNUSED int zone_stream_has_explicit_roof_polygon(const uint8_t
     return 0;
 }
 
-#define ZONE_STREAM_ENTRY_TYPE_CACHE_SIZE 256u
-
-typedef struct {
-    const uint8_t *gfx_data;
-    int16_t want_type;
-    uint16_t sig0;
-    uint16_t sig1;
-    uint8_t valid;
-    uint8_t result;
-} ZoneStreamEntryTypeCacheEntry;
-
-/* Per-thread cache: this lookup runs in hot zone loops (including worker threads). */
-static AB3D_THREAD_LOCAL ZoneStreamEntryTypeCacheEntry
-    g_zone_stream_entry_type_cache[ZONE_STREAM_ENTRY_TYPE_CACHE_SIZE];
-
-static inline unsigned zone_stream_entry_type_cache_slot(const uint8_t *gfx_data, int16_t want_type)
-{
-    uintptr_t k = (uintptr_t)gfx_data;
-    k ^= (uintptr_t)((uint32_t)(uint16_t)want_type * 0x9E3779B1u);
-    k ^= (k >> 11);
-    return (unsigned)(k & (ZONE_STREAM_ENTRY_TYPE_CACHE_SIZE - 1u));
-}
-
-static int zone_stream_has_entry_type(const uint8_t *gfx_data, int16_t want_type)
+static int zone_stream_has_entry_type(const LevelState *level, const uint8_t *gfx_data, int16_t want_type)
 {
-    unsigned slot;
-    uint16_t sig0;
-    uint16_t sig1;
-
     if (!gfx_data) return 0;
 
-    /* Small signature guards against stale cache hits if allocator reuses an address. */
-    sig0 = (uint16_t)rd16(gfx_data + 0);
-    sig1 = (uint16_t)rd16(gfx_data + 2);
-    slot = zone_stream_entry_type_cache_slot(gfx_data, want_type);
     {
-        ZoneStreamEntryTypeCacheEntry *ce = &g_zone_stream_entry_type_cache[slot];
-        if (ce->valid && ce->gfx_data == gfx_data &&
-            ce->want_type == want_type && ce->sig0 == sig0 && ce->sig1 == sig1) {
-            return ce->result ? 1 : 0;
+        const LevelGfxStream *gs = level_gfx_stream(level, gfx_data);
+        if (gs) {
+            if (want_type >= 0 && want_type < 32)
+                return (gs->type_mask >> want_type) & 1u;
+            for (int32_t i = 0; i < gs->count; i++) {
+                if (level->decoded->gfx_tokens[gs->first + i].type == want_type) return 1;
+            }
+            return 0;
         }
     }
 
     const uint8_t *scan = gfx_data + 2;
-    int scan_iter = 500;
-    int found = 0;
+    int scan_iter = LEVEL_GFX_STREAM_MAX;
     while (scan_iter-- > 0) {
         int16_t t = rd16(scan);
         scan += 2;
         if (t < 0) break;
-        if (t == want_type) {
-            found = 1;
-            break;
-        }
+        if (t == want_type) return 1;
 
         {
-            size_t skip = zone_gfx_entry_data_skip(t, scan);
+            size_t skip = level_gfx_entry_payload_size(t, scan);
             if (skip == 0) {
                 if (t != 3 && t != 12) break;
                 continue;
@@ -13447,18 +15097,7 @@ static int zone_stream_has_entry_type(const uint8_t *gfx_data, int16_t want_type
             scan += skip;
         }
     }
-
-    {
-        ZoneStreamEntryTypeCacheEntry *ce = &g_zone_stream_entry_type_cache[slot];
-        ce->gfx_data = gfx_data;
-        ce->want_type = want_type;
-        ce->sig0 = sig0;
-        ce->sig1 = sig1;
-        ce->valid = 1;
-        ce->result = (uint8_t)(found ? 1 : 0);
-    }
-
-    return found;
+    return 0;
 }
 
 /* Rasterize a floor-outline polygon at zone_roof height as a sky ceiling.
@@ -13632,7 +15271,7 @@ static void renderer_build_zone_stream_backdrop_sky_cache(int use_upper,
         }
 
         {
-            size_t skip = zone_gfx_entry_data_skip(t, scan);
+            size_t skip = level_gfx_entry_payload_size(t, scan);
             if (skip == 0) {
                 if (t != 3 && t != 12) break;
                 continue;
@@ -13652,7 +15291,11 @@ void renderer_build_level_sky_cache(const LevelState *level)
 
     g_level_sky_cache_buckets = (RendererSkyCacheBucket *)calloc((size_t)zone_slots * 2u,
                                                                   sizeof(RendererSkyCacheBucket));
-    if (!g_level_sky_cache_buckets) return;
+    g_level_sky_cache_zone_state = (uint8_t *)calloc((size_t)zone_slots, 1);
+    if (!g_level_sky_cache_buckets || !g_level_sky_cache_zone_state) {
+        renderer_reset_level_sky_cache_internal();
+        return;
+    }
     g_level_sky_cache_zone_slots = zone_slots;
 
     int zone_limit = zone_slots;
@@ -13661,81 +15304,72 @@ void renderer_build_level_sky_cache(const LevelState *level)
     /* Do not clamp by num_zones: some real levels use extra zone_adds slots
      * (num_zone_slots > num_zones), and those slots can be valid runtime zones. */
 
-    for (int zone_id = 0; zone_id < zone_limit; zone_id++) {
-        int32_t zone_off = rd32(level->zone_adds + (size_t)zone_id * 4u);
-        if (zone_off < 0) continue;
-        if (level->data_byte_count > 0 && (size_t)zone_off + 20u > level->data_byte_count) continue;
-        const uint8_t *zone_data = level->data + zone_off;
-
-        const uint8_t *zgraph = level->zone_graph_adds + (size_t)zone_id * 8u;
-        int32_t lower_gfx_off = rd32(zgraph);
-        int32_t upper_gfx_off = rd32(zgraph + 4);
-        int32_t lower_roof_y = rd32(zone_data + ZONE_OFF_ROOF);
-        int32_t upper_roof_raw = rd32(zone_data + ZONE_OFF_UPPER_ROOF);
-        const uint8_t *lower_gfx_data = NULL;
-        const uint8_t *upper_gfx_data = NULL;
-        int zone_backdrop_flag = (rd16(zone_data + ZONE_OFF_BACK) != 0);
-
-        if (lower_gfx_off > 0 &&
-            (level->graphics_byte_count == 0 || ((size_t)lower_gfx_off + 2u) <= level->graphics_byte_count)) {
-            lower_gfx_data = level->graphics + lower_gfx_off;
-        }
-        if (upper_gfx_off > 0 &&
-            (level->graphics_byte_count == 0 || ((size_t)upper_gfx_off + 2u) <= level->graphics_byte_count)) {
-            upper_gfx_data = level->graphics + upper_gfx_off;
+    /* Roofs are snapshotted here: door_routine/lift_routine rewrite ZD_ROOF at runtime, and
+     * the synthesized polygons must not depend on when a zone is first seen. */
+    for (int zone_id = 0; zone_id < zone_slots; zone_id++) {
+        uint8_t zstate = RENDERER_SKY_ZONE_BUILT;
+        if (zone_id < zone_limit) {
+            int32_t zone_off = rd32(level->zone_adds + (size_t)zone_id * 4u);
+            if (zone_off >= 0 &&
+                (level->data_byte_count == 0 || (size_t)zone_off + 20u <= level->data_byte_count)) {
+                const uint8_t *zone_data = level->data + zone_off;
+                zstate = 0;
+                if (rd16(zone_data + ZONE_OFF_BACK) != 0) zstate |= RENDERER_SKY_ZONE_BACKDROP;
+                if (rd32(zone_data + ZONE_OFF_ROOF) < 0) zstate |= RENDERER_SKY_ZONE_LOWER_OPEN;
+                if (rd32(zone_data + ZONE_OFF_UPPER_ROOF) < 0) zstate |= RENDERER_SKY_ZONE_UPPER_OPEN;
+            }
         }
+        g_level_sky_cache_zone_state[zone_id] = zstate;
+    }
+}
 
-        for (int use_upper = 0; use_upper <= 1; use_upper++) {
-            int bucket_idx = zone_id * 2 + use_upper;
-            uint32_t start = g_level_sky_cache_poly_count;
-            g_level_sky_cache_buckets[bucket_idx].start = start;
-            g_level_sky_cache_buckets[bucket_idx].count = 0;
-
-            const uint8_t *gfx_data = use_upper ? upper_gfx_data : lower_gfx_data;
-            if (!gfx_data) continue;
+/* Synthesize one zone's lower/upper backdrop sky polygons on first use. Appends to the
+ * shared poly array (may realloc), so it must run before render workers are dispatched. */
+static void renderer_level_sky_cache_prepare_zone(const LevelState *level, int16_t zone_id)
+{
+    if (!level || !g_level_sky_cache_zone_state) return;
+    if (zone_id < 0 || zone_id >= g_level_sky_cache_zone_slots) return;
+    uint8_t zstate = g_level_sky_cache_zone_state[zone_id];
+    if (zstate & RENDERER_SKY_ZONE_BUILT) return;
+    g_level_sky_cache_zone_state[zone_id] = (uint8_t)(zstate | RENDERER_SKY_ZONE_BUILT);
 
-            int stream_has_backdrop_marker = 0;
-            {
-                const uint8_t *scan = gfx_data + 2;
-                int scan_iter = 500;
-                while (scan_iter-- > 0) {
-                    int16_t t = rd16(scan);
-                    scan += 2;
-                    if (t < 0) break;
-                    if (t == 12) stream_has_backdrop_marker = 1;
+    const uint8_t *zgraph = level->zone_graph_adds + (size_t)zone_id * 8u;
+    int32_t lower_gfx_off = rd32(zgraph);
+    int32_t upper_gfx_off = rd32(zgraph + 4);
+    const uint8_t *lower_gfx_data = NULL;
+    const uint8_t *upper_gfx_data = NULL;
+    int zone_backdrop_flag = (zstate & RENDERER_SKY_ZONE_BACKDROP) ? 1 : 0;
 
-                    {
-                        size_t skip = zone_gfx_entry_data_skip(t, scan);
-                        if (skip == 0) {
-                            if (t != 3 && t != 12) break;
-                            continue;
-                        }
-                        scan += skip;
-                    }
-                }
-            }
+    if (lower_gfx_off > 0 &&
+        (level->graphics_byte_count == 0 || ((size_t)lower_gfx_off + 2u) <= level->graphics_byte_count)) {
+        lower_gfx_data = level->graphics + lower_gfx_off;
+    }
+    if (upper_gfx_off > 0 &&
+        (level->graphics_byte_count == 0 || ((size_t)upper_gfx_off + 2u) <= level->graphics_byte_count)) {
+        upper_gfx_data = level->graphics + upper_gfx_off;
+    }
 
-            int32_t stream_roof_y = use_upper ? upper_roof_raw : lower_roof_y;
-            int roof_open_to_sky = (stream_roof_y < 0) ? 1 : 0;
-            int synth_enabled =
-                ((zone_backdrop_flag || stream_has_backdrop_marker) && roof_open_to_sky) ? 1 : 0;
-            RendererSkyBuildDebug dbg = {0};
+    for (int use_upper = 0; use_upper <= 1; use_upper++) {
+        int bucket_idx = zone_id * 2 + use_upper;
+        uint32_t start = g_level_sky_cache_poly_count;
+        g_level_sky_cache_buckets[bucket_idx].start = start;
+        g_level_sky_cache_buckets[bucket_idx].count = 0;
 
-            if (synth_enabled) {
-                renderer_build_zone_stream_backdrop_sky_cache(use_upper,
-                                                              lower_gfx_data,
-                                                              upper_gfx_data,
-                                                              &dbg);
-            }
-            uint32_t added = g_level_sky_cache_poly_count - start;
-            g_level_sky_cache_buckets[bucket_idx].count = added;
+        const uint8_t *gfx_data = use_upper ? upper_gfx_data : lower_gfx_data;
+        if (!gfx_data) continue;
 
-        }
-    }
+        int roof_open_to_sky = (zstate & (use_upper ? RENDERER_SKY_ZONE_UPPER_OPEN
+                                                    : RENDERER_SKY_ZONE_LOWER_OPEN)) ? 1 : 0;
+        if (!roof_open_to_sky) continue;
+        int stream_has_backdrop_marker = zone_stream_has_entry_type(level, gfx_data, 12);
+        if (!zone_backdrop_flag && !stream_has_backdrop_marker) continue;
 
-    if (g_level_sky_cache_poly_count > 0) {
-        printf("[RENDERER] Sky cache: %u synthesized polygons\n",
-               (unsigned)g_level_sky_cache_poly_count);
+        RendererSkyBuildDebug dbg = {0};
+        renderer_build_zone_stream_backdrop_sky_cache(use_upper,
+                                                      lower_gfx_data,
+                                                      upper_gfx_data,
+                                                      &dbg);
+        g_level_sky_cache_buckets[bucket_idx].count = g_level_sky_cache_poly_count - start;
     }
 }
 
@@ -13747,6 +15381,7 @@ static void renderer_draw_zone_backdrop_sky_ctx(RenderSliceContext *ctx,
     if (zone_roof >= 0) return;
     if (!ctx || !g_level_sky_cache_buckets || !g_level_sky_cache_polys) return;
     if (zone_id < 0 || zone_id >= g_level_sky_cache_zone_slots) return;
+    if (!(g_level_sky_cache_zone_state[zone_id] & RENDERER_SKY_ZONE_BUILT)) return;
 
     int bucket_idx = zone_id * 2 + (use_upper ? 1 : 0);
     RendererSkyCacheBucket b = g_level_sky_cache_buckets[bucket_idx];
@@ -13845,11 +15480,11 @@ static void renderer_draw_zone_ctx(RenderSliceContext *ctx, GameState *state, in
     int has_lift_wall_list = (level->lift_wall_list && level->lift_wall_list_offsets && level->num_lifts > 0);
     int zone_has_door_flag = has_door_wall_list ? 0 : zone_has_door(level->door_data, zone_id);
     int zone_has_lift_flag = has_lift_wall_list ? 0 : zone_has_lift(level->lift_data, zone_id);
-    int current_stream_has_object_entries = zone_stream_has_entry_type(gfx_data, 4);
+    int current_stream_has_object_entries = zone_stream_has_entry_type(level, gfx_data, 4);
     int zone_backdrop_flag = (rd16(zone_data + ZONE_OFF_BACK) != 0);
-    int stream_has_backdrop_marker = zone_stream_has_entry_type(gfx_data, 12);
+    int stream_has_backdrop_marker = zone_stream_has_entry_type(level, gfx_data, 12);
     if (!stream_has_backdrop_marker && other_gfx_data) {
-        stream_has_backdrop_marker = zone_stream_has_entry_type(other_gfx_data, 12);
+        stream_has_backdrop_marker = zone_stream_has_entry_type(level, other_gfx_data, 12);
     }
     int zone_open_sky = ((zone_roof < 0) && (zone_backdrop_flag || stream_has_backdrop_marker)) ? 1 : 0;
     int is_multi_floor_zone = (other_gfx_data != NULL);
@@ -14045,8 +15680,10 @@ static void renderer_draw_zone_ctx(RenderSliceContext *ctx, GameState *state, in
                 /* Amiga seethru path (type 13) clamps d6 to 32; normal walls clamp to 64. */
                 int16_t wall_d6_max = (entry_type == 13) ? 32 : 64;
                 if (!skip_this_wall) {
-                    /* Automap: stage this wall as visible; main thread commits after world pass. */
-                    if (level->points && level->graphics) {
+                    /* Automap: stage this wall as visible; main thread commits after world pass.
+                     * Walls already committed are skipped via the lock-free seen bitmap. */
+                    if (level->points && level->graphics &&
+                        !automap_seen_bit_test(level, wall_gfx_off)) {
                         /* door_wall_list gfx_off points to the wall record starting at the type word. */
                         int16_t wx1 = rd16(level->points + (size_t)p1 * 4u + 0u);
                         int16_t wz1 = rd16(level->points + (size_t)p1 * 4u + 2u);
@@ -14763,6 +16400,7 @@ void renderer_draw_zone(GameState *state, int16_t zone_id, int use_upper)
                               g_renderer.top_clip, g_renderer.bot_clip);
     ctx.wall_top_clip = g_renderer.wall_top_clip;
     ctx.wall_bot_clip = g_renderer.wall_bot_clip;
+    if (state) renderer_level_sky_cache_prepare_zone(&state->level, zone_id);
     renderer_draw_zone_ctx(&ctx, state, zone_id, use_upper);
 }
 
@@ -15073,6 +16711,8 @@ static void renderer_build_world_zone_prepass(GameState *state, uint32_t frame_i
             }
         }
     }
+
+    renderer_build_world_sprite_list(state, &out->sprites);
 }
 
 static void renderer_draw_world_slice(GameState *state,
@@ -15084,6 +16724,7 @@ static void renderer_draw_world_slice(GameState *state,
                                       RendererWorkloadStats *out_workload_stats)
 {
     RenderSliceContext frame_ctx;
+    RendererSpriteStripList strip_sprites;
     int16_t *viewer_floor_occlude_top = NULL;
     int have_viewer_floor_occlude = 0;
     if (out_workload_stats) renderer_workload_stats_reset(out_workload_stats);
@@ -15114,6 +16755,8 @@ static void renderer_draw_world_slice(GameState *state,
     render_slice_context_init(&frame_ctx, (int16_t)cs, (int16_t)ce, strip_top, strip_bot);
     frame_ctx.automap_stage_slot = (int16_t)automap_stage_slot;
     frame_ctx.zone_prepass = zone_prepass;
+    renderer_build_sprite_strip_list(&zone_prepass->sprites, cs, ce, &strip_sprites);
+    frame_ctx.sprite_strip = &strip_sprites;
     /* Column strips assign disjoint x ranges to workers; single-threaded full-width is one worker. */
     frame_ctx.update_column_clip = 1;
     PlayerState *plr = (state->mode == MODE_SLAVE) ? &state->plr2 : &state->plr1;
@@ -15228,7 +16871,8 @@ static void renderer_apply_underwater_tint_slice(int8_t fill_screen_water,
                                                   uint32_t *dst_rgb, uint16_t *dst_cw)
 {
     if (fill_screen_water == 0) return;
-    if (!src_rgb || !src_cw || !dst_rgb || !dst_cw) return;
+    (void)src_rgb;
+    if (!src_cw || !dst_cw || !renderer_rgb_target_ok(dst_rgb)) return;
 
     const int w = g_renderer.width;
     const int h = g_renderer.height;
@@ -15267,7 +16911,7 @@ static void renderer_apply_underwater_tint_slice(int8_t fill_screen_water,
 
 static void renderer_apply_underwater_tint(int8_t fill_screen_water)
 {
-    if (!g_renderer.rgb_buffer || !g_renderer.cw_buffer) return;
+    if (!renderer_rgb_target_ok(g_renderer.rgb_buffer) || !g_renderer.cw_buffer) return;
     renderer_apply_underwater_tint_slice(fill_screen_water,
                                          0, (int16_t)g_renderer.height,
                                          0, (int16_t)g_renderer.width,
@@ -15289,7 +16933,9 @@ void renderer_draw_display(GameState *state)
     int zone_trace = 0;
     int trace_clip = 0;
     g_pick_capture_armed = 0;
+    if (pick_this_frame && !renderer_alloc_pick_planes()) pick_this_frame = 0;
     g_pick_capture_active = pick_this_frame;
+    renderer_select_raster_kernels();
     if (pick_this_frame) {
         renderer_f2_pick_snapshot_clear(&g_renderer_f2_pick_snapshot);
     }
@@ -15303,9 +16949,12 @@ void renderer_draw_display(GameState *state)
         g_renderer_profile_collect_stats = 0;
         return;
     }
+    renderer_frame_arena_begin(-1);
     int prof_on = renderer_profile_env_enabled() ? renderer_profile_enabled() : 0;
+    int timing_on = (prof_on || g_renderer_frame_timing_capture) ? 1 : 0;
     uint64_t frame_perf_freq = 0;
     uint64_t t0 = 0;
+    uint64_t t_after_rotate = 0;
     uint64_t t_after_setup = 0;
     uint64_t t_after_world = 0;
     uint64_t t_after_tint = 0;
@@ -15323,14 +16972,14 @@ void renderer_draw_display(GameState *state)
     int16_t prepass_draw_order[RENDERER_MAX_ZONE_ORDER];
     RendererWorkloadStats world_workload_stats;
     renderer_workload_stats_reset(&world_workload_stats);
-    if (prof_on || pick_this_frame) {
+    if (timing_on || pick_this_frame) {
         frame_perf_freq = SDL_GetPerformanceFrequency();
         if (frame_perf_freq == 0) frame_perf_freq = 1;
         t0 = SDL_GetPerformanceCounter();
     }
     uint32_t frame_idx = g_render_frame_counter++;
     g_renderer_zone_trace_active = 0;
-    g_renderer_profile_collect_stats = (prof_on || pick_this_frame) ? 1 : 0;
+    g_renderer_profile_collect_stats = (timing_on || pick_this_frame) ? 1 : 0;
     automap_refresh_key_mask_cache_for_frame(&state->level, frame_idx);
     if (!automap_door_lookup_matches_level(&state->level)) {
         automap_door_lookup_ensure_for_level(&state->level);
@@ -15349,8 +16998,12 @@ void renderer_draw_display(GameState *state)
         if (n < 0) n = 0;
         if (n > RENDERER_MAX_THREADS) n = RENDERER_MAX_THREADS;
         g_renderer_thread_max_workers = n;
+        g_renderer_thread_schedule = (int)state->cfg_render_thread_schedule;
+        g_renderer_thread_wait = (int)state->cfg_render_thread_wait;
     } else {
         g_renderer_thread_max_workers = 0;
+        g_renderer_thread_schedule = RENDER_THREAD_SCHEDULE_STRIPS;
+        g_renderer_thread_wait = RENDER_THREAD_WAIT_BLOCK;
     }
 #endif
 
@@ -15379,6 +17032,7 @@ void renderer_draw_display(GameState *state)
         r->floor_uv_dist_max = (int32_t)(((int64_t)30000 * (int64_t)ypct + 50) / 100);
         r->floor_uv_dist_near = (int32_t)(((int64_t)32000 * (int64_t)ypct + 50) / 100);
     }
+    /* No-op after allocate_buffers' prefill unless the view outgrows the allocation. */
     renderer_floor_prepare_row_recip_table(h);
 
     /* 2. Setup view transform (from AB3DI.s DrawDisplay lines 3399-3438) */
@@ -15386,6 +17040,7 @@ void renderer_draw_display(GameState *state)
     PlayerState *plr_sky = (state->mode == MODE_SLAVE) ? &state->plr2 : &state->plr1;
     int16_t sky_angpos = (int16_t)plr_sky->angpos;
     r->sky_frame_angpos = sky_angpos;
+    sky_pan_cache_sync(w);
 
     int16_t ang = (int16_t)(plr->angpos & 0x3FFF); /* 14-bit angle */
     r->sinval = sin_lookup(ang);
@@ -15423,6 +17078,8 @@ void renderer_draw_display(GameState *state)
         }
         if (r->clip.z) memset(r->clip.z, 0, (size_t)w * sizeof(int32_t));
         if (r->clip.z2) memset(r->clip.z2, 0, (size_t)w * sizeof(int32_t));
+        if (r->clip.tile_dirty)
+            memset(r->clip.tile_dirty, 1, ((size_t)w + RENDERER_CLIP_TILE_W - 1) >> RENDERER_CLIP_TILE_SHIFT);
     }
     if (pick_this_frame) {
         renderer_pick_clear_active_buffers();
@@ -15450,15 +17107,19 @@ void renderer_draw_display(GameState *state)
             trace_clip = 1;
             renderer_consume_clip_trace_slot();
         }
-        g_renderer_profile_collect_stats = (prof_on || zone_trace || pick_this_frame) ? 1 : 0;
+        g_renderer_profile_collect_stats = (timing_on || zone_trace || pick_this_frame) ? 1 : 0;
         if (trace_clip) {
             printf("[CLIP][frame %u] begin\n", (unsigned)frame_idx);
         }
     }
 
     /* 4. Rotate geometry */
+    uint64_t trace_phase = trace_begin();
     renderer_rotate_level_pts(state);
     renderer_rotate_object_pts(state);
+    if (timing_on) t_after_rotate = SDL_GetPerformanceCounter();
+    trace_end("rotate", trace_phase);
+    trace_phase = trace_begin();
     RendererWorldZonePrepass world_zone_prepass;
     renderer_build_world_zone_prepass(state, frame_idx, trace_clip, &world_zone_prepass);
     prepass_total_zones = world_zone_prepass.count;
@@ -15470,6 +17131,7 @@ void renderer_draw_display(GameState *state)
         if (world_zone_prepass.lower_clip[i].valid) prepass_draw_lower++;
         if (world_zone_prepass.upper_clip[i].valid) prepass_draw_upper++;
         if (world_zone_prepass.lower_clip[i].valid || world_zone_prepass.upper_clip[i].valid) {
+            renderer_level_sky_cache_prepare_zone(&state->level, world_zone_prepass.zone_ids[i]);
             prepass_draw_zones++;
             if (prepass_draw_order_count < RENDERER_MAX_ZONE_ORDER) {
                 prepass_draw_order[prepass_draw_order_count++] = world_zone_prepass.zone_ids[i];
@@ -15483,7 +17145,9 @@ void renderer_draw_display(GameState *state)
     if (zone_trace) {
         renderer_log_world_zone_prepass(state, &world_zone_prepass, frame_idx);
     }
-    if (prof_on) t_after_setup = SDL_GetPerformanceCounter();
+    if (timing_on) t_after_setup = SDL_GetPerformanceCounter();
+    trace_end("prepass", trace_phase);
+    trace_phase = trace_begin();
 
     automap_stage_reset_frame();
 
@@ -15520,7 +17184,9 @@ void renderer_draw_display(GameState *state)
         world_workers = 1;
     }
     automap_commit_staged_walls(&state->level);
-    if (prof_on) t_after_world = SDL_GetPerformanceCounter();
+    if (timing_on) t_after_world = SDL_GetPerformanceCounter();
+    trace_end(used_threaded_world ? "world dispatch" : "world", trace_phase);
+    trace_phase = trace_begin();
 
     int8_t tint_water = fill_screen_water;
     if (state && !state->cfg_post_tint)
@@ -15529,7 +17195,7 @@ void renderer_draw_display(GameState *state)
     /* Save tint value for the GL post-pass (read by display.c after this call). */
     g_renderer.last_fill_screen_water = tint_water;
 
-    /* 6. Underwater fillscrnwater post-pass — skipped when GL multiply handles it (or weapon GL). */
+    /* 6. Underwater fillscrnwater post-pass — skipped when the GL unpack shader masks it (or weapon GL). */
     int used_threaded_tint = 0;
     if (!s_weapon_post_gl_active && !s_gl_water_tint_post_active) {
 #ifndef AB3D_NO_THREADS
@@ -15546,7 +17212,8 @@ void renderer_draw_display(GameState *state)
 #endif
         }
     }
-    if (prof_on) t_after_tint = SDL_GetPerformanceCounter();
+    if (timing_on) t_after_tint = SDL_GetPerformanceCounter();
+    trace_end("tint", trace_phase);
 
     if (g_debug_spill_visualize) {
         renderer_apply_spill_visualize_debug_overlay(&world_zone_prepass, frame_idx);
@@ -15557,7 +17224,7 @@ void renderer_draw_display(GameState *state)
     if (!used_threaded_world && state->cfg_weapon_draw && !s_weapon_post_gl_active) {
         renderer_draw_gun(state);
     }
-    if (prof_on) t_after_gun = SDL_GetPerformanceCounter();
+    if (timing_on) t_after_gun = SDL_GetPerformanceCounter();
 
     /* 8. Swap buffers (the just-drawn buffer becomes the display buffer) */
     /* Flush non-temporal store write-combine buffers before the display path reads cw_buffer. */
@@ -15568,7 +17235,7 @@ void renderer_draw_display(GameState *state)
 
     uint64_t frame_end_counter = 0;
     double frame_ms = 0.0;
-    if (prof_on || pick_this_frame) {
+    if (timing_on || pick_this_frame) {
         frame_end_counter = SDL_GetPerformanceCounter();
         if (t0 > 0 && frame_end_counter >= t0) {
             frame_ms = ((double)(frame_end_counter - t0) * 1000.0) / (double)frame_perf_freq;
@@ -15595,6 +17262,42 @@ void renderer_draw_display(GameState *state)
         g_renderer_f2_pick_snapshot.workload = world_workload_stats;
     }
 
+    if (g_renderer_frame_timing_capture) {
+        RendererFrameTimings *ft = &g_renderer_last_frame_timings;
+        double to_ms = 1000.0 / (double)frame_perf_freq;
+        ft->valid = 1;
+        ft->frame_idx = frame_idx;
+        ft->world_workers = world_workers;
+        ft->total_ms = (double)(frame_end_counter - t0) * to_ms;
+        ft->rotate_ms = (double)(t_after_rotate - t0) * to_ms;
+        ft->prepass_ms = (double)(t_after_setup - t_after_rotate) * to_ms;
+        ft->world_ms = (double)(t_after_world - t_after_setup) * to_ms;
+        ft->tint_ms = (double)(t_after_tint - t_after_world) * to_ms;
+        ft->gun_ms = (double)(t_after_gun - t_after_tint) * to_ms;
+        ft->swap_ms = (double)(frame_end_counter - t_after_gun) * to_ms;
+        ft->wall_cpu_ms = (double)world_workload_stats.ticks_wall * to_ms;
+        ft->floor_cpu_ms = (double)world_workload_stats.ticks_floor * to_ms;
+        ft->sprite_cpu_ms = (double)world_workload_stats.ticks_sprite * to_ms;
+        ft->worker_util = 1.0;
+#ifndef AB3D_NO_THREADS
+        if (used_threaded_world && world_workers > 0 && t_after_world > t_after_setup) {
+            uint64_t busy = 0;
+            for (int i = 0; i < world_workers && i < RENDERER_MAX_THREADS; i++)
+                busy += g_renderer_thread_pool.worker_busy_ticks[i];
+            ft->worker_util = (double)busy /
+                              ((double)world_workers * (double)(t_after_world - t_after_setup));
+        }
+#endif
+        ft->pixel_writes = renderer_workload_estimated_writes(&world_workload_stats);
+        ft->zones_total = prepass_total_zones;
+        ft->zones_drawn = prepass_draw_zones;
+        ft->sprite_candidates = world_zone_prepass.sprites.count;
+        ft->sprite_draws = world_workload_stats.sprite_calls;
+        ft->sprite_pixels_tested = world_workload_stats.sprite_pixels_tested;
+        ft->sprite_pixels_occluded = world_workload_stats.sprite_pixels_wall_occluded +
+                                     world_workload_stats.sprite_pixels_spill_occluded;
+    }
+
     /* Automap is drawn via SDL in display.c after the frame is composited. */
     if (prof_on) {
         RendererProfileState *ps = &g_renderer_profile;
@@ -148,8 +148,19 @@ typedef struct {
     int16_t *top2;
     int16_t *bot2;
     int32_t *z2;   /* span 1 depth; 0 = invalid span */
+    /* Coarse summary per RENDERER_CLIP_TILE_W columns, refreshed lazily from
+     * the spans above: rows every column covers (tile_top > tile_bot = none),
+     * the farthest depth of that cover and the nearest span depth overall. */
+    int16_t *tile_top;
+    int16_t *tile_bot;
+    int32_t *tile_zmax;
+    int32_t *tile_zmin;  /* INT32_MAX = no spans */
+    uint8_t *tile_dirty;
 } ColumnClip;
 
+#define RENDERER_CLIP_TILE_SHIFT 3
+#define RENDERER_CLIP_TILE_W     (1 << RENDERER_CLIP_TILE_SHIFT)
+
 /* -----------------------------------------------------------------------
  * Wall texture table (walltiles)
  *
@@ -193,7 +204,7 @@ typedef struct {
     uint8_t *back_buffer;     /* Back buffer for swap */
 
     /* 32-bit ARGB framebuffer (double-buffered).
-     * Size: width * height * sizeof(uint32_t). */
+     * Size: width * height * sizeof(uint32_t).  NULL unless raster expand is on. */
     uint32_t *rgb_buffer;
     uint32_t *rgb_back_buffer;
 
@@ -317,6 +328,9 @@ void renderer_shutdown(void);
 
 /* Resize framebuffer (call on window resize) */
 void renderer_resize(int w, int h);
+/* Draw at w x h inside the buffers the last renderer_resize allocated (no reallocation).
+ * Returns 0, changing nothing, when w x h does not fit. Main thread, between frames. */
+int renderer_set_view_size(int w, int h);
 
 /* Clear the framebuffer to a color */
 void renderer_clear(uint8_t color);
@@ -328,6 +342,17 @@ void renderer_clear(uint8_t color);
 void renderer_set_sky_assets(const uint8_t *chunky_pixels, int tex_w, int tex_h, size_t data_bytes,
                              const uint8_t *rgb_palette_768);
 
+/* Distance mips for wall and floor textures (2x2 and 4x4 blocks). Each level
+ * keeps the source layout and packing with every block filled by the texel
+ * nearest its mean colour, so samplers swap the pointer and snap addresses.
+ * Wall pixels are the packed column strips after the 2048-byte palette (pal:
+ * brightest 32-entry level); the floor sheet is the 64 KB tile sheet with
+ * its level-0 palette. Sources must outlive the mips; rebuilt on reload. */
+void renderer_build_wall_mips(int tex_id, const uint8_t *pixels, size_t pixel_bytes,
+                              int valshift, const uint8_t *pal);
+void renderer_build_floor_mips(const uint8_t *sheet, size_t sheet_bytes, const uint8_t *floor_pal);
+void renderer_release_texture_mips(void);
+
 /* Swap front/back buffers */
 void renderer_swap(void);
 
@@ -335,6 +360,49 @@ void renderer_swap(void);
  * Translated from AB3DI.s DrawDisplay.
  * After this call, g_renderer.buffer contains the rendered frame. */
 void renderer_draw_display(GameState *state);
+/* Phase times of the last renderer_draw_display, filled while capture is enabled.
+ * *_cpu_ms are summed over all world workers (CPU time, not wall time). */
+typedef struct {
+    int valid;
+    uint32_t frame_idx;
+    int world_workers;
+    double total_ms;
+    double rotate_ms;
+    double prepass_ms;
+    double world_ms;
+    double tint_ms;
+    double gun_ms;
+    double swap_ms;
+    double wall_cpu_ms;
+    double floor_cpu_ms;
+    double sprite_cpu_ms;
+    /* World busy time summed over workers / (workers * world wall time); 1 when drawn inline. */
+    double worker_util;
+    uint64_t pixel_writes;           /* renderer_workload_estimated_writes of the world pass */
+    int zones_total;                 /* zones in the prepass order */
+    int zones_drawn;                 /* zones with a visible lower or upper section */
+    int sprite_candidates;           /* frame sprite list (before clipping) */
+    uint64_t sprite_draws;           /* sprite rect draws (a sprite split across strips counts once per strip) */
+    uint64_t sprite_pixels_tested;
+    uint64_t sprite_pixels_occluded; /* wall or spill depth rejected */
+} RendererFrameTimings;
+
+void renderer_set_frame_timing_capture(int enabled);
+int renderer_get_last_frame_timings(RendererFrameTimings *out);
+
+/* Run fn(i, userdata) for i in [0, count) on the render worker pool, the
+ * caller taking part, with at least min_per_worker indices per thread.
+ * Indices are handed out from a shared counter, so fn writes a per-index
+ * slot and must only read shared state. Runs inline without a pool. Main
+ * thread only, never while a frame is being drawn. Returns the number of
+ * pool workers that took part (0 = ran inline). */
+typedef void (*RendererIndexFn)(int index, void *userdata);
+int renderer_parallel_for(int count, int min_per_worker, RendererIndexFn fn, void *userdata);
+
+/* Free the calling thread's frame arena and scratch tables. Any thread other than the
+ * main thread and the pool workers that calls renderer_draw_display must call this before it exits.
+ * Threads that never draw (loader, audio) get no arena scratch at all. */
+void renderer_release_thread_scratch(void);
 /* Build/reset synthesized backdrop sky-hole polygons for the currently loaded level.
  * Build once after level parse/load, then draw from cache each frame. */
 void renderer_build_level_sky_cache(const LevelState *level);
@@ -379,6 +447,21 @@ void renderer_automap_preallocate_for_level(LevelState *level);
 int renderer_automap_collect_line_segments(GameState *state,
                                            int *x0, int *y0, int *x1, int *y1,
                                            uint16_t *c12, int max_lines);
+/* Seen walls in world units for a persistent GPU buffer (display.c); c12 carries the
+ * same colour/flag bits as renderer_automap_collect_line_segments. */
+typedef struct {
+    int16_t  x1, z1, x2, z2;
+    uint16_t c12;
+} RendererAutomapWall;
+/* Copy seen walls [first, first + max_walls); returns the count copied. The list only
+ * grows by appending; *out_rev changes whenever earlier walls may differ (door colour,
+ * level unload, save restore), and the caller must then re-copy from 0. */
+int renderer_automap_copy_walls(GameState *state, uint32_t first,
+                                RendererAutomapWall *out, int max_walls, uint32_t *out_rev);
+/* Automap view: centre (player world X/Z) and world units per internal pixel. Internal
+ * pixel = (w - 1 - (w/2 + (x - px) / units), h/2 + (z - pz) / units). */
+void renderer_automap_get_view(const GameState *state, int32_t *out_px, int32_t *out_pz,
+                               int32_t *out_units_per_px);
 /* HUD: Amiga12 tint for key condition bit 0..3 (same palette as automap key sprites). */
 uint16_t renderer_key_condition_bit_color_c12(const GameState *state, int bit_index);
 /* HUD: key sprite frame index 0..3 for condition bit (from level key objects / fallback). */
@@ -388,6 +471,13 @@ uintptr_t renderer_key_sprite_hud_cache_tag(const GameState *state);
 int renderer_key_sprite_rasterize_frame_argb(int frame_index, uint32_t *out, int stride_pixels);
 /* Return nearest wall-span depth at (col,row), or 0 when no wall span covers that pixel. */
 int32_t renderer_column_clip_nearest_z_at(int col, int row);
+/* renderer_column_clip_nearest_z_at for columns x0..x1 (inside the view) of
+ * one row, into out_z[0..x1-x0]. Returns 0 when no wall span covers any of
+ * them (out_z need not be read then). */
+int renderer_column_clip_row_nearest_z(int row, int x0, int x1, int32_t *out_z);
+/* 1 when every pixel of [x0,x1] x [y0,y1] lies under a wall span nearer than z
+ * (conservative, from the per-tile summary); 0 = maybe visible. */
+int renderer_column_clip_rect_hidden(int x0, int x1, int y0, int y1, int32_t z);
 
 /* Sub-routines (called by draw_display) */
 void renderer_rotate_level_pts(GameState *state);
@@ -445,8 +535,8 @@ const uint32_t *renderer_get_rgb_buffer(void);
 const uint16_t *renderer_get_cw_buffer(void);
 uint32_t *renderer_get_active_rgb_target(void);
 uint16_t *renderer_get_active_cw_target(void);
-/* When zero (default), raster skips per-pixel ARGB expansion; cw_buffer is authoritative for display. */
-void renderer_set_rgb_raster_expand(int enabled);
+/* When zero (default), raster skips per-pixel ARGB expansion and the ARGB planes are not allocated;
+ * cw_buffer is authoritative for display. */
 int renderer_get_rgb_raster_expand(void);
 uint16_t renderer_argb_to_amiga12(uint32_t argb);
 int renderer_get_width(void);
@@ -14,6 +14,9 @@
  *   5. For each part, iterate its polygon list (matching polyloo).
  *      For each polygon: decode edge-stream perimeter, back-face cull, then
  *      flat-shade filled scan-line fill.
+ *
+ * poly_obj_load decodes the .vec stream once into native point rows and
+ * validated polygon/vertex arrays; the draw only reads those.
  */
 
 #include "renderer_3dobj.h"
@@ -25,10 +28,32 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <limits.h>
+#include <math.h>
 #include <SDL.h>
 #include "logging.h"
 #define printf ab3d_log_printf
 
+#if defined(__SSE2__) || (defined(_MSC_VER) && (defined(_M_AMD64) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)))
+#include <emmintrin.h>
+#define AB3D_HAVE_SSE2 1
+#else
+#define AB3D_HAVE_SSE2 0
+#endif
+
+#if !AB3D_HAVE_SSE2 && (defined(__ARM_NEON) || defined(__ARM_NEON__) || (defined(_MSC_VER) && defined(_M_ARM64)))
+#include <arm_neon.h>
+#define AB3D_HAVE_NEON 1
+#else
+#define AB3D_HAVE_NEON 0
+#endif
+
+#if defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define AB3D_HAVE_WASM_SIMD 1
+#else
+#define AB3D_HAVE_WASM_SIMD 0
+#endif
+
 /* -----------------------------------------------------------------------
  * Global POLYOBJECTS table
  * ----------------------------------------------------------------------- */
@@ -64,6 +89,146 @@ static inline int16_t vec_rd16(const uint8_t *p)
     return (int16_t)(((uint16_t)p[0] << 8) | p[1]);
 }
 
+/* Largest perimeter a polygon may have (larger records are skipped). */
+#define MAX_POLY_VERTS    16
+
+static uint32_t g_poly_generation = 0;
+
+/* Walk one part's polygon list the way polyloo does, keeping the records the
+ * draw would accept (3..MAX_POLY_VERTS perimeter points, all indices valid).
+ * With polys == NULL only the counts are accumulated. */
+static void vec_decode_part(const VecObject *vo, int part,
+                            VecPoly *polys, VecPolyVert *verts,
+                            int *poly_count, int *vert_count)
+{
+    int poly_off = (int)vo->part_poly_off[part];
+    if (poly_off + 2 > (int)vo->size) return;
+    const uint8_t *poly_ptr = vo->data + poly_off;
+    int bytes_left = (int)vo->size - poly_off;
+    int np = vo->num_points;
+
+    while (bytes_left >= 2) {
+        const uint8_t *poly_start = poly_ptr;
+        int16_t lines_to_draw = vec_rd16(poly_start);
+        if (lines_to_draw < 0) break;  /* end-of-list marker */
+
+        int poly_size = 18 + lines_to_draw * 4;
+        if (poly_size <= 0 || poly_size > bytes_left) break;
+        poly_ptr   += poly_size;
+        bytes_left -= poly_size;
+
+        /* Sliding edge stream: lines_to_draw + 1 unique perimeter points,
+         * the next record repeats the first one for closure. */
+        int num_verts = lines_to_draw + 1;
+        if (num_verts < 3 || num_verts > MAX_POLY_VERTS) continue;
+
+        int bad_index = 0;
+        for (int v = 0; v < num_verts; v++) {
+            int pt = (int)(uint16_t)vec_rd16(poly_start + 4 + v * 4);
+            if (pt >= np) bad_index = 1;
+        }
+        if (bad_index) continue;
+
+        if (polys) {
+            /* texture_map_index, brightness divisor, pregour live at:
+             *   poly + 12 + d0*4, +14 + d0*4, +16 + d0*4 */
+            uint16_t preholes_word = (uint16_t)vec_rd16(poly_start + 2);
+            const uint8_t *extra = poly_start + 12 + lines_to_draw * 4;
+            uint16_t tex_map = 0;
+            int shade_div = 1;
+            uint16_t pregour_word = 0;
+            if (extra + 6 <= vo->data + vo->size) {
+                tex_map = (uint16_t)vec_rd16(extra);
+                shade_div = (int)vec_rd16(extra + 2);
+                pregour_word = (uint16_t)vec_rd16(extra + 4);
+            }
+            if (shade_div < 0) shade_div = -shade_div;
+            if (shade_div == 0) shade_div = 1;
+
+            VecPoly *vp = &polys[*poly_count];
+            vp->first_vert = (uint32_t)*vert_count;
+            vp->num_verts = (uint8_t)num_verts;
+            /* On Amiga the word write lands on adjacent bytes:
+             * low byte of preholes -> Holes, low byte of pregour -> Gouraud. */
+            vp->use_holes = (preholes_word & 0x00FF) != 0;
+            vp->use_gouraud = (pregour_word & 0x00FF) != 0;
+            vp->tex_map = tex_map;
+            vp->shade_div = (int16_t)(shade_div > INT16_MAX ? INT16_MAX : shade_div);
+            for (int v = 0; v < num_verts; v++) {
+                const uint8_t *vrec = poly_start + 4 + v * 4;
+                VecPolyVert *pv = &verts[*vert_count + v];
+                pv->point = (uint8_t)vec_rd16(vrec);
+                pv->u = vrec[2];
+                pv->v = vrec[3];
+            }
+        }
+        (*poly_count)++;
+        *vert_count += num_verts;
+    }
+}
+
+/* Native copies of the frame points and polygon lists. */
+static int vec_decode(VecObject *vo)
+{
+    int np = vo->num_points;
+    int nf = vo->num_frames;
+    int stride = (np + VEC_POINT_BATCH - 1) / VEC_POINT_BATCH * VEC_POINT_BATCH;
+
+    vo->point_stride = stride;
+    vo->frame_xz = (int16_t *)calloc((size_t)nf * (size_t)stride * 2u, sizeof(int16_t));
+    vo->frame_y = (int16_t *)calloc((size_t)nf * (size_t)stride, sizeof(int16_t));
+    if (!vo->frame_xz || !vo->frame_y) return 0;
+
+    for (int f = 0; f < nf; f++) {
+        int off = (int)vo->frame_off[f];
+        if (off + np * 6 > (int)vo->size) continue;
+        const uint8_t *pts = vo->data + off;
+        int16_t *xz = vo->frame_xz + (size_t)f * (size_t)stride * 2u;
+        int16_t *y = vo->frame_y + (size_t)f * (size_t)stride;
+        for (int i = 0; i < np; i++) {
+            xz[i * 2 + 0] = vec_rd16(pts + i * 6 + 0);
+            y[i]          = vec_rd16(pts + i * 6 + 2);
+            xz[i * 2 + 1] = vec_rd16(pts + i * 6 + 4);
+        }
+        vo->frame_valid |= 1u << f;
+    }
+
+    int poly_count = 0, vert_count = 0;
+    for (int p = 0; p < vo->num_parts; p++)
+        vec_decode_part(vo, p, NULL, NULL, &poly_count, &vert_count);
+    vo->polys = (VecPoly *)calloc((size_t)(poly_count > 0 ? poly_count : 1), sizeof(VecPoly));
+    vo->poly_verts = (VecPolyVert *)calloc((size_t)(vert_count > 0 ? vert_count : 1), sizeof(VecPolyVert));
+    if (!vo->polys || !vo->poly_verts) return 0;
+
+    poly_count = 0;
+    vert_count = 0;
+    for (int p = 0; p < vo->num_parts; p++) {
+        int first = poly_count;
+        vec_decode_part(vo, p, vo->polys, vo->poly_verts, &poly_count, &vert_count);
+        vo->part_first_poly[p] = (uint32_t)first;
+        vo->part_num_polys[p] = (uint16_t)(poly_count - first);
+
+        /* sort_off is a byte offset into boxrot[] where each entry is 10 bytes
+         * (4 + 4 + 2).  Recover the point index as sort_off / 10. */
+        int sort_pt = (int)vo->part_sort_off[p] / 10;
+        if (sort_pt >= np) sort_pt = 0;
+        vo->part_sort_pt[p] = (uint8_t)sort_pt;
+    }
+    vo->num_polys = poly_count;
+    return 1;
+}
+
+void poly_obj_unload(int slot)
+{
+    if (slot < 0 || slot >= POLY_OBJECTS_COUNT) return;
+    VecObject *vo = &g_poly_objects[slot];
+    free(vo->frame_xz);
+    free(vo->frame_y);
+    free(vo->polys);
+    free(vo->poly_verts);
+    memset(vo, 0, sizeof(*vo));
+}
+
 /* -----------------------------------------------------------------------
  * poly_obj_load: parse a .vec binary into a slot
  * ----------------------------------------------------------------------- */
@@ -71,7 +236,7 @@ int poly_obj_load(int slot, const uint8_t *data, size_t size)
 {
     if (slot < 0 || slot >= POLY_OBJECTS_COUNT) return 0;
     VecObject *vo = &g_poly_objects[slot];
-    memset(vo, 0, sizeof(*vo));
+    poly_obj_unload(slot);
 
     if (!data || size < 6) return 0;
 
@@ -107,8 +272,16 @@ int poly_obj_load(int slot, const uint8_t *data, size_t size)
     }
     vo->num_parts = num_parts;
 
-    printf("[3DOBJ] Slot %d: %d pts, %d frames, %d parts (size=%zu)\n",
-           slot, vo->num_points, vo->num_frames, vo->num_parts, size);
+    if (!vec_decode(vo)) {
+        printf("[3DOBJ] Slot %d: out of memory decoding\n", slot);
+        poly_obj_unload(slot);
+        return 0;
+    }
+    if (++g_poly_generation == 0) g_poly_generation = 1;
+    vo->generation = g_poly_generation;
+
+    printf("[3DOBJ] Slot %d: %d pts, %d frames, %d parts, %d polys (size=%zu)\n",
+           slot, vo->num_points, vo->num_frames, vo->num_parts, vo->num_polys, size);
     return 1;
 }
 
@@ -236,15 +409,28 @@ static inline void poly_cw_store_xy(uint16_t *cw, int x, int y, int width, int h
 /* -----------------------------------------------------------------------
  * Per-vertex screen coordinate cache (shared across all polygons in one
  * draw call, reset for each object).
+ *
+ * The rotobj result depends only on (mesh, frame, relative angle), so each
+ * thread keeps the last one per POLYOBJECTS slot: identical barrels and
+ * pickups seen from one viewpoint share a facing and skip the rotation.
  * ----------------------------------------------------------------------- */
-typedef struct { int32_t x, y; int16_t z; } BoxRot;
-typedef struct { int32_t x, y, z; int16_t vb; } ObjVertex;
+typedef struct { int32_t x, y, z; int16_t vb; int in_front; int sx, sy; } ObjVertex;
 typedef struct { int32_t x, y, z; int32_t u, v; int16_t vb; } PolyVertex;
 
 typedef struct {
-    BoxRot boxrot[MAX_POLY_POINTS];
-    int16_t boxbrights[MAX_POLY_POINTS];
+    uint32_t generation;        /* VecObject.generation; 0 = empty */
+    int frame, ang;
+    int32_t min_z;
+    int32_t x[MAX_POLY_POINTS]; /* boxrot x: (x*sin - z*cos) >> 7 */
+    int32_t y[MAX_POLY_POINTS]; /* boxrot y: y << 8 */
+    int32_t z[MAX_POLY_POINTS]; /* boxrot z: int16 (x*cos + z*sin) >> 14 */
+    int32_t vb[MAX_POLY_POINTS];/* boxbrights: (z + 20) >> 2, 0..13 */
+} PolyRotCache;
+
+typedef struct {
+    PolyRotCache rot[POLY_OBJECTS_COUNT];
     ObjVertex world[MAX_POLY_POINTS];
+    int32_t span_wall_z[RENDER_INTERNAL_MAX_DIM]; /* one row of wall depths */
 } PolyThreadContext;
 
 static SDL_TLSID g_poly_thread_tls_id = 0;
@@ -258,7 +444,6 @@ static SDL_SpinLock g_poly_thread_tls_lock = 0;
  * g_renderer.rgb_buffer.  Uses a simple span-table (min_x/max_x per row).
  * ----------------------------------------------------------------------- */
 #define POLY_MAX_HEIGHT   (RENDER_HEIGHT)
-#define MAX_POLY_VERTS    16
 #define MAX_CLIP_VERTS    (MAX_POLY_VERTS + 2)
 #define OBJ_NEAR_Z        4
 
@@ -267,8 +452,6 @@ static PolyVertex intersect_near_plane(const PolyVertex *a, const PolyVertex *b,
 static int clip_polygon_to_near(const PolyVertex *in, int in_count,
                                 PolyVertex *out, int max_out, int32_t near_z);
 static int poly_textures_ready(void);
-static uint8_t sample_poly_texel_index(uint16_t tex_map_word,
-                                       int32_t u_fixed, int32_t v_fixed);
 static void draw_textured_polygon(const int *sx, const int *sy,
                                   const int32_t *sz,
                                   const int32_t *u, const int32_t *v,
@@ -312,6 +495,146 @@ static PolyThreadContext *poly_thread_context_get(void)
     return ctx;
 }
 
+/* rotobj over one frame, VEC_POINT_BATCH points per step. The Amiga
+ * doubles each raw coordinate before muls (add.w d,d), then:
+ *   boxrot[i].x = (x*2*sin - z*2*cos) >> 8 = (x*sin - z*cos) >> 7  (int32)
+ *   boxrot[i].y = y*2 << 7                  = y << 8               (int32)
+ *   boxrot[i].z = ((x*cos + z*sin)*4) >> 16 = (x*cos+z*sin) >> 14  (int16)
+ * and the per-vertex brightness is (z + 20) / 4 clamped to 0..13
+ * (add.w #20 / asr.w #2). Sine values stay within +-16384, so every product
+ * pair fits the 16x16->32 multiply-add. Rows are zero padded to the stride. */
+static void poly_rotate_points(const int16_t *xz, const int16_t *ys, int n,
+                               int16_t sin_v, int16_t cos_v, PolyRotCache *out)
+{
+    int i = 0;
+#if AB3D_HAVE_SSE2
+    const __m128i kx = _mm_set1_epi32((int)(((uint32_t)(uint16_t)(int16_t)-cos_v << 16) | (uint16_t)sin_v));
+    const __m128i kz = _mm_set1_epi32((int)(((uint32_t)(uint16_t)sin_v << 16) | (uint16_t)cos_v));
+    const __m128i b20 = _mm_set1_epi32(20);
+    const __m128i lo = _mm_setzero_si128();
+    const __m128i hi = _mm_set1_epi16(13);
+    for (; i + VEC_POINT_BATCH <= n; i += VEC_POINT_BATCH) {
+        __m128i p = _mm_loadu_si128((const __m128i *)(xz + i * 2));
+        __m128i y = _mm_loadl_epi64((const __m128i *)(ys + i));
+        __m128i rx = _mm_srai_epi32(_mm_madd_epi16(p, kx), 7);
+        __m128i rz = _mm_srai_epi32(_mm_madd_epi16(p, kz), 14);
+        rz = _mm_srai_epi32(_mm_slli_epi32(rz, 16), 16);          /* int16 wrap */
+        __m128i ry = _mm_slli_epi32(_mm_srai_epi32(_mm_unpacklo_epi16(y, y), 16), 8);
+        __m128i vb = _mm_srai_epi32(_mm_add_epi32(rz, b20), 2);
+        vb = _mm_packs_epi32(vb, vb);
+        vb = _mm_min_epi16(_mm_max_epi16(vb, lo), hi);
+        vb = _mm_srai_epi32(_mm_unpacklo_epi16(vb, vb), 16);
+        _mm_storeu_si128((__m128i *)(out->x + i), rx);
+        _mm_storeu_si128((__m128i *)(out->y + i), ry);
+        _mm_storeu_si128((__m128i *)(out->z + i), rz);
+        _mm_storeu_si128((__m128i *)(out->vb + i), vb);
+    }
+#elif AB3D_HAVE_NEON
+    const int16x4_t vs = vdup_n_s16(sin_v);
+    const int16x4_t vc = vdup_n_s16(cos_v);
+    const int32x4_t b20 = vdupq_n_s32(20);
+    const int32x4_t lo = vdupq_n_s32(0);
+    const int32x4_t hi = vdupq_n_s32(13);
+    for (; i + VEC_POINT_BATCH <= n; i += VEC_POINT_BATCH) {
+        int16x4x2_t p = vld2_s16(xz + i * 2);                    /* val[0]=x, val[1]=z */
+        int32x4_t rx = vshrq_n_s32(vmlsl_s16(vmull_s16(p.val[0], vs), p.val[1], vc), 7);
+        int16x4_t rz16 = vmovn_s32(vshrq_n_s32(vmlal_s16(vmull_s16(p.val[0], vc), p.val[1], vs), 14));
+        int32x4_t rz = vmovl_s16(rz16);
+        int32x4_t ry = vshll_n_s16(vld1_s16(ys + i), 8);
+        int32x4_t vb = vshrq_n_s32(vaddq_s32(rz, b20), 2);
+        vb = vminq_s32(vmaxq_s32(vb, lo), hi);
+        vst1q_s32(out->x + i, rx);
+        vst1q_s32(out->y + i, ry);
+        vst1q_s32(out->z + i, rz);
+        vst1q_s32(out->vb + i, vb);
+    }
+#elif AB3D_HAVE_WASM_SIMD
+    const v128_t kx = wasm_i16x8_make(sin_v, (int16_t)-cos_v, sin_v, (int16_t)-cos_v,
+                                      sin_v, (int16_t)-cos_v, sin_v, (int16_t)-cos_v);
+    const v128_t kz = wasm_i16x8_make(cos_v, sin_v, cos_v, sin_v, cos_v, sin_v, cos_v, sin_v);
+    const v128_t b20 = wasm_i32x4_splat(20);
+    const v128_t lo = wasm_i32x4_splat(0);
+    const v128_t hi = wasm_i32x4_splat(13);
+    for (; i + VEC_POINT_BATCH <= n; i += VEC_POINT_BATCH) {
+        v128_t p = wasm_v128_load(xz + i * 2);
+        v128_t rx = wasm_i32x4_shr(wasm_i32x4_dot_i16x8(p, kx), 7);
+        v128_t rz = wasm_i32x4_shr(wasm_i32x4_dot_i16x8(p, kz), 14);
+        rz = wasm_i32x4_shr(wasm_i32x4_shl(rz, 16), 16);          /* int16 wrap */
+        v128_t ry = wasm_i32x4_shl(wasm_i32x4_load16x4(ys + i), 8);
+        v128_t vb = wasm_i32x4_shr(wasm_i32x4_add(rz, b20), 2);
+        vb = wasm_i32x4_min(wasm_i32x4_max(vb, lo), hi);
+        wasm_v128_store(out->x + i, rx);
+        wasm_v128_store(out->y + i, ry);
+        wasm_v128_store(out->z + i, rz);
+        wasm_v128_store(out->vb + i, vb);
+    }
+#endif
+    for (; i < n; i++) {
+        int32_t lx = xz[i * 2 + 0];
+        int32_t lz = xz[i * 2 + 1];
+        int16_t rz = (int16_t)((lx * cos_v + lz * sin_v) >> 14);
+        int vb = ((int)rz + 20) >> 2;
+        if (vb < 0)  vb = 0;
+        if (vb > 13) vb = 13;
+        out->x[i] = (lx * sin_v - lz * cos_v) >> 7;
+        out->y[i] = (int32_t)ys[i] << 8;
+        out->z[i] = rz;
+        out->vb[i] = vb;
+    }
+}
+
+/* Relative rotation angle: the Amiga subtracts 2048 (ANGLE_90, 90 degrees)
+ * and the viewer angle from objVectFacing (obj[30]). */
+static int poly_relative_angle(const uint8_t *obj, const GameState *state)
+{
+    int16_t facing = vec_rd16(obj + 30);
+    const PlayerState *plr = (state->mode == MODE_SLAVE) ? &state->plr2 : &state->plr1;
+    int viewer_ang = (int)(plr->angpos & ANGLE_MASK);
+    return ((int)facing - ANGLE_90 - viewer_ang) & ANGLE_MASK;
+}
+
+/* ObjDraw3 PolygonObj forces frame 0:
+ *   moveq #0,d5
+ *   move.w (a4,d5.w*2),d5
+ * The objVectFrameNumber path exists only in commented-out code. */
+static int poly_object_frame(const uint8_t *obj, const VecObject *vo)
+{
+    int frame_num = 0;
+    if (g_poly_use_object_frame) {
+        frame_num = (int)vec_rd16(obj + 10);
+        if (frame_num < 0 || frame_num >= vo->num_frames) frame_num = 0;
+    }
+    return frame_num;
+}
+
+/* Rotated points of slot/frame at rel_ang, from the thread's cache when the
+ * same facing was the last one drawn for that slot. NULL when the frame is
+ * not usable. */
+static const PolyRotCache *poly_rotated_frame(PolyThreadContext *ctx, int slot,
+                                              int frame, int rel_ang)
+{
+    const VecObject *vo = &g_poly_objects[slot];
+    if (!(vo->frame_valid & (1u << frame))) return NULL;
+
+    PolyRotCache *rc = &ctx->rot[slot];
+    if (rc->generation == vo->generation && rc->frame == frame && rc->ang == rel_ang)
+        return rc;
+
+    int np = vo->num_points;
+    poly_rotate_points(vo->frame_xz + (size_t)frame * (size_t)vo->point_stride * 2u,
+                       vo->frame_y + (size_t)frame * (size_t)vo->point_stride,
+                       vo->point_stride, sin_lookup(rel_ang), cos_lookup(rel_ang), rc);
+    int32_t min_z = INT32_MAX;
+    for (int i = 0; i < np; i++) {
+        if (rc->z[i] < min_z) min_z = rc->z[i];
+    }
+    rc->min_z = min_z;
+    rc->generation = vo->generation;
+    rc->frame = frame;
+    rc->ang = rel_ang;
+    return rc;
+}
+
 static void trace_edge(int x0, int y0, int x1, int y1,
                        int y_base, int y_limit,
                        int *span_min, int *span_max)
@@ -349,7 +672,7 @@ static void draw_filled_polygon(const int *sx, const int *sy, int n,
 {
     uint32_t *rgb = renderer_get_active_rgb_target();
     uint16_t *cw = renderer_get_active_cw_target();
-    if (n < 3 || !rgb || !cw) return;
+    if (n < 3 || (!rgb && renderer_get_rgb_raster_expand()) || !cw) return;
 
     int min_y = sy[0], max_y = sy[0];
     for (int i = 1; i < n; i++) {
@@ -384,7 +707,7 @@ static void draw_filled_polygon(const int *sx, const int *sy, int n,
         if (x0 < clip_left)  x0 = clip_left;
         if (x1 > clip_right) x1 = clip_right;
         if (x0 > x1) continue;
-        uint32_t *row = rgb + (size_t)y * W;
+        uint32_t *row = rgb ? rgb + (size_t)y * W : NULL;
         for (int x = x0; x <= x1; x++) {
             if (renderer_get_rgb_raster_expand())
                 row[x] = color;
@@ -433,37 +756,13 @@ int32_t poly_object_front_z_for_sort(const uint8_t *obj, const ObjRotatedPoint *
     VecObject *vo = &g_poly_objects[vect_num];
     if (!vo->data || vo->num_points <= 0 || vo->num_frames <= 0) return orp->z;
 
-    int frame_num = 0;
-    if (g_poly_use_object_frame) {
-        frame_num = (int)vec_rd16(obj + 10);
-        if (frame_num < 0 || frame_num >= vo->num_frames) frame_num = 0;
-    }
-
-    int frame_byte_off = (int)vo->frame_off[frame_num];
-    int np = vo->num_points;
-    if (np > MAX_POLY_POINTS) np = MAX_POLY_POINTS;
-    if (frame_byte_off < 0 || frame_byte_off + np * 6 > (int)vo->size) return orp->z;
-
-    int16_t facing = vec_rd16(obj + 30);
-    const PlayerState *plr = (state->mode == MODE_SLAVE) ? &state->plr2 : &state->plr1;
-    int viewer_ang = (int)(plr->angpos & ANGLE_MASK);
-    int rel_ang = (int)facing - ANGLE_90 - viewer_ang;
-    rel_ang &= ANGLE_MASK;
-
-    int16_t sin_v = sin_lookup(rel_ang);
-    int16_t cos_v = cos_lookup(rel_ang);
-
-    const uint8_t *pts = vo->data + frame_byte_off;
-    int32_t min_world_z = INT32_MAX;
-    for (int i = 0; i < np; i++) {
-        int16_t lx = vec_rd16(pts + i * 6 + 0);
-        int16_t lz = vec_rd16(pts + i * 6 + 4);
-        int16_t rz = (int16_t)(((int32_t)lx * cos_v + (int32_t)lz * sin_v) >> 14);
-        int32_t world_z = orp->z + ((int32_t)rz << ROT_Z_FRAC_BITS);
-        if (world_z < min_world_z) min_world_z = world_z;
-    }
-
-    return (min_world_z == INT32_MAX) ? orp->z : min_world_z;
+    PolyThreadContext *thread_ctx = poly_thread_context_get();
+    if (!thread_ctx) return orp->z;
+    const PolyRotCache *rc = poly_rotated_frame(thread_ctx, vect_num,
+                                                poly_object_frame(obj, vo),
+                                                poly_relative_angle(obj, state));
+    if (!rc || rc->min_z == INT32_MAX) return orp->z;
+    return orp->z + (rc->min_z << ROT_Z_FRAC_BITS);
 }
 
 /* -----------------------------------------------------------------------
@@ -493,19 +792,9 @@ void draw_3d_vector_object(const uint8_t *obj, const ObjRotatedPoint *orp, GameS
     int32_t z_mid      = orp->z;              /* 24.8 fixed-point */
     int obj_bright_base = (int)(ROT_Z_INT(z_mid) >> 7) + (int)obj_bright;
 
-    /* ---- 2. Relative rotation angle ---------------------------------- */
-    /* Amiga: angpos = (objAng - 2048 - viewer_angpos) & 8191
-     * where angpos uses byte-indexed sine table (even entries only).
-     * We read objVectFacing from offset 30 (a2-field before a0 advanced). */
-    int16_t facing  = vec_rd16(obj + 30);  /* objVectFacing */
-    PlayerState *plr = (state->mode == MODE_SLAVE) ? &state->plr2 : &state->plr1;
-    int viewer_ang  = (int)(plr->angpos & ANGLE_MASK); /* 0..8191 */
-    /* Amiga subtracts 2048 (= ANGLE_90 bytes = 90 degrees) before viewer angle */
-    int rel_ang = (int)facing - ANGLE_90 - viewer_ang;
-    rel_ang &= ANGLE_MASK;   /* wrap to 0..8191 */
-
-    int16_t sin_v = sin_lookup(rel_ang);
-    int16_t cos_v = cos_lookup(rel_ang);
+    /* ---- 2/4. Relative rotation angle and animation frame ------------- */
+    int rel_ang = poly_relative_angle(obj, state);
+    int frame_num = poly_object_frame(obj, vo);
 
     /* ---- 3. Y-axis offset for object --------------------------------- */
     /* ObjDraw3 PolygonObj @ convtoscr: move.w 2(a0),d2 / ext.l d2 / asl.l #7,d2 / sub.l yoff,d2
@@ -513,56 +802,19 @@ void draw_3d_vector_object(const uint8_t *obj, const ObjRotatedPoint *orp, GameS
     int16_t obj_y4 = vec_rd16(obj + 4);
     int32_t y_adjust = ((int32_t)obj_y4 << 7) - r->yoff;
 
-    /* ---- 4. Select animation frame ----------------------------------- */
-    /* ObjDraw3 PolygonObj currently forces frame 0:
-     *   moveq #0,d5
-     *   move.w (a4,d5.w*2),d5
-     * The objVectFrameNumber path exists only in commented-out code. */
-    int frame_num = 0;
-    if (g_poly_use_object_frame) {
-        frame_num = (int)vec_rd16(obj + 10);
-        if (frame_num < 0 || frame_num >= vo->num_frames) frame_num = 0;
-    }
-    int frame_byte_off = (int)vo->frame_off[frame_num];
-    if (frame_byte_off + vo->num_points * 6 > (int)vo->size) return;
-    const uint8_t *pts = vo->data + frame_byte_off;
+    /* ---- 5. rotobj: rotate all vertices ------------------------------ */
     PolyThreadContext *thread_ctx = poly_thread_context_get();
     if (!thread_ctx) return;
-    BoxRot *boxrot = thread_ctx->boxrot;
-    int16_t *boxbrights = thread_ctx->boxbrights;
+    const PolyRotCache *rot = poly_rotated_frame(thread_ctx, vect_num, frame_num, rel_ang);
+    if (!rot) return;
     ObjVertex *world = thread_ctx->world;
 
-    /* ---- 5. rotobj: rotate all vertices ------------------------------ */
-    /* Amiga doubles each raw coordinate before muls (add.w d,d), then:
-     *   boxrot[i].x = (x*2*sin - z*2*cos) >> 8 = (x*sin - z*cos) >> 7  (int32)
-     *   boxrot[i].y = y*2 << 7                  = y << 8               (int32)
-     *   boxrot[i].z = ((x*cos + z*sin)*4) >> 16 = (x*cos+z*sin) >> 14  (int16)
-     */
-    int np = vo->num_points;
-    for (int i = 0; i < np; i++) {
-        int16_t lx = vec_rd16(pts + i * 6 + 0);
-        int16_t ly = vec_rd16(pts + i * 6 + 2);
-        int16_t lz = vec_rd16(pts + i * 6 + 4);
-
-        int32_t rx = ((int32_t)lx * sin_v - (int32_t)lz * cos_v) >> 7;
-        int32_t ry = (int32_t)ly << 8;
-        int16_t rz = (int16_t)(((int32_t)lx * cos_v + (int32_t)lz * sin_v) >> 14);
-
-        boxrot[i].x = rx;
-        boxrot[i].y = ry;
-        boxrot[i].z = rz;
-
-        /* Per-vertex brightness: (rz + 20) / 4, clamped 0..13 (Amiga add.w #20 / asr.w #2) */
-        int vb = ((int)rz + 20) >> 2;
-        if (vb < 0)  vb = 0;
-        if (vb > 13) vb = 13;
-        boxbrights[i] = (int16_t)vb;
-    }
-
     /* ---- 6. convtoscr prep: translate vertices to world/view --------- */
     /* Keep world-space X/Y/Z per vertex, then clip each polygon against
      * a near plane before projection. This avoids dropping whole faces when
-     * only part of a polygon crosses behind the camera. */
+     * only part of a polygon crosses behind the camera. Vertices in front of
+     * the near plane are projected once here and shared by every face. */
+    int np = vo->num_points;
     int32_t xpos_mid = orp->x_fine;     /* 32-bit view X of object centre */
     int32_t zpos_mid = orp->z;          /* view Z of object centre  */
     int W = r->width, H = r->height;
@@ -573,15 +825,22 @@ void draw_3d_vector_object(const uint8_t *obj, const ObjRotatedPoint *orp, GameS
     int half_h = H / 2;
     int proj_xs = poly_proj_x_scale_px(r, state);
     int32_t proj_ys = r->proj_y_scale;
+    int all_front = 1;
 
     for (int i = 0; i < np; i++) {
-        int32_t worldX = boxrot[i].x + xpos_mid;
-        int32_t worldY = boxrot[i].y + y_adjust;
-        int32_t worldZ = ((int32_t)boxrot[i].z << ROT_Z_FRAC_BITS) + zpos_mid;
-        world[i].x = worldX;
-        world[i].y = worldY;
-        world[i].z = worldZ;
-        world[i].vb = boxbrights[i];
+        ObjVertex *wv = &world[i];
+        wv->x = rot->x[i] + xpos_mid;
+        wv->y = rot->y[i] + y_adjust;
+        wv->z = (rot->z[i] << ROT_Z_FRAC_BITS) + zpos_mid;
+        wv->vb = (int16_t)rot->vb[i];
+        wv->in_front = wv->z >= ROT_Z_FROM_INT(OBJ_NEAR_Z);
+        if (wv->in_front) {
+            wv->sx = (int)(((int64_t)wv->x * (int64_t)proj_xs << ROT_Z_FRAC_BITS) / (int64_t)wv->z) + center_x;
+            wv->sy = (int)(((int64_t)(wv->y >> WORLD_Y_FRAC_BITS) * proj_ys * RENDER_SCALE
+                            << ROT_Z_FRAC_BITS) / wv->z) + half_h;
+        } else {
+            all_front = 0;
+        }
     }
 
     /* ---- 7. PutinParts: depth-sort polygon parts --------------------- */
@@ -598,10 +857,7 @@ void draw_3d_vector_object(const uint8_t *obj, const ObjRotatedPoint *orp, GameS
     int sorted_count = 0;
 
     for (int p = 0; p < nparts; p++) {
-        /* sort_off is a byte offset into boxrot[] where each entry is 10 bytes
-         * (4 + 4 + 2).  Recover the point index as sort_off / 10. */
-        int sort_pt = (int)vo->part_sort_off[p] / 10;
-        if (sort_pt < 0 || sort_pt >= np) sort_pt = 0;
+        int sort_pt = (int)vo->part_sort_pt[p];
 
         /* Match Amiga data source: translated coords (our world[]).
          * world[].z is 24.8 fixed-point; convert to integer for the key. */
@@ -633,93 +889,101 @@ void draw_3d_vector_object(const uint8_t *obj, const ObjRotatedPoint *orp, GameS
     if (clip_t < 0) clip_t = 0;
     if (clip_b >= H) clip_b = H - 1;
 
+    /* Whole-object wall occlusion: with every vertex in front of the near
+     * plane the projected vertex box bounds all faces and the nearest vertex
+     * depth bounds every interpolated pixel depth, so if the column clip
+     * hides that box at that depth no textured pixel can pass. */
+    if (poly_textures_ready() && sorted_count > 0 && all_front) {
+        int bx0 = INT_MAX, bx1 = INT_MIN, by0 = INT_MAX, by1 = INT_MIN;
+        int32_t zmin = INT32_MAX;
+        for (int i = 0; i < np; i++) {
+            if (world[i].sx < bx0) bx0 = world[i].sx;
+            if (world[i].sx > bx1) bx1 = world[i].sx;
+            if (world[i].sy < by0) by0 = world[i].sy;
+            if (world[i].sy > by1) by1 = world[i].sy;
+            if (ROT_Z_INT(world[i].z) < zmin) zmin = ROT_Z_INT(world[i].z);
+        }
+        if (bx0 < clip_l) bx0 = clip_l;
+        if (bx1 > clip_r) bx1 = clip_r;
+        if (by0 < clip_t) by0 = clip_t;
+        if (by1 > clip_b) by1 = clip_b;
+        if (bx0 > bx1 || by0 > by1) return;
+        if (zmin < INT32_MAX && renderer_column_clip_rect_hidden(bx0, bx1, by0, by1, zmin + 1))
+            return;
+    }
+
     for (int si = 0; si < sorted_count; si++) {   /* farthest first (painter's) */
         int pi = sorted[si].part_idx;
-        int poly_off = (int)vo->part_poly_off[pi];
-        if (poly_off + 2 > (int)vo->size) continue;
-        const uint8_t *poly_ptr = vo->data + poly_off;
+        const VecPoly *polys = vo->polys + vo->part_first_poly[pi];
+        int npolys = (int)vo->part_num_polys[pi];
 
         /* Iterate polygon list for this part */
-        int bytes_left = (int)vo->size - poly_off;
-        while (bytes_left >= 2) {
-            const uint8_t *poly_start = poly_ptr;
-            int16_t lines_to_draw = vec_rd16(poly_start);
-            if (lines_to_draw < 0) break;  /* end-of-list marker */
-
-            int poly_size = 18 + lines_to_draw * 4;
-            if (poly_size <= 0 || poly_size > bytes_left) break;
-
-            poly_ptr   += poly_size;
-            bytes_left -= poly_size;
-
-            /* ObjDraw3 encodes polygons as a sliding edge stream.
-             * Unique perimeter vertices = lines_to_draw + 1.
-             * The next record repeats the first point for closure. */
-            int num_verts = lines_to_draw + 1;
-            if (num_verts < 3 || num_verts > MAX_POLY_VERTS) continue;
-
-            int vi[MAX_POLY_VERTS];
-            int bad_index = 0;
-            for (int v = 0; v < num_verts; v++) {
-                const uint8_t *vrec = poly_start + 4 + v * 4;
-                vi[v] = (int)(uint16_t)vec_rd16(vrec);
-                if (vi[v] < 0 || vi[v] >= np) bad_index = 1;
-            }
-            if (bad_index) continue;
-
-            /* texture_map_index, brightness divisor, pregour live at:
-             *   poly + 12 + d0*4, +14 + d0*4, +16 + d0*4 */
-            uint16_t preholes_word = (uint16_t)vec_rd16(poly_start + 2);
-            const uint8_t *extra = poly_start + 12 + lines_to_draw * 4;
-            uint16_t tex_map = 0;
-            int shade_div = 1;
-            uint16_t pregour_word = 0;
-            if (extra + 6 <= vo->data + vo->size) {
-                tex_map = (uint16_t)vec_rd16(extra);
-                shade_div = (int)vec_rd16(extra + 2);
-                pregour_word = (uint16_t)vec_rd16(extra + 4);
-            }
-            if (shade_div < 0) shade_div = -shade_div;
-            if (shade_div == 0) shade_div = 1;
-            /* On Amiga the word write lands on adjacent bytes:
-             * low byte of preholes -> Holes, low byte of pregour -> Gouraud. */
-            int use_holes = ((int)preholes_word & 0x00FF) != 0;
-            int use_gouraud = ((int)pregour_word & 0x00FF) != 0;
-
-            PolyVertex in_poly[MAX_CLIP_VERTS];
-            for (int v = 0; v < num_verts; v++) {
-                const uint8_t *vrec = poly_start + 4 + v * 4;
-                const ObjVertex *sv = &world[vi[v]];
-                in_poly[v].x = sv->x;
-                in_poly[v].y = sv->y;
-                in_poly[v].z = sv->z;
-                in_poly[v].u = (int32_t)vrec[2] << 16;
-                in_poly[v].v = (int32_t)vrec[3] << 16;
-                in_poly[v].vb = sv->vb;
-            }
-
-            PolyVertex clipped_poly[MAX_CLIP_VERTS];
-            int clipped_n = clip_polygon_to_near(in_poly, num_verts, clipped_poly,
-                                                 MAX_CLIP_VERTS, ROT_Z_FROM_INT(OBJ_NEAR_Z));
-            if (clipped_n < 3) continue;
+        for (int pn = 0; pn < npolys; pn++) {
+            const VecPoly *vp = &polys[pn];
+            const VecPolyVert *pv = vo->poly_verts + vp->first_vert;
+            int num_verts = (int)vp->num_verts;
+            uint16_t tex_map = vp->tex_map;
+            int shade_div = (int)vp->shade_div;
+            int use_holes = vp->use_holes;
+            int use_gouraud = vp->use_gouraud;
 
             int sx[MAX_CLIP_VERTS], sy[MAX_CLIP_VERTS];
             int32_t sz[MAX_CLIP_VERTS];
             int32_t su[MAX_CLIP_VERTS], svt[MAX_CLIP_VERTS];
             int16_t shade_values[MAX_CLIP_VERTS];
-            for (int v = 0; v < clipped_n; v++) {
-                int32_t wz = clipped_poly[v].z;
-                if (wz <= 0) wz = 1;
-                sx[v] = (int)(((int64_t)clipped_poly[v].x * (int64_t)proj_xs << ROT_Z_FRAC_BITS) / (int64_t)wz) + center_x;
-                sy[v] = (int)(((int64_t)(clipped_poly[v].y >> WORLD_Y_FRAC_BITS) * proj_ys * RENDER_SCALE
-                              << ROT_Z_FRAC_BITS) / wz) + half_h;
-                sz[v] = ROT_Z_INT(wz);
-                su[v] = clipped_poly[v].u;
-                svt[v] = clipped_poly[v].v;
-                int vb = (int)clipped_poly[v].vb;
-                if (vb < 0) vb = 0;
-                if (vb > 14) vb = 14;
-                shade_values[v] = (int16_t)vb;
+            int clipped_n = num_verts;
+
+            int poly_front = 1;
+            for (int v = 0; v < num_verts; v++) {
+                if (!world[pv[v].point].in_front) { poly_front = 0; break; }
+            }
+            if (poly_front) {
+                /* Nothing to clip: use the shared projections, starting at the
+                 * second vertex as clip_polygon_to_near would emit them. */
+                for (int v = 0; v < num_verts; v++) {
+                    const VecPolyVert *e = &pv[(v + 1) % num_verts];
+                    const ObjVertex *sv = &world[e->point];
+                    sx[v] = sv->sx;
+                    sy[v] = sv->sy;
+                    sz[v] = ROT_Z_INT(sv->z);
+                    su[v] = (int32_t)e->u << 16;
+                    svt[v] = (int32_t)e->v << 16;
+                    int vb = (int)sv->vb;
+                    if (vb < 0) vb = 0;
+                    if (vb > 14) vb = 14;
+                    shade_values[v] = (int16_t)vb;
+                }
+            } else {
+                PolyVertex in_poly[MAX_CLIP_VERTS];
+                for (int v = 0; v < num_verts; v++) {
+                    const ObjVertex *sv = &world[pv[v].point];
+                    in_poly[v].x = sv->x;
+                    in_poly[v].y = sv->y;
+                    in_poly[v].z = sv->z;
+                    in_poly[v].u = (int32_t)pv[v].u << 16;
+                    in_poly[v].v = (int32_t)pv[v].v << 16;
+                    in_poly[v].vb = sv->vb;
+                }
+
+                PolyVertex clipped_poly[MAX_CLIP_VERTS];
+                clipped_n = clip_polygon_to_near(in_poly, num_verts, clipped_poly,
+                                                 MAX_CLIP_VERTS, ROT_Z_FROM_INT(OBJ_NEAR_Z));
+                if (clipped_n < 3) continue;
+
+                for (int v = 0; v < clipped_n; v++) {
+                    int32_t wz = clipped_poly[v].z;
+                    if (wz <= 0) wz = 1;
+                    sx[v] = (int)(((int64_t)clipped_poly[v].x * (int64_t)proj_xs << ROT_Z_FRAC_BITS) / (int64_t)wz) + center_x;
+                    sy[v] = (int)(((int64_t)(clipped_poly[v].y >> WORLD_Y_FRAC_BITS) * proj_ys * RENDER_SCALE
+                                  << ROT_Z_FRAC_BITS) / wz) + half_h;
+                    sz[v] = ROT_Z_INT(wz);
+                    su[v] = clipped_poly[v].u;
+                    svt[v] = clipped_poly[v].v;
+                    int vb = (int)clipped_poly[v].vb;
+                    if (vb < 0) vb = 0;
+                    if (vb > 14) vb = 14;
+                    shade_values[v] = (int16_t)vb;
+                }
             }
 
             /* Back-face culling – matches Amiga doapoly cross product:
@@ -774,41 +1038,26 @@ static int poly_textures_ready(void)
            g_poly_tex_pal_size >= (15u * 512u);
 }
 
-static uint8_t sample_poly_texel_index(uint16_t tex_map_word,
-                                       int32_t u_fixed, int32_t v_fixed)
-{
-    if (!poly_textures_ready()) return 0;
-
-    int u = (int)(u_fixed >> 16) & 63;
-    int v = (int)(v_fixed >> 16) & 63;
-    size_t uv = ((size_t)v << 8) | (size_t)u;  /* v:high byte, u:low byte */
-    size_t tex_off = (uv << 2) + (size_t)tex_map_word;
-    if (tex_off >= g_poly_tex_maps_size) tex_off %= g_poly_tex_maps_size;
-
-    return g_poly_tex_maps[tex_off];
-}
+/* Screen-space plane of one triangle attribute: a(px,py) = a0 + dx*(px-x0) + dy*(py-y0). */
+typedef struct { double a0, dx, dy; } PolyPlane;
 
-static uint16_t sample_poly_palette_cw(uint8_t pal_idx, int shade_level)
+static void poly_plane_setup(PolyPlane *p, double a0, double a1, double a2,
+                             double e1x, double e1y, double e2x, double e2y,
+                             double inv_area)
 {
-    if (!poly_textures_ready()) return 0;
-    if (shade_level < 0) shade_level = 0;
-    if (shade_level > 14) shade_level = 14;
-
-    size_t pal_off = (size_t)shade_level * 512u + (size_t)pal_idx * 2u;
-    if (pal_off + 1u >= g_poly_tex_pal_size) return 0;
-    return (uint16_t)(((uint16_t)g_poly_tex_pal[pal_off] << 8) |
-                       (uint16_t)g_poly_tex_pal[pal_off + 1u]);
+    p->a0 = a0;
+    p->dx = ((a1 - a0) * e2y - (a2 - a0) * e1y) * inv_area;
+    p->dy = ((a2 - a0) * e1x - (a1 - a0) * e2x) * inv_area;
 }
 
-static inline int poly_pixel_behind_wall(int x, int y, int32_t z_view)
-{
-    if (x < 0 || x >= g_renderer.width || y < 0 || y >= g_renderer.height) return 1;
-    /* Reuse the exact same wall-span depth query used by billboard sprites. */
-    int32_t wall_z = renderer_column_clip_nearest_z_at(x, y);
-    if (wall_z > 0 && z_view >= wall_z) return 1;
-    return 0;
-}
+/* Subspan length between perspective divides. */
+#define POLY_SUBSPAN 16
 
+/* Perspective-correct texture mapper. 1/z and u/z, v/z, shade/z are planar in
+ * screen space; each covered row is walked once, wall depths for the whole
+ * span are fetched in one ColumnClip pass, and the divide happens every
+ * POLY_SUBSPAN pixels with fixed-point steps in between. Coverage follows
+ * pixel centres with inclusive edges. */
 static void draw_textured_triangle(const int *sx, const int *sy,
                                    const int32_t *sz, const int32_t *u, const int32_t *v,
                                    const int16_t *shade_values,
@@ -819,62 +1068,129 @@ static void draw_textured_triangle(const int *sx, const int *sy,
 {
     uint32_t *rgb = renderer_get_active_rgb_target();
     uint16_t *cw = renderer_get_active_cw_target();
-    if (!rgb || !cw) return;
+    if ((!rgb && renderer_get_rgb_raster_expand()) || !cw || !poly_textures_ready()) return;
+    PolyThreadContext *ctx = poly_thread_context_get();
+    if (!ctx) return;
 
-    int min_x = sx[0], max_x = sx[0];
     int min_y = sy[0], max_y = sy[0];
     for (int i = 1; i < 3; i++) {
-        if (sx[i] < min_x) min_x = sx[i];
-        if (sx[i] > max_x) max_x = sx[i];
         if (sy[i] < min_y) min_y = sy[i];
         if (sy[i] > max_y) max_y = sy[i];
     }
-    if (min_x < clip_left) min_x = clip_left;
-    if (max_x > clip_right) max_x = clip_right;
     if (min_y < clip_top) min_y = clip_top;
     if (max_y > clip_bot) max_y = clip_bot;
-    if (min_x > max_x || min_y > max_y) return;
+    if (min_y > max_y || clip_left > clip_right) return;
 
     double x0 = (double)sx[0], y0 = (double)sy[0];
-    double x1 = (double)sx[1], y1 = (double)sy[1];
-    double x2 = (double)sx[2], y2 = (double)sy[2];
-    double area = (x1 - x0) * (y2 - y0) - (x2 - x0) * (y1 - y0);
+    double e1x = (double)sx[1] - x0, e1y = (double)sy[1] - y0;
+    double e2x = (double)sx[2] - x0, e2y = (double)sy[2] - y0;
+    double area = e1x * e2y - e2x * e1y;
     if (area == 0.0) return;
-
     double inv_area = 1.0 / area;
+
+    double iz[3], shade[3];
+    for (int i = 0; i < 3; i++) {
+        iz[i] = 1.0 / (double)(sz[i] > 0 ? sz[i] : 1);
+        shade[i] = (use_gouraud && shade_values) ? (double)shade_values[i] : (double)shade_level;
+    }
+    PolyPlane p_iz, p_u, p_v, p_s;
+    poly_plane_setup(&p_iz, iz[0], iz[1], iz[2], e1x, e1y, e2x, e2y, inv_area);
+    poly_plane_setup(&p_u, (double)u[0] * iz[0], (double)u[1] * iz[1], (double)u[2] * iz[2],
+                     e1x, e1y, e2x, e2y, inv_area);
+    poly_plane_setup(&p_v, (double)v[0] * iz[0], (double)v[1] * iz[1], (double)v[2] * iz[2],
+                     e1x, e1y, e2x, e2y, inv_area);
+    poly_plane_setup(&p_s, shade[0] * iz[0], shade[1] * iz[1], shade[2] * iz[2],
+                     e1x, e1y, e2x, e2y, inv_area);
+
     int W = g_renderer.width;
     int H = g_renderer.height;
+    int expand = renderer_get_rgb_raster_expand();
+    const uint8_t *tex = g_poly_tex_maps;
+    size_t tex_size = g_poly_tex_maps_size;
+    int flat_shade = shade_level < 0 ? 0 : (shade_level > 14 ? 14 : shade_level);
+    const uint8_t *flat_pal = g_poly_tex_pal + (size_t)flat_shade * 512u;
+    int32_t *wall_z = ctx->span_wall_z;
 
     for (int y = min_y; y <= max_y; y++) {
-        uint32_t *row = rgb + (size_t)y * W;
         double py = (double)y + 0.5;
-        for (int x = min_x; x <= max_x; x++) {
-            double px = (double)x + 0.5;
-            double w0 = ((x1 - px) * (y2 - py) - (x2 - px) * (y1 - py)) * inv_area;
-            double w1 = ((x2 - px) * (y0 - py) - (x0 - px) * (y2 - py)) * inv_area;
-            double w2 = 1.0 - w0 - w1;
-            if (w0 < -1e-6 || w1 < -1e-6 || w2 < -1e-6) continue;
-
-            int32_t zf = (int32_t)(w0 * (double)sz[0] + w1 * (double)sz[1] + w2 * (double)sz[2]);
-            if (poly_pixel_behind_wall(x, y, zf)) continue;
-            /* Amiga doapoly is painter/stream ordered only: no per-pixel object z-buffer. */
-            int32_t uf = (int32_t)(w0 * (double)u[0] + w1 * (double)u[1] + w2 * (double)u[2]);
-            int32_t vf = (int32_t)(w0 * (double)v[0] + w1 * (double)v[1] + w2 * (double)v[2]);
-            uint8_t pal_idx = sample_poly_texel_index(tex_map_word, uf, vf);
-            if (use_holes && pal_idx == 0) continue;
-            int pixel_shade = shade_level;
-            if (use_gouraud && shade_values) {
-                double shade_f = w0 * (double)shade_values[0] +
-                                 w1 * (double)shade_values[1] +
-                                 w2 * (double)shade_values[2];
-                pixel_shade = (int)(shade_f + 0.5);
-                if (pixel_shade < 0) pixel_shade = 0;
-                if (pixel_shade > 14) pixel_shade = 14;
+
+        /* Row extent from the three edges at the pixel-centre line. */
+        double xl = 1e30, xr = -1e30;
+        for (int i = 0; i < 3; i++) {
+            int j = (i == 2) ? 0 : i + 1;
+            double ya = (double)sy[i], yb = (double)sy[j];
+            if (ya == yb) continue;
+            if (py < (ya < yb ? ya : yb) || py > (ya < yb ? yb : ya)) continue;
+            double xe = (double)sx[i] + (py - ya) * (double)(sx[j] - sx[i]) / (yb - ya);
+            if (xe < xl) xl = xe;
+            if (xe > xr) xr = xe;
+        }
+        if (xl > xr) continue;
+        int xs0 = (int)ceil(xl - 0.5 - 1e-6);
+        int xs1 = (int)floor(xr - 0.5 + 1e-6);
+        if (xs0 < clip_left) xs0 = clip_left;
+        if (xs1 > clip_right) xs1 = clip_right;
+        if (xs0 > xs1) continue;
+
+        int has_wall = renderer_column_clip_row_nearest_z(y, xs0, xs1, wall_z);
+        uint32_t *row = rgb ? rgb + (size_t)y * W : NULL;
+        double dyr = py - y0;
+        double iz_row = p_iz.a0 + p_iz.dy * dyr;
+        double u_row = p_u.a0 + p_u.dy * dyr;
+        double v_row = p_v.a0 + p_v.dy * dyr;
+        double s_row = p_s.a0 + p_s.dy * dyr;
+
+        for (int xs = xs0; xs <= xs1; xs += POLY_SUBSPAN) {
+            int len = xs1 - xs + 1;
+            if (len > POLY_SUBSPAN) len = POLY_SUBSPAN;
+
+            /* Divide at the first and last pixel centre of the subspan; both
+             * are covered, so 1/z stays within the vertex range. */
+            double dxl = (double)xs + 0.5 - x0;
+            double izl = iz_row + p_iz.dx * dxl;
+            double zl = 1.0 / (izl > 1e-9 ? izl : 1e-9);
+            double ul = (u_row + p_u.dx * dxl) * zl;
+            double vl = (v_row + p_v.dx * dxl) * zl;
+            double sl = (s_row + p_s.dx * dxl) * zl;
+            int32_t uu = (int32_t)ul, du = 0;
+            int32_t vv = (int32_t)vl, dv = 0;
+            int32_t zz = (int32_t)(zl * 256.0), dz = 0;
+            int32_t ss = (int32_t)(sl * 65536.0), ds = 0;
+            if (len > 1) {
+                double dxr = dxl + (double)(len - 1);
+                double izr = iz_row + p_iz.dx * dxr;
+                double zr = 1.0 / (izr > 1e-9 ? izr : 1e-9);
+                double inv_steps = 1.0 / (double)(len - 1);
+                du = (int32_t)(((u_row + p_u.dx * dxr) * zr - ul) * inv_steps);
+                dv = (int32_t)(((v_row + p_v.dx * dxr) * zr - vl) * inv_steps);
+                dz = (int32_t)((zr - zl) * 256.0 * inv_steps);
+                ds = (int32_t)(((s_row + p_s.dx * dxr) * zr - sl) * 65536.0 * inv_steps);
+            }
+
+            for (int x = xs; x < xs + len; x++, uu += du, vv += dv, zz += dz, ss += ds) {
+                if (has_wall) {
+                    /* Amiga doapoly is painter/stream ordered only: no per-pixel object z-buffer. */
+                    int32_t wz = wall_z[x - xs0];
+                    if (wz > 0 && (zz >> 8) >= wz) continue;
+                }
+                size_t uv = ((size_t)((vv >> 16) & 63) << 8) | (size_t)((uu >> 16) & 63);
+                size_t tex_off = (uv << 2) + (size_t)tex_map_word;
+                if (tex_off >= tex_size) tex_off %= tex_size;
+                uint8_t pal_idx = tex[tex_off];
+                if (use_holes && pal_idx == 0) continue;
+
+                const uint8_t *pal = flat_pal;
+                if (use_gouraud && shade_values) {
+                    int pixel_shade = (ss + 0x8000) >> 16;
+                    if (pixel_shade < 0) pixel_shade = 0;
+                    if (pixel_shade > 14) pixel_shade = 14;
+                    pal = g_poly_tex_pal + (size_t)pixel_shade * 512u;
+                }
+                uint16_t pal_cw = (uint16_t)(((uint16_t)pal[pal_idx * 2u] << 8) | pal[pal_idx * 2u + 1u]);
+                if (expand)
+                    row[x] = amiga12_to_argb_local(pal_cw);
+                poly_cw_store_xy(cw, x, y, W, H, pal_cw);
             }
-            uint16_t pal_cw = sample_poly_palette_cw(pal_idx, pixel_shade);
-            if (renderer_get_rgb_raster_expand())
-                row[x] = amiga12_to_argb_local(pal_cw);
-            poly_cw_store_xy(cw, x, y, W, H, pal_cw);
         }
     }
 }
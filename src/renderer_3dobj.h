@@ -53,9 +53,29 @@
 #define MAX_POLY_PARTS      32
 #define MAX_POLY_FRAMES     32
 
+/* One polygon of a decoded part (doapoly record after validation). */
+typedef struct {
+    uint32_t first_vert;   /* index into VecObject.poly_verts */
+    uint8_t  num_verts;    /* perimeter vertices, 3..16 */
+    uint8_t  use_holes;    /* low byte of preholes */
+    uint8_t  use_gouraud;  /* low byte of pregour */
+    uint16_t tex_map;      /* texture_map_index */
+    int16_t  shade_div;    /* |brightness divisor|, never 0 */
+} VecPoly;
+
+typedef struct {
+    uint8_t point;         /* < num_points */
+    uint8_t u, v;
+} VecPolyVert;
+
+/* Frame point rows are padded to a multiple of this many points. */
+#define VEC_POINT_BATCH     4
+
 /*
  * Parsed vector object.
- * The raw data pointer is owned by io.c (never freed here).
+ * The raw data pointer is owned by io.c (never freed here); the decoded
+ * arrays below are built by poly_obj_load and owned by this module, so the
+ * draw path never touches the big-endian stream.
  */
 typedef struct {
     const uint8_t *data;       /* raw .vec bytes */
@@ -66,6 +86,18 @@ typedef struct {
     int       num_parts;
     uint16_t  part_poly_off[MAX_POLY_PARTS]; /* byte offset to polygon list */
     uint16_t  part_sort_off[MAX_POLY_PARTS]; /* byte offset into boxrot for sort key */
+
+    uint32_t     generation;   /* bumped by every load; keys the rotation cache */
+    int          point_stride; /* num_points rounded up to VEC_POINT_BATCH */
+    uint32_t     frame_valid;  /* bit f: frame f's points lie inside the file */
+    int16_t     *frame_xz;     /* [frame][point] x,z pairs (2 * point_stride per frame) */
+    int16_t     *frame_y;      /* [frame][point] (point_stride per frame) */
+    int          num_polys;
+    VecPoly     *polys;
+    VecPolyVert *poly_verts;
+    uint32_t  part_first_poly[MAX_POLY_PARTS];
+    uint16_t  part_num_polys[MAX_POLY_PARTS];
+    uint8_t   part_sort_pt[MAX_POLY_PARTS];  /* part_sort_off / 10, clamped */
 } VecObject;
 
 /* Global POLYOBJECTS table (indices 0-9) */
@@ -78,6 +110,9 @@ extern VecObject g_poly_objects[POLY_OBJECTS_COUNT];
  */
 int poly_obj_load(int slot, const uint8_t *data, size_t size);
 
+/* Free a slot's decoded arrays (before io.c frees the raw data). */
+void poly_obj_unload(int slot);
+
 /* Set shared texture assets used by 3D object polygons.
  * texture_maps points to TextureMaps (expected 65536 bytes).
  * texture_pal points to OldTexturePalScaled (expected 15*256*2 bytes). */
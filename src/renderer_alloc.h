@@ -93,4 +93,106 @@ static inline void ab3d_aligned_free(void *p)
 
 #endif
 
+/* -----------------------------------------------------------------------
+ * Frame arena
+ *
+ * Cache-line-aligned bump allocator for per-frame scratch. Each thread owns
+ * one arena and resets it once per frame; pointers handed out stay valid
+ * until that reset. A frame that outgrows the arena takes the excess from
+ * overflow blocks, and the next reset regrows the arena to the high-water
+ * mark, so steady-state frames never touch the heap.
+ * ----------------------------------------------------------------------- */
+typedef struct Ab3dArena {
+    unsigned char *base;
+    size_t capacity;
+    size_t offset;        /* bytes used in base this frame */
+    size_t used;          /* bytes handed out this frame, overflow included */
+    size_t high_water;    /* peak `used` over the arena's lifetime */
+    void *overflow;       /* overflow blocks, chained through their first word */
+    unsigned generation;  /* bumped on every reset */
+} Ab3dArena;
+
+static inline size_t ab3d_arena_round(size_t size)
+{
+    return (size + (AB3D_CACHE_LINE_SIZE - 1u)) & ~(size_t)(AB3D_CACHE_LINE_SIZE - 1u);
+}
+
+static inline void *ab3d_arena_alloc(Ab3dArena *a, size_t size)
+{
+    unsigned char *p;
+    if (!a) return NULL;
+    if (size == 0) size = 1;
+    if (size > SIZE_MAX - 2u * AB3D_CACHE_LINE_SIZE) return NULL;
+    size = ab3d_arena_round(size);
+    if (a->base && size <= a->capacity - a->offset) {
+        p = a->base + a->offset;
+        a->offset += size;
+    } else {
+        /* Header line keeps the payload aligned and links the block. */
+        unsigned char *block = (unsigned char *)ab3d_aligned_alloc(AB3D_CACHE_LINE_SIZE,
+                                                                   AB3D_CACHE_LINE_SIZE + size);
+        if (!block) return NULL;
+        *(void **)(void *)block = a->overflow;
+        a->overflow = block;
+        p = block + AB3D_CACHE_LINE_SIZE;
+    }
+    a->used += size;
+    if (a->used > a->high_water) a->high_water = a->used;
+    return p;
+}
+
+static inline void ab3d_arena_free_overflow(Ab3dArena *a)
+{
+    while (a->overflow) {
+        void *next = *(void **)a->overflow;
+        ab3d_aligned_free(a->overflow);
+        a->overflow = next;
+    }
+}
+
+/* Ensure at least `size` bytes of backing store. Only call between frames
+ * (no live allocations). Returns 1 if the backing store was reallocated. */
+static inline int ab3d_arena_reserve(Ab3dArena *a, size_t size)
+{
+    unsigned char *base;
+    if (!a || size <= a->capacity) return 0;
+    size = ab3d_arena_round(size);
+    base = (unsigned char *)ab3d_aligned_alloc(AB3D_CACHE_LINE_SIZE, size);
+    if (!base) return 0;
+    ab3d_aligned_free(a->base);
+    a->base = base;
+    a->capacity = size;
+    return 1;
+}
+
+/* Start a new frame: drop overflow, regrow to the high-water mark (plus a
+ * quarter of headroom) if the last frame spilled. Returns 1 on regrow. */
+static inline int ab3d_arena_reset(Ab3dArena *a)
+{
+    int grew = 0;
+    if (!a) return 0;
+    ab3d_arena_free_overflow(a);
+    if (a->high_water > a->capacity) {
+        size_t want = a->high_water + a->high_water / 4u;
+        if (want < a->high_water) want = a->high_water;
+        grew = ab3d_arena_reserve(a, want);
+    }
+    a->offset = 0;
+    a->used = 0;
+    a->generation++;
+    return grew;
+}
+
+static inline void ab3d_arena_release(Ab3dArena *a)
+{
+    if (!a) return;
+    ab3d_arena_free_overflow(a);
+    ab3d_aligned_free(a->base);
+    a->base = NULL;
+    a->capacity = 0;
+    a->offset = 0;
+    a->used = 0;
+    a->generation++;
+}
+
 #endif /* RENDERER_ALLOC_H */
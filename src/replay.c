@@ -0,0 +1,472 @@
+/*
+ * replay.c - Input recording and headless simulation replay.
+ *
+ * Tape format (native byte order, like savegame.bin):
+ *
+ *     ReplayHeaderDisk, PlayerState plr1, PlayerState plr2,
+ *     then per display frame: ReplayFrameDisk + hash_count ReplayHashDisk
+ *
+ * A frame is written once its logic ticks have run, so the hashes taken
+ * during those ticks follow it. Replay reads the frame, runs it, then
+ * checks the hashes against its own.
+ */
+
+#include "replay.h"
+#include "control_loop.h"
+#include "input.h"
+#include <SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "logging.h"
+#define printf ab3d_log_printf
+
+#define REPLAY_MAGIC              "AB3T"
+#define REPLAY_VERSION            1u
+#define REPLAY_DEFAULT_HASH_EVERY 50
+/* One display frame runs at most MAX_TEMP_FRAMES / 10 (fixed timestep) ticks. */
+#define REPLAY_MAX_FRAME_HASHES   16
+#define REPLAY_MAX_LOGGED_MISMATCHES 8
+
+typedef struct {
+    char     magic[4];
+    uint32_t version;
+    uint32_t player_state_size;
+    uint32_t seed;
+    uint32_t start_ticks_ms;
+    int32_t  hash_every;
+    int16_t  level;
+    uint8_t  infinite_health;
+    uint8_t  infinite_ammo;
+    uint8_t  all_weapons;
+    uint8_t  all_keys;
+    uint8_t  fixed_timestep;
+    uint8_t  control;          /* plr1 ControlMode: bit0 keys, 1 path, 2 mouse, 3 joy, 4 mouse_kbd */
+} ReplayHeaderDisk;
+
+typedef struct {
+    uint32_t elapsed_ms;       /* clock delta before game_loop_tick's 200 ms clamp */
+    uint8_t  keys[16];
+    int16_t  mouse_dx, mouse_dy, mouse_wheel;
+    int16_t  joy1_dx, joy1_dy, joy2_dx, joy2_dy;
+    int16_t  gamepad_weapon_cycle_steps;
+    uint8_t  buttons;          /* bit0/1 mouse left/right, bit2/3 joy1/joy2 fire */
+    uint8_t  gamepad_duck_toggles;
+    uint8_t  last_pressed;
+    uint8_t  reserved0;
+    uint16_t hash_count;
+    uint16_t reserved1;
+} ReplayFrameDisk;
+
+typedef struct {
+    uint32_t tick;
+    uint32_t hash;
+} ReplayHashDisk;
+
+typedef struct {
+    const char *path;
+    FILE    *f;
+    int      armed;            /* --record-input given, tape not written yet */
+    int      seeded;           /* srand done for the level being set up */
+    int      active;
+    int      hash_every;
+    uint32_t seed;
+    int      frame_open;
+    ReplayFrameDisk frame;
+    ReplayHashDisk  hashes[REPLAY_MAX_FRAME_HASHES];
+    int      hash_count;
+    long     frames;
+    int      last_tick;
+} ReplayRecorder;
+
+typedef struct {
+    FILE    *f;
+    FILE    *out;
+    int      active;
+    int      tape_every;
+    int      print_every;
+    ReplayFrameDisk frame;
+    ReplayHashDisk  computed[REPLAY_MAX_FRAME_HASHES];
+    int      computed_count;
+    long     frames;
+    int      checked;
+    int      mismatches;
+    int      first_bad_tick;
+    int      last_tick;
+} ReplayPlayer;
+
+static ReplayRecorder g_rec;
+static ReplayPlayer g_play;
+
+static uint32_t replay_fnv1a(uint32_t h, const void *data, size_t bytes)
+{
+    const uint8_t *p = (const uint8_t *)data;
+    if (!data) return h;
+    for (size_t i = 0; i < bytes; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static uint32_t replay_hash_player(uint32_t h, const PlayerState *plr)
+{
+    h = replay_fnv1a(h, &plr->xoff, sizeof(plr->xoff));
+    h = replay_fnv1a(h, &plr->zoff, sizeof(plr->zoff));
+    h = replay_fnv1a(h, &plr->yoff, sizeof(plr->yoff));
+    h = replay_fnv1a(h, &plr->angpos, sizeof(plr->angpos));
+    h = replay_fnv1a(h, &plr->zone, sizeof(plr->zone));
+    h = replay_fnv1a(h, &plr->energy, sizeof(plr->energy));
+    h = replay_fnv1a(h, &plr->gun_selected, sizeof(plr->gun_selected));
+    return h;
+}
+
+/* What the logic ticks own: level data (zones, doors, lifts, the object
+ * list), object points, both shot pools and the players. */
+static uint32_t replay_state_hash(const GameState *state)
+{
+    const LevelState *level = &state->level;
+    uint32_t h = 2166136261u;
+
+    if (level->data) h = replay_fnv1a(h, level->data, level->data_byte_count);
+    if (level->object_points && level->num_object_points > 0)
+        h = replay_fnv1a(h, level->object_points, (size_t)level->num_object_points * 8u);
+    if (level->player_shot_data)
+        h = replay_fnv1a(h, level->player_shot_data, (size_t)PLAYER_SHOT_SLOT_COUNT * OBJECT_SIZE);
+    if (level->nasty_shot_data)
+        h = replay_fnv1a(h, level->nasty_shot_data, (size_t)level->nasty_shot_slots * OBJECT_SIZE);
+    h = replay_hash_player(h, &state->plr1);
+    h = replay_hash_player(h, &state->plr2);
+    return h;
+}
+
+static uint8_t replay_pack_control(const ControlMode *c)
+{
+    return (uint8_t)((c->keys ? 1u : 0u) | (c->path ? 2u : 0u) | (c->mouse ? 4u : 0u) |
+                     (c->joy ? 8u : 0u) | (c->mouse_kbd ? 16u : 0u));
+}
+
+static void replay_unpack_control(uint8_t bits, ControlMode *c)
+{
+    c->keys = (bits & 1u) != 0;
+    c->path = (bits & 2u) != 0;
+    c->mouse = (bits & 4u) != 0;
+    c->joy = (bits & 8u) != 0;
+    c->mouse_kbd = (bits & 16u) != 0;
+}
+
+int replay_parse_args(int argc, char *argv[], ReplayOptions *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->hash_every = REPLAY_DEFAULT_HASH_EVERY;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--record-input") == 0 || strcmp(argv[i], "--replay") == 0 ||
+            strcmp(argv[i], "--replay-out") == 0 || strcmp(argv[i], "--replay-hash-every") == 0) {
+            if (i + 1 >= argc) {
+                fprintf(stderr, "[REPLAY] usage: --record-input <tape> | --replay <tape> "
+                                "[--replay-hash-every <ticks>] [--replay-out <file>]\n");
+                return -1;
+            }
+            const char *flag = argv[i];
+            const char *value = argv[++i];
+            if (strcmp(flag, "--record-input") == 0) out->record_path = value;
+            else if (strcmp(flag, "--replay") == 0) out->replay_path = value;
+            else if (strcmp(flag, "--replay-out") == 0) out->out_path = value;
+            else out->hash_every = atoi(value);
+        }
+    }
+    if (out->hash_every <= 0) {
+        fprintf(stderr, "[REPLAY] --replay-hash-every must be positive\n");
+        return -1;
+    }
+    if (out->record_path && out->replay_path) {
+        fprintf(stderr, "[REPLAY] --record-input and --replay are exclusive\n");
+        return -1;
+    }
+    if (out->record_path) {
+        memset(&g_rec, 0, sizeof(g_rec));
+        g_rec.path = out->record_path;
+        g_rec.hash_every = out->hash_every;
+        g_rec.armed = 1;
+    }
+    return out->replay_path ? 1 : 0;
+}
+
+/* ---------------------------------------------------------------- record */
+
+int replay_recording(void)
+{
+    return g_rec.active;
+}
+
+void replay_record_level_prepare(GameState *state)
+{
+    (void)state;
+    if (!g_rec.armed || g_rec.seeded) return;
+    g_rec.seed = (uint32_t)SDL_GetPerformanceCounter() * 2654435761u;
+    if (g_rec.seed == 0) g_rec.seed = 1;
+    srand(g_rec.seed);
+    g_rec.seeded = 1;
+}
+
+void replay_record_begin(GameState *state, const GameLoopCtx *ctx)
+{
+    ReplayHeaderDisk hdr;
+
+    if (!g_rec.armed || !g_rec.seeded || g_rec.active) return;
+    g_rec.armed = 0;
+    if (state->mode != MODE_SINGLE) {
+        printf("[REPLAY] recording is single-player only; not recording\n");
+        return;
+    }
+    g_rec.f = fopen(g_rec.path, "wb");
+    if (!g_rec.f) {
+        printf("[REPLAY] cannot write %s\n", g_rec.path);
+        return;
+    }
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, REPLAY_MAGIC, 4);
+    hdr.version = REPLAY_VERSION;
+    hdr.player_state_size = (uint32_t)sizeof(PlayerState);
+    hdr.seed = g_rec.seed;
+    hdr.start_ticks_ms = (uint32_t)ctx->last_ticks;
+    hdr.hash_every = g_rec.hash_every;
+    hdr.level = state->current_level;
+    hdr.infinite_health = state->infinite_health ? 1u : 0u;
+    hdr.infinite_ammo = state->infinite_ammo ? 1u : 0u;
+    hdr.all_weapons = state->cfg_all_weapons ? 1u : 0u;
+    hdr.all_keys = state->cfg_all_keys ? 1u : 0u;
+    hdr.fixed_timestep = state->cfg_fixed_timestep ? 1u : 0u;
+    hdr.control = replay_pack_control(&state->plr1_control);
+    if (fwrite(&hdr, sizeof(hdr), 1, g_rec.f) != 1 ||
+        fwrite(&state->plr1, sizeof(PlayerState), 1, g_rec.f) != 1 ||
+        fwrite(&state->plr2, sizeof(PlayerState), 1, g_rec.f) != 1) {
+        printf("[REPLAY] write failed: %s\n", g_rec.path);
+        fclose(g_rec.f);
+        g_rec.f = NULL;
+        return;
+    }
+    g_rec.active = 1;
+    g_rec.frames = 0;
+    g_rec.last_tick = 0;
+    printf("[REPLAY] recording level %d to %s (seed %08x, hash every %d ticks)\n",
+           (int)state->current_level + 1, g_rec.path, (unsigned)g_rec.seed, g_rec.hash_every);
+}
+
+void replay_record_frame(GameState *state, uint32_t elapsed_ms)
+{
+    InputFrame in;
+    ReplayFrameDisk *fr = &g_rec.frame;
+
+    if (!g_rec.active) return;
+    input_capture_frame(state->key_map, state->last_pressed, &in);
+    memset(fr, 0, sizeof(*fr));
+    fr->elapsed_ms = elapsed_ms;
+    memcpy(fr->keys, in.keys, sizeof(fr->keys));
+    fr->mouse_dx = in.mouse.dx;
+    fr->mouse_dy = in.mouse.dy;
+    fr->mouse_wheel = in.mouse.wheel_y;
+    fr->joy1_dx = in.joy1.dx;
+    fr->joy1_dy = in.joy1.dy;
+    fr->joy2_dx = in.joy2.dx;
+    fr->joy2_dy = in.joy2.dy;
+    fr->gamepad_weapon_cycle_steps = in.gamepad_weapon_cycle_steps;
+    fr->buttons = (uint8_t)((in.mouse.left_button ? 1u : 0u) | (in.mouse.right_button ? 2u : 0u) |
+                            (in.joy1.fire ? 4u : 0u) | (in.joy2.fire ? 8u : 0u));
+    fr->gamepad_duck_toggles = in.gamepad_duck_toggles;
+    fr->last_pressed = in.last_pressed;
+    g_rec.hash_count = 0;
+    g_rec.frame_open = 1;
+}
+
+void replay_record_end(void)
+{
+    if (!g_rec.active) return;
+    replay_end_frame();
+    fclose(g_rec.f);
+    g_rec.f = NULL;
+    g_rec.active = 0;
+    printf("[REPLAY] recorded %ld frames, %d logic ticks to %s\n",
+           g_rec.frames, g_rec.last_tick, g_rec.path);
+}
+
+/* ---------------------------------------------------------------- shared */
+
+void replay_after_logic_tick(const GameState *state, int logic_count)
+{
+    if (g_rec.active && g_rec.frame_open) {
+        g_rec.last_tick = logic_count;
+        if (logic_count % g_rec.hash_every == 0 && g_rec.hash_count < REPLAY_MAX_FRAME_HASHES) {
+            g_rec.hashes[g_rec.hash_count].tick = (uint32_t)logic_count;
+            g_rec.hashes[g_rec.hash_count].hash = replay_state_hash(state);
+            g_rec.hash_count++;
+        }
+    }
+    if (g_play.active) {
+        int check = (logic_count % g_play.tape_every == 0);
+        int print = (logic_count % g_play.print_every == 0);
+        g_play.last_tick = logic_count;
+        if (!check && !print) return;
+        uint32_t h = replay_state_hash(state);
+        if (print) {
+            printf("[REPLAY] tick %d hash %08x\n", logic_count, (unsigned)h);
+            if (g_play.out) fprintf(g_play.out, "%d,%08x\n", logic_count, (unsigned)h);
+        }
+        if (check && g_play.computed_count < REPLAY_MAX_FRAME_HASHES) {
+            g_play.computed[g_play.computed_count].tick = (uint32_t)logic_count;
+            g_play.computed[g_play.computed_count].hash = h;
+            g_play.computed_count++;
+        }
+    }
+}
+
+void replay_end_frame(void)
+{
+    if (g_rec.active && g_rec.frame_open) {
+        g_rec.frame.hash_count = (uint16_t)g_rec.hash_count;
+        if (fwrite(&g_rec.frame, sizeof(g_rec.frame), 1, g_rec.f) != 1 ||
+            (g_rec.hash_count > 0 &&
+             fwrite(g_rec.hashes, sizeof(ReplayHashDisk), (size_t)g_rec.hash_count, g_rec.f) !=
+                 (size_t)g_rec.hash_count)) {
+            printf("[REPLAY] write failed: %s; recording stopped\n", g_rec.path);
+            fclose(g_rec.f);
+            g_rec.f = NULL;
+            g_rec.active = 0;
+        }
+        g_rec.frame_open = 0;
+        g_rec.frames++;
+    }
+    if (g_play.active) {
+        for (int i = 0; i < (int)g_play.frame.hash_count; i++) {
+            ReplayHashDisk want;
+            int found = 0;
+            if (fread(&want, sizeof(want), 1, g_play.f) != 1) break;
+            for (int k = 0; k < g_play.computed_count; k++) {
+                if (g_play.computed[k].tick != want.tick) continue;
+                found = 1;
+                g_play.checked++;
+                if (g_play.computed[k].hash != want.hash) {
+                    if (g_play.mismatches == 0) g_play.first_bad_tick = (int)want.tick;
+                    if (g_play.mismatches < REPLAY_MAX_LOGGED_MISMATCHES)
+                        printf("[REPLAY] tick %u: hash %08x, recorded %08x\n", (unsigned)want.tick,
+                               (unsigned)g_play.computed[k].hash, (unsigned)want.hash);
+                    g_play.mismatches++;
+                }
+                break;
+            }
+            if (!found) {
+                /* The replay ran a different number of ticks this frame. */
+                if (g_play.mismatches == 0) g_play.first_bad_tick = (int)want.tick;
+                if (g_play.mismatches < REPLAY_MAX_LOGGED_MISMATCHES)
+                    printf("[REPLAY] tick %u: not reached in this frame\n", (unsigned)want.tick);
+                g_play.mismatches++;
+            }
+        }
+        g_play.computed_count = 0;
+        memset(&g_play.frame, 0, sizeof(g_play.frame));
+    }
+}
+
+/* ---------------------------------------------------------------- replay */
+
+int replay_next_frame(GameState *state, uint32_t *elapsed_ms)
+{
+    const ReplayFrameDisk *fr = &g_play.frame;
+    InputFrame in;
+
+    if (!g_play.active || fread(&g_play.frame, sizeof(g_play.frame), 1, g_play.f) != 1)
+        return 0;
+    memset(&in, 0, sizeof(in));
+    memcpy(in.keys, fr->keys, sizeof(in.keys));
+    in.last_pressed = fr->last_pressed;
+    in.mouse.dx = fr->mouse_dx;
+    in.mouse.dy = fr->mouse_dy;
+    in.mouse.wheel_y = fr->mouse_wheel;
+    in.mouse.left_button = (fr->buttons & 1u) != 0;
+    in.mouse.right_button = (fr->buttons & 2u) != 0;
+    in.joy1.dx = fr->joy1_dx;
+    in.joy1.dy = fr->joy1_dy;
+    in.joy1.fire = (fr->buttons & 4u) != 0;
+    in.joy2.dx = fr->joy2_dx;
+    in.joy2.dy = fr->joy2_dy;
+    in.joy2.fire = (fr->buttons & 8u) != 0;
+    in.gamepad_duck_toggles = fr->gamepad_duck_toggles;
+    in.gamepad_weapon_cycle_steps = fr->gamepad_weapon_cycle_steps;
+    input_apply_frame(&in, state->key_map, &state->last_pressed);
+    *elapsed_ms = fr->elapsed_ms;
+    g_play.frames++;
+    return 1;
+}
+
+int replay_run(GameState *state, const ReplayOptions *opts)
+{
+    ReplayHeaderDisk hdr;
+    PlayerState plr1, plr2;
+    bool copper_screen_ready = false;
+    GameLoopCtx ctx;
+
+    memset(&g_play, 0, sizeof(g_play));
+    g_play.f = fopen(opts->replay_path, "rb");
+    if (!g_play.f) {
+        printf("[REPLAY] cannot open %s\n", opts->replay_path);
+        return 1;
+    }
+    if (fread(&hdr, sizeof(hdr), 1, g_play.f) != 1 || memcmp(hdr.magic, REPLAY_MAGIC, 4) != 0 ||
+        hdr.version != REPLAY_VERSION || hdr.player_state_size != (uint32_t)sizeof(PlayerState) ||
+        hdr.hash_every <= 0 || hdr.level < 0 || hdr.level >= MAX_LEVELS ||
+        fread(&plr1, sizeof(plr1), 1, g_play.f) != 1 || fread(&plr2, sizeof(plr2), 1, g_play.f) != 1) {
+        printf("[REPLAY] %s is not a tape from this build\n", opts->replay_path);
+        fclose(g_play.f);
+        return 1;
+    }
+    if (opts->out_path) {
+        g_play.out = fopen(opts->out_path, "w");
+        if (!g_play.out) printf("[REPLAY] cannot write %s\n", opts->out_path);
+        else fprintf(g_play.out, "tick,hash\n");
+    }
+
+    play_game_load_shared_assets(state);
+    state->mode = MODE_SINGLE;
+    state->current_level = hdr.level;
+    state->max_level = hdr.level;
+    state->infinite_health = hdr.infinite_health != 0;
+    state->infinite_ammo = hdr.infinite_ammo != 0;
+    state->cfg_all_weapons = hdr.all_weapons != 0;
+    state->cfg_all_keys = hdr.all_keys != 0;
+    state->cfg_fixed_timestep = hdr.fixed_timestep != 0;
+    replay_unpack_control(hdr.control, &state->plr1_control);
+    srand(hdr.seed);
+    play_the_game_prepare_level(state, &copper_screen_ready);
+    state->plr1 = plr1;
+    state->plr2 = plr2;
+
+    game_loop_ctx_init(&ctx, state);
+    ctx.headless = 1;
+    ctx.last_ticks = (Uint32)hdr.start_ticks_ms;
+    g_play.tape_every = hdr.hash_every;
+    g_play.print_every = opts->hash_every;
+    g_play.active = 1;
+
+    printf("[REPLAY] level %d from %s (seed %08x)\n", (int)hdr.level + 1, opts->replay_path,
+           (unsigned)hdr.seed);
+    Uint64 t0 = SDL_GetPerformanceCounter();
+    while (state->running)
+        game_loop_tick(state, &ctx);
+    double sec = (double)(SDL_GetPerformanceCounter() - t0) / (double)SDL_GetPerformanceFrequency();
+    g_play.active = 0;
+
+    printf("[REPLAY] %ld frames, %d logic ticks in %.3f s: %.0f ticks/s\n",
+           g_play.frames, ctx.logic_count, sec, (sec > 0.0) ? (double)ctx.logic_count / sec : 0.0);
+    if (g_play.mismatches > 0) {
+        printf("[REPLAY] DIVERGED: %d of %d recorded hashes differ, first at tick %d\n",
+               g_play.mismatches, g_play.checked + g_play.mismatches, g_play.first_bad_tick);
+    } else {
+        printf("[REPLAY] %d recorded hashes match\n", g_play.checked);
+    }
+
+    if (g_play.out) fclose(g_play.out);
+    fclose(g_play.f);
+    state->running = false;
+    play_the_game_finalize_session(state);
+    return (g_play.mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,58 @@
+/*
+ * replay.h - Input recording and headless simulation replay.
+ *
+ * --record-input <file> records the first level played: the RNG seed (srand
+ * is reseeded before the level is set up), both players' starting state,
+ * the ini switches the simulation reads, and per display frame the raw
+ * clock delta plus everything the logic ticks read from input. Every
+ * --replay-hash-every logic ticks (default 50) a hash of the simulation
+ * state is stored alongside.
+ *
+ * --replay <file> loads the same level, restores that state and runs
+ * game_loop_tick headless (no display_* calls, tape clock instead of real
+ * time) as fast as it goes. It prints ticks per second and a state hash per
+ * N ticks, and checks each recorded hash, so a change to objects.c or
+ * movement.c that alters the simulation shows up as the first tick whose
+ * hash differs.
+ */
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "game_state.h"
+#include "game_loop.h"
+
+typedef struct {
+    const char *record_path;   /* --record-input */
+    const char *replay_path;   /* --replay */
+    const char *out_path;      /* --replay-out: "tick,hash" CSV */
+    int hash_every;            /* --replay-hash-every, in logic ticks */
+} ReplayOptions;
+
+/* Parse the replay/record flags from argv (recording is armed here).
+ * Returns 1 when --replay was requested, 0 when not, -1 on malformed
+ * arguments (message already printed). */
+int replay_parse_args(int argc, char *argv[], ReplayOptions *out);
+
+/* Run --replay after setup_game. Returns the process exit code: 0 when every
+ * recorded hash matched, 1 otherwise. */
+int replay_run(GameState *state, const ReplayOptions *opts);
+
+/* Recording hooks. All are no-ops unless --record-input is armed. */
+void replay_record_level_prepare(GameState *state);          /* top of level setup */
+void replay_record_begin(GameState *state, const GameLoopCtx *ctx); /* before the first frame */
+void replay_record_frame(GameState *state, uint32_t elapsed_ms);    /* input + clock known */
+void replay_record_end(void);                                 /* level session over */
+
+/* Shared by recording and replay (game_loop.c). */
+void replay_after_logic_tick(const GameState *state, int logic_count);
+void replay_end_frame(void);
+
+/* Replay: load the next frame's input into state; 0 at the end of the tape.
+ * *elapsed_ms gets the recorded clock delta. */
+int replay_next_frame(GameState *state, uint32_t *elapsed_ms);
+
+/* 1 while a tape is being written. */
+int replay_recording(void);
+
+#endif /* REPLAY_H */
@@ -376,8 +376,8 @@ static int decode_p(LH5State *s)
  * Main decompression function
  * ======================================================================= */
 
-size_t sb_decompress(const uint8_t *src, size_t src_len,
-                     uint8_t *dst, size_t dst_len)
+size_t sb_decompress_reference(const uint8_t *src, size_t src_len,
+                               uint8_t *dst, size_t dst_len)
 {
     if (!sb_is_compressed(src, src_len))
         return 0;
@@ -444,61 +444,366 @@ size_t sb_decompress(const uint8_t *src, size_t src_len,
 }
 
 /* =======================================================================
- * File loading helper
+ * Fast decoder
+ *
+ * Same bitstream as above, decoded with a 64-bit MSB-first reservoir that
+ * is refilled once per code (worst case c + p + extra = 46 bits), and
+ * two-level canonical lookup tables instead of the make_table trees: a
+ * 12-bit (c) / 8-bit (pt) primary index, and a fixed-size second level
+ * for the few codes longer than that. Matches are copied straight out of
+ * dst (the whole history is there) rather than through the dtext ring.
  * ======================================================================= */
 
-int sb_load_file(const char *path, uint8_t **out_data, size_t *out_size)
+#define FAST_CBITS      12
+#define FAST_PTBITS     8
+#define FAST_C_SUBBITS  (16 - FAST_CBITS)
+#define FAST_PT_SUBBITS (16 - FAST_PTBITS)
+
+/* Table entry: bits 0-9 symbol, 10-14 code length; bit 15 marks a link
+ * whose low 15 bits index the second-level table. */
+#define FAST_LINK       0x8000u
+#define FAST_ENTRY(sym, len) ((uint16_t)((unsigned)(sym) | ((unsigned)(len) << 10)))
+#define FAST_SYM(e)     ((e) & 0x3ffu)
+#define FAST_LEN(e)     (((e) >> 10) & 0x1fu)
+
+typedef struct {
+    const uint8_t *in;
+    size_t         insize;
+    size_t         inpos;
+    uint64_t       bits;      /* next bit in bit 63 */
+    unsigned       nbits;     /* valid bits in the reservoir */
+
+    uint16_t c_primary[1u << FAST_CBITS];
+    uint16_t c_sub[NC << FAST_C_SUBBITS];
+    uint16_t pt_primary[1u << FAST_PTBITS];
+    uint16_t pt_sub[NPT << FAST_PT_SUBBITS];
+    uint8_t  c_len[NC];
+    uint8_t  pt_len[NPT];
+    uint16_t blocksize;
+} SbFastState;
+
+/* Top up to at least 56 valid bits. Past the end of input the stream reads
+ * as zeros, as in fillbuf. */
+static inline void fast_refill(SbFastState *s)
 {
-    *out_data = NULL;
-    *out_size = 0;
+    if (s->nbits > 56) return;
+    if (s->inpos + 8 <= s->insize) {
+        const uint8_t *p = s->in + s->inpos;
+        uint64_t w = ((uint64_t)p[0] << 56) | ((uint64_t)p[1] << 48) |
+                     ((uint64_t)p[2] << 40) | ((uint64_t)p[3] << 32) |
+                     ((uint64_t)p[4] << 24) | ((uint64_t)p[5] << 16) |
+                     ((uint64_t)p[6] << 8)  |  (uint64_t)p[7];
+        s->bits |= w >> s->nbits;
+        s->inpos += (63u - s->nbits) >> 3;
+        s->nbits |= 56u;
+        return;
+    }
+    while (s->nbits <= 56) {
+        uint64_t b = (s->inpos < s->insize) ? s->in[s->inpos++] : 0;
+        s->bits |= b << (56u - s->nbits);
+        s->nbits += 8;
+    }
+}
 
-    FILE *f = fopen(path, "rb");
-    if (!f) {
-        printf("[SB] Cannot open: %s\n", path);
-        return -1;
+#define FAST_PEEK(s, n) ((unsigned)((s)->bits >> (64 - (n))))
+
+static inline void fast_skip(SbFastState *s, unsigned n)
+{
+    s->bits <<= n;
+    s->nbits -= n;
+}
+
+static inline unsigned fast_getbits(SbFastState *s, unsigned n)
+{
+    unsigned x;
+    if (n == 0) return 0;
+    fast_refill(s);
+    x = FAST_PEEK(s, n);
+    fast_skip(s, n);
+    return x;
+}
+
+/* Build a canonical two-level table from bit lengths (same code assignment
+ * and validity rule as make_table). */
+static int fast_build_table(int nchar, const uint8_t *bitlen, unsigned primary_bits,
+                            uint16_t *primary, uint16_t *sub, unsigned sub_cap)
+{
+    uint32_t count[17] = { 0 };
+    uint32_t start[18];
+    unsigned sub_bits = 16u - primary_bits;
+    unsigned sub_size = 1u << sub_bits;
+    unsigned sub_used = 0;
+
+    for (int i = 0; i < nchar; i++) {
+        if (bitlen[i] > 16) return -1;
+        count[bitlen[i]]++;
+    }
+    start[1] = 0;
+    for (int k = 1; k <= 16; k++)
+        start[k + 1] = start[k] + (count[k] << (16 - k));
+    if ((start[17] & 0xffffu) != 0) return -1;
+
+    memset(primary, 0, sizeof(uint16_t) << primary_bits);
+    for (int j = 0; j < nchar; j++) {
+        unsigned k = bitlen[j];
+        if (k == 0) continue;
+        uint32_t code = start[k];      /* left-aligned in 16 bits */
+        start[k] += 1u << (16 - k);
+        if (code >= 0x10000u) return -1;
+        unsigned idx = code >> sub_bits;
+        if (k <= primary_bits) {
+            unsigned n = 1u << (primary_bits - k);
+            for (unsigned i = 0; i < n; i++)
+                primary[idx + i] = FAST_ENTRY(j, k);
+        } else {
+            uint16_t e = primary[idx];
+            if (!(e & FAST_LINK)) {
+                if (sub_used >= sub_cap) return -1;
+                e = (uint16_t)(FAST_LINK | (sub_used * sub_size));
+                memset(sub + sub_used * sub_size, 0, sizeof(uint16_t) * sub_size);
+                primary[idx] = e;
+                sub_used++;
+            }
+            uint16_t *t = sub + (e & ~FAST_LINK) + (code & (sub_size - 1));
+            unsigned n = 1u << (16 - k);
+            for (unsigned i = 0; i < n; i++)
+                t[i] = FAST_ENTRY(j, k);
+        }
     }
+    return 0;
+}
 
-    fseek(f, 0, SEEK_END);
-    long file_len = ftell(f);
-    fseek(f, 0, SEEK_SET);
+/* Decode one symbol; the caller has refilled. */
+static inline unsigned fast_decode(SbFastState *s, const uint16_t *primary,
+                                   const uint16_t *sub, unsigned primary_bits)
+{
+    unsigned e = primary[FAST_PEEK(s, primary_bits)];
+    if (e & FAST_LINK)
+        e = sub[(e & ~FAST_LINK) + (FAST_PEEK(s, 16) & ((1u << (16 - primary_bits)) - 1u))];
+    fast_skip(s, FAST_LEN(e));
+    return FAST_SYM(e);
+}
 
-    if (file_len < 12) {
-        printf("[SB] File too small: %s (%ld bytes)\n", path, file_len);
-        fclose(f);
-        return -1;
+static void fast_fill_single(uint16_t *primary, unsigned primary_bits, unsigned sym)
+{
+    unsigned n = 1u << primary_bits;
+    for (unsigned i = 0; i < n; i++)
+        primary[i] = FAST_ENTRY(sym, 0);
+}
+
+static int fast_read_pt_len(SbFastState *s, int nn, int nbit, int i_special)
+{
+    int i, c, n;
+
+    n = (int)fast_getbits(s, (unsigned)nbit);
+    if (n == 0) {
+        c = (int)fast_getbits(s, (unsigned)nbit);
+        memset(s->pt_len, 0, sizeof(s->pt_len));
+        fast_fill_single(s->pt_primary, FAST_PTBITS, (unsigned)c);
+        return 0;
     }
 
-    uint8_t *file_buf = (uint8_t *)malloc((size_t)file_len);
-    if (!file_buf) {
-        fclose(f);
-        return -1;
+    i = 0;
+    while (i < MIN(n, NPT)) {
+        fast_refill(s);
+        c = (int)FAST_PEEK(s, 3);
+        if (c != 7) {
+            fast_skip(s, 3);
+        } else {
+            uint64_t mask = (uint64_t)1 << 60;
+            while ((mask & s->bits) && c < 16 + 7) {
+                mask >>= 1;
+                c++;
+            }
+            fast_skip(s, (unsigned)(c - 3));
+        }
+        s->pt_len[i++] = (uint8_t)c;
+        if (i == i_special) {
+            c = (int)fast_getbits(s, 2);
+            while (--c >= 0 && i < NPT)
+                s->pt_len[i++] = 0;
+        }
     }
+    while (i < nn)
+        s->pt_len[i++] = 0;
+    return fast_build_table(nn, s->pt_len, FAST_PTBITS, s->pt_primary, s->pt_sub, NPT);
+}
 
-    if (fread(file_buf, 1, (size_t)file_len, f) != (size_t)file_len) {
-        printf("[SB] Read error: %s\n", path);
-        free(file_buf);
-        fclose(f);
-        return -1;
+static int fast_read_c_len(SbFastState *s)
+{
+    int i, c, n;
+
+    n = (int)fast_getbits(s, CBIT);
+    if (n == 0) {
+        c = (int)fast_getbits(s, CBIT);
+        if (c >= NC) return -1;
+        memset(s->c_len, 0, sizeof(s->c_len));
+        fast_fill_single(s->c_primary, FAST_CBITS, (unsigned)c);
+        return 0;
     }
-    fclose(f);
 
-    if (!sb_is_compressed(file_buf, (size_t)file_len)) {
+    i = 0;
+    while (i < MIN(n, NC)) {
+        fast_refill(s);
+        c = (int)fast_decode(s, s->pt_primary, s->pt_sub, FAST_PTBITS);
+        if (c <= 2) {
+            if (c == 0)
+                c = 1;
+            else if (c == 1)
+                c = (int)fast_getbits(s, 4) + 3;
+            else
+                c = (int)fast_getbits(s, CBIT) + 20;
+            while (--c >= 0 && i < NC)
+                s->c_len[i++] = 0;
+        } else {
+            s->c_len[i++] = (uint8_t)(c - 2);
+        }
+    }
+    while (i < NC)
+        s->c_len[i++] = 0;
+    return fast_build_table(NC, s->c_len, FAST_CBITS, s->c_primary, s->c_sub, NC);
+}
+
+size_t sb_decompress_fast(const uint8_t *src, size_t src_len,
+                          uint8_t *dst, size_t dst_len)
+{
+    if (!sb_is_compressed(src, src_len))
+        return 0;
+
+    uint32_t unpacked = read_be32(src + 4);
+    if (unpacked > dst_len)
+        return 0;
+
+    SbFastState *s = (SbFastState *)malloc(sizeof(SbFastState));
+    if (!s) return 0;
+    s->in = src + 12;
+    s->insize = src_len - 12;
+    s->inpos = 0;
+    s->bits = 0;
+    s->nbits = 0;
+    s->blocksize = 0;
+
+    size_t out_pos = 0;
+    while (out_pos < unpacked) {
+        if (s->blocksize == 0) {
+            s->blocksize = (uint16_t)fast_getbits(s, 16);
+            if (fast_read_pt_len(s, NT, TBIT, 3) < 0) break;
+            if (fast_read_c_len(s) < 0) break;
+            if (fast_read_pt_len(s, NP_SB, PBIT_SB, -1) < 0) break;
+        }
+        s->blocksize--;
+
+        fast_refill(s);
+        unsigned c = fast_decode(s, s->c_primary, s->c_sub, FAST_CBITS);
+        if (c < 256) {
+            dst[out_pos++] = (uint8_t)c;
+            continue;
+        }
+
+        size_t match_len = c - 256 + THRESHOLD;
+        unsigned j = fast_decode(s, s->pt_primary, s->pt_sub, FAST_PTBITS);
+        if (j >= NP_SB) break;
+        size_t dist = 1;
+        if (j != 0)
+            dist += 1u << (j - 1);
+        if (j > 1) {
+            dist += FAST_PEEK(s, j - 1);
+            fast_skip(s, j - 1);
+        }
+        if (match_len > unpacked - out_pos)
+            match_len = unpacked - out_pos;
+
+        uint8_t *d = dst + out_pos;
+        if (dist > out_pos) {
+            /* Reaches back before the first byte: the ring starts as spaces. */
+            for (size_t i = 0; i < match_len; i++)
+                d[i] = (i + out_pos >= dist) ? d[(ptrdiff_t)i - (ptrdiff_t)dist] : 0x20;
+        } else if (dist >= 8 && out_pos + match_len + 8 <= unpacked) {
+            /* 8-byte chunks never overlap their own source; the tail write
+             * past match_len is overwritten by later output. */
+            const uint8_t *m = d - dist;
+            for (size_t i = 0; i < match_len; i += 8)
+                memcpy(d + i, m + i, 8);
+        } else {
+            const uint8_t *m = d - dist;
+            for (size_t i = 0; i < match_len; i++)
+                d[i] = m[i];
+        }
+        out_pos += match_len;
+    }
+
+    free(s);
+    return out_pos;
+}
+
+/* AB3D_SB_DECODER=reference selects the original decoder; =verify runs both
+ * and reports the first mismatch (the reference output is kept). */
+static int sb_decoder_mode(void)
+{
+    static int mode = -1;
+    if (mode < 0) {
+        const char *env = getenv("AB3D_SB_DECODER");
+        mode = 0;
+        if (env && strcmp(env, "reference") == 0) mode = 1;
+        else if (env && strcmp(env, "verify") == 0) mode = 2;
+    }
+    return mode;
+}
+
+size_t sb_decompress(const uint8_t *src, size_t src_len,
+                     uint8_t *dst, size_t dst_len)
+{
+    int mode = sb_decoder_mode();
+    if (mode == 0)
+        return sb_decompress_fast(src, src_len, dst, dst_len);
+    if (mode == 1)
+        return sb_decompress_reference(src, src_len, dst, dst_len);
+
+    size_t ref = sb_decompress_reference(src, src_len, dst, dst_len);
+    uint8_t *chk = (uint8_t *)malloc(dst_len ? dst_len : 1);
+    if (chk) {
+        size_t fast = sb_decompress_fast(src, src_len, chk, dst_len);
+        size_t n = MIN(ref, dst_len);
+        size_t bad = n;
+        for (size_t i = 0; i < n; i++) {
+            if (chk[i] != dst[i]) { bad = i; break; }
+        }
+        if (fast != n || bad != n)
+            printf("[SB] Fast decoder mismatch: %zu vs %zu bytes, first diff at %zu\n",
+                   fast, ref, bad);
+        free(chk);
+    }
+    return ref;
+}
+
+/* =======================================================================
+ * File loading helper
+ * ======================================================================= */
+
+int sb_unpack_buffer(uint8_t *file_buf, size_t file_len, const char *path,
+                     uint8_t **out_data, size_t *out_size)
+{
+    *out_data = NULL;
+    *out_size = 0;
+    if (!path) path = "(memory)";
+
+    if (!sb_is_compressed(file_buf, file_len)) {
         /* Not compressed - return raw data */
-        printf("[SB] Raw file (not =SB= compressed): %s (%ld bytes)\n",
+        printf("[SB] Raw file (not =SB= compressed): %s (%zu bytes)\n",
                path, file_len);
         *out_data = file_buf;
-        *out_size = (size_t)file_len;
+        *out_size = file_len;
         return 0;
     }
 
-    uint32_t unpacked = sb_unpacked_size(file_buf, (size_t)file_len);
+    uint32_t unpacked = sb_unpacked_size(file_buf, file_len);
     uint8_t *dst = (uint8_t *)calloc(1, unpacked);
     if (!dst) {
         free(file_buf);
         return -1;
     }
 
-    size_t decoded = sb_decompress(file_buf, (size_t)file_len, dst, unpacked);
+    size_t decoded = sb_decompress(file_buf, file_len, dst, unpacked);
     free(file_buf);
 
     if (decoded == 0) {
@@ -514,3 +819,41 @@ int sb_load_file(const char *path, uint8_t **out_data, size_t *out_size)
     *out_size = decoded;
     return 0;
 }
+
+int sb_load_file(const char *path, uint8_t **out_data, size_t *out_size)
+{
+    *out_data = NULL;
+    *out_size = 0;
+
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        printf("[SB] Cannot open: %s\n", path);
+        return -1;
+    }
+
+    fseek(f, 0, SEEK_END);
+    long file_len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    if (file_len < 12) {
+        printf("[SB] File too small: %s (%ld bytes)\n", path, file_len);
+        fclose(f);
+        return -1;
+    }
+
+    uint8_t *file_buf = (uint8_t *)malloc((size_t)file_len);
+    if (!file_buf) {
+        fclose(f);
+        return -1;
+    }
+
+    if (fread(file_buf, 1, (size_t)file_len, f) != (size_t)file_len) {
+        printf("[SB] Read error: %s\n", path);
+        free(file_buf);
+        fclose(f);
+        return -1;
+    }
+    fclose(f);
+
+    return sb_unpack_buffer(file_buf, (size_t)file_len, path, out_data, out_size);
+}
@@ -34,10 +34,34 @@ uint32_t sb_unpacked_size(const uint8_t *data, size_t data_len);
  * dst_len  - size of output buffer
  *
  * Returns the number of bytes decompressed, or 0 on error.
+ *
+ * Uses the table-driven fast decoder unless AB3D_SB_DECODER is set to
+ * "reference" (original lha port) or "verify" (run both, log mismatches).
  */
 size_t sb_decompress(const uint8_t *src, size_t src_len,
                      uint8_t *dst, size_t dst_len);
 
+/* The two decoders behind sb_decompress, same contract. The reference one
+ * is the bit-at-a-time lha port; the fast one is exercised against it by
+ * tools/sb_bench.c. */
+size_t sb_decompress_reference(const uint8_t *src, size_t src_len,
+                               uint8_t *dst, size_t dst_len);
+size_t sb_decompress_fast(const uint8_t *src, size_t src_len,
+                          uint8_t *dst, size_t dst_len);
+
+/* Unpack a file image already read into memory.
+ *
+ * file_buf - malloc'd file contents; ownership passes to this call (it is
+ *            either returned as-is for raw files or freed after decoding)
+ * path     - name used in log messages (may be NULL)
+ * out_data - receives malloc'd decompressed data (caller must free)
+ * out_size - receives size of decompressed data
+ *
+ * Returns 0 on success, -1 on error.
+ */
+int sb_unpack_buffer(uint8_t *file_buf, size_t file_len, const char *path,
+                     uint8_t **out_data, size_t *out_size);
+
 /* Load and decompress an =SB= file from disk.
  *
  * path     - file path
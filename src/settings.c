@@ -81,6 +81,72 @@ static int parse_display_mode_value(const char *v, int8_t *out_mode)
     return 0;
 }
 
+static int parse_render_thread_schedule_value(const char *v, int8_t *out_schedule)
+{
+    char buf[32];
+    size_t n = 0;
+    if (!v || !out_schedule) return 0;
+
+    while (*v && isspace((unsigned char)*v)) v++;
+    while (*v && n + 1 < sizeof(buf)) {
+        buf[n++] = (char)tolower((unsigned char)*v++);
+    }
+    while (n > 0 && isspace((unsigned char)buf[n - 1])) n--;
+    buf[n] = '\0';
+
+    if (strcmp(buf, "strips") == 0 || strcmp(buf, "0") == 0) {
+        *out_schedule = RENDER_THREAD_SCHEDULE_STRIPS;
+        return 1;
+    }
+    if (strcmp(buf, "tiles") == 0 || strcmp(buf, "1") == 0) {
+        *out_schedule = RENDER_THREAD_SCHEDULE_TILES;
+        return 1;
+    }
+    if (strcmp(buf, "adaptive") == 0 || strcmp(buf, "2") == 0) {
+        *out_schedule = RENDER_THREAD_SCHEDULE_ADAPTIVE;
+        return 1;
+    }
+    return 0;
+}
+
+static int parse_render_thread_wait_value(const char *v, int8_t *out_wait)
+{
+    char buf[32];
+    size_t n = 0;
+    if (!v || !out_wait) return 0;
+
+    while (*v && isspace((unsigned char)*v)) v++;
+    while (*v && n + 1 < sizeof(buf)) {
+        buf[n++] = (char)tolower((unsigned char)*v++);
+    }
+    while (n > 0 && isspace((unsigned char)buf[n - 1])) n--;
+    buf[n] = '\0';
+
+    if (strcmp(buf, "block") == 0 || strcmp(buf, "0") == 0) {
+        *out_wait = RENDER_THREAD_WAIT_BLOCK;
+        return 1;
+    }
+    if (strcmp(buf, "spin") == 0 || strcmp(buf, "1") == 0) {
+        *out_wait = RENDER_THREAD_WAIT_SPIN;
+        return 1;
+    }
+    return 0;
+}
+
+static const char *render_thread_schedule_to_text(int8_t schedule)
+{
+    switch (schedule) {
+    case RENDER_THREAD_SCHEDULE_TILES:    return "tiles";
+    case RENDER_THREAD_SCHEDULE_ADAPTIVE: return "adaptive";
+    default:                              return "strips";
+    }
+}
+
+static const char *render_thread_wait_to_text(int8_t wait)
+{
+    return (wait == RENDER_THREAD_WAIT_SPIN) ? "spin" : "block";
+}
+
 static const char *display_mode_to_text(int8_t mode)
 {
     switch (mode) {
@@ -161,6 +227,20 @@ static void apply_line(GameState *state, char *line)
         } else {
             printf("[SETTINGS] render_threads_max ignored (use 0..64): %s\n", val);
         }
+    } else if (strcmp(key, "render_thread_schedule") == 0) {
+        int8_t schedule = RENDER_THREAD_SCHEDULE_STRIPS;
+        if (parse_render_thread_schedule_value(val, &schedule)) {
+            state->cfg_render_thread_schedule = schedule;
+        } else {
+            printf("[SETTINGS] render_thread_schedule ignored (use strips/tiles/adaptive): %s\n", val);
+        }
+    } else if (strcmp(key, "render_thread_wait") == 0) {
+        int8_t wait = RENDER_THREAD_WAIT_BLOCK;
+        if (parse_render_thread_wait_value(val, &wait)) {
+            state->cfg_render_thread_wait = wait;
+        } else {
+            printf("[SETTINGS] render_thread_wait ignored (use block/spin): %s\n", val);
+        }
     } else if (strcmp(key, "volume") == 0) {
         int n = atoi(val);
         if (n >= 0 && n <= 100) {
@@ -193,6 +273,24 @@ static void apply_line(GameState *state, char *line)
         state->cfg_post_tint = parse_bool(val) ? true : false;
     } else if (strcmp(key, "weapon_post_gl") == 0) {
         state->cfg_weapon_post_gl = parse_bool(val) ? true : false;
+    } else if (strcmp(key, "present_pipeline") == 0) {
+        state->cfg_present_pipeline = parse_bool(val) ? true : false;
+    } else if (strcmp(key, "fixed_timestep") == 0) {
+        state->cfg_fixed_timestep = parse_bool(val) ? true : false;
+    } else if (strcmp(key, "dynamic_resolution_ms") == 0) {
+        int n = atoi(val);
+        if (n >= 0 && n <= 100) {
+            state->cfg_dynamic_resolution_ms = (int16_t)n;
+        } else {
+            printf("[SETTINGS] dynamic_resolution_ms ignored (use 0 or 1..100): %s\n", val);
+        }
+    } else if (strcmp(key, "dynamic_resolution_min") == 0) {
+        int n = atoi(val);
+        if (n >= 25 && n <= 100) {
+            state->cfg_dynamic_resolution_min = (int16_t)n;
+        } else {
+            printf("[SETTINGS] dynamic_resolution_min ignored (use 25..100): %s\n", val);
+        }
     }
 }
 
@@ -206,6 +304,7 @@ static void apply_runtime_constraints(GameState *state)
     }
     state->cfg_render_threads = false;
     state->cfg_render_threads_max = 0;
+    state->cfg_present_pipeline = false;
 #else
     (void)state;
 #endif
@@ -214,7 +313,7 @@ static void apply_runtime_constraints(GameState *state)
 static void log_effective_settings(const GameState *state, const char *source_label)
 {
     if (state->cfg_start_level >= 0) {
-        printf("[SETTINGS] %s: start_level=%d infinite_health=%d infinite_ammo=%d all_weapons=%d all_keys=%d display_mode=%s render=%dx%d supersampling=%d render_threads=%d render_threads_max=%d volume=%d audio_buffer_samples=%d y_proj_scale=%d billboard_sprite_rendering_enhancement=%d weapon_draw=%d post_tint=%d weapon_post_gl=%d show_fps=%d\n",
+        printf("[SETTINGS] %s: start_level=%d infinite_health=%d infinite_ammo=%d all_weapons=%d all_keys=%d display_mode=%s render=%dx%d supersampling=%d render_threads=%d render_threads_max=%d render_thread_schedule=%s render_thread_wait=%s volume=%d audio_buffer_samples=%d y_proj_scale=%d billboard_sprite_rendering_enhancement=%d weapon_draw=%d post_tint=%d weapon_post_gl=%d show_fps=%d present_pipeline=%d fixed_timestep=%d dynamic_resolution_ms=%d dynamic_resolution_min=%d\n",
                source_label,
                (int)state->cfg_start_level + 1,
                state->infinite_health ? 1 : 0,
@@ -227,6 +326,8 @@ static void log_effective_settings(const GameState *state, const char *source_la
                (int)state->cfg_supersampling,
                state->cfg_render_threads ? 1 : 0,
                (int)state->cfg_render_threads_max,
+               render_thread_schedule_to_text(state->cfg_render_thread_schedule),
+               render_thread_wait_to_text(state->cfg_render_thread_wait),
                (int)state->cfg_volume,
              (int)state->cfg_audio_buffer_samples,
                (int)state->cfg_y_proj_scale,
@@ -234,9 +335,13 @@ static void log_effective_settings(const GameState *state, const char *source_la
                state->cfg_weapon_draw ? 1 : 0,
                state->cfg_post_tint ? 1 : 0,
                state->cfg_weapon_post_gl ? 1 : 0,
-               state->cfg_show_fps ? 1 : 0);
+               state->cfg_show_fps ? 1 : 0,
+               state->cfg_present_pipeline ? 1 : 0,
+               state->cfg_fixed_timestep ? 1 : 0,
+               (int)state->cfg_dynamic_resolution_ms,
+               (int)state->cfg_dynamic_resolution_min);
     } else {
-         printf("[SETTINGS] %s: start_level=default infinite_health=%d infinite_ammo=%d all_weapons=%d all_keys=%d display_mode=%s render=%dx%d supersampling=%d render_threads=%d render_threads_max=%d volume=%d audio_buffer_samples=%d y_proj_scale=%d billboard_sprite_rendering_enhancement=%d weapon_draw=%d post_tint=%d weapon_post_gl=%d show_fps=%d\n",
+         printf("[SETTINGS] %s: start_level=default infinite_health=%d infinite_ammo=%d all_weapons=%d all_keys=%d display_mode=%s render=%dx%d supersampling=%d render_threads=%d render_threads_max=%d render_thread_schedule=%s render_thread_wait=%s volume=%d audio_buffer_samples=%d y_proj_scale=%d billboard_sprite_rendering_enhancement=%d weapon_draw=%d post_tint=%d weapon_post_gl=%d show_fps=%d present_pipeline=%d fixed_timestep=%d dynamic_resolution_ms=%d dynamic_resolution_min=%d\n",
                source_label,
                state->infinite_health ? 1 : 0,
                state->infinite_ammo ? 1 : 0,
@@ -248,6 +353,8 @@ static void log_effective_settings(const GameState *state, const char *source_la
                (int)state->cfg_supersampling,
                state->cfg_render_threads ? 1 : 0,
                (int)state->cfg_render_threads_max,
+               render_thread_schedule_to_text(state->cfg_render_thread_schedule),
+               render_thread_wait_to_text(state->cfg_render_thread_wait),
                (int)state->cfg_volume,
                (int)state->cfg_audio_buffer_samples,
                (int)state->cfg_y_proj_scale,
@@ -255,7 +362,11 @@ static void log_effective_settings(const GameState *state, const char *source_la
                state->cfg_weapon_draw ? 1 : 0,
                state->cfg_post_tint ? 1 : 0,
                state->cfg_weapon_post_gl ? 1 : 0,
-               state->cfg_show_fps ? 1 : 0);
+               state->cfg_show_fps ? 1 : 0,
+               state->cfg_present_pipeline ? 1 : 0,
+               state->cfg_fixed_timestep ? 1 : 0,
+               (int)state->cfg_dynamic_resolution_ms,
+               (int)state->cfg_dynamic_resolution_min);
     }
 }
 
@@ -314,6 +425,15 @@ void settings_load(GameState *state)
     log_effective_settings(state, "Defaults");
 }
 
+int settings_env_feature_enabled(int *cache, const char *disable_env)
+{
+    if (cache && *cache >= 0) return *cache;
+    const char *env = SDL_getenv(disable_env);
+    int on = (env && env[0] && env[0] != '0') ? 0 : 1;
+    if (cache) *cache = on;
+    return on;
+}
+
 void settings_log_recap(const GameState *state)
 {
     log_effective_settings(state, "Active");
@@ -13,4 +13,9 @@ void settings_load(GameState *state);
 /* One-line summary of INI-backed fields (same values as at startup). Call where useful for logs. */
 void settings_log_recap(const GameState *state);
 
+/* Runtime fast-path switch backed by an AB3D_DISABLE_* environment variable: returns 0 when
+ * disable_env is set to anything but empty/"0", else 1. With a cache (initialize it to -1),
+ * the environment is read once and the answer kept there. */
+int settings_env_feature_enabled(int *cache, const char *disable_env);
+
 #endif
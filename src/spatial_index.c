@@ -0,0 +1,272 @@
+/*
+ * Alien Breed 3D I - PC Port
+ * spatial_index.c - Coarse XZ grid over the level object list
+ */
+
+#include "spatial_index.h"
+#include "game_types.h"
+#include "settings.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define SI_CELL_SHIFT       8      /* 256-unit cells: a few object widths */
+#define SI_BUCKETS          1024   /* hashed cell heads (power of two) */
+#define SI_MAX_OBJECTS      SPATIAL_INDEX_MAX_RESULTS
+#define SI_MAX_QUERY_CELLS  256    /* bigger rect: a list walk is as cheap */
+#define SI_NO_BUCKET        (-1)
+
+typedef struct {
+    const LevelState *level;
+    const uint8_t    *object_data;
+    const uint8_t    *object_points;
+    int16_t           num_object_points;
+    int               valid;
+    int               count;                    /* objects before the cid < 0 terminator */
+    int16_t           cid[SI_MAX_OBJECTS];
+    int16_t           pos_x[SI_MAX_OBJECTS];    /* position the object is filed under */
+    int16_t           pos_z[SI_MAX_OBJECTS];
+    int16_t           bucket[SI_MAX_OBJECTS];   /* SI_NO_BUCKET: no usable ObjectPoints entry */
+    int16_t           next[SI_MAX_OBJECTS];
+    int16_t           prev[SI_MAX_OBJECTS];
+    int16_t           head[SI_BUCKETS];
+    uint32_t          unplaced[SI_MAX_OBJECTS / 32];
+    uint32_t          moved[SI_MAX_OBJECTS / 32];  /* noted since the last relink */
+    int               any_moved;
+    int16_t          *slot_of_cid;              /* cid -> list index, -1 if not listed */
+    int               slot_of_cid_cap;
+} SpatialIndex;
+
+static SpatialIndex g_spatial_index;
+static int g_spatial_index_state = -1;
+
+static int spatial_index_enabled(void)
+{
+    return settings_env_feature_enabled(&g_spatial_index_state, "AB3D_DISABLE_SPATIAL_INDEX");
+}
+
+static int si_bucket_for(int32_t cx, int32_t cz)
+{
+    uint32_t h = (uint32_t)cx * 73856093u ^ (uint32_t)cz * 19349663u;
+    return (int)((h ^ (h >> 13)) & (SI_BUCKETS - 1));
+}
+
+static int si_has_point(const SpatialIndex *si, int16_t cid)
+{
+    return si->object_points && cid >= 0 && cid < si->num_object_points;
+}
+
+static void si_unlink(SpatialIndex *si, int i)
+{
+    int b = si->bucket[i];
+    if (b == SI_NO_BUCKET) {
+        si->unplaced[i >> 5] &= ~(1u << (i & 31));
+        return;
+    }
+    if (si->prev[i] >= 0) si->next[si->prev[i]] = si->next[i];
+    else si->head[b] = si->next[i];
+    if (si->next[i] >= 0) si->prev[si->next[i]] = si->prev[i];
+}
+
+static void si_link(SpatialIndex *si, int i)
+{
+    if (!si_has_point(si, si->cid[i])) {
+        si->bucket[i] = SI_NO_BUCKET;
+        si->unplaced[i >> 5] |= 1u << (i & 31);
+        return;
+    }
+    const uint8_t *p = si->object_points + (size_t)si->cid[i] * 8u;
+    si->pos_x[i] = obj_w(p);
+    si->pos_z[i] = obj_w(p + 4);
+    int b = si_bucket_for((int32_t)si->pos_x[i] >> SI_CELL_SHIFT,
+                          (int32_t)si->pos_z[i] >> SI_CELL_SHIFT);
+    si->bucket[i] = (int16_t)b;
+    si->prev[i] = -1;
+    si->next[i] = si->head[b];
+    if (si->head[b] >= 0) si->prev[si->head[b]] = (int16_t)i;
+    si->head[b] = (int16_t)i;
+}
+
+static void si_build(SpatialIndex *si, const LevelState *level)
+{
+    si->level = level;
+    si->object_data = level->object_data;
+    si->object_points = level->object_points;
+    si->num_object_points = level->num_object_points;
+    si->valid = 0;
+    si->count = 0;
+    si->any_moved = 0;
+    memset(si->head, 0xFF, sizeof(si->head));
+    memset(si->unplaced, 0, sizeof(si->unplaced));
+    memset(si->moved, 0, sizeof(si->moved));
+    if (!level->object_data) return;
+
+    int cid_slots = level->num_object_points > 0 ? level->num_object_points : 0;
+    if (cid_slots > si->slot_of_cid_cap) {
+        int16_t *grown = (int16_t *)realloc(si->slot_of_cid, (size_t)cid_slots * sizeof(int16_t));
+        if (!grown) return;
+        si->slot_of_cid = grown;
+        si->slot_of_cid_cap = cid_slots;
+    }
+    if (si->slot_of_cid) memset(si->slot_of_cid, 0xFF, (size_t)si->slot_of_cid_cap * sizeof(int16_t));
+
+    for (int i = 0;; i++) {
+        int16_t cid = obj_w(level->object_data + (size_t)i * OBJECT_SIZE);
+        if (cid < 0) break;
+        if (i >= SI_MAX_OBJECTS) return; /* list longer than the index: stay invalid */
+        si->cid[i] = cid;
+        if (cid < cid_slots && si->slot_of_cid[cid] < 0) si->slot_of_cid[cid] = (int16_t)i;
+        si_link(si, i);
+        si->count = i + 1;
+    }
+    si->valid = 1;
+}
+
+/* Relink the objects noted by spatial_index_note_moved whose cell changed. */
+static void si_relink_moved(SpatialIndex *si)
+{
+    for (int w = 0; w < SI_MAX_OBJECTS / 32; w++) {
+        uint32_t bits = si->moved[w];
+        si->moved[w] = 0;
+        while (bits) {
+            int b = 0;
+            while (!(bits & (1u << b))) b++;
+            bits &= bits - 1u;
+            int i = w * 32 + b;
+            if (si->bucket[i] == SI_NO_BUCKET) continue;
+            const uint8_t *p = si->object_points + (size_t)si->cid[i] * 8u;
+            int16_t x = obj_w(p);
+            int16_t z = obj_w(p + 4);
+            if (((int32_t)x >> SI_CELL_SHIFT) == ((int32_t)si->pos_x[i] >> SI_CELL_SHIFT) &&
+                ((int32_t)z >> SI_CELL_SHIFT) == ((int32_t)si->pos_z[i] >> SI_CELL_SHIFT)) {
+                si->pos_x[i] = x;
+                si->pos_z[i] = z;
+                continue;
+            }
+            si_unlink(si, i);
+            si_link(si, i);
+        }
+    }
+    si->any_moved = 0;
+}
+
+/* Bring the index up to date with ObjectPoints; returns 0 when unusable. */
+static int si_sync(const LevelState *level)
+{
+    SpatialIndex *si = &g_spatial_index;
+
+    if (!spatial_index_enabled() || !level || !level->object_data) return 0;
+    if (si->level != level || si->object_data != level->object_data ||
+        si->object_points != level->object_points ||
+        si->num_object_points != level->num_object_points) {
+        si_build(si, level);
+        return si->valid;
+    }
+    if (!si->valid) return 0;
+    if (si->any_moved) si_relink_moved(si);
+    return 1;
+}
+
+void spatial_index_begin_tick(const LevelState *level)
+{
+    if (!spatial_index_enabled() || !level) return;
+    si_build(&g_spatial_index, level);
+}
+
+void spatial_index_reset(void)
+{
+    g_spatial_index.level = NULL;
+    g_spatial_index.valid = 0;
+}
+
+void spatial_index_note_moved(int16_t cid)
+{
+    SpatialIndex *si = &g_spatial_index;
+    if (!si->valid || cid < 0 || cid >= si->slot_of_cid_cap) return;
+    int i = si->slot_of_cid[cid];
+    if (i < 0) return;
+    si->moved[i >> 5] |= 1u << (i & 31);
+    si->any_moved = 1;
+}
+
+int spatial_index_object_for_cid(const LevelState *level, int16_t cid)
+{
+    if (cid < 0) return -1;
+    if (si_sync(level)) {
+        const SpatialIndex *si = &g_spatial_index;
+        if (cid < level->num_object_points) return si->slot_of_cid[cid];
+        for (int i = 0; i < si->count; i++) { /* no ObjectPoints entry: not in the table */
+            if (si->cid[i] == cid) return i;
+        }
+        return -1;
+    }
+    if (!level || !level->object_data) return -1;
+    for (int i = 0;; i++) {
+        int16_t c = obj_w(level->object_data + (size_t)i * OBJECT_SIZE);
+        if (c < 0) return -1;
+        if (c == cid) return i;
+    }
+}
+
+int spatial_index_query_rect(const LevelState *level,
+                             int32_t min_x, int32_t min_z,
+                             int32_t max_x, int32_t max_z,
+                             int *out, int out_cap)
+{
+    const SpatialIndex *si = &g_spatial_index;
+    uint32_t hits[SI_MAX_OBJECTS / 32];
+    int n = 0;
+
+    if (!out || out_cap < SI_MAX_OBJECTS) return -1;
+    if (min_x > max_x || min_z > max_z) return 0;
+    if (!si_sync(level)) return -1;
+
+    int32_t cx0 = min_x >> SI_CELL_SHIFT, cx1 = max_x >> SI_CELL_SHIFT;
+    int32_t cz0 = min_z >> SI_CELL_SHIFT, cz1 = max_z >> SI_CELL_SHIFT;
+    if ((int64_t)(cx1 - cx0 + 1) * (int64_t)(cz1 - cz0 + 1) > SI_MAX_QUERY_CELLS)
+        return -1;
+
+    memcpy(hits, si->unplaced, sizeof(hits));
+    for (int32_t cz = cz0; cz <= cz1; cz++) {
+        for (int32_t cx = cx0; cx <= cx1; cx++) {
+            for (int i = si->head[si_bucket_for(cx, cz)]; i >= 0; i = si->next[i]) {
+                int32_t x = si->pos_x[i];
+                int32_t z = si->pos_z[i];
+                if (x < min_x || x > max_x || z < min_z || z > max_z) continue;
+                hits[i >> 5] |= 1u << (i & 31);
+            }
+        }
+    }
+
+    /* Emit in list order (bit order == list index order). */
+    for (int w = 0; w < SI_MAX_OBJECTS / 32; w++) {
+        uint32_t bits = hits[w];
+        while (bits) {
+            int b = 0;
+            while (!(bits & (1u << b))) b++;
+            bits &= bits - 1u;
+            out[n++] = w * 32 + b;
+        }
+    }
+    return n;
+}
+
+int spatial_index_query_radius(const LevelState *level, int32_t x, int32_t z,
+                               int32_t radius, int *out, int out_cap)
+{
+    if (radius < 0) radius = 0;
+    return spatial_index_query_rect(level, x - radius, z - radius,
+                                    x + radius, z + radius, out, out_cap);
+}
+
+int spatial_index_query_segment(const LevelState *level,
+                                int32_t x0, int32_t z0, int32_t x1, int32_t z1,
+                                int32_t radius, int *out, int out_cap)
+{
+    if (radius < 0) radius = 0;
+    return spatial_index_query_rect(level,
+                                    ((x0 < x1) ? x0 : x1) - radius,
+                                    ((z0 < z1) ? z0 : z1) - radius,
+                                    ((x0 > x1) ? x0 : x1) + radius,
+                                    ((z0 > z1) ? z0 : z1) + radius,
+                                    out, out_cap);
+}
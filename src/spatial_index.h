@@ -0,0 +1,60 @@
+/*
+ * Alien Breed 3D I - PC Port
+ * spatial_index.h - Coarse XZ grid over the level object list
+ *
+ * Broadphase for the object-vs-object scans (collision_check, compute_blast,
+ * bullet hit tests). Objects are bucketed by grid cell from their
+ * ObjectPoints position; queries return object-list indices in ascending
+ * order, so callers that used to walk the whole list visit the surviving
+ * candidates in the same order and keep identical results.
+ *
+ * The grid belongs to the simulation thread. It is rebuilt once per tick;
+ * between rebuilds every ObjectPoints position writer reports the cid with
+ * spatial_index_note_moved, and the next query relinks just those objects.
+ * Bulk rewrites (save restore) call spatial_index_reset instead.
+ */
+
+#ifndef SPATIAL_INDEX_H
+#define SPATIAL_INDEX_H
+
+#include "game_state.h"
+
+/* Result capacity for one query; larger than the object list cap. */
+#define SPATIAL_INDEX_MAX_RESULTS 256
+
+/* Rebuild for the current object list (objects_update calls this once per
+ * tick; queries build lazily if the level/object tables changed). */
+void spatial_index_begin_tick(const LevelState *level);
+
+/* Forget the index (level memory released, ObjectPoints rewritten in bulk);
+ * the next query rebuilds it. */
+void spatial_index_reset(void);
+
+/* The ObjectPoints X/Z of cid changed. Cheap; cids that are not in the object
+ * list (shots in their own pools) are ignored. */
+void spatial_index_note_moved(int16_t cid);
+
+/* Object-list index of the object with collision id cid, or -1 (O(1)). */
+int spatial_index_object_for_cid(const LevelState *level, int16_t cid);
+
+/* Objects whose position lies in [min_x,max_x] x [min_z,max_z], plus any
+ * object without a usable ObjectPoints entry (callers re-test those).
+ * Returns the count written to out (ascending list indices), or -1 when
+ * the index is unavailable / the rectangle is too large to be worth it -
+ * callers then fall back to the full list walk. */
+int spatial_index_query_rect(const LevelState *level,
+                             int32_t min_x, int32_t min_z,
+                             int32_t max_x, int32_t max_z,
+                             int *out, int out_cap);
+
+/* Square of half-size radius around (x, z). Same contract as query_rect. */
+int spatial_index_query_radius(const LevelState *level, int32_t x, int32_t z,
+                               int32_t radius, int *out, int out_cap);
+
+/* Objects within radius of the segment (x0,z0)-(x1,z1), by bounding box.
+ * Same contract as query_rect. */
+int spatial_index_query_segment(const LevelState *level,
+                                int32_t x0, int32_t z0, int32_t x1, int32_t z1,
+                                int32_t radius, int *out, int out_cap);
+
+#endif /* SPATIAL_INDEX_H */
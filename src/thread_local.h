@@ -0,0 +1,19 @@
+/*
+ * Alien Breed 3D I - PC Port
+ * thread_local.h - Portable thread-local storage qualifier
+ */
+
+#ifndef THREAD_LOCAL_H
+#define THREAD_LOCAL_H
+
+#if defined(_MSC_VER)
+#define AB3D_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#define AB3D_THREAD_LOCAL _Thread_local
+#elif defined(__GNUC__) || defined(__clang__)
+#define AB3D_THREAD_LOCAL __thread
+#else
+#define AB3D_THREAD_LOCAL
+#endif
+
+#endif /* THREAD_LOCAL_H */
@@ -0,0 +1,179 @@
+/*
+ * Alien Breed 3D I - PC Port
+ * trace.c - Per-thread timeline capture, written as Chrome trace JSON
+ */
+
+#include "trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "logging.h"
+#include "thread_local.h"
+#define printf ab3d_log_printf
+
+#define TRACE_RING_MASK (TRACE_RING_EVENTS - 1)
+/* A wrapped ring may be overwriting its oldest slots while it is written out. */
+#define TRACE_WRAP_GUARD 64
+
+typedef struct {
+    const char *name;
+    uint64_t t0, t1;
+} TraceEvent;
+
+typedef struct {
+    char name[32];
+    int tid;
+    SDL_atomic_t generation; /* capture the count belongs to; owner writes only */
+    SDL_atomic_t count;   /* events appended since the capture started; owner writes only */
+    TraceEvent events[TRACE_RING_EVENTS];
+} TraceRing;
+
+volatile int g_trace_capturing = 0;
+
+static TraceRing *g_trace_rings[TRACE_MAX_THREADS];
+static SDL_atomic_t g_trace_ring_count;
+/* Bumped by trace_start; each owner zeroes its own ring when it sees a new value. */
+static SDL_atomic_t g_trace_generation;
+static uint64_t g_trace_start = 0;
+static const char *g_trace_path = NULL;     /* AB3D_TRACE */
+static int g_trace_out_of_rings_logged = 0;
+
+static AB3D_THREAD_LOCAL TraceRing *t_trace_ring = NULL;
+static AB3D_THREAD_LOCAL char t_trace_name[32];
+
+static TraceRing *trace_ring_for_thread(void)
+{
+    if (t_trace_ring) return t_trace_ring;
+
+    int slot = SDL_AtomicAdd(&g_trace_ring_count, 1);
+    if (slot >= TRACE_MAX_THREADS) {
+        SDL_AtomicAdd(&g_trace_ring_count, -1);
+        if (!g_trace_out_of_rings_logged) {
+            g_trace_out_of_rings_logged = 1;
+            printf("[TRACE] more than %d threads; extra threads are not recorded\n", TRACE_MAX_THREADS);
+        }
+        return NULL;
+    }
+    TraceRing *ring = (TraceRing *)calloc(1, sizeof(*ring));
+    if (!ring) return NULL;
+    ring->tid = slot + 1;
+    if (t_trace_name[0]) snprintf(ring->name, sizeof(ring->name), "%s", t_trace_name);
+    else snprintf(ring->name, sizeof(ring->name), "thread %d", ring->tid);
+    SDL_MemoryBarrierRelease();
+    g_trace_rings[slot] = ring;
+    t_trace_ring = ring;
+    return ring;
+}
+
+void trace_set_thread_name(const char *name)
+{
+    snprintf(t_trace_name, sizeof(t_trace_name), "%s", name ? name : "");
+    if (t_trace_ring) snprintf(t_trace_ring->name, sizeof(t_trace_ring->name), "%s", t_trace_name);
+}
+
+void trace_record(const char *name, uint64_t t0, uint64_t t1)
+{
+    TraceRing *ring = trace_ring_for_thread();
+    if (!ring) return;
+    int gen = SDL_AtomicGet(&g_trace_generation);
+    if (SDL_AtomicGet(&ring->generation) != gen) {
+        SDL_AtomicSet(&ring->count, 0);
+        SDL_AtomicSet(&ring->generation, gen);
+    }
+    int n = SDL_AtomicGet(&ring->count);
+    TraceEvent *ev = &ring->events[n & TRACE_RING_MASK];
+    ev->name = name;
+    ev->t0 = t0;
+    ev->t1 = t1;
+    SDL_MemoryBarrierRelease();
+    SDL_AtomicSet(&ring->count, n + 1);
+}
+
+static void trace_start(void)
+{
+    SDL_AtomicAdd(&g_trace_generation, 1);
+    g_trace_start = SDL_GetPerformanceCounter();
+    SDL_MemoryBarrierRelease();
+    g_trace_capturing = 1;
+}
+
+static void trace_write(const char *path)
+{
+    double us_per_tick = 1000000.0 / (double)SDL_GetPerformanceFrequency();
+    long written = 0;
+    int first = 1;
+    FILE *f = fopen(path, "w");
+
+    if (!f) {
+        printf("[TRACE] cannot write %s\n", path);
+        return;
+    }
+    SDL_MemoryBarrierAcquire();
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    int rings = SDL_AtomicGet(&g_trace_ring_count);
+    for (int r = 0; r < rings && r < TRACE_MAX_THREADS; r++) {
+        const TraceRing *ring = g_trace_rings[r];
+        if (!ring) continue;
+        /* Not written to since this capture started: its events are stale. */
+        int stale = SDL_AtomicGet((SDL_atomic_t *)&ring->generation) !=
+                    SDL_AtomicGet(&g_trace_generation);
+        fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                first ? "" : ",\n", ring->tid, ring->name);
+        first = 0;
+
+        int count = stale ? 0 : SDL_AtomicGet((SDL_atomic_t *)&ring->count);
+        int begin = 0;
+        if (count > TRACE_RING_EVENTS) begin = count - TRACE_RING_EVENTS + TRACE_WRAP_GUARD;
+        for (int i = begin; i < count; i++) {
+            const TraceEvent *ev = &ring->events[i & TRACE_RING_MASK];
+            if (!ev->name || ev->t0 < g_trace_start || ev->t1 < ev->t0) continue;
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    ev->name, ring->tid,
+                    (double)(ev->t0 - g_trace_start) * us_per_tick,
+                    (double)(ev->t1 - ev->t0) * us_per_tick);
+            written++;
+        }
+    }
+    fprintf(f, "\n]}\n");
+    fclose(f);
+    printf("[TRACE] wrote %ld events from %d threads to %s\n", written, rings, path);
+}
+
+static void trace_stop_and_write(void)
+{
+    g_trace_capturing = 0;
+    trace_write(g_trace_path ? g_trace_path : "ab3d_trace.json");
+}
+
+void trace_init(void)
+{
+    const char *env = getenv("AB3D_TRACE");
+    trace_set_thread_name("main");
+    if (env && env[0]) {
+        g_trace_path = env;
+        trace_start();
+        printf("[TRACE] capturing to %s (written at exit; F8 writes early)\n", g_trace_path);
+    }
+}
+
+void trace_toggle(void)
+{
+    if (g_trace_capturing) {
+        trace_stop_and_write();
+    } else {
+        trace_start();
+        printf("[TRACE] capture started (F8 again to write it)\n");
+    }
+}
+
+void trace_shutdown(void)
+{
+    if (g_trace_capturing) trace_stop_and_write();
+    int rings = SDL_AtomicGet(&g_trace_ring_count);
+    for (int i = 0; i < rings && i < TRACE_MAX_THREADS; i++) {
+        free(g_trace_rings[i]);
+        g_trace_rings[i] = NULL;
+    }
+    SDL_AtomicSet(&g_trace_ring_count, 0);
+    t_trace_ring = NULL;
+}
@@ -0,0 +1,53 @@
+/*
+ * Alien Breed 3D I - PC Port
+ * trace.h - Per-thread timeline capture, written as Chrome trace JSON
+ *
+ * [RPROF] only prints interval averages; this records every scope with its
+ * begin/end time and thread, so worker imbalance and present stalls can be
+ * read off a timeline (chrome://tracing, ui.perfetto.dev).
+ *
+ * Each thread appends complete events to its own ring (allocated on its
+ * first event, never shared with other writers), so recording takes no
+ * lock. Capture runs from startup to exit with AB3D_TRACE=<path>, or
+ * between two F8 presses (written to AB3D_TRACE or ab3d_trace.json). A ring
+ * that wraps keeps its newest TRACE_RING_EVENTS events.
+ *
+ * Event names must be string literals (only the pointer is stored).
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <SDL.h>
+#include <stdint.h>
+
+#define TRACE_RING_EVENTS 65536
+#define TRACE_MAX_THREADS 64
+
+extern volatile int g_trace_capturing;
+
+/* Read AB3D_TRACE; start capturing when it is set. */
+void trace_init(void);
+/* Write the capture if one is running (AB3D_TRACE mode), free the rings. */
+void trace_shutdown(void);
+/* F8: start a capture, or stop the running one and write it. */
+void trace_toggle(void);
+
+/* Label the calling thread's track (copied; call before its first event). */
+void trace_set_thread_name(const char *name);
+
+void trace_record(const char *name, uint64_t t0, uint64_t t1);
+
+/* uint64_t t = trace_begin(); ...; trace_end("phase", t);
+ * Both are one branch when no capture is running. */
+static inline uint64_t trace_begin(void)
+{
+    return g_trace_capturing ? SDL_GetPerformanceCounter() : 0;
+}
+
+static inline void trace_end(const char *name, uint64_t t0)
+{
+    if (t0 && g_trace_capturing) trace_record(name, t0, SDL_GetPerformanceCounter());
+}
+
+#endif /* TRACE_H */
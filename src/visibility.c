@@ -8,7 +8,10 @@
 #include "visibility.h"
 #include "level.h"
 #include "math_tables.h"
+#include "thread_local.h"
+#include "settings.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 /* -----------------------------------------------------------------------
@@ -44,6 +47,12 @@ static int resolve_lgr_entry_zone_id(const LevelState *level, int16_t entry_word
     if (level && level->zone_graph_adds && level->graphics) {
         if (level->num_zone_graph_entries > 0 && entry_word >= level->num_zone_graph_entries)
             return 0;
+        if (level->decoded && entry_word < level->decoded->num_graph_entries) {
+            int32_t zid = level->decoded->graph_zone_id[entry_word];
+            if (zid == LEVEL_GRAPH_ZONE_NONE) return 0;
+            *out_zone_id = (int16_t)zid;
+            return 1;
+        }
         {
             uint32_t gfx_off = (uint32_t)read_be32(level->zone_graph_adds + (unsigned)entry_word * 8u);
             if (level->graphics_byte_count > 0 &&
@@ -174,6 +183,58 @@ static void move_before(int node, int before,
     prev[before] = node;
 }
 
+/* Settodraw: collect the listed zones in list order, mark them in
+ * to_draw_tab and seed each zone's WorkSpace gate long. Returns the count. */
+static int order_zones_gather(const LevelState *level, const uint8_t *list_of_graph_rooms,
+                              int16_t zone_list[256], uint8_t to_draw_tab[256],
+                              uint32_t workspace[256])
+{
+    int num_zones = 0;
+
+    memset(to_draw_tab, 0, 256);
+    memset(workspace, 0, 256 * sizeof(uint32_t));
+    if (!list_of_graph_rooms) return 0;
+
+    {
+        /* A zone's own list: the decoded PVS already holds the result. */
+        const uint32_t *gate;
+        int count;
+        const int16_t *pvs = level_graph_room_pvs(level, list_of_graph_rooms, &gate, &count);
+        if (pvs) {
+            for (int i = 0; i < count && num_zones < MAX_ORDER_ENTRIES; i++) {
+                int16_t zid = pvs[i];
+                if (zid < 0 || zid >= 256) continue;
+                to_draw_tab[zid] = 1;
+                workspace[zid] = gate[i];
+                zone_list[num_zones++] = zid;
+            }
+            return num_zones;
+        }
+    }
+
+    const uint8_t *lgr = list_of_graph_rooms;
+    int zone_slots = level_zone_slot_count(level);
+    while (num_zones < MAX_ORDER_ENTRIES) {
+        int16_t entry_word = read_be16(lgr);
+        int16_t zid = -1;
+        if (entry_word < 0) break;
+        if (resolve_lgr_entry_zone_id(level, entry_word, &zid) &&
+            zid >= 0 && zid < 256 &&
+            (zone_slots <= 0 || zid < zone_slots)) {
+            if (!to_draw_tab[zid]) {
+                to_draw_tab[zid] = 1;
+                workspace[zid] = read_be32(lgr + 4);
+                zone_list[num_zones++] = zid;
+            } else {
+                /* Multiple graph entries can alias one zone id; preserve any gate bits. */
+                workspace[zid] |= read_be32(lgr + 4);
+            }
+        }
+        lgr += 8;
+    }
+    return num_zones;
+}
+
 /* -----------------------------------------------------------------------
  * order_zones - Amiga OrderZones: traverse list from current zone, then
  * reorder by portal (exit-line) side test so back-to-front order is correct.
@@ -185,15 +246,10 @@ static void move_before(int node, int before,
  *    but currently drawn before current, move current in front of connected.
  * 4. Output final list order.
  * ----------------------------------------------------------------------- */
-void order_zones(ZoneOrder *out, const LevelState *level,
-                 int32_t viewer_x, int32_t viewer_z,
-                 int32_t move_dx, int32_t move_dz,
-                 int viewer_angle,
-                 const uint8_t *list_of_graph_rooms)
+static void order_zones_build(ZoneOrder *out, const LevelState *level,
+                              int32_t viewer_x, int32_t viewer_z,
+                              const uint8_t *list_of_graph_rooms)
 {
-    (void)move_dx;
-    (void)move_dz;
-    (void)viewer_angle;
     out->count = 0;
 
     {
@@ -202,37 +258,11 @@ void order_zones(ZoneOrder *out, const LevelState *level,
         }
 
         uint8_t to_draw_tab[256];
-        memset(to_draw_tab, 0, sizeof(to_draw_tab));
-
         /* WorkSpace[zone_id] = long at offset 4 in list entry (Amiga settodraw). */
         uint32_t workspace[256];
-        memset(workspace, 0, sizeof(workspace));
-
         int16_t zone_list[256];
-        int num_zones = 0;
-
-        if (list_of_graph_rooms) {
-            const uint8_t *lgr = list_of_graph_rooms;
-            int zone_slots = level_zone_slot_count(level);
-            while (num_zones < MAX_ORDER_ENTRIES) {
-                int16_t entry_word = read_be16(lgr);
-                int16_t zid = -1;
-                if (entry_word < 0) break;
-                if (resolve_lgr_entry_zone_id(level, entry_word, &zid) &&
-                    zid >= 0 && zid < 256 &&
-                    (zone_slots <= 0 || zid < zone_slots)) {
-                    if (!to_draw_tab[zid]) {
-                        to_draw_tab[zid] = 1;
-                        workspace[zid] = read_be32(lgr + 4);
-                        zone_list[num_zones++] = zid;
-                    } else {
-                        /* Multiple graph entries can alias one zone id; preserve any gate bits. */
-                        workspace[zid] |= read_be32(lgr + 4);
-                    }
-                }
-                lgr += 8;
-            }
-        }
+        int num_zones = order_zones_gather(level, list_of_graph_rooms,
+                                           zone_list, to_draw_tab, workspace);
         if (num_zones == 0) return;
 
         /* Narrow fallback path for the known problematic viewpoint:
@@ -282,20 +312,20 @@ void order_zones(ZoneOrder *out, const LevelState *level,
                         uint32_t d6 = workspace[cur_zone];
                         for (int ei = 0; ei < 64; ei++) {
                             int16_t line_idx = read_be16(exit_list + ei * 2);
-                            const uint8_t *fline;
+                            LevelFloorLine fl;
                             int32_t lx, lz, word4, word6;
                             int connect_index;
                             if (line_idx < 0) break;
                             if (line_idx >= level->num_floor_lines) continue;
 
-                            fline = level->floor_lines + (int)line_idx * FLINE_SIZE;
-                            connect_index = level_connect_to_zone_index(level, read_be16(fline + FLINE_CONNECT));
+                            level_floor_line(level, line_idx, &fl);
+                            connect_index = fl.connect_zone;
                             if (connect_index < 0 || connect_index >= 256 || !to_draw_tab[connect_index]) continue;
 
-                            lx = (int32_t)read_be16(fline + FLINE_X);
-                            lz = (int32_t)read_be16(fline + FLINE_Z);
-                            word4 = (int32_t)read_be16(fline + FLINE_WORD4);
-                            word6 = (int32_t)read_be16(fline + FLINE_WORD6);
+                            lx = (int32_t)fl.x;
+                            lz = (int32_t)fl.z;
+                            word4 = (int32_t)fl.xlen;
+                            word6 = (int32_t)fl.zlen;
 
                             /* Amiga InsertList bit flow:
                              *   b   = d7 (indrawlist gate)
@@ -357,20 +387,20 @@ void order_zones(ZoneOrder *out, const LevelState *level,
                             for (int ei = 0; ei < 128; ei++) {
                                 int16_t line_idx = read_be16(exit_list + ei * 2);
                                 int connect_index, conn_node;
-                                const uint8_t *fline;
+                                LevelFloorLine fl;
                                 int32_t lx, lz, word4, word6, dx, dz, side;
 
                                 if (line_idx < 0) break;
                                 if (line_idx >= level->num_floor_lines) continue;
 
-                                fline = level->floor_lines + (int)line_idx * FLINE_SIZE;
-                                connect_index = level_connect_to_zone_index(level, read_be16(fline + FLINE_CONNECT));
+                                level_floor_line(level, line_idx, &fl);
+                                connect_index = fl.connect_zone;
                                 if (connect_index < 0 || connect_index >= 256 || !to_draw_tab[connect_index]) continue;
 
-                                lx = (int32_t)read_be16(fline + FLINE_X);
-                                lz = (int32_t)read_be16(fline + FLINE_Z);
-                                word4 = (int32_t)read_be16(fline + FLINE_WORD4);
-                                word6 = (int32_t)read_be16(fline + FLINE_WORD6);
+                                lx = (int32_t)fl.x;
+                                lz = (int32_t)fl.z;
+                                word4 = (int32_t)fl.xlen;
+                                word6 = (int32_t)fl.zlen;
                                 dx = viewer_x - lx;
                                 dz = viewer_z - lz;
                                 side = dx * word6 - dz * word4;
@@ -407,61 +437,207 @@ void order_zones(ZoneOrder *out, const LevelState *level,
 }
 
 /* -----------------------------------------------------------------------
- * can_it_be_seen - Line-of-sight (ObjectMove.s CanItBeSeen)
+ * Zone order cache
  *
- * 1. Same room: visible only if viewer_top == target_top.
- * 2. Else: to_room must be in from_room list-of-graph (when graph available).
- * 3. Clip points: left/right clip test when clips/points available.
- * 4. GoThroughZones: exit cross test, crossing height (fline+10 divisor),
- *    clearance vs current room (ViewerTop), GotIn (entry_top), target_top at end.
+ * order_zones_build reads the viewer only through "side > 0" tests on exit
+ * lines whose far zone is also in the list; everything else it reads (the
+ * list, gate longs, exit lists, floor line geometry) is fixed for a given
+ * ListOfGraphRooms. So when the list changes (viewer enters another zone,
+ * new level) its portal lines are collected once, and each call evaluates
+ * just those side tests into a bitset. While the bitset matches the one the
+ * cached order was built with, the order is reused as-is; otherwise it is
+ * rebuilt and cached. Door state is not an input to this ordering.
+ *
+ * Only the game loop orders zones, so one cache entry is enough.
+ * AB3D_DISABLE_ZONE_ORDER_CACHE=1 rebuilds every call.
  * ----------------------------------------------------------------------- */
-uint8_t can_it_be_seen(const LevelState *level,
-                       const uint8_t *from_room, const uint8_t *to_room,
-                       int16_t to_zone_id,
-                       int16_t viewer_x, int16_t viewer_z, int16_t viewer_y,
-                       int16_t target_x, int16_t target_z, int16_t target_y,
-                       int8_t viewer_top, int8_t target_top,
-                       int full_height)
+#define ZONE_ORDER_CACHE_MAX_PORTALS 1024
+
+typedef struct {
+    int               valid;
+    const LevelState *level;
+    const uint8_t    *data;
+    const uint8_t    *zone_adds;
+    const uint8_t    *floor_lines;
+    const uint8_t    *lgr;
+    int               portal_count;     /* -1: list has too many portals, no caching */
+    int32_t           portal_x[ZONE_ORDER_CACHE_MAX_PORTALS];
+    int32_t           portal_z[ZONE_ORDER_CACHE_MAX_PORTALS];
+    int32_t           portal_word4[ZONE_ORDER_CACHE_MAX_PORTALS];
+    int32_t           portal_word6[ZONE_ORDER_CACHE_MAX_PORTALS];
+    int               have_order;
+    uint32_t          side_bits[ZONE_ORDER_CACHE_MAX_PORTALS / 32];
+    ZoneOrder         order;
+} ZoneOrderCache;
+
+static ZoneOrderCache g_zone_order_cache;
+static int g_zone_order_cache_state = -1;
+
+void order_zones_invalidate_cache(void)
 {
-    int current_zone_idx;
-    int target_zone_idx;
+    g_zone_order_cache.valid = 0;
+    g_zone_order_cache.have_order = 0;
+}
 
-    if (!level->data || !level->floor_lines) {
-        return 0;
+/* Collect every exit line either ordering pass could side-test for this list
+ * (both passes skip lines whose connected zone is not listed). */
+static void zone_order_cache_collect(ZoneOrderCache *c, const LevelState *level,
+                                     const uint8_t *list_of_graph_rooms)
+{
+    uint8_t to_draw_tab[256];
+    uint32_t workspace[256];
+    int16_t zone_list[256];
+    int num_zones = order_zones_gather(level, list_of_graph_rooms,
+                                       zone_list, to_draw_tab, workspace);
+    int n = 0;
+
+    for (int i = 0; i < num_zones && n >= 0; i++) {
+        int32_t zone_off = read_be32(level->zone_adds + (int)zone_list[i] * 4);
+        if (zone_off == 0) continue;
+        const uint8_t *zone_data = level->data + zone_off;
+        int16_t exit_rel = read_be16(zone_data + ZONE_EXIT_LIST);
+        if (exit_rel == 0) continue;
+        const uint8_t *exit_list = zone_data + exit_rel;
+        for (int ei = 0; ei < 128; ei++) {
+            int16_t line_idx = read_be16(exit_list + ei * 2);
+            if (line_idx < 0) break;
+            if (line_idx >= level->num_floor_lines) continue;
+            LevelFloorLine fl;
+            level_floor_line(level, line_idx, &fl);
+            int connect_index = fl.connect_zone;
+            if (connect_index < 0 || connect_index >= 256 || !to_draw_tab[connect_index]) continue;
+            if (n >= ZONE_ORDER_CACHE_MAX_PORTALS) {
+                n = -1;
+                break;
+            }
+            c->portal_x[n] = (int32_t)fl.x;
+            c->portal_z[n] = (int32_t)fl.z;
+            c->portal_word4[n] = (int32_t)fl.xlen;
+            c->portal_word6[n] = (int32_t)fl.zlen;
+            n++;
+        }
     }
 
-    if (!level->zone_adds) return 0;
-    int zone_slots = level_zone_slot_count(level);
-    if (zone_slots <= 0) return 0;
+    c->valid = 1;
+    c->level = level;
+    c->data = level->data;
+    c->zone_adds = level->zone_adds;
+    c->floor_lines = level->floor_lines;
+    c->lgr = list_of_graph_rooms;
+    c->portal_count = n;
+    c->have_order = 0;
+}
 
-    current_zone_idx = resolve_zone_index_from_hint_or_room(level, from_room, -1);
-    target_zone_idx = resolve_zone_index_from_hint_or_room(level, to_room, to_zone_id);
+void order_zones(ZoneOrder *out, const LevelState *level,
+                 int32_t viewer_x, int32_t viewer_z,
+                 int32_t move_dx, int32_t move_dz,
+                 int viewer_angle,
+                 const uint8_t *list_of_graph_rooms)
+{
+    ZoneOrderCache *c = &g_zone_order_cache;
+    (void)move_dx;
+    (void)move_dz;
+    (void)viewer_angle;
 
-    if (!full_height) {
-        if (!level_zone_has_upper_layer(level, (int16_t)current_zone_idx))
-            viewer_top = 0;
-        if (!level_zone_has_upper_layer(level, (int16_t)target_zone_idx))
-            target_top = 0;
+    if (!settings_env_feature_enabled(&g_zone_order_cache_state, "AB3D_DISABLE_ZONE_ORDER_CACHE") || !list_of_graph_rooms ||
+        !level->data || !level->zone_adds || !level->floor_lines) {
+        order_zones_build(out, level, viewer_x, viewer_z, list_of_graph_rooms);
+        return;
     }
 
-    /* Same room (insameroom): normally visible only on same floor.
-     * Full-height callers (e.g. blast/hitscan paths) intentionally
-     * allow cross-section visibility in the same zone. */
-    if (from_room == to_room) {
-        if (!full_height &&
-            !level_zone_has_upper_layer(level, (int16_t)current_zone_idx)) {
-            viewer_top = 0;
-            target_top = 0;
-        }
-        if (full_height || viewer_top == target_top)
-            return 0x03u;
-        return 0u;
+    if (!c->valid || c->level != level || c->data != level->data ||
+        c->zone_adds != level->zone_adds || c->floor_lines != level->floor_lines ||
+        c->lgr != list_of_graph_rooms) {
+        zone_order_cache_collect(c, level, list_of_graph_rooms);
+    }
+    if (c->portal_count < 0) {
+        order_zones_build(out, level, viewer_x, viewer_z, list_of_graph_rooms);
+        return;
     }
 
-    /* to_zone_id is the target's zone id (caller passes it; do not read from to_room) */
+    uint32_t bits[ZONE_ORDER_CACHE_MAX_PORTALS / 32];
+    int words = (c->portal_count + 31) / 32;
+    memset(bits, 0, (size_t)words * sizeof(uint32_t));
+    for (int i = 0; i < c->portal_count; i++) {
+        int32_t dx = viewer_x - c->portal_x[i];
+        int32_t dz = viewer_z - c->portal_z[i];
+        if (dx * c->portal_word6[i] - dz * c->portal_word4[i] > 0)
+            bits[i >> 5] |= 1u << (i & 31);
+    }
+
+    if (!c->have_order || memcmp(bits, c->side_bits, (size_t)words * sizeof(uint32_t)) != 0) {
+        order_zones_build(&c->order, level, viewer_x, viewer_z, list_of_graph_rooms);
+        memcpy(c->side_bits, bits, (size_t)words * sizeof(uint32_t));
+        c->have_order = 1;
+    }
+    out->count = c->order.count;
+    memcpy(out->zones, c->order.zones, (size_t)c->order.count * sizeof(int16_t));
+}
+
+/* -----------------------------------------------------------------------
+ * Line-of-sight caches
+ *
+ * The InList scan only depends on the source room and target zone, so its
+ * answer (clip list offset, or "not listed") is kept in a direct-mapped
+ * room-pair cache, the same way level_connect_to_zone_index caches its scan.
+ * Entries carry the level generation (can_it_be_seen_invalidate_level), so
+ * nothing survives a level load or release.
+ *
+ * Whole results are also memoized per tick, keyed by every input. Door and
+ * lift motion changes what a trace sees, so the game loop flushes the memo
+ * (can_it_be_seen_flush_results) at the start of each tick and again after
+ * door_routine/lift_routine. Both caches are thread-local.
+ * AB3D_DISABLE_LOS_CACHE=1 bypasses both.
+ * ----------------------------------------------------------------------- */
+#define LOS_NOT_IN_LIST       ((int16_t)-32768)
+#define LOS_ROOM_CACHE_SIZE   2048
+#define LOS_RESULT_CACHE_SIZE 1024
+
+typedef struct {
+    const uint8_t    *from_room;
+    uint32_t          level_generation; /* 0 = empty */
+    int16_t           to_zone_id;
+    int16_t           clip_off;      /* LOS_NOT_IN_LIST when absent */
+} LosRoomCacheEntry;
+
+typedef struct {
+    const LevelState *level;
+    const uint8_t    *data;
+    LosQuery          q;
+    uint32_t          generation;    /* 0 = empty */
+    uint8_t           result;
+} LosResultCacheEntry;
+
+static AB3D_THREAD_LOCAL LosRoomCacheEntry g_los_room_cache[LOS_ROOM_CACHE_SIZE];
+static AB3D_THREAD_LOCAL LosResultCacheEntry g_los_result_cache[LOS_RESULT_CACHE_SIZE];
+static uint32_t g_los_result_generation = 1;
+/* Bumped on every level load/release: room-list answers depend on the data,
+ * graphics and zone_graph_adds buffers, any of which may be reused at the same address. */
+static uint32_t g_los_level_generation = 1;
+static int g_los_cache_state = -1;
+
+static int los_cache_enabled(void)
+{
+    return settings_env_feature_enabled(&g_los_cache_state, "AB3D_DISABLE_LOS_CACHE");
+}
+
+void can_it_be_seen_flush_results(void)
+{
+    if (++g_los_result_generation == 0)
+        g_los_result_generation = 1;
+}
+
+void can_it_be_seen_invalidate_level(void)
+{
+    if (++g_los_level_generation == 0)
+        g_los_level_generation = 1;
+    can_it_be_seen_flush_results();
+}
+
+static int16_t los_room_list_scan(const LevelState *level, const uint8_t *from_room,
+                                  int16_t to_zone_id)
+{
     const uint8_t *list = from_room + ZONE_LIST_OF_GRAPH;
-    bool in_list = false;
-    int16_t clip_off = -1;
 
     /* InList: is to_room in from_room's list-of-graph?
      *
@@ -488,35 +664,99 @@ uint8_t can_it_be_seen(const LevelState *level,
                 }
                 uint32_t gfx_off = (uint32_t)read_be32(level->zone_graph_adds + (unsigned)word0 * 8u);
                 int16_t entry_zone_id = read_be16(level->graphics + gfx_off);
-                if (entry_zone_id == to_zone_id) {
-                    in_list = true;
-                    clip_off = read_be16(entry + 2);
-                    break;
-                }
+                if (entry_zone_id == to_zone_id)
+                    return (read_be16(entry + 2) < 0) ? (int16_t)-1 : read_be16(entry + 2);
             } else {
                 /* Direct format fallback: first word is zone id (no graph data present) */
-                if (word0 == to_zone_id) {
-                    in_list = true;
-                    clip_off = read_be16(entry + 2);
-                    break;
-                }
+                if (word0 == to_zone_id)
+                    return (read_be16(entry + 2) < 0) ? (int16_t)-1 : read_be16(entry + 2);
             }
 
             entry += 8;
         }
-        if (!in_list) {
-            if (amiga_graph)
-                return 0;   /* target not reachable from this zone */
-            in_list = true; /* no graph data at all: let GoThroughZones decide */
+        /* No graph data at all: let GoThroughZones decide. */
+        return amiga_graph ? LOS_NOT_IN_LIST : (int16_t)-1;
+    }
+}
+
+static int16_t los_room_list_lookup(const LevelState *level, const uint8_t *from_room,
+                                    int16_t to_zone_id)
+{
+    if (!los_cache_enabled())
+        return los_room_list_scan(level, from_room, to_zone_id);
+
+    uintptr_t mix = ((uintptr_t)from_room >> 2) ^
+                    ((uintptr_t)(uint16_t)to_zone_id * 2654435761u);
+    LosRoomCacheEntry *entry = &g_los_room_cache[mix & (LOS_ROOM_CACHE_SIZE - 1)];
+    if (entry->level_generation == g_los_level_generation &&
+        entry->from_room == from_room && entry->to_zone_id == to_zone_id)
+        return entry->clip_off;
+
+    int16_t clip_off = los_room_list_scan(level, from_room, to_zone_id);
+    entry->level_generation = g_los_level_generation;
+    entry->from_room = from_room;
+    entry->to_zone_id = to_zone_id;
+    entry->clip_off = clip_off;
+    return clip_off;
+}
+
+/* -----------------------------------------------------------------------
+ * can_it_be_seen - Line-of-sight (ObjectMove.s CanItBeSeen)
+ *
+ * 1. Same room: visible only if viewer_top == target_top.
+ * 2. Else: to_room must be in from_room list-of-graph (when graph available).
+ * 3. Clip points: left/right clip test when clips/points available.
+ * 4. GoThroughZones: exit cross test, crossing height (fline+10 divisor),
+ *    clearance vs current room (ViewerTop), GotIn (entry_top), target_top at end.
+ * ----------------------------------------------------------------------- */
+/* current_zone_idx: from_room's zone index, resolved once per source room
+ * by can_it_be_seen_batch. */
+static uint8_t los_trace(const LevelState *level, int current_zone_idx,
+                         const uint8_t *from_room, const uint8_t *to_room,
+                         int16_t to_zone_id,
+                         int16_t viewer_x, int16_t viewer_z, int16_t viewer_y,
+                         int16_t target_x, int16_t target_z, int16_t target_y,
+                         int8_t viewer_top, int8_t target_top,
+                         int full_height)
+{
+    int target_zone_idx;
+
+    int zone_slots = level_zone_slot_count(level);
+    if (zone_slots <= 0) return 0;
+
+    target_zone_idx = resolve_zone_index_from_hint_or_room(level, to_room, to_zone_id);
+
+    if (!full_height) {
+        if (!level_zone_has_upper_layer(level, (int16_t)current_zone_idx))
+            viewer_top = 0;
+        if (!level_zone_has_upper_layer(level, (int16_t)target_zone_idx))
+            target_top = 0;
+    }
+
+    /* Same room (insameroom): normally visible only on same floor.
+     * Full-height callers (e.g. blast/hitscan paths) intentionally
+     * allow cross-section visibility in the same zone. */
+    if (from_room == to_room) {
+        if (!full_height &&
+            !level_zone_has_upper_layer(level, (int16_t)current_zone_idx)) {
+            viewer_top = 0;
+            target_top = 0;
         }
+        if (full_height || viewer_top == target_top)
+            return 0x03u;
+        return 0u;
     }
 
+    /* to_zone_id is the target's zone id (caller passes it; do not read from to_room) */
+    int16_t clip_off = los_room_list_lookup(level, from_room, to_zone_id);
+    if (clip_off == LOS_NOT_IN_LIST) return 0;   /* target not reachable from this zone */
+
     int32_t dx = (int32_t)target_x - (int32_t)viewer_x;
     int32_t dz = (int32_t)target_z - (int32_t)viewer_z;
 
     /* Clip check (left/right) when clips/points available.
      * Amiga: d4 = (pz-vz)*dx - (px-vx)*dz; left=ble outlist, right=bge outlist. */
-    if (in_list && clip_off >= 0 && level->clips && level->points) {
+    if (clip_off >= 0 && level->clips && level->points) {
         const uint8_t *clip_ptr = level->clips + (unsigned)clip_off * 2u;
         for (;;) {
             int16_t pt_idx = read_be16(clip_ptr);
@@ -562,12 +802,13 @@ uint8_t can_it_be_seen(const LevelState *level,
             /* Negative sentinel → end of list, no path found → not visible */
             if (line_idx < 0) break;
 
-            const uint8_t *fline = level->floor_lines + (unsigned)line_idx * (unsigned)FLINE_SIZE;
-            int16_t lx    = read_be16(fline + FLINE_X);
-            int16_t lz    = read_be16(fline + FLINE_Z);
-            int16_t lxlen = read_be16(fline + FLINE_XLEN);
-            int16_t lzlen = read_be16(fline + FLINE_ZLEN);
-            int16_t connect = read_be16(fline + FLINE_CONNECT);
+            LevelFloorLine fl;
+            level_floor_line(level, line_idx, &fl);
+            int16_t lx    = fl.x;
+            int16_t lz    = fl.z;
+            int16_t lxlen = fl.xlen;
+            int16_t lzlen = fl.zlen;
+            int16_t connect = fl.connect;
 
             /* Amiga viewer side test (FindWayOut):
              * d4 = (lz-vz)*dx - (lx-vx)*dz  > 0 → viewer on correct side */
@@ -585,7 +826,7 @@ uint8_t can_it_be_seen(const LevelState *level,
 
             /* Wall (no exit) → not visible (Amiga: blt outlist) */
             if (connect < 0) return 0;
-            int connect_index = level_connect_to_zone_index(level, connect);
+            int connect_index = fl.connect_zone;
             if (connect_index < 0 || connect_index >= zone_slots) return 0;
 
             /* Closed door blocks this exit. */
@@ -595,7 +836,7 @@ uint8_t can_it_be_seen(const LevelState *level,
              * Amiga d4 = (tz-lz)*lxlen - (tx-lx)*lzlen  (target signed distance, negated)
              * Amiga d5 = (vx-lx)*lzlen - (vz-lz)*lxlen  (viewer signed distance)
              * crossing_y = viewer_y + d5*dy / (d5+d4) */
-            int16_t divisor = read_be16(fline + FLINE_DIVISOR);
+            int16_t divisor = fl.length;
             if (divisor == 0) divisor = 1;
             int32_t num_t = (int32_t)(target_z - lz) * (int32_t)lxlen
                           - (int32_t)(target_x - lx) * (int32_t)lzlen; /* = Amiga d4 */
@@ -611,7 +852,7 @@ uint8_t can_it_be_seen(const LevelState *level,
             int32_t cross_y = cross_y_16 << 7;
 
             /* Advance into next zone (Amiga: GotIn) */
-            int32_t next_off = read_be32(level->zone_adds + (unsigned)connect_index * 4u);
+            int32_t next_off = fl.target_off;
             const uint8_t *next_zone = level->data + next_off;
 
             int8_t entry_top;
@@ -685,3 +926,123 @@ uint8_t can_it_be_seen(const LevelState *level,
 
     return 0;
 }
+
+static int los_query_equal(const LosQuery *a, const LosQuery *b)
+{
+    return a->from_room == b->from_room && a->to_room == b->to_room &&
+           a->to_zone_id == b->to_zone_id &&
+           a->viewer_x == b->viewer_x && a->viewer_z == b->viewer_z &&
+           a->viewer_y == b->viewer_y &&
+           a->target_x == b->target_x && a->target_z == b->target_z &&
+           a->target_y == b->target_y &&
+           a->viewer_top == b->viewer_top && a->target_top == b->target_top &&
+           a->full_height == b->full_height;
+}
+
+static unsigned int los_query_slot(const LosQuery *q)
+{
+    uint32_t h = 2166136261u;
+    h = (h ^ (uint32_t)((uintptr_t)q->from_room >> 2)) * 16777619u;
+    h = (h ^ (uint32_t)((uintptr_t)q->to_room >> 2)) * 16777619u;
+    h = (h ^ ((uint32_t)(uint16_t)q->viewer_x | ((uint32_t)(uint16_t)q->viewer_z << 16))) * 16777619u;
+    h = (h ^ ((uint32_t)(uint16_t)q->target_x | ((uint32_t)(uint16_t)q->target_z << 16))) * 16777619u;
+    h = (h ^ ((uint32_t)(uint16_t)q->viewer_y | ((uint32_t)(uint16_t)q->target_y << 16))) * 16777619u;
+    h = (h ^ ((uint32_t)(uint8_t)q->viewer_top | ((uint32_t)(uint8_t)q->target_top << 8) |
+              ((uint32_t)(q->full_height != 0) << 16))) * 16777619u;
+    return (unsigned int)(h ^ (h >> 16)) & (LOS_RESULT_CACHE_SIZE - 1);
+}
+
+void can_it_be_seen_batch(const LevelState *level, const LosQuery *queries, int count,
+                          uint8_t *out)
+{
+    const uint8_t *source_room = NULL;
+    int source_zone_idx = -1;
+    int use_cache;
+
+    if (!queries || !out || count <= 0) return;
+    if (!level->data || !level->floor_lines || !level->zone_adds) {
+        memset(out, 0, (size_t)count);
+        return;
+    }
+    use_cache = los_cache_enabled();
+
+    for (int i = 0; i < count; i++) {
+        const LosQuery *q = &queries[i];
+        LosResultCacheEntry *entry = NULL;
+
+        if (use_cache) {
+            entry = &g_los_result_cache[los_query_slot(q)];
+            if (entry->generation == g_los_result_generation &&
+                entry->level == level && entry->data == level->data &&
+                los_query_equal(&entry->q, q)) {
+                out[i] = entry->result;
+                continue;
+            }
+        }
+
+        /* Consecutive queries from one room share its zone resolution. */
+        if (q->from_room != source_room || !source_room) {
+            source_room = q->from_room;
+            source_zone_idx = resolve_zone_index_from_hint_or_room(level, source_room, -1);
+        }
+        out[i] = los_trace(level, source_zone_idx,
+                           q->from_room, q->to_room, q->to_zone_id,
+                           q->viewer_x, q->viewer_z, q->viewer_y,
+                           q->target_x, q->target_z, q->target_y,
+                           q->viewer_top, q->target_top, q->full_height);
+
+        if (entry) {
+            entry->level = level;
+            entry->data = level->data;
+            entry->q = *q;
+            entry->generation = g_los_result_generation;
+            entry->result = out[i];
+        }
+    }
+}
+
+void can_it_be_seen_seed_results(const LevelState *level, const LosQuery *queries,
+                                 const uint8_t *results, int count)
+{
+    if (!queries || !results || count <= 0 || !los_cache_enabled()) return;
+    for (int i = 0; i < count; i++) {
+        LosResultCacheEntry *entry = &g_los_result_cache[los_query_slot(&queries[i])];
+        entry->level = level;
+        entry->data = level->data;
+        entry->q = queries[i];
+        entry->generation = g_los_result_generation;
+        entry->result = results[i];
+    }
+}
+
+int can_it_be_seen_cache_enabled(void)
+{
+    return los_cache_enabled();
+}
+
+uint8_t can_it_be_seen(const LevelState *level,
+                       const uint8_t *from_room, const uint8_t *to_room,
+                       int16_t to_zone_id,
+                       int16_t viewer_x, int16_t viewer_z, int16_t viewer_y,
+                       int16_t target_x, int16_t target_z, int16_t target_y,
+                       int8_t viewer_top, int8_t target_top,
+                       int full_height)
+{
+    LosQuery q;
+    uint8_t vis = 0;
+
+    q.from_room = from_room;
+    q.to_room = to_room;
+    q.to_zone_id = to_zone_id;
+    q.viewer_x = viewer_x;
+    q.viewer_z = viewer_z;
+    q.viewer_y = viewer_y;
+    q.target_x = target_x;
+    q.target_z = target_z;
+    q.target_y = target_y;
+    q.viewer_top = viewer_top;
+    q.target_top = target_top;
+    q.full_height = full_height;
+    can_it_be_seen_batch(level, &q, 1, &vis);
+    return vis;
+}
@@ -33,6 +33,8 @@ typedef struct {
  * Translated from OrderZones.s.
  *
  * Traverses ListOfGraphRooms and outputs zone ids in list order (no sorting).
+ * Results are cached per list and reused while the viewer stays on the same
+ * side of every portal line in it (see visibility.c).
  */
 void order_zones(ZoneOrder *out, const LevelState *level,
                  int32_t viewer_x, int32_t viewer_z,
@@ -40,6 +42,9 @@ void order_zones(ZoneOrder *out, const LevelState *level,
                  int viewer_angle,
                  const uint8_t *list_of_graph_rooms);
 
+/* Drop the cached ordering (level memory released / reloaded). */
+void order_zones_invalidate_cache(void);
+
 /*
  * CanItBeSeen - Line-of-sight check between two points.
  *
@@ -56,4 +61,38 @@ uint8_t can_it_be_seen(const LevelState *level,
                        int8_t viewer_top, int8_t target_top,
                        int full_height);
 
+/* One can_it_be_seen query; arguments as above. */
+typedef struct {
+    const uint8_t *from_room;
+    const uint8_t *to_room;
+    int16_t to_zone_id;
+    int16_t viewer_x, viewer_z, viewer_y;
+    int16_t target_x, target_z, target_y;
+    int8_t viewer_top, target_top;
+    int full_height;
+} LosQuery;
+
+/* Answer count queries into out[] (same bitmask as can_it_be_seen).
+ * Queries sharing a from_room should be adjacent: the source zone is
+ * resolved once per run. Results are memoized until the next flush. */
+void can_it_be_seen_batch(const LevelState *level, const LosQuery *queries, int count,
+                          uint8_t *out);
+
+/* Store results computed elsewhere (e.g. a worker's can_it_be_seen_batch)
+ * in the calling thread's memo for the current tick. Later lookups of an
+ * identical query return them; anything evicted is simply traced again. */
+void can_it_be_seen_seed_results(const LevelState *level, const LosQuery *queries,
+                                 const uint8_t *results, int count);
+
+/* 0 when AB3D_DISABLE_LOS_CACHE is set (seeding is then a no-op). */
+int can_it_be_seen_cache_enabled(void);
+
+/* Invalidate memoized LOS results. Called at the start of each logic tick
+ * and after doors/lifts move, since those change what a trace can see. */
+void can_it_be_seen_flush_results(void);
+
+/* Forget all LOS caches for the current level. Called when a level is loaded
+ * or released (io_invalidate_level_caches). */
+void can_it_be_seen_invalidate_level(void);
+
 #endif /* VISIBILITY_H */
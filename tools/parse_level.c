@@ -7,6 +7,11 @@
  *   Loads data_dir/levels/level_<x>/twolev.graph.bin and twolev.bin.
  *   If data_dir omitted, tries "data", "..", "../data", "."
  *
+ *        parse_level --bake <data_dir> [level|all] [out_file]
+ *   Runs the game's level_parse on twolev.bin/.graph.bin/.clips and writes
+ *   the baked image (see src/level_bake.h), by default to
+ *   data_dir/levels/level_<x>/twolev.bake. "all" bakes every level present.
+ *
  * Graphics file (LEVELGRAPHICS): Amiga big-endian
  *   Long 0: door_offset, Long 4: lift_offset, Long 8: switch_offset, Long 12: zone_graph_offset
  *   Byte 16+: zone_adds (not used here)
@@ -24,7 +29,21 @@
 #include <string.h>
 #include <stdint.h>
 #include <ctype.h>
+#include <stdarg.h>
 #include "sb_decompress.h"
+#include "level.h"
+#include "level_bake.h"
+
+/* level.c / level_bake.c log through this; the game's version needs SDL. */
+int ab3d_log_printf(const char *fmt, ...)
+{
+    va_list ap;
+    int n;
+    va_start(ap, fmt);
+    n = vprintf(fmt, ap);
+    va_end(ap);
+    return n;
+}
 
 static int16_t read_be16(const uint8_t *p)
 {
@@ -298,29 +317,123 @@ static int load_level_file(const char *path, uint8_t **out, size_t *size)
     return sb_load_file(path, out, size);
 }
 
+/* "1".."16" or "a".."p"; anything else is level a. */
+static char parse_level_arg(const char *arg)
+{
+    char level_ch = 'a';
+    if (arg && arg[0]) {
+        if (isdigit((unsigned char)arg[0])) {
+            int n = atoi(arg);
+            if (n >= 1 && n <= 16) level_ch = (char)('a' + (n - 1));
+        } else if (isalpha((unsigned char)arg[0])) {
+            level_ch = (char)tolower((unsigned char)arg[0]);
+            if (level_ch < 'a' || level_ch > 'p') level_ch = 'a';
+        }
+    }
+    return level_ch;
+}
+
+/* Same sequence as the game's level setup (control_loop.c): parse, assign
+ * clips, then the level-specific fixes, whose changes become the patch list. */
+static int bake_level(const char *base, char level_ch, const char *out_path)
+{
+    LevelState level;
+    char path[1024];
+    uint8_t *pre_data = NULL, *pre_graphics = NULL;
+    uint64_t hash;
+    int rc = 1;
+
+    memset(&level, 0, sizeof(level));
+    snprintf(path, sizeof(path), "%s/levels/level_%c/twolev.bin", base, level_ch);
+    if (load_level_file(path, &level.data, &level.data_byte_count) != 0) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return 1;
+    }
+    snprintf(path, sizeof(path), "%s/levels/level_%c/twolev.graph.bin", base, level_ch);
+    if (load_level_file(path, &level.graphics, &level.graphics_byte_count) != 0) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        goto done;
+    }
+    snprintf(path, sizeof(path), "%s/levels/level_%c/twolev.clips", base, level_ch);
+    if (load_level_file(path, &level.clips, &level.clips_byte_count) != 0) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        goto done;
+    }
+
+    printf("[parse_level] Baking level_%c\n", level_ch);
+    hash = level_bake_source_hash(&level);
+    if (level_parse(&level) != 0) {
+        fprintf(stderr, "level_parse failed for level_%c\n", level_ch);
+        goto done;
+    }
+    if (level.clips && level.num_zones > 0)
+        level_assign_clips(&level, level.num_zones);
+
+    pre_data = (uint8_t *)malloc(level.data_byte_count);
+    pre_graphics = (uint8_t *)malloc(level.graphics_byte_count);
+    if (!pre_data || !pre_graphics) goto done;
+    memcpy(pre_data, level.data, level.data_byte_count);
+    memcpy(pre_graphics, level.graphics, level.graphics_byte_count);
+    level_apply_level_specific_fixes(&level, (int16_t)(level_ch - 'a'));
+
+    if (out_path) {
+        rc = level_bake_write(&level, hash, pre_data, pre_graphics, out_path) != 0;
+    } else {
+        snprintf(path, sizeof(path), "%s/levels/level_%c/%s", base, level_ch, LEVEL_BAKE_FILE_NAME);
+        rc = level_bake_write(&level, hash, pre_data, pre_graphics, path) != 0;
+    }
+
+done:
+    level_free_decoded(&level);
+    free(level.zone_index_by_data_offset);
+    free(pre_data);
+    free(pre_graphics);
+    free(level.data);
+    free(level.graphics);
+    free(level.clips);
+    return rc;
+}
+
+static int bake_main(int argc, char **argv)
+{
+    const char *base = (argc > 1) ? argv[1] : "data";
+    const char *which = (argc > 2) ? argv[2] : "a";
+    int failed = 0, baked = 0;
+
+    if (strcmp(which, "all") != 0)
+        return bake_level(base, parse_level_arg(which), (argc > 3) ? argv[3] : NULL);
+
+    for (char c = 'a'; c <= 'p'; c++) {
+        char path[1024];
+        FILE *f;
+        snprintf(path, sizeof(path), "%s/levels/level_%c/twolev.bin", base, c);
+        f = fopen(path, "rb");
+        if (!f) continue;
+        fclose(f);
+        failed += bake_level(base, c, NULL);
+        baked++;
+    }
+    printf("[parse_level] Baked %d of %d levels\n", baked - failed, baked);
+    return (failed || !baked) ? 1 : 0;
+}
+
 int main(int argc, char **argv)
 {
     /* Usage:
      *   parse_level [data_dir] [level]
+     *   parse_level --bake <data_dir> [level|all] [out_file]
      *   level can be 1..16 or a..p (default: a) */
+    if (argc > 1 && strcmp(argv[1], "--bake") == 0)
+        return bake_main(argc - 1, argv + 1);
+
     const char *base = (argc > 1) ? argv[1] : "data";
-    char level_ch = 'a';
+    char level_ch = parse_level_arg((argc > 2) ? argv[2] : NULL);
     static const char *try_bases[] = { "data", "..", "../data", ".", NULL };
     char path[1024];
     uint8_t *graph = NULL, *data = NULL;
     size_t graph_size = 0, data_size = 0;
     const char *used_base = NULL;
 
-    if (argc > 2 && argv[2] && argv[2][0]) {
-        if (isdigit((unsigned char)argv[2][0])) {
-            int n = atoi(argv[2]);
-            if (n >= 1 && n <= 16) level_ch = (char)('a' + (n - 1));
-        } else if (isalpha((unsigned char)argv[2][0])) {
-            level_ch = (char)tolower((unsigned char)argv[2][0]);
-            if (level_ch < 'a' || level_ch > 'p') level_ch = 'a';
-        }
-    }
-
     if (argc > 1) {
         snprintf(path, sizeof(path), "%s/levels/level_%c/twolev.graph.bin", base, level_ch);
         if (load_level_file(path, &graph, &graph_size) == 0) used_base = base;
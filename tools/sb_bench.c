@@ -0,0 +1,147 @@
+/*
+ * Standalone =SB= decoder benchmark - checks the fast decoder against the
+ * reference lha port and reports throughput for both.
+ *
+ * Usage: sb_bench [-n iterations] file...
+ *   file: any =SB= packed asset (twolev.bin, *.wad, ...). With no files,
+ *         tries data/levels/level_a..p/twolev{.bin,.graph.bin,.clips}.
+ *   iterations: decodes per file and decoder (default 20).
+ *
+ * Exits non-zero if any file decodes differently between the two decoders.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "sb_decompress.h"
+
+static double now_sec(void)
+{
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static uint8_t *read_file(const char *path, size_t *out_len)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long len = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (len <= 0) {
+        fclose(f);
+        return NULL;
+    }
+    uint8_t *buf = (uint8_t *)malloc((size_t)len);
+    if (buf && fread(buf, 1, (size_t)len, f) != (size_t)len) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    *out_len = (size_t)len;
+    return buf;
+}
+
+typedef size_t (*DecodeFn)(const uint8_t *, size_t, uint8_t *, size_t);
+
+static double time_decoder(DecodeFn fn, const uint8_t *src, size_t src_len,
+                           uint8_t *dst, size_t dst_len, int iters, size_t *out_n)
+{
+    double best = 1e30;
+    for (int i = 0; i < iters; i++) {
+        double t0 = now_sec();
+        *out_n = fn(src, src_len, dst, dst_len);
+        double dt = now_sec() - t0;
+        if (dt < best) best = dt;
+    }
+    return best;
+}
+
+/* Returns 0 ok, 1 mismatch, -1 skipped. */
+static int bench_file(const char *path, int iters, int verbose_missing, double *tot_ref, double *tot_fast, double *tot_bytes)
+{
+    size_t src_len = 0;
+    uint8_t *src = read_file(path, &src_len);
+    if (!src) {
+        if (verbose_missing) printf("%-48s  cannot read, skipped\n", path);
+        return -1;
+    }
+    if (!sb_is_compressed(src, src_len)) {
+        printf("%-48s  not =SB= packed, skipped\n", path);
+        free(src);
+        return -1;
+    }
+
+    uint32_t unpacked = sb_unpacked_size(src, src_len);
+    uint8_t *ref = (uint8_t *)calloc(1, unpacked ? unpacked : 1);
+    uint8_t *fast = (uint8_t *)calloc(1, unpacked ? unpacked : 1);
+    if (!ref || !fast) {
+        free(ref);
+        free(fast);
+        free(src);
+        return -1;
+    }
+
+    size_t n_ref = 0, n_fast = 0;
+    double t_ref = time_decoder(sb_decompress_reference, src, src_len, ref, unpacked, iters, &n_ref);
+    double t_fast = time_decoder(sb_decompress_fast, src, src_len, fast, unpacked, iters, &n_fast);
+
+    size_t cmp = (n_ref < unpacked) ? n_ref : unpacked;
+    int same = (n_fast == cmp) && memcmp(ref, fast, cmp) == 0;
+    double mb = (double)unpacked / (1024.0 * 1024.0);
+    printf("%-48s  %8u bytes  ref %7.1f MB/s  fast %7.1f MB/s  x%.2f  %s\n",
+           path, unpacked, mb / t_ref, mb / t_fast, t_ref / t_fast, same ? "ok" : "MISMATCH");
+
+    *tot_ref += t_ref;
+    *tot_fast += t_fast;
+    *tot_bytes += (double)unpacked;
+    free(ref);
+    free(fast);
+    free(src);
+    return same ? 0 : 1;
+}
+
+int main(int argc, char *argv[])
+{
+    int iters = 20;
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "-n") == 0) {
+        iters = atoi(argv[2]);
+        if (iters < 1) iters = 1;
+        first = 3;
+    }
+
+    double tot_ref = 0.0, tot_fast = 0.0, tot_bytes = 0.0;
+    int files = 0, bad = 0;
+
+    if (first < argc) {
+        for (int i = first; i < argc; i++) {
+            int r = bench_file(argv[i], iters, 1, &tot_ref, &tot_fast, &tot_bytes);
+            if (r >= 0) files++;
+            if (r > 0) bad++;
+        }
+    } else {
+        static const char *const names[] = { "twolev.bin", "twolev.graph.bin", "twolev.clips" };
+        for (int lvl = 0; lvl < 16; lvl++) {
+            for (int k = 0; k < 3; k++) {
+                char path[256];
+                snprintf(path, sizeof(path), "data/levels/level_%c/%s", 'a' + lvl, names[k]);
+                int r = bench_file(path, iters, 0, &tot_ref, &tot_fast, &tot_bytes);
+                if (r >= 0) files++;
+                if (r > 0) bad++;
+            }
+        }
+    }
+
+    if (files == 0) {
+        fprintf(stderr, "sb_bench: no =SB= files decoded\n");
+        return 2;
+    }
+    double mb = tot_bytes / (1024.0 * 1024.0);
+    printf("total: %d files, %.2f MB  ref %.1f MB/s  fast %.1f MB/s  x%.2f  %d mismatches\n",
+           files, mb, mb / tot_ref, mb / tot_fast, tot_ref / tot_fast, bad);
+    return bad ? 1 : 0;
+}